@@ -6,10 +6,14 @@
  */
 
 #pragma once
+#include <chrono>
 #include <cstdint>
+#include <future>
 #include <optional>
 #include <vector>
 
+#include "fbpcf/engine/util/PackedBitVector.h"
+
 namespace fbpcf::engine {
 
 /**
@@ -39,6 +43,29 @@ class ISecretShareEngine {
       int id,
       const std::vector<bool>& v) = 0;
 
+  /**
+   * Generate a private integer input wire carring party id's input. Integers
+   * are additively shared mod 2^64.
+   * @param id the party that own v
+   * @param v the plaintext input, this value can be std::nullopt if this
+   * party doesn't own v
+   * @return the ciphertext form
+   */
+  virtual uint64_t setIntegerInput(
+      int id,
+      std::optional<uint64_t> v = std::nullopt) = 0;
+
+  /**
+   * Generate a batch of private integer input wires carring party id's inputs
+   * @param id the party that own v
+   * @param v the plaintext inputs, the integers in this vector can be any value
+   * if this party doesn't own v
+   * @return the ciphertext form
+   */
+  virtual std::vector<uint64_t> setBatchIntegerInput(
+      int id,
+      const std::vector<uint64_t>& v) = 0;
+
   /**
    * Compute an XOR gate with two private or two public values. This operation
    * requires all parties to XOR their shares/values (That's why it is
@@ -155,6 +182,140 @@ class ISecretShareEngine {
       const std::vector<bool>& left,
       const std::vector<bool>& right) const = 0;
 
+  //======== Below are free integer computation API's: ========
+  // Integers are additively shared mod 2^64, thus additions, negations and
+  // multiplications by a public value are all free.
+
+  /**
+   * Compute a plus gate with two private or two public values. All parties add
+   * up their shares/values locally.
+   * @param left the value on left input wire
+   * @param right the value on right input wire
+   * @return the value of the result
+   */
+  virtual uint64_t computeSymmetricPlus(uint64_t left, uint64_t right)
+      const = 0;
+
+  /**
+   * Compute a batch of plus gates with two private or two public values.
+   * @param left the values on left input wires
+   * @param right the values on right input wires
+   * @return the values of the results
+   */
+  virtual std::vector<uint64_t> computeBatchSymmetricPlus(
+      const std::vector<uint64_t>& left,
+      const std::vector<uint64_t>& right) const = 0;
+
+  /**
+   * Compute a plus gate between a private (left) and a public (right) value.
+   * Only one party adds the public value to his/her share, others only needs
+   * to output left wire value.
+   * @param left the value on left input wire
+   * @param right the value on right input wire
+   * @return the value of the result
+   */
+  virtual uint64_t computeAsymmetricPlus(uint64_t left, uint64_t right)
+      const = 0;
+
+  /**
+   * Compute a batch of plus gates between private (left) and public (right)
+   * values.
+   * @param left the values on left input wires
+   * @param right the values on right input wires
+   * @return the values of the results
+   */
+  virtual std::vector<uint64_t> computeBatchAsymmetricPlus(
+      const std::vector<uint64_t>& left,
+      const std::vector<uint64_t>& right) const = 0;
+
+  /**
+   * Compute a negation gate on a private or public value. All parties negate
+   * their shares/values locally.
+   * @param input the value on input wire
+   * @return the value of the result
+   */
+  virtual uint64_t computeNeg(uint64_t input) const = 0;
+
+  /**
+   * Compute a batch of negation gates on private or public values.
+   * @param input the values on input wires
+   * @return the values of the results
+   */
+  virtual std::vector<uint64_t> computeBatchNeg(
+      const std::vector<uint64_t>& input) const = 0;
+
+  /**
+   * Compute a free multiplication gate: at least one of the input is a public
+   * value, thus the parties only need to multiply the secret share and the
+   * public value (or two public values) locally.
+   * @param left the value on left input wire
+   * @param right the value on right input wire
+   * @return the value of the result
+   */
+  virtual uint64_t computeFreeMult(uint64_t left, uint64_t right) const = 0;
+
+  /**
+   * Compute a batch of free multiplication gates: at least one of the input is
+   * a public value.
+   * @param left the values on left input wires
+   * @param right the values on right input wires
+   * @return the values of the results
+   */
+  virtual std::vector<uint64_t> computeBatchFreeMult(
+      const std::vector<uint64_t>& left,
+      const std::vector<uint64_t>& right) const = 0;
+
+  //======== Below are packed batch computation API's: ========
+  // These are equivalent to the std::vector<bool> versions above, but operate
+  // on word-packed bits so that a batch is processed a SIMD register at a time.
+
+  /**
+   * Compute a batch of XOR gates with two private or two public values.
+   * @param left the packed values on left input wires
+   * @param right the packed values on right input wires
+   * @return the packed values of the results
+   */
+  virtual util::PackedBitVector computeBatchSymmetricXOR(
+      const util::PackedBitVector& left,
+      const util::PackedBitVector& right) const = 0;
+
+  /**
+   * Compute a batch of XOR gates with a private and a public values.
+   * @param left the packed values on left input wires
+   * @param right the packed values on right input wires
+   * @return the packed values of the results
+   */
+  virtual util::PackedBitVector computeBatchAsymmetricXOR(
+      const util::PackedBitVector& left,
+      const util::PackedBitVector& right) const = 0;
+
+  /**
+   * Compute a batch of NOT gates on public values.
+   * @param input the packed values on input wires
+   * @return the packed values of the results
+   */
+  virtual util::PackedBitVector computeBatchSymmetricNOT(
+      const util::PackedBitVector& input) const = 0;
+
+  /**
+   * Compute a batch of NOT gates on private values.
+   * @param input the packed values on input wires
+   * @return the packed values of the results
+   */
+  virtual util::PackedBitVector computeBatchAsymmetricNOT(
+      const util::PackedBitVector& input) const = 0;
+
+  /**
+   * Compute a batch of free AND gates: at least one of the input is a public
+   * value.
+   * @param left the packed values on left input wires
+   * @param right the packed values on right input wires
+   * @return the packed values of the results
+   */
+  virtual util::PackedBitVector computeBatchFreeAND(
+      const util::PackedBitVector& left,
+      const util::PackedBitVector& right) const = 0;
+
   //======== Below are API's to schedule non-free AND's: ========
 
   /** Schedule an AND gate for computation. Since computing AND gates incurs 2
@@ -179,6 +340,18 @@ class ISecretShareEngine {
       const std::vector<bool>& left,
       const std::vector<bool>& right) = 0;
 
+  /** Schedule a batch of AND gates on packed values. Packed batches are
+   * indexed separately from the std::vector<bool> ones.
+   * @param left the packed values on left input wires
+   * @param right the packed values on right input wires. Must be same length
+   * as left
+   * @return the index of the scheduled batch, i.e. how many packed batches
+   * have already been scheduled.
+   */
+  virtual uint32_t scheduleBatchAND(
+      const util::PackedBitVector& left,
+      const util::PackedBitVector& right) = 0;
+
   /** Schedule a composite AND gate for computation. Since computing AND gates
    * incurs 2 roundtrips, we want to batch them together to reduce the total
    * number of roundtrips.
@@ -213,6 +386,29 @@ class ISecretShareEngine {
    */
   virtual void executeScheduledAND() = 0;
 
+  /**
+   * Same as executeScheduledAND, except that fetching the tuples, masking the
+   * inputs and exchanging the masked values happen in the background. The
+   * results can be retrieved once the returned future is ready. Until then,
+   * only local computations (inputs, free gates and scheduling) may be done
+   * on this engine.
+   */
+  virtual std::future<void> executeScheduledANDAsync() = 0;
+
+  /**
+   * Hint that the next AND gates to be executed take this many tuples in
+   * total, so that the tuples can be generated ahead of time. All parties
+   * need to give the same hints at the same points.
+   * @param numberOfANDs the number of upcoming AND results
+   */
+  virtual void prefetchANDTuples(uint64_t numberOfANDs) = 0;
+
+  /**
+   * Get how long the execution of AND gates was blocked waiting for tuples
+   * to be generated.
+   */
+  virtual std::chrono::nanoseconds getTupleStarvationTime() const = 0;
+
   /**
    * Compute a batch of AND gate: all inputs are private values. This batch of
    * gates will be immediately executed, incuring a roundtrip.
@@ -224,6 +420,119 @@ class ISecretShareEngine {
       const std::vector<bool>& left,
       const std::vector<bool>& right) = 0;
 
+  //======== Below are API's for non-free integer multiplications: ========
+
+  /**
+   * Schedule a multiplication gate between two private integers. Like AND
+   * gates, they are batched together and executed within one roundtrip.
+   * @param left the value on left input wire
+   * @param right the value on right input wire
+   * @return the index of the scheduled gate, i.e. how many gates has already
+   * been scheduled.
+   */
+  virtual uint32_t scheduleMult(uint64_t left, uint64_t right) = 0;
+
+  /**
+   * Schedule a batch of multiplication gates between private integers.
+   * @param left the values on left input wires
+   * @param right the values on right input wires. Must be same length as left
+   * @return the index of the scheduled gate, i.e. how many gates has already
+   * been scheduled.
+   */
+  virtual uint32_t scheduleBatchMult(
+      const std::vector<uint64_t>& left,
+      const std::vector<uint64_t>& right) = 0;
+
+  /**
+   * Execute all the scheduled multiplications within ONE roundtrip, no matter
+   * how many of them are scheduled.
+   */
+  virtual void executeScheduledMult() = 0;
+
+  /**
+   * Get the execution result of the executed multiplication gate
+   * @param index the index of the multiplication gate in the schedule
+   * @return the result value
+   */
+  virtual uint64_t getMultExecutionResult(uint32_t index) const = 0;
+
+  /**
+   * Get the execution result of the executed batch multiplication gate
+   * @param index the index of the batch multiplication gate in the schedule
+   * @return the result value
+   */
+  virtual const std::vector<uint64_t>& getBatchMultExecutionResult(
+      uint32_t index) const = 0;
+
+  //======== Below are API's for share conversions: ========
+
+  /**
+   * Share the lowest width bits of every party's share of a private integer
+   * as private boolean values. This can be done locally, and adding up the
+   * summands with a boolean adder converts the integer to its binary form
+   * (A2B).
+   * @param share this party's share of the integer
+   * @param width how many bits of the summands to share
+   * @return the shares of the summands, where the k-th bit (lsb first) of party
+   * i's summand is at [i * width + k]
+   */
+  virtual std::vector<bool> computeIntegerToBooleanSummands(
+      uint64_t share,
+      int8_t width) = 0;
+
+  /**
+   * Share the lowest width bits of every party's shares of a batch of private
+   * integers as private boolean values.
+   * @param shares this party's shares of the integers
+   * @param width how many bits of the summands to share
+   * @return the shares of the summands, where the k-th bits (lsb first) of
+   * party i's summands are at [i * width + k]
+   */
+  virtual std::vector<std::vector<bool>> computeBatchIntegerToBooleanSummands(
+      const std::vector<uint64_t>& shares,
+      int8_t width) = 0;
+
+  /**
+   * Schedule a conversion from private bits to the private integer
+   * sum_k 2^k * bits[k] mod 2^64 (B2A). Like the multiplications, they are
+   * batched together and executed within one roundtrip.
+   * @param bits the values of the bits, lsb first
+   * @return the index of the scheduled conversion, i.e. how many conversions
+   * has already been scheduled.
+   */
+  virtual uint32_t scheduleBooleanToInteger(const std::vector<bool>& bits) = 0;
+
+  /**
+   * Schedule a conversion from a batch of private bits to private integers.
+   * @param bits the values of the bits, where bits[k] are the k-th bits (lsb
+   * first) of the integers. All of them must have the same length.
+   * @return the index of the scheduled conversion, i.e. how many conversions
+   * has already been scheduled.
+   */
+  virtual uint32_t scheduleBatchBooleanToInteger(
+      const std::vector<std::vector<bool>>& bits) = 0;
+
+  /**
+   * Execute all the scheduled conversions within ONE roundtrip, no matter how
+   * many of them are scheduled.
+   */
+  virtual void executeScheduledBooleanToInteger() = 0;
+
+  /**
+   * Get the execution result of the executed conversion
+   * @param index the index of the conversion in the schedule
+   * @return the result value
+   */
+  virtual uint64_t getBooleanToIntegerExecutionResult(uint32_t index) const = 0;
+
+  /**
+   * Get the execution result of the executed batch conversion
+   * @param index the index of the batch conversion in the schedule
+   * @return the result value
+   */
+  virtual const std::vector<uint64_t>& getBatchBooleanToIntegerExecutionResult(
+      uint32_t index) const = 0;
+
   //======== Below are API's to retrieve non-free AND results: ========
 
   /**
@@ -241,6 +550,14 @@ class ISecretShareEngine {
   virtual const std::vector<bool>& getBatchANDExecutionResult(
       uint32_t index) const = 0;
 
+  /**
+   * Get the execution result of the executed packed batch AND gate
+   * @param index the index of the packed batch AND gate in the schedule
+   * @return the packed result values
+   */
+  virtual const util::PackedBitVector& getPackedBatchANDExecutionResult(
+      uint32_t index) const = 0;
+
   /**
    * Get the execution result of the executed composite AND gate
    * @param index the index of the AND gate in the schedule
@@ -267,6 +584,25 @@ class ISecretShareEngine {
       int id,
       const std::vector<bool>& output) const = 0;
 
+  /**
+   * reveal a packed vector of shared secrets to a designated party
+   * @param Id the identity of the plaintext receiver
+   * @param output the packed plaintext output, all zeros if this party is not
+   * the receiver
+   */
+  virtual util::PackedBitVector revealToParty(
+      int id,
+      const util::PackedBitVector& output) const = 0;
+
+  /**
+   * reveal a vector of shared integers to a designated party
+   * @param Id the identity of the plaintext receiver
+   * @param output the plaintext output, 0 if this party is not the receiver
+   */
+  virtual std::vector<uint64_t> revealToParty(
+      int id,
+      const std::vector<uint64_t>& output) const = 0;
+
   /**
    * Get the total amount of traffic transmitted.
    * @return a pair of (sent, received) data in bytes.
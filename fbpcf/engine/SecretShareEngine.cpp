@@ -9,6 +9,7 @@
 #include <cstddef>
 #include <exception>
 #include <iterator>
+#include <map>
 #include <memory>
 #include <stdexcept>
 
@@ -22,10 +23,13 @@ SecretShareEngine::SecretShareEngine(
         communicationAgent,
     std::unique_ptr<util::IPrgFactory> prgFactory,
     int myId,
-    int numberOfParty)
+    int numberOfParty,
+    std::unique_ptr<tuple_generator::IArithmeticTupleGenerator>
+        arithmeticTupleGenerator)
     : tupleGenerator_{std::move(tupleGenerator)},
       communicationAgent_{std::move(communicationAgent)},
       prgFactory_{std::move(prgFactory)},
+      arithmeticTupleGenerator_{std::move(arithmeticTupleGenerator)},
       myId_{myId},
       numberOfParty_{numberOfParty} {
   std::map<int, __m128i> randomPrgKey;
@@ -85,6 +89,45 @@ std::vector<bool> SecretShareEngine::setBatchInput(
   }
 }
 
+uint64_t SecretShareEngine::setIntegerInput(
+    int id,
+    std::optional<uint64_t> v) {
+  if (id == myId_) {
+    if (!v.has_value()) {
+      throw std::invalid_argument("needs to provide input value");
+    }
+    uint64_t rst = v.value();
+    for (auto& item : inputPrgs_) {
+      rst -= item.second.first->getRandomUInt64(1).at(0);
+    }
+    return rst;
+  } else {
+    assert(inputPrgs_.find(id) != inputPrgs_.end());
+    return inputPrgs_.at(id).second->getRandomUInt64(1).at(0);
+  }
+}
+
+std::vector<uint64_t> SecretShareEngine::setBatchIntegerInput(
+    int id,
+    const std::vector<uint64_t>& v) {
+  if (id == myId_) {
+    if (v.size() == 0) {
+      throw std::invalid_argument("empty input!");
+    }
+    std::vector<uint64_t> rst = v;
+    for (auto& item : inputPrgs_) {
+      auto mask = item.second.first->getRandomUInt64(v.size());
+      for (size_t i = 0; i < rst.size(); i++) {
+        rst[i] -= mask[i];
+      }
+    }
+    return rst;
+  } else {
+    assert(inputPrgs_.find(id) != inputPrgs_.end());
+    return inputPrgs_.at(id).second->getRandomUInt64(v.size());
+  }
+}
+
 bool SecretShareEngine::computeSymmetricXOR(bool left, bool right) const {
   return left ^ right;
 }
@@ -194,6 +237,123 @@ std::vector<bool> SecretShareEngine::computeBatchFreeAND(
   return rst;
 }
 
+//======== Below are free integer computation API's: ========
+
+uint64_t SecretShareEngine::computeSymmetricPlus(uint64_t left, uint64_t right)
+    const {
+  return left + right;
+}
+
+std::vector<uint64_t> SecretShareEngine::computeBatchSymmetricPlus(
+    const std::vector<uint64_t>& left,
+    const std::vector<uint64_t>& right) const {
+  if (left.size() != right.size()) {
+    throw std::invalid_argument("The input sizes are not the same.");
+  }
+  std::vector<uint64_t> rst(left.size());
+  for (size_t i = 0; i < left.size(); i++) {
+    rst[i] = left[i] + right[i];
+  }
+  return rst;
+}
+
+uint64_t SecretShareEngine::computeAsymmetricPlus(
+    uint64_t left,
+    uint64_t right) const {
+  if (myId_ == 0) {
+    return left + right;
+  } else {
+    return left;
+  }
+}
+
+std::vector<uint64_t> SecretShareEngine::computeBatchAsymmetricPlus(
+    const std::vector<uint64_t>& left,
+    const std::vector<uint64_t>& right) const {
+  if (left.size() != right.size()) {
+    throw std::invalid_argument("The input sizes are not the same.");
+  }
+  if (myId_ != 0) {
+    return left;
+  }
+  std::vector<uint64_t> rst(left.size());
+  for (size_t i = 0; i < left.size(); i++) {
+    rst[i] = left[i] + right[i];
+  }
+  return rst;
+}
+
+uint64_t SecretShareEngine::computeNeg(uint64_t input) const {
+  return -input;
+}
+
+std::vector<uint64_t> SecretShareEngine::computeBatchNeg(
+    const std::vector<uint64_t>& input) const {
+  std::vector<uint64_t> rst(input.size());
+  for (size_t i = 0; i < input.size(); i++) {
+    rst[i] = -input[i];
+  }
+  return rst;
+}
+
+uint64_t SecretShareEngine::computeFreeMult(uint64_t left, uint64_t right)
+    const {
+  return left * right;
+}
+
+std::vector<uint64_t> SecretShareEngine::computeBatchFreeMult(
+    const std::vector<uint64_t>& left,
+    const std::vector<uint64_t>& right) const {
+  if (left.size() != right.size()) {
+    throw std::invalid_argument("The input sizes are not the same.");
+  }
+  std::vector<uint64_t> rst(left.size());
+  for (size_t i = 0; i < left.size(); i++) {
+    rst[i] = left[i] * right[i];
+  }
+  return rst;
+}
+
+//======== Below are packed batch computation API's: ========
+
+util::PackedBitVector SecretShareEngine::computeBatchSymmetricXOR(
+    const util::PackedBitVector& left,
+    const util::PackedBitVector& right) const {
+  return left ^ right;
+}
+
+util::PackedBitVector SecretShareEngine::computeBatchAsymmetricXOR(
+    const util::PackedBitVector& left,
+    const util::PackedBitVector& right) const {
+  if (left.size() != right.size()) {
+    throw std::invalid_argument("The input sizes are not the same.");
+  }
+  if (myId_ == 0) {
+    return left ^ right;
+  } else {
+    return left;
+  }
+}
+
+util::PackedBitVector SecretShareEngine::computeBatchSymmetricNOT(
+    const util::PackedBitVector& input) const {
+  return ~input;
+}
+
+util::PackedBitVector SecretShareEngine::computeBatchAsymmetricNOT(
+    const util::PackedBitVector& input) const {
+  if (myId_ != 0) {
+    return input;
+  }
+  return ~input;
+}
+
+util::PackedBitVector SecretShareEngine::computeBatchFreeAND(
+    const util::PackedBitVector& left,
+    const util::PackedBitVector& right) const {
+  return left & right;
+}
+
 //======== Below are API's to schedule non-free AND's: ========
 
 uint32_t SecretShareEngine::scheduleAND(bool left, bool right) {
@@ -211,6 +371,17 @@ uint32_t SecretShareEngine::scheduleBatchAND(
   return scheduledBatchANDGates_.size() - 1;
 }
 
+uint32_t SecretShareEngine::scheduleBatchAND(
+    const util::PackedBitVector& left,
+    const util::PackedBitVector& right) {
+  if (left.size() != right.size()) {
+    throw std::runtime_error("Batch AND's must have the same length");
+  }
+  scheduledPackedBatchANDGates_.push_back(
+      ScheduledPackedBatchAND(left, right));
+  return scheduledPackedBatchANDGates_.size() - 1;
+}
+
 uint32_t SecretShareEngine::scheduleCompositeAND(
     bool left,
     std::vector<bool> rights) {
@@ -241,13 +412,42 @@ void SecretShareEngine::executeScheduledAND() {
   executionResults_ = computeAllANDsFromScheduledANDs(
       scheduledANDGates_,
       scheduledBatchANDGates_,
+      scheduledPackedBatchANDGates_,
       scheduledCompositeANDGates_,
       scheduledBatchCompositeANDGates_);
 
   scheduledANDGates_.clear();
   scheduledBatchANDGates_.clear();
+  scheduledPackedBatchANDGates_.clear();
+  scheduledCompositeANDGates_.clear();
+  scheduledBatchCompositeANDGates_.clear();
+}
+
+std::future<void> SecretShareEngine::executeScheduledANDAsync() {
+  // the scheduled ANDs are moved out, so that new ones can be scheduled while
+  // these are being executed.
+  auto job = [this,
+              ands = std::move(scheduledANDGates_),
+              batchAnds = std::move(scheduledBatchANDGates_),
+              packedBatchAnds = std::move(scheduledPackedBatchANDGates_),
+              compositeAnds = std::move(scheduledCompositeANDGates_),
+              batchCompositeAnds =
+                  std::move(scheduledBatchCompositeANDGates_)]() mutable {
+    executionResults_ = computeAllANDsFromScheduledANDs(
+        ands,
+        batchAnds,
+        packedBatchAnds,
+        compositeAnds,
+        batchCompositeAnds);
+  };
+
+  scheduledANDGates_.clear();
+  scheduledBatchANDGates_.clear();
+  scheduledPackedBatchANDGates_.clear();
   scheduledCompositeANDGates_.clear();
   scheduledBatchCompositeANDGates_.clear();
+
+  return std::async(std::launch::async, std::move(job));
 }
 
 std::vector<bool> SecretShareEngine::computeBatchANDImmediately(
@@ -259,6 +459,7 @@ std::vector<bool> SecretShareEngine::computeBatchANDImmediately(
   std::vector<ScheduledAND> scheduledANDs;
   scheduledANDs.reserve(left.size());
   std::vector<ScheduledBatchAND> scheduledBatchANDs;
+  std::vector<ScheduledPackedBatchAND> scheduledPackedBatchANDs;
   std::vector<ScheduledCompositeAND> scheduledCompositeANDs;
   std::vector<ScheduledBatchCompositeAND> scheduledBatchCompositeANDs;
   for (int i = 0; i < left.size(); i++) {
@@ -267,11 +468,264 @@ std::vector<bool> SecretShareEngine::computeBatchANDImmediately(
   return computeAllANDsFromScheduledANDs(
              scheduledANDs,
              scheduledBatchANDs,
+             scheduledPackedBatchANDs,
              scheduledCompositeANDs,
              scheduledBatchCompositeANDs)
       .andResults;
 }
 
+//======== Below are API's for non-free integer multiplications: ========
+
+uint32_t SecretShareEngine::scheduleMult(uint64_t left, uint64_t right) {
+  scheduledMultLeft_.push_back(left);
+  scheduledMultRight_.push_back(right);
+  return scheduledMultLeft_.size() - 1;
+}
+
+uint32_t SecretShareEngine::scheduleBatchMult(
+    const std::vector<uint64_t>& left,
+    const std::vector<uint64_t>& right) {
+  if (left.size() != right.size()) {
+    throw std::runtime_error("Batch Mult's must have the same length");
+  }
+  scheduledBatchMults_.emplace_back(left, right);
+  return scheduledBatchMults_.size() - 1;
+}
+
+void SecretShareEngine::executeScheduledMult() {
+  // the regular multiplications go first, followed by the batches in the
+  // order they are scheduled.
+  auto left = std::move(scheduledMultLeft_);
+  auto right = std::move(scheduledMultRight_);
+  auto regularMultCount = left.size();
+  for (auto& item : scheduledBatchMults_) {
+    left.insert(left.end(), item.first.begin(), item.first.end());
+    right.insert(right.end(), item.second.begin(), item.second.end());
+  }
+
+  auto results = computeMults(left, right);
+
+  multExecutionResults_.results = std::vector<uint64_t>(
+      results.begin(), results.begin() + regularMultCount);
+  multExecutionResults_.batchResults.clear();
+  multExecutionResults_.batchResults.reserve(scheduledBatchMults_.size());
+  auto index = regularMultCount;
+  for (auto& item : scheduledBatchMults_) {
+    auto batchSize = item.first.size();
+    multExecutionResults_.batchResults.emplace_back(
+        results.begin() + index, results.begin() + index + batchSize);
+    index += batchSize;
+  }
+
+  scheduledMultLeft_.clear();
+  scheduledMultRight_.clear();
+  scheduledBatchMults_.clear();
+}
+
+uint64_t SecretShareEngine::getMultExecutionResult(uint32_t index) const {
+  return multExecutionResults_.results.at(index);
+}
+
+const std::vector<uint64_t>& SecretShareEngine::getBatchMultExecutionResult(
+    uint32_t index) const {
+  return multExecutionResults_.batchResults.at(index);
+}
+
+std::vector<uint64_t> SecretShareEngine::computeMults(
+    const std::vector<uint64_t>& left,
+    const std::vector<uint64_t>& right) {
+  auto size = left.size();
+  if (size == 0) {
+    return std::vector<uint64_t>();
+  }
+  if (arithmeticTupleGenerator_ == nullptr) {
+    throw std::runtime_error(
+        "Multiplying private integers needs an arithmetic tuple generator.");
+  }
+  auto tuples = arithmeticTupleGenerator_->getIntegerTuple(size);
+
+  // open d = left - a and e = right - b in one roundtrip, then
+  // left * right = c + d * b + e * a + d * e, where d * e is only added by
+  // party 0.
+  std::vector<uint64_t> secretsToOpen(2 * size);
+  for (size_t i = 0; i < size; i++) {
+    secretsToOpen[i] = left[i] - tuples[i].getA();
+    secretsToOpen[size + i] = right[i] - tuples[i].getB();
+  }
+  auto openedSecrets = communicationAgent_->openSecretsToAll(secretsToOpen);
+  if (openedSecrets.size() != secretsToOpen.size()) {
+    throw std::runtime_error("unexpected number of opened secrets");
+  }
+
+  std::vector<uint64_t> rst(size);
+  for (size_t i = 0; i < size; i++) {
+    auto d = openedSecrets[i];
+    auto e = openedSecrets[size + i];
+    rst[i] = tuples[i].getC() + d * tuples[i].getB() + e * tuples[i].getA();
+    if (myId_ == 0) {
+      rst[i] += d * e;
+    }
+  }
+  return rst;
+}
+
+//======== Below are API's for share conversions: ========
+
+std::vector<bool> SecretShareEngine::computeIntegerToBooleanSummands(
+    uint64_t share,
+    int8_t width) {
+  auto summands = computeBatchIntegerToBooleanSummands({share}, width);
+  std::vector<bool> rst(summands.size());
+  for (size_t i = 0; i < summands.size(); i++) {
+    rst[i] = summands.at(i).at(0);
+  }
+  return rst;
+}
+
+std::vector<std::vector<bool>>
+SecretShareEngine::computeBatchIntegerToBooleanSummands(
+    const std::vector<uint64_t>& shares,
+    int8_t width) {
+  if (width <= 0 || width > 64) {
+    throw std::invalid_argument("The width must be in [1, 64].");
+  }
+  auto batchSize = shares.size();
+  // all the bits of this party's shares, the k-th bits go to
+  // [k * batchSize, (k + 1) * batchSize)
+  std::vector<bool> bits(width * batchSize);
+  for (int8_t k = 0; k < width; k++) {
+    for (size_t j = 0; j < batchSize; j++) {
+      bits[k * batchSize + j] = (shares[j] >> k) & 1;
+    }
+  }
+
+  // every party inputs its own summand, the values are ignored for the others
+  std::vector<std::vector<bool>> rst(numberOfParty_ * width);
+  for (int i = 0; i < numberOfParty_; i++) {
+    auto summand = setBatchInput(i, bits);
+    for (int8_t k = 0; k < width; k++) {
+      rst[i * width + k] = std::vector<bool>(
+          summand.begin() + k * batchSize,
+          summand.begin() + (k + 1) * batchSize);
+    }
+  }
+  return rst;
+}
+
+uint32_t SecretShareEngine::scheduleBooleanToInteger(
+    const std::vector<bool>& bits) {
+  if (bits.size() > 64) {
+    throw std::invalid_argument("An integer takes at most 64 bits.");
+  }
+  scheduledBooleanToIntegers_.push_back(bits);
+  return scheduledBooleanToIntegers_.size() - 1;
+}
+
+uint32_t SecretShareEngine::scheduleBatchBooleanToInteger(
+    const std::vector<std::vector<bool>>& bits) {
+  if (bits.size() > 64) {
+    throw std::invalid_argument("An integer takes at most 64 bits.");
+  }
+  for (auto& item : bits) {
+    if (item.size() != bits.at(0).size()) {
+      throw std::invalid_argument("The input sizes are not the same.");
+    }
+  }
+  scheduledBatchBooleanToIntegers_.push_back(bits);
+  return scheduledBatchBooleanToIntegers_.size() - 1;
+}
+
+void SecretShareEngine::executeScheduledBooleanToInteger() {
+  // the regular conversions go first, followed by the batches in the order
+  // they are scheduled.
+  std::vector<bool> bits;
+  for (auto& item : scheduledBooleanToIntegers_) {
+    bits.insert(bits.end(), item.begin(), item.end());
+  }
+  for (auto& item : scheduledBatchBooleanToIntegers_) {
+    for (auto& kthBits : item) {
+      bits.insert(bits.end(), kthBits.begin(), kthBits.end());
+    }
+  }
+
+  auto values = computeBitsToIntegers(bits);
+
+  size_t index = 0;
+  booleanToIntegerExecutionResults_.results.clear();
+  booleanToIntegerExecutionResults_.results.reserve(
+      scheduledBooleanToIntegers_.size());
+  for (auto& item : scheduledBooleanToIntegers_) {
+    uint64_t rst = 0;
+    for (size_t k = 0; k < item.size(); k++) {
+      rst += values.at(index++) << k;
+    }
+    booleanToIntegerExecutionResults_.results.push_back(rst);
+  }
+  booleanToIntegerExecutionResults_.batchResults.clear();
+  booleanToIntegerExecutionResults_.batchResults.reserve(
+      scheduledBatchBooleanToIntegers_.size());
+  for (auto& item : scheduledBatchBooleanToIntegers_) {
+    auto batchSize = item.empty() ? 0 : item.at(0).size();
+    std::vector<uint64_t> rst(batchSize, 0);
+    for (size_t k = 0; k < item.size(); k++) {
+      for (size_t j = 0; j < batchSize; j++) {
+        rst[j] += values.at(index++) << k;
+      }
+    }
+    booleanToIntegerExecutionResults_.batchResults.push_back(std::move(rst));
+  }
+
+  scheduledBooleanToIntegers_.clear();
+  scheduledBatchBooleanToIntegers_.clear();
+}
+
+uint64_t SecretShareEngine::getBooleanToIntegerExecutionResult(
+    uint32_t index) const {
+  return booleanToIntegerExecutionResults_.results.at(index);
+}
+
+const std::vector<uint64_t>&
+SecretShareEngine::getBatchBooleanToIntegerExecutionResult(
+    uint32_t index) const {
+  return booleanToIntegerExecutionResults_.batchResults.at(index);
+}
+
+std::vector<uint64_t> SecretShareEngine::computeBitsToIntegers(
+    const std::vector<bool>& bits) {
+  auto size = bits.size();
+  if (size == 0) {
+    return std::vector<uint64_t>();
+  }
+  if (arithmeticTupleGenerator_ == nullptr) {
+    throw std::runtime_error(
+        "Converting private bits to integers needs an arithmetic tuple "
+        "generator.");
+  }
+  auto daBits = arithmeticTupleGenerator_->getDaBit(size);
+
+  // open c = b ^ r in one roundtrip, where r is the random bit of a daBit,
+  // then b = c + r - 2 * c * r, where c is only added by party 0.
+  std::vector<bool> secretsToOpen(size);
+  for (size_t i = 0; i < size; i++) {
+    secretsToOpen[i] = bits[i] ^ daBits[i].getBooleanShare();
+  }
+  auto openedSecrets = communicationAgent_->openSecretsToAll(secretsToOpen);
+  if (openedSecrets.size() != secretsToOpen.size()) {
+    throw std::runtime_error("unexpected number of opened secrets");
+  }
+
+  std::vector<uint64_t> rst(size);
+  for (size_t i = 0; i < size; i++) {
+    auto r = daBits[i].getIntegerShare();
+    if (openedSecrets[i]) {
+      rst[i] = (myId_ == 0 ? 1 : 0) - r;
+    } else {
+      rst[i] = r;
+    }
+  }
+  return rst;
+}
+
 //======== Below are API's to retrieve non-free AND results: ========
 
 bool SecretShareEngine::getANDExecutionResult(uint32_t index) const {
@@ -283,6 +737,11 @@ const std::vector<bool>& SecretShareEngine::getBatchANDExecutionResult(
   return executionResults_.batchANDResults.at(index);
 }
 
+const util::PackedBitVector&
+SecretShareEngine::getPackedBatchANDExecutionResult(uint32_t index) const {
+  return executionResults_.packedBatchANDResults.at(index);
+}
+
 const std::vector<bool>& SecretShareEngine::getCompositeANDExecutionResult(
     uint32_t index) const {
   return executionResults_.compositeANDResults.at(index);
@@ -297,81 +756,185 @@ SecretShareEngine::ExecutionResults
 SecretShareEngine::computeAllANDsFromScheduledANDs(
     std::vector<ScheduledAND>& ands,
     std::vector<ScheduledBatchAND>& batchAnds,
+    std::vector<ScheduledPackedBatchAND>& packedBatchAnds,
     std::vector<ScheduledCompositeAND>& compositeAnds,
     std::vector<ScheduledBatchCompositeAND>& batchCompositeAnds) {
-  size_t tupleCount = ands.size();
-
+  // Regular ANDs and batch ANDs consume one regular tuple each. Each left
+  // value of a composite AND consumes a composite tuple, such that the masked
+  // left value is opened only once. If the tuple generator can't generate
+  // composite tuples, composite ANDs fall back to one regular tuple per right
+  // value.
+  bool useCompositeTuples = tupleGenerator_->supportsCompositeTupleGeneration();
+
+  size_t regularANDCount = ands.size();
   for (size_t i = 0; i < batchAnds.size(); i++) {
-    tupleCount += batchAnds[i].getLeft().size();
+    regularANDCount += batchAnds[i].getLeft().size();
+  }
+  for (size_t i = 0; i < packedBatchAnds.size(); i++) {
+    regularANDCount += packedBatchAnds[i].getLeft().size();
   }
 
+  // the number of right values for each composite left value, in the order
+  // they are scheduled.
+  std::vector<size_t> compositeWidths;
+  std::map<size_t, uint32_t> compositeTupleSizes;
+  size_t compositeRightCount = 0;
   for (size_t i = 0; i < compositeAnds.size(); i++) {
-    tupleCount += compositeAnds[i].getRights().size();
+    auto width = compositeAnds[i].getRights().size();
+    compositeWidths.push_back(width);
+    compositeTupleSizes[width]++;
+    compositeRightCount += width;
   }
 
   for (size_t i = 0; i < batchCompositeAnds.size(); i++) {
-    tupleCount += batchCompositeAnds[i].getLeft().size() *
-        batchCompositeAnds[i].getRights().size();
+    auto batchSize = batchCompositeAnds[i].getLeft().size();
+    auto width = batchCompositeAnds[i].getRights().size();
+    compositeWidths.insert(compositeWidths.end(), batchSize, width);
+    compositeTupleSizes[width] += batchSize;
+    compositeRightCount += batchSize * width;
   }
+  auto compositeLeftCount = compositeWidths.size();
 
-  if (tupleCount == 0) {
+  if (regularANDCount + compositeRightCount == 0) {
     return {
         std::vector<bool>(),
         std::vector<std::vector<bool>>(),
+        std::vector<util::PackedBitVector>(packedBatchAnds.size()),
         std::vector<std::vector<bool>>(),
         std::vector<std::vector<std::vector<bool>>>()};
   }
 
-  auto tuples = tupleGenerator_->getBooleanTuple(tupleCount);
-  std::vector<bool> secretsToOpen(tupleCount * 2);
+  // gather all the inputs into bit planes, so that masking and
+  // reconstruction can be done a word at a time. Composite right values are
+  // stored grouped by their left value.
+  util::PackedBitVector leftValues(ands.size());
+  util::PackedBitVector rightValues(ands.size());
+  util::PackedBitVector compositeLeftValues(compositeLeftCount);
+  util::PackedBitVector compositeRightValues(compositeRightCount);
 
   size_t index = 0;
   for (size_t i = 0; i < ands.size(); i++) {
-    secretsToOpen[index * 2] = ands[i].getLeft() ^ tuples.at(index).getA();
-    secretsToOpen[index * 2 + 1] = ands[i].getRight() ^ tuples.at(index).getB();
+    leftValues.set(index, ands[i].getLeft());
+    rightValues.set(index, ands[i].getRight());
     index++;
   }
 
   for (size_t i = 0; i < batchAnds.size(); i++) {
-    auto& leftValues = batchAnds[i].getLeft();
-    auto& rightValues = batchAnds[i].getRight();
-    for (int j = 0; j < leftValues.size(); j++) {
-      secretsToOpen[index * 2] = leftValues[j] ^ tuples.at(index).getA();
-      secretsToOpen[index * 2 + 1] =
-          rightValues.at(j) ^ tuples.at(index).getB();
-      index++;
-    }
+    leftValues.append(util::PackedBitVector(batchAnds[i].getLeft()));
+    rightValues.append(util::PackedBitVector(batchAnds[i].getRight()));
+  }
+
+  // packed batches are appended a word at a time.
+  for (size_t i = 0; i < packedBatchAnds.size(); i++) {
+    leftValues.append(packedBatchAnds[i].getLeft());
+    rightValues.append(packedBatchAnds[i].getRight());
   }
 
+  size_t leftIndex = 0;
+  size_t rightIndex = 0;
   for (size_t i = 0; i < compositeAnds.size(); i++) {
-    for (size_t j = 0; j < compositeAnds[i].getRights().size(); j++) {
-      secretsToOpen[index * 2] =
-          compositeAnds[i].getLeft() ^ tuples.at(index).getA();
-      secretsToOpen[index * 2 + 1] =
-          compositeAnds[i].getRights()[j] ^ tuples.at(index).getB();
-      index++;
+    compositeLeftValues.set(leftIndex++, compositeAnds[i].getLeft());
+    for (auto right : compositeAnds[i].getRights()) {
+      compositeRightValues.set(rightIndex++, right);
     }
   }
 
   for (size_t i = 0; i < batchCompositeAnds.size(); i++) {
-    auto& leftValues = batchCompositeAnds[i].getLeft();
-    for (auto& rightValues : batchCompositeAnds[i].getRights()) {
-      for (int j = 0; j < leftValues.size(); j++) {
-        secretsToOpen[index * 2] = leftValues[j] ^ tuples.at(index).getA();
-        secretsToOpen[index * 2 + 1] =
-            rightValues.at(j) ^ tuples.at(index).getB();
-        index++;
+    auto& batchLeft = batchCompositeAnds[i].getLeft();
+    auto& batchRights = batchCompositeAnds[i].getRights();
+    for (size_t j = 0; j < batchLeft.size(); j++) {
+      compositeLeftValues.set(leftIndex++, batchLeft[j]);
+      for (auto& batchRight : batchRights) {
+        compositeRightValues.set(rightIndex++, batchRight[j]);
+      }
+    }
+  }
+
+  // copy each composite left value once for each of its right values.
+  auto expandCompositeLeft = [&compositeWidths, compositeRightCount](
+                                 const util::PackedBitVector& src) {
+    util::PackedBitVector rst(compositeRightCount);
+    size_t position = 0;
+    for (size_t i = 0; i < compositeWidths.size(); i++) {
+      auto value = src.get(i);
+      for (size_t j = 0; j < compositeWidths[i]; j++) {
+        rst.set(position++, value);
       }
     }
+    return rst;
+  };
+
+  if (!useCompositeTuples) {
+    leftValues.append(expandCompositeLeft(compositeLeftValues));
+    rightValues.append(compositeRightValues);
+  }
+  auto tupleCount = leftValues.size();
+  auto tuples = tupleGenerator_->getPackedBooleanTuple(tupleCount);
+
+  // The opened secrets are laid out as: masked left values, masked right
+  // values, and if composite tuples are used, masked composite left values
+  // and masked composite right values.
+  auto secretsToOpen = leftValues ^ tuples.getA();
+  secretsToOpen.append(rightValues ^ tuples.getB());
+
+  util::PackedBitVector compositeA;
+  util::PackedBitVector compositeB;
+  util::PackedBitVector compositeC;
+  if (useCompositeTuples) {
+    compositeA = util::PackedBitVector(compositeLeftCount);
+    compositeB = util::PackedBitVector(compositeRightCount);
+    compositeC = util::PackedBitVector(compositeRightCount);
+  }
+  if (useCompositeTuples && compositeLeftCount > 0) {
+    auto compositeTuples =
+        tupleGenerator_->getCompositeTuple(compositeTupleSizes);
+    std::map<size_t, size_t> nextTupleIndex;
+    size_t position = 0;
+    for (size_t i = 0; i < compositeWidths.size(); i++) {
+      auto width = compositeWidths[i];
+      auto& tuple = compositeTuples.at(width).at(nextTupleIndex[width]++);
+      compositeA.set(i, tuple.getA());
+      for (size_t j = 0; j < width; j++) {
+        compositeB.set(position, tuple.getB()[j]);
+        compositeC.set(position, tuple.getC()[j]);
+        position++;
+      }
+    }
+    secretsToOpen.append(compositeLeftValues ^ compositeA);
+    secretsToOpen.append(compositeRightValues ^ compositeB);
   }
 
-  auto openedSecrets =
-      communicationAgent_->openSecretsToAll(std::move(secretsToOpen));
+  auto openedSecrets = communicationAgent_->openSecretsToAll(secretsToOpen);
 
-  if (openedSecrets.size() != tupleCount * 2) {
+  if (openedSecrets.size() != secretsToOpen.size()) {
     throw std::runtime_error("unexpected number of opened secrets");
   }
 
+  auto openedLeft = openedSecrets.slice(0, tupleCount);
+  auto openedRight = openedSecrets.slice(tupleCount, tupleCount);
+
+  auto results = tuples.getC() ^ (openedLeft & tuples.getB()) ^
+      (openedRight & tuples.getA());
+  if (myId_ == 0) {
+    results ^= openedLeft & openedRight;
+  }
+
+  util::PackedBitVector compositeResults;
+  if (useCompositeTuples) {
+    auto openedCompositeLeft = expandCompositeLeft(
+        openedSecrets.slice(2 * tupleCount, compositeLeftCount));
+    auto openedCompositeRight = openedSecrets.slice(
+        2 * tupleCount + compositeLeftCount, compositeRightCount);
+
+    compositeResults = compositeC ^ (openedCompositeLeft & compositeB) ^
+        (openedCompositeRight & expandCompositeLeft(compositeA));
+    if (myId_ == 0) {
+      compositeResults ^= openedCompositeLeft & openedCompositeRight;
+    }
+  } else {
+    compositeResults = results.slice(regularANDCount, compositeRightCount);
+  }
+
   std::vector<bool> andResults;
   andResults.reserve(ands.size());
   std::vector<std::vector<bool>> batchAndResults;
@@ -383,71 +946,49 @@ SecretShareEngine::computeAllANDsFromScheduledANDs(
   index = 0;
 
   for (size_t i = 0; i < ands.size(); i++) {
-    bool val = tuples.at(index).getC() ^
-        (openedSecrets.at(2 * index) & tuples.at(index).getB()) ^
-        (openedSecrets.at(2 * index + 1) & tuples.at(index).getA());
-    if (myId_ == 0) {
-      val =
-          val ^ (openedSecrets.at(2 * index) & openedSecrets.at(2 * index + 1));
-    }
-    andResults.push_back(val);
+    andResults.push_back(results.get(index));
     index++;
   }
 
   for (size_t i = 0; i < batchAnds.size(); i++) {
-    auto& leftValues = batchAnds[i].getLeft();
-    auto batchSize = leftValues.size();
+    auto batchSize = batchAnds[i].getLeft().size();
     std::vector<bool> rst(batchSize);
-    for (int j = 0; j < batchSize; j++) {
-      bool val = tuples.at(index).getC() ^
-          (openedSecrets.at(2 * index) & tuples.at(index).getB()) ^
-          (openedSecrets.at(2 * index + 1) & tuples.at(index).getA());
-      if (myId_ == 0) {
-        val = val ^
-            (openedSecrets.at(2 * index) & openedSecrets.at(2 * index + 1));
-      }
-      rst[j] = val;
+    for (size_t j = 0; j < batchSize; j++) {
+      rst[j] = results.get(index);
       index++;
     }
     batchAndResults.push_back(std::move(rst));
   }
 
+  std::vector<util::PackedBitVector> packedBatchAndResults;
+  packedBatchAndResults.reserve(packedBatchAnds.size());
+  for (size_t i = 0; i < packedBatchAnds.size(); i++) {
+    auto batchSize = packedBatchAnds[i].getLeft().size();
+    packedBatchAndResults.push_back(results.slice(index, batchSize));
+    index += batchSize;
+  }
+
+  index = 0;
   for (size_t i = 0; i < compositeAnds.size(); i++) {
     auto outputSize = compositeAnds[i].getRights().size();
     std::vector<bool> rst(outputSize);
     for (size_t j = 0; j < outputSize; j++) {
-      bool val = tuples.at(index).getC() ^
-          (openedSecrets.at(2 * index) & tuples.at(index).getB()) ^
-          (openedSecrets.at(2 * index + 1) & tuples.at(index).getA());
-      if (myId_ == 0) {
-        val = val ^
-            (openedSecrets.at(2 * index) & openedSecrets.at(2 * index + 1));
-      }
-      rst[j] = (val);
+      rst[j] = compositeResults.get(index);
       index++;
     }
     compositeAndResults.push_back(std::move(rst));
   }
 
   for (size_t i = 0; i < batchCompositeAnds.size(); i++) {
-    auto& leftValues = batchCompositeAnds[i].getLeft();
-    auto batchSize = leftValues.size();
+    auto batchSize = batchCompositeAnds[i].getLeft().size();
     auto outputSize = batchCompositeAnds[i].getRights().size();
-    std::vector<std::vector<bool>> compositeResult(outputSize);
-    for (int j = 0; j < outputSize; j++) {
-      std::vector<bool> innerBatchResult(batchSize);
-      for (int k = 0; k < batchSize; k++) {
-        bool val = tuples.at(index).getC() ^
-            (openedSecrets.at(2 * index) & tuples.at(index).getB()) ^
-            (openedSecrets.at(2 * index + 1) & tuples.at(index).getA());
-        if (myId_ == 0) {
-          val = val ^
-              (openedSecrets.at(2 * index) & openedSecrets.at(2 * index + 1));
-        }
-        innerBatchResult[k] = val;
+    std::vector<std::vector<bool>> compositeResult(
+        outputSize, std::vector<bool>(batchSize));
+    for (size_t k = 0; k < batchSize; k++) {
+      for (size_t j = 0; j < outputSize; j++) {
+        compositeResult[j][k] = compositeResults.get(index);
         index++;
       }
-      compositeResult[j] = std::move(innerBatchResult);
     }
     compositeBatchAndResults.push_back(std::move(compositeResult));
   }
@@ -455,6 +996,7 @@ SecretShareEngine::computeAllANDsFromScheduledANDs(
   return {
       andResults,
       batchAndResults,
+      packedBatchAndResults,
       compositeAndResults,
       compositeBatchAndResults};
 }
@@ -465,4 +1007,16 @@ std::vector<bool> SecretShareEngine::revealToParty(
   return communicationAgent_->openSecretsToParty(id, output);
 }
 
+util::PackedBitVector SecretShareEngine::revealToParty(
+    int id,
+    const util::PackedBitVector& output) const {
+  return communicationAgent_->openSecretsToParty(id, output);
+}
+
+std::vector<uint64_t> SecretShareEngine::revealToParty(
+    int id,
+    const std::vector<uint64_t>& output) const {
+  return communicationAgent_->openSecretsToParty(id, output);
+}
+
 } // namespace fbpcf::engine
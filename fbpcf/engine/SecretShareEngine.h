@@ -12,6 +12,7 @@
 
 #include "fbpcf/engine/ISecretShareEngine.h"
 #include "fbpcf/engine/communication/ISecretShareEngineCommunicationAgent.h"
+#include "fbpcf/engine/tuple_generator/IArithmeticTupleGenerator.h"
 #include "fbpcf/engine/tuple_generator/ITupleGenerator.h"
 #include "fbpcf/engine/util/IPrgFactory.h"
 
@@ -25,7 +26,9 @@ class SecretShareEngine final : public ISecretShareEngine {
           communicationAgent,
       std::unique_ptr<util::IPrgFactory> prgFactory,
       int myId,
-      int numberOfParty);
+      int numberOfParty,
+      std::unique_ptr<tuple_generator::IArithmeticTupleGenerator>
+          arithmeticTupleGenerator = nullptr);
 
   /**
    * @inherit doc
@@ -37,6 +40,18 @@ class SecretShareEngine final : public ISecretShareEngine {
    */
   std::vector<bool> setBatchInput(int id, const std::vector<bool>& v) override;
 
+  /**
+   * @inherit doc
+   */
+  uint64_t setIntegerInput(int id, std::optional<uint64_t> v) override;
+
+  /**
+   * @inherit doc
+   */
+  std::vector<uint64_t> setBatchIntegerInput(
+      int id,
+      const std::vector<uint64_t>& v) override;
+
   /**
    * @inherit doc
    */
@@ -97,6 +112,90 @@ class SecretShareEngine final : public ISecretShareEngine {
       const std::vector<bool>& left,
       const std::vector<bool>& right) const override;
 
+  //======== Below are free integer computation API's: ========
+
+  /**
+   * @inherit doc
+   */
+  uint64_t computeSymmetricPlus(uint64_t left, uint64_t right) const override;
+
+  /**
+   * @inherit doc
+   */
+  std::vector<uint64_t> computeBatchSymmetricPlus(
+      const std::vector<uint64_t>& left,
+      const std::vector<uint64_t>& right) const override;
+
+  /**
+   * @inherit doc
+   */
+  uint64_t computeAsymmetricPlus(uint64_t left, uint64_t right) const override;
+
+  /**
+   * @inherit doc
+   */
+  std::vector<uint64_t> computeBatchAsymmetricPlus(
+      const std::vector<uint64_t>& left,
+      const std::vector<uint64_t>& right) const override;
+
+  /**
+   * @inherit doc
+   */
+  uint64_t computeNeg(uint64_t input) const override;
+
+  /**
+   * @inherit doc
+   */
+  std::vector<uint64_t> computeBatchNeg(
+      const std::vector<uint64_t>& input) const override;
+
+  /**
+   * @inherit doc
+   */
+  uint64_t computeFreeMult(uint64_t left, uint64_t right) const override;
+
+  /**
+   * @inherit doc
+   */
+  std::vector<uint64_t> computeBatchFreeMult(
+      const std::vector<uint64_t>& left,
+      const std::vector<uint64_t>& right) const override;
+
+  //======== Below are packed batch computation API's: ========
+
+  /**
+   * @inherit doc
+   */
+  util::PackedBitVector computeBatchSymmetricXOR(
+      const util::PackedBitVector& left,
+      const util::PackedBitVector& right) const override;
+
+  /**
+   * @inherit doc
+   */
+  util::PackedBitVector computeBatchAsymmetricXOR(
+      const util::PackedBitVector& left,
+      const util::PackedBitVector& right) const override;
+
+  /**
+   * @inherit doc
+   */
+  util::PackedBitVector computeBatchSymmetricNOT(
+      const util::PackedBitVector& input) const override;
+
+  /**
+   * @inherit doc
+   */
+  util::PackedBitVector computeBatchAsymmetricNOT(
+      const util::PackedBitVector& input) const override;
+
+  /**
+   * @inherit doc
+   */
+  util::PackedBitVector computeBatchFreeAND(
+      const util::PackedBitVector& left,
+      const util::PackedBitVector& right) const override;
+
   //======== Below are API's to schedule non-free AND's: ========
 
   /**
@@ -111,6 +210,13 @@ class SecretShareEngine final : public ISecretShareEngine {
       const std::vector<bool>& left,
       const std::vector<bool>& right) override;
 
+  /**
+   * @inherit doc
+   */
+  uint32_t scheduleBatchAND(
+      const util::PackedBitVector& left,
+      const util::PackedBitVector& right) override;
+
   /**
    * @inherit doc
    */
@@ -130,6 +236,25 @@ class SecretShareEngine final : public ISecretShareEngine {
    */
   void executeScheduledAND() override;
 
+  /**
+   * @inherit doc
+   */
+  std::future<void> executeScheduledANDAsync() override;
+
+  /**
+   * @inherit doc
+   */
+  void prefetchANDTuples(uint64_t numberOfANDs) override {
+    tupleGenerator_->prefetchBooleanTuples(numberOfANDs);
+  }
+
+  /**
+   * @inherit doc
+   */
+  std::chrono::nanoseconds getTupleStarvationTime() const override {
+    return tupleGenerator_->getStarvationTime();
+  }
+
   /**
    * @inherit doc
    */
@@ -137,6 +262,79 @@ class SecretShareEngine final : public ISecretShareEngine {
       const std::vector<bool>& left,
       const std::vector<bool>& right) override;
 
+  //======== Below are API's for non-free integer multiplications: ========
+
+  /**
+   * @inherit doc
+   */
+  uint32_t scheduleMult(uint64_t left, uint64_t right) override;
+
+  /**
+   * @inherit doc
+   */
+  uint32_t scheduleBatchMult(
+      const std::vector<uint64_t>& left,
+      const std::vector<uint64_t>& right) override;
+
+  /**
+   * @inherit doc
+   */
+  void executeScheduledMult() override;
+
+  /**
+   * @inherit doc
+   */
+  uint64_t getMultExecutionResult(uint32_t index) const override;
+
+  /**
+   * @inherit doc
+   */
+  const std::vector<uint64_t>& getBatchMultExecutionResult(
+      uint32_t index) const override;
+
+  //======== Below are API's for share conversions: ========
+
+  /**
+   * @inherit doc
+   */
+  std::vector<bool> computeIntegerToBooleanSummands(
+      uint64_t share,
+      int8_t width) override;
+
+  /**
+   * @inherit doc
+   */
+  std::vector<std::vector<bool>> computeBatchIntegerToBooleanSummands(
+      const std::vector<uint64_t>& shares,
+      int8_t width) override;
+
+  /**
+   * @inherit doc
+   */
+  uint32_t scheduleBooleanToInteger(const std::vector<bool>& bits) override;
+
+  /**
+   * @inherit doc
+   */
+  uint32_t scheduleBatchBooleanToInteger(
+      const std::vector<std::vector<bool>>& bits) override;
+
+  /**
+   * @inherit doc
+   */
+  void executeScheduledBooleanToInteger() override;
+
+  /**
+   * @inherit doc
+   */
+  uint64_t getBooleanToIntegerExecutionResult(uint32_t index) const override;
+
+  /**
+   * @inherit doc
+   */
+  const std::vector<uint64_t>& getBatchBooleanToIntegerExecutionResult(
+      uint32_t index) const override;
+
   //======== Below are API's to retrieve non-free AND results: ========
 
   /**
@@ -150,6 +348,12 @@ class SecretShareEngine final : public ISecretShareEngine {
   const std::vector<bool>& getBatchANDExecutionResult(
       uint32_t index) const override;
 
+  /**
+   * @inherit doc
+   */
+  const util::PackedBitVector& getPackedBatchANDExecutionResult(
+      uint32_t index) const override;
+
   /**
    * @inherit doc
    */
@@ -168,12 +372,31 @@ class SecretShareEngine final : public ISecretShareEngine {
   std::vector<bool> revealToParty(int id, const std::vector<bool>& output)
       const override;
 
+  /**
+   * @inherit doc
+   */
+  util::PackedBitVector revealToParty(
+      int id,
+      const util::PackedBitVector& output) const override;
+
+  /**
+   * @inherit doc
+   */
+  std::vector<uint64_t> revealToParty(
+      int id,
+      const std::vector<uint64_t>& output) const override;
+
   /**
    * @inherit doc
    */
   std::pair<uint64_t, uint64_t> getTrafficStatistics() const override {
     auto onlineCost = communicationAgent_->getTrafficStatistics();
     auto offlineCost = tupleGenerator_->getTrafficStatistics();
+    if (arithmeticTupleGenerator_ != nullptr) {
+      auto arithmeticCost = arithmeticTupleGenerator_->getTrafficStatistics();
+      offlineCost.first += arithmeticCost.first;
+      offlineCost.second += arithmeticCost.second;
+    }
     return {
         onlineCost.first + offlineCost.first,
         onlineCost.second + offlineCost.second};
@@ -183,6 +406,7 @@ class SecretShareEngine final : public ISecretShareEngine {
   struct ExecutionResults {
     std::vector<bool> andResults;
     std::vector<std::vector<bool>> batchANDResults;
+    std::vector<util::PackedBitVector> packedBatchANDResults;
     std::vector<std::vector<bool>> compositeANDResults;
     std::vector<std::vector<std::vector<bool>>> compositeBatchANDResults;
   };
@@ -234,6 +458,32 @@ class SecretShareEngine final : public ISecretShareEngine {
     std::vector<bool> right_;
   };
 
+  class ScheduledPackedBatchAND {
+   public:
+    ScheduledPackedBatchAND(
+        const util::PackedBitVector& left,
+        const util::PackedBitVector& right)
+        : left_(left), right_(right) {}
+
+    explicit ScheduledPackedBatchAND(const ScheduledPackedBatchAND&) = default;
+    ScheduledPackedBatchAND(ScheduledPackedBatchAND&&) = default;
+    ScheduledPackedBatchAND& operator=(const ScheduledPackedBatchAND&) =
+        delete;
+    ScheduledPackedBatchAND& operator=(ScheduledPackedBatchAND&&) = delete;
+
+    const util::PackedBitVector& getLeft() const {
+      return left_;
+    }
+
+    const util::PackedBitVector& getRight() const {
+      return right_;
+    }
+
+   private:
+    util::PackedBitVector left_;
+    util::PackedBitVector right_;
+  };
+
   class ScheduledCompositeAND {
    public:
     ScheduledCompositeAND(bool left, std::vector<bool>& rights)
@@ -285,9 +535,23 @@ class SecretShareEngine final : public ISecretShareEngine {
     std::vector<std::vector<bool>> rights_;
   };
 
+  struct IntegerExecutionResults {
+    std::vector<uint64_t> results;
+    std::vector<std::vector<uint64_t>> batchResults;
+  };
+
+  // Beaver multiplication of all the given pairs within one roundtrip.
+  std::vector<uint64_t> computeMults(
+      const std::vector<uint64_t>& left,
+      const std::vector<uint64_t>& right);
+
+  // convert all the given bits to integers (0 or 1) within one roundtrip.
+  std::vector<uint64_t> computeBitsToIntegers(const std::vector<bool>& bits);
+
   ExecutionResults computeAllANDsFromScheduledANDs(
       std::vector<ScheduledAND>& ands,
       std::vector<ScheduledBatchAND>& batchAnds,
+      std::vector<ScheduledPackedBatchAND>& packedBatchAnds,
       std::vector<ScheduledCompositeAND>& compositeAnds,
       std::vector<ScheduledBatchCompositeAND>& batchCompositeAnds);
 
@@ -295,6 +559,9 @@ class SecretShareEngine final : public ISecretShareEngine {
   std::unique_ptr<communication::ISecretShareEngineCommunicationAgent>
       communicationAgent_;
   std::unique_ptr<util::IPrgFactory> prgFactory_;
+  // only needed for multiplications between private integers
+  std::unique_ptr<tuple_generator::IArithmeticTupleGenerator>
+      arithmeticTupleGenerator_;
 
   int myId_;
   int numberOfParty_;
@@ -313,10 +580,23 @@ class SecretShareEngine final : public ISecretShareEngine {
   // memory arena to speed up
   std::vector<ScheduledAND> scheduledANDGates_;
   std::vector<ScheduledBatchAND> scheduledBatchANDGates_;
+  std::vector<ScheduledPackedBatchAND> scheduledPackedBatchANDGates_;
   std::vector<ScheduledCompositeAND> scheduledCompositeANDGates_;
   std::vector<ScheduledBatchCompositeAND> scheduledBatchCompositeANDGates_;
 
+  // the operands of the scheduled multiplications
+  std::vector<uint64_t> scheduledMultLeft_;
+  std::vector<uint64_t> scheduledMultRight_;
+  std::vector<std::pair<std::vector<uint64_t>, std::vector<uint64_t>>>
+      scheduledBatchMults_;
+
+  // the bits of the scheduled boolean to integer conversions
+  std::vector<std::vector<bool>> scheduledBooleanToIntegers_;
+  std::vector<std::vector<std::vector<bool>>> scheduledBatchBooleanToIntegers_;
+
   ExecutionResults executionResults_;
+  IntegerExecutionResults multExecutionResults_;
+  IntegerExecutionResults booleanToIntegerExecutionResults_;
 };
 
 } // namespace fbpcf::engine
@@ -6,9 +6,11 @@
  */
 
 #pragma once
+#include <algorithm>
 #include <cstdint>
 #include <memory>
 #include <optional>
+#include <stdexcept>
 #include <vector>
 
 #include "fbpcf/engine/ISecretShareEngineFactory.h"
@@ -16,18 +18,24 @@
 #include "fbpcf/engine/communication/AgentMapHelper.h"
 #include "fbpcf/engine/communication/IPartyCommunicationAgentFactory.h"
 #include "fbpcf/engine/communication/SecretShareEngineCommunicationAgent.h"
+#include "fbpcf/engine/tuple_generator/DummyArithmeticTupleGeneratorFactory.h"
 #include "fbpcf/engine/tuple_generator/DummyTupleGeneratorFactory.h"
+#include "fbpcf/engine/tuple_generator/IArithmeticTupleGeneratorFactory.h"
 #include "fbpcf/engine/tuple_generator/ITupleGeneratorFactory.h"
 #include "fbpcf/engine/tuple_generator/ProductShareGenerator.h"
 #include "fbpcf/engine/tuple_generator/ProductShareGeneratorFactory.h"
 #include "fbpcf/engine/tuple_generator/TupleGeneratorFactory.h"
+#include "fbpcf/engine/tuple_generator/TwoPartyArithmeticTupleGeneratorFactory.h"
 #include "fbpcf/engine/tuple_generator/TwoPartyTupleGeneratorFactory.h"
 #include "fbpcf/engine/tuple_generator/oblivious_transfer/RcotBasedBidirectionObliviousTransferFactory.h"
 #include "fbpcf/engine/tuple_generator/oblivious_transfer/RcotHelper.h"
+#include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/LpnParameter.h"
 #include "fbpcf/engine/util/AesPrgFactory.h"
 
 namespace fbpcf::engine {
 
+const size_t kSecureEngineTupleBufferSize = 1600000;
+
 /**
  * This factory creates a secure secret share MPC engine, provided underlying
  * factories create secure components.
@@ -37,6 +45,8 @@ namespace fbpcf::engine {
  * as a blackbox). A side note: none of these components address any security
  * concerns outside the world of MPC. Therefore threats like man-in-the-middle
  * need to be addressed with other methods separately.
+ * The arithmetic tuple generator factory is optional, the engines it creates
+ * can only multiply private integers if it's provided.
  */
 class SecretShareEngineFactory final : public ISecretShareEngineFactory {
  public:
@@ -46,8 +56,12 @@ class SecretShareEngineFactory final : public ISecretShareEngineFactory {
       communication::IPartyCommunicationAgentFactory& communicationAgentFactory,
       std::unique_ptr<util::IPrgFactory> prgFactoryCreator(),
       int myId,
-      int numberOfParty)
+      int numberOfParty,
+      std::unique_ptr<tuple_generator::IArithmeticTupleGeneratorFactory>
+          arithmeticTupleGeneratorFactory = nullptr)
       : tupleGeneratorFactory_(std::move(tupleGeneratorFactory)),
+        arithmeticTupleGeneratorFactory_(
+            std::move(arithmeticTupleGeneratorFactory)),
         communicationAgentFactory_(communicationAgentFactory),
         prgFactoryCreator_(std::move(prgFactoryCreator)),
         myId_(myId),
@@ -57,18 +71,28 @@ class SecretShareEngineFactory final : public ISecretShareEngineFactory {
     auto agentMap = communication::getAgentMap(
         numberOfParty_, myId_, communicationAgentFactory_);
 
+    // all parties need to create the tuple generators in the same order.
+    auto tupleGenerator = tupleGeneratorFactory_->create();
+    std::unique_ptr<tuple_generator::IArithmeticTupleGenerator>
+        arithmeticTupleGenerator = arithmeticTupleGeneratorFactory_ == nullptr
+        ? nullptr
+        : arithmeticTupleGeneratorFactory_->create();
+
     return std::make_unique<SecretShareEngine>(
-        tupleGeneratorFactory_->create(),
+        std::move(tupleGenerator),
         std::make_unique<communication::SecretShareEngineCommunicationAgent>(
             myId_, std::move(agentMap)),
         prgFactoryCreator_(),
         myId_,
-        numberOfParty_);
+        numberOfParty_,
+        std::move(arithmeticTupleGenerator));
   }
 
  private:
   std::unique_ptr<tuple_generator::ITupleGeneratorFactory>
       tupleGeneratorFactory_;
+  std::unique_ptr<tuple_generator::IArithmeticTupleGeneratorFactory>
+      arithmeticTupleGeneratorFactory_;
   communication::IPartyCommunicationAgentFactory& communicationAgentFactory_;
   std::function<std::unique_ptr<util::IPrgFactory>()> prgFactoryCreator_;
   int myId_;
@@ -81,7 +105,9 @@ getEngineFactoryWithTupleGeneratorFactory(
     int numberOfParty,
     communication::IPartyCommunicationAgentFactory& communicationAgentFactory,
     std::unique_ptr<tuple_generator::ITupleGeneratorFactory>
-        tupleGeneratorFactory) {
+        tupleGeneratorFactory,
+    std::unique_ptr<tuple_generator::IArithmeticTupleGeneratorFactory>
+        arithmeticTupleGeneratorFactory = nullptr) {
   return std::make_unique<SecretShareEngineFactory>(
       std::move(tupleGeneratorFactory),
       communicationAgentFactory,
@@ -89,7 +115,8 @@ getEngineFactoryWithTupleGeneratorFactory(
         return std::make_unique<util::AesPrgFactory>();
       },
       myId,
-      numberOfParty);
+      numberOfParty,
+      std::move(arithmeticTupleGeneratorFactory));
 }
 
 template <class T>
@@ -100,9 +127,11 @@ getSecureEngineFactoryWithRcotFactory(
     communication::IPartyCommunicationAgentFactory& communicationAgentFactory,
     std::unique_ptr<tuple_generator::oblivious_transfer::
                         IRandomCorrelatedObliviousTransferFactory>
-        rcotFactory) {
-  size_t bufferSize = 1600000;
-
+        rcotFactory,
+    std::unique_ptr<tuple_generator::IArithmeticTupleGeneratorFactory>
+        arithmeticTupleGeneratorFactory = nullptr,
+    size_t bufferSize = kSecureEngineTupleBufferSize,
+    bool enableCompositeTupleGeneration = false) {
   std::unique_ptr<tuple_generator::ITupleGeneratorFactory>
       tupleGeneratorFactory;
 
@@ -112,7 +141,8 @@ getSecureEngineFactoryWithRcotFactory(
             std::move(rcotFactory),
             communicationAgentFactory,
             myId,
-            bufferSize);
+            bufferSize,
+            enableCompositeTupleGeneration);
   } else {
     auto biDirectionOtFactory =
         std::make_unique<tuple_generator::oblivious_transfer::
@@ -138,42 +168,125 @@ getSecureEngineFactoryWithRcotFactory(
       myId,
       numberOfParty,
       communicationAgentFactory,
-      std::move(tupleGeneratorFactory));
+      std::move(tupleGeneratorFactory),
+      std::move(arithmeticTupleGeneratorFactory));
+}
+/**
+ * The FERRET LPN parameters and the tuple buffer size for a job that expects
+ * the given number of AND gates. The buffer never exceeds a single extension,
+ * so the first batch of tuples doesn't wait for several extensions.
+ */
+inline std::
+    pair<tuple_generator::oblivious_transfer::ferret::LpnParameter, size_t>
+    getFerretSettings(std::optional<uint64_t> expectedAndCount) {
+  if (!expectedAndCount.has_value()) {
+    return {
+        tuple_generator::oblivious_transfer::ferret::kLargeLpnParameter,
+        kSecureEngineTupleBufferSize};
+  }
+  auto parameter = tuple_generator::oblivious_transfer::ferret::
+      selectLpnParameter(expectedAndCount.value());
+  return {
+      parameter,
+      std::min<size_t>(
+          kSecureEngineTupleBufferSize,
+          tuple_generator::oblivious_transfer::ferret::getExtensionOutputSize(
+              parameter))};
 }
+
 /**
  * create a secure engine that utilizes FERRET protocol
  * this function must be called by all parties at the same time since it
  * contains inter-party communication
+ * @param expectedAndCount an optional hint of how many AND gates the job
+ * evaluates, used to pick the FERRET parameters. All parties must pass the
+ * same hint.
+ * @param enableCompositeTupleGeneration whether two parties generate composite
+ * tuples, so the left value of a composite AND is only opened once.
  */
 template <class T>
 inline std::unique_ptr<SecretShareEngineFactory>
 getSecureEngineFactoryWithFERRET(
     int myId,
     int numberOfParty,
-    communication::IPartyCommunicationAgentFactory& communicationAgentFactory) {
+    communication::IPartyCommunicationAgentFactory& communicationAgentFactory,
+    std::optional<uint64_t> expectedAndCount = std::nullopt,
+    bool enableCompositeTupleGeneration = false) {
+  auto [parameter, bufferSize] = getFerretSettings(expectedAndCount);
+  return getSecureEngineFactoryWithRcotFactory<T>(
+      myId,
+      numberOfParty,
+      communicationAgentFactory,
+      tuple_generator::oblivious_transfer::createFerretRcotFactory(parameter),
+      nullptr,
+      bufferSize,
+      enableCompositeTupleGeneration);
+}
+
+/**
+ * create a secure engine that utilizes FERRET protocol and is also able to
+ * multiply private integers. Only two parties are supported. The integer
+ * tuples are generated from a separate set of FERRET RCOT's, each tuple takes
+ * 64 RCOT's.
+ * this function must be called by all parties at the same time since it
+ * contains inter-party communication
+ * @param expectedAndCount an optional hint of how many AND gates the job
+ * evaluates, it only affects the FERRET RCOT's for the boolean tuples.
+ * @param enableCompositeTupleGeneration whether to generate composite tuples
+ * for the boolean AND gates.
+ */
+template <class T>
+inline std::unique_ptr<SecretShareEngineFactory>
+getSecureArithmeticEngineFactoryWithFERRET(
+    int myId,
+    int numberOfParty,
+    communication::IPartyCommunicationAgentFactory& communicationAgentFactory,
+    std::optional<uint64_t> expectedAndCount = std::nullopt,
+    bool enableCompositeTupleGeneration = false) {
+  if (numberOfParty != 2) {
+    throw std::invalid_argument(
+        "Only two parties can multiply private integers for now.");
+  }
+  // each integer tuple takes 64 RCOT's, thus a smaller buffer is used.
+  uint64_t arithmeticBufferSize = 160000;
+  auto [parameter, bufferSize] = getFerretSettings(expectedAndCount);
   return getSecureEngineFactoryWithRcotFactory<T>(
       myId,
       numberOfParty,
       communicationAgentFactory,
-      tuple_generator::oblivious_transfer::createFerretRcotFactory());
+      tuple_generator::oblivious_transfer::createFerretRcotFactory(parameter),
+      std::make_unique<
+          tuple_generator::TwoPartyArithmeticTupleGeneratorFactory>(
+          tuple_generator::oblivious_transfer::createFerretRcotFactory(),
+          communicationAgentFactory,
+          myId,
+          arithmeticBufferSize),
+      bufferSize,
+      enableCompositeTupleGeneration);
 }
 
 /**
  * create a secure engine that utilizes classic OT protocol
  * this function must be called by all parties at the same time since it
  * contains inter-party commuication
+ * @param enableCompositeTupleGeneration whether two parties generate composite
+ * tuples.
  */
 template <class T>
 inline std::unique_ptr<SecretShareEngineFactory>
 getSecureEngineFactoryWithClassicOt(
     int myId,
     int numberOfParty,
-    communication::IPartyCommunicationAgentFactory& communicationAgentFactory) {
+    communication::IPartyCommunicationAgentFactory& communicationAgentFactory,
+    bool enableCompositeTupleGeneration = false) {
   return getSecureEngineFactoryWithRcotFactory<T>(
       myId,
       numberOfParty,
       communicationAgentFactory,
-      tuple_generator::oblivious_transfer::createClassicRcotFactory());
+      tuple_generator::oblivious_transfer::createClassicRcotFactory(),
+      nullptr,
+      kSecureEngineTupleBufferSize,
+      enableCompositeTupleGeneration);
 }
 
 /**
@@ -191,8 +304,9 @@ getInsecureEngineFactoryWithDummyTupleGenerator(
       myId,
       numberOfParty,
       communicationAgentFactory,
+      std::make_unique<tuple_generator::insecure::DummyTupleGeneratorFactory>(),
       std::make_unique<
-          tuple_generator::insecure::DummyTupleGeneratorFactory>());
+          tuple_generator::insecure::DummyArithmeticTupleGeneratorFactory>());
 }
 
 } // namespace fbpcf::engine
@@ -7,9 +7,12 @@
 
 #pragma once
 #include <emmintrin.h>
+#include <cstdint>
 #include <map>
 #include <vector>
 
+#include "fbpcf/engine/util/PackedBitVector.h"
+
 namespace fbpcf::engine::communication {
 
 /**
@@ -50,6 +53,47 @@ class ISecretShareEngineCommunicationAgent {
       int id,
       const std::vector<bool>& secretShares) = 0;
 
+  /**
+   * Jointly open a vector of packed secrets to every party. The shares are
+   * sent a word at a time instead of bit by bit.
+   * @param secretShares my share of the secrets
+   * @return the revealed secrets
+   */
+  virtual util::PackedBitVector openSecretsToAll(
+      const util::PackedBitVector& secretShares) = 0;
+
+  /**
+   * Jointly open a vector of packed secrets to a particular party.
+   * @param id the the party to receive the secrets.
+   * @param secretShares my share of the secrets
+   * @return the revealed secrets if this party is designed to received them;
+   * otherwise a vector of zeros
+   */
+  virtual util::PackedBitVector openSecretsToParty(
+      int id,
+      const util::PackedBitVector& secretShares) = 0;
+
+  /**
+   * Jointly open a vector of additively shared (mod 2^64) integers to every
+   * party.
+   * @param secretShares my share of the secrets
+   * @return the revealed secrets
+   */
+  virtual std::vector<uint64_t> openSecretsToAll(
+      const std::vector<uint64_t>& secretShares) = 0;
+
+  /**
+   * Jointly open a vector of additively shared (mod 2^64) integers to a
+   * particular party.
+   * @param id the the party to receive the secrets.
+   * @param secretShares my share of the secrets
+   * @return the revealed secrets if this party is designed to received them;
+   * otherwise an array of dummy values
+   */
+  virtual std::vector<uint64_t> openSecretsToParty(
+      int id,
+      const std::vector<uint64_t>& secretShares) = 0;
+
   /**
    * Get the total amount of traffic transmitted.
    * @return a pair of (sent, received) data in bytes.
@@ -12,6 +12,28 @@
 #include "fbpcf/engine/communication/SecretShareEngineCommunicationAgent.h"
 
 namespace fbpcf::engine::communication {
+
+namespace {
+
+// Only the bytes that hold bits are sent, the bits beyond size() are zero.
+void sendPackedBits(
+    IPartyCommunicationAgent& agent,
+    const util::PackedBitVector& bits) {
+  auto data = reinterpret_cast<const unsigned char*>(bits.data());
+  agent.send(std::vector<unsigned char>(data, data + (bits.size() + 7) / 8));
+}
+
+util::PackedBitVector receivePackedBits(
+    IPartyCommunicationAgent& agent,
+    size_t size) {
+  util::PackedBitVector rst(size);
+  auto received = agent.receive((size + 7) / 8);
+  memcpy(rst.data(), received.data(), received.size());
+  return rst;
+}
+
+} // namespace
+
 std::map<int, __m128i> SecretShareEngineCommunicationAgent::exchangeKeys(
     const std::map<int, __m128i>& keys) {
   std::map<int, __m128i> rst;
@@ -61,6 +83,80 @@ std::vector<bool> SecretShareEngineCommunicationAgent::openSecretsToParty(
   }
 }
 
+util::PackedBitVector SecretShareEngineCommunicationAgent::openSecretsToAll(
+    const util::PackedBitVector& secretShares) {
+  util::PackedBitVector rst = secretShares;
+
+  // exchange the share with all the peers
+  for (auto& iter : agentMap_) {
+    util::PackedBitVector receivedShares;
+    if (iter.first < myId_) {
+      sendPackedBits(*iter.second, secretShares);
+      receivedShares = receivePackedBits(*iter.second, secretShares.size());
+    } else {
+      receivedShares = receivePackedBits(*iter.second, secretShares.size());
+      sendPackedBits(*iter.second, secretShares);
+    }
+    rst ^= receivedShares;
+  }
+  return rst;
+}
+
+util::PackedBitVector SecretShareEngineCommunicationAgent::openSecretsToParty(
+    int id,
+    const util::PackedBitVector& secretShares) {
+  if (id == myId_) {
+    util::PackedBitVector rst = secretShares;
+    for (auto& iter : agentMap_) {
+      rst ^= receivePackedBits(*iter.second, secretShares.size());
+    }
+    return rst;
+  } else {
+    sendPackedBits(*agentMap_.at(id), secretShares);
+    return util::PackedBitVector(secretShares.size());
+  }
+}
+
+std::vector<uint64_t> SecretShareEngineCommunicationAgent::openSecretsToAll(
+    const std::vector<uint64_t>& secretShares) {
+  std::vector<uint64_t> rst = secretShares;
+  std::vector<uint64_t> receivedShares;
+
+  // exchange the share with all the peers
+  for (auto& iter : agentMap_) {
+    if (iter.first < myId_) {
+      iter.second->sendT<uint64_t>(secretShares);
+      receivedShares = iter.second->receiveT<uint64_t>(secretShares.size());
+    } else {
+      receivedShares = iter.second->receiveT<uint64_t>(secretShares.size());
+      iter.second->sendT<uint64_t>(secretShares);
+    }
+    for (size_t i = 0; i < rst.size(); i++) {
+      rst[i] += receivedShares[i];
+    }
+  }
+  return rst;
+}
+
+std::vector<uint64_t> SecretShareEngineCommunicationAgent::openSecretsToParty(
+    int id,
+    const std::vector<uint64_t>& secretShares) {
+  if (id == myId_) {
+    std::vector<uint64_t> rst = secretShares;
+    for (auto& iter : agentMap_) {
+      auto receivedShares =
+          iter.second->receiveT<uint64_t>(secretShares.size());
+      for (size_t i = 0; i < rst.size(); i++) {
+        rst[i] += receivedShares[i];
+      }
+    }
+    return rst;
+  } else {
+    agentMap_.at(id)->sendT<uint64_t>(secretShares);
+    return std::vector<uint64_t>(secretShares.size());
+  }
+}
+
 std::pair<uint64_t, uint64_t>
 SecretShareEngineCommunicationAgent::getTrafficStatistics() const {
   uint64_t sent = 0;
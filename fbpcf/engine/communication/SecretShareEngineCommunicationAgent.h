@@ -45,6 +45,32 @@ class SecretShareEngineCommunicationAgent final
       int id,
       const std::vector<bool>& secretShares) override;
 
+  /**
+   * @inherit doc
+   */
+  util::PackedBitVector openSecretsToAll(
+      const util::PackedBitVector& secretShares) override;
+
+  /**
+   * @inherit doc
+   */
+  util::PackedBitVector openSecretsToParty(
+      int id,
+      const util::PackedBitVector& secretShares) override;
+
+  /**
+   * @inherit doc
+   */
+  std::vector<uint64_t> openSecretsToAll(
+      const std::vector<uint64_t>& secretShares) override;
+
+  /**
+   * @inherit doc
+   */
+  std::vector<uint64_t> openSecretsToParty(
+      int id,
+      const std::vector<uint64_t>& secretShares) override;
+
   /**
    * @inherit doc
    */
@@ -160,4 +160,59 @@ TEST(secretShareEngineCommunicationAgentTest, testOpenToParty) {
   }
 }
 
+void openPackedSecretsTest(
+    std::unique_ptr<SecretShareEngineCommunicationAgent> agent,
+    int myId,
+    int numberOfParty,
+    const std::vector<bool>& secrets,
+    const std::vector<bool>& expections) {
+  util::PackedBitVector packedSecrets(secrets);
+  auto openedToAll = agent->openSecretsToAll(packedSecrets);
+  EXPECT_EQ(openedToAll.toBoolVector(), expections);
+
+  auto openedToParty = agent->openSecretsToParty(1, packedSecrets);
+  if (myId == 1) {
+    EXPECT_EQ(openedToParty.toBoolVector(), expections);
+  } else {
+    EXPECT_EQ(
+        openedToParty.toBoolVector(), std::vector<bool>(secrets.size()));
+  }
+}
+
+TEST(secretShareEngineCommunicationAgentTest, testOpenPackedSecrets) {
+  SecretShareEngineCommunicationAgentTestHelper helper;
+  int numberOfParty = 4;
+  // deliberately not a multiple of the word size
+  int size = 131;
+
+  std::random_device rd;
+  std::mt19937_64 e(rd());
+  std::uniform_int_distribution<uint8_t> dist(0, 1);
+
+  std::vector<std::vector<bool>> secrets(numberOfParty);
+  std::vector<bool> plaintext;
+  for (int i = 0; i < size; i++) {
+    plaintext.push_back(false);
+    for (int j = 0; j < numberOfParty; j++) {
+      secrets[j].push_back(dist(e));
+      plaintext[i] = plaintext[i] ^ secrets[j][i];
+    }
+  }
+
+  auto agents = helper.createAgents(numberOfParty);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < numberOfParty; i++) {
+    threads.push_back(std::thread(
+        openPackedSecretsTest,
+        std::move(agents[i]),
+        i,
+        numberOfParty,
+        secrets[i],
+        plaintext));
+  }
+  for (int i = 0; i < numberOfParty; i++) {
+    threads[i].join();
+  }
+}
+
 } // namespace fbpcf::engine::communication
@@ -10,6 +10,7 @@
 #include <regex.h>
 #include <functional>
 #include <future>
+#include <limits>
 #include <memory>
 #include <random>
 #include <thread>
@@ -20,9 +21,16 @@
 #include "fbpcf/engine/SecretShareEngine.h"
 #include "fbpcf/engine/SecretShareEngineFactory.h"
 #include "fbpcf/engine/communication/test/AgentFactoryCreationHelper.h"
+#include "fbpcf/engine/tuple_generator/test/TupleGeneratorTestHelper.h"
 
 namespace fbpcf::engine {
 
+using TupleGeneratorFactoryCreator =
+    std::unique_ptr<tuple_generator::ITupleGeneratorFactory>(
+        int numberOfParty,
+        int myId,
+        communication::IPartyCommunicationAgentFactory& agentFactory);
+
 template <typename T>
 T testHelper(
     int numberOfParty,
@@ -30,18 +38,29 @@ T testHelper(
         T(std::unique_ptr<ISecretShareEngine> engine,
           int myId,
           int numberOfParty)> test,
-    void (*assertPartyResultsConsistent)(T base, T comparison)) {
+    void (*assertPartyResultsConsistent)(T base, T comparison),
+    TupleGeneratorFactoryCreator* tupleGeneratorFactoryCreator = nullptr) {
   auto agentFactories = communication::getInMemoryAgentFactory(numberOfParty);
 
   std::vector<std::future<T>> futures;
   for (auto i = 0; i < numberOfParty; ++i) {
     futures.push_back(std::async(
-        [i, numberOfParty, test](
+        [i, numberOfParty, test, tupleGeneratorFactoryCreator](
             std::reference_wrapper<
                 communication::IPartyCommunicationAgentFactory> agentFactory) {
-          auto engine = getInsecureEngineFactoryWithDummyTupleGenerator(
-                            i, numberOfParty, agentFactory)
-                            ->create();
+          // the dummy tuple generator always produces (0, 0, 0), use a real
+          // tuple generator to test with random tuples.
+          auto engine = tupleGeneratorFactoryCreator == nullptr
+              ? getInsecureEngineFactoryWithDummyTupleGenerator(
+                    i, numberOfParty, agentFactory)
+                    ->create()
+              : getEngineFactoryWithTupleGeneratorFactory(
+                    i,
+                    numberOfParty,
+                    agentFactory,
+                    tupleGeneratorFactoryCreator(
+                        numberOfParty, i, agentFactory))
+                    ->create();
           return test(std::move(engine), i, numberOfParty);
         },
         std::reference_wrapper<communication::IPartyCommunicationAgentFactory>(
@@ -386,9 +405,11 @@ TEST(SecretShareEngineTest, TestBatchXORWithDummyComponents) {
   }
 }
 
-std::pair<std::vector<bool>, std::vector<std::vector<bool>>> ANDTestBody(
+std::pair<std::vector<bool>, std::vector<std::vector<bool>>>
+ANDTestBodyWithExecution(
     ISecretShareEngine& engine,
-    const std::vector<bool>& inputs) {
+    const std::vector<bool>& inputs,
+    bool executeAsync) {
   auto size = inputs.size();
   EXPECT_EQ(size % 16, 0);
 
@@ -476,7 +497,14 @@ std::pair<std::vector<bool>, std::vector<std::vector<bool>>> ANDTestBody(
   auto batchCompositeIndex2 =
       engine.scheduleBatchCompositeAND(leftComposite3, rightComposite3);
 
-  engine.executeScheduledAND();
+  if (executeAsync) {
+    auto pendingANDs = engine.executeScheduledANDAsync();
+    // the scheduled ANDs are taken over by the pending execution
+    EXPECT_EQ(engine.scheduleAND(true, false), 0);
+    pendingANDs.get();
+  } else {
+    engine.executeScheduledAND();
+  }
 
   // Regular AND
   std::vector<bool> andResult(size / 2);
@@ -511,15 +539,22 @@ std::pair<std::vector<bool>, std::vector<std::vector<bool>>> ANDTestBody(
   return std::make_pair(andResult, compositeAndResult);
 }
 
-TEST(SecretShareEngineTest, TestANDWithDummyComponents) {
-  int numberOfParty = 4;
-  int size = 16384;
-  auto inputs = generateRandomInputs(numberOfParty, size, size);
+std::pair<std::vector<bool>, std::vector<std::vector<bool>>> ANDTestBody(
+    ISecretShareEngine& engine,
+    const std::vector<bool>& inputs) {
+  return ANDTestBodyWithExecution(engine, inputs, false);
+}
 
-  auto rst = testHelper(
-      numberOfParty,
-      testTemplate(inputs, ANDTestBody),
-      assertPartyResultsConsistent);
+std::pair<std::vector<bool>, std::vector<std::vector<bool>>> asyncANDTestBody(
+    ISecretShareEngine& engine,
+    const std::vector<bool>& inputs) {
+  return ANDTestBodyWithExecution(engine, inputs, true);
+}
+
+void verifyANDResults(
+    const std::vector<std::pair<bool, int>>& inputs,
+    const std::pair<std::vector<bool>, std::vector<std::vector<bool>>>& rst) {
+  int size = inputs.size();
   auto andResult = std::get<0>(rst);
   auto compositeAndResult = std::get<1>(rst);
   ASSERT_EQ(andResult.size(), 2 * size);
@@ -584,6 +619,197 @@ TEST(SecretShareEngineTest, TestANDWithDummyComponents) {
   }
 }
 
+TEST(SecretShareEngineTest, TestANDWithDummyComponents) {
+  int numberOfParty = 4;
+  int size = 16384;
+  auto inputs = generateRandomInputs(numberOfParty, size, size);
+
+  auto rst = testHelper(
+      numberOfParty,
+      testTemplate(inputs, ANDTestBody),
+      assertPartyResultsConsistent);
+  verifyANDResults(inputs, rst);
+}
+
+TEST(SecretShareEngineTest, TestAsyncANDWithDummyComponents) {
+  int numberOfParty = 2;
+  int size = 16384;
+  auto inputs = generateRandomInputs(numberOfParty, size, size);
+
+  auto rst = testHelper(
+      numberOfParty,
+      testTemplate(inputs, asyncANDTestBody),
+      assertPartyResultsConsistent);
+  verifyANDResults(inputs, rst);
+}
+
+TEST(SecretShareEngineTest, TestANDWithRandomTuples) {
+  int numberOfParty = 3;
+  int size = 16384;
+  auto inputs = generateRandomInputs(numberOfParty, size, size);
+
+  // this generator supports composite tuples
+  auto rst = testHelper(
+      numberOfParty,
+      testTemplate(inputs, ANDTestBody),
+      assertPartyResultsConsistent,
+      tuple_generator::
+          createInMemoryTupleGeneratorFactoryWithDummyProductShareGenerator);
+  verifyANDResults(inputs, rst);
+}
+
+TEST(SecretShareEngineTest, TestANDWithRandomTuplesWithoutCompositeTuples) {
+  int numberOfParty = 2;
+  int size = 16384;
+  auto inputs = generateRandomInputs(numberOfParty, size, size);
+
+  // this generator doesn't support composite tuples, the engine needs to fall
+  // back to regular tuples
+  auto rst = testHelper(
+      numberOfParty,
+      testTemplate(inputs, ANDTestBody),
+      assertPartyResultsConsistent,
+      tuple_generator::
+          createTwoPartyTupleGeneratorFactoryWithDummyRcotWithoutCompositeTuples);
+  verifyANDResults(inputs, rst);
+}
+
+TEST(SecretShareEngineTest, TestANDWithTwoPartyCompositeTuples) {
+  int numberOfParty = 2;
+  int size = 16384;
+  auto inputs = generateRandomInputs(numberOfParty, size, size);
+
+  auto rst = testHelper(
+      numberOfParty,
+      testTemplate(inputs, ANDTestBody),
+      assertPartyResultsConsistent,
+      tuple_generator::createTwoPartyTupleGeneratorFactoryWithDummyRcot);
+  verifyANDResults(inputs, rst);
+}
+
+std::vector<bool> compositeANDTrafficTestBody(
+    ISecretShareEngine& engine,
+    const std::vector<bool>& inputs) {
+  const size_t width = 16;
+  auto batchSize = inputs.size() / (width + 1);
+  std::vector<bool> left(inputs.begin(), inputs.begin() + batchSize);
+  std::vector<std::vector<bool>> rights;
+  for (size_t i = 0; i < width; i++) {
+    rights.push_back(std::vector<bool>(
+        inputs.begin() + (i + 1) * batchSize,
+        inputs.begin() + (i + 2) * batchSize));
+  }
+
+  auto sentBefore = engine.getTrafficStatistics().first;
+  auto index = engine.scheduleBatchCompositeAND(left, rights);
+  engine.executeScheduledAND();
+  auto sent = engine.getTrafficStatistics().first - sentBefore;
+
+  // The left value is only opened once, so this should take roughly
+  // (width + 1) / (2 * width) of the traffic of regular ANDs.
+  auto regularANDTraffic = 2 * width * batchSize / 8;
+  EXPECT_LT(sent, regularANDTraffic * 0.6);
+
+  std::vector<bool> rst;
+  for (auto& item : engine.getBatchCompositeANDExecutionResult(index)) {
+    rst.insert(rst.end(), item.begin(), item.end());
+  }
+  return rst;
+}
+
+TEST(SecretShareEngineTest, TestCompositeANDOpensLeftValueOnce) {
+  int numberOfParty = 2;
+  int batchSize = 1024;
+  int width = 16;
+  int size = batchSize * (width + 1);
+  auto inputs = generateRandomInputs(numberOfParty, size, size);
+
+  auto rst = testHelper(
+      numberOfParty,
+      testTemplate(inputs, compositeANDTrafficTestBody),
+      assertPartyResultsConsistent);
+  ASSERT_EQ(rst.size(), batchSize * width);
+  for (int i = 0; i < width; i++) {
+    for (int j = 0; j < batchSize; j++) {
+      EXPECT_EQ(
+          rst[i * batchSize + j],
+          inputs[j].first & inputs[(i + 1) * batchSize + j].first);
+    }
+  }
+}
+
+// Runs a batch composite AND on engines created with FERRET and returns the
+// number of bytes party 0 sent for it, checking the result along the way.
+uint64_t testCompositeANDWithFERRET(bool enableCompositeTupleGeneration) {
+  const size_t batchSize = 4096;
+  const size_t width = 16;
+  auto size = batchSize * (width + 1);
+  auto inputs = generateRandomInputs(2, size, size);
+  auto agentFactories = communication::getInMemoryAgentFactory(2);
+
+  auto task = [&inputs, enableCompositeTupleGeneration](
+                  communication::IPartyCommunicationAgentFactory& agentFactory,
+                  int myId) {
+    auto engine = getSecureEngineFactoryWithFERRET<bool>(
+                      myId,
+                      2,
+                      agentFactory,
+                      batchSize * width,
+                      enableCompositeTupleGeneration)
+                      ->create();
+    auto setInput = [&engine, myId](const std::pair<bool, int>& input) {
+      return myId == input.second ? engine->setInput(input.second, input.first)
+                                  : engine->setInput(input.second);
+    };
+    std::vector<bool> left;
+    std::vector<std::vector<bool>> rights(width);
+    for (size_t i = 0; i < batchSize; i++) {
+      left.push_back(setInput(inputs[i]));
+      for (size_t j = 0; j < width; j++) {
+        rights[j].push_back(setInput(inputs[(j + 1) * batchSize + i]));
+      }
+    }
+    // the first run sets up the RCOT's, the second one only opens values.
+    engine->scheduleBatchCompositeAND(left, rights);
+    engine->executeScheduledAND();
+
+    auto sentBefore = engine->getTrafficStatistics().first;
+    auto index = engine->scheduleBatchCompositeAND(left, rights);
+    engine->executeScheduledAND();
+    auto sent = engine->getTrafficStatistics().first - sentBefore;
+
+    std::vector<std::vector<bool>> rst;
+    for (auto& item : engine->getBatchCompositeANDExecutionResult(index)) {
+      rst.push_back(engine->revealToParty(0, item));
+    }
+    return std::make_pair(sent, rst);
+  };
+
+  auto future0 = std::async(task, std::ref(*agentFactories.at(0)), 0);
+  auto future1 = std::async(task, std::ref(*agentFactories.at(1)), 1);
+  auto [sent, rst] = future0.get();
+  future1.get();
+
+  EXPECT_EQ(rst.size(), width);
+  for (size_t j = 0; j < width; j++) {
+    for (size_t i = 0; i < batchSize; i++) {
+      EXPECT_EQ(
+          rst[j][i],
+          inputs[i].first & inputs[(j + 1) * batchSize + i].first);
+    }
+  }
+  return sent;
+}
+
+TEST(SecretShareEngineTest, TestCompositeANDWithFERRET) {
+  auto regularTraffic = testCompositeANDWithFERRET(false);
+  auto compositeTraffic = testCompositeANDWithFERRET(true);
+
+  // with composite tuples the left value is only opened once, which takes
+  // (width + 1) / (2 * width) of the traffic of regular tuples.
+  EXPECT_LT(compositeTraffic, regularTraffic * 0.6);
+}
+
 std::vector<bool> FreeANDTestBody(
     ISecretShareEngine& engine,
     const std::vector<bool>& inputs) {
@@ -653,4 +879,534 @@ TEST(SecretShareEngineTest, TestBatchFreeANDWithDummyComponents) {
   }
 }
 
+std::vector<bool> packedBatchSymmetricXORTestBody(
+    ISecretShareEngine& engine,
+    const std::vector<bool>& inputs) {
+  EXPECT_EQ(inputs.size() % 2, 0);
+  auto size = inputs.size();
+  util::PackedBitVector firstHalfInput(
+      std::vector<bool>(inputs.begin(), inputs.begin() + size / 2));
+  util::PackedBitVector secondHalfInput(
+      std::vector<bool>(inputs.begin() + size / 2, inputs.end()));
+
+  return engine.computeBatchSymmetricXOR(firstHalfInput, secondHalfInput)
+      .toBoolVector();
+}
+
+std::vector<bool> packedBatchAsymmetricXORTestBody(
+    ISecretShareEngine& engine,
+    const std::vector<bool>& inputs) {
+  EXPECT_EQ(inputs.size() % 2, 0);
+  auto size = inputs.size();
+  util::PackedBitVector firstHalfInput(
+      std::vector<bool>(inputs.begin(), inputs.begin() + size / 2));
+  util::PackedBitVector secondHalfInput(
+      std::vector<bool>(inputs.begin() + size / 2, inputs.end()));
+
+  return engine.computeBatchAsymmetricXOR(firstHalfInput, secondHalfInput)
+      .toBoolVector();
+}
+
+std::vector<bool> packedBatchSymmetricNOTTestBody(
+    ISecretShareEngine& engine,
+    const std::vector<bool>& inputs) {
+  return engine.computeBatchSymmetricNOT(util::PackedBitVector(inputs))
+      .toBoolVector();
+}
+
+std::vector<bool> packedBatchAsymmetricNOTTestBody(
+    ISecretShareEngine& engine,
+    const std::vector<bool>& inputs) {
+  return engine.computeBatchAsymmetricNOT(util::PackedBitVector(inputs))
+      .toBoolVector();
+}
+
+std::vector<bool> packedBatchFreeANDTestBody(
+    ISecretShareEngine& engine,
+    const std::vector<bool>& inputs) {
+  EXPECT_EQ(inputs.size() % 2, 0);
+  auto size = inputs.size();
+  util::PackedBitVector firstHalfInput(
+      std::vector<bool>(inputs.begin(), inputs.begin() + size / 2));
+  util::PackedBitVector secondHalfInput(
+      std::vector<bool>(inputs.begin() + size / 2, inputs.end()));
+
+  return engine.computeBatchFreeAND(firstHalfInput, secondHalfInput)
+      .toBoolVector();
+}
+
+TEST(SecretShareEngineTest, TestPackedBatchComputationWithDummyComponents) {
+  int numberOfParty = 4;
+  // deliberately not a multiple of the word size
+  int size = 16382;
+  auto inputs1 = generateRandomInputs(numberOfParty, size, size);
+  auto inputs2 = generateRandomInputs(numberOfParty, size, size / 2);
+  auto inputs3 = generateRandomInputs(numberOfParty, size, 0);
+
+  auto xorRst1 = testHelper(
+      numberOfParty,
+      testTemplate(inputs1, packedBatchSymmetricXORTestBody),
+      assertPartyResultsConsistent);
+  auto xorRst2 = testHelper(
+      numberOfParty,
+      testTemplate(inputs2, packedBatchAsymmetricXORTestBody),
+      assertPartyResultsConsistent);
+  auto andRst = testHelper(
+      numberOfParty,
+      testTemplate(inputs2, packedBatchFreeANDTestBody),
+      assertPartyResultsConsistent);
+  auto notRst1 = testHelper(
+      numberOfParty,
+      testTemplate(inputs3, packedBatchSymmetricNOTTestBody, false),
+      assertPartyResultsConsistent);
+  auto notRst2 = testHelper(
+      numberOfParty,
+      testTemplate(inputs1, packedBatchAsymmetricNOTTestBody),
+      assertPartyResultsConsistent);
+
+  ASSERT_EQ(xorRst1.size(), size / 2);
+  ASSERT_EQ(xorRst2.size(), size / 2);
+  ASSERT_EQ(andRst.size(), size / 2);
+  for (int i = 0; i < size / 2; i++) {
+    EXPECT_EQ(xorRst1[i], inputs1[i].first ^ inputs1[i + size / 2].first);
+    EXPECT_EQ(xorRst2[i], inputs2[i].first ^ inputs2[i + size / 2].first);
+    EXPECT_EQ(andRst[i], inputs2[i].first & inputs2[i + size / 2].first);
+  }
+  ASSERT_EQ(notRst1.size(), size);
+  ASSERT_EQ(notRst2.size(), size);
+  for (int i = 0; i < size; i++) {
+    EXPECT_EQ(notRst1[i], !inputs3[i].first);
+    EXPECT_EQ(notRst2[i], !inputs1[i].first);
+  }
+}
+
+std::vector<bool> packedBatchANDTestBody(
+    ISecretShareEngine& engine,
+    const std::vector<bool>& inputs) {
+  auto size = inputs.size() / 2;
+  std::vector<bool> left(inputs.begin(), inputs.begin() + size);
+  std::vector<bool> right(inputs.begin() + size, inputs.end());
+
+  // a regular batch is scheduled in between, the packed batches are indexed
+  // on their own.
+  auto index0 = engine.scheduleBatchAND(
+      util::PackedBitVector(left), util::PackedBitVector(right));
+  auto regularIndex = engine.scheduleBatchAND(left, right);
+  auto index1 = engine.scheduleBatchAND(
+      util::PackedBitVector(right), util::PackedBitVector(left));
+  engine.executeScheduledAND();
+  EXPECT_EQ(index0, 0);
+  EXPECT_EQ(index1, 1);
+
+  auto rst =
+      engine.revealToParty(0, engine.getPackedBatchANDExecutionResult(index0));
+  EXPECT_EQ(
+      rst.toBoolVector(),
+      engine.revealToParty(
+          0, engine.getBatchANDExecutionResult(regularIndex)));
+  rst.append(
+      engine.revealToParty(0, engine.getPackedBatchANDExecutionResult(index1)));
+  return rst.toBoolVector();
+}
+
+void testPackedBatchAND(
+    int numberOfParty,
+    TupleGeneratorFactoryCreator* tupleGeneratorFactoryCreator) {
+  // deliberately not a multiple of the word size
+  int size = 16382;
+  auto inputs = generateRandomInputs(numberOfParty, size, size);
+
+  auto rst = testHelper(
+      numberOfParty,
+      testTemplate(inputs, packedBatchANDTestBody, false),
+      assertPartyResultsConsistent,
+      tupleGeneratorFactoryCreator);
+  ASSERT_EQ(rst.size(), size);
+  for (int i = 0; i < size / 2; i++) {
+    auto expected = inputs[i].first & inputs[i + size / 2].first;
+    EXPECT_EQ(rst[i], expected);
+    EXPECT_EQ(rst[i + size / 2], expected);
+  }
+}
+
+TEST(SecretShareEngineTest, TestPackedBatchANDWithDummyComponents) {
+  testPackedBatchAND(3, nullptr);
+}
+
+TEST(SecretShareEngineTest, TestPackedBatchANDWithRandomTuples) {
+  testPackedBatchAND(
+      2, tuple_generator::createTwoPartyTupleGeneratorFactoryWithDummyRcot);
+}
+
+using ArithmeticTupleGeneratorFactoryCreator =
+    std::unique_ptr<tuple_generator::IArithmeticTupleGeneratorFactory>(
+        int myId,
+        communication::IPartyCommunicationAgentFactory& agentFactory);
+
+std::vector<std::pair<uint64_t, int>> generateRandomIntegerInputs(
+    int numberOfParty,
+    int size,
+    int startOfPublicValues) {
+  std::random_device rd;
+  std::mt19937_64 e(rd());
+  std::uniform_int_distribution<uint64_t> dist(
+      0, std::numeric_limits<uint64_t>().max());
+  std::uniform_int_distribution<uint8_t> partyDist(0, numberOfParty - 1);
+
+  std::vector<std::pair<uint64_t, int>> rst(size);
+  for (int i = 0; i < size; i++) {
+    rst[i] = {dist(e), partyDist(e)};
+  }
+
+  for (int i = startOfPublicValues; i < size; i++) {
+    rst[i].second = numberOfParty + 1;
+  }
+
+  return rst;
+}
+
+// Every party inputs the integers (private ones in a batch and one by one),
+// runs testBody and opens the outputs to party 0.
+std::vector<uint64_t> integerTestHelper(
+    int numberOfParty,
+    const std::vector<std::pair<uint64_t, int>>& inputsArrangement,
+    std::vector<uint64_t> testBody(
+        ISecretShareEngine& engine,
+        const std::vector<uint64_t>&),
+    ArithmeticTupleGeneratorFactoryCreator*
+        arithmeticTupleGeneratorFactoryCreator = nullptr) {
+  auto test = [&inputsArrangement, testBody, numberOfParty](
+                  std::unique_ptr<ISecretShareEngine> engine, int myId) {
+    std::vector<uint64_t> inputs;
+    for (size_t i = 0; i < inputsArrangement.size(); i++) {
+      auto [value, owner] = inputsArrangement[i];
+      if (owner >= numberOfParty) {
+        // a public value
+        inputs.push_back(value);
+      } else if (i % 2 == 0) {
+        inputs.push_back(engine->setIntegerInput(
+            owner, myId == owner ? std::make_optional(value) : std::nullopt));
+      } else {
+        inputs.push_back(
+            engine->setBatchIntegerInput(owner, std::vector<uint64_t>{value})
+                .at(0));
+      }
+    }
+    return engine->revealToParty(0, testBody(*engine, inputs));
+  };
+
+  auto agentFactories = communication::getInMemoryAgentFactory(numberOfParty);
+  std::vector<std::future<std::vector<uint64_t>>> futures;
+  for (auto i = 0; i < numberOfParty; ++i) {
+    futures.push_back(std::async(
+        [i, numberOfParty, test, arithmeticTupleGeneratorFactoryCreator](
+            std::reference_wrapper<
+                communication::IPartyCommunicationAgentFactory> agentFactory) {
+          auto engine = arithmeticTupleGeneratorFactoryCreator == nullptr
+              ? getInsecureEngineFactoryWithDummyTupleGenerator(
+                    i, numberOfParty, agentFactory)
+                    ->create()
+              : getEngineFactoryWithTupleGeneratorFactory(
+                    i,
+                    numberOfParty,
+                    agentFactory,
+                    tuple_generator::createDummyTupleGeneratorFactory(
+                        numberOfParty, i, agentFactory),
+                    arithmeticTupleGeneratorFactoryCreator(i, agentFactory))
+                    ->create();
+          return test(std::move(engine), i);
+        },
+        std::reference_wrapper<communication::IPartyCommunicationAgentFactory>(
+            *agentFactories.at(i))));
+  }
+  auto rst = futures[0].get();
+  for (auto i = 1; i < numberOfParty; ++i) {
+    EXPECT_EQ(futures[i].get().size(), rst.size());
+  }
+  return rst;
+}
+
+// The inputs are laid out as [private | private | public], each part of size
+// inputs.size() / 3.
+std::vector<uint64_t> freeIntegerOperationsTestBody(
+    ISecretShareEngine& engine,
+    const std::vector<uint64_t>& inputs) {
+  auto size = inputs.size() / 3;
+  std::vector<uint64_t> left(inputs.begin(), inputs.begin() + size);
+  std::vector<uint64_t> right(inputs.begin() + size, inputs.begin() + 2 * size);
+  std::vector<uint64_t> constants(inputs.begin() + 2 * size, inputs.end());
+
+  std::vector<uint64_t> rst;
+  for (size_t i = 0; i < size; i++) {
+    rst.push_back(engine.computeSymmetricPlus(left[i], right[i]));
+  }
+  for (size_t i = 0; i < size; i++) {
+    rst.push_back(engine.computeAsymmetricPlus(left[i], constants[i]));
+  }
+  for (size_t i = 0; i < size; i++) {
+    rst.push_back(engine.computeNeg(left[i]));
+  }
+  for (size_t i = 0; i < size; i++) {
+    rst.push_back(engine.computeFreeMult(left[i], constants[i]));
+  }
+  auto appendBatch = [&rst](const std::vector<uint64_t>& batch) {
+    rst.insert(rst.end(), batch.begin(), batch.end());
+  };
+  appendBatch(engine.computeBatchSymmetricPlus(left, right));
+  appendBatch(engine.computeBatchAsymmetricPlus(left, constants));
+  appendBatch(engine.computeBatchNeg(left));
+  appendBatch(engine.computeBatchFreeMult(left, constants));
+  return rst;
+}
+
+TEST(SecretShareEngineTest, TestFreeIntegerOperationsWithDummyComponents) {
+  int numberOfParty = 4;
+  int size = 1024;
+  auto inputs = generateRandomIntegerInputs(numberOfParty, 3 * size, 2 * size);
+
+  auto rst =
+      integerTestHelper(numberOfParty, inputs, freeIntegerOperationsTestBody);
+  ASSERT_EQ(rst.size(), 8 * size);
+  for (int batch = 0; batch < 2; batch++) {
+    auto offset = 4 * size * batch;
+    for (int i = 0; i < size; i++) {
+      auto left = inputs[i].first;
+      auto right = inputs[size + i].first;
+      auto constant = inputs[2 * size + i].first;
+      EXPECT_EQ(rst[offset + i], left + right);
+      EXPECT_EQ(rst[offset + size + i], left + constant);
+      EXPECT_EQ(rst[offset + 2 * size + i], -left);
+      EXPECT_EQ(rst[offset + 3 * size + i], left * constant);
+    }
+  }
+}
+
+// The inputs are laid out as [private | private], the first half of the
+// multiplications are scheduled one by one, the rest in two batches. They are
+// all executed in one roundtrip.
+std::vector<uint64_t> multTestBody(
+    ISecretShareEngine& engine,
+    const std::vector<uint64_t>& inputs) {
+  auto size = inputs.size() / 2;
+  auto half = size / 2;
+  std::vector<uint32_t> indexes;
+  for (size_t i = 0; i < half; i++) {
+    indexes.push_back(engine.scheduleMult(inputs[i], inputs[size + i]));
+  }
+  auto batchIndex0 = engine.scheduleBatchMult(
+      std::vector<uint64_t>(inputs.begin() + half, inputs.begin() + size - 1),
+      std::vector<uint64_t>(
+          inputs.begin() + size + half, inputs.begin() + 2 * size - 1));
+  auto batchIndex1 = engine.scheduleBatchMult(
+      std::vector<uint64_t>(inputs.begin() + size - 1, inputs.begin() + size),
+      std::vector<uint64_t>(inputs.end() - 1, inputs.end()));
+
+  engine.executeScheduledMult();
+
+  std::vector<uint64_t> rst;
+  for (auto index : indexes) {
+    rst.push_back(engine.getMultExecutionResult(index));
+  }
+  auto& batch0 = engine.getBatchMultExecutionResult(batchIndex0);
+  rst.insert(rst.end(), batch0.begin(), batch0.end());
+  auto& batch1 = engine.getBatchMultExecutionResult(batchIndex1);
+  rst.insert(rst.end(), batch1.begin(), batch1.end());
+
+  // nothing is sent if nothing is scheduled
+  auto traffic = engine.getTrafficStatistics();
+  engine.executeScheduledMult();
+  EXPECT_EQ(engine.getTrafficStatistics(), traffic);
+  return rst;
+}
+
+void verifyMultResults(
+    const std::vector<std::pair<uint64_t, int>>& inputs,
+    const std::vector<uint64_t>& rst) {
+  auto size = inputs.size() / 2;
+  ASSERT_EQ(rst.size(), size);
+  for (size_t i = 0; i < size; i++) {
+    EXPECT_EQ(rst[i], inputs[i].first * inputs[size + i].first);
+  }
+}
+
+TEST(SecretShareEngineTest, TestMultWithDummyComponents) {
+  int numberOfParty = 4;
+  int size = 1024;
+  auto inputs = generateRandomIntegerInputs(numberOfParty, 2 * size, 2 * size);
+
+  auto rst = integerTestHelper(numberOfParty, inputs, multTestBody);
+  verifyMultResults(inputs, rst);
+}
+
+TEST(SecretShareEngineTest, TestMultWithTwoPartyArithmeticTuples) {
+  int numberOfParty = 2;
+  int size = 1024;
+  auto inputs = generateRandomIntegerInputs(numberOfParty, 2 * size, 2 * size);
+
+  auto rst = integerTestHelper(
+      numberOfParty,
+      inputs,
+      multTestBody,
+      tuple_generator::
+          createTwoPartyArithmeticTupleGeneratorFactoryWithDummyRcot);
+  verifyMultResults(inputs, rst);
+}
+
+std::vector<uint64_t> multTrafficTestBody(
+    ISecretShareEngine& engine,
+    const std::vector<uint64_t>& inputs) {
+  auto size = inputs.size() / 2;
+  std::vector<uint64_t> left(inputs.begin(), inputs.begin() + size);
+  std::vector<uint64_t> right(inputs.begin() + size, inputs.end());
+
+  auto sentBefore = engine.getTrafficStatistics().first;
+  auto index = engine.scheduleBatchMult(left, right);
+  engine.executeScheduledMult();
+  // the dummy tuple generator doesn't communicate, and each multiplication
+  // opens two integers to the only peer.
+  EXPECT_EQ(
+      engine.getTrafficStatistics().first - sentBefore,
+      2 * size * sizeof(uint64_t));
+  return engine.getBatchMultExecutionResult(index);
+}
+
+TEST(SecretShareEngineTest, TestMultTraffic) {
+  int numberOfParty = 2;
+  int size = 1024;
+  auto inputs = generateRandomIntegerInputs(numberOfParty, 2 * size, 2 * size);
+
+  auto rst = integerTestHelper(numberOfParty, inputs, multTrafficTestBody);
+  verifyMultResults(inputs, rst);
+}
+
+
+// The inputs are all private. The summands of the first half are shared one by
+// one and the rest in a batch, then converted back to integers, which adds up
+// to the inputs. The lowest 16 bits are converted as well.
+std::vector<uint64_t> conversionTestBody(
+    ISecretShareEngine& engine,
+    const std::vector<uint64_t>& inputs) {
+  const int8_t kShortWidth = 16;
+  auto half = inputs.size() / 2;
+  std::vector<uint64_t> batch(inputs.begin() + half, inputs.end());
+
+  std::vector<std::vector<uint32_t>> indexes;
+  for (size_t i = 0; i < half; i++) {
+    indexes.emplace_back();
+    for (auto width : {int8_t(64), kShortWidth}) {
+      auto summands = engine.computeIntegerToBooleanSummands(inputs[i], width);
+      for (size_t j = 0; j < summands.size(); j += width) {
+        indexes.back().push_back(engine.scheduleBooleanToInteger(
+            std::vector<bool>(
+                summands.begin() + j, summands.begin() + j + width)));
+      }
+    }
+  }
+  std::vector<std::vector<uint32_t>> batchIndexes;
+  for (auto width : {int8_t(64), kShortWidth}) {
+    batchIndexes.emplace_back();
+    auto summands = engine.computeBatchIntegerToBooleanSummands(batch, width);
+    for (size_t j = 0; j < summands.size(); j += width) {
+      batchIndexes.back().push_back(engine.scheduleBatchBooleanToInteger(
+          std::vector<std::vector<bool>>(
+              summands.begin() + j, summands.begin() + j + width)));
+    }
+  }
+
+  engine.executeScheduledBooleanToInteger();
+
+  // [full width | lowest 16 bits] for every input
+  std::vector<uint64_t> rst(2 * inputs.size(), 0);
+  auto numberOfParty = indexes.empty() ? 0 : indexes.at(0).size() / 2;
+  for (size_t i = 0; i < half; i++) {
+    for (size_t j = 0; j < indexes.at(i).size(); j++) {
+      rst[(j < numberOfParty ? 0 : inputs.size()) + i] +=
+          engine.getBooleanToIntegerExecutionResult(indexes.at(i).at(j));
+    }
+  }
+  for (size_t w = 0; w < batchIndexes.size(); w++) {
+    for (auto index : batchIndexes.at(w)) {
+      auto& values = engine.getBatchBooleanToIntegerExecutionResult(index);
+      for (size_t i = 0; i < values.size(); i++) {
+        rst[w * inputs.size() + half + i] += values.at(i);
+      }
+    }
+  }
+  return rst;
+}
+
+void verifyConversionResults(
+    const std::vector<std::pair<uint64_t, int>>& inputs,
+    const std::vector<uint64_t>& rst) {
+  ASSERT_EQ(rst.size(), 2 * inputs.size());
+  for (size_t i = 0; i < inputs.size(); i++) {
+    EXPECT_EQ(rst[i], inputs[i].first);
+    // the summands only add up to the input mod 2^16
+    EXPECT_EQ(rst[inputs.size() + i] & 0xFFFF, inputs[i].first & 0xFFFF);
+  }
+}
+
+TEST(SecretShareEngineTest, TestConversionWithDummyComponents) {
+  int numberOfParty = 4;
+  int size = 256;
+  auto inputs = generateRandomIntegerInputs(numberOfParty, size, size);
+
+  auto rst = integerTestHelper(numberOfParty, inputs, conversionTestBody);
+  verifyConversionResults(inputs, rst);
+}
+
+TEST(SecretShareEngineTest, TestConversionWithTwoPartyArithmeticTuples) {
+  int numberOfParty = 2;
+  int size = 256;
+  auto inputs = generateRandomIntegerInputs(numberOfParty, size, size);
+
+  auto rst = integerTestHelper(
+      numberOfParty,
+      inputs,
+      conversionTestBody,
+      tuple_generator::
+          createTwoPartyArithmeticTupleGeneratorFactoryWithDummyRcot);
+  verifyConversionResults(inputs, rst);
+}
+
+std::vector<uint64_t> conversionTrafficTestBody(
+    ISecretShareEngine& engine,
+    const std::vector<uint64_t>& inputs) {
+  auto sentBefore = engine.getTrafficStatistics().first;
+  auto summands = engine.computeBatchIntegerToBooleanSummands(inputs, 64);
+  // sharing the summands is free
+  EXPECT_EQ(engine.getTrafficStatistics().first, sentBefore);
+
+  auto index0 = engine.scheduleBatchBooleanToInteger(
+      std::vector<std::vector<bool>>(summands.begin(), summands.begin() + 64));
+  auto index1 = engine.scheduleBatchBooleanToInteger(
+      std::vector<std::vector<bool>>(summands.begin() + 64, summands.end()));
+  engine.executeScheduledBooleanToInteger();
+  // the dummy tuple generator doesn't communicate, and each bit opens one
+  // bit to the only peer.
+  EXPECT_EQ(
+      engine.getTrafficStatistics().first - sentBefore,
+      2 * 64 * inputs.size() / 8);
+
+  auto rst = engine.getBatchBooleanToIntegerExecutionResult(index0);
+  auto& rst1 = engine.getBatchBooleanToIntegerExecutionResult(index1);
+  for (size_t i = 0; i < rst.size(); i++) {
+    rst[i] += rst1.at(i);
+  }
+  return rst;
+}
+
+TEST(SecretShareEngineTest, TestConversionTraffic) {
+  int numberOfParty = 2;
+  int size = 1024;
+  auto inputs = generateRandomIntegerInputs(numberOfParty, size, size);
+
+  auto rst =
+      integerTestHelper(numberOfParty, inputs, conversionTrafficTestBody);
+  ASSERT_EQ(rst.size(), size);
+  for (int i = 0; i < size; i++) {
+    EXPECT_EQ(rst[i], inputs[i].first);
+  }
+}
+
 } // namespace fbpcf::engine
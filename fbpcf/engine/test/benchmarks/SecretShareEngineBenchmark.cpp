@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <folly/Benchmark.h>
+#include <memory>
+#include <random>
+#include <vector>
+#include "common/init/Init.h"
+
+#include "fbpcf/engine/ISecretShareEngine.h"
+#include "fbpcf/engine/test/SecretShareEngineTestHelper.h"
+#include "fbpcf/engine/util/PackedBitVector.h"
+#include "folly/BenchmarkUtil.h"
+
+namespace fbpcf::engine {
+
+DEFINE_int64(
+    SecretShareEngine_Benchmark_Size,
+    1 << 20,
+    "How many bits are in a batch when benchmarking batch computation");
+
+std::vector<bool> generateRandomBits() {
+  std::random_device rd;
+  std::mt19937_64 e(rd());
+  std::uniform_int_distribution<uint8_t> dist(0, 1);
+
+  // for benchmark, the concrete value doesn't matter;
+  std::vector<bool> rst(FLAGS_SecretShareEngine_Benchmark_Size);
+  for (size_t i = 0; i < rst.size(); i++) {
+    rst[i] = dist(e);
+  }
+  return rst;
+}
+
+// Local computation doesn't need the peers after the engines are created, so
+// we only benchmark party 0's engine.
+class BatchComputationBenchmark {
+ public:
+  BatchComputationBenchmark() {
+    engines_ = helper_.createEnginesWithDummyTupleGenerator(2);
+    left_ = generateRandomBits();
+    right_ = generateRandomBits();
+    packedLeft_ = util::PackedBitVector(left_);
+    packedRight_ = util::PackedBitVector(right_);
+  }
+
+  ISecretShareEngine& engine() {
+    return *engines_.at(0);
+  }
+
+  const std::vector<bool>& left() const {
+    return left_;
+  }
+  const std::vector<bool>& right() const {
+    return right_;
+  }
+  const util::PackedBitVector& packedLeft() const {
+    return packedLeft_;
+  }
+  const util::PackedBitVector& packedRight() const {
+    return packedRight_;
+  }
+
+ private:
+  SecretShareEngineTestHelper helper_;
+  std::vector<std::unique_ptr<ISecretShareEngine>> engines_;
+  std::vector<bool> left_;
+  std::vector<bool> right_;
+  util::PackedBitVector packedLeft_;
+  util::PackedBitVector packedRight_;
+};
+
+BENCHMARK(SecretShareEngine_computeBatchSymmetricXOR, n) {
+  folly::BenchmarkSuspender braces;
+  BatchComputationBenchmark benchmark;
+  braces.dismiss();
+
+  while (n--) {
+    auto rst = benchmark.engine().computeBatchSymmetricXOR(
+        benchmark.left(), benchmark.right());
+    folly::doNotOptimizeAway(rst);
+  }
+}
+
+BENCHMARK_RELATIVE(SecretShareEngine_computeBatchSymmetricXOR_Packed, n) {
+  folly::BenchmarkSuspender braces;
+  BatchComputationBenchmark benchmark;
+  braces.dismiss();
+
+  while (n--) {
+    auto rst = benchmark.engine().computeBatchSymmetricXOR(
+        benchmark.packedLeft(), benchmark.packedRight());
+    folly::doNotOptimizeAway(rst);
+  }
+}
+
+BENCHMARK(SecretShareEngine_computeBatchAsymmetricNOT, n) {
+  folly::BenchmarkSuspender braces;
+  BatchComputationBenchmark benchmark;
+  braces.dismiss();
+
+  while (n--) {
+    auto rst = benchmark.engine().computeBatchAsymmetricNOT(benchmark.left());
+    folly::doNotOptimizeAway(rst);
+  }
+}
+
+BENCHMARK_RELATIVE(SecretShareEngine_computeBatchAsymmetricNOT_Packed, n) {
+  folly::BenchmarkSuspender braces;
+  BatchComputationBenchmark benchmark;
+  braces.dismiss();
+
+  while (n--) {
+    auto rst =
+        benchmark.engine().computeBatchAsymmetricNOT(benchmark.packedLeft());
+    folly::doNotOptimizeAway(rst);
+  }
+}
+
+BENCHMARK(SecretShareEngine_computeBatchFreeAND, n) {
+  folly::BenchmarkSuspender braces;
+  BatchComputationBenchmark benchmark;
+  braces.dismiss();
+
+  while (n--) {
+    auto rst = benchmark.engine().computeBatchFreeAND(
+        benchmark.left(), benchmark.right());
+    folly::doNotOptimizeAway(rst);
+  }
+}
+
+BENCHMARK_RELATIVE(SecretShareEngine_computeBatchFreeAND_Packed, n) {
+  folly::BenchmarkSuspender braces;
+  BatchComputationBenchmark benchmark;
+  braces.dismiss();
+
+  while (n--) {
+    auto rst = benchmark.engine().computeBatchFreeAND(
+        benchmark.packedLeft(), benchmark.packedRight());
+    folly::doNotOptimizeAway(rst);
+  }
+}
+
+// Includes the cost of packing the inputs and unpacking the result, i.e. the
+// cost paid by a caller that still holds std::vector<bool>.
+BENCHMARK_RELATIVE(SecretShareEngine_computeBatchFreeAND_PackedRoundTrip, n) {
+  folly::BenchmarkSuspender braces;
+  BatchComputationBenchmark benchmark;
+  braces.dismiss();
+
+  while (n--) {
+    auto rst = benchmark.engine()
+                   .computeBatchFreeAND(
+                       util::PackedBitVector(benchmark.left()),
+                       util::PackedBitVector(benchmark.right()))
+                   .toBoolVector();
+    folly::doNotOptimizeAway(rst);
+  }
+}
+
+} // namespace fbpcf::engine
+
+int main(int argc, char* argv[]) {
+  facebook::initFacebook(&argc, &argv);
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  folly::runBenchmarks();
+  return 0;
+}
@@ -0,0 +1,32 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+#include "fbpcf/engine/tuple_generator/IArithmeticTupleGenerator.h"
+
+namespace fbpcf::engine::tuple_generator::insecure {
+
+/**
+ A dummy arithmetic tuple generator, always generate tuple (0, 0, 0) and
+ daBit (0, 0)
+ */
+class DummyArithmeticTupleGenerator final : public IArithmeticTupleGenerator {
+ public:
+  std::vector<IntegerTuple> getIntegerTuple(uint32_t size) override {
+    return std::vector<IntegerTuple>(size, IntegerTuple(0, 0, 0));
+  }
+
+  std::vector<DaBit> getDaBit(uint32_t size) override {
+    return std::vector<DaBit>(size, DaBit(false, 0));
+  }
+
+  std::pair<uint64_t, uint64_t> getTrafficStatistics() const override {
+    return {0, 0};
+  }
+};
+
+} // namespace fbpcf::engine::tuple_generator::insecure
@@ -0,0 +1,31 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+#include <memory>
+
+#include "fbpcf/engine/tuple_generator/DummyArithmeticTupleGenerator.h"
+#include "fbpcf/engine/tuple_generator/IArithmeticTupleGeneratorFactory.h"
+
+namespace fbpcf::engine::tuple_generator::insecure {
+
+/**
+ * This factory creates dummy arithmetic tuple generators
+ */
+
+class DummyArithmeticTupleGeneratorFactory final
+    : public IArithmeticTupleGeneratorFactory {
+ public:
+  /**
+   * Create a dummy arithmetic tuple generator;
+   */
+  std::unique_ptr<IArithmeticTupleGenerator> create() override {
+    return std::make_unique<DummyArithmeticTupleGenerator>();
+  }
+};
+
+} // namespace fbpcf::engine::tuple_generator::insecure
@@ -11,7 +11,8 @@
 namespace fbpcf::engine::tuple_generator::insecure {
 
 /**
- A dummy boolean tuple generator, always generate tuple (0, 0,0 )
+ A dummy boolean tuple generator, always generate tuple (0, 0,0 ) and
+ composite tuples of all zeros
  */
 class DummyTupleGenerator final : public ITupleGenerator {
  public:
@@ -23,6 +24,40 @@ class DummyTupleGenerator final : public ITupleGenerator {
     return result;
   }
 
+  PackedBooleanTuples getPackedBooleanTuple(uint32_t size) override {
+    return PackedBooleanTuples(
+        util::PackedBitVector(size),
+        util::PackedBitVector(size),
+        util::PackedBitVector(size));
+  }
+
+  void prefetchBooleanTuples(uint64_t size) override {}
+
+  std::chrono::nanoseconds getStarvationTime() const override {
+    return std::chrono::nanoseconds(0);
+  }
+
+  std::map<size_t, std::vector<CompositeBooleanTuple>> getCompositeTuple(
+      const std::map<size_t, uint32_t>& tupleSizes) override {
+    std::map<size_t, std::vector<CompositeBooleanTuple>> result;
+    for (auto& countOfTuples : tupleSizes) {
+      auto tupleSize = countOfTuples.first;
+      result.emplace(
+          tupleSize,
+          std::vector<CompositeBooleanTuple>(
+              countOfTuples.second,
+              CompositeBooleanTuple(
+                  0,
+                  std::vector<bool>(tupleSize, 0),
+                  std::vector<bool>(tupleSize, 0))));
+    }
+    return result;
+  }
+
+  bool supportsCompositeTupleGeneration() override {
+    return true;
+  }
+
   std::pair<uint64_t, uint64_t> getTrafficStatistics() const override {
     return {0, 0};
   }
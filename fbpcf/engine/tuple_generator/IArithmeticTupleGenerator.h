@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+
+namespace fbpcf::engine::tuple_generator {
+
+/**
+ The arithmetic tuple generator API, all values are in Z_2^64.
+ */
+class IArithmeticTupleGenerator {
+ public:
+  virtual ~IArithmeticTupleGenerator() = default;
+
+  /**
+   * This is an arithmetic version multiplicative triple. This object
+   * represents the shares hold by one party, e.g. the share of a, b and their
+   * product c = a * b mod 2^64.
+   */
+  class IntegerTuple {
+   public:
+    IntegerTuple() {}
+
+    IntegerTuple(uint64_t a, uint64_t b, uint64_t c) : a_{a}, b_{b}, c_{c} {}
+
+    // get the first share
+    uint64_t getA() const {
+      return a_;
+    }
+
+    // get the second share
+    uint64_t getB() const {
+      return b_;
+    }
+
+    // get the third share
+    uint64_t getC() const {
+      return c_;
+    }
+
+   private:
+    uint64_t a_;
+    uint64_t b_;
+    uint64_t c_;
+  };
+
+  /**
+   * A doubly-shared random bit (daBit): this object represents the shares of
+   * a random bit r hold by one party, both as a boolean (XOR) share and as an
+   * integer share in Z_2^64. They are used to convert boolean secrets to
+   * integer secrets.
+   */
+  class DaBit {
+   public:
+    DaBit() {}
+
+    DaBit(bool booleanShare, uint64_t integerShare)
+        : booleanShare_{booleanShare}, integerShare_{integerShare} {}
+
+    // get the boolean share of r
+    bool getBooleanShare() const {
+      return booleanShare_;
+    }
+
+    // get the integer share of r
+    uint64_t getIntegerShare() const {
+      return integerShare_;
+    }
+
+   private:
+    bool booleanShare_;
+    uint64_t integerShare_;
+  };
+
+  /**
+   * Generate a number of integer tuples.
+   * @param size number of tuples to generate.
+   */
+  virtual std::vector<IntegerTuple> getIntegerTuple(uint32_t size) = 0;
+
+  /**
+   * Generate a number of daBits.
+   * @param size number of daBits to generate.
+   */
+  virtual std::vector<DaBit> getDaBit(uint32_t size) = 0;
+
+  /**
+   * Get the total amount of traffic transmitted.
+   * @return a pair of (sent, received) data in bytes.
+   */
+  virtual std::pair<uint64_t, uint64_t> getTrafficStatistics() const = 0;
+};
+
+} // namespace fbpcf::engine::tuple_generator
@@ -0,0 +1,29 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+#include <memory>
+
+#include "fbpcf/engine/tuple_generator/IArithmeticTupleGenerator.h"
+
+namespace fbpcf::engine::tuple_generator {
+
+/**
+ * This is the API for a factory that creates arithmetic tuple generators.
+ */
+
+class IArithmeticTupleGeneratorFactory {
+ public:
+  virtual ~IArithmeticTupleGeneratorFactory() = default;
+
+  /**
+   * Create an arithmetic tuple generator with all party.
+   */
+  virtual std::unique_ptr<IArithmeticTupleGenerator> create() = 0;
+};
+
+} // namespace fbpcf::engine::tuple_generator
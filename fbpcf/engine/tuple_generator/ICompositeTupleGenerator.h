@@ -0,0 +1,44 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <map>
+#include <vector>
+
+#include "fbpcf/engine/tuple_generator/ITupleGenerator.h"
+
+namespace fbpcf::engine::tuple_generator {
+
+/**
+ * The composite tuple generator API. A composite tuple of size n is a share of
+ * a, b_0, ..., b_{n-1} and c_i = a & b_i. Generators implementing this API can
+ * produce a whole family of products at a cost that doesn't grow linearly with
+ * the number of independent tuples in that family.
+ */
+class ICompositeTupleGenerator {
+ public:
+  virtual ~ICompositeTupleGenerator() = default;
+
+  /**
+   * Get a number of composite tuples for each requested size.
+   * @param tupleSizes a map from the size of a composite tuple to how many
+   * tuples of that size are needed
+   * @return a map from the size of a composite tuple to the tuples
+   */
+  virtual std::map<size_t, std::vector<ITupleGenerator::CompositeBooleanTuple>>
+  getCompositeTuple(const std::map<size_t, uint32_t>& tupleSizes) = 0;
+
+  /**
+   * Get the total amount of traffic transmitted.
+   * @return a pair of (sent, received) data in bytes.
+   */
+  virtual std::pair<uint64_t, uint64_t> getTrafficStatistics() const = 0;
+};
+
+} // namespace fbpcf::engine::tuple_generator
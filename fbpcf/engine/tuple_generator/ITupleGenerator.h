@@ -8,8 +8,13 @@
 #pragma once
 
 #include <stdint.h>
+#include <chrono>
+#include <map>
+#include <stdexcept>
 #include <vector>
 
+#include "fbpcf/engine/util/PackedBitVector.h"
+
 namespace fbpcf::engine::tuple_generator {
 
 const uint64_t kDefaultBufferSize = 16384;
@@ -55,12 +60,154 @@ class ITupleGenerator {
     unsigned char value_;
   };
 
+  /**
+   * A batch of boolean tuples stored as three bit planes: the i-th tuple is
+   * (getA()[i], getB()[i], getC()[i]). Compared with a vector of BooleanTuple,
+   * this takes 3 bits per tuple instead of 8 and lets the engine mask and
+   * reconstruct a whole word of tuples at once.
+   */
+  class PackedBooleanTuples {
+   public:
+    PackedBooleanTuples() {}
+
+    PackedBooleanTuples(
+        util::PackedBitVector a,
+        util::PackedBitVector b,
+        util::PackedBitVector c)
+        : a_(std::move(a)), b_(std::move(b)), c_(std::move(c)) {
+      if (a_.size() != b_.size() || a_.size() != c_.size()) {
+        throw std::invalid_argument("The sizes of the planes are not equal.");
+      }
+    }
+
+    size_t size() const {
+      return a_.size();
+    }
+
+    // get the plane of first shares
+    const util::PackedBitVector& getA() const {
+      return a_;
+    }
+
+    // get the plane of second shares
+    const util::PackedBitVector& getB() const {
+      return b_;
+    }
+
+    // get the plane of third shares
+    const util::PackedBitVector& getC() const {
+      return c_;
+    }
+
+    /**
+     * Append tuples [offset, offset + length) of src to this batch.
+     */
+    void append(const PackedBooleanTuples& src, size_t offset, size_t length) {
+      a_.append(src.a_, offset, length);
+      b_.append(src.b_, offset, length);
+      c_.append(src.c_, offset, length);
+    }
+
+    /**
+     * Convert to the one-tuple-per-byte representation.
+     */
+    std::vector<BooleanTuple> toBooleanTuples() const {
+      std::vector<BooleanTuple> rst(size());
+      for (size_t i = 0; i < rst.size(); i++) {
+        rst[i] = BooleanTuple(a_.get(i), b_.get(i), c_.get(i));
+      }
+      return rst;
+    }
+
+   private:
+    util::PackedBitVector a_;
+    util::PackedBitVector b_;
+    util::PackedBitVector c_;
+  };
+
+  /**
+   * This is a boolean composite tuple: one share of a single bit a, and shares
+   * of b_i and c_i = a & b_i for i in [0, size). It allows ANDing one secret
+   * with many secrets while only opening the masked left value once.
+   */
+  class CompositeBooleanTuple {
+   public:
+    CompositeBooleanTuple() {}
+
+    CompositeBooleanTuple(bool a, std::vector<bool> b, std::vector<bool> c)
+        : a_{a}, b_{std::move(b)}, c_{std::move(c)} {
+      if (b_.size() != c_.size()) {
+        throw std::invalid_argument("The sizes of b and c are not equal.");
+      }
+    }
+
+    // get the shared first share
+    bool getA() const {
+      return a_;
+    }
+
+    // get the second shares
+    const std::vector<bool>& getB() const {
+      return b_;
+    }
+
+    // get the third shares
+    const std::vector<bool>& getC() const {
+      return c_;
+    }
+
+    size_t size() const {
+      return b_.size();
+    }
+
+   private:
+    bool a_;
+    std::vector<bool> b_;
+    std::vector<bool> c_;
+  };
+
   /**
    * Generate a number of boolean tuples.
    * @param size number of tuples to generate.
    */
   virtual std::vector<BooleanTuple> getBooleanTuple(uint32_t size) = 0;
 
+  /**
+   * Generate composite boolean tuples.
+   * @param tupleSizes a map from composite size (number of b_i's) to the
+   * number of composite tuples of that size to generate.
+   * @return a map from composite size to the generated tuples.
+   */
+  virtual std::map<size_t, std::vector<CompositeBooleanTuple>>
+  getCompositeTuple(const std::map<size_t, uint32_t>& tupleSizes) = 0;
+
+  /**
+   * Whether getCompositeTuple is supported. If not, callers need to fall back
+   * to one regular tuple per b_i.
+   */
+  virtual bool supportsCompositeTupleGeneration() = 0;
+
+  /**
+   * Generate a number of boolean tuples in bit plane form.
+   * @param size number of tuples to generate.
+   */
+  virtual PackedBooleanTuples getPackedBooleanTuple(uint32_t size) = 0;
+
+  /**
+   * Hint that the next requests will take this many boolean tuples in total,
+   * so that they can be generated ahead instead of when they are requested.
+   * All parties need to give the same hints at the same points, as the tuples
+   * are generated jointly.
+   * @param size number of tuples to generate ahead.
+   */
+  virtual void prefetchBooleanTuples(uint64_t size) = 0;
+
+  /**
+   * Get how long the requests for boolean tuples were blocked waiting for
+   * the tuples to be generated.
+   */
+  virtual std::chrono::nanoseconds getStarvationTime() const = 0;
+
   /**
    * Get the total amount of traffic transmitted.
    * @return a pair of (sent, received) data in bytes.
@@ -24,6 +24,11 @@ TupleGenerator::TupleGenerator(
 
 std::vector<ITupleGenerator::BooleanTuple> TupleGenerator::getBooleanTuple(
     uint32_t size) {
+  return asyncBuffer_.getData(size).toBooleanTuples();
+}
+
+ITupleGenerator::PackedBooleanTuples TupleGenerator::getPackedBooleanTuple(
+    uint32_t size) {
   return asyncBuffer_.getData(size);
 }
 
@@ -34,26 +39,91 @@ std::vector<ITupleGenerator::BooleanTuple> TupleGenerator::getBooleanTuple(
  * Party i and j will randomly choose ai, bi and aj, bj and use the product
  * share generator to generate shares of aibj+ajbi
  */
-std::vector<TupleGenerator::BooleanTuple> TupleGenerator::generateTuples(
+ITupleGenerator::PackedBooleanTuples TupleGenerator::generateTuples(
     uint64_t size) {
-  auto vectorA = prg_->getRandomBits(size);
-  auto vectorB = prg_->getRandomBits(size);
-  std::vector<bool> vectorC(size, false);
+  auto bitsA = prg_->getRandomBits(size);
+  auto bitsB = prg_->getRandomBits(size);
+  util::PackedBitVector vectorA(bitsA);
+  util::PackedBitVector vectorB(bitsB);
+  util::PackedBitVector vectorC = vectorA & vectorB;
 
   for (auto& item : productShareGeneratorMap_) {
-    auto shares = item.second->generateBooleanProductShares(vectorA, vectorB);
+    auto shares = item.second->generateBooleanProductShares(bitsA, bitsB);
     assert(shares.size() == size);
-    for (size_t i = 0; i < size; i++) {
-      vectorC[i] = vectorC[i] ^ shares[i];
-    }
+    vectorC ^= util::PackedBitVector(shares);
   }
 
-  std::vector<TupleGenerator::BooleanTuple> booleanTuples(size);
-  for (size_t i = 0; i < size; i++) {
-    booleanTuples[i] = BooleanTuple(
-        vectorA[i], vectorB[i], (vectorA[i] & vectorB[i]) ^ vectorC[i]);
+  return PackedBooleanTuples(
+      std::move(vectorA), std::move(vectorB), std::move(vectorC));
+}
+
+std::map<size_t, std::vector<ITupleGenerator::CompositeBooleanTuple>>
+TupleGenerator::getCompositeTuple(
+    const std::map<size_t, uint32_t>& tupleSizes) {
+  // The product share generators are shared with the background generation,
+  // so composite tuples must be generated in between two buffer refills.
+  return asyncBuffer_.runExclusively(
+      [this, &tupleSizes]() { return generateCompositeTuples(tupleSizes); });
+}
+
+/**
+ * Composite tuple generation is the same as regular tuple generation, except
+ * that every party uses the same a_i for all b_i's in one composite tuple.
+ * Therefore the product shares are computed on a vector of a's where each a is
+ * repeated tupleSize times.
+ */
+std::map<size_t, std::vector<ITupleGenerator::CompositeBooleanTuple>>
+TupleGenerator::generateCompositeTuples(
+    const std::map<size_t, uint32_t>& tupleSizes) {
+  std::map<size_t, std::vector<CompositeBooleanTuple>> rst;
+  for (auto& countOfTuples : tupleSizes) {
+    auto tupleSize = countOfTuples.first;
+    auto tupleCount = countOfTuples.second;
+    auto totalSize = tupleSize * tupleCount;
+    if (totalSize == 0) {
+      rst.emplace(
+          tupleSize,
+          std::vector<CompositeBooleanTuple>(
+              tupleCount,
+              CompositeBooleanTuple(
+                  0,
+                  std::vector<bool>(tupleSize),
+                  std::vector<bool>(tupleSize))));
+      continue;
+    }
+
+    auto vectorA = prg_->getRandomBits(tupleCount);
+    auto vectorB = prg_->getRandomBits(totalSize);
+    std::vector<bool> expandedA(totalSize);
+    for (size_t i = 0; i < totalSize; i++) {
+      expandedA[i] = vectorA[i / tupleSize];
+    }
+    util::PackedBitVector vectorC =
+        util::PackedBitVector(expandedA) & util::PackedBitVector(vectorB);
+
+    for (auto& item : productShareGeneratorMap_) {
+      auto shares =
+          item.second->generateBooleanProductShares(expandedA, vectorB);
+      assert(shares.size() == totalSize);
+      vectorC ^= util::PackedBitVector(shares);
+    }
+
+    std::vector<CompositeBooleanTuple> tuples;
+    tuples.reserve(tupleCount);
+    for (size_t i = 0; i < tupleCount; i++) {
+      std::vector<bool> b(
+          vectorB.begin() + i * tupleSize,
+          vectorB.begin() + (i + 1) * tupleSize);
+      std::vector<bool> c(tupleSize);
+      for (size_t j = 0; j < tupleSize; j++) {
+        c[j] = vectorC.get(i * tupleSize + j);
+      }
+      tuples.push_back(
+          CompositeBooleanTuple(vectorA[i], std::move(b), std::move(c)));
+    }
+    rst.emplace(tupleSize, std::move(tuples));
   }
-  return booleanTuples;
+  return rst;
 }
 
 std::pair<uint64_t, uint64_t> TupleGenerator::getTrafficStatistics() const {
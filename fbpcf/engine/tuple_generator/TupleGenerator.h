@@ -39,16 +39,51 @@ class TupleGenerator final : public ITupleGenerator {
    */
   std::vector<BooleanTuple> getBooleanTuple(uint32_t size) override;
 
+  /**
+   * @inherit doc
+   */
+  PackedBooleanTuples getPackedBooleanTuple(uint32_t size) override;
+
+  /**
+   * @inherit doc
+   */
+  void prefetchBooleanTuples(uint64_t size) override {
+    asyncBuffer_.prefetch(size);
+  }
+
+  /**
+   * @inherit doc
+   */
+  std::chrono::nanoseconds getStarvationTime() const override {
+    return asyncBuffer_.getWaitTime();
+  }
+
+  /**
+   * @inherit doc
+   */
+  std::map<size_t, std::vector<CompositeBooleanTuple>> getCompositeTuple(
+      const std::map<size_t, uint32_t>& tupleSizes) override;
+
+  /**
+   * @inherit doc
+   */
+  bool supportsCompositeTupleGeneration() override {
+    return true;
+  }
+
   std::pair<uint64_t, uint64_t> getTrafficStatistics() const override;
 
  private:
-  inline std::vector<BooleanTuple> generateTuples(uint64_t size);
+  inline PackedBooleanTuples generateTuples(uint64_t size);
+
+  std::map<size_t, std::vector<CompositeBooleanTuple>> generateCompositeTuples(
+      const std::map<size_t, uint32_t>& tupleSizes);
 
   std::map<int, std::unique_ptr<IProductShareGenerator>>
       productShareGeneratorMap_;
   std::unique_ptr<util::IPrg> prg_;
 
-  util::AsyncBuffer<BooleanTuple> asyncBuffer_;
+  util::AsyncBuffer<BooleanTuple, PackedBooleanTuples> asyncBuffer_;
 };
 
 } // namespace fbpcf::engine::tuple_generator
@@ -0,0 +1,249 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "fbpcf/engine/tuple_generator/TwoPartyArithmeticTupleGenerator.h"
+
+#include <future>
+
+#include "fbpcf/engine/util/util.h"
+
+namespace fbpcf::engine::tuple_generator {
+
+namespace {
+
+const size_t kBitsPerTuple = 64;
+
+// For the j-th bit of a triple, only the lowest 64 - j bits of the correction
+// affect the product, so corrections are packed back to back with a variable
+// length.
+size_t getPackedSize(uint64_t tupleCount) {
+  // sum of 64 - j over j in [0, 64)
+  const size_t packedBitsPerTuple = kBitsPerTuple * (kBitsPerTuple + 1) / 2;
+  return (tupleCount * packedBitsPerTuple + 63) / 64;
+}
+
+std::vector<uint64_t> packCorrections(const std::vector<uint64_t>& src) {
+  std::vector<uint64_t> rst(getPackedSize(src.size() / kBitsPerTuple), 0);
+  size_t position = 0;
+  for (size_t i = 0; i < src.size(); i++) {
+    size_t length = kBitsPerTuple - i % kBitsPerTuple;
+    auto value =
+        length == 64 ? src[i] : src[i] & ((uint64_t(1) << length) - 1);
+    auto offset = position % 64;
+    rst[position / 64] |= value << offset;
+    if (offset + length > 64) {
+      rst[position / 64 + 1] |= value >> (64 - offset);
+    }
+    position += length;
+  }
+  return rst;
+}
+
+// The unpacked values are only correct in their lowest 64 - j bits.
+std::vector<uint64_t> unpackCorrections(
+    const std::vector<uint64_t>& src,
+    uint64_t tupleCount) {
+  std::vector<uint64_t> rst(tupleCount * kBitsPerTuple);
+  size_t position = 0;
+  for (size_t i = 0; i < rst.size(); i++) {
+    size_t length = kBitsPerTuple - i % kBitsPerTuple;
+    auto offset = position % 64;
+    rst[i] = src[position / 64] >> offset;
+    if (offset + length > 64) {
+      rst[i] |= src[position / 64 + 1] << (64 - offset);
+    }
+    position += length;
+  }
+  return rst;
+}
+
+inline uint64_t getLow64(__m128i src) {
+  return static_cast<uint64_t>(_mm_cvtsi128_si64(src));
+}
+
+} // namespace
+
+TwoPartyArithmeticTupleGenerator::TwoPartyArithmeticTupleGenerator(
+    std::unique_ptr<oblivious_transfer::IRandomCorrelatedObliviousTransfer>
+        senderRcot,
+    std::unique_ptr<oblivious_transfer::IRandomCorrelatedObliviousTransfer>
+        receiverRcot,
+    __m128i delta,
+    std::unique_ptr<communication::IPartyCommunicationAgent> agent,
+    uint64_t bufferSize)
+    : // the key itself is not important as long as it's a pre-agreed value
+      hashFromAes_(util::Aes::getFixedKey()),
+      prg_(util::getRandomM128iFromSystemNoise()),
+      senderRcot_{std::move(senderRcot)},
+      receiverRcot_{std::move(receiverRcot)},
+      delta_{delta},
+      agent_{std::move(agent)},
+      buffer_{bufferSize, [this](uint64_t size) {
+                return generateTuples(size);
+              }} {}
+
+std::vector<IArithmeticTupleGenerator::IntegerTuple>
+TwoPartyArithmeticTupleGenerator::getIntegerTuple(uint32_t size) {
+  return buffer_.getData(size);
+}
+
+std::vector<IArithmeticTupleGenerator::DaBit>
+TwoPartyArithmeticTupleGenerator::getDaBit(uint32_t size) {
+  // daBits share the RCOT's and the channel with the tuple generation, so
+  // they are generated while the buffer isn't generating.
+  return buffer_.runExclusively(
+      [this, size]() { return generateDaBits(size); });
+}
+
+/**
+ * Two party arithmetic tuple generation algorithm (Gilboa's multiplication):
+ *
+ * Party 1 holds random a_1, b_1 and party 2 holds random a_2, b_2, then
+ * (a_1 + a_2) * (b_1 + b_2) = a_1 * b_1 + a_2 * b_2 + a_1 * b_2 + a_2 * b_1,
+ * where the cross products are shared with 64 RCOT's each.
+ *
+ * For a_1 * b_2, party 1 sends k_0 and k_1 = k_0 + delta_1 for every bit j of
+ * b_2, and party 2 receives k_r, where r is used as the j-th bit of b_2. Then
+ * party 1 sends d = h(k_0) - h(k_1) + a_1 so that
+ *   party 2 computes m = h(k_r) + r * d = h(k_0) + r * a_1
+ *   party 1 keeps -h(k_0)
+ * are the shares of r * a_1. Summing them up with weight 2^j gives the shares
+ * of a_1 * b_2. The high bits of d are shifted out by the weight, thus only the
+ * lowest 64 - j bits are sent.
+ *
+ * Both directions run at the same time:
+ *   c_1 = a_1 * b_1 + sum_j 2^j * (-h(k_0)) + sum_j 2^j * (h(l_p) + p * d')
+ * where l and d' come from party 2 as the sender.
+ */
+std::vector<IArithmeticTupleGenerator::IntegerTuple>
+TwoPartyArithmeticTupleGenerator::generateTuples(uint64_t size) {
+  auto otSize = size * kBitsPerTuple;
+  auto receiverMessagesFuture =
+      std::async([otSize, this]() { return receiverRcot_->rcot(otSize); });
+
+  auto sender0Messages = senderRcot_->rcot(otSize);
+
+  std::vector<__m128i> sender1Messages(otSize);
+  for (size_t i = 0; i < otSize; ++i) {
+    sender1Messages[i] = _mm_xor_si128(sender0Messages.at(i), delta_);
+  }
+
+  auto receiverMessages = receiverMessagesFuture.get();
+
+  std::vector<uint64_t> a(size);
+  std::vector<uint64_t> b(size, 0);
+  std::vector<__m128i> randomA((size + 1) / 2);
+  prg_.getRandomDataInPlace(randomA);
+  for (size_t i = 0; i < size; i++) {
+    a[i] = i % 2 == 0 ? getLow64(randomA.at(i / 2))
+                      : static_cast<uint64_t>(
+                            _mm_extract_epi64(randomA.at(i / 2), 1));
+    for (size_t j = 0; j < kBitsPerTuple; j++) {
+      b[i] |= static_cast<uint64_t>(
+                  util::getLsb(receiverMessages.at(i * kBitsPerTuple + j)))
+          << j;
+    }
+  }
+
+  hashFromAes_.inPlaceHash(sender0Messages);
+  hashFromAes_.inPlaceHash(sender1Messages);
+  hashFromAes_.inPlaceHash(receiverMessages);
+
+  std::vector<uint64_t> corrections(otSize);
+  for (size_t i = 0; i < otSize; i++) {
+    corrections[i] = getLow64(sender0Messages.at(i)) -
+        getLow64(sender1Messages.at(i)) + a.at(i / kBitsPerTuple);
+  }
+  agent_->sendT<uint64_t>(packCorrections(corrections));
+  auto receivedCorrections = unpackCorrections(
+      agent_->receiveT<uint64_t>(getPackedSize(size)), size);
+
+  std::vector<IntegerTuple> rst(size);
+  for (size_t i = 0; i < size; i++) {
+    uint64_t c = a.at(i) * b.at(i);
+    for (size_t j = 0; j < kBitsPerTuple; j++) {
+      auto index = i * kBitsPerTuple + j;
+      auto received = getLow64(receiverMessages.at(index));
+      if ((b.at(i) >> j) & 1) {
+        received += receivedCorrections.at(index);
+      }
+      c += (received - getLow64(sender0Messages.at(index))) << j;
+    }
+    rst[i] = IntegerTuple(a.at(i), b.at(i), c);
+  }
+  return rst;
+}
+
+/**
+ * Two party daBit generation algorithm:
+ *
+ * Each party takes the choice bit of an RCOT it receives as its boolean share,
+ * i.e. r = r_1 ^ r_2 and r = r_1 + r_2 - 2 * r_1 * r_2. The product r_1 * r_2
+ * is shared in both directions the same way as the cross products of the
+ * tuples, except that party 1 uses r_1 (instead of a_1) in the correction
+ * d = h(k_0) - h(k_1) + r_1, and vice versa. Summing up the shares of both
+ * directions gives the shares of 2 * r_1 * r_2, thus the integer share of
+ * party 1 is
+ *   r_1 - (-h(k_0)) - (h(l_p) + r_1 * d')
+ * where l and d' come from party 2 as the sender.
+ */
+std::vector<IArithmeticTupleGenerator::DaBit>
+TwoPartyArithmeticTupleGenerator::generateDaBits(uint64_t size) {
+  auto receiverMessagesFuture =
+      std::async([size, this]() { return receiverRcot_->rcot(size); });
+
+  auto sender0Messages = senderRcot_->rcot(size);
+
+  std::vector<__m128i> sender1Messages(size);
+  for (size_t i = 0; i < size; ++i) {
+    sender1Messages[i] = _mm_xor_si128(sender0Messages.at(i), delta_);
+  }
+
+  auto receiverMessages = receiverMessagesFuture.get();
+
+  std::vector<bool> r(size);
+  for (size_t i = 0; i < size; i++) {
+    r[i] = util::getLsb(receiverMessages.at(i));
+  }
+
+  hashFromAes_.inPlaceHash(sender0Messages);
+  hashFromAes_.inPlaceHash(sender1Messages);
+  hashFromAes_.inPlaceHash(receiverMessages);
+
+  std::vector<uint64_t> corrections(size);
+  for (size_t i = 0; i < size; i++) {
+    corrections[i] = getLow64(sender0Messages.at(i)) -
+        getLow64(sender1Messages.at(i)) + static_cast<uint64_t>(r.at(i));
+  }
+  agent_->sendT<uint64_t>(corrections);
+  auto receivedCorrections = agent_->receiveT<uint64_t>(size);
+
+  std::vector<DaBit> rst(size);
+  for (size_t i = 0; i < size; i++) {
+    auto received = getLow64(receiverMessages.at(i));
+    if (r.at(i)) {
+      received += receivedCorrections.at(i);
+    }
+    rst[i] = DaBit(
+        r.at(i),
+        static_cast<uint64_t>(r.at(i)) + getLow64(sender0Messages.at(i)) -
+            received);
+  }
+  return rst;
+}
+
+std::pair<uint64_t, uint64_t>
+TwoPartyArithmeticTupleGenerator::getTrafficStatistics() const {
+  auto rst = agent_->getTrafficStatistics();
+  auto senderStats = senderRcot_->getTrafficStatistics();
+  auto receiverStats = receiverRcot_->getTrafficStatistics();
+  rst.first += senderStats.first + receiverStats.first;
+  rst.second += senderStats.second + receiverStats.second;
+  return rst;
+}
+
+} // namespace fbpcf::engine::tuple_generator
@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <memory>
+
+#include "fbpcf/engine/communication/IPartyCommunicationAgent.h"
+#include "fbpcf/engine/tuple_generator/IArithmeticTupleGenerator.h"
+#include "fbpcf/engine/tuple_generator/ITupleGenerator.h"
+#include "fbpcf/engine/tuple_generator/oblivious_transfer/IRandomCorrelatedObliviousTransfer.h"
+#include "fbpcf/engine/util/AesPrg.h"
+#include "fbpcf/engine/util/AsyncBuffer.h"
+#include "fbpcf/engine/util/aes.h"
+
+namespace fbpcf::engine::tuple_generator {
+
+/**
+ * A two party generator of Z_2^64 multiplicative triples. The cross products
+ * are computed with Gilboa's OT-based multiplication, which takes 64 RCOT's in
+ * each direction per triple. A daBit takes one RCOT in each direction.
+ */
+class TwoPartyArithmeticTupleGenerator final
+    : public IArithmeticTupleGenerator {
+ public:
+  TwoPartyArithmeticTupleGenerator(
+      std::unique_ptr<oblivious_transfer::IRandomCorrelatedObliviousTransfer>
+          senderRcot,
+      std::unique_ptr<oblivious_transfer::IRandomCorrelatedObliviousTransfer>
+          receiverRcot,
+      __m128i delta,
+      std::unique_ptr<communication::IPartyCommunicationAgent> agent,
+      uint64_t bufferSize = kDefaultBufferSize);
+
+  /**
+   * @inherit doc
+   */
+  std::vector<IntegerTuple> getIntegerTuple(uint32_t size) override;
+
+  /**
+   * @inherit doc
+   */
+  std::vector<DaBit> getDaBit(uint32_t size) override;
+
+  /**
+   * @inherit doc
+   */
+  std::pair<uint64_t, uint64_t> getTrafficStatistics() const override;
+
+ private:
+  std::vector<IntegerTuple> generateTuples(uint64_t size);
+
+  std::vector<DaBit> generateDaBits(uint64_t size);
+
+  util::Aes hashFromAes_;
+  util::AesPrg prg_;
+
+  std::unique_ptr<oblivious_transfer::IRandomCorrelatedObliviousTransfer>
+      senderRcot_;
+  std::unique_ptr<oblivious_transfer::IRandomCorrelatedObliviousTransfer>
+      receiverRcot_;
+  __m128i delta_;
+  std::unique_ptr<communication::IPartyCommunicationAgent> agent_;
+
+  util::AsyncBuffer<IntegerTuple> buffer_;
+};
+
+} // namespace fbpcf::engine::tuple_generator
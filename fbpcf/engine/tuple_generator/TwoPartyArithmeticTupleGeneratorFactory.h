@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <memory>
+
+#include "fbpcf/engine/communication/IPartyCommunicationAgentFactory.h"
+#include "fbpcf/engine/tuple_generator/IArithmeticTupleGeneratorFactory.h"
+#include "fbpcf/engine/tuple_generator/TwoPartyArithmeticTupleGenerator.h"
+#include "fbpcf/engine/tuple_generator/oblivious_transfer/IRandomCorrelatedObliviousTransferFactory.h"
+#include "fbpcf/engine/util/util.h"
+
+namespace fbpcf::engine::tuple_generator {
+
+class TwoPartyArithmeticTupleGeneratorFactory final
+    : public IArithmeticTupleGeneratorFactory {
+ public:
+  TwoPartyArithmeticTupleGeneratorFactory(
+      std::unique_ptr<
+          oblivious_transfer::IRandomCorrelatedObliviousTransferFactory>
+          rcotFactory,
+      communication::IPartyCommunicationAgentFactory& agentFactory,
+      int myId,
+      uint64_t bufferSize)
+      : rcotFactory_{std::move(rcotFactory)},
+        agentFactory_{agentFactory},
+        myId_(myId),
+        bufferSize_(bufferSize) {}
+
+  /**
+   * Create a two party arithmetic tuple generator. The RCOT's and the channel
+   * for the corrections are not shared with the boolean tuple generator.
+   */
+  std::unique_ptr<IArithmeticTupleGenerator> create() override {
+    auto delta = util::getRandomM128iFromSystemNoise();
+    util::setLsbTo1(delta);
+
+    // the two parties need to create the RCOT's in the matching order.
+    auto otherId = 1 - myId_;
+    std::unique_ptr<oblivious_transfer::IRandomCorrelatedObliviousTransfer>
+        senderRcot;
+    std::unique_ptr<oblivious_transfer::IRandomCorrelatedObliviousTransfer>
+        receiverRcot;
+    if (myId_ == 0) {
+      senderRcot = rcotFactory_->create(delta, agentFactory_.create(otherId));
+      receiverRcot = rcotFactory_->create(agentFactory_.create(otherId));
+    } else {
+      receiverRcot = rcotFactory_->create(agentFactory_.create(otherId));
+      senderRcot = rcotFactory_->create(delta, agentFactory_.create(otherId));
+    }
+
+    return std::make_unique<TwoPartyArithmeticTupleGenerator>(
+        std::move(senderRcot),
+        std::move(receiverRcot),
+        delta,
+        agentFactory_.create(otherId),
+        bufferSize_);
+  }
+
+ private:
+  std::unique_ptr<oblivious_transfer::IRandomCorrelatedObliviousTransferFactory>
+      rcotFactory_;
+  communication::IPartyCommunicationAgentFactory& agentFactory_;
+  int myId_;
+  uint64_t bufferSize_;
+};
+
+} // namespace fbpcf::engine::tuple_generator
@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <future>
+
+#include "fbpcf/engine/tuple_generator/TwoPartyCompositeTupleGenerator.h"
+#include "fbpcf/engine/util/PackedBitVector.h"
+#include "fbpcf/engine/util/util.h"
+
+namespace fbpcf::engine::tuple_generator {
+
+namespace {
+
+const size_t kBitsPerBlock = 128;
+
+// reinterpret a vector of 128-bit blocks as a bit vector, block i takes bits
+// [128 * i, 128 * (i + 1)).
+util::PackedBitVector toPackedBits(const std::vector<__m128i>& src) {
+  util::PackedBitVector rst(src.size() * kBitsPerBlock);
+  if (!src.empty()) {
+    std::memcpy(rst.data(), src.data(), src.size() * sizeof(__m128i));
+  }
+  return rst;
+}
+
+} // namespace
+
+TwoPartyCompositeTupleGenerator::TwoPartyCompositeTupleGenerator(
+    std::unique_ptr<oblivious_transfer::IRandomCorrelatedObliviousTransfer>
+        senderRcot,
+    std::unique_ptr<oblivious_transfer::IRandomCorrelatedObliviousTransfer>
+        receiverRcot,
+    __m128i delta)
+    : // the key itself is not important as long as it's a pre-agreed value
+      hashFromAes_(util::Aes::getFixedKey()),
+      senderRcot_{std::move(senderRcot)},
+      receiverRcot_{std::move(receiverRcot)},
+      delta_{delta} {}
+
+/**
+ * Two party composite tuple generation algorithm, for a tuple of size n:
+ *
+ * Party 1 sends k_0 and k_1 = k_0 + delta_1 to party 2
+ * Party 2 sends l_0 and l_1 = l_0 + delta_2 to party 1
+ *
+ * Party 1 chooses r and receives l_r from party 2
+ * Party 2 chooses p and receives k_p from party 1
+ *
+ * Let G(x) = h(x ^ 0) || h(x ^ 1) || ... be an n-bit expansion of x.
+ *
+ * Party 1 computes:
+ *   a_1 = r
+ *   b_1 = G(k_0) ^ G(k_1)
+ *   c_1 = (a_1 & b_1) ^ G(k_0) ^ G(l_r)
+ *
+ * Party 2 computes:
+ *   a_2 = p
+ *   b_2 = G(l_0) ^ G(l_1)
+ *   c_2 = (a_2 & b_2) ^ G(l_0) ^ G(k_p)
+ *
+ * Since G(k_p) = G(k_0) ^ (p & b_1) and G(l_r) = G(l_0) ^ (r & b_2):
+ * c_1 ^ c_2 = (r & b_1) ^ (p & b_2) ^ (r & b_2) ^ (p & b_1)
+ *           = (a_1 ^ a_2) & (b_1 ^ b_2)
+ *
+ * Thus every element of b is a product partner of the same a, and the whole
+ * family costs one OT in each direction and no additional communication.
+ */
+std::map<size_t, std::vector<ITupleGenerator::CompositeBooleanTuple>>
+TwoPartyCompositeTupleGenerator::getCompositeTuple(
+    const std::map<size_t, uint32_t>& tupleSizes) {
+  size_t tupleCount = 0;
+  size_t blockCount = 0;
+  for (auto& countOfTuples : tupleSizes) {
+    tupleCount += countOfTuples.second;
+    blockCount += countOfTuples.second *
+        ((countOfTuples.first + kBitsPerBlock - 1) / kBitsPerBlock);
+  }
+
+  std::vector<__m128i> sender0Messages;
+  std::vector<__m128i> receiverMessages;
+  if (tupleCount > 0) {
+    auto receiverMessagesFuture = std::async(
+        [tupleCount, this]() { return receiverRcot_->rcot(tupleCount); });
+    sender0Messages = senderRcot_->rcot(tupleCount);
+    receiverMessages = receiverMessagesFuture.get();
+  }
+
+  // expand every OT message into as many blocks as its tuple needs.
+  std::vector<__m128i> sender0Expansion(blockCount);
+  std::vector<__m128i> sender1Expansion(blockCount);
+  std::vector<__m128i> receiverExpansion(blockCount);
+  util::PackedBitVector expandedA(blockCount * kBitsPerBlock);
+  std::vector<bool> vectorA(tupleCount);
+  size_t index = 0;
+  size_t blockIndex = 0;
+  for (auto& countOfTuples : tupleSizes) {
+    auto blocksPerTuple =
+        (countOfTuples.first + kBitsPerBlock - 1) / kBitsPerBlock;
+    for (size_t i = 0; i < countOfTuples.second; i++) {
+      auto sender0 = sender0Messages.at(index);
+      auto sender1 = _mm_xor_si128(sender0, delta_);
+      auto receiver = receiverMessages.at(index);
+      vectorA[index] = util::getLsb(receiver);
+      for (size_t j = 0; j < blocksPerTuple; j++) {
+        auto tweak = _mm_set_epi64x(0, j);
+        sender0Expansion[blockIndex + j] = _mm_xor_si128(sender0, tweak);
+        sender1Expansion[blockIndex + j] = _mm_xor_si128(sender1, tweak);
+        receiverExpansion[blockIndex + j] = _mm_xor_si128(receiver, tweak);
+      }
+      if (vectorA[index]) {
+        std::fill(
+            expandedA.data() + 2 * blockIndex,
+            expandedA.data() + 2 * (blockIndex + blocksPerTuple),
+            ~util::PackedBitVector::Word(0));
+      }
+      index++;
+      blockIndex += blocksPerTuple;
+    }
+  }
+
+  hashFromAes_.inPlaceHash(sender0Expansion);
+  hashFromAes_.inPlaceHash(sender1Expansion);
+  hashFromAes_.inPlaceHash(receiverExpansion);
+
+  auto sender0Bits = toPackedBits(sender0Expansion);
+  auto vectorB = sender0Bits ^ toPackedBits(sender1Expansion);
+  auto vectorC =
+      (expandedA & vectorB) ^ sender0Bits ^ toPackedBits(receiverExpansion);
+  auto unpackedB = vectorB.toBoolVector();
+  auto unpackedC = vectorC.toBoolVector();
+
+  std::map<size_t, std::vector<ITupleGenerator::CompositeBooleanTuple>> rst;
+  index = 0;
+  blockIndex = 0;
+  for (auto& countOfTuples : tupleSizes) {
+    auto tupleSize = countOfTuples.first;
+    auto blocksPerTuple = (tupleSize + kBitsPerBlock - 1) / kBitsPerBlock;
+    auto& tuples = rst[tupleSize];
+    tuples.reserve(countOfTuples.second);
+    for (size_t i = 0; i < countOfTuples.second; i++) {
+      auto offset = blockIndex * kBitsPerBlock;
+      tuples.emplace_back(
+          vectorA[index],
+          std::vector<bool>(
+              unpackedB.begin() + offset,
+              unpackedB.begin() + offset + tupleSize),
+          std::vector<bool>(
+              unpackedC.begin() + offset,
+              unpackedC.begin() + offset + tupleSize));
+      index++;
+      blockIndex += blocksPerTuple;
+    }
+  }
+  return rst;
+}
+
+std::pair<uint64_t, uint64_t>
+TwoPartyCompositeTupleGenerator::getTrafficStatistics() const {
+  auto senderStats = senderRcot_->getTrafficStatistics();
+  auto receiverStats = receiverRcot_->getTrafficStatistics();
+  return {
+      senderStats.first + receiverStats.first,
+      senderStats.second + receiverStats.second};
+}
+
+} // namespace fbpcf::engine::tuple_generator
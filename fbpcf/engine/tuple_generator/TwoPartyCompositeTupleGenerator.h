@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <memory>
+
+#include "fbpcf/engine/tuple_generator/ICompositeTupleGenerator.h"
+#include "fbpcf/engine/tuple_generator/oblivious_transfer/IRandomCorrelatedObliviousTransfer.h"
+#include "fbpcf/engine/util/aes.h"
+
+namespace fbpcf::engine::tuple_generator {
+
+/**
+ * A two party composite tuple generator. Each composite tuple consumes only
+ * one random correlated OT in each direction regardless of its size: the OT
+ * messages are expanded into long messages with a fixed-key AES hash and the
+ * products a & b_i of the whole family are derived from them.
+ */
+class TwoPartyCompositeTupleGenerator final : public ICompositeTupleGenerator {
+ public:
+  TwoPartyCompositeTupleGenerator(
+      std::unique_ptr<oblivious_transfer::IRandomCorrelatedObliviousTransfer>
+          senderRcot,
+      std::unique_ptr<oblivious_transfer::IRandomCorrelatedObliviousTransfer>
+          receiverRcot,
+      __m128i delta);
+
+  /**
+   * @inherit doc
+   */
+  std::map<size_t, std::vector<ITupleGenerator::CompositeBooleanTuple>>
+  getCompositeTuple(const std::map<size_t, uint32_t>& tupleSizes) override;
+
+  /**
+   * @inherit doc
+   */
+  std::pair<uint64_t, uint64_t> getTrafficStatistics() const override;
+
+ private:
+  util::Aes hashFromAes_;
+
+  std::unique_ptr<oblivious_transfer::IRandomCorrelatedObliviousTransfer>
+      senderRcot_;
+  std::unique_ptr<oblivious_transfer::IRandomCorrelatedObliviousTransfer>
+      receiverRcot_;
+  __m128i delta_;
+};
+
+} // namespace fbpcf::engine::tuple_generator
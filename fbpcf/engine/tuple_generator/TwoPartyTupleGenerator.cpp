@@ -16,7 +16,8 @@ TwoPartyTupleGenerator::TwoPartyTupleGenerator(
     std::unique_ptr<oblivious_transfer::IRandomCorrelatedObliviousTransfer>
         receiverRcot,
     __m128i delta,
-    uint64_t bufferSize)
+    uint64_t bufferSize,
+    std::unique_ptr<ICompositeTupleGenerator> compositeTupleGenerator)
     : // the key itself is not important as long as it's a pre-agreed value
       hashFromAes_(util::Aes::getFixedKey()),
       senderRcot_{std::move(senderRcot)},
@@ -24,13 +25,29 @@ TwoPartyTupleGenerator::TwoPartyTupleGenerator(
       delta_{delta},
       buffer_{bufferSize, [this](uint64_t size) {
                 return generateTuples(size);
-              }} {}
+              }},
+      compositeTupleGenerator_{std::move(compositeTupleGenerator)} {}
 
 std::vector<ITupleGenerator::BooleanTuple>
 TwoPartyTupleGenerator::getBooleanTuple(uint32_t size) {
+  return buffer_.getData(size).toBooleanTuples();
+}
+
+ITupleGenerator::PackedBooleanTuples
+TwoPartyTupleGenerator::getPackedBooleanTuple(uint32_t size) {
   return buffer_.getData(size);
 }
 
+std::map<size_t, std::vector<ITupleGenerator::CompositeBooleanTuple>>
+TwoPartyTupleGenerator::getCompositeTuple(
+    const std::map<size_t, uint32_t>& tupleSizes) {
+  if (compositeTupleGenerator_ == nullptr) {
+    throw std::runtime_error(
+        "Composite tuple generation is not supported by this generator.");
+  }
+  return compositeTupleGenerator_->getCompositeTuple(tupleSizes);
+}
+
 /**
  * Two party tuple generation algorithm:
  *
@@ -57,7 +74,7 @@ TwoPartyTupleGenerator::getBooleanTuple(uint32_t size) {
  * = h(k_r) ^ h(k_p) ^ h(l_r) ^ h(l_p)
  * = c_1 ^ c_2
  */
-std::vector<ITupleGenerator::BooleanTuple>
+ITupleGenerator::PackedBooleanTuples
 TwoPartyTupleGenerator::generateTuples(uint64_t size) {
   auto receiverMessagesFuture =
       std::async([size, this]() { return receiverRcot_->rcot(size); });
@@ -71,26 +88,32 @@ TwoPartyTupleGenerator::generateTuples(uint64_t size) {
 
   auto receiverMessages = receiverMessagesFuture.get();
 
-  std::vector<bool> choiceBits(size);
+  util::PackedBitVector vectorA(size);
+  util::PackedBitVector vectorB(size);
+  util::PackedBitVector vectorC(size);
   for (auto i = 0; i < size; ++i) {
-    choiceBits[i] = util::getLsb(receiverMessages.at(i));
+    vectorB.set(i, util::getLsb(receiverMessages.at(i)));
   }
 
   hashFromAes_.inPlaceHash(sender0Messages);
   hashFromAes_.inPlaceHash(sender1Messages);
   hashFromAes_.inPlaceHash(receiverMessages);
 
-  std::vector<ITupleGenerator::BooleanTuple> booleanTuples(size);
   for (size_t i = 0; i < size; i++) {
-    auto a = util::getLsb(sender0Messages.at(i)) ^
-        util::getLsb(sender1Messages.at(i));
-    auto b = choiceBits.at(i);
-    auto c = (a & b) ^ util::getLsb(sender0Messages.at(i)) ^
-        util::getLsb(receiverMessages.at(i));
-
-    booleanTuples[i] = BooleanTuple(a, b, c);
+    vectorA.set(
+        i,
+        util::getLsb(sender0Messages.at(i)) ^
+            util::getLsb(sender1Messages.at(i)));
+    vectorC.set(
+        i,
+        util::getLsb(sender0Messages.at(i)) ^
+            util::getLsb(receiverMessages.at(i)));
   }
-  return booleanTuples;
+  // c = (a & b) ^ h(k_0) ^ h(l_r), the XOR part is already in vectorC.
+  vectorC ^= vectorA & vectorB;
+
+  return PackedBooleanTuples(
+      std::move(vectorA), std::move(vectorB), std::move(vectorC));
 }
 
 std::pair<uint64_t, uint64_t> TwoPartyTupleGenerator::getTrafficStatistics()
@@ -102,6 +125,12 @@ std::pair<uint64_t, uint64_t> TwoPartyTupleGenerator::getTrafficStatistics()
   rst.first += senderStats.first + receiverStats.first;
   rst.second += senderStats.first + receiverStats.second;
 
+  if (compositeTupleGenerator_ != nullptr) {
+    auto compositeStats = compositeTupleGenerator_->getTrafficStatistics();
+    rst.first += compositeStats.first;
+    rst.second += compositeStats.second;
+  }
+
   return rst;
 }
 
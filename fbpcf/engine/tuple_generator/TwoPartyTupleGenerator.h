@@ -8,7 +8,9 @@
 #pragma once
 
 #include <future>
+#include <memory>
 
+#include "fbpcf/engine/tuple_generator/ICompositeTupleGenerator.h"
 #include "fbpcf/engine/tuple_generator/ITupleGenerator.h"
 #include "fbpcf/engine/tuple_generator/oblivious_transfer/IRandomCorrelatedObliviousTransfer.h"
 #include "fbpcf/engine/util/AsyncBuffer.h"
@@ -24,20 +26,55 @@ class TwoPartyTupleGenerator final : public ITupleGenerator {
       std::unique_ptr<oblivious_transfer::IRandomCorrelatedObliviousTransfer>
           receiverRcot,
       __m128i delta,
-      uint64_t bufferSize = kDefaultBufferSize);
+      uint64_t bufferSize = kDefaultBufferSize,
+      std::unique_ptr<ICompositeTupleGenerator> compositeTupleGenerator =
+          nullptr);
 
   /**
    * @inherit doc
    */
   std::vector<BooleanTuple> getBooleanTuple(uint32_t size) override;
 
+  /**
+   * @inherit doc
+   */
+  PackedBooleanTuples getPackedBooleanTuple(uint32_t size) override;
+
+  /**
+   * @inherit doc
+   */
+  void prefetchBooleanTuples(uint64_t size) override {
+    buffer_.prefetch(size);
+  }
+
+  /**
+   * @inherit doc
+   */
+  std::chrono::nanoseconds getStarvationTime() const override {
+    return buffer_.getWaitTime();
+  }
+
+  /**
+   * Composite tuples are delegated to the composite tuple generator, this
+   * throws if the generator is created without one.
+   */
+  std::map<size_t, std::vector<CompositeBooleanTuple>> getCompositeTuple(
+      const std::map<size_t, uint32_t>& tupleSizes) override;
+
+  /**
+   * @inherit doc
+   */
+  bool supportsCompositeTupleGeneration() override {
+    return compositeTupleGenerator_ != nullptr;
+  }
+
   /**
    * @inherit doc
    */
   std::pair<uint64_t, uint64_t> getTrafficStatistics() const override;
 
  private:
-  inline std::vector<BooleanTuple> generateTuples(uint64_t size);
+  inline PackedBooleanTuples generateTuples(uint64_t size);
 
   util::Aes hashFromAes_;
 
@@ -47,7 +84,9 @@ class TwoPartyTupleGenerator final : public ITupleGenerator {
       receiverRcot_;
   __m128i delta_;
 
-  util::AsyncBuffer<BooleanTuple> buffer_;
+  util::AsyncBuffer<BooleanTuple, PackedBooleanTuples> buffer_;
+
+  std::unique_ptr<ICompositeTupleGenerator> compositeTupleGenerator_;
 };
 
 } // namespace fbpcf::engine::tuple_generator
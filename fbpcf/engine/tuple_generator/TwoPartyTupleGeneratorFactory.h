@@ -11,6 +11,7 @@
 
 #include "fbpcf/engine/communication/IPartyCommunicationAgentFactory.h"
 #include "fbpcf/engine/tuple_generator/ITupleGeneratorFactory.h"
+#include "fbpcf/engine/tuple_generator/TwoPartyCompositeTupleGenerator.h"
 #include "fbpcf/engine/tuple_generator/TwoPartyTupleGenerator.h"
 #include "fbpcf/engine/tuple_generator/oblivious_transfer/IRandomCorrelatedObliviousTransfer.h"
 #include "fbpcf/engine/tuple_generator/oblivious_transfer/IRandomCorrelatedObliviousTransferFactory.h"
@@ -25,14 +26,19 @@ class TwoPartyTupleGeneratorFactory final : public ITupleGeneratorFactory {
           rcotFactory,
       communication::IPartyCommunicationAgentFactory& agentFactory,
       int myId,
-      uint64_t bufferSize)
+      uint64_t bufferSize,
+      bool enableCompositeTupleGeneration = false)
       : rcotFactory_{std::move(rcotFactory)},
         agentFactory_{agentFactory},
         myId_(myId),
-        bufferSize_(bufferSize) {}
+        bufferSize_(bufferSize),
+        enableCompositeTupleGeneration_(enableCompositeTupleGeneration) {}
 
   /**
-   * Create a two party tuple generator.
+   * Create a two party tuple generator. If enabled, composite tuples are
+   * generated over a separate pair of RCOT's, so they don't need to wait for
+   * the regular tuple buffer. That pair takes its own base OT's and
+   * extension, so it is only created on request.
    */
   std::unique_ptr<ITupleGenerator> create() override {
     auto delta = util::getRandomM128iFromSystemNoise();
@@ -43,8 +49,39 @@ class TwoPartyTupleGeneratorFactory final : public ITupleGeneratorFactory {
     std::unique_ptr<oblivious_transfer::IRandomCorrelatedObliviousTransfer>
         receiverRcot;
 
-    auto otherId = 1 - myId_;
+    createRcotPair(delta, senderRcot, receiverRcot);
+
+    std::unique_ptr<ICompositeTupleGenerator> compositeTupleGenerator;
+    if (enableCompositeTupleGeneration_) {
+      std::unique_ptr<oblivious_transfer::IRandomCorrelatedObliviousTransfer>
+          compositeSenderRcot;
+      std::unique_ptr<oblivious_transfer::IRandomCorrelatedObliviousTransfer>
+          compositeReceiverRcot;
+      createRcotPair(delta, compositeSenderRcot, compositeReceiverRcot);
+      compositeTupleGenerator =
+          std::make_unique<TwoPartyCompositeTupleGenerator>(
+              std::move(compositeSenderRcot),
+              std::move(compositeReceiverRcot),
+              delta);
+    }
+
+    return std::make_unique<TwoPartyTupleGenerator>(
+        std::move(senderRcot),
+        std::move(receiverRcot),
+        delta,
+        bufferSize_,
+        std::move(compositeTupleGenerator));
+  }
 
+ private:
+  // the two parties need to create the RCOT's in the matching order.
+  void createRcotPair(
+      __m128i delta,
+      std::unique_ptr<oblivious_transfer::IRandomCorrelatedObliviousTransfer>&
+          senderRcot,
+      std::unique_ptr<oblivious_transfer::IRandomCorrelatedObliviousTransfer>&
+          receiverRcot) {
+    auto otherId = 1 - myId_;
     if (myId_ == 0) {
       senderRcot = rcotFactory_->create(delta, agentFactory_.create(otherId));
       receiverRcot = rcotFactory_->create(agentFactory_.create(otherId));
@@ -52,17 +89,14 @@ class TwoPartyTupleGeneratorFactory final : public ITupleGeneratorFactory {
       receiverRcot = rcotFactory_->create(agentFactory_.create(otherId));
       senderRcot = rcotFactory_->create(delta, agentFactory_.create(otherId));
     }
-
-    return std::make_unique<TwoPartyTupleGenerator>(
-        std::move(senderRcot), std::move(receiverRcot), delta, bufferSize_);
   }
 
- private:
   std::unique_ptr<oblivious_transfer::IRandomCorrelatedObliviousTransferFactory>
       rcotFactory_;
   communication::IPartyCommunicationAgentFactory& agentFactory_;
   int myId_;
   uint64_t bufferSize_;
+  bool enableCompositeTupleGeneration_;
 };
 
 } // namespace fbpcf::engine::tuple_generator
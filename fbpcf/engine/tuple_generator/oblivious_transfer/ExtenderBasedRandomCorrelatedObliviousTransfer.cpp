@@ -7,28 +7,40 @@
 
 #include "fbpcf/engine/tuple_generator/oblivious_transfer/ExtenderBasedRandomCorrelatedObliviousTransfer.h"
 
+#include <stdexcept>
+
 namespace fbpcf::engine::tuple_generator::oblivious_transfer {
 
 ExtenderBasedRandomCorrelatedObliviousTransfer::
     ExtenderBasedRandomCorrelatedObliviousTransfer(
         util::Role role,
-        std::unique_ptr<ferret::IRcotExtender> rcotExtender)
-    : role_(role), rcotExtender_(std::move(rcotExtender)) {
+        std::unique_ptr<ferret::IRcotExtender> rcotExtender,
+        bool backgroundExtension)
+    : role_(role),
+      rcotExtender_(std::move(rcotExtender)),
+      backgroundExtension_(backgroundExtension),
+      trafficStatistics_({0, 0}) {
   baseRcotSize_ = rcotExtender_->getBaseCotSize();
 }
 
+ExtenderBasedRandomCorrelatedObliviousTransfer::
+    ~ExtenderBasedRandomCorrelatedObliviousTransfer() {
+  // the extension in flight uses the extender, let it finish first.
+  if (nextRcotResults_.valid()) {
+    nextRcotResults_.wait();
+  }
+}
+
 std::vector<__m128i> ExtenderBasedRandomCorrelatedObliviousTransfer::rcot(
     int64_t size) {
   std::vector<__m128i> rst;
-
   int index = 0;
   while (index < size) {
     if (otIndex_ >= rcotResults_.size()) {
-      extendRcot();
+      refillRcotResults();
     }
     auto insertSize =
         std::min<int64_t>(size - index, rcotResults_.size() - otIndex_);
-
     rst.insert(
         rst.end(),
         std::make_move_iterator(rcotResults_.begin() + otIndex_),
@@ -39,29 +51,43 @@ std::vector<__m128i> ExtenderBasedRandomCorrelatedObliviousTransfer::rcot(
   return rst;
 }
 
-void ExtenderBasedRandomCorrelatedObliviousTransfer::extendRcot() {
-  assert(baseRcotResults_.size() == baseRcotSize_);
-
+std::vector<__m128i> ExtenderBasedRandomCorrelatedObliviousTransfer::extendRcot(
+    std::vector<__m128i>&& baseRcotResults) {
+  assert(baseRcotResults.size() == baseRcotSize_);
   switch (role_) {
     case util::Role::sender:
-      rcotResults_ =
-          rcotExtender_->senderExtendRcot(std::move(baseRcotResults_));
-      break;
+      return rcotExtender_->senderExtendRcot(std::move(baseRcotResults));
     case util::Role::receiver:
-      rcotResults_ =
-          rcotExtender_->receiverExtendRcot(std::move(baseRcotResults_));
-      break;
+      return rcotExtender_->receiverExtendRcot(std::move(baseRcotResults));
+  }
+  throw std::runtime_error("Unknown role.");
+}
+
+void ExtenderBasedRandomCorrelatedObliviousTransfer::refillRcotResults() {
+  if (nextRcotResults_.valid()) {
+    auto nextRcotResults = nextRcotResults_.get();
+    rcotResults_.swap(nextRcotResults);
+  } else {
+    rcotResults_ = extendRcot(std::move(baseRcotResults_));
   }
 
   // otherwise the extension won't make sense at all.
   assert(rcotResults_.size() > baseRcotSize_);
-
   baseRcotResults_ = std::vector<__m128i>(
       rcotResults_.end() - baseRcotSize_, rcotResults_.end());
-
   rcotResults_.erase(rcotResults_.end() - baseRcotSize_, rcotResults_.end());
-
   otIndex_ = 0;
+
+  if (backgroundExtension_) {
+    // the extender is idle until the next extension starts
+    trafficStatistics_ = rcotExtender_->getTrafficStatistics();
+    nextRcotResults_ = std::async(
+        std::launch::async,
+        [this](std::vector<__m128i>&& baseRcotResults) {
+          return extendRcot(std::move(baseRcotResults));
+        },
+        std::move(baseRcotResults_));
+  }
 }
 
 } // namespace fbpcf::engine::tuple_generator::oblivious_transfer
@@ -8,6 +8,7 @@
 #pragma once
 
 #include <assert.h>
+#include <future>
 
 #include "fbpcf/engine/tuple_generator/oblivious_transfer/IRandomCorrelatedObliviousTransfer.h"
 #include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/IRcotExtender.h"
@@ -17,6 +18,11 @@ namespace fbpcf::engine::tuple_generator::oblivious_transfer {
 /**
  * A Random Correlated Oblivious Transfer from a RCOT extender. This object
  * securely realize RCOT with a secure RCOT extender.
+ * With background extension, the next extension starts on another thread as
+ * soon as the results of the current one are handed over, so rcot() only
+ * waits if it drains the buffer faster than the extender refills it. The
+ * extender talks over its own communication agent, hence this doesn't
+ * interleave with any other traffic. The two parties must use the same mode.
  */
 
 class ExtenderBasedRandomCorrelatedObliviousTransfer final
@@ -24,7 +30,10 @@ class ExtenderBasedRandomCorrelatedObliviousTransfer final
  public:
   ExtenderBasedRandomCorrelatedObliviousTransfer(
       util::Role role,
-      std::unique_ptr<ferret::IRcotExtender> rcotExtender);
+      std::unique_ptr<ferret::IRcotExtender> rcotExtender,
+      bool backgroundExtension = false);
+
+  ~ExtenderBasedRandomCorrelatedObliviousTransfer();
 
   // get how many base RCOT results are needed to bootstrapping the underlying
   // extender.
@@ -39,7 +48,7 @@ class ExtenderBasedRandomCorrelatedObliviousTransfer final
     assert(baseRcotResults.size() == baseRcotSize_);
     assert(baseRcotResults_.size() == 0);
     baseRcotResults_ = std::move(baseRcotResults);
-    extendRcot();
+    refillRcotResults();
   }
 
   /**
@@ -51,11 +60,18 @@ class ExtenderBasedRandomCorrelatedObliviousTransfer final
    * @inherit doc
    */
   std::pair<uint64_t, uint64_t> getTrafficStatistics() const override {
-    return rcotExtender_->getTrafficStatistics();
+    // with background extension the extender may be busy on another thread,
+    // this is the traffic up to the last handed over extension then.
+    return backgroundExtension_ ? trafficStatistics_
+                                : rcotExtender_->getTrafficStatistics();
   }
 
  private:
-  void extendRcot();
+  std::vector<__m128i> extendRcot(std::vector<__m128i>&& baseRcotResults);
+
+  // replace the drained RCOT results with the ones of the next extension
+  void refillRcotResults();
+
   util::Role role_;
 
   int64_t baseRcotSize_;
@@ -67,6 +83,11 @@ class ExtenderBasedRandomCorrelatedObliviousTransfer final
   // buffered RCOT results
   std::vector<__m128i> rcotResults_;
   int64_t otIndex_;
+
+  bool backgroundExtension_;
+  // the results of the extension running in background, if any
+  std::future<std::vector<__m128i>> nextRcotResults_;
+  std::pair<uint64_t, uint64_t> trafficStatistics_;
 };
 
 } // namespace fbpcf::engine::tuple_generator::oblivious_transfer
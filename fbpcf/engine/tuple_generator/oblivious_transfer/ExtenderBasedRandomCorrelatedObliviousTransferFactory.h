@@ -25,6 +25,9 @@ class ExtenderBasedRandomCorrelatedObliviousTransferFactory final
    * @param extendedSize a parameter for the extender
    * @param baseSize a parameter for the extender
    * @param weight a parameter for the extender
+   * @param backgroundExtension whether to run the next extension in
+   * background while the current results are consumed, this takes memory for
+   * a second set of results.
    */
   ExtenderBasedRandomCorrelatedObliviousTransferFactory(
       std::unique_ptr<IFlexibleRandomCorrelatedObliviousTransferFactory>
@@ -32,12 +35,14 @@ class ExtenderBasedRandomCorrelatedObliviousTransferFactory final
       std::unique_ptr<ferret::IRcotExtenderFactory> factory,
       int64_t extendedSize,
       int64_t baseSize,
-      int64_t weight)
+      int64_t weight,
+      bool backgroundExtension = false)
       : bootstrappingRcotFactory_(std::move(bootstrappingRcotFactory)),
         factory_(std::move(factory)),
         extendedSize_(extendedSize),
         baseSize_(baseSize),
-        weight_(weight) {}
+        weight_(weight),
+        backgroundExtension_(backgroundExtension) {}
 
   std::unique_ptr<IRandomCorrelatedObliviousTransfer> create(
       __m128i delta,
@@ -52,7 +57,7 @@ class ExtenderBasedRandomCorrelatedObliviousTransferFactory final
     extender->setCommunicationAgent(std::move(agent));
 
     auto ot = std::make_unique<ExtenderBasedRandomCorrelatedObliviousTransfer>(
-        util::Role::sender, std::move(extender));
+        util::Role::sender, std::move(extender), backgroundExtension_);
     ot->setBaseRcotResults(std::move(baseRcotResults));
     return ot;
   }
@@ -69,7 +74,7 @@ class ExtenderBasedRandomCorrelatedObliviousTransferFactory final
     extender->setCommunicationAgent(std::move(agent));
 
     auto ot = std::make_unique<ExtenderBasedRandomCorrelatedObliviousTransfer>(
-        util::Role::receiver, std::move(extender));
+        util::Role::receiver, std::move(extender), backgroundExtension_);
     ot->setBaseRcotResults(std::move(baseRcotResults));
     return ot;
   }
@@ -81,6 +86,7 @@ class ExtenderBasedRandomCorrelatedObliviousTransferFactory final
   int64_t extendedSize_;
   int64_t baseSize_;
   int64_t weight_;
+  bool backgroundExtension_;
 };
 
 } // namespace fbpcf::engine::tuple_generator::oblivious_transfer
@@ -12,6 +12,7 @@
 #include "fbpcf/engine/tuple_generator/oblivious_transfer/EmpShRandomCorrelatedObliviousTransferFactory.h"
 #include "fbpcf/engine/tuple_generator/oblivious_transfer/ExtenderBasedRandomCorrelatedObliviousTransferFactory.h"
 #include "fbpcf/engine/tuple_generator/oblivious_transfer/IRandomCorrelatedObliviousTransferFactory.h"
+#include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/LpnParameter.h"
 #include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/RcotExtenderFactory.h"
 #include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/RegularErrorMultiPointCot.h"
 #include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/RegularErrorMultiPointCotFactory.h"
@@ -32,7 +33,8 @@ inline std::unique_ptr<IRandomCorrelatedObliviousTransferFactory>
 createFerretRcotFactory(
     int64_t extendedSize = ferret::kExtendedSize,
     int64_t baseSize = ferret::kBaseSize,
-    int64_t weight = ferret::kWeight) {
+    int64_t weight = ferret::kWeight,
+    bool backgroundExtension = false) {
   return std::make_unique<
       ExtenderBasedRandomCorrelatedObliviousTransferFactory>(
       createClassicRcotFactory(),
@@ -42,7 +44,33 @@ createFerretRcotFactory(
               std::make_unique<ferret::SinglePointCotFactory>())),
       extendedSize,
       baseSize,
-      weight);
+      weight,
+      backgroundExtension);
+}
+
+inline std::unique_ptr<IRandomCorrelatedObliviousTransferFactory>
+createFerretRcotFactory(
+    const ferret::LpnParameter& parameter,
+    bool backgroundExtension = false) {
+  return createFerretRcotFactory(
+      parameter.extendedSize,
+      parameter.baseSize,
+      parameter.weight,
+      backgroundExtension);
+}
+
+/**
+ * Create a FERRET rcot factory with the LPN parameter preset that suits the
+ * expected number of correlations, e.g. the number of AND gates since each
+ * AND tuple takes one correlation from every rcot.
+ * All parties must pass the same hint.
+ */
+inline std::unique_ptr<IRandomCorrelatedObliviousTransferFactory>
+createFerretRcotFactoryForExpectedRcotCount(
+    uint64_t expectedRcotCount,
+    bool backgroundExtension = false) {
+  return createFerretRcotFactory(
+      ferret::selectLpnParameter(expectedRcotCount), backgroundExtension);
 }
 
 } // namespace fbpcf::engine::tuple_generator::oblivious_transfer
@@ -12,6 +12,8 @@
 #include <algorithm>
 #include <cstddef>
 #include <random>
+#include <stdexcept>
+#include <string>
 #include "fbpcf/engine/util/util.h"
 
 namespace fbpcf::engine::tuple_generator::oblivious_transfer::ferret::insecure {
@@ -60,5 +62,25 @@ std::vector<__m128i> DummySinglePointCot::receiverExtend(
   return rst;
 }
 
+std::vector<__m128i> DummySinglePointCot::batchExtend(
+    std::vector<__m128i>&& baseCot,
+    int numberOfExtensions) {
+  if (numberOfExtensions <= 0 || baseCot.size() % numberOfExtensions != 0) {
+    throw std::invalid_argument(
+        "can't split " + std::to_string(baseCot.size()) + " base COT into " +
+        std::to_string(numberOfExtensions) + " extensions");
+  }
+  auto depth = baseCot.size() / numberOfExtensions;
+  std::vector<__m128i> rst;
+  for (int i = 0; i < numberOfExtensions; i++) {
+    std::vector<__m128i> cot(
+        baseCot.begin() + i * depth, baseCot.begin() + (i + 1) * depth);
+    auto tmp = role_ == util::Role::sender ? senderExtend(std::move(cot))
+                                           : receiverExtend(std::move(cot));
+    rst.insert(rst.end(), tmp.begin(), tmp.end());
+  }
+  return rst;
+}
+
 } // namespace
   // fbpcf::engine::tuple_generator::oblivious_transfer::ferret::insecure
@@ -48,12 +48,35 @@ class DummySinglePointCot final : public ISinglePointCot {
    */
   std::vector<__m128i> receiverExtend(std::vector<__m128i>&& baseCot) override;
 
+  /**
+   * @inherit doc
+   */
+  std::vector<__m128i> senderBatchExtend(
+      std::vector<__m128i>&& baseCot,
+      int numberOfExtensions) override {
+    return batchExtend(std::move(baseCot), numberOfExtensions);
+  }
+
+  /**
+   * @inherit doc
+   */
+  std::vector<__m128i> receiverBatchExtend(
+      std::vector<__m128i>&& baseCot,
+      int numberOfExtensions) override {
+    return batchExtend(std::move(baseCot), numberOfExtensions);
+  }
+
   std::pair<uint64_t, uint64_t> getTrafficStatistics() const override {
     // we are returning {0, 0} because this object doesn't own the agent.
     return {0, 0};
   }
 
  private:
+  // the extensions of a batch are simply run one after another
+  std::vector<__m128i> batchExtend(
+      std::vector<__m128i>&& baseCot,
+      int numberOfExtensions);
+
   std::unique_ptr<communication::IPartyCommunicationAgent>& agent_;
   std::unique_ptr<util::IPrg> prg_;
 
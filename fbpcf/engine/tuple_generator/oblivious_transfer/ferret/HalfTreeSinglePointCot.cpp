@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <emmintrin.h>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/HalfTreeSinglePointCot.h"
+#include "fbpcf/engine/util/util.h"
+
+namespace fbpcf::engine::tuple_generator::oblivious_transfer::ferret {
+
+void HalfTreeSinglePointCot::senderInit(__m128i delta) {
+  delta_ = delta;
+  role_ = util::Role::sender;
+}
+
+void HalfTreeSinglePointCot::receiverInit() {
+  role_ = util::Role::receiver;
+}
+
+void HalfTreeSinglePointCot::forEachTree(
+    size_t numberOfTrees,
+    const std::function<void(size_t)>& task) const {
+  if (threadPool_ == nullptr || numberOfTrees == 1) {
+    for (size_t i = 0; i < numberOfTrees; i++) {
+      task(i);
+    }
+  } else {
+    threadPool_->parallelFor(numberOfTrees, task);
+  }
+}
+
+size_t HalfTreeSinglePointCot::getDepth(
+    size_t baseCotSize,
+    int numberOfExtensions) const {
+  if (numberOfExtensions <= 0 || baseCotSize % numberOfExtensions != 0 ||
+      baseCotSize == 0) {
+    throw std::invalid_argument(
+        "can't split " + std::to_string(baseCotSize) + " base COT into " +
+        std::to_string(numberOfExtensions) + " extensions");
+  }
+  return baseCotSize / numberOfExtensions;
+}
+
+std::vector<__m128i> HalfTreeSinglePointCot::concatenateTrees(
+    std::vector<std::vector<__m128i>>&& trees) const {
+  if (trees.size() == 1) {
+    return std::move(trees.at(0));
+  }
+  std::vector<__m128i> rst;
+  rst.reserve(trees.size() * trees.at(0).size());
+  for (auto& tree : trees) {
+    rst.insert(rst.end(), tree.begin(), tree.end());
+    tree = std::vector<__m128i>();
+  }
+  return rst;
+}
+
+std::vector<__m128i> HalfTreeSinglePointCot::senderBatchExtend(
+    std::vector<__m128i>&& baseCot,
+    int numberOfExtensions) {
+  assert(role_ == util::Role::sender);
+  auto depth = getDepth(baseCot.size(), numberOfExtensions);
+
+  // the first layer is (k, k ^ delta), the receiver learns the key matching
+  // its choice bit from the base cot.
+  std::vector<std::vector<__m128i>> trees(numberOfExtensions);
+  std::vector<__m128i> masks(numberOfExtensions);
+  for (int j = 0; j < numberOfExtensions; j++) {
+    auto key = util::getRandomM128iFromSystemNoise();
+    trees[j] = {key, _mm_xor_si128(key, delta_)};
+    masks[j] = _mm_xor_si128(key, baseCot[j * depth]);
+  }
+  agent_->sendT<__m128i>(masks);
+
+  // in each of the following layers, the XOR of the right children is the
+  // XOR of the left children plus delta, so masking the latter with the base
+  // cot lets the receiver learn the one matching its choice bit.
+  for (size_t i = 1; i < depth; i++) {
+    forEachTree(numberOfExtensions, [&](size_t j) {
+      trees[j] = expander_.expand(std::move(trees[j]));
+      masks[j] = baseCot[j * depth + i];
+      for (size_t k = 0; k < trees[j].size(); k += 2) {
+        masks[j] = _mm_xor_si128(masks[j], trees[j][k]);
+      }
+    });
+    agent_->sendT<__m128i>(masks);
+  }
+
+  forEachTree(numberOfExtensions, [&](size_t j) {
+    for (auto& key : trees[j]) {
+      util::setLsbTo0(key);
+    }
+  });
+  return concatenateTrees(std::move(trees));
+}
+
+std::vector<__m128i> HalfTreeSinglePointCot::receiverBatchExtend(
+    std::vector<__m128i>&& baseCot,
+    int numberOfExtensions) {
+  assert(role_ == util::Role::receiver);
+  auto depth = getDepth(baseCot.size(), numberOfExtensions);
+
+  // reconstruct the ggm trees. Only the key at positions[j] is missing in the
+  // j-th tree
+  std::vector<std::vector<__m128i>> trees(numberOfExtensions);
+  std::vector<int64_t> positions(numberOfExtensions);
+  auto masks = agent_->receiveT<__m128i>(numberOfExtensions);
+  for (int j = 0; j < numberOfExtensions; j++) {
+    auto cot = baseCot[j * depth];
+    trees[j] = {_mm_set_epi64x(0, 0), _mm_set_epi64x(0, 0)};
+    trees[j][util::getLsb(cot)] = _mm_xor_si128(masks[j], cot);
+    positions[j] = !util::getLsb(cot);
+  }
+
+  for (size_t i = 1; i < depth; i++) {
+    masks = agent_->receiveT<__m128i>(numberOfExtensions);
+    forEachTree(numberOfExtensions, [&](size_t j) {
+      auto cot = baseCot[j * depth + i];
+      auto& rst = trees[j];
+      rst = expander_.expand(std::move(rst));
+
+      // the XOR of the children on the side of the choice bit
+      auto positionToFix = (positions[j] << 1) + util::getLsb(cot);
+      rst[positionToFix] = _mm_xor_si128(masks[j], cot);
+      for (size_t k = util::getLsb(cot); k < rst.size(); k += 2) {
+        if (k != positionToFix) {
+          rst[positionToFix] = _mm_xor_si128(rst[k], rst[positionToFix]);
+        }
+      }
+      positions[j] = (positions[j] << 1) ^ !util::getLsb(cot);
+    });
+  }
+
+  // the leaves XOR to delta, so the missing one is the XOR of all the others
+  // plus the lsb of delta once the sender clears the lsb of every leaf.
+  forEachTree(numberOfExtensions, [&](size_t j) {
+    auto& rst = trees[j];
+    rst[positions[j]] = _mm_set_epi64x(0, 0);
+    __m128i totalXor = _mm_set_epi64x(0, 1);
+    for (auto& key : rst) {
+      util::setLsbTo0(key);
+      totalXor = _mm_xor_si128(totalXor, key);
+    }
+    rst[positions[j]] = totalXor;
+  });
+  return concatenateTrees(std::move(trees));
+}
+
+} // namespace
+  // fbpcf::engine::tuple_generator::oblivious_transfer::ferret
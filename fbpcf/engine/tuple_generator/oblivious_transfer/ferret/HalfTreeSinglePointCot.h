@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+#include <emmintrin.h>
+#include <functional>
+#include <memory>
+#include "fbpcf/engine/communication/IPartyCommunicationAgent.h"
+#include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/ISinglePointCot.h"
+#include "fbpcf/engine/util/ThreadPool.h"
+#include "fbpcf/engine/util/util.h"
+
+namespace fbpcf::engine::tuple_generator::oblivious_transfer::ferret {
+
+/**
+ * This is a real single point COT over a correlated ("half-tree") ggm tree.
+ * The two keys of the first layer XOR to delta and every key is the XOR of
+ * its two children, so the XOR of the right children of a layer is the XOR
+ * of its left children plus delta. The sender only needs to send one block
+ * per layer, which costs half the AES calls of SinglePointCot, and no final
+ * correction since the leaves XOR to delta. See
+ * https://eprint.iacr.org/2022/1431.pdf for more details.
+ * Like SinglePointCot, a batch of extensions shares its messages and the
+ * trees of a layer are expanded on the thread pool if one is given.
+ */
+class HalfTreeSinglePointCot final : public ISinglePointCot {
+ public:
+  explicit HalfTreeSinglePointCot(
+      std::unique_ptr<communication::IPartyCommunicationAgent>& agent,
+      std::shared_ptr<util::ThreadPool> threadPool = nullptr)
+      : agent_(agent), threadPool_(threadPool) {}
+
+  /**
+   * @inherit doc
+   */
+  void senderInit(__m128i delta) override;
+
+  /**
+   * @inherit doc
+   */
+  void receiverInit() override;
+
+  /**
+   * @inherit doc
+   */
+  std::vector<__m128i> senderExtend(std::vector<__m128i>&& baseCot) override {
+    return senderBatchExtend(std::move(baseCot), 1);
+  }
+
+  /**
+   * @inherit doc
+   */
+  std::vector<__m128i> receiverExtend(std::vector<__m128i>&& baseCot) override {
+    return receiverBatchExtend(std::move(baseCot), 1);
+  }
+
+  /**
+   * @inherit doc
+   */
+  std::vector<__m128i> senderBatchExtend(
+      std::vector<__m128i>&& baseCot,
+      int numberOfExtensions) override;
+
+  /**
+   * @inherit doc
+   */
+  std::vector<__m128i> receiverBatchExtend(
+      std::vector<__m128i>&& baseCot,
+      int numberOfExtensions) override;
+
+  std::pair<uint64_t, uint64_t> getTrafficStatistics() const override {
+    // we are returning {0, 0} because this object doesn't own the agent.
+    return {0, 0};
+  }
+
+ private:
+  // run task(i) for each tree i, on the thread pool if there is one.
+  void forEachTree(
+      size_t numberOfTrees,
+      const std::function<void(size_t)>& task) const;
+
+  // check the base cot size and return the depth of each tree.
+  size_t getDepth(size_t baseCotSize, int numberOfExtensions) const;
+
+  std::vector<__m128i> concatenateTrees(
+      std::vector<std::vector<__m128i>>&& trees) const;
+
+  std::unique_ptr<communication::IPartyCommunicationAgent>& agent_;
+  std::shared_ptr<util::ThreadPool> threadPool_;
+  util::HalfTreeExpander expander_;
+
+  util::Role role_;
+  __m128i delta_;
+};
+
+} // namespace
+  // fbpcf::engine::tuple_generator::oblivious_transfer::ferret
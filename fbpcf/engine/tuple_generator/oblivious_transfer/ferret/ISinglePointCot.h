@@ -54,6 +54,32 @@ class ISinglePointCot {
   virtual std::vector<__m128i> receiverExtend(
       std::vector<__m128i>&& baseCot) = 0;
 
+  /**
+   * the sender's API to run several independent extensions at once, sharing
+   * their communication rounds.
+   * @param baseCot : base cot results needed for all the extensions, the i-th
+   * extension uses the i-th baseCot.size() / numberOfExtensions of them.
+   * @param numberOfExtensions : the number of extensions
+   * @return the concatenated results of the extensions, each one as in
+   * senderExtend().
+   */
+  virtual std::vector<__m128i> senderBatchExtend(
+      std::vector<__m128i>&& baseCot,
+      int numberOfExtensions) = 0;
+
+  /**
+   * the receiver's API to run several independent extensions at once, sharing
+   * their communication rounds.
+   * @param baseCot : base cot results needed for all the extensions, the i-th
+   * extension uses the i-th baseCot.size() / numberOfExtensions of them.
+   * @param numberOfExtensions : the number of extensions
+   * @return the concatenated results of the extensions, each one as in
+   * receiverExtend().
+   */
+  virtual std::vector<__m128i> receiverBatchExtend(
+      std::vector<__m128i>&& baseCot,
+      int numberOfExtensions) = 0;
+
   /**
    * Get the total amount of traffic transmitted.
    * @return a pair of (sent, received) data in bytes.
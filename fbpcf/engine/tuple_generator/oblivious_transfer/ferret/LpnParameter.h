@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/RegularErrorMultiPointCot.h"
+
+namespace fbpcf::engine::tuple_generator::oblivious_transfer::ferret {
+
+/**
+ * The regular-error LPN parameters of a Ferret extension: each extension
+ * produces extendedSize correlations out of baseSize correlations for the
+ * matrix multiplication plus the ones consumed by "weight" single point
+ * cots. extendedSize / weight must be a power of 2.
+ */
+struct LpnParameter {
+  int64_t extendedSize;
+  int64_t baseSize;
+  int64_t weight;
+};
+
+// The parameters Ferret uses for its setup phase, see
+// https://eprint.iacr.org/2020/924.pdf. An extension is about 10MB.
+constexpr LpnParameter kSmallLpnParameter{649728, 36288, 1269};
+
+// The parameters Ferret uses for its main iterations, the default. An
+// extension is about 173MB.
+constexpr LpnParameter kLargeLpnParameter{kExtendedSize, kBaseSize, kWeight};
+
+/**
+ * The number of fresh correlations an extension with the given parameters
+ * hands out, the rest are kept as the base of the next extension.
+ */
+constexpr int64_t getExtensionOutputSize(const LpnParameter& parameter) {
+  int64_t spcotBaseSize = 0;
+  for (auto length = parameter.extendedSize / parameter.weight; length > 1;
+       length >>= 1) {
+    spcotBaseSize++;
+  }
+  return parameter.extendedSize - parameter.baseSize -
+      spcotBaseSize * parameter.weight;
+}
+
+/**
+ * Pick the small preset if its first extension already covers the expected
+ * number of correlations, so that small jobs neither wait for nor store a
+ * large extension. Larger jobs get the large preset, which has the highest
+ * throughput.
+ * @param expectedRcotCount how many correlations the caller expects to draw
+ */
+constexpr LpnParameter selectLpnParameter(uint64_t expectedRcotCount) {
+  if (expectedRcotCount <=
+      static_cast<uint64_t>(getExtensionOutputSize(kSmallLpnParameter))) {
+    return kSmallLpnParameter;
+  } else {
+    return kLargeLpnParameter;
+  }
+}
+
+} // namespace fbpcf::engine::tuple_generator::oblivious_transfer::ferret
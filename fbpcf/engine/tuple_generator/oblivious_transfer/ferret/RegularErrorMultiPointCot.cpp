@@ -58,21 +58,15 @@ std::vector<__m128i> RegularErrorMultiPointCot::extend(
   // We will perform single point cot for "weight" times, where the errors are
   // regularily distributed across position 1 to position length. With that
   // said, we are performing single point cot with either length/weight.
-
-  std::vector<__m128i> rst;
-  int64_t index = 0;
-
-  for (int i = 0; i < spcotCount_; i++) {
-    auto tmp = singleCotExtend(std::vector(
-        baseCot.begin() + index, baseCot.begin() + index + baseCotSize_));
-
-    rst.insert(
-        rst.end(),
-        std::make_move_iterator(tmp.begin()),
-        std::make_move_iterator(tmp.begin() + spcotLength_));
-    index += baseCotSize_;
+  // All of them are run as one batch so that they share the communication
+  // rounds.
+
+  if (role_ == util::Role::sender) {
+    return singlePointCot_->senderBatchExtend(std::move(baseCot), spcotCount_);
+  } else {
+    return singlePointCot_->receiverBatchExtend(
+        std::move(baseCot), spcotCount_);
   }
-  return rst;
 }
 
 std::vector<__m128i> RegularErrorMultiPointCot::senderExtend(
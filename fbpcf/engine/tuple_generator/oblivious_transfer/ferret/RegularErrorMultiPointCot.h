@@ -65,17 +65,6 @@ class RegularErrorMultiPointCot final : public IMultiPointCot {
    */
   void init(int64_t length, int64_t weight);
 
-  /**
-   * This is merely a helper to unify the underlying single point cot API
-   */
-  std::vector<__m128i> singleCotExtend(std::vector<__m128i>&& baseCot) {
-    if (role_ == util::Role::sender) {
-      return singlePointCot_->senderExtend(std::move(baseCot));
-    } else {
-      return singlePointCot_->receiverExtend(std::move(baseCot));
-    }
-  }
-
   /**
    * This is merely a helper for avoiding duplicated code.
    */
@@ -8,46 +8,42 @@
 #include <emmintrin.h>
 #include <string.h>
 #include <memory>
+#include <stdexcept>
+#include <string>
 
 #include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/SinglePointCot.h"
 #include "fbpcf/engine/util/util.h"
 
 namespace fbpcf::engine::tuple_generator::oblivious_transfer::ferret {
 
-std::vector<__m128i> SinglePointCot::constructALayerOfKeyForSender(
-    std::vector<__m128i>&& previousLayer,
-    __m128i baseCot) {
-  auto rst = expander_->expand(std::move(previousLayer));
-  std::vector<__m128i> masks = {baseCot, _mm_xor_si128(baseCot, delta_)};
-  cipherForHash_->encryptInPlace(masks);
-
-  masks[0] = _mm_xor_si128(masks[0], baseCot);
-  masks[1] = _mm_xor_si128(masks[1], _mm_xor_si128(baseCot, delta_));
-
-  for (size_t i = 0; i < rst.size(); i += 2) {
-    masks[0] = _mm_xor_si128(masks[0], rst[i]);
-    masks[1] = _mm_xor_si128(masks[1], rst[i + 1]);
+void SinglePointCot::constructALayerOfKeyForSender(
+    Tree& tree,
+    __m128i baseCot,
+    __m128i* masks) const {
+  tree.layer = tree.expander.expand(std::move(tree.layer));
+
+  std::vector<__m128i> hashes = {baseCot, _mm_xor_si128(baseCot, delta_)};
+  tree.cipherForHash.encryptInPlace(hashes);
+  masks[0] = _mm_xor_si128(hashes[0], baseCot);
+  masks[1] = _mm_xor_si128(hashes[1], _mm_xor_si128(baseCot, delta_));
+  for (size_t i = 0; i < tree.layer.size(); i += 2) {
+    masks[0] = _mm_xor_si128(masks[0], tree.layer[i]);
+    masks[1] = _mm_xor_si128(masks[1], tree.layer[i + 1]);
   }
-
-  agent_->sendT<__m128i>(masks);
-
-  return rst;
 }
 
-std::vector<__m128i> SinglePointCot::constructALayerOfKeyForReceiver(
-    std::vector<__m128i>&& previousLayer,
+void SinglePointCot::constructALayerOfKeyForReceiver(
+    Tree& tree,
     __m128i baseCot,
-    int missingPosition) {
-  auto rst = expander_->expand(std::move(previousLayer));
+    int64_t missingPosition,
+    const __m128i* masks) const {
+  tree.layer = tree.expander.expand(std::move(tree.layer));
+  auto& rst = tree.layer;
 
   auto positionToFix = (missingPosition << 1) + util::getLsb(baseCot);
-
   std::vector<__m128i> tmp({baseCot});
-  cipherForHash_->encryptInPlace(tmp);
+  tree.cipherForHash.encryptInPlace(tmp);
   rst[positionToFix] = _mm_xor_si128(tmp[0], baseCot);
-
-  auto masks = agent_->receiveT<__m128i>(2);
-
   rst[positionToFix] =
       _mm_xor_si128(masks[util::getLsb(baseCot)], rst[positionToFix]);
 
@@ -56,8 +52,6 @@ std::vector<__m128i> SinglePointCot::constructALayerOfKeyForReceiver(
       rst[positionToFix] = _mm_xor_si128(rst[i], rst[positionToFix]);
     }
   }
-
-  return rst;
 }
 
 void SinglePointCot::senderInit(__m128i delta) {
@@ -69,60 +63,122 @@ void SinglePointCot::receiverInit() {
   role_ = util::Role::receiver;
 }
 
-std::vector<__m128i> SinglePointCot::senderExtend(
-    std::vector<__m128i>&& baseCot) {
-  assert(role_ == util::Role::sender);
-  expander_ = std::make_unique<util::Expander>(index_);
-  cipherForHash_ = std::make_unique<util::Aes>(_mm_set_epi64x(index_, 0));
-
-  std::vector<__m128i> rst{util::getRandomM128iFromSystemNoise()};
-
-  // contruct the ggm tree
-  for (size_t i = 0; i < baseCot.size(); i++) {
-    rst = constructALayerOfKeyForSender(std::move(rst), baseCot[i]);
+std::vector<SinglePointCot::Tree> SinglePointCot::createTrees(
+    int numberOfExtensions) {
+  std::vector<Tree> trees;
+  trees.reserve(numberOfExtensions);
+  for (int i = 0; i < numberOfExtensions; i++) {
+    trees.emplace_back(index_++);
   }
-  __m128i totalXor = delta_;
+  return trees;
+}
 
-  for (size_t i = 0; i < rst.size(); i++) {
-    util::setLsbTo0(rst[i]);
-    totalXor = _mm_xor_si128(totalXor, rst[i]);
+void SinglePointCot::forEachTree(
+    size_t numberOfTrees,
+    const std::function<void(size_t)>& task) const {
+  if (threadPool_ == nullptr || numberOfTrees == 1) {
+    for (size_t i = 0; i < numberOfTrees; i++) {
+      task(i);
+    }
+  } else {
+    threadPool_->parallelFor(numberOfTrees, task);
   }
+}
 
-  agent_->sendSingleT<__m128i>(totalXor);
-  index_++;
+size_t SinglePointCot::getDepth(
+    size_t baseCotSize,
+    int numberOfExtensions) const {
+  if (numberOfExtensions <= 0 || baseCotSize % numberOfExtensions != 0) {
+    throw std::invalid_argument(
+        "can't split " + std::to_string(baseCotSize) + " base COT into " +
+        std::to_string(numberOfExtensions) + " extensions");
+  }
+  return baseCotSize / numberOfExtensions;
+}
 
+std::vector<__m128i> SinglePointCot::concatenateTrees(
+    std::vector<Tree>&& trees) const {
+  if (trees.size() == 1) {
+    return std::move(trees.at(0).layer);
+  }
+  std::vector<__m128i> rst;
+  rst.reserve(trees.size() * trees.at(0).layer.size());
+  for (auto& tree : trees) {
+    rst.insert(rst.end(), tree.layer.begin(), tree.layer.end());
+    tree.layer = std::vector<__m128i>();
+  }
   return rst;
 }
 
-std::vector<__m128i> SinglePointCot::receiverExtend(
-    std::vector<__m128i>&& baseCot) {
-  assert(role_ == util::Role::receiver);
-  expander_ = std::make_unique<util::Expander>(index_);
-  cipherForHash_ = std::make_unique<util::Aes>(_mm_set_epi64x(index_, 0));
+std::vector<__m128i> SinglePointCot::senderBatchExtend(
+    std::vector<__m128i>&& baseCot,
+    int numberOfExtensions) {
+  assert(role_ == util::Role::sender);
+  auto depth = getDepth(baseCot.size(), numberOfExtensions);
+  auto trees = createTrees(numberOfExtensions);
+  for (auto& tree : trees) {
+    tree.layer = {util::getRandomM128iFromSystemNoise()};
+  }
 
-  std::vector<__m128i> rst{_mm_set_epi32(0, 0, 0, 0)};
+  // contruct the ggm trees, all of them advance one layer per message
+  std::vector<__m128i> masks(2 * numberOfExtensions);
+  for (size_t i = 0; i < depth; i++) {
+    forEachTree(numberOfExtensions, [&](size_t j) {
+      constructALayerOfKeyForSender(
+          trees[j], baseCot[j * depth + i], masks.data() + 2 * j);
+    });
+    agent_->sendT<__m128i>(masks);
+  }
 
-  int64_t position = 0;
+  std::vector<__m128i> totalXors(numberOfExtensions);
+  forEachTree(numberOfExtensions, [&](size_t j) {
+    auto& rst = trees[j].layer;
+    totalXors[j] = delta_;
+    for (size_t i = 0; i < rst.size(); i++) {
+      util::setLsbTo0(rst[i]);
+      totalXors[j] = _mm_xor_si128(totalXors[j], rst[i]);
+    }
+  });
+  agent_->sendT<__m128i>(totalXors);
+  return concatenateTrees(std::move(trees));
+}
 
-  // reconstruct the ggm tree. Only m_position is missing
-  for (size_t i = 0; i < baseCot.size(); i++) {
-    rst = constructALayerOfKeyForReceiver(std::move(rst), baseCot[i], position);
-    position <<= 1;
-    position ^= !util::getLsb(baseCot[i]);
+std::vector<__m128i> SinglePointCot::receiverBatchExtend(
+    std::vector<__m128i>&& baseCot,
+    int numberOfExtensions) {
+  assert(role_ == util::Role::receiver);
+  auto depth = getDepth(baseCot.size(), numberOfExtensions);
+  auto trees = createTrees(numberOfExtensions);
+  for (auto& tree : trees) {
+    tree.layer = {_mm_set_epi32(0, 0, 0, 0)};
   }
-  // totalXor = delta + m_0 + m_1 + ...
-  __m128i totalXor = agent_->receiveSingleT<__m128i>();
 
-  rst[position] = _mm_set_epi64x(0, 0);
-  for (size_t i = 0; i < rst.size(); i++) {
-    util::setLsbTo0(rst[i]);
-    totalXor = _mm_xor_si128(totalXor, rst[i]);
+  // reconstruct the ggm trees. Only the key at positions[j] is missing in the
+  // j-th tree
+  std::vector<int64_t> positions(numberOfExtensions, 0);
+  for (size_t i = 0; i < depth; i++) {
+    auto masks = agent_->receiveT<__m128i>(2 * numberOfExtensions);
+    forEachTree(numberOfExtensions, [&](size_t j) {
+      auto cot = baseCot[j * depth + i];
+      constructALayerOfKeyForReceiver(
+          trees[j], cot, positions[j], masks.data() + 2 * j);
+      positions[j] = (positions[j] << 1) ^ !util::getLsb(cot);
+    });
   }
-  // totalXor = m_position + delta
-  rst[position] = totalXor;
-  index_++;
 
-  return rst;
+  // totalXor = delta + m_0 + m_1 + ...
+  auto totalXors = agent_->receiveT<__m128i>(numberOfExtensions);
+  forEachTree(numberOfExtensions, [&](size_t j) {
+    auto& rst = trees[j].layer;
+    rst[positions[j]] = _mm_set_epi64x(0, 0);
+    for (size_t i = 0; i < rst.size(); i++) {
+      util::setLsbTo0(rst[i]);
+      totalXors[j] = _mm_xor_si128(totalXors[j], rst[i]);
+    }
+    // totalXor = m_position + delta
+    rst[positions[j]] = totalXors[j];
+  });
+  return concatenateTrees(std::move(trees));
 }
 
 } // namespace
@@ -7,10 +7,12 @@
 
 #pragma once
 #include <emmintrin.h>
+#include <functional>
 #include <memory>
 #include "fbpcf/engine/communication/IPartyCommunicationAgent.h"
 #include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/ISinglePointCot.h"
 #include "fbpcf/engine/util/IPrg.h"
+#include "fbpcf/engine/util/ThreadPool.h"
 #include "fbpcf/engine/util/aes.h"
 #include "fbpcf/engine/util/util.h"
 
@@ -19,17 +21,22 @@ namespace fbpcf::engine::tuple_generator::oblivious_transfer::ferret {
 /**
  * This is a real single point COT. See https://eprint.iacr.org/2020/924.pdf for
  * more details
+ * A batch of extensions grows all the ggm trees one layer at a time, so each
+ * layer takes a single message for all the trees. The trees of a layer are
+ * expanded on the thread pool if one is given.
  */
 class SinglePointCot final : public ISinglePointCot {
  public:
   explicit SinglePointCot(
-      std::unique_ptr<communication::IPartyCommunicationAgent>& agent)
-      : agent_(agent), index_(0) {}
+      std::unique_ptr<communication::IPartyCommunicationAgent>& agent,
+      std::shared_ptr<util::ThreadPool> threadPool = nullptr)
+      : agent_(agent), threadPool_(threadPool), index_(0) {}
 
   /**
    * @inherit doc
    */
   void senderInit(__m128i delta) override;
+
   /**
    * @inherit doc
    */
@@ -38,12 +45,30 @@ class SinglePointCot final : public ISinglePointCot {
   /**
    * @inherit doc
    */
-  std::vector<__m128i> senderExtend(std::vector<__m128i>&& baseCot) override;
+  std::vector<__m128i> senderExtend(std::vector<__m128i>&& baseCot) override {
+    return senderBatchExtend(std::move(baseCot), 1);
+  }
+
+  /**
+   * @inherit doc
+   */
+  std::vector<__m128i> receiverExtend(std::vector<__m128i>&& baseCot) override {
+    return receiverBatchExtend(std::move(baseCot), 1);
+  }
+
+  /**
+   * @inherit doc
+   */
+  std::vector<__m128i> senderBatchExtend(
+      std::vector<__m128i>&& baseCot,
+      int numberOfExtensions) override;
 
   /**
    * @inherit doc
    */
-  std::vector<__m128i> receiverExtend(std::vector<__m128i>&& baseCot) override;
+  std::vector<__m128i> receiverBatchExtend(
+      std::vector<__m128i>&& baseCot,
+      int numberOfExtensions) override;
 
   std::pair<uint64_t, uint64_t> getTrafficStatistics() const override {
     // we are returning {0, 0} because this object doesn't own the agent.
@@ -51,23 +76,44 @@ class SinglePointCot final : public ISinglePointCot {
   }
 
  private:
-  std::vector<__m128i> constructALayerOfKeyForSender(
-      std::vector<__m128i>&& previousLayer,
-      __m128i baseCot);
-  std::vector<__m128i> constructALayerOfKeyForReceiver(
-      std::vector<__m128i>&& previousLayer,
-      __m128i baseCot,
-      int missingPosition);
+  // a ggm tree under construction, each tree has its own keys.
+  struct Tree {
+    explicit Tree(int64_t index)
+        : expander(index), cipherForHash(_mm_set_epi64x(index, 0)) {}
 
-  std::unique_ptr<communication::IPartyCommunicationAgent>& agent_;
+    util::Expander expander;
+    util::Aes cipherForHash;
+    std::vector<__m128i> layer;
+  };
+
+  std::vector<Tree> createTrees(int numberOfExtensions);
 
-  std::unique_ptr<util::Expander> expander_;
+  // run task(i) for each tree i, on the thread pool if there is one.
+  void forEachTree(
+      size_t numberOfTrees,
+      const std::function<void(size_t)>& task) const;
 
-  std::unique_ptr<util::Aes> cipherForHash_;
+  // check the base cot size and return the depth of each tree.
+  size_t getDepth(size_t baseCotSize, int numberOfExtensions) const;
+
+  std::vector<__m128i> concatenateTrees(std::vector<Tree>&& trees) const;
+
+  void constructALayerOfKeyForSender(
+      Tree& tree,
+      __m128i baseCot,
+      __m128i* masks) const;
+
+  void constructALayerOfKeyForReceiver(
+      Tree& tree,
+      __m128i baseCot,
+      int64_t missingPosition,
+      const __m128i* masks) const;
+
+  std::unique_ptr<communication::IPartyCommunicationAgent>& agent_;
+  std::shared_ptr<util::ThreadPool> threadPool_;
 
   util::Role role_;
   __m128i delta_;
-
   int64_t index_;
 };
 
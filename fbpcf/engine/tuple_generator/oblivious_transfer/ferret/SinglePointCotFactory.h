@@ -10,6 +10,7 @@
 #include <openssl/rand.h>
 #include <memory>
 
+#include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/HalfTreeSinglePointCot.h"
 #include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/ISinglePointCotFactory.h"
 #include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/SinglePointCot.h"
 #include "fbpcf/engine/util/IPrgFactory.h"
@@ -18,11 +19,29 @@ namespace fbpcf::engine::tuple_generator::oblivious_transfer::ferret {
 
 class SinglePointCotFactory final : public ISinglePointCotFactory {
  public:
+  /**
+   * @param threadPool the pool to expand the trees of a batch on, they are
+   * expanded on the calling thread if it's null.
+   * @param halfTree whether to create HalfTreeSinglePointCot instead of
+   * SinglePointCot, the two parties must agree on it.
+   */
+  explicit SinglePointCotFactory(
+      std::shared_ptr<util::ThreadPool> threadPool = nullptr,
+      bool halfTree = false)
+      : threadPool_(threadPool), halfTree_(halfTree) {}
+
   std::unique_ptr<ISinglePointCot> create(
       std::unique_ptr<communication::IPartyCommunicationAgent>& agent)
       override {
-    return std::make_unique<SinglePointCot>(agent);
+    if (halfTree_) {
+      return std::make_unique<HalfTreeSinglePointCot>(agent, threadPool_);
+    }
+    return std::make_unique<SinglePointCot>(agent, threadPool_);
   }
+
+ private:
+  std::shared_ptr<util::ThreadPool> threadPool_;
+  bool halfTree_;
 };
 
 } // namespace
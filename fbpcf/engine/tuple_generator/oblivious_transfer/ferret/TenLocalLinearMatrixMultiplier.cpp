@@ -9,6 +9,7 @@
 #include "fbpcf/engine/util/AesPrg.h"
 
 #include <emmintrin.h>
+#include <xmmintrin.h>
 
 namespace fbpcf::engine::tuple_generator::oblivious_transfer::ferret {
 
@@ -16,35 +17,73 @@ std::vector<__m128i> TenLocalLinearMatrixMultiplier::multiplyWithRandomMatrix(
     __m128i seed,
     int64_t rstLength,
     const std::vector<__m128i>& src) const {
+  std::vector<__m128i> rst(rstLength);
+  size_t numberOfRanges =
+      (rstLength + kResultsPerRange - 1) / kResultsPerRange;
+
+  // each range gets its own seed, so the ranges can be computed in any order
+  // and on any thread while both parties still agree on the matrix.
+  std::vector<__m128i> rangeSeeds(numberOfRanges);
+  util::AesPrg(seed).getRandomDataInPlace(rangeSeeds);
+
+  auto task = [&](size_t i) {
+    multiplyRange(
+        rangeSeeds.at(i),
+        i * kResultsPerRange,
+        std::min<int64_t>((i + 1) * kResultsPerRange, rstLength),
+        src,
+        rst);
+  };
+  if (threadPool_ == nullptr) {
+    for (size_t i = 0; i < numberOfRanges; i++) {
+      task(i);
+    }
+  } else {
+    threadPool_->parallelFor(numberOfRanges, task);
+  }
+  return rst;
+}
+
+void TenLocalLinearMatrixMultiplier::multiplyRange(
+    __m128i seed,
+    int64_t begin,
+    int64_t end,
+    const std::vector<__m128i>& src,
+    std::vector<__m128i>& rst) const {
   uint32_t srcSize = src.size();
   uint32_t mask = 1;
   while (mask < srcSize) {
     mask = (mask << 1) ^ 1;
   }
   util::AesPrg prg(seed);
-  std::vector<__m128i> rst(rstLength);
 
-  int index = 0;
-  std::vector<__m128i> randomData(10);
-  uint32_t* randomNumberIndex;
-  for (; index < rstLength; index += 4) {
+  // each result item consumes 10 uint32_t random numbers, 4 items per block
+  // of 10 __m128i.
+  std::vector<__m128i> randomData(kResultsPerBatch / 4 * 10);
+  uint32_t* randomNumberIndex = reinterpret_cast<uint32_t*>(randomData.data());
+  for (int64_t index = begin; index < end; index += kResultsPerBatch) {
+    int64_t batchSize = std::min(kResultsPerBatch, end - index);
     prg.getRandomDataInPlace(randomData);
-    randomNumberIndex = reinterpret_cast<uint32_t*>(randomData.data());
-    for (int i = 0; i < 4 && index + i < rstLength; i++) {
-      rst[index + i] = _mm_set_epi64x(0, 0);
-      // each iteration consumes 10 uint32_t random numbers
-      for (int j = 0; j < 10; j++) {
-        randomNumberIndex[j] &= mask;
-        randomNumberIndex[j] = randomNumberIndex[j] >= srcSize
-            ? (randomNumberIndex[j] - srcSize)
-            : randomNumberIndex[j];
-        rst[index + i] =
-            _mm_xor_si128(rst[index + i], src[randomNumberIndex[j]]);
+    // the src items are random gathers from a multi-MB vector, hence issue
+    // all the loads of a batch before any of them is needed.
+    for (int64_t j = 0; j < batchSize * 10; j++) {
+      randomNumberIndex[j] &= mask;
+      randomNumberIndex[j] = randomNumberIndex[j] >= srcSize
+          ? (randomNumberIndex[j] - srcSize)
+          : randomNumberIndex[j];
+      _mm_prefetch(
+          reinterpret_cast<const char*>(src.data() + randomNumberIndex[j]),
+          _MM_HINT_T0);
+    }
+    for (int64_t i = 0; i < batchSize; i++) {
+      const uint32_t* itemIndex = randomNumberIndex + i * 10;
+      __m128i item = src[itemIndex[0]];
+      for (int j = 1; j < 10; j++) {
+        item = _mm_xor_si128(item, src[itemIndex[j]]);
       }
-      randomNumberIndex += 10;
+      rst[index + i] = item;
     }
   }
-  return rst;
 }
 
 } // namespace
@@ -7,8 +7,11 @@
 
 #pragma once
 
+#include <memory>
+
 #include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/IMatrixMultiplier.h"
 #include "fbpcf/engine/util/IPrgFactory.h"
+#include "fbpcf/engine/util/ThreadPool.h"
 
 namespace fbpcf::engine::tuple_generator::oblivious_transfer::ferret {
 
@@ -16,10 +19,16 @@ namespace fbpcf::engine::tuple_generator::oblivious_transfer::ferret {
  * This lpn calculator uses a built-in 10 local linear code generator.
  * With a given seed, exactly 10 items from src (potentially with duplication)
  * are selected to compose 1 result item.
+ * The result is split into fixed size ranges, each with its own PRG stream
+ * derived from the seed. The ranges are computed on the thread pool if one is
+ * given; the result does not depend on the number of threads, so the two
+ * parties can use different pools.
  */
 class TenLocalLinearMatrixMultiplier final : public IMatrixMultiplier {
  public:
-  TenLocalLinearMatrixMultiplier() {}
+  explicit TenLocalLinearMatrixMultiplier(
+      std::shared_ptr<util::ThreadPool> threadPool = nullptr)
+      : threadPool_(threadPool) {}
 
   /**
    * @inherit doc
@@ -28,6 +37,22 @@ class TenLocalLinearMatrixMultiplier final : public IMatrixMultiplier {
       __m128i seed,
       int64_t rstLength,
       const std::vector<__m128i>& src) const override;
+
+ private:
+  // number of result items computed from one PRG stream
+  static constexpr int64_t kResultsPerRange = 1 << 16;
+
+  // number of result items whose src items are prefetched together
+  static constexpr int64_t kResultsPerBatch = 64;
+
+  void multiplyRange(
+      __m128i seed,
+      int64_t begin,
+      int64_t end,
+      const std::vector<__m128i>& src,
+      std::vector<__m128i>& rst) const;
+
+  std::shared_ptr<util::ThreadPool> threadPool_;
 };
 
 } // namespace
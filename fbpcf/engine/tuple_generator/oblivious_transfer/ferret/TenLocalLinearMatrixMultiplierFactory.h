@@ -19,9 +19,21 @@ namespace fbpcf::engine::tuple_generator::oblivious_transfer::ferret {
 class TenLocalLinearMatrixMultiplierFactory final
     : public IMatrixMultiplierFactory {
  public:
+  /**
+   * @param threadPool the pool to run the multiplications on, they run on the
+   * calling thread if it's null. The multipliers created by this factory
+   * share it.
+   */
+  explicit TenLocalLinearMatrixMultiplierFactory(
+      std::shared_ptr<util::ThreadPool> threadPool = nullptr)
+      : threadPool_(threadPool) {}
+
   std::unique_ptr<IMatrixMultiplier> create() override {
-    return std::make_unique<TenLocalLinearMatrixMultiplier>();
+    return std::make_unique<TenLocalLinearMatrixMultiplier>(threadPool_);
   }
+
+ private:
+  std::shared_ptr<util::ThreadPool> threadPool_;
 };
 
 } // namespace
@@ -15,6 +15,8 @@
 #include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/DummyMatrixMultiplierFactory.h"
 #include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/IMatrixMultiplier.h"
 #include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/TenLocalLinearMatrixMultiplierFactory.h"
+#include "fbpcf/engine/util/util.h"
+#include "fbpcf/test/TestHelper.h"
 
 namespace fbpcf::engine::tuple_generator::oblivious_transfer::ferret {
 int getHammingWeight(uint8_t src) {
@@ -66,5 +68,27 @@ TEST(MatrixMultiplierTest, test10LocalLinearMatrixMultiplier) {
   testMatrixMultiplier(factory.create(), 10);
 }
 
+TEST(MatrixMultiplierTest, testMultithreaded10LocalLinearMatrixMultiplier) {
+  std::vector<__m128i> src(1000);
+  for (auto& item : src) {
+    item = util::getRandomM128iFromSystemNoise();
+  }
+  __m128i seed = util::getRandomM128iFromSystemNoise();
+  // not a multiple of the range size to cover the last partial range
+  int64_t length = 300001;
+
+  auto expectedRst = TenLocalLinearMatrixMultiplierFactory()
+                         .create()
+                         ->multiplyWithRandomMatrix(seed, length, src);
+  EXPECT_EQ(expectedRst.size(), length);
+
+  for (size_t numberOfThreads : {1, 3, 8}) {
+    TenLocalLinearMatrixMultiplierFactory factory(
+        std::make_shared<util::ThreadPool>(numberOfThreads));
+    auto rst = factory.create()->multiplyWithRandomMatrix(seed, length, src);
+    testEq(rst, expectedRst);
+  }
+}
+
 } // namespace
   // fbpcf::engine::tuple_generator::oblivious_transfer::ferret
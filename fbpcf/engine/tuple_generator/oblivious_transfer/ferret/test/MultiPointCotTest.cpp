@@ -135,5 +135,40 @@ TEST(MPCotExtenderTest, testRealMPCotWithRealSpcot) {
   testMpCot(std::move(sender), std::move(receiver));
 }
 
+TEST(MPCotExtenderTest, testRealMPCotWithMultithreadedSpcot) {
+  communication::InMemoryPartyCommunicationAgentHost host;
+
+  std::unique_ptr<communication::IPartyCommunicationAgent> agent0 =
+      host.getAgent(0);
+  std::unique_ptr<communication::IPartyCommunicationAgent> agent1 =
+      host.getAgent(1);
+
+  RegularErrorMultiPointCotFactory factory(
+      std::make_unique<SinglePointCotFactory>(
+          std::make_shared<util::ThreadPool>(4)));
+
+  auto sender = factory.create(agent0);
+  auto receiver = factory.create(agent1);
+
+  testMpCot(std::move(sender), std::move(receiver));
+}
+
+TEST(MPCotExtenderTest, testRealMPCotWithHalfTreeSpcot) {
+  communication::InMemoryPartyCommunicationAgentHost host;
+
+  std::unique_ptr<communication::IPartyCommunicationAgent> agent0 =
+      host.getAgent(0);
+  std::unique_ptr<communication::IPartyCommunicationAgent> agent1 =
+      host.getAgent(1);
+
+  RegularErrorMultiPointCotFactory factory(
+      std::make_unique<SinglePointCotFactory>(nullptr, /*halfTree*/ true));
+
+  auto sender = factory.create(agent0);
+  auto receiver = factory.create(agent1);
+
+  testMpCot(std::move(sender), std::move(receiver));
+}
+
 } // namespace
   // fbpcf::engine::tuple_generator::oblivious_transfer::ferret
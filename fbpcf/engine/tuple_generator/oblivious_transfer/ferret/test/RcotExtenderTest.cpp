@@ -18,6 +18,7 @@
 #include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/DummyRcotExtender.h"
 #include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/DummyRcotExtenderFactory.h"
 #include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/DummySinglePointCotFactory.h"
+#include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/LpnParameter.h"
 #include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/RcotExtender.h"
 #include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/RcotExtenderFactory.h"
 #include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/RegularErrorMultiPointCotFactory.h"
@@ -127,5 +128,42 @@ TEST(RcotExtenderTest, testWithRegularErrorMPCOTandRealSPCOT) {
           std::make_unique<SinglePointCotFactory>())));
 }
 
+TEST(RcotExtenderTest, testLpnParameterPresets) {
+  std::vector<LpnParameter> presets{kSmallLpnParameter, kLargeLpnParameter};
+  int64_t previousOutputSize = 0;
+  for (auto& preset : presets) {
+    // each single point cot covers a power-of-2 long piece of the output
+    auto spcotLength = preset.extendedSize / preset.weight;
+    EXPECT_EQ(preset.extendedSize % preset.weight, 0);
+    EXPECT_EQ(spcotLength & (spcotLength - 1), 0);
+
+    RcotExtenderFactory factory(
+        std::make_unique<TenLocalLinearMatrixMultiplierFactory>(),
+        std::make_unique<RegularErrorMultiPointCotFactory>(
+            std::make_unique<SinglePointCotFactory>()));
+    auto extender = factory.create();
+    auto baseCotSize = extender->receiverInit(
+        preset.extendedSize, preset.baseSize, preset.weight);
+    EXPECT_EQ(
+        getExtensionOutputSize(preset), preset.extendedSize - baseCotSize);
+
+    EXPECT_GT(getExtensionOutputSize(preset), previousOutputSize);
+    previousOutputSize = getExtensionOutputSize(preset);
+  }
+
+  auto smallOutputSize = getExtensionOutputSize(kSmallLpnParameter);
+  EXPECT_EQ(
+      selectLpnParameter(0).extendedSize, kSmallLpnParameter.extendedSize);
+  EXPECT_EQ(
+      selectLpnParameter(smallOutputSize).extendedSize,
+      kSmallLpnParameter.extendedSize);
+  EXPECT_EQ(
+      selectLpnParameter(smallOutputSize + 1).extendedSize,
+      kLargeLpnParameter.extendedSize);
+  EXPECT_EQ(
+      selectLpnParameter(1ULL << 40).extendedSize,
+      kLargeLpnParameter.extendedSize);
+}
+
 } // namespace
   // fbpcf::engine::tuple_generator::oblivious_transfer::ferret
@@ -74,6 +74,72 @@ void testSpCot(
   }
 }
 
+void testBatchSpCot(
+    std::unique_ptr<ISinglePointCot> sender,
+    std::unique_ptr<ISinglePointCot> receiver) {
+  __m128i delta = _mm_set_epi32(1, 1, 1, 1);
+  int numberOfExtensions = 7;
+  int depth = 10;
+  int baseOtSize = depth * numberOfExtensions;
+  std::vector<__m128i> baseOTSend(baseOtSize);
+  std::vector<__m128i> baseOTReceive(baseOtSize);
+
+  std::random_device rd;
+  std::mt19937_64 e(rd());
+  std::uniform_int_distribution<uint32_t> dist(0, 0xFFFFFFFF);
+
+  std::vector<uint32_t> positions(numberOfExtensions);
+  for (int j = 0; j < numberOfExtensions; j++) {
+    positions[j] = dist(e) & ((1 << depth) - 1);
+    for (int i = 0; i < depth; i++) {
+      auto index = j * depth + i;
+      baseOTSend[index] =
+          _mm_set_epi32(dist(e), dist(e), dist(e), dist(e) << 1);
+      baseOTReceive[index] = baseOTSend[index];
+
+      if (!((positions[j] >> (depth - 1 - i)) & 1)) {
+        baseOTReceive[index] = _mm_xor_si128(baseOTReceive[index], delta);
+      }
+    }
+  }
+
+  auto senderTask = [delta, numberOfExtensions](
+                        std::unique_ptr<ISinglePointCot> spcot,
+                        std::vector<__m128i>&& baseCot) {
+    spcot->senderInit(delta);
+    return spcot->senderBatchExtend(std::move(baseCot), numberOfExtensions);
+  };
+
+  auto receiverTask = [numberOfExtensions](
+                          std::unique_ptr<ISinglePointCot> spcot,
+                          std::vector<__m128i>&& baseCot) {
+    spcot->receiverInit();
+    return spcot->receiverBatchExtend(std::move(baseCot), numberOfExtensions);
+  };
+
+  auto f0 = std::async(senderTask, std::move(sender), std::move(baseOTSend));
+  auto f1 =
+      std::async(receiverTask, std::move(receiver), std::move(baseOTReceive));
+
+  auto sendResult = f0.get();
+  auto receiveResult = f1.get();
+
+  int length = 1 << depth;
+  ASSERT_EQ(sendResult.size(), length * numberOfExtensions);
+  ASSERT_EQ(receiveResult.size(), length * numberOfExtensions);
+  for (int j = 0; j < numberOfExtensions; j++) {
+    for (int i = 0; i < length; i++) {
+      auto index = j * length + i;
+      if (i == positions[j]) {
+        EXPECT_TRUE(compareM128i(
+            sendResult[index], _mm_xor_si128(receiveResult[index], delta)));
+      } else {
+        EXPECT_TRUE(compareM128i(sendResult[index], receiveResult[index]));
+      }
+    }
+  }
+}
+
 TEST(SPCotExtenderTest, testDummySPCot) {
   communication::InMemoryPartyCommunicationAgentHost host;
 
@@ -105,5 +171,85 @@ TEST(SPCotExtenderTest, testRealSPCot) {
   testSpCot(std::move(sender), std::move(receiver));
 }
 
+TEST(SPCotExtenderTest, testDummyBatchSPCot) {
+  communication::InMemoryPartyCommunicationAgentHost host;
+
+  std::unique_ptr<communication::IPartyCommunicationAgent> agent0 =
+      host.getAgent(0);
+  std::unique_ptr<communication::IPartyCommunicationAgent> agent1 =
+      host.getAgent(1);
+
+  insecure::DummySinglePointCotFactory factory(
+      std::make_unique<util::AesPrgFactory>(1024));
+  auto sender = factory.create(agent0);
+  auto receiver = factory.create(agent1);
+
+  testBatchSpCot(std::move(sender), std::move(receiver));
+}
+
+TEST(SPCotExtenderTest, testRealBatchSPCot) {
+  communication::InMemoryPartyCommunicationAgentHost host;
+
+  std::unique_ptr<communication::IPartyCommunicationAgent> agent0 =
+      host.getAgent(0);
+  std::unique_ptr<communication::IPartyCommunicationAgent> agent1 =
+      host.getAgent(1);
+
+  SinglePointCotFactory factory;
+  auto sender = factory.create(agent0);
+  auto receiver = factory.create(agent1);
+
+  testBatchSpCot(std::move(sender), std::move(receiver));
+}
+
+TEST(SPCotExtenderTest, testMultithreadedBatchSPCot) {
+  communication::InMemoryPartyCommunicationAgentHost host;
+
+  std::unique_ptr<communication::IPartyCommunicationAgent> agent0 =
+      host.getAgent(0);
+  std::unique_ptr<communication::IPartyCommunicationAgent> agent1 =
+      host.getAgent(1);
+
+  // each party has its own pool, with a different number of threads
+  auto sender = SinglePointCotFactory(std::make_shared<util::ThreadPool>(4))
+                    .create(agent0);
+  auto receiver = SinglePointCotFactory(std::make_shared<util::ThreadPool>(3))
+                      .create(agent1);
+
+  testBatchSpCot(std::move(sender), std::move(receiver));
+}
+
+TEST(SPCotExtenderTest, testHalfTreeSPCot) {
+  communication::InMemoryPartyCommunicationAgentHost host;
+
+  std::unique_ptr<communication::IPartyCommunicationAgent> agent0 =
+      host.getAgent(0);
+  std::unique_ptr<communication::IPartyCommunicationAgent> agent1 =
+      host.getAgent(1);
+
+  SinglePointCotFactory factory(nullptr, /*halfTree*/ true);
+  auto sender = factory.create(agent0);
+  auto receiver = factory.create(agent1);
+
+  testSpCot(std::move(sender), std::move(receiver));
+}
+
+TEST(SPCotExtenderTest, testHalfTreeBatchSPCot) {
+  communication::InMemoryPartyCommunicationAgentHost host;
+
+  std::unique_ptr<communication::IPartyCommunicationAgent> agent0 =
+      host.getAgent(0);
+  std::unique_ptr<communication::IPartyCommunicationAgent> agent1 =
+      host.getAgent(1);
+
+  auto sender = SinglePointCotFactory(
+                    std::make_shared<util::ThreadPool>(4), /*halfTree*/ true)
+                    .create(agent0);
+  auto receiver = SinglePointCotFactory(nullptr, /*halfTree*/ true)
+                      .create(agent1);
+
+  testBatchSpCot(std::move(sender), std::move(receiver));
+}
+
 } // namespace
   // fbpcf::engine::tuple_generator::oblivious_transfer::ferret
@@ -26,6 +26,36 @@ BENCHMARK(TenLocalLinearMatrixMultiplier, n) {
       std::make_unique<TenLocalLinearMatrixMultiplierFactory>(), n);
 }
 
+BENCHMARK_DRAW_LINE();
+
+// scaling of the multithreaded multiplier, relative to a single thread
+BENCHMARK_NAMED_PARAM(
+    benchmarkMultithreadedMatrixMultiplier,
+    TenLocalLinearMatrixMultiplier_1_thread,
+    1)
+BENCHMARK_RELATIVE_NAMED_PARAM(
+    benchmarkMultithreadedMatrixMultiplier,
+    TenLocalLinearMatrixMultiplier_2_threads,
+    2)
+BENCHMARK_RELATIVE_NAMED_PARAM(
+    benchmarkMultithreadedMatrixMultiplier,
+    TenLocalLinearMatrixMultiplier_4_threads,
+    4)
+BENCHMARK_RELATIVE_NAMED_PARAM(
+    benchmarkMultithreadedMatrixMultiplier,
+    TenLocalLinearMatrixMultiplier_8_threads,
+    8)
+BENCHMARK_RELATIVE_NAMED_PARAM(
+    benchmarkMultithreadedMatrixMultiplier,
+    TenLocalLinearMatrixMultiplier_16_threads,
+    16)
+BENCHMARK_RELATIVE_NAMED_PARAM(
+    benchmarkMultithreadedMatrixMultiplier,
+    TenLocalLinearMatrixMultiplier_32_threads,
+    32)
+
+BENCHMARK_DRAW_LINE();
+
 BENCHMARK_COUNTERS(SinglePointCot, counters) {
   SinglePointCotBenchmark benchmark;
   benchmark.runBenchmark(counters);
@@ -40,6 +70,21 @@ BENCHMARK_COUNTERS(RcotExtender, counters) {
   RcotExtenderBenchmark benchmark;
   benchmark.runBenchmark(counters);
 }
+
+BENCHMARK_COUNTERS(HalfTreeSinglePointCot, counters) {
+  SinglePointCotBenchmark benchmark(/*halfTree*/ true);
+  benchmark.runBenchmark(counters);
+}
+
+BENCHMARK_COUNTERS(RegularErrorMultiPointCotWithHalfTree, counters) {
+  RegularErrorMultiPointCotBenchmark benchmark(/*halfTree*/ true);
+  benchmark.runBenchmark(counters);
+}
+
+BENCHMARK_COUNTERS(RcotExtenderWithHalfTree, counters) {
+  RcotExtenderBenchmark benchmark(/*halfTree*/ true);
+  benchmark.runBenchmark(counters);
+}
 } // namespace fbpcf::engine::tuple_generator::oblivious_transfer::ferret
 
 int main(int argc, char* argv[]) {
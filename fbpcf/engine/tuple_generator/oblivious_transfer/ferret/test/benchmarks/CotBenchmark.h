@@ -50,12 +50,16 @@ getBaseOT(size_t baseOtSize) {
 
 class SinglePointCotBenchmark final : public util::NetworkedBenchmark {
  public:
+  // halfTree selects HalfTreeSinglePointCot over SinglePointCot
+  explicit SinglePointCotBenchmark(bool halfTree = false)
+      : halfTree_(halfTree) {}
+
   void setup() override {
     auto [agent0, agent1] = util::getSocketAgents();
     agent0_ = std::move(agent0);
     agent1_ = std::move(agent1);
 
-    SinglePointCotFactory factory;
+    SinglePointCotFactory factory(nullptr, halfTree_);
     sender_ = factory.create(agent0_);
     receiver_ = factory.create(agent1_);
 
@@ -82,6 +86,8 @@ class SinglePointCotBenchmark final : public util::NetworkedBenchmark {
   }
 
  private:
+  bool halfTree_;
+
   std::unique_ptr<communication::IPartyCommunicationAgent> agent0_;
   std::unique_ptr<communication::IPartyCommunicationAgent> agent1_;
 
@@ -95,13 +101,16 @@ class SinglePointCotBenchmark final : public util::NetworkedBenchmark {
 class RegularErrorMultiPointCotBenchmark final
     : public util::NetworkedBenchmark {
  public:
+  explicit RegularErrorMultiPointCotBenchmark(bool halfTree = false)
+      : halfTree_(halfTree) {}
+
   void setup() override {
     auto [agent0, agent1] = util::getSocketAgents();
     agent0_ = std::move(agent0);
     agent1_ = std::move(agent1);
 
     RegularErrorMultiPointCotFactory factory(
-        std::make_unique<SinglePointCotFactory>());
+        std::make_unique<SinglePointCotFactory>(nullptr, halfTree_));
 
     sender_ = factory.create(agent0_);
     receiver_ = factory.create(agent1_);
@@ -129,6 +138,8 @@ class RegularErrorMultiPointCotBenchmark final
   }
 
  private:
+  bool halfTree_;
+
   std::unique_ptr<communication::IPartyCommunicationAgent> agent0_;
   std::unique_ptr<communication::IPartyCommunicationAgent> agent1_;
 
@@ -141,13 +152,16 @@ class RegularErrorMultiPointCotBenchmark final
 
 class RcotExtenderBenchmark final : public util::NetworkedBenchmark {
  public:
+  explicit RcotExtenderBenchmark(bool halfTree = false)
+      : halfTree_(halfTree) {}
+
   void setup() override {
     auto [agent0, agent1] = util::getSocketAgents();
 
     RcotExtenderFactory factory(
         std::make_unique<TenLocalLinearMatrixMultiplierFactory>(),
         std::make_unique<RegularErrorMultiPointCotFactory>(
-            std::make_unique<SinglePointCotFactory>()));
+            std::make_unique<SinglePointCotFactory>(nullptr, halfTree_)));
 
     sender_ = factory.create();
     receiver_ = factory.create();
@@ -178,6 +192,8 @@ class RcotExtenderBenchmark final : public util::NetworkedBenchmark {
   }
 
  private:
+  bool halfTree_;
+
   std::unique_ptr<IRcotExtender> sender_;
   std::unique_ptr<IRcotExtender> receiver_;
 
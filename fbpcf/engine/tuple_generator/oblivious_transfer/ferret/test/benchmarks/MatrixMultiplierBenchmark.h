@@ -14,7 +14,9 @@
 #include "fbpcf/engine/communication/IPartyCommunicationAgent.h"
 #include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/IMatrixMultiplierFactory.h"
 #include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/RegularErrorMultiPointCot.h"
+#include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/TenLocalLinearMatrixMultiplierFactory.h"
 #include "fbpcf/engine/util/AesPrgFactory.h"
+#include "fbpcf/engine/util/ThreadPool.h"
 
 namespace fbpcf::engine::tuple_generator::oblivious_transfer::ferret {
 
@@ -56,5 +58,16 @@ inline void benchmarkMatrixMultiplier(
   }
   folly::doNotOptimizeAway(rst);
 }
+
+inline void benchmarkMultithreadedMatrixMultiplier(
+    uint64_t n,
+    size_t numberOfThreads) {
+  std::unique_ptr<IMatrixMultiplierFactory> factory;
+  BENCHMARK_SUSPEND {
+    factory = std::make_unique<TenLocalLinearMatrixMultiplierFactory>(
+        std::make_shared<util::ThreadPool>(numberOfThreads));
+  }
+  benchmarkMatrixMultiplier(std::move(factory), n);
+}
 } // namespace
   // fbpcf::engine::tuple_generator::oblivious_transfer::ferret
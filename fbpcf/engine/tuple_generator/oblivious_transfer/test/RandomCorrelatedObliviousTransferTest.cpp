@@ -26,6 +26,7 @@
 #include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/DummyMultiPointCotFactory.h"
 #include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/DummyRcotExtenderFactory.h"
 #include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/DummySinglePointCotFactory.h"
+#include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/LpnParameter.h"
 #include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/RcotExtenderFactory.h"
 #include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/RegularErrorMultiPointCotFactory.h"
 #include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/SinglePointCotFactory.h"
@@ -227,6 +228,45 @@ TEST(
           ferret::kWeight));
 }
 
+TEST(
+    RandomCorrelatedObliviousTransferTest,
+    testExtenderBasedRcotWithBackgroundExtensionPoweredByMpcotWithRealSpcot) {
+  auto createFactory = []() {
+    return std::make_unique<
+        ExtenderBasedRandomCorrelatedObliviousTransferFactory>(
+        std::make_unique<
+            insecure::DummyRandomCorrelatedObliviousTransferFactory>(),
+        std::make_unique<ferret::RcotExtenderFactory>(
+            std::make_unique<ferret::TenLocalLinearMatrixMultiplierFactory>(),
+            std::make_unique<ferret::RegularErrorMultiPointCotFactory>(
+                std::make_unique<ferret::SinglePointCotFactory>())),
+        4096,
+        512,
+        32,
+        true);
+  };
+  testRandomCorrelatedObliviousTransfer(createFactory(), createFactory());
+}
+
+TEST(
+    RandomCorrelatedObliviousTransferTest,
+    testExtenderBasedRcotWithSmallLpnParameterPoweredByMpcotWithRealSpcot) {
+  auto createFactory = []() {
+    return std::make_unique<
+        ExtenderBasedRandomCorrelatedObliviousTransferFactory>(
+        std::make_unique<
+            insecure::DummyRandomCorrelatedObliviousTransferFactory>(),
+        std::make_unique<ferret::RcotExtenderFactory>(
+            std::make_unique<ferret::TenLocalLinearMatrixMultiplierFactory>(),
+            std::make_unique<ferret::RegularErrorMultiPointCotFactory>(
+                std::make_unique<ferret::SinglePointCotFactory>())),
+        ferret::kSmallLpnParameter.extendedSize,
+        ferret::kSmallLpnParameter.baseSize,
+        ferret::kSmallLpnParameter.weight);
+  };
+  testRandomCorrelatedObliviousTransfer(createFactory(), createFactory());
+}
+
 TEST(RandomCorrelatedObliviousTransferTest, testEmpRcot) {
   testRandomCorrelatedObliviousTransfer(
       std::make_unique<EmpShRandomCorrelatedObliviousTransferFactory>(
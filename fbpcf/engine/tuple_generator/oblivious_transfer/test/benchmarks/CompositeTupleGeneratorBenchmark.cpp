@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <folly/Benchmark.h>
+#include <map>
+#include <memory>
+
+#include "common/init/Init.h"
+
+#include "fbpcf/engine/communication/IPartyCommunicationAgentFactory.h"
+#include "fbpcf/engine/tuple_generator/TwoPartyCompositeTupleGenerator.h"
+#include "fbpcf/engine/tuple_generator/TwoPartyTupleGenerator.h"
+#include "fbpcf/engine/tuple_generator/oblivious_transfer/IRandomCorrelatedObliviousTransferFactory.h"
+#include "fbpcf/engine/tuple_generator/oblivious_transfer/IknpShRandomCorrelatedObliviousTransferFactory.h"
+#include "fbpcf/engine/tuple_generator/oblivious_transfer/NpBaseObliviousTransferFactory.h"
+#include "fbpcf/engine/util/test/benchmarks/BenchmarkHelper.h"
+#include "fbpcf/engine/util/test/benchmarks/NetworkedBenchmark.h"
+#include "fbpcf/engine/util/util.h"
+
+namespace fbpcf::engine::tuple_generator {
+
+// Both benchmarks produce the same number of AND products:
+// kNumberOfFamilies * kFamilyWidth.
+const uint32_t kNumberOfFamilies = 16384;
+const size_t kFamilyWidth = 32;
+
+class TwoPartyTupleGenerationBenchmark : public util::NetworkedBenchmark {
+ public:
+  void setup() override {
+    auto [factory0, factory1] = util::getSocketAgentFactories();
+    agentFactory0_ = std::move(factory0);
+    agentFactory1_ = std::move(factory1);
+  }
+
+  void runSender() override {
+    trafficStatistics_ = runParty(0, *agentFactory0_);
+  }
+
+  void runReceiver() override {
+    runParty(1, *agentFactory1_);
+  }
+
+  std::pair<uint64_t, uint64_t> getTrafficStatistics() override {
+    return trafficStatistics_;
+  }
+
+ protected:
+  // generate the tuples and return the traffic statistics.
+  virtual std::pair<uint64_t, uint64_t> generate(
+      std::unique_ptr<oblivious_transfer::IRandomCorrelatedObliviousTransfer>
+          senderRcot,
+      std::unique_ptr<oblivious_transfer::IRandomCorrelatedObliviousTransfer>
+          receiverRcot,
+      __m128i delta) = 0;
+
+ private:
+  std::pair<uint64_t, uint64_t> runParty(
+      int myId,
+      communication::IPartyCommunicationAgentFactory& agentFactory) {
+    oblivious_transfer::IknpShRandomCorrelatedObliviousTransferFactory
+        rcotFactory(std::make_unique<
+                    oblivious_transfer::NpBaseObliviousTransferFactory>());
+
+    auto delta = util::getRandomM128iFromSystemNoise();
+    util::setLsbTo1(delta);
+
+    // the same creation order as TwoPartyTupleGeneratorFactory
+    std::unique_ptr<oblivious_transfer::IRandomCorrelatedObliviousTransfer>
+        senderRcot;
+    std::unique_ptr<oblivious_transfer::IRandomCorrelatedObliviousTransfer>
+        receiverRcot;
+    if (myId == 0) {
+      senderRcot = rcotFactory.create(delta, agentFactory.create(1));
+      receiverRcot = rcotFactory.create(agentFactory.create(1));
+    } else {
+      receiverRcot = rcotFactory.create(agentFactory.create(0));
+      senderRcot = rcotFactory.create(delta, agentFactory.create(0));
+    }
+    return generate(std::move(senderRcot), std::move(receiverRcot), delta);
+  }
+
+  std::unique_ptr<communication::IPartyCommunicationAgentFactory>
+      agentFactory0_;
+  std::unique_ptr<communication::IPartyCommunicationAgentFactory>
+      agentFactory1_;
+
+  std::pair<uint64_t, uint64_t> trafficStatistics_;
+};
+
+class RegularTupleGeneratorBenchmark final
+    : public TwoPartyTupleGenerationBenchmark {
+ protected:
+  std::pair<uint64_t, uint64_t> generate(
+      std::unique_ptr<oblivious_transfer::IRandomCorrelatedObliviousTransfer>
+          senderRcot,
+      std::unique_ptr<oblivious_transfer::IRandomCorrelatedObliviousTransfer>
+          receiverRcot,
+      __m128i delta) override {
+    TwoPartyTupleGenerator generator(
+        std::move(senderRcot), std::move(receiverRcot), delta);
+    generator.getBooleanTuple(kNumberOfFamilies * kFamilyWidth);
+    return generator.getTrafficStatistics();
+  }
+};
+
+BENCHMARK_COUNTERS(TwoPartyTupleGenerator_RegularTuples, counters) {
+  RegularTupleGeneratorBenchmark benchmark;
+  benchmark.runBenchmark(counters);
+}
+
+class CompositeTupleGeneratorBenchmark final
+    : public TwoPartyTupleGenerationBenchmark {
+ protected:
+  std::pair<uint64_t, uint64_t> generate(
+      std::unique_ptr<oblivious_transfer::IRandomCorrelatedObliviousTransfer>
+          senderRcot,
+      std::unique_ptr<oblivious_transfer::IRandomCorrelatedObliviousTransfer>
+          receiverRcot,
+      __m128i delta) override {
+    TwoPartyCompositeTupleGenerator generator(
+        std::move(senderRcot), std::move(receiverRcot), delta);
+    generator.getCompositeTuple({{kFamilyWidth, kNumberOfFamilies}});
+    return generator.getTrafficStatistics();
+  }
+};
+
+BENCHMARK_COUNTERS(TwoPartyCompositeTupleGenerator_CompositeTuples, counters) {
+  CompositeTupleGeneratorBenchmark benchmark;
+  benchmark.runBenchmark(counters);
+}
+
+} // namespace fbpcf::engine::tuple_generator
+
+int main(int argc, char* argv[]) {
+  facebook::initFacebook(&argc, &argv);
+  folly::runBenchmarks();
+  return 0;
+}
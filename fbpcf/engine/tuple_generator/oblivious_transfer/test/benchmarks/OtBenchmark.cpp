@@ -16,6 +16,8 @@
 #include "fbpcf/engine/tuple_generator/oblivious_transfer/IRandomCorrelatedObliviousTransferFactory.h"
 #include "fbpcf/engine/tuple_generator/oblivious_transfer/IknpShRandomCorrelatedObliviousTransferFactory.h"
 #include "fbpcf/engine/tuple_generator/oblivious_transfer/NpBaseObliviousTransferFactory.h"
+#include "fbpcf/engine/tuple_generator/oblivious_transfer/RcotHelper.h"
+#include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/LpnParameter.h"
 #include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/RcotExtenderFactory.h"
 #include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/RegularErrorMultiPointCot.h"
 #include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/RegularErrorMultiPointCotFactory.h"
@@ -197,6 +199,122 @@ BENCHMARK_COUNTERS(
   benchmark.runBenchmark(counters);
 }
 
+// Runs a FERRET RCOT with one of the LPN parameter presets. The startup
+// variant times creating the RCOT's, i.e. the base OT's plus the first
+// extension. The steady state variant creates them during setup and times
+// drawing a fixed number of RCOT's, which takes several extensions with the
+// small preset. Besides the time, it reports the size of an extension.
+template <bool startup>
+class FerretLpnParameterBenchmark final : public util::NetworkedBenchmark {
+ public:
+  explicit FerretLpnParameterBenchmark(const ferret::LpnParameter& parameter)
+      : parameter_(parameter) {}
+
+  void addCounters(folly::UserCounters& counters) {
+    counters["rcot_per_extension"] =
+        ferret::getExtensionOutputSize(parameter_);
+    if (!startup) {
+      counters["rcot"] = size_;
+    }
+  }
+
+ protected:
+  void setup() override {
+    auto [agent0, agent1] = util::getSocketAgents();
+    agent0_ = std::move(agent0);
+    agent1_ = std::move(agent1);
+
+    std::random_device rd;
+    std::mt19937_64 e(rd());
+    std::uniform_int_distribution<uint64_t> dist(0, 0xFFFFFFFFFFFFFFFF);
+    delta_ = _mm_set_epi64x(dist(e), dist(e));
+    util::setLsbTo1(delta_);
+
+    factory_ = createFerretRcotFactory(parameter_);
+    if (!startup) {
+      auto senderTask = std::async([this]() { createSender(); });
+      createReceiver();
+      senderTask.get();
+      initialTraffic_ = sender_->getTrafficStatistics();
+    }
+  }
+
+  void runSender() override {
+    if (startup) {
+      createSender();
+    } else {
+      sender_->rcot(size_);
+    }
+  }
+
+  void runReceiver() override {
+    if (startup) {
+      createReceiver();
+    } else {
+      receiver_->rcot(size_);
+    }
+  }
+
+  std::pair<uint64_t, uint64_t> getTrafficStatistics() override {
+    auto [sent, received] = sender_->getTrafficStatistics();
+    return {sent - initialTraffic_.first, received - initialTraffic_.second};
+  }
+
+ private:
+  void createSender() {
+    sender_ = factory_->create(delta_, std::move(agent0_));
+  }
+
+  void createReceiver() {
+    receiver_ = factory_->create(std::move(agent1_));
+  }
+
+  ferret::LpnParameter parameter_;
+  size_t size_ = 16000000;
+  __m128i delta_;
+
+  std::unique_ptr<IRandomCorrelatedObliviousTransferFactory> factory_;
+
+  std::unique_ptr<communication::IPartyCommunicationAgent> agent0_;
+  std::unique_ptr<communication::IPartyCommunicationAgent> agent1_;
+
+  std::unique_ptr<IRandomCorrelatedObliviousTransfer> sender_;
+  std::unique_ptr<IRandomCorrelatedObliviousTransfer> receiver_;
+
+  std::pair<uint64_t, uint64_t> initialTraffic_{0, 0};
+};
+
+template <bool startup>
+void runFerretLpnParameterBenchmark(
+    const ferret::LpnParameter& parameter,
+    folly::UserCounters& counters) {
+  FerretLpnParameterBenchmark<startup> benchmark(parameter);
+  benchmark.runBenchmark(counters);
+  BENCHMARK_SUSPEND {
+    benchmark.addCounters(counters);
+  }
+}
+
+BENCHMARK_COUNTERS(FerretRcot_SmallLpnParameter_Startup, counters) {
+  runFerretLpnParameterBenchmark</*startup*/ true>(
+      ferret::kSmallLpnParameter, counters);
+}
+
+BENCHMARK_COUNTERS(FerretRcot_LargeLpnParameter_Startup, counters) {
+  runFerretLpnParameterBenchmark</*startup*/ true>(
+      ferret::kLargeLpnParameter, counters);
+}
+
+BENCHMARK_COUNTERS(FerretRcot_SmallLpnParameter_SteadyState, counters) {
+  runFerretLpnParameterBenchmark</*startup*/ false>(
+      ferret::kSmallLpnParameter, counters);
+}
+
+BENCHMARK_COUNTERS(FerretRcot_LargeLpnParameter_SteadyState, counters) {
+  runFerretLpnParameterBenchmark</*startup*/ false>(
+      ferret::kLargeLpnParameter, counters);
+}
+
 } // namespace fbpcf::engine::tuple_generator::oblivious_transfer
 
 int main(int argc, char* argv[]) {
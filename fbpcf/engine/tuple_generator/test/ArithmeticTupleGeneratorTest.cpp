@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+#include <future>
+#include <memory>
+
+#include "fbpcf/engine/tuple_generator/IArithmeticTupleGenerator.h"
+#include "fbpcf/engine/tuple_generator/test/TupleGeneratorTestHelper.h"
+
+namespace fbpcf::engine::tuple_generator {
+
+using ArithmeticTupleGeneratorFactoryCreator =
+    std::unique_ptr<IArithmeticTupleGeneratorFactory>(
+        int myId,
+        communication::IPartyCommunicationAgentFactory& agentFactory);
+
+void testArithmeticTupleGenerator(
+    ArithmeticTupleGeneratorFactoryCreator creator,
+    bool expectRandomTuples) {
+  auto agentFactories = communication::getInMemoryAgentFactory(2);
+
+  auto task =
+      [](ArithmeticTupleGeneratorFactoryCreator creator,
+         int myId,
+         std::reference_wrapper<communication::IPartyCommunicationAgentFactory>
+             agentFactory,
+         int size) {
+        auto generator = creator(myId, agentFactory)->create();
+        // fetch in uneven pieces to cover the buffer boundaries
+        auto rst = generator->getIntegerTuple(size / 3);
+        auto rest = generator->getIntegerTuple(size - size / 3);
+        rst.insert(rst.end(), rest.begin(), rest.end());
+        return rst;
+      };
+
+  // this size is larger than the tuple generator buffer size so we can test
+  // regeneration.
+  int size = kTestBufferSize * 4;
+
+  auto future0 = std::async(
+      task,
+      creator,
+      0,
+      std::reference_wrapper<communication::IPartyCommunicationAgentFactory>(
+          *agentFactories.at(0)),
+      size);
+  auto future1 = std::async(
+      task,
+      creator,
+      1,
+      std::reference_wrapper<communication::IPartyCommunicationAgentFactory>(
+          *agentFactories.at(1)),
+      size);
+  auto results0 = future0.get();
+  auto results1 = future1.get();
+
+  ASSERT_EQ(results0.size(), size);
+  ASSERT_EQ(results1.size(), size);
+  size_t nonZeroA = 0;
+  size_t nonZeroB = 0;
+  for (int i = 0; i < size; i++) {
+    uint64_t a = results0[i].getA() + results1[i].getA();
+    uint64_t b = results0[i].getB() + results1[i].getB();
+    uint64_t c = results0[i].getC() + results1[i].getC();
+    EXPECT_EQ(c, a * b);
+    nonZeroA += a != 0;
+    nonZeroB += b != 0;
+  }
+  if (expectRandomTuples) {
+    EXPECT_EQ(nonZeroA, size);
+    EXPECT_GT(nonZeroB, size / 2);
+  }
+}
+
+void testDaBitGenerator(
+    ArithmeticTupleGeneratorFactoryCreator creator,
+    bool expectRandomBits) {
+  auto agentFactories = communication::getInMemoryAgentFactory(2);
+
+  auto task =
+      [](ArithmeticTupleGeneratorFactoryCreator creator,
+         int myId,
+         std::reference_wrapper<communication::IPartyCommunicationAgentFactory>
+             agentFactory,
+         int size) {
+        auto generator = creator(myId, agentFactory)->create();
+        // interleave with tuples, which share the same RCOT's
+        auto rst = generator->getDaBit(size / 2);
+        generator->getIntegerTuple(kTestBufferSize + 1);
+        auto rest = generator->getDaBit(size - size / 2);
+        rst.insert(rst.end(), rest.begin(), rest.end());
+        return rst;
+      };
+
+  int size = kTestBufferSize;
+
+  auto future0 = std::async(
+      task,
+      creator,
+      0,
+      std::reference_wrapper<communication::IPartyCommunicationAgentFactory>(
+          *agentFactories.at(0)),
+      size);
+  auto future1 = std::async(
+      task,
+      creator,
+      1,
+      std::reference_wrapper<communication::IPartyCommunicationAgentFactory>(
+          *agentFactories.at(1)),
+      size);
+  auto results0 = future0.get();
+  auto results1 = future1.get();
+
+  ASSERT_EQ(results0.size(), size);
+  ASSERT_EQ(results1.size(), size);
+  size_t ones = 0;
+  for (int i = 0; i < size; i++) {
+    bool r = results0[i].getBooleanShare() ^ results1[i].getBooleanShare();
+    EXPECT_EQ(
+        results0[i].getIntegerShare() + results1[i].getIntegerShare(), r);
+    ones += r;
+  }
+  if (expectRandomBits) {
+    EXPECT_GT(ones, size / 4);
+    EXPECT_LT(ones, size * 3 / 4);
+  }
+}
+
+TEST(ArithmeticTupleGeneratorTest, testDummyArithmeticTupleGenerator) {
+  testArithmeticTupleGenerator(
+      createDummyArithmeticTupleGeneratorFactory, false);
+}
+
+TEST(ArithmeticTupleGeneratorTest, testTwoPartyGeneratorWithDummyRcot) {
+  testArithmeticTupleGenerator(
+      createTwoPartyArithmeticTupleGeneratorFactoryWithDummyRcot, false);
+}
+
+TEST(ArithmeticTupleGeneratorTest, testTwoPartyGeneratorWithRealOt) {
+  testArithmeticTupleGenerator(
+      createTwoPartyArithmeticTupleGeneratorFactoryWithRealOt, true);
+}
+
+TEST(ArithmeticTupleGeneratorTest, testTwoPartyGeneratorWithRcotExtender) {
+  testArithmeticTupleGenerator(
+      createTwoPartyArithmeticTupleGeneratorFactoryWithRcotExtender, true);
+}
+
+TEST(ArithmeticTupleGeneratorTest, testDummyDaBitGenerator) {
+  testDaBitGenerator(createDummyArithmeticTupleGeneratorFactory, false);
+}
+
+TEST(ArithmeticTupleGeneratorTest, testTwoPartyDaBitGeneratorWithDummyRcot) {
+  testDaBitGenerator(
+      createTwoPartyArithmeticTupleGeneratorFactoryWithDummyRcot, false);
+}
+
+TEST(ArithmeticTupleGeneratorTest, testTwoPartyDaBitGeneratorWithRealOt) {
+  testDaBitGenerator(
+      createTwoPartyArithmeticTupleGeneratorFactoryWithRealOt, true);
+}
+
+} // namespace fbpcf::engine::tuple_generator
@@ -9,6 +9,7 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 #include <future>
+#include <map>
 #include <memory>
 #include <thread>
 
@@ -74,10 +75,155 @@ void testTupleGenerator(
   }
 }
 
+void testPackedTupleGenerator(
+    int numberOfParty,
+    TupleGeneratorFactoryCreator creator) {
+  auto agentFactories = communication::getInMemoryAgentFactory(numberOfParty);
+
+  auto task =
+      [](TupleGeneratorFactoryCreator creator,
+         int numberOfParty,
+         int myId,
+         std::reference_wrapper<communication::IPartyCommunicationAgentFactory>
+             agentFactory,
+         int size) {
+        auto generator = creator(numberOfParty, myId, agentFactory)->create();
+        // request in uneven chunks so the buffer is split at arbitrary bit
+        // offsets
+        auto rst = generator->getPackedBooleanTuple(size / 3);
+        auto remaining = generator->getPackedBooleanTuple(size - size / 3);
+        rst.append(remaining, 0, remaining.size());
+        return rst;
+      };
+
+  int size = kTestBufferSize * 4 + 7;
+
+  std::vector<std::future<ITupleGenerator::PackedBooleanTuples>> futures;
+  for (int i = 0; i < numberOfParty; i++) {
+    futures.push_back(std::async(
+        task,
+        creator,
+        numberOfParty,
+        i,
+        std::reference_wrapper<communication::IPartyCommunicationAgentFactory>(
+            *agentFactories.at(i)),
+        size));
+  }
+
+  auto a = util::PackedBitVector(size);
+  auto b = util::PackedBitVector(size);
+  auto c = util::PackedBitVector(size);
+  for (int i = 0; i < numberOfParty; i++) {
+    auto result = futures[i].get();
+    ASSERT_EQ(result.size(), size);
+    a ^= result.getA();
+    b ^= result.getB();
+    c ^= result.getC();
+  }
+  EXPECT_EQ(c, a & b);
+}
+
+void testCompositeTupleGenerator(
+    int numberOfParty,
+    TupleGeneratorFactoryCreator creator) {
+  auto agentFactories = communication::getInMemoryAgentFactory(numberOfParty);
+
+  std::map<size_t, uint32_t> tupleSizes = {{1, 100}, {3, 1000}, {16, 500}};
+  int size = kTestBufferSize * 2;
+
+  auto task =
+      [&tupleSizes, size](
+          TupleGeneratorFactoryCreator creator,
+          int numberOfParty,
+          int myId,
+          std::reference_wrapper<communication::IPartyCommunicationAgentFactory>
+              agentFactory) {
+        auto generator = creator(numberOfParty, myId, agentFactory)->create();
+        EXPECT_TRUE(generator->supportsCompositeTupleGeneration());
+        // interleave with regular tuples to test the generator can share the
+        // underlying resources between both kinds of tuples.
+        auto tuples = generator->getBooleanTuple(size / 3);
+        auto compositeTuples = generator->getCompositeTuple(tupleSizes);
+        auto moreTuples = generator->getBooleanTuple(size);
+        auto moreCompositeTuples = generator->getCompositeTuple(tupleSizes);
+        tuples.insert(tuples.end(), moreTuples.begin(), moreTuples.end());
+        for (auto& item : moreCompositeTuples) {
+          compositeTuples[item.first].insert(
+              compositeTuples[item.first].end(),
+              item.second.begin(),
+              item.second.end());
+        }
+        return std::make_pair(tuples, compositeTuples);
+      };
+
+  std::vector<std::future<std::pair<
+      std::vector<ITupleGenerator::BooleanTuple>,
+      std::map<size_t, std::vector<ITupleGenerator::CompositeBooleanTuple>>>>>
+      futures;
+  for (int i = 0; i < numberOfParty; i++) {
+    futures.push_back(std::async(
+        task,
+        creator,
+        numberOfParty,
+        i,
+        std::reference_wrapper<communication::IPartyCommunicationAgentFactory>(
+            *agentFactories.at(i))));
+  }
+
+  std::vector<std::vector<ITupleGenerator::BooleanTuple>> results;
+  std::vector<
+      std::map<size_t, std::vector<ITupleGenerator::CompositeBooleanTuple>>>
+      compositeResults;
+  for (int i = 0; i < numberOfParty; i++) {
+    auto result = futures[i].get();
+    results.push_back(std::move(result.first));
+    compositeResults.push_back(std::move(result.second));
+  }
+
+  for (int i = 0; i < results[0].size(); i++) {
+    bool a = false;
+    bool b = false;
+    bool c = false;
+    for (int j = 0; j < numberOfParty; j++) {
+      a ^= results[j][i].getA();
+      b ^= results[j][i].getB();
+      c ^= results[j][i].getC();
+    }
+    EXPECT_EQ(c, a & b);
+  }
+
+  for (auto& countOfTuples : tupleSizes) {
+    auto tupleSize = countOfTuples.first;
+    for (int j = 0; j < numberOfParty; j++) {
+      ASSERT_EQ(
+          compositeResults[j].at(tupleSize).size(), countOfTuples.second * 2);
+    }
+    for (int i = 0; i < countOfTuples.second * 2; i++) {
+      bool a = false;
+      std::vector<bool> b(tupleSize);
+      std::vector<bool> c(tupleSize);
+      for (int j = 0; j < numberOfParty; j++) {
+        auto& tuple = compositeResults[j].at(tupleSize).at(i);
+        ASSERT_EQ(tuple.size(), tupleSize);
+        a ^= tuple.getA();
+        for (int k = 0; k < tupleSize; k++) {
+          b[k] = b[k] ^ tuple.getB()[k];
+          c[k] = c[k] ^ tuple.getC()[k];
+        }
+      }
+      for (int k = 0; k < tupleSize; k++) {
+        EXPECT_EQ(c[k], a & b[k]);
+      }
+    }
+  }
+}
+
 TEST(TupleGeneratorTest, testDummyTupleGenerator) {
   int numberOfParty = 4;
 
   testTupleGenerator(numberOfParty, createDummyTupleGeneratorFactory);
+  testPackedTupleGenerator(numberOfParty, createDummyTupleGeneratorFactory);
+  testCompositeTupleGenerator(numberOfParty, createDummyTupleGeneratorFactory);
 }
 
 TEST(TupleGeneratorTest, testWithDummyProductShareGenerator) {
@@ -86,6 +232,12 @@ TEST(TupleGeneratorTest, testWithDummyProductShareGenerator) {
   testTupleGenerator(
       numberOfParty,
 
+      createInMemoryTupleGeneratorFactoryWithDummyProductShareGenerator);
+  testPackedTupleGenerator(
+      numberOfParty,
+      createInMemoryTupleGeneratorFactoryWithDummyProductShareGenerator);
+  testCompositeTupleGenerator(
+      numberOfParty,
       createInMemoryTupleGeneratorFactoryWithDummyProductShareGenerator);
 }
 
@@ -95,14 +247,22 @@ TEST(TupleGeneratorTest, testWithSecureProductShareGenerator) {
   testTupleGenerator(
       numberOfParty,
       createInMemoryTupleGeneratorFactoryWithRealProductShareGenerator);
+  testCompositeTupleGenerator(
+      numberOfParty,
+      createInMemoryTupleGeneratorFactoryWithRealProductShareGenerator);
 }
 
 TEST(TupleGeneratorTest, testTwoPartyTupleGeneratorWithDummyRcot) {
   testTupleGenerator(2, createTwoPartyTupleGeneratorFactoryWithDummyRcot);
+  testPackedTupleGenerator(
+      2, createTwoPartyTupleGeneratorFactoryWithDummyRcot);
+  testCompositeTupleGenerator(
+      2, createTwoPartyTupleGeneratorFactoryWithDummyRcot);
 }
 
 TEST(TupleGeneratorTest, testTwoPartyTupleGeneratorWithRealOt) {
   testTupleGenerator(2, createTwoPartyTupleGeneratorFactoryWithRealOt);
+  testCompositeTupleGenerator(2, createTwoPartyTupleGeneratorFactoryWithRealOt);
 }
 
 TEST(TupleGeneratorTest, testTwoPartyTupleGeneratorWithRcotExtender) {
@@ -15,11 +15,14 @@
 #include "fbpcf/engine/communication/InMemoryPartyCommunicationAgentFactory.h"
 #include "fbpcf/engine/communication/InMemoryPartyCommunicationAgentHost.h"
 #include "fbpcf/engine/communication/test/AgentFactoryCreationHelper.h"
+#include "fbpcf/engine/tuple_generator/DummyArithmeticTupleGeneratorFactory.h"
 #include "fbpcf/engine/tuple_generator/DummyProductShareGeneratorFactory.h"
 #include "fbpcf/engine/tuple_generator/DummyTupleGeneratorFactory.h"
+#include "fbpcf/engine/tuple_generator/IArithmeticTupleGeneratorFactory.h"
 #include "fbpcf/engine/tuple_generator/IProductShareGeneratorFactory.h"
 #include "fbpcf/engine/tuple_generator/ITupleGeneratorFactory.h"
 #include "fbpcf/engine/tuple_generator/ProductShareGeneratorFactory.h"
+#include "fbpcf/engine/tuple_generator/TwoPartyArithmeticTupleGeneratorFactory.h"
 #include "fbpcf/engine/tuple_generator/TupleGeneratorFactory.h"
 #include "fbpcf/engine/tuple_generator/TwoPartyTupleGeneratorFactory.h"
 #include "fbpcf/engine/tuple_generator/oblivious_transfer/RcotHelper.h"
@@ -107,7 +110,26 @@ createTwoPartyTupleGeneratorFactoryWithDummyRcot(
       std::reference_wrapper<communication::IPartyCommunicationAgentFactory>(
           agentFactory),
       myId,
-      kTestBufferSize);
+      kTestBufferSize,
+      /*enableCompositeTupleGeneration*/ true);
+}
+
+inline std::unique_ptr<ITupleGeneratorFactory>
+createTwoPartyTupleGeneratorFactoryWithDummyRcotWithoutCompositeTuples(
+    int /*numberOfParty*/,
+    int myId,
+    communication::IPartyCommunicationAgentFactory& agentFactory) {
+  auto rcot = std::unique_ptr<
+      oblivious_transfer::IRandomCorrelatedObliviousTransferFactory>(
+      std::make_unique<oblivious_transfer::insecure::
+                           DummyRandomCorrelatedObliviousTransferFactory>());
+  return std::make_unique<TwoPartyTupleGeneratorFactory>(
+      std::move(rcot),
+      std::reference_wrapper<communication::IPartyCommunicationAgentFactory>(
+          agentFactory),
+      myId,
+      kTestBufferSize,
+      /*enableCompositeTupleGeneration*/ false);
 }
 
 inline std::unique_ptr<ITupleGeneratorFactory>
@@ -121,7 +143,8 @@ createTwoPartyTupleGeneratorFactoryWithRealOt(
       std::reference_wrapper<communication::IPartyCommunicationAgentFactory>(
           agentFactory),
       myId,
-      kTestBufferSize);
+      kTestBufferSize,
+      /*enableCompositeTupleGeneration*/ true);
 }
 
 inline std::unique_ptr<ITupleGeneratorFactory>
@@ -136,6 +159,49 @@ createTwoPartyTupleGeneratorFactoryWithRcotExtender(
       std::reference_wrapper<communication::IPartyCommunicationAgentFactory>(
           agentFactory),
       myId,
+      kTestBufferSize,
+      /*enableCompositeTupleGeneration*/ true);
+}
+
+inline std::unique_ptr<IArithmeticTupleGeneratorFactory>
+createDummyArithmeticTupleGeneratorFactory(
+    int /*myId*/,
+    communication::IPartyCommunicationAgentFactory& /*agentFactory*/) {
+  return std::make_unique<insecure::DummyArithmeticTupleGeneratorFactory>();
+}
+
+inline std::unique_ptr<IArithmeticTupleGeneratorFactory>
+createTwoPartyArithmeticTupleGeneratorFactoryWithDummyRcot(
+    int myId,
+    communication::IPartyCommunicationAgentFactory& agentFactory) {
+  auto rcot = std::unique_ptr<
+      oblivious_transfer::IRandomCorrelatedObliviousTransferFactory>(
+      std::make_unique<oblivious_transfer::insecure::
+                           DummyRandomCorrelatedObliviousTransferFactory>());
+  return std::make_unique<TwoPartyArithmeticTupleGeneratorFactory>(
+      std::move(rcot), agentFactory, myId, kTestBufferSize);
+}
+
+inline std::unique_ptr<IArithmeticTupleGeneratorFactory>
+createTwoPartyArithmeticTupleGeneratorFactoryWithRealOt(
+    int myId,
+    communication::IPartyCommunicationAgentFactory& agentFactory) {
+  return std::make_unique<TwoPartyArithmeticTupleGeneratorFactory>(
+      oblivious_transfer::createClassicRcotFactory(),
+      agentFactory,
+      myId,
+      kTestBufferSize);
+}
+
+inline std::unique_ptr<IArithmeticTupleGeneratorFactory>
+createTwoPartyArithmeticTupleGeneratorFactoryWithRcotExtender(
+    int myId,
+    communication::IPartyCommunicationAgentFactory& agentFactory) {
+  return std::make_unique<TwoPartyArithmeticTupleGeneratorFactory>(
+      oblivious_transfer::createFerretRcotFactory(
+          kTestExtendedSize, kTestBaseSize, kTestWeight),
+      agentFactory,
+      myId,
       kTestBufferSize);
 }
 
@@ -7,61 +7,167 @@
 
 #pragma once
 
+#include <chrono>
 #include <cstdint>
 #include <functional>
 #include <future>
+#include <optional>
 #include <vector>
 
 namespace fbpcf::engine::util {
 
+/**
+ * Copy data[offset, offset + size) to the end of dst. This is the default used
+ * by AsyncBuffer; containers other than std::vector need to provide a member
+ * append(src, offset, size).
+ */
+template <typename T>
+inline void appendToBuffer(
+    std::vector<T>& dst,
+    const std::vector<T>& src,
+    uint64_t offset,
+    uint64_t size) {
+  dst.insert(dst.end(), src.begin() + offset, src.begin() + offset + size);
+}
+
+template <typename Container>
+inline void appendToBuffer(
+    Container& dst,
+    const Container& src,
+    uint64_t offset,
+    uint64_t size) {
+  dst.append(src, offset, size);
+}
+
 /**
  * Holds a buffer that returns the requested amount of data on-demand. Data is
  * regenerated in chunks asynchronously.
+ * By default the data is stored in a std::vector<T>, a different Container
+ * (e.g. a bit-packed one) can be used as long as it has size() and a matching
+ * appendToBuffer overload.
+ * The chunks are generated one after another, so that generateData can talk
+ * to other parties as long as they request the same data in the same order.
  */
-template <typename T>
+template <typename T, typename Container = std::vector<T>>
 class AsyncBuffer {
  public:
   AsyncBuffer(
       uint64_t bufferSize,
-      std::function<std::vector<T>(uint64_t size)> generateData)
+      std::function<Container(uint64_t size)> generateData)
       : bufferSize_{bufferSize},
-        bufferIndex_{bufferSize},
+        bufferIndex_{0},
         generateData_{generateData} {
     futureBuffer_ = std::async(generateData_, bufferSize_);
+    futureBufferSize_ = bufferSize_;
   }
 
   ~AsyncBuffer() {
-    futureBuffer_.get();
+    if (futureBuffer_.valid()) {
+      futureBuffer_.get();
+    }
   }
 
-  std::vector<T> getData(uint64_t size) {
-    std::vector<T> rst;
+  Container getData(uint64_t size) {
+    Container rst;
     while (rst.size() < size) {
-      if (bufferIndex_ >= bufferSize_) {
-        buffer_ = futureBuffer_.get();
+      if (bufferIndex_ >= buffer_.size()) {
+        if (readyBuffer_.has_value()) {
+          buffer_ = std::move(readyBuffer_.value());
+          readyBuffer_.reset();
+        } else {
+          auto start = std::chrono::steady_clock::now();
+          buffer_ = futureBuffer_.get();
+          futureBufferSize_ = 0;
+          waitTime_ += std::chrono::steady_clock::now() - start;
+        }
         bufferIndex_ = 0;
-        futureBuffer_ = std::async(generateData_, bufferSize_);
+        if (!futureBuffer_.valid()) {
+          futureBuffer_ = std::async(generateData_, bufferSize_);
+          futureBufferSize_ = bufferSize_;
+        }
       }
 
-      auto insertSize = std::min(size - rst.size(), bufferSize_ - bufferIndex_);
-      rst.insert(
-          rst.end(),
-          buffer_.begin() + bufferIndex_,
-          buffer_.begin() + bufferIndex_ + insertSize);
+      auto insertSize =
+          std::min(size - rst.size(), buffer_.size() - bufferIndex_);
+      appendToBuffer(rst, buffer_, bufferIndex_, insertSize);
       bufferIndex_ += insertSize;
     }
     return rst;
   }
 
+  /**
+   * Make sure the next size elements are generated or being generated, so
+   * that a large request doesn't wait for several chunks one after another.
+   * The missing elements are generated right after the in-flight chunk, as
+   * part of it.
+   */
+  void prefetch(uint64_t size) {
+    uint64_t availableSize = buffer_.size() - bufferIndex_ + futureBufferSize_ +
+        (readyBuffer_.has_value() ? readyBuffer_->size() : 0);
+    if (availableSize >= size) {
+      return;
+    }
+    auto missingSize = size - availableSize;
+    if (futureBuffer_.valid()) {
+      auto generateMissingData = [this, missingSize](
+                                     std::future<Container> previousBuffer) {
+        auto data = previousBuffer.get();
+        auto missingData = generateData_(missingSize);
+        appendToBuffer(data, missingData, 0, missingData.size());
+        return data;
+      };
+      futureBuffer_ =
+          std::async(generateMissingData, std::move(futureBuffer_));
+    } else {
+      futureBuffer_ = std::async(generateData_, missingSize);
+    }
+    futureBufferSize_ += missingSize;
+  }
+
+  /**
+   * Get how long getData() was blocked waiting for data to be generated.
+   */
+  std::chrono::nanoseconds getWaitTime() const {
+    return waitTime_;
+  }
+
+  /**
+   * Run f after the in-flight generation (if any) has finished. The next
+   * generation only starts after f returns. This allows f to share resources
+   * such as communication channels with generateData, in an order that is
+   * deterministic across parties.
+   */
+  template <typename F>
+  auto runExclusively(F f) {
+    if (futureBuffer_.valid()) {
+      auto data = futureBuffer_.get();
+      futureBufferSize_ = 0;
+      if (readyBuffer_.has_value()) {
+        appendToBuffer(readyBuffer_.value(), data, 0, data.size());
+      } else {
+        readyBuffer_ = std::move(data);
+      }
+    }
+    return f();
+  }
+
  private:
   uint64_t bufferSize_;
   uint64_t bufferIndex_;
 
-  std::function<std::vector<T>(uint64_t size)> generateData_;
+  std::function<Container(uint64_t size)> generateData_;
+
+  Container buffer_;
+
+  // a generated buffer that is waiting to be consumed, only set when the
+  // background generation was stopped by runExclusively.
+  std::optional<Container> readyBuffer_;
 
-  std::vector<T> buffer_;
+  std::future<Container> futureBuffer_;
+  // the size of the data futureBuffer_ is generating
+  uint64_t futureBufferSize_ = 0;
 
-  std::future<std::vector<T>> futureBuffer_;
+  std::chrono::nanoseconds waitTime_{0};
 };
 
 } // namespace fbpcf::engine::util
@@ -10,6 +10,8 @@
 #include <assert.h>
 #include <emmintrin.h>
 #include <cstdint>
+#include <cstring>
+#include <vector>
 #include "fbpcf/engine/util/util.h"
 
 namespace fbpcf::engine::util {
@@ -24,6 +26,13 @@ class IPrg {
     return buildM128i(randomBytes);
   }
 
+  std::vector<uint64_t> getRandomUInt64(uint32_t size) {
+    auto randomBytes = getRandomBytes(size * sizeof(uint64_t));
+    std::vector<uint64_t> rst(size);
+    memcpy(rst.data(), randomBytes.data(), randomBytes.size());
+    return rst;
+  }
+
   virtual std::vector<bool> getRandomBits(uint32_t size) = 0;
 
   virtual std::vector<unsigned char> getRandomBytes(uint32_t size) = 0;
@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <emmintrin.h>
+#include <stdexcept>
+
+#include "fbpcf/engine/util/PackedBitVector.h"
+
+namespace fbpcf::engine::util {
+
+PackedBitVector::PackedBitVector(size_t size, bool value)
+    : size_(size), words_(getNumberOfWords(size), value ? ~Word(0) : 0) {
+  clearTail();
+}
+
+PackedBitVector::PackedBitVector(const std::vector<bool>& src)
+    : size_(src.size()), words_(getNumberOfWords(src.size()), 0) {
+  // fill a whole word before writing it back.
+  size_t fullWords = size_ / kBitsPerWord;
+  for (size_t i = 0; i < fullWords; i++) {
+    Word word = 0;
+    for (size_t j = 0; j < kBitsPerWord; j++) {
+      word |= Word(src[i * kBitsPerWord + j]) << j;
+    }
+    words_[i] = word;
+  }
+  for (size_t j = fullWords * kBitsPerWord; j < size_; j++) {
+    set(j, src[j]);
+  }
+}
+
+std::vector<bool> PackedBitVector::toBoolVector() const {
+  std::vector<bool> rst(size_);
+  size_t fullWords = size_ / kBitsPerWord;
+  for (size_t i = 0; i < fullWords; i++) {
+    auto word = words_[i];
+    for (size_t j = 0; j < kBitsPerWord; j++) {
+      rst[i * kBitsPerWord + j] = (word >> j) & 1;
+    }
+  }
+  for (size_t j = fullWords * kBitsPerWord; j < size_; j++) {
+    rst[j] = get(j);
+  }
+  return rst;
+}
+
+void PackedBitVector::append(
+    const PackedBitVector& src,
+    size_t offset,
+    size_t length) {
+  if (offset + length > src.size_) {
+    throw std::out_of_range("Appending bits beyond the end of source.");
+  }
+  auto position = size_;
+  size_ += length;
+  words_.resize(getNumberOfWords(size_), 0);
+  for (size_t i = 0; i < length; i += kBitsPerWord) {
+    auto chunk = (length - i < kBitsPerWord) ? length - i : kBitsPerWord;
+    depositWord(position + i, src.extractWord(offset + i, chunk), chunk);
+  }
+}
+
+PackedBitVector PackedBitVector::operator^(const PackedBitVector& other) const {
+  PackedBitVector rst(*this);
+  rst ^= other;
+  return rst;
+}
+
+PackedBitVector PackedBitVector::operator&(const PackedBitVector& other) const {
+  PackedBitVector rst(*this);
+  rst &= other;
+  return rst;
+}
+
+PackedBitVector PackedBitVector::operator~() const {
+  PackedBitVector rst(size_);
+  auto src = reinterpret_cast<const __m128i*>(words_.data());
+  auto dst = reinterpret_cast<__m128i*>(rst.words_.data());
+  auto ones = _mm_set1_epi32(-1);
+  for (size_t i = 0; i < words_.size() / 2; i++) {
+    _mm_store_si128(dst + i, _mm_xor_si128(_mm_load_si128(src + i), ones));
+  }
+  rst.clearTail();
+  return rst;
+}
+
+PackedBitVector& PackedBitVector::operator^=(const PackedBitVector& other) {
+  checkSize(other);
+  auto src = reinterpret_cast<const __m128i*>(other.words_.data());
+  auto dst = reinterpret_cast<__m128i*>(words_.data());
+  for (size_t i = 0; i < words_.size() / 2; i++) {
+    _mm_store_si128(
+        dst + i,
+        _mm_xor_si128(_mm_load_si128(dst + i), _mm_load_si128(src + i)));
+  }
+  return *this;
+}
+
+PackedBitVector& PackedBitVector::operator&=(const PackedBitVector& other) {
+  checkSize(other);
+  auto src = reinterpret_cast<const __m128i*>(other.words_.data());
+  auto dst = reinterpret_cast<__m128i*>(words_.data());
+  for (size_t i = 0; i < words_.size() / 2; i++) {
+    _mm_store_si128(
+        dst + i,
+        _mm_and_si128(_mm_load_si128(dst + i), _mm_load_si128(src + i)));
+  }
+  return *this;
+}
+
+void PackedBitVector::clearTail() {
+  auto usedBits = size_ % kBitsPerWord;
+  auto usedWords = (size_ + kBitsPerWord - 1) / kBitsPerWord;
+  if (usedBits != 0) {
+    words_[usedWords - 1] &= (Word(1) << usedBits) - 1;
+  }
+  for (size_t i = usedWords; i < words_.size(); i++) {
+    words_[i] = 0;
+  }
+}
+
+PackedBitVector::Word PackedBitVector::extractWord(
+    size_t position,
+    size_t length) const {
+  auto index = position / kBitsPerWord;
+  auto shift = position % kBitsPerWord;
+  Word rst = words_[index] >> shift;
+  if (shift != 0 && index + 1 < words_.size()) {
+    rst |= words_[index + 1] << (kBitsPerWord - shift);
+  }
+  if (length < kBitsPerWord) {
+    rst &= (Word(1) << length) - 1;
+  }
+  return rst;
+}
+
+void PackedBitVector::depositWord(size_t position, Word word, size_t length) {
+  auto index = position / kBitsPerWord;
+  auto shift = position % kBitsPerWord;
+  words_[index] |= word << shift;
+  if (shift != 0 && length > kBitsPerWord - shift) {
+    words_[index + 1] |= word >> (kBitsPerWord - shift);
+  }
+}
+
+void PackedBitVector::checkSize(const PackedBitVector& other) const {
+  if (size_ != other.size_) {
+    throw std::invalid_argument("The input sizes are not the same.");
+  }
+}
+
+} // namespace fbpcf::engine::util
@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+namespace fbpcf::engine::util {
+
+/**
+ * A minimal allocator returning memory aligned to kAlignment bytes, so that
+ * word-wide kernels can use aligned SIMD loads and stores.
+ */
+template <class T, size_t kAlignment>
+class AlignedAllocator {
+ public:
+  using value_type = T;
+
+  template <class U>
+  struct rebind {
+    using other = AlignedAllocator<U, kAlignment>;
+  };
+
+  AlignedAllocator() noexcept = default;
+
+  template <class U>
+  explicit AlignedAllocator(const AlignedAllocator<U, kAlignment>&) noexcept {}
+
+  T* allocate(size_t n) {
+    // aligned_alloc requires the size to be a multiple of the alignment.
+    auto bytes = (n * sizeof(T) + kAlignment - 1) / kAlignment * kAlignment;
+    auto rst = std::aligned_alloc(kAlignment, bytes);
+    if (rst == nullptr) {
+      throw std::bad_alloc();
+    }
+    return static_cast<T*>(rst);
+  }
+
+  void deallocate(T* p, size_t) noexcept {
+    std::free(p);
+  }
+
+  template <class U>
+  bool operator==(const AlignedAllocator<U, kAlignment>&) const noexcept {
+    return true;
+  }
+
+  template <class U>
+  bool operator!=(const AlignedAllocator<U, kAlignment>&) const noexcept {
+    return false;
+  }
+};
+
+/**
+ * A bit vector that packs 64 bits into a word. The storage is cache-line
+ * aligned and always holds an even number of words, so kernels can process a
+ * full 128-bit SIMD register per iteration without a scalar tail. Bits beyond
+ * size() are kept at zero by every operation.
+ */
+class PackedBitVector {
+ public:
+  using Word = uint64_t;
+  static const size_t kBitsPerWord = 64;
+  static const size_t kAlignment = 64;
+
+  PackedBitVector() : size_(0) {}
+
+  explicit PackedBitVector(size_t size, bool value = false);
+
+  explicit PackedBitVector(const std::vector<bool>& src);
+
+  /**
+   * Unpack into a std::vector<bool>.
+   */
+  std::vector<bool> toBoolVector() const;
+
+  /**
+   * @return the number of bits stored
+   */
+  size_t size() const {
+    return size_;
+  }
+
+  /**
+   * @return the number of words backing this vector, including padding
+   */
+  size_t numberOfWords() const {
+    return words_.size();
+  }
+
+  Word* data() {
+    return words_.data();
+  }
+
+  const Word* data() const {
+    return words_.data();
+  }
+
+  bool get(size_t index) const {
+    return (words_[index / kBitsPerWord] >> (index % kBitsPerWord)) & 1;
+  }
+
+  void set(size_t index, bool value) {
+    auto mask = Word(1) << (index % kBitsPerWord);
+    auto& word = words_[index / kBitsPerWord];
+    word = value ? (word | mask) : (word & ~mask);
+  }
+
+  /**
+   * Append bits [offset, offset + length) of src to the end of this vector.
+   * @param src the vector to copy from
+   * @param offset the index of the first bit to copy
+   * @param length number of bits to copy
+   */
+  void append(const PackedBitVector& src, size_t offset, size_t length);
+
+  void append(const PackedBitVector& src) {
+    append(src, 0, src.size());
+  }
+
+  /**
+   * @return a copy of bits [offset, offset + length)
+   */
+  PackedBitVector slice(size_t offset, size_t length) const {
+    PackedBitVector rst;
+    rst.append(*this, offset, length);
+    return rst;
+  }
+
+  /**
+   * Element-wise XOR/AND of two vectors of the same size.
+   */
+  PackedBitVector operator^(const PackedBitVector& other) const;
+  PackedBitVector operator&(const PackedBitVector& other) const;
+
+  /**
+   * Element-wise NOT.
+   */
+  PackedBitVector operator~() const;
+
+  PackedBitVector& operator^=(const PackedBitVector& other);
+  PackedBitVector& operator&=(const PackedBitVector& other);
+
+  bool operator==(const PackedBitVector& other) const {
+    return size_ == other.size_ && words_ == other.words_;
+  }
+
+  bool operator!=(const PackedBitVector& other) const {
+    return !(*this == other);
+  }
+
+ private:
+  static size_t getNumberOfWords(size_t size) {
+    // round up to an even number of words, i.e. a whole number of __m128i.
+    return (size + 2 * kBitsPerWord - 1) / (2 * kBitsPerWord) * 2;
+  }
+
+  // clear the padding bits in the last used word.
+  void clearTail();
+
+  // read `length` (<= 64) bits starting at an arbitrary bit position.
+  Word extractWord(size_t position, size_t length) const;
+
+  // OR `length` (<= 64) bits into an arbitrary bit position, the target bits
+  // must be zero.
+  void depositWord(size_t position, Word word, size_t length);
+
+  void checkSize(const PackedBitVector& other) const;
+
+  size_t size_;
+  std::vector<Word, AlignedAllocator<Word, kAlignment>> words_;
+};
+
+} // namespace fbpcf::engine::util
@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "fbpcf/engine/util/ThreadPool.h"
+#include <stdexcept>
+
+namespace fbpcf::engine::util {
+
+ThreadPool::ThreadPool(size_t numberOfThreads) {
+  if (numberOfThreads == 0) {
+    throw std::invalid_argument("A thread pool needs at least one thread.");
+  }
+  for (size_t i = 1; i < numberOfThreads; i++) {
+    workers_.emplace_back([this]() { work(); });
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopped_ = true;
+  }
+  jobAvailable_.notify_all();
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+}
+
+void ThreadPool::parallelFor(
+    size_t numberOfTasks,
+    const std::function<void(size_t)>& task) {
+  if (numberOfTasks == 0) {
+    return;
+  }
+  std::lock_guard<std::mutex> parallelForLock(parallelForMutex_);
+  std::unique_lock<std::mutex> lock(mutex_);
+  task_ = &task;
+  numberOfTasks_ = numberOfTasks;
+  nextTask_ = 0;
+  finishedTasks_ = 0;
+  exception_ = nullptr;
+  jobId_++;
+  jobAvailable_.notify_all();
+
+  runTasks(lock);
+  jobDone_.wait(lock, [this]() { return finishedTasks_ == numberOfTasks_; });
+  task_ = nullptr;
+  if (exception_) {
+    std::rethrow_exception(exception_);
+  }
+}
+
+void ThreadPool::work() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  uint64_t lastJobId = 0;
+  while (true) {
+    jobAvailable_.wait(
+        lock, [&]() { return stopped_ || jobId_ != lastJobId; });
+    if (stopped_) {
+      return;
+    }
+    lastJobId = jobId_;
+    runTasks(lock);
+  }
+}
+
+void ThreadPool::runTasks(std::unique_lock<std::mutex>& lock) {
+  while (task_ != nullptr && nextTask_ < numberOfTasks_) {
+    auto index = nextTask_++;
+    auto& task = *task_;
+    lock.unlock();
+    std::exception_ptr exception;
+    try {
+      task(index);
+    } catch (...) {
+      exception = std::current_exception();
+    }
+    lock.lock();
+    if (exception && !exception_) {
+      exception_ = exception;
+    }
+    if (++finishedTasks_ == numberOfTasks_) {
+      jobDone_.notify_one();
+    }
+  }
+}
+
+} // namespace fbpcf::engine::util
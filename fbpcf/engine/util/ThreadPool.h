@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace fbpcf::engine::util {
+
+/**
+ * A fixed number of worker threads that run the tasks of parallelFor().
+ * The calling thread takes part in the work too, so a pool of n threads starts
+ * n - 1 workers. The pool runs one parallelFor() at a time.
+ */
+class ThreadPool {
+ public:
+  explicit ThreadPool(size_t numberOfThreads);
+
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  size_t getNumberOfThreads() const {
+    return workers_.size() + 1;
+  }
+
+  /**
+   * Run task(i) for every i in [0, numberOfTasks) and wait for all of them to
+   * finish. The tasks can run in any order and on any thread. If some tasks
+   * throw, the first exception is rethrown once all the tasks are done.
+   */
+  void parallelFor(
+      size_t numberOfTasks,
+      const std::function<void(size_t)>& task);
+
+ private:
+  void work();
+
+  // run tasks of the current job until there are none left.
+  void runTasks(std::unique_lock<std::mutex>& lock);
+
+  std::vector<std::thread> workers_;
+
+  std::mutex parallelForMutex_;
+
+  std::mutex mutex_;
+  std::condition_variable jobAvailable_;
+  std::condition_variable jobDone_;
+
+  const std::function<void(size_t)>* task_ = nullptr;
+  size_t numberOfTasks_ = 0;
+  size_t nextTask_ = 0;
+  size_t finishedTasks_ = 0;
+  uint64_t jobId_ = 0;
+  std::exception_ptr exception_;
+  bool stopped_ = false;
+};
+
+} // namespace fbpcf::engine::util
@@ -6,8 +6,12 @@
  */
 
 #include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
 
 #include "fbpcf/engine/util/AsyncBuffer.h"
+#include "fbpcf/engine/util/PackedBitVector.h"
 
 namespace fbpcf::engine::util {
 
@@ -53,4 +57,110 @@ TEST(AsyncBufferTest, TestGetData) {
     EXPECT_EQ(allData.at(i), i);
   }
 }
+
+TEST(AsyncBufferTest, TestGetPackedData) {
+  auto index = 0;
+  auto asyncBuffer = AsyncBuffer<bool, PackedBitVector>(
+      100, [&index](uint64_t size) {
+        PackedBitVector res(size);
+        for (auto i = 0; i < size; ++i) {
+          // an aperiodic pattern to catch misaligned copies
+          res.set(i, (index * index + index / 7) % 3 == 0);
+          index++;
+        }
+        return res;
+      });
+
+  PackedBitVector allData;
+  for (auto size : {37, 100, 64, 199}) {
+    auto newData = asyncBuffer.getData(size);
+    ASSERT_EQ(newData.size(), size);
+    allData.append(newData);
+  }
+
+  for (auto i = 0; i < 400; i++) {
+    EXPECT_EQ(allData.get(i), (i * i + i / 7) % 3 == 0);
+  }
+}
+
+TEST(AsyncBufferTest, TestRunExclusively) {
+  std::atomic<int32_t> index = 0;
+  std::atomic<bool> isGenerating = false;
+  auto asyncBuffer = AsyncBuffer<int32_t>(100, [&](uint64_t size) {
+    isGenerating = true;
+    std::vector<int32_t> res;
+    for (auto i = 0; i < size; ++i) {
+      res.push_back(index++);
+    }
+    isGenerating = false;
+    return res;
+  });
+
+  std::vector<int32_t> allData;
+  for (auto i = 0; i < 5; i++) {
+    // the generation must not run concurrently with the exclusive function
+    auto rst = asyncBuffer.runExclusively([&]() {
+      EXPECT_FALSE(isGenerating);
+      return index.load();
+    });
+    EXPECT_EQ(rst % 100, 0);
+    EXPECT_EQ(asyncBuffer.runExclusively([&]() { return index.load(); }), rst);
+
+    auto newData = asyncBuffer.getData(70);
+    allData.insert(allData.end(), newData.begin(), newData.end());
+  }
+
+  for (auto i = 0; i < 350; i++) {
+    EXPECT_EQ(allData.at(i), i);
+  }
+}
+
+TEST(AsyncBufferTest, TestPrefetch) {
+  auto index = 0;
+  std::vector<uint64_t> generationSizes;
+  auto asyncBuffer = AsyncBuffer<int32_t>(100, [&](uint64_t size) {
+    generationSizes.push_back(size);
+    std::vector<int32_t> res;
+    for (auto i = 0; i < size; ++i) {
+      res.push_back(index++);
+    }
+    return res;
+  });
+
+  // the missing elements are generated along with the in-flight chunk
+  asyncBuffer.prefetch(350);
+  auto allData = asyncBuffer.getData(30);
+  // the next chunk is generated once the first one is used
+  EXPECT_EQ(
+      asyncBuffer.runExclusively([&]() { return generationSizes; }),
+      std::vector<uint64_t>({100, 250, 100}));
+
+  // nothing is missing
+  asyncBuffer.prefetch(320);
+  auto newData = asyncBuffer.getData(320);
+  allData.insert(allData.end(), newData.begin(), newData.end());
+  asyncBuffer.prefetch(0);
+
+  // the data generated ahead is kept when running exclusively
+  asyncBuffer.runExclusively([]() { return 0; });
+  asyncBuffer.prefetch(200);
+  asyncBuffer.runExclusively([]() { return 0; });
+  newData = asyncBuffer.getData(200);
+  allData.insert(allData.end(), newData.begin(), newData.end());
+
+  for (auto i = 0; i < 550; i++) {
+    EXPECT_EQ(allData.at(i), i);
+  }
+}
+
+TEST(AsyncBufferTest, TestWaitTime) {
+  auto asyncBuffer = AsyncBuffer<int32_t>(100, [](uint64_t size) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    return std::vector<int32_t>(size);
+  });
+  EXPECT_EQ(asyncBuffer.getWaitTime().count(), 0);
+  asyncBuffer.getData(100);
+  EXPECT_GT(asyncBuffer.getWaitTime().count(), 0);
+}
+
 } // namespace fbpcf::engine::util
@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "fbpcf/engine/util/PackedBitVector.h"
+
+namespace fbpcf::engine::util {
+
+std::vector<bool> generateRandomBits(size_t size) {
+  std::random_device rd;
+  std::mt19937_64 e(rd());
+  std::uniform_int_distribution<uint8_t> dist(0, 1);
+  std::vector<bool> rst(size);
+  for (size_t i = 0; i < size; i++) {
+    rst[i] = dist(e);
+  }
+  return rst;
+}
+
+TEST(PackedBitVectorTest, testPackAndUnpack) {
+  for (size_t size : {0, 1, 63, 64, 65, 127, 128, 129, 1000}) {
+    auto bits = generateRandomBits(size);
+    PackedBitVector packed(bits);
+    EXPECT_EQ(packed.size(), size);
+    EXPECT_EQ(packed.numberOfWords() % 2, 0);
+    EXPECT_GE(packed.numberOfWords() * 64, size);
+    auto address = reinterpret_cast<uintptr_t>(packed.data());
+    EXPECT_EQ(address % PackedBitVector::kAlignment, 0);
+    EXPECT_EQ(packed.toBoolVector(), bits);
+    for (size_t i = 0; i < size; i++) {
+      EXPECT_EQ(packed.get(i), bits[i]);
+    }
+  }
+}
+
+TEST(PackedBitVectorTest, testSetAndConstantFill) {
+  PackedBitVector ones(130, true);
+  EXPECT_EQ(ones.toBoolVector(), std::vector<bool>(130, true));
+  // padding bits must be kept at zero
+  EXPECT_EQ(ones.data()[2], 0x3);
+  EXPECT_EQ(ones.data()[3], 0);
+
+  ones.set(129, false);
+  ones.set(0, false);
+  EXPECT_FALSE(ones.get(0));
+  EXPECT_FALSE(ones.get(129));
+  EXPECT_TRUE(ones.get(128));
+}
+
+TEST(PackedBitVectorTest, testBitwiseOperations) {
+  size_t size = 1000;
+  auto left = generateRandomBits(size);
+  auto right = generateRandomBits(size);
+  PackedBitVector packedLeft(left);
+  PackedBitVector packedRight(right);
+
+  auto xorRst = (packedLeft ^ packedRight).toBoolVector();
+  auto andRst = (packedLeft & packedRight).toBoolVector();
+  auto notRst = ~packedLeft;
+  for (size_t i = 0; i < size; i++) {
+    EXPECT_EQ(xorRst[i], left[i] ^ right[i]);
+    EXPECT_EQ(andRst[i], left[i] & right[i]);
+    EXPECT_EQ(notRst.get(i), !left[i]);
+  }
+  // NOT must not leak into the padding bits
+  EXPECT_EQ(notRst, PackedBitVector(notRst.toBoolVector()));
+
+  PackedBitVector wrongSize(size + 1);
+  EXPECT_THROW(packedLeft ^ wrongSize, std::invalid_argument);
+  EXPECT_THROW(packedLeft & wrongSize, std::invalid_argument);
+}
+
+TEST(PackedBitVectorTest, testAppendAndSlice) {
+  auto bits = generateRandomBits(1000);
+  PackedBitVector packed(bits);
+
+  // exercise every combination of source and destination alignments
+  PackedBitVector appended;
+  std::vector<bool> expected;
+  for (size_t offset : {0, 1, 63, 64, 100}) {
+    for (size_t length : {0, 1, 63, 64, 65, 300}) {
+      appended.append(packed, offset, length);
+      expected.insert(
+          expected.end(),
+          bits.begin() + offset,
+          bits.begin() + offset + length);
+      EXPECT_EQ(appended.toBoolVector(), expected);
+      EXPECT_EQ(
+          packed.slice(offset, length).toBoolVector(),
+          std::vector<bool>(
+              bits.begin() + offset, bits.begin() + offset + length));
+    }
+  }
+  // padding bits must still be zero
+  EXPECT_EQ(appended, PackedBitVector(expected));
+
+  EXPECT_THROW(packed.slice(900, 101), std::out_of_range);
+}
+
+} // namespace fbpcf::engine::util
@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+#include "fbpcf/engine/util/ThreadPool.h"
+
+namespace fbpcf::engine::util {
+
+TEST(ThreadPoolTest, TestParallelFor) {
+  for (size_t numberOfThreads : {1, 2, 8}) {
+    ThreadPool pool(numberOfThreads);
+    EXPECT_EQ(pool.getNumberOfThreads(), numberOfThreads);
+
+    // the pool can be reused for many jobs
+    for (size_t numberOfTasks : {0, 1, 7, 1000}) {
+      std::vector<size_t> results(numberOfTasks, 0);
+      pool.parallelFor(
+          numberOfTasks, [&results](size_t i) { results[i] += i + 1; });
+      for (size_t i = 0; i < numberOfTasks; i++) {
+        EXPECT_EQ(results[i], i + 1);
+      }
+    }
+  }
+}
+
+TEST(ThreadPoolTest, TestException) {
+  ThreadPool pool(4);
+  std::atomic<size_t> count = 0;
+  EXPECT_THROW(
+      pool.parallelFor(
+          100,
+          [&count](size_t i) {
+            count++;
+            if (i % 10 == 0) {
+              throw std::runtime_error("test");
+            }
+          }),
+      std::runtime_error);
+  // the other tasks still ran
+  EXPECT_EQ(count, 100);
+
+  pool.parallelFor(10, [&count](size_t /*i*/) { count++; });
+  EXPECT_EQ(count, 110);
+}
+
+TEST(ThreadPoolTest, TestInvalidNumberOfThreads) {
+  EXPECT_THROW(ThreadPool(0), std::invalid_argument);
+}
+
+} // namespace fbpcf::engine::util
@@ -10,6 +10,7 @@
 #include <smmintrin.h>
 #include <random>
 #include "fbpcf/engine/util/test/aesTestHelper.h"
+#include "fbpcf/engine/util/util.h"
 
 namespace fbpcf::engine::util {
 
@@ -38,4 +39,29 @@ TEST(aesTest, testEncryptionAndDecryption) {
   }
 }
 
+TEST(aesTest, testHalfTreeExpander) {
+  std::vector<__m128i> keys(16);
+  for (auto& key : keys) {
+    key = getRandomM128iFromSystemNoise();
+  }
+
+  auto children = HalfTreeExpander().expand(std::vector<__m128i>(keys));
+  // a fixed key expander gives the same children everywhere
+  auto expectedChildren = HalfTreeExpander().expand(std::vector<__m128i>(keys));
+
+  ASSERT_EQ(children.size(), 2 * keys.size());
+  for (size_t i = 0; i < keys.size(); i++) {
+    auto sum = _mm_xor_si128(children[2 * i], children[2 * i + 1]);
+    EXPECT_TRUE(_mm_testz_si128(
+        _mm_xor_si128(sum, keys[i]), _mm_xor_si128(sum, keys[i])));
+    for (int j = 0; j < 2; j++) {
+      auto diff =
+          _mm_xor_si128(children[2 * i + j], expectedChildren[2 * i + j]);
+      EXPECT_TRUE(_mm_testz_si128(diff, diff));
+    }
+    auto left = _mm_xor_si128(children[2 * i], keys[i]);
+    EXPECT_FALSE(_mm_testz_si128(left, left));
+  }
+}
+
 } // namespace fbpcf::engine::util
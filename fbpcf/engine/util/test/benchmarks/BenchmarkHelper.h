@@ -7,6 +7,8 @@
 
 #pragma once
 
+#include <chrono>
+#include <condition_variable>
 #include <future>
 #include <map>
 #include <memory>
@@ -14,6 +16,7 @@
 #include <queue>
 #include <random>
 #include <stdexcept>
+#include <thread>
 
 #include "fbpcf/engine/communication/IPartyCommunicationAgent.h"
 #include "fbpcf/engine/communication/IPartyCommunicationAgentFactory.h"
@@ -129,4 +132,107 @@ getSocketAgentFactories() {
       std::make_unique<util::BenchmarkSocketAgentFactory>(1, agentsByParty)};
 };
 
+// A wrapper around an agent that simulates a link with a given one-way
+// latency. The data sent are held back on a background thread until the
+// latency has passed, so that a round trip takes twice the latency on top of
+// the actual transfer, while the sender doesn't block.
+class DelayedPartyCommunicationAgent final
+    : public communication::IPartyCommunicationAgent {
+ public:
+  DelayedPartyCommunicationAgent(
+      std::unique_ptr<communication::IPartyCommunicationAgent> agent,
+      std::chrono::microseconds latency)
+      : agent_(std::move(agent)), latency_(latency) {
+    forwarder_ = std::thread([this]() { forward(); });
+  }
+
+  ~DelayedPartyCommunicationAgent() override {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      done_ = true;
+    }
+    cv_.notify_one();
+    forwarder_.join();
+  }
+
+  void send(const std::vector<unsigned char>& data) override {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      pending_.emplace(std::chrono::steady_clock::now() + latency_, data);
+    }
+    cv_.notify_one();
+  }
+
+  std::vector<unsigned char> receive(int size) override {
+    return agent_->receive(size);
+  }
+
+  std::pair<uint64_t, uint64_t> getTrafficStatistics() const override {
+    return agent_->getTrafficStatistics();
+  }
+
+ private:
+  // forward the pending data in order, each after its deadline, and flush
+  // everything before exiting.
+  void forward() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+      cv_.wait(lock, [this]() { return done_ || !pending_.empty(); });
+      if (pending_.empty()) {
+        return;
+      }
+      auto [deadline, data] = std::move(pending_.front());
+      pending_.pop();
+      lock.unlock();
+      std::this_thread::sleep_until(deadline);
+      agent_->send(data);
+      lock.lock();
+    }
+  }
+
+  std::unique_ptr<communication::IPartyCommunicationAgent> agent_;
+  std::chrono::microseconds latency_;
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::queue<std::pair<
+      std::chrono::steady_clock::time_point,
+      std::vector<unsigned char>>>
+      pending_;
+  bool done_ = false;
+  std::thread forwarder_;
+};
+
+// Creates the agents from another factory and delays everything they send.
+class DelayedAgentFactory final
+    : public communication::IPartyCommunicationAgentFactory {
+ public:
+  DelayedAgentFactory(
+      std::unique_ptr<communication::IPartyCommunicationAgentFactory> factory,
+      std::chrono::microseconds latency)
+      : factory_(std::move(factory)), latency_(latency) {}
+
+  std::unique_ptr<communication::IPartyCommunicationAgent> create(
+      int id) override {
+    return std::make_unique<DelayedPartyCommunicationAgent>(
+        factory_->create(id), latency_);
+  }
+
+ private:
+  std::unique_ptr<communication::IPartyCommunicationAgentFactory> factory_;
+  std::chrono::microseconds latency_;
+};
+
+// Same as getSocketAgentFactories(), except that every message arrives after
+// the given one-way latency, e.g. 25ms to simulate a link with 50ms RTT.
+inline std::pair<
+    std::unique_ptr<communication::IPartyCommunicationAgentFactory>,
+    std::unique_ptr<communication::IPartyCommunicationAgentFactory>>
+getDelayedSocketAgentFactories(std::chrono::microseconds latency) {
+  auto [factory0, factory1] = getSocketAgentFactories();
+  return {
+      std::make_unique<DelayedAgentFactory>(std::move(factory0), latency),
+      std::make_unique<DelayedAgentFactory>(std::move(factory1), latency)};
+}
+
 } // namespace fbpcf::engine::util
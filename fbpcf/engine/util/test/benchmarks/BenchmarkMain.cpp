@@ -13,6 +13,7 @@
 
 #include "fbpcf/engine/util/AesPrg.h"
 #include "fbpcf/engine/util/aes.h"
+#include "fbpcf/engine/util/util.h"
 #include "folly/BenchmarkUtil.h"
 
 namespace fbpcf::engine::util {
@@ -73,6 +74,34 @@ BENCHMARK(Aes_inPlaceHash, n) {
   folly::doNotOptimizeAway(data);
 }
 
+BENCHMARK(Expander_expand, n) {
+  folly::BenchmarkSuspender braces;
+  auto data = generateData();
+  braces.dismiss();
+
+  Expander expander(0);
+
+  std::vector<__m128i> rst;
+  while (n--) {
+    rst = expander.expand(std::vector<__m128i>(data));
+  }
+  folly::doNotOptimizeAway(rst);
+}
+
+BENCHMARK_RELATIVE(HalfTreeExpander_expand, n) {
+  folly::BenchmarkSuspender braces;
+  auto data = generateData();
+  braces.dismiss();
+
+  HalfTreeExpander expander;
+
+  std::vector<__m128i> rst;
+  while (n--) {
+    rst = expander.expand(std::vector<__m128i>(data));
+  }
+  folly::doNotOptimizeAway(rst);
+}
+
 BENCHMARK(AesPrg_getRandomBits, n) {
   folly::BenchmarkSuspender braces;
   auto seed = getRandomSeed();
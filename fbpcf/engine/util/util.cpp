@@ -30,4 +30,23 @@ std::vector<__m128i> Expander::expand(std::vector<__m128i>&& src) const {
   return rst;
 }
 
+std::vector<__m128i> HalfTreeExpander::expand(
+    std::vector<__m128i>&& src) const {
+  // sigma(x_L || x_R) = (x_L ^ x_R) || x_L, an orthomorphism
+  assert(!std::empty(src));
+  const __m128i highMask = _mm_set_epi64x(-1, 0);
+  std::vector<__m128i> hash(src.size());
+  for (size_t i = 0; i < src.size(); i++) {
+    hash[i] = _mm_xor_si128(
+        _mm_shuffle_epi32(src.at(i), 78), _mm_and_si128(src.at(i), highMask));
+  }
+  cipher_.inPlaceHash(hash);
+  std::vector<__m128i> rst(src.size() * 2);
+  for (size_t i = 0; i < src.size(); i++) {
+    rst[2 * i] = hash.at(i);
+    rst[2 * i + 1] = _mm_xor_si128(src.at(i), hash.at(i));
+  }
+  return rst;
+}
+
 } // namespace fbpcf::engine::util
@@ -128,4 +128,21 @@ class Expander {
   Aes cipher1_;
 };
 
+/**
+ * This class expands an array of n keys into an array of 2n keys, with the
+ * same layout as Expander but a single fixed-key AES call per key. The
+ * children of key s are H(s) and s ^ H(s), where H(x) = AES(sigma(x)) ^
+ * sigma(x) is a circular correlation robust hash, so the two children always
+ * XOR to their parent. See "Half-Tree" https://eprint.iacr.org/2022/1431.pdf
+ * for more details.
+ */
+class HalfTreeExpander {
+ public:
+  HalfTreeExpander() : cipher_(Aes::getFixedKey()) {}
+  std::vector<__m128i> expand(std::vector<__m128i>&& src) const;
+
+ private:
+  Aes cipher_;
+};
+
 } // namespace fbpcf::engine::util
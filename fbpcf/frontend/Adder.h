@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+namespace fbpcf::frontend {
+
+/**
+ * Adder policies decide which circuit Int uses for +, - and the comparisons,
+ * as a comparison is the borrow of a subtraction. A policy provides the static
+ * functions add(left, right) and subtract(left, right), that take two arrays
+ * of bits (lsb first) and return their sum/difference modulo 2^width as an
+ * array of OutputBitType, and lessThan<isSigned>(left, right), that returns
+ * whether left < right as an OutputBitType. The bits only need to support the
+ * ^, &, ! operators and compositeAND.
+ */
+
+/**
+ * The ripple-carry circuit propagates the carry from the lsb to the msb. It
+ * only needs width - 1 AND gates, but they form a chain, thus a secure
+ * addition takes width - 1 rounds of communication. Comparisons follow the same
+ * kind of chain.
+ */
+struct RippleCarryAdder {
+  template <
+      typename OutputBitType,
+      typename LeftBitType,
+      typename RightBitType,
+      size_t width>
+  static std::array<OutputBitType, width> add(
+      const std::array<LeftBitType, width>& left,
+      const std::array<RightBitType, width>& right);
+
+  template <
+      typename OutputBitType,
+      typename LeftBitType,
+      typename RightBitType,
+      size_t width>
+  static std::array<OutputBitType, width> subtract(
+      const std::array<LeftBitType, width>& left,
+      const std::array<RightBitType, width>& right);
+
+  template <
+      bool isSigned,
+      typename OutputBitType,
+      typename LeftBitType,
+      typename RightBitType,
+      size_t width>
+  static OutputBitType lessThan(
+      const std::array<LeftBitType, width>& left,
+      const std::array<RightBitType, width>& right);
+};
+
+/**
+ * One step in a prefix network: the (generate, propagate) signal of every
+ * target absorbs the signal of the source, which covers the bits right below
+ * the target's current span.
+ */
+struct PrefixStep {
+  size_t source;
+  std::vector<size_t> targets;
+};
+
+/**
+ * A parallel-prefix adder computes the generate/propagate signals of all the
+ * bits with one layer of AND gates and then computes all the carries at once
+ * with a prefix network of logarithmic depth. A PrefixNetwork provides
+ * static std::vector<PrefixStep> getSteps(size_t n), the steps to compute all
+ * prefixes of n signals in order. Steps sharing a source are evaluated with
+ * composite AND gates.
+ */
+template <typename PrefixNetwork>
+class ParallelPrefixAdder {
+ public:
+  template <
+      typename OutputBitType,
+      typename LeftBitType,
+      typename RightBitType,
+      size_t width>
+  static std::array<OutputBitType, width> add(
+      const std::array<LeftBitType, width>& left,
+      const std::array<RightBitType, width>& right);
+
+  template <
+      typename OutputBitType,
+      typename LeftBitType,
+      typename RightBitType,
+      size_t width>
+  static std::array<OutputBitType, width> subtract(
+      const std::array<LeftBitType, width>& left,
+      const std::array<RightBitType, width>& right);
+
+  /**
+   * Only the borrow out of the msb is needed for a comparison, so the signals
+   * are combined with a balanced binary tree instead of the prefix network.
+   */
+  template <
+      bool isSigned,
+      typename OutputBitType,
+      typename LeftBitType,
+      typename RightBitType,
+      size_t width>
+  static OutputBitType lessThan(
+      const std::array<LeftBitType, width>& left,
+      const std::array<RightBitType, width>& right);
+
+ private:
+  // generate[0] must already include the carry-in. Only generate[i] and
+  // propagate[i] for i < width - 1 go through the prefix network.
+  template <typename BitType, size_t width>
+  static std::array<BitType, width> computeSum(
+      const BitType& lsb,
+      std::vector<BitType> generate,
+      const std::vector<BitType>& propagate);
+};
+
+/**
+ * Sklansky's network: log2(n) layers, in layer d the top half of each
+ * 2^(d+1)-aligned block absorbs the prefix of its bottom half. The fan-out is
+ * high, which composite AND gates absorb for free.
+ */
+struct SklanskyNetwork {
+  static std::vector<PrefixStep> getSteps(size_t n);
+};
+
+/**
+ * Kogge-Stone's network: log2(n) layers with fan-out 1, at the cost of
+ * roughly n * log2(n) combinations.
+ */
+struct KoggeStoneNetwork {
+  static std::vector<PrefixStep> getSteps(size_t n);
+};
+
+/**
+ * Brent-Kung's network: an up-sweep and a down-sweep of a binary tree. It
+ * takes 2 * log2(n) - 1 layers but only about 2 * n combinations.
+ */
+struct BrentKungNetwork {
+  static std::vector<PrefixStep> getSteps(size_t n);
+};
+
+using SklanskyAdder = ParallelPrefixAdder<SklanskyNetwork>;
+using KoggeStoneAdder = ParallelPrefixAdder<KoggeStoneNetwork>;
+using BrentKungAdder = ParallelPrefixAdder<BrentKungNetwork>;
+
+} // namespace fbpcf::frontend
+
+#include "fbpcf/frontend/Adder_impl.h"
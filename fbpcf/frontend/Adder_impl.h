@@ -0,0 +1,304 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <algorithm>
+
+namespace fbpcf::frontend {
+
+template <
+    typename OutputBitType,
+    typename LeftBitType,
+    typename RightBitType,
+    size_t width>
+std::array<OutputBitType, width> RippleCarryAdder::add(
+    const std::array<LeftBitType, width>& left,
+    const std::array<RightBitType, width>& right) {
+  std::array<OutputBitType, width> rst;
+
+  rst[0] = left.at(0) ^ right.at(0);
+  auto carry = left.at(0) & right.at(0);
+
+  for (size_t i = 1; i < width - 1; i++) {
+    auto leftSum = carry ^ left.at(i);
+    auto rightSum = carry ^ right.at(i);
+    rst[i] = leftSum ^ right.at(i);
+    carry = (leftSum & rightSum) ^ carry;
+  }
+  auto leftSum = carry ^ left[width - 1];
+  rst[width - 1] = leftSum ^ right[width - 1];
+  return rst;
+}
+
+template <
+    typename OutputBitType,
+    typename LeftBitType,
+    typename RightBitType,
+    size_t width>
+std::array<OutputBitType, width> RippleCarryAdder::subtract(
+    const std::array<LeftBitType, width>& left,
+    const std::array<RightBitType, width>& right) {
+  std::array<OutputBitType, width> rst;
+
+  rst[0] = left.at(0) ^ right.at(0);
+  auto carry = (!left.at(0)) & right.at(0);
+
+  for (size_t i = 1; i < width - 1; i++) {
+    // the logic here is:
+    // 1. rst[i] is the xor of minuend, subtrahend, and carry over;
+    // 2. the new carry over is the old carry over if minuend = subtrahend;
+    // 3. otherwise, the new carry over is the subtrahend, no matter what's the
+    // carry over: if subtrahend is 0, then minuend is 1, thus carry over must
+    // be 0; similarly, if subtrahend is 1, then minuend is 0, thus carry over
+    // must be 1;
+    auto tmp = carry ^ right.at(i);
+    rst[i] = left.at(i) ^ tmp;
+    carry = carry ^ ((left.at(i) ^ right.at(i)) & tmp);
+  }
+  rst[width - 1] = carry ^ left.at(width - 1) ^ right.at(width - 1);
+  return rst;
+}
+
+/**
+ * The algorithm of comparising two unsigned integers comes as follows:
+ * 1. compare the msb: equal, or one is larger than the other.
+ * 2. if the msbs are equal, recursively compare the remaining bits.
+ * Since we are running an oblivious computation, the comparison result is
+ * unknown. Therefore we have to compare all the bits no matter the results.
+ * That results in our comparison results starts from the lsbs. In the i-th
+ * iteration, we get the comparison results of the least i significant bits in
+ * the two integers, stored in carry variable. Then we use that result to
+ * compute the comparison result of the i+1-th iteration: if the two (i+1)-th
+ * least significant bits are same,then the comparison result in the (i+1)-th
+ * iteration is still carry, otherwise it would be the comparison result of the
+ * two (i+1)-th lsbs. In summary we have: carry_{i+1} = left[i] == right[i] ?
+ * carry_{i} : right[i].
+ * The actual formula we use: carry = (carry ^ left[i]) & (carry ^ right[i]) ^
+ * right[i] realize the desired behavior: if left[i] and right[i] are the same,
+ * then the result would be the same as (carry ^ right[i]) & (carry ^ right[i])
+ * ^ right[i] = carry; otherwise carry ^ left[i] and carry ^ right[i] will be
+ * opposite (thus their product will always be 0), and the whole formula can be
+ * simplified to right[i]
+ */
+template <
+    bool isSigned,
+    typename OutputBitType,
+    typename LeftBitType,
+    typename RightBitType,
+    size_t width>
+OutputBitType RippleCarryAdder::lessThan(
+    const std::array<LeftBitType, width>& left,
+    const std::array<RightBitType, width>& right) {
+  OutputBitType carry = (!left[0]) & right[0];
+  for (size_t i = 1; i < width - 1; i++) {
+    carry = ((carry ^ left.at(i)) & (carry ^ right.at(i))) ^ right.at(i);
+  }
+  // the msb's meaning is different in signed and unsigend int
+  if constexpr (isSigned) {
+    carry = ((carry ^ left[width - 1]) & (carry ^ right[width - 1])) ^
+        left[width - 1];
+  } else {
+    carry = ((carry ^ left[width - 1]) & (carry ^ right[width - 1])) ^
+        right[width - 1];
+  }
+  return carry;
+}
+
+/**
+ * With generate g = a & b and propagate p = a ^ b, the carry out of bit i is
+ * G[0, i] where G[j, i] = g_i ^ p_i & G[j, i - 1]. Two adjacent spans combine
+ * as (G, P)[j, i] = (G[k + 1, i] ^ P[k + 1, i] & G[j, k], P[k + 1, i] &
+ * P[j, k]). The XOR can replace the OR of the textbook formula because a span
+ * can't generate and propagate a carry at the same time.
+ */
+template <typename PrefixNetwork>
+template <
+    typename OutputBitType,
+    typename LeftBitType,
+    typename RightBitType,
+    size_t width>
+std::array<OutputBitType, width> ParallelPrefixAdder<PrefixNetwork>::add(
+    const std::array<LeftBitType, width>& left,
+    const std::array<RightBitType, width>& right) {
+  // the carry out of the msb is dropped, so is its generate signal.
+  std::vector<OutputBitType> generate(width - 1);
+  std::vector<OutputBitType> propagate(width);
+  for (size_t i = 0; i < width; i++) {
+    propagate[i] = left.at(i) ^ right.at(i);
+  }
+  for (size_t i = 0; i + 1 < width; i++) {
+    generate[i] = left.at(i) & right.at(i);
+  }
+  return computeSum<OutputBitType, width>(
+      propagate.at(0), std::move(generate), propagate);
+}
+
+/**
+ * a - b = a + !b + 1, so we add the complement of the subtrahend with a
+ * carry-in of 1.
+ */
+template <typename PrefixNetwork>
+template <
+    typename OutputBitType,
+    typename LeftBitType,
+    typename RightBitType,
+    size_t width>
+std::array<OutputBitType, width> ParallelPrefixAdder<PrefixNetwork>::subtract(
+    const std::array<LeftBitType, width>& left,
+    const std::array<RightBitType, width>& right) {
+  std::vector<OutputBitType> generate(width - 1);
+  std::vector<OutputBitType> propagate(width);
+  for (size_t i = 0; i < width; i++) {
+    propagate[i] = !(left.at(i) ^ right.at(i));
+  }
+  for (size_t i = 0; i + 1 < width; i++) {
+    generate[i] = left.at(i) & !right.at(i);
+  }
+  if (width > 1) {
+    // the carry-in makes bit 0 generate a carry whenever it propagates one.
+    generate[0] = generate.at(0) ^ propagate.at(0);
+  }
+  return computeSum<OutputBitType, width>(
+      left.at(0) ^ right.at(0), std::move(generate), propagate);
+}
+
+/**
+ * For a span of bits, "less" says the span of left is smaller than that of
+ * right and "equal" says they are the same. A higher span H and the lower span
+ * L right below it combine as (less, equal) = (less_H ^ equal_H & less_L,
+ * equal_H & equal_L), both ANDs share equal_H and make a composite AND gate.
+ */
+template <typename PrefixNetwork>
+template <
+    bool isSigned,
+    typename OutputBitType,
+    typename LeftBitType,
+    typename RightBitType,
+    size_t width>
+OutputBitType ParallelPrefixAdder<PrefixNetwork>::lessThan(
+    const std::array<LeftBitType, width>& left,
+    const std::array<RightBitType, width>& right) {
+  std::vector<OutputBitType> less(width);
+  std::vector<OutputBitType> equal(width);
+  for (size_t i = 0; i < width; i++) {
+    equal[i] = !(left.at(i) ^ right.at(i));
+    less[i] = (!left.at(i)) & right.at(i);
+  }
+  // the msb's meaning is different in signed and unsigend int
+  if constexpr (isSigned) {
+    less[width - 1] = left.at(width - 1) & !right.at(width - 1);
+  }
+
+  // the i-th span of the next layer consists of the (2i)-th and (2i+1)-th
+  // spans of the current one, and the span containing the lsb is always the
+  // first one. Its equal signal is never needed.
+  for (size_t count = width; count > 1; count = (count + 1) / 2) {
+    less[0] = less.at(1) ^ (equal.at(1) & less.at(0));
+    for (size_t i = 1; 2 * i + 1 < count; i++) {
+      auto products = equal.at(2 * i + 1).compositeAND(
+          std::vector<OutputBitType>{less.at(2 * i), equal.at(2 * i)});
+      less[i] = less.at(2 * i + 1) ^ products.at(0);
+      equal[i] = products.at(1);
+    }
+    if (count % 2 == 1) {
+      less[count / 2] = less.at(count - 1);
+      equal[count / 2] = equal.at(count - 1);
+    }
+  }
+  return less.at(0);
+}
+
+template <typename PrefixNetwork>
+template <typename BitType, size_t width>
+std::array<BitType, width> ParallelPrefixAdder<PrefixNetwork>::computeSum(
+    const BitType& lsb,
+    std::vector<BitType> generate,
+    const std::vector<BitType>& propagate) {
+  auto n = generate.size();
+  std::vector<BitType> groupPropagate(
+      propagate.begin(), propagate.begin() + n);
+  // once a span reaches the lsb, its propagate signal is no longer needed.
+  std::vector<bool> reachesLsb(n, false);
+  if (n > 0) {
+    reachesLsb[0] = true;
+  }
+
+  for (auto& step : PrefixNetwork::getSteps(n)) {
+    std::vector<BitType> targetPropagate;
+    for (auto target : step.targets) {
+      targetPropagate.push_back(groupPropagate.at(target));
+    }
+    auto carried = generate.at(step.source).compositeAND(targetPropagate);
+    if (!reachesLsb.at(step.source)) {
+      auto propagated =
+          groupPropagate.at(step.source).compositeAND(targetPropagate);
+      for (size_t i = 0; i < step.targets.size(); i++) {
+        groupPropagate[step.targets.at(i)] = propagated.at(i);
+      }
+    }
+    for (size_t i = 0; i < step.targets.size(); i++) {
+      auto target = step.targets.at(i);
+      generate[target] = generate.at(target) ^ carried.at(i);
+      reachesLsb[target] = reachesLsb.at(step.source);
+    }
+  }
+
+  std::array<BitType, width> rst;
+  rst[0] = lsb;
+  for (size_t i = 1; i < width; i++) {
+    rst[i] = propagate.at(i) ^ generate.at(i - 1);
+  }
+  return rst;
+}
+
+inline std::vector<PrefixStep> SklanskyNetwork::getSteps(size_t n) {
+  std::vector<PrefixStep> steps;
+  for (size_t blockSize = 1; blockSize < n; blockSize *= 2) {
+    for (size_t start = blockSize; start < n; start += 2 * blockSize) {
+      PrefixStep step{start - 1, {}};
+      for (size_t i = start; i < std::min(start + blockSize, n); i++) {
+        step.targets.push_back(i);
+      }
+      steps.push_back(std::move(step));
+    }
+  }
+  return steps;
+}
+
+inline std::vector<PrefixStep> KoggeStoneNetwork::getSteps(size_t n) {
+  std::vector<PrefixStep> steps;
+  for (size_t distance = 1; distance < n; distance *= 2) {
+    // going downwards so that every source is read before it's updated in
+    // the same layer.
+    for (size_t i = n - 1; i >= distance; i--) {
+      steps.push_back(PrefixStep{i - distance, {i}});
+    }
+  }
+  return steps;
+}
+
+inline std::vector<PrefixStep> BrentKungNetwork::getSteps(size_t n) {
+  std::vector<PrefixStep> steps;
+  size_t distance = 1;
+  // up-sweep: the last signal of every aligned block of size 2 * distance
+  // absorbs the first half of the block.
+  for (; 2 * distance <= n; distance *= 2) {
+    for (size_t i = 2 * distance - 1; i < n; i += 2 * distance) {
+      steps.push_back(PrefixStep{i - distance, {i}});
+    }
+  }
+  // down-sweep: fill in the prefixes in between.
+  for (distance /= 2; distance > 0; distance /= 2) {
+    for (size_t i = 3 * distance - 1; i < n; i += 2 * distance) {
+      steps.push_back(PrefixStep{i - distance, {i}});
+    }
+  }
+  return steps;
+}
+
+} // namespace fbpcf::frontend
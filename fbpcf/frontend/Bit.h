@@ -11,16 +11,22 @@
 #include <memory>
 #include <type_traits>
 #include <vector>
+#include "fbpcf/scheduler/IArithmeticScheduler.h"
 #include "fbpcf/scheduler/IScheduler.h"
 
 namespace fbpcf::frontend {
 
+template <int schedulerId, bool usingBatch>
+class ReplayableFunction;
+
 template <bool isSecret, int schedulerId, bool usingBatch = false>
 class Bit : public scheduler::SchedulerKeeper<schedulerId> {
   using BoolType =
       typename std::conditional<usingBatch, std::vector<bool>, bool>::type;
   using WireType =
       scheduler::IScheduler::WireId<scheduler::IScheduler::Boolean>;
+  using IntegerWireType =
+      scheduler::IScheduler::WireId<scheduler::IScheduler::Arithmetic>;
 
  public:
   class ExtractedBit {
@@ -93,6 +99,17 @@ class Bit : public scheduler::SchedulerKeeper<schedulerId> {
   Bit<isSecret || isSecretOther, schedulerId, usingBatch> operator&(
       const Bit<isSecretOther, schedulerId, usingBatch>& other) const;
 
+  /**
+   * AND this bit with each of the bits in others. All the ANDs are computed by
+   * a single composite gate, which is cheaper than computing them one by one
+   * since this bit only needs to be processed once.
+   */
+  template <bool isSecretOther>
+  std::vector<Bit<isSecret || isSecretOther, schedulerId, usingBatch>>
+  compositeAND(
+      const std::vector<Bit<isSecretOther, schedulerId, usingBatch>>& others)
+      const;
+
   template <bool isSecretOther>
   Bit<isSecret || isSecretOther, schedulerId, usingBatch> operator^(
       const Bit<isSecretOther, schedulerId, usingBatch>& other) const;
@@ -118,7 +135,26 @@ class Bit : public scheduler::SchedulerKeeper<schedulerId> {
    */
   typename Bit<true, schedulerId, usingBatch>::ExtractedBit extractBit() const;
 
+  /**
+   * Convert secret bits, least significant bit first, to a private integer
+   * wire storing sum_k 2^k * bits[k] mod 2^64. All the bits are converted in
+   * one round. The scheduler needs to be an arithmetic scheduler. The caller
+   * owns the returned wire.
+   */
+  static IntegerWireType toIntegerWire(
+      const std::vector<Bit<isSecret, schedulerId, usingBatch>>& bits);
+
+  /**
+   * Secret share the lowest width bits of both parties' shares of a private
+   * integer wire, without communication. Return the two summands, least
+   * significant bit first; the integer is their sum mod 2^width.
+   */
+  static std::vector<std::vector<Bit<isSecret, schedulerId, usingBatch>>>
+  integerWireToSummands(IntegerWireType src, int8_t width);
+
  private:
+  static scheduler::IArithmeticScheduler& getArithmeticScheduler();
+
   void increaseReferenceCount(const WireType& v) const;
   void decreaseReferenceCount(const WireType& v) const;
   void moveId(WireType& dst, WireType& src) const;
@@ -127,6 +163,7 @@ class Bit : public scheduler::SchedulerKeeper<schedulerId> {
   WireType id_{};
 
   friend class Bit<!isSecret, schedulerId, usingBatch>;
+  friend class ReplayableFunction<schedulerId, usingBatch>;
 };
 
 } // namespace fbpcf::frontend
@@ -120,8 +120,7 @@ BitString<isSecret, schedulerId, usingBatch>::operator&(
 template <bool isSecret, int schedulerId, bool usingBatch>
 template <bool isSecretOther>
 BitString<isSecret || isSecretOther, schedulerId, usingBatch>
-BitString<isSecret, schedulerId, usingBatch>::
-    BitString<isSecret, schedulerId, usingBatch>::operator^(
+BitString<isSecret, schedulerId, usingBatch>::operator^(
         const BitString<isSecretOther, schedulerId, usingBatch>& src) const {
   if (src.size() != size()) {
     throw std::runtime_error(
@@ -153,8 +152,15 @@ BitString<isSecret, schedulerId, usingBatch>::mux(
       usingBatch>
       rst(data_.size());
 
+  // all the bits share the same choice, so one composite AND suffices.
+  std::vector<Bit<isSecret || isSecretOther, schedulerId, usingBatch>>
+      differences(size());
   for (size_t i = 0; i < size(); i++) {
-    rst[i] = data_.at(i) ^ (choice & (other.data_.at(i) ^ data_.at(i)));
+    differences[i] = other.data_.at(i) ^ data_.at(i);
+  }
+  auto selected = choice.compositeAND(differences);
+  for (size_t i = 0; i < size(); i++) {
+    rst[i] = data_.at(i) ^ selected.at(i);
   }
 
   return rst;
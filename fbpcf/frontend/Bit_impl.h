@@ -7,6 +7,8 @@
 
 #pragma once
 
+#include <stdexcept>
+
 // included for clangd resolution. Should not execute during compilation
 #include "fbpcf/frontend/Bit.h"
 
@@ -194,6 +196,54 @@ Bit<isSecret, schedulerId, usingBatch>::operator&(
   return rst;
 }
 
+template <bool isSecret, int schedulerId, bool usingBatch>
+template <bool isSecretOther>
+std::vector<Bit<isSecret || isSecretOther, schedulerId, usingBatch>>
+Bit<isSecret, schedulerId, usingBatch>::compositeAND(
+    const std::vector<Bit<isSecretOther, schedulerId, usingBatch>>& others)
+    const {
+  std::vector<Bit<isSecret || isSecretOther, schedulerId, usingBatch>> rst(
+      others.size());
+  if (others.empty()) {
+    return rst;
+  }
+
+  std::vector<WireType> rights(others.size());
+  for (size_t i = 0; i < others.size(); i++) {
+    rights[i] = others[i].id_;
+  }
+
+  auto& scheduler = scheduler::SchedulerKeeper<schedulerId>::getScheduler();
+  std::vector<WireType> ids;
+  if constexpr (isSecret && isSecretOther) {
+    // both are secret
+    if constexpr (usingBatch) {
+      ids = scheduler.privateAndPrivateCompositeBatch(id_, rights);
+    } else {
+      ids = scheduler.privateAndPrivateComposite(id_, rights);
+    }
+  } else if constexpr (!isSecret && !isSecretOther) {
+    // both are not secret
+    if constexpr (usingBatch) {
+      ids = scheduler.publicAndPublicCompositeBatch(id_, rights);
+    } else {
+      ids = scheduler.publicAndPublicComposite(id_, rights);
+    }
+  } else {
+    // one side is secret, the scheduler accepts a public value on either side
+    if constexpr (usingBatch) {
+      ids = scheduler.privateAndPublicCompositeBatch(id_, rights);
+    } else {
+      ids = scheduler.privateAndPublicComposite(id_, rights);
+    }
+  }
+
+  for (size_t i = 0; i < rst.size(); i++) {
+    rst[i].id_ = ids.at(i);
+  }
+  return rst;
+}
+
 template <bool isSecret, int schedulerId, bool usingBatch>
 template <bool isSecretOther>
 Bit<isSecret || isSecretOther, schedulerId, usingBatch>
@@ -293,4 +343,57 @@ Bit<isSecret, schedulerId, usingBatch>::extractBit() const {
   }
 }
 
+template <bool isSecret, int schedulerId, bool usingBatch>
+typename Bit<isSecret, schedulerId, usingBatch>::IntegerWireType
+Bit<isSecret, schedulerId, usingBatch>::toIntegerWire(
+    const std::vector<Bit<isSecret, schedulerId, usingBatch>>& bits) {
+  static_assert(isSecret, "Only secret bits need conversion.");
+  std::vector<WireType> ids(bits.size());
+  for (size_t i = 0; i < bits.size(); i++) {
+    ids[i] = bits[i].id_;
+  }
+  if constexpr (usingBatch) {
+    return getArithmeticScheduler().booleanToIntegerBatch(ids);
+  } else {
+    return getArithmeticScheduler().booleanToInteger(ids);
+  }
+}
+
+template <bool isSecret, int schedulerId, bool usingBatch>
+std::vector<std::vector<Bit<isSecret, schedulerId, usingBatch>>>
+Bit<isSecret, schedulerId, usingBatch>::integerWireToSummands(
+    IntegerWireType src,
+    int8_t width) {
+  static_assert(isSecret, "Only secret bits need conversion.");
+  std::vector<std::vector<WireType>> ids;
+  if constexpr (usingBatch) {
+    ids = getArithmeticScheduler().integerToBooleanSummandsBatch(src, width);
+  } else {
+    ids = getArithmeticScheduler().integerToBooleanSummands(src, width);
+  }
+  std::vector<std::vector<Bit<isSecret, schedulerId, usingBatch>>> summands(
+      ids.size());
+  for (size_t i = 0; i < ids.size(); i++) {
+    summands[i] =
+        std::vector<Bit<isSecret, schedulerId, usingBatch>>(ids[i].size());
+    for (size_t j = 0; j < ids[i].size(); j++) {
+      // the scheduler hands over the reference to the new wire
+      summands[i][j].id_ = ids[i][j];
+    }
+  }
+  return summands;
+}
+
+template <bool isSecret, int schedulerId, bool usingBatch>
+scheduler::IArithmeticScheduler&
+Bit<isSecret, schedulerId, usingBatch>::getArithmeticScheduler() {
+  auto scheduler = dynamic_cast<scheduler::IArithmeticScheduler*>(
+      &scheduler::SchedulerKeeper<schedulerId>::getScheduler());
+  if (scheduler == nullptr) {
+    throw std::runtime_error(
+        "Converting between bits and integers needs an arithmetic scheduler.");
+  }
+  return *scheduler;
+}
+
 } // namespace fbpcf::frontend
@@ -11,7 +11,9 @@
 #include <stdexcept>
 #include <type_traits>
 
+#include "fbpcf/frontend/Adder.h"
 #include "fbpcf/frontend/Bit.h"
+#include "fbpcf/frontend/Multiplier.h"
 #include "fbpcf/frontend/util.h"
 
 namespace fbpcf::frontend {
@@ -21,7 +23,8 @@ template <
     int8_t width,
     bool isSecret,
     int schedulerId,
-    bool usingBatch = false>
+    bool usingBatch = false,
+    typename AdderType = RippleCarryAdder>
 class Int {
   using UnitIntType =
       typename std::conditional<isSigned, int64_t, uint64_t>::type;
@@ -118,43 +121,116 @@ class Int {
    */
   explicit Int(ExtractedInt&& extractedInt);
 
+  /**
+   * Construct a private int from the lowest width bits of a private integer
+   * wire. The parties' shares of the wire are secret shared as two boolean
+   * summands for free, which are then added up by AdderType; a parallel-prefix
+   * adder takes O(log(width)) rounds. The scheduler needs to be an arithmetic
+   * scheduler.
+   */
+  explicit Int(
+      scheduler::IScheduler::WireId<scheduler::IScheduler::Arithmetic> src);
+
   void publicInput(const IntType& v);
 
   void privateInput(const IntType& v, int partyId);
 
   template <bool isSecretOther>
-  Int<isSigned, width, isSecret || isSecretOther, schedulerId, usingBatch>
-  operator+(const Int<isSigned, width, isSecretOther, schedulerId, usingBatch>&
-                other) const;
+  Int<isSigned,
+      width,
+      isSecret || isSecretOther,
+      schedulerId,
+      usingBatch,
+      AdderType>
+  operator+(const Int<isSigned,
+                      width,
+                      isSecretOther,
+                      schedulerId,
+                      usingBatch,
+                      AdderType>& other) const;
 
   template <bool isSecretOther>
-  Int<isSigned, width, isSecret || isSecretOther, schedulerId, usingBatch>
-  operator-(const Int<isSigned, width, isSecretOther, schedulerId, usingBatch>&
-                other) const;
+  Int<isSigned,
+      width,
+      isSecret || isSecretOther,
+      schedulerId,
+      usingBatch,
+      AdderType>
+  operator-(const Int<isSigned,
+                      width,
+                      isSecretOther,
+                      schedulerId,
+                      usingBatch,
+                      AdderType>& other) const;
+
+  /**
+   * Multiply two integers, the result is truncated to width bits, i.e. it's
+   * the product mod 2^width. When one of the operands is public, only the
+   * copies of the other operand shifted by the set bits of the public one
+   * need to be added up.
+   */
+  template <bool isSecretOther>
+  Int<isSigned,
+      width,
+      isSecret || isSecretOther,
+      schedulerId,
+      usingBatch,
+      AdderType>
+  operator*(const Int<isSigned,
+                      width,
+                      isSecretOther,
+                      schedulerId,
+                      usingBatch,
+                      AdderType>& other) const;
 
   template <bool isSecretOther>
   Bit<isSecret || isSecretOther, schedulerId, usingBatch> operator<(
-      const Int<isSigned, width, isSecretOther, schedulerId, usingBatch>& other)
+      const Int<isSigned,
+                width,
+                isSecretOther,
+                schedulerId,
+                usingBatch,
+                AdderType>& other)
       const;
 
   template <bool isSecretOther>
   Bit<isSecret || isSecretOther, schedulerId, usingBatch> operator<=(
-      const Int<isSigned, width, isSecretOther, schedulerId, usingBatch>& other)
+      const Int<isSigned,
+                width,
+                isSecretOther,
+                schedulerId,
+                usingBatch,
+                AdderType>& other)
       const;
 
   template <bool isSecretOther>
   Bit<isSecret || isSecretOther, schedulerId, usingBatch> operator>(
-      const Int<isSigned, width, isSecretOther, schedulerId, usingBatch>& other)
+      const Int<isSigned,
+                width,
+                isSecretOther,
+                schedulerId,
+                usingBatch,
+                AdderType>& other)
       const;
 
   template <bool isSecretOther>
   Bit<isSecret || isSecretOther, schedulerId, usingBatch> operator>=(
-      const Int<isSigned, width, isSecretOther, schedulerId, usingBatch>& other)
+      const Int<isSigned,
+                width,
+                isSecretOther,
+                schedulerId,
+                usingBatch,
+                AdderType>& other)
       const;
 
   template <bool isSecretOther>
   Bit<isSecret || isSecretOther, schedulerId, usingBatch> operator==(
-      const Int<isSigned, width, isSecretOther, schedulerId, usingBatch>& other)
+      const Int<isSigned,
+                width,
+                isSecretOther,
+                schedulerId,
+                usingBatch,
+                AdderType>& other)
       const;
 
   /**
@@ -166,9 +242,15 @@ class Int {
       width,
       isSecret || isSecretChoice || isSecretOther,
       schedulerId,
-      usingBatch>
+      usingBatch,
+      AdderType>
   mux(const Bit<isSecretChoice, schedulerId, usingBatch>& choice,
-      const Int<isSigned, width, isSecretOther, schedulerId, usingBatch>& other)
+      const Int<isSigned,
+                width,
+                isSecretOther,
+                schedulerId,
+                usingBatch,
+                AdderType>& other)
       const;
 
   const Bit<isSecret, schedulerId, usingBatch>& operator[](size_t index) const {
@@ -190,7 +272,7 @@ class Int {
    * However only party with partyId will receive the actual value, other
    * parties will receive a dummy value.
    */
-  Int<isSigned, width, false, schedulerId, usingBatch> openToParty(
+  Int<isSigned, width, false, schedulerId, usingBatch, AdderType> openToParty(
       int partyId) const;
 
   /**
@@ -201,9 +283,23 @@ class Int {
   /**
    * extract this party's share of this int
    */
-  typename Int<isSigned, width, true, schedulerId, usingBatch>::ExtractedInt
+  typename Int<isSigned,
+               width,
+               true,
+               schedulerId,
+               usingBatch,
+               AdderType>::ExtractedInt
   extractIntShare() const;
 
+  /**
+   * Convert this private int to a private integer wire storing its value mod
+   * 2^64, where signed ints are sign extended. All the bits are converted in
+   * one round. The scheduler needs to be an arithmetic scheduler. The caller
+   * owns the returned wire.
+   */
+  scheduler::IScheduler::WireId<scheduler::IScheduler::Arithmetic>
+  toIntegerWire() const;
+
  private:
   template <typename T>
   std::vector<UnitIntType> convertTo64BitIntVector(
@@ -230,6 +326,16 @@ class Int {
       std::vector<uint64_t>& data,
       const std::vector<bool>& bits);
 
+  // add the copies of operand shifted by the set bits of publicOperand to
+  // columns, where columns[k] collects the bits of weight 2^k.
+  template <bool isSecretOperand, typename OutputBitType>
+  static void addShiftedCopies(
+      std::vector<std::vector<OutputBitType>>& columns,
+      const std::array<Bit<isSecretOperand, schedulerId, usingBatch>, width>&
+          operand,
+      const std::array<Bit<false, schedulerId, usingBatch>, width>&
+          publicOperand);
+
   // extract the t-th lsb(s) of v (either return a bool or a std::vector<bool>)
   static BoolType extractLsb(const IntType& v, size_t t);
 
@@ -239,37 +345,52 @@ class Int {
   // format to prevent overflow when width = 64
   static const uint64_t kMask = ((((uint64_t)1 << (width - 1)) - 1) << 1) + 1;
 
-  friend class Int<isSigned, width, !isSecret, schedulerId, usingBatch>;
+  friend class Int<isSigned,
+                   width,
+                   !isSecret,
+                   schedulerId,
+                   usingBatch,
+                   AdderType>;
 };
 
 // this struct works as a helper to build a more readable frontend
-template <typename T, bool isSecret, int schedulerId>
+template <typename T, bool isSecret, int schedulerId, typename AdderType>
 struct IntTypeHelper;
 
-template <int8_t width, bool isSecret, int schedulerId>
-struct IntTypeHelper<Signed<width>, isSecret, schedulerId> {
-  using type = Int<true, width, isSecret, schedulerId, false>;
+template <int8_t width, bool isSecret, int schedulerId, typename AdderType>
+struct IntTypeHelper<Signed<width>, isSecret, schedulerId, AdderType> {
+  using type = Int<true, width, isSecret, schedulerId, false, AdderType>;
 };
 
-template <int8_t width, bool isSecret, int schedulerId>
-struct IntTypeHelper<Unsigned<width>, isSecret, schedulerId> {
-  using type = Int<false, width, isSecret, schedulerId, false>;
+template <int8_t width, bool isSecret, int schedulerId, typename AdderType>
+struct IntTypeHelper<Unsigned<width>, isSecret, schedulerId, AdderType> {
+  using type = Int<false, width, isSecret, schedulerId, false, AdderType>;
 };
 
-template <int8_t width, bool isSecret, int schedulerId>
-struct IntTypeHelper<Batch<Signed<width>>, isSecret, schedulerId> {
-  using type = Int<true, width, isSecret, schedulerId, true>;
+template <int8_t width, bool isSecret, int schedulerId, typename AdderType>
+struct IntTypeHelper<Batch<Signed<width>>, isSecret, schedulerId, AdderType> {
+  using type = Int<true, width, isSecret, schedulerId, true, AdderType>;
 };
 
-template <int8_t width, bool isSecret, int schedulerId>
-struct IntTypeHelper<Batch<Unsigned<width>>, isSecret, schedulerId> {
-  using type = Int<false, width, isSecret, schedulerId, true>;
+template <int8_t width, bool isSecret, int schedulerId, typename AdderType>
+struct IntTypeHelper<
+    Batch<Unsigned<width>>,
+    isSecret,
+    schedulerId,
+    AdderType> {
+  using type = Int<false, width, isSecret, schedulerId, true, AdderType>;
 };
 
-template <typename T, int schedulerId>
-using Integer =
-    typename IntTypeHelper<typename T::type, IsSecret<T>::value, schedulerId>::
-        type;
+/**
+ * An optional AdderType (see Adder.h) selects the circuit used by + and -,
+ * e.g. Integer<Secret<Unsigned<64>>, 0, SklanskyAdder>.
+ */
+template <typename T, int schedulerId, typename AdderType = RippleCarryAdder>
+using Integer = typename IntTypeHelper<
+    typename T::type,
+    IsSecret<T>::value,
+    schedulerId,
+    AdderType>::type;
 
 } // namespace fbpcf::frontend
 
@@ -18,9 +18,11 @@ template <
     int8_t width,
     bool isSecret,
     int schedulerId,
-    bool usingBatch>
+    bool usingBatch,
+    typename AdderType>
 template <typename T>
-Int<isSigned, width, isSecret, schedulerId, usingBatch>::Int(const T& v) {
+Int<isSigned, width, isSecret, schedulerId, usingBatch, AdderType>::Int(
+    const T& v) {
   static_assert(
       InputTypeChecker<T>::value,
       "Need to use proper signed/unsigned integer (vector).");
@@ -36,9 +38,10 @@ template <
     int8_t width,
     bool isSecret,
     int schedulerId,
-    bool usingBatch>
+    bool usingBatch,
+    typename AdderType>
 template <typename T>
-Int<isSigned, width, isSecret, schedulerId, usingBatch>::Int(
+Int<isSigned, width, isSecret, schedulerId, usingBatch, AdderType>::Int(
     const T& v,
     int partyId) {
   static_assert(
@@ -56,8 +59,9 @@ template <
     int8_t width,
     bool isSecret,
     int schedulerId,
-    bool usingBatch>
-Int<isSigned, width, isSecret, schedulerId, usingBatch>::Int(
+    bool usingBatch,
+    typename AdderType>
+Int<isSigned, width, isSecret, schedulerId, usingBatch, AdderType>::Int(
     ExtractedInt&& extractedInt) {
   for (int8_t i = 0; i < width; i++) {
     data_[i] =
@@ -70,8 +74,36 @@ template <
     int8_t width,
     bool isSecret,
     int schedulerId,
-    bool usingBatch>
-void Int<isSigned, width, isSecret, schedulerId, usingBatch>::publicInput(
+    bool usingBatch,
+    typename AdderType>
+Int<isSigned, width, isSecret, schedulerId, usingBatch, AdderType>::Int(
+    scheduler::IScheduler::WireId<scheduler::IScheduler::Arithmetic> src) {
+  static_assert(isSecret, "Only private integer wires need conversion.");
+  auto summands =
+      Bit<true, schedulerId, usingBatch>::integerWireToSummands(src, width);
+  std::array<Bit<true, schedulerId, usingBatch>, width> left;
+  std::array<Bit<true, schedulerId, usingBatch>, width> right;
+  for (int8_t i = 0; i < width; i++) {
+    left[i] = std::move(summands.at(0).at(i));
+    right[i] = std::move(summands.at(1).at(i));
+  }
+  data_ = AdderType::template add<Bit<true, schedulerId, usingBatch>>(
+      left, right);
+}
+
+template <
+    bool isSigned,
+    int8_t width,
+    bool isSecret,
+    int schedulerId,
+    bool usingBatch,
+    typename AdderType>
+void Int<isSigned,
+         width,
+         isSecret,
+         schedulerId,
+         usingBatch,
+         AdderType>::publicInput(
     const IntType& v) {
   IntType buf = v;
   processInput(buf);
@@ -83,8 +115,14 @@ template <
     int8_t width,
     bool isSecret,
     int schedulerId,
-    bool usingBatch>
-void Int<isSigned, width, isSecret, schedulerId, usingBatch>::privateInput(
+    bool usingBatch,
+    typename AdderType>
+void Int<isSigned,
+         width,
+         isSecret,
+         schedulerId,
+         usingBatch,
+         AdderType>::privateInput(
     const IntType& v,
     int partyId) {
   IntType buf = v;
@@ -97,26 +135,35 @@ template <
     int8_t width,
     bool isSecret,
     int schedulerId,
-    bool usingBatch>
+    bool usingBatch,
+    typename AdderType>
 template <bool isSecretOther>
-Int<isSigned, width, isSecret || isSecretOther, schedulerId, usingBatch>
-Int<isSigned, width, isSecret, schedulerId, usingBatch>::operator+(
-    const Int<isSigned, width, isSecretOther, schedulerId, usingBatch>& other)
+Int<isSigned,
+    width,
+    isSecret || isSecretOther,
+    schedulerId,
+    usingBatch,
+    AdderType>
+Int<isSigned, width, isSecret, schedulerId, usingBatch, AdderType>::operator+(
+    const Int<isSigned,
+              width,
+              isSecretOther,
+              schedulerId,
+              usingBatch,
+              AdderType>& other)
     const {
   // signed int add and unsigned int add are the same
-  Int<isSigned, width, isSecret || isSecretOther, schedulerId, usingBatch> rst;
-
-  rst.data_[0] = data_.at(0) ^ other.data_.at(0);
-  auto carry = data_.at(0) & other.data_.at(0);
+  Int<isSigned,
+      width,
+      isSecret || isSecretOther,
+      schedulerId,
+      usingBatch,
+      AdderType>
+      rst;
 
-  for (int8_t i = 1; i < width - 1; i++) {
-    auto left = carry ^ data_.at(i);
-    auto right = carry ^ other.data_.at(i);
-    rst.data_[i] = left ^ other.data_.at(i);
-    carry = (left & right) ^ carry;
-  }
-  auto left = carry ^ data_[width - 1];
-  rst.data_[width - 1] = left ^ other.data_[width - 1];
+  rst.data_ = AdderType::template add<
+      Bit<isSecret || isSecretOther, schedulerId, usingBatch>>(
+      data_, other.data_);
   return rst;
 }
 
@@ -125,81 +172,90 @@ template <
     int8_t width,
     bool isSecret,
     int schedulerId,
-    bool usingBatch>
+    bool usingBatch,
+    typename AdderType>
 template <bool isSecretOther>
-Int<isSigned, width, isSecret || isSecretOther, schedulerId, usingBatch>
-Int<isSigned, width, isSecret, schedulerId, usingBatch>::operator-(
-    const Int<isSigned, width, isSecretOther, schedulerId, usingBatch>& other)
+Int<isSigned,
+    width,
+    isSecret || isSecretOther,
+    schedulerId,
+    usingBatch,
+    AdderType>
+Int<isSigned, width, isSecret, schedulerId, usingBatch, AdderType>::operator-(
+    const Int<isSigned,
+              width,
+              isSecretOther,
+              schedulerId,
+              usingBatch,
+              AdderType>& other)
     const {
   // signed int add and unsigned int subtract are the same
-  Int<isSigned, width, isSecret || isSecretOther, schedulerId, usingBatch> rst;
-
-  rst.data_[0] = data_.at(0) ^ other.data_.at(0);
-  auto carry = !data_.at(0) & other.data_.at(0);
-
-  for (int8_t i = 1; i < width - 1; i++) {
-    // the logic here is:
-    // 1. rst.data_[i] is the xor of minuend, subtrahend, and carry over;
-    // 2. the new carry over is the old carry over if minuend = subtrahend;
-    // 3. otherwise, the new carry over is the subtrahend, no matter what's the
-    // carry over: if subtrahend is 0, then minuend is 1, thus carry over must
-    // be 0; similarly, if subtrahend is 1, then minuend is 0, thus carry over
-    // must be 1;
-    auto tmp = carry ^ other.data_.at(i);
-    rst.data_[i] = data_.at(i) ^ tmp;
-    carry = carry ^ ((data_.at(i) ^ other.data_.at(i)) & tmp);
-  }
-  rst.data_[width - 1] =
-      carry ^ data_.at(width - 1) ^ other.data_.at(width - 1);
+  Int<isSigned,
+      width,
+      isSecret || isSecretOther,
+      schedulerId,
+      usingBatch,
+      AdderType>
+      rst;
+
+  rst.data_ = AdderType::template subtract<
+      Bit<isSecret || isSecretOther, schedulerId, usingBatch>>(
+      data_, other.data_);
   return rst;
 }
 
-/**
- * The algorithm of comparising two unsigned integers comes as follows:
- * 1. compare the msb: equal, or one is larger than the other.
- * 2. if the msbs are equal, recursively compare the remaining bits.
- * Since we are running an oblivious computation, the comparison result is
- * unknown. Therefore we have to compare all the bits no matter the results.
- * That results in our comparison results starts from the lsbs. In the i-th
- * iteration, we get the comparison results of the least i significant bits in
- * the two integers, stored in carry variable. Then we use that result to
- * compute the comparison result of the i+1-th iteration: if the two (i+1)-th
- * least significant bits are same,then the comparison result in the (i+1)-th
- * iteration is still carry, otherwise it would be the comparison result of the
- * two (i+1)-th lsbs. In summary we have: carry_{i+1} = left[i] == right[i] ?
- * carry_{i} : right[i].
- * The actual formula we use: carry = (carry ^ left[i]) & (carry ^ right[i]) ^
- * right[i] realize the desired behavior: if left[i] and right[i] are the same,
- * then the result would be the same as (carry ^ right[i]) & (carry ^ right[i])
- * ^ right[i] = carry; otherwise carry ^ left[i] and carry ^ right[i] will be
- * opposite (thus their product will always be 0), and the whole formula can be
- * simplified to right[i]
- */
 template <
     bool isSigned,
     int8_t width,
     bool isSecret,
     int schedulerId,
-    bool usingBatch>
+    bool usingBatch,
+    typename AdderType>
 template <bool isSecretOther>
-Bit<isSecret || isSecretOther, schedulerId, usingBatch>
-Int<isSigned, width, isSecret, schedulerId, usingBatch>::operator<(
-    const Int<isSigned, width, isSecretOther, schedulerId, usingBatch>& other)
+Int<isSigned,
+    width,
+    isSecret || isSecretOther,
+    schedulerId,
+    usingBatch,
+    AdderType>
+Int<isSigned, width, isSecret, schedulerId, usingBatch, AdderType>::operator*(
+    const Int<isSigned,
+              width,
+              isSecretOther,
+              schedulerId,
+              usingBatch,
+              AdderType>& other)
     const {
-  auto carry = (!data_[0]) & other.data_[0];
-  for (int8_t i = 1; i < width - 1; i++) {
-    carry = ((carry ^ data_.at(i)) & (carry ^ other.data_.at(i))) ^
-        other.data_.at(i);
-  }
-  // the msb's meaning is different in signed and unsigend int
-  if constexpr (isSigned) {
-    carry = ((carry ^ data_[width - 1]) & (carry ^ other.data_[width - 1])) ^
-        data_[width - 1];
+  // signed int multiply and unsigned int multiply are the same after
+  // truncation
+  using OutputBitType = Bit<isSecret || isSecretOther, schedulerId, usingBatch>;
+  Int<isSigned,
+      width,
+      isSecret || isSecretOther,
+      schedulerId,
+      usingBatch,
+      AdderType>
+      rst;
+
+  if constexpr (isSecret && isSecretOther) {
+    rst.data_ = WallaceTreeMultiplier::multiply<AdderType, OutputBitType>(
+        data_, other.data_);
   } else {
-    carry = ((carry ^ data_[width - 1]) & (carry ^ other.data_[width - 1])) ^
-        other.data_[width - 1];
+    std::vector<std::vector<OutputBitType>> columns(width);
+    if constexpr (isSecretOther) {
+      addShiftedCopies<isSecretOther, OutputBitType>(
+          columns, other.data_, data_);
+    } else {
+      addShiftedCopies<isSecret, OutputBitType>(columns, data_, other.data_);
+    }
+    // a ^ a is a zero of the right type, and XOR gates are free.
+    OutputBitType zero = data_.at(0) ^ other.data_.at(0);
+    zero = zero ^ zero;
+    rst.data_ =
+        WallaceTreeMultiplier::sumColumns<AdderType, OutputBitType, width>(
+            std::move(columns), zero);
   }
-  return carry;
+  return rst;
 }
 
 template <
@@ -207,11 +263,82 @@ template <
     int8_t width,
     bool isSecret,
     int schedulerId,
-    bool usingBatch>
+    bool usingBatch,
+    typename AdderType>
+template <bool isSecretOperand, typename OutputBitType>
+void Int<isSigned, width, isSecret, schedulerId, usingBatch, AdderType>::
+    addShiftedCopies(
+        std::vector<std::vector<OutputBitType>>& columns,
+        const std::array<Bit<isSecretOperand, schedulerId, usingBatch>, width>&
+            operand,
+        const std::array<Bit<false, schedulerId, usingBatch>, width>&
+            publicOperand) {
+  for (int8_t i = 0; i < width; i++) {
+    auto shift = publicOperand.at(i).getValue();
+    bool isAllZero;
+    bool isAllOne;
+    if constexpr (usingBatch) {
+      isAllZero = std::none_of(shift.begin(), shift.end(), [](bool v) {
+        return v;
+      });
+      isAllOne = std::all_of(shift.begin(), shift.end(), [](bool v) {
+        return v;
+      });
+    } else {
+      isAllZero = !shift;
+      isAllOne = shift;
+    }
+    if (isAllZero) {
+      continue;
+    }
+    for (int8_t j = 0; i + j < width; j++) {
+      // ANDs with a public bit are free anyway, but a copy is even cheaper.
+      columns[i + j].push_back(
+          isAllOne ? OutputBitType(operand.at(j))
+                   : OutputBitType(operand.at(j) & publicOperand.at(i)));
+    }
+  }
+}
+
+template <
+    bool isSigned,
+    int8_t width,
+    bool isSecret,
+    int schedulerId,
+    bool usingBatch,
+    typename AdderType>
+template <bool isSecretOther>
+Bit<isSecret || isSecretOther, schedulerId, usingBatch>
+Int<isSigned, width, isSecret, schedulerId, usingBatch, AdderType>::operator<(
+    const Int<isSigned,
+              width,
+              isSecretOther,
+              schedulerId,
+              usingBatch,
+              AdderType>& other)
+    const {
+  return AdderType::template lessThan<
+      isSigned,
+      Bit<isSecret || isSecretOther, schedulerId, usingBatch>>(
+      data_, other.data_);
+}
+
+template <
+    bool isSigned,
+    int8_t width,
+    bool isSecret,
+    int schedulerId,
+    bool usingBatch,
+    typename AdderType>
 template <bool isSecretOther>
 Bit<isSecret || isSecretOther, schedulerId, usingBatch>
-Int<isSigned, width, isSecret, schedulerId, usingBatch>::operator<=(
-    const Int<isSigned, width, isSecretOther, schedulerId, usingBatch>& other)
+Int<isSigned, width, isSecret, schedulerId, usingBatch, AdderType>::operator<=(
+    const Int<isSigned,
+              width,
+              isSecretOther,
+              schedulerId,
+              usingBatch,
+              AdderType>& other)
     const {
   return !(other < *this);
 }
@@ -221,11 +348,17 @@ template <
     int8_t width,
     bool isSecret,
     int schedulerId,
-    bool usingBatch>
+    bool usingBatch,
+    typename AdderType>
 template <bool isSecretOther>
 Bit<isSecret || isSecretOther, schedulerId, usingBatch>
-Int<isSigned, width, isSecret, schedulerId, usingBatch>::operator>(
-    const Int<isSigned, width, isSecretOther, schedulerId, usingBatch>& other)
+Int<isSigned, width, isSecret, schedulerId, usingBatch, AdderType>::operator>(
+    const Int<isSigned,
+              width,
+              isSecretOther,
+              schedulerId,
+              usingBatch,
+              AdderType>& other)
     const {
   return (other < *this);
 }
@@ -235,11 +368,17 @@ template <
     int8_t width,
     bool isSecret,
     int schedulerId,
-    bool usingBatch>
+    bool usingBatch,
+    typename AdderType>
 template <bool isSecretOther>
 Bit<isSecret || isSecretOther, schedulerId, usingBatch>
-Int<isSigned, width, isSecret, schedulerId, usingBatch>::operator>=(
-    const Int<isSigned, width, isSecretOther, schedulerId, usingBatch>& other)
+Int<isSigned, width, isSecret, schedulerId, usingBatch, AdderType>::operator>=(
+    const Int<isSigned,
+              width,
+              isSecretOther,
+              schedulerId,
+              usingBatch,
+              AdderType>& other)
     const {
   return !(*this < other);
 }
@@ -249,11 +388,17 @@ template <
     int8_t width,
     bool isSecret,
     int schedulerId,
-    bool usingBatch>
+    bool usingBatch,
+    typename AdderType>
 template <bool isSecretOther>
 Bit<isSecret || isSecretOther, schedulerId, usingBatch>
-Int<isSigned, width, isSecret, schedulerId, usingBatch>::operator==(
-    const Int<isSigned, width, isSecretOther, schedulerId, usingBatch>& other)
+Int<isSigned, width, isSecret, schedulerId, usingBatch, AdderType>::operator==(
+    const Int<isSigned,
+              width,
+              isSecretOther,
+              schedulerId,
+              usingBatch,
+              AdderType>& other)
     const {
   std::array<Bit<isSecret || isSecretOther, schedulerId, usingBatch>, width>
       rst;
@@ -271,26 +416,41 @@ template <
     int8_t width,
     bool isSecret,
     int schedulerId,
-    bool usingBatch>
+    bool usingBatch,
+    typename AdderType>
 template <bool isSecretChoice, bool isSecretOther>
 Int<isSigned,
     width,
     isSecret || isSecretChoice || isSecretOther,
     schedulerId,
-    usingBatch>
-Int<isSigned, width, isSecret, schedulerId, usingBatch>::mux(
+    usingBatch,
+    AdderType>
+Int<isSigned, width, isSecret, schedulerId, usingBatch, AdderType>::mux(
     const Bit<isSecretChoice, schedulerId, usingBatch>& choice,
-    const Int<isSigned, width, isSecretOther, schedulerId, usingBatch>& other)
+    const Int<isSigned,
+              width,
+              isSecretOther,
+              schedulerId,
+              usingBatch,
+              AdderType>& other)
     const {
   Int<isSigned,
       width,
       isSecret || isSecretChoice || isSecretOther,
       schedulerId,
-      usingBatch>
+      usingBatch,
+      AdderType>
       rst;
 
+  // all the bits share the same choice, so one composite AND suffices.
+  std::vector<Bit<isSecret || isSecretOther, schedulerId, usingBatch>>
+      differences(width);
+  for (int8_t i = 0; i < width; i++) {
+    differences[i] = other.data_.at(i) ^ data_.at(i);
+  }
+  auto selected = choice.compositeAND(differences);
   for (int8_t i = 0; i < width; i++) {
-    rst.data_[i] = data_.at(i) ^ (choice & (other.data_.at(i) ^ data_.at(i)));
+    rst.data_[i] = data_.at(i) ^ selected.at(i);
   }
   return rst;
 }
@@ -300,9 +460,20 @@ template <
     int8_t width,
     bool isSecret,
     int schedulerId,
-    bool usingBatch>
-typename Int<isSigned, width, isSecret, schedulerId, usingBatch>::IntType
-Int<isSigned, width, isSecret, schedulerId, usingBatch>::getValue() const {
+    bool usingBatch,
+    typename AdderType>
+typename Int<isSigned,
+             width,
+             isSecret,
+             schedulerId,
+             usingBatch,
+             AdderType>::IntType
+Int<isSigned,
+    width,
+    isSecret,
+    schedulerId,
+    usingBatch,
+    AdderType>::getValue() const {
   static_assert(!isSecret, "Shouldn't try to get a secret value!");
   return convertBitsToInt<Bit<isSecret, schedulerId, usingBatch>>(data_);
 }
@@ -312,12 +483,13 @@ template <
     int8_t width,
     bool isSecret,
     int schedulerId,
-    bool usingBatch>
-Int<isSigned, width, false, schedulerId, usingBatch>
-Int<isSigned, width, isSecret, schedulerId, usingBatch>::openToParty(
+    bool usingBatch,
+    typename AdderType>
+Int<isSigned, width, false, schedulerId, usingBatch, AdderType>
+Int<isSigned, width, isSecret, schedulerId, usingBatch, AdderType>::openToParty(
     int partyId) const {
   static_assert(isSecret, "No need to open a public value.");
-  Int<isSigned, width, false, schedulerId, usingBatch> rst;
+  Int<isSigned, width, false, schedulerId, usingBatch, AdderType> rst;
 
   for (int8_t i = 0; i < width; i++) {
     rst.data_[i] = data_.at(i).openToParty(partyId);
@@ -330,9 +502,20 @@ template <
     int8_t width,
     bool isSecret,
     int schedulerId,
-    bool usingBatch>
-typename Int<isSigned, width, true, schedulerId, usingBatch>::ExtractedInt
-Int<isSigned, width, isSecret, schedulerId, usingBatch>::extractIntShare()
+    bool usingBatch,
+    typename AdderType>
+typename Int<isSigned,
+             width,
+             true,
+             schedulerId,
+             usingBatch,
+             AdderType>::ExtractedInt
+Int<isSigned,
+    width,
+    isSecret,
+    schedulerId,
+    usingBatch,
+    AdderType>::extractIntShare()
     const {
   static_assert(isSecret, "No need to extract a public value.");
   ExtractedInt rst;
@@ -347,9 +530,15 @@ template <
     int8_t width,
     bool isSecret,
     int schedulerId,
-    bool usingBatch>
-typename Int<isSigned, width, isSecret, schedulerId, usingBatch>::BoolType
-Int<isSigned, width, isSecret, schedulerId, usingBatch>::extractLsb(
+    bool usingBatch,
+    typename AdderType>
+typename Int<isSigned,
+             width,
+             isSecret,
+             schedulerId,
+             usingBatch,
+             AdderType>::BoolType
+Int<isSigned, width, isSecret, schedulerId, usingBatch, AdderType>::extractLsb(
     const IntType& v,
     size_t t) {
   if constexpr (usingBatch) {
@@ -372,8 +561,14 @@ template <
     int8_t width,
     bool isSecret,
     int schedulerId,
-    bool usingBatch>
-void Int<isSigned, width, isSecret, schedulerId, usingBatch>::shiftLeft(
+    bool usingBatch,
+    typename AdderType>
+void Int<isSigned,
+         width,
+         isSecret,
+         schedulerId,
+         usingBatch,
+         AdderType>::shiftLeft(
     std::vector<uint64_t>& data) {
   for (auto& item : data) {
     item = item << 1;
@@ -385,8 +580,9 @@ template <
     int8_t width,
     bool isSecret,
     int schedulerId,
-    bool usingBatch>
-void Int<isSigned, width, isSecret, schedulerId, usingBatch>::addLsb(
+    bool usingBatch,
+    typename AdderType>
+void Int<isSigned, width, isSecret, schedulerId, usingBatch, AdderType>::addLsb(
     std::vector<uint64_t>& data,
     const std::vector<bool>& bits) {
   if (data.size() != bits.size()) {
@@ -405,8 +601,14 @@ template <
     int8_t width,
     bool isSecret,
     int schedulerId,
-    bool usingBatch>
-void Int<isSigned, width, isSecret, schedulerId, usingBatch>::processInput(
+    bool usingBatch,
+    typename AdderType>
+void Int<isSigned,
+         width,
+         isSecret,
+         schedulerId,
+         usingBatch,
+         AdderType>::processInput(
     IntType& v) const {
   if constexpr (usingBatch) {
     for (auto& item : v) {
@@ -422,8 +624,9 @@ template <
     int8_t width,
     bool isSecret,
     int schedulerId,
-    bool usingBatch>
-void Int<isSigned, width, isSecret, schedulerId, usingBatch>::
+    bool usingBatch,
+    typename AdderType>
+void Int<isSigned, width, isSecret, schedulerId, usingBatch, AdderType>::
     processSingleInput(UnitIntType& v) const {
   if constexpr (isSigned) {
     if (v >= 0) {
@@ -469,8 +672,9 @@ template <
     int8_t width,
     bool isSecret,
     int schedulerId,
-    bool usingBatch>
-void Int<isSigned, width, isSecret, schedulerId, usingBatch>::
+    bool usingBatch,
+    typename AdderType>
+void Int<isSigned, width, isSecret, schedulerId, usingBatch, AdderType>::
     convertPublicIntToBits(const IntType& v) {
   for (int8_t i = 0; i < width; i++) {
     data_[i] = Bit<false, schedulerId, usingBatch>(extractLsb(v, i));
@@ -482,8 +686,9 @@ template <
     int8_t width,
     bool isSecret,
     int schedulerId,
-    bool usingBatch>
-void Int<isSigned, width, isSecret, schedulerId, usingBatch>::
+    bool usingBatch,
+    typename AdderType>
+void Int<isSigned, width, isSecret, schedulerId, usingBatch, AdderType>::
     convertPrivateIntToBits(const IntType& v, int partyId) {
   for (int8_t i = 0; i < width; i++) {
     data_[i] = Bit<true, schedulerId, usingBatch>(extractLsb(v, i), partyId);
@@ -495,11 +700,17 @@ template <
     int8_t width,
     bool isSecret,
     int schedulerId,
-    bool usingBatch>
+    bool usingBatch,
+    typename AdderType>
 template <typename T>
-std::vector<typename Int<isSigned, width, isSecret, schedulerId, usingBatch>::
+std::vector<typename Int<isSigned,
+                         width,
+                         isSecret,
+                         schedulerId,
+                         usingBatch,
+                         AdderType>::
                 UnitIntType>
-Int<isSigned, width, isSecret, schedulerId, usingBatch>::
+Int<isSigned, width, isSecret, schedulerId, usingBatch, AdderType>::
     convertTo64BitIntVector(const std::vector<T>& src) const {
   static_assert(sizeof(T) * 8 >= width);
   std::vector<UnitIntType> rst(src.size());
@@ -512,10 +723,21 @@ template <
     int8_t width,
     bool isSecret,
     int schedulerId,
-    bool usingBatch>
+    bool usingBatch,
+    typename AdderType>
 template <typename T>
-typename Int<isSigned, width, isSecret, schedulerId, usingBatch>::IntType
-Int<isSigned, width, isSecret, schedulerId, usingBatch>::convertBitsToInt(
+typename Int<isSigned,
+             width,
+             isSecret,
+             schedulerId,
+             usingBatch,
+             AdderType>::IntType
+Int<isSigned,
+    width,
+    isSecret,
+    schedulerId,
+    usingBatch,
+    AdderType>::convertBitsToInt(
     const std::array<T, width>& data) {
   if constexpr (usingBatch) {
     // processing the msb(s) and use the result as the starting point
@@ -560,4 +782,25 @@ Int<isSigned, width, isSecret, schedulerId, usingBatch>::convertBitsToInt(
   }
 }
 
+template <
+    bool isSigned,
+    int8_t width,
+    bool isSecret,
+    int schedulerId,
+    bool usingBatch,
+    typename AdderType>
+scheduler::IScheduler::WireId<scheduler::IScheduler::Arithmetic>
+Int<isSigned, width, isSecret, schedulerId, usingBatch, AdderType>::
+    toIntegerWire() const {
+  static_assert(isSecret, "Only private ints need conversion.");
+  std::vector<Bit<true, schedulerId, usingBatch>> bits(
+      data_.begin(), data_.end());
+  if constexpr (isSigned) {
+    // the sign bit weighs -2^(width - 1), i.e. 2^(width - 1) + ... + 2^63
+    // mod 2^64
+    bits.resize(64, data_[width - 1]);
+  }
+  return Bit<true, schedulerId, usingBatch>::toIntegerWire(bits);
+}
+
 } // namespace fbpcf::frontend
@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+namespace fbpcf::frontend {
+
+/**
+ * A truncated (mod 2^width) multiplier. The partial products are reduced by a
+ * Wallace tree (with Dadda's schedule) of full and half adders, each of which
+ * takes a single AND gate, until every column has at most two bits left. The
+ * two remaining rows are then added up with AdderType, thus a parallel-prefix
+ * AdderType keeps the overall depth logarithmic. Like the adder policies, it
+ * works on arrays of bits (lsb first) that support the ^, &, ! operators and
+ * compositeAND.
+ */
+struct WallaceTreeMultiplier {
+  /**
+   * Multiply two secret operands. Row i of the partial products is right[i]
+   * AND-ed with the lowest width - i bits of left, which makes one composite
+   * AND gate.
+   */
+  template <
+      typename AdderType,
+      typename OutputBitType,
+      typename LeftBitType,
+      typename RightBitType,
+      size_t width>
+  static std::array<OutputBitType, width> multiply(
+      const std::array<LeftBitType, width>& left,
+      const std::array<RightBitType, width>& right);
+
+  /**
+   * Sum up all the bits in columns mod 2^width, where columns[k] holds bits
+   * of weight 2^k.
+   * @param zero a bit of value 0, used to fill in the empty positions.
+   */
+  template <typename AdderType, typename BitType, size_t width>
+  static std::array<BitType, width> sumColumns(
+      std::vector<std::vector<BitType>> columns,
+      const BitType& zero);
+};
+
+} // namespace fbpcf::frontend
+
+#include "fbpcf/frontend/Multiplier_impl.h"
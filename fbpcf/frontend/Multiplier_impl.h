@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <algorithm>
+
+namespace fbpcf::frontend {
+
+template <
+    typename AdderType,
+    typename OutputBitType,
+    typename LeftBitType,
+    typename RightBitType,
+    size_t width>
+std::array<OutputBitType, width> WallaceTreeMultiplier::multiply(
+    const std::array<LeftBitType, width>& left,
+    const std::array<RightBitType, width>& right) {
+  std::vector<std::vector<OutputBitType>> columns(width);
+  for (size_t i = 0; i < width; i++) {
+    auto row = right.at(i).compositeAND(
+        std::vector<LeftBitType>(left.begin(), left.end() - i));
+    for (size_t j = 0; j < row.size(); j++) {
+      columns[i + j].push_back(row.at(j));
+    }
+  }
+  // a ^ a is a zero of the right type, and XOR gates are free.
+  auto zero = columns.at(0).at(0) ^ columns.at(0).at(0);
+  return sumColumns<AdderType, OutputBitType, width>(std::move(columns), zero);
+}
+
+/**
+ * The columns are reduced in stages following Dadda's schedule: the stage
+ * targets are the sequence 2, 3, 4, 6, 9, 13, ... (d_{j+1} = 1.5 * d_j) in
+ * reverse, and every stage only uses as many adders as needed to bring each
+ * column down to the target, counting the carries coming from the column
+ * below. All the adders in a stage only depend on the previous stage, so each
+ * stage takes one layer of AND gates:
+ * full adder: sum = a ^ b ^ c, carry = ((a ^ c) & (b ^ c)) ^ c;
+ * half adder: sum = a ^ b, carry = a & b.
+ * Carries out of the msb are dropped, which makes the adders of the last
+ * column free.
+ */
+template <typename AdderType, typename BitType, size_t width>
+std::array<BitType, width> WallaceTreeMultiplier::sumColumns(
+    std::vector<std::vector<BitType>> columns,
+    const BitType& zero) {
+  auto getMaxHeight = [&columns]() {
+    size_t rst = 0;
+    for (auto& column : columns) {
+      rst = std::max(rst, column.size());
+    }
+    return rst;
+  };
+
+  std::vector<size_t> targets = {2};
+  while (targets.back() < getMaxHeight()) {
+    targets.push_back(targets.back() * 3 / 2);
+  }
+  targets.pop_back();
+
+  for (auto target = targets.rbegin(); target != targets.rend(); target++) {
+    std::vector<std::vector<BitType>> reduced(width);
+    for (size_t k = 0; k < width; k++) {
+      auto& column = columns.at(k);
+      // the carries from column k - 1 are already in reduced[k]
+      auto height = column.size() + reduced.at(k).size();
+      size_t i = 0;
+      while (height > *target && i + 2 <= column.size()) {
+        if (height == *target + 1 || i + 3 > column.size()) {
+          reduced[k].push_back(column.at(i) ^ column.at(i + 1));
+          if (k + 1 < width) {
+            reduced[k + 1].push_back(column.at(i) & column.at(i + 1));
+          }
+          i += 2;
+          height -= 1;
+        } else {
+          auto leftSum = column.at(i) ^ column.at(i + 2);
+          auto rightSum = column.at(i + 1) ^ column.at(i + 2);
+          reduced[k].push_back(leftSum ^ column.at(i + 1));
+          if (k + 1 < width) {
+            reduced[k + 1].push_back((leftSum & rightSum) ^ column.at(i + 2));
+          }
+          i += 3;
+          height -= 2;
+        }
+      }
+      for (; i < column.size(); i++) {
+        reduced[k].push_back(column.at(i));
+      }
+    }
+    columns = std::move(reduced);
+  }
+
+  std::array<BitType, width> row0;
+  std::array<BitType, width> row1;
+  for (size_t k = 0; k < width; k++) {
+    row0[k] = columns.at(k).empty() ? zero : columns.at(k).at(0);
+    row1[k] = columns.at(k).size() < 2 ? zero : columns.at(k).at(1);
+  }
+  if (getMaxHeight() <= 1) {
+    // nothing to add up, e.g. when multiplied by a power of 2.
+    return row0;
+  }
+  return AdderType::template add<BitType>(row0, row1);
+}
+
+} // namespace fbpcf::frontend
@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "fbpcf/frontend/Bit.h"
+#include "fbpcf/scheduler/IScheduler.h"
+#include "fbpcf/scheduler/gate_keeper/Circuit.h"
+
+namespace fbpcf::frontend {
+
+/**
+ * A function of secret bits that is evaluated many times, e.g. once per
+ * shard. The first call records the gates the function adds (see
+ * IScheduler::startRecording()), the later calls replay the recorded circuit
+ * instead of running the function again, which skips building every gate
+ * from the frontend. The function needs to add the same gates whatever its
+ * inputs are, and only normal boolean gates: no composite AND, integer gate
+ * or opening. If the scheduler doesn't record circuits, the function is run
+ * on every call.
+ */
+template <int schedulerId, bool usingBatch = false>
+class ReplayableFunction : public scheduler::SchedulerKeeper<schedulerId> {
+ public:
+  using SecBit = Bit<true, schedulerId, usingBatch>;
+  using Function =
+      std::function<std::vector<SecBit>(const std::vector<SecBit>&)>;
+
+  explicit ReplayableFunction(Function function)
+      : function_{std::move(function)} {}
+
+  /**
+   * Evaluate the function on the given bits.
+   */
+  std::vector<SecBit> operator()(const std::vector<SecBit>& inputs);
+
+ private:
+  using WireType =
+      scheduler::IScheduler::WireId<scheduler::IScheduler::Boolean>;
+
+  Function function_;
+  // whether the first call recorded the function
+  bool isRecorded_ = false;
+  // null if the scheduler doesn't record circuits
+  std::shared_ptr<const scheduler::Circuit> circuit_;
+};
+
+} // namespace fbpcf::frontend
+
+#include "fbpcf/frontend/ReplayableFunction_impl.h"
@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+// included for clangd resolution. Should not execute during compilation
+#include "fbpcf/frontend/ReplayableFunction.h"
+
+namespace fbpcf::frontend {
+
+template <int schedulerId, bool usingBatch>
+std::vector<typename ReplayableFunction<schedulerId, usingBatch>::SecBit>
+ReplayableFunction<schedulerId, usingBatch>::operator()(
+    const std::vector<SecBit>& inputs) {
+  auto& scheduler = scheduler::SchedulerKeeper<schedulerId>::getScheduler();
+  std::vector<WireType> inputWires(inputs.size());
+  for (size_t i = 0; i < inputs.size(); i++) {
+    inputWires[i] = inputs.at(i).id_;
+  }
+
+  if (circuit_ != nullptr) {
+    auto outputWires = scheduler.replayCircuit(*circuit_, inputWires);
+    // the output wires are handed over with their reference
+    std::vector<SecBit> outputs(outputWires.size());
+    for (size_t i = 0; i < outputWires.size(); i++) {
+      outputs[i].id_ = outputWires.at(i);
+    }
+    return outputs;
+  }
+  if (isRecorded_) {
+    return function_(inputs);
+  }
+
+  if constexpr (usingBatch) {
+    scheduler.startRecordingBatch(inputWires);
+  } else {
+    scheduler.startRecording(inputWires);
+  }
+  auto outputs = function_(inputs);
+  std::vector<WireType> outputWires(outputs.size());
+  for (size_t i = 0; i < outputs.size(); i++) {
+    outputWires[i] = outputs.at(i).id_;
+  }
+  circuit_ = scheduler.stopRecording(outputWires);
+  isRecorded_ = true;
+  return outputs;
+}
+
+} // namespace fbpcf::frontend
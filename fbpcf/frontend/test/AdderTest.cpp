@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <random>
+
+#include "fbpcf/frontend/Adder.h"
+#include "fbpcf/frontend/test/DepthTrackingBit.h"
+
+namespace fbpcf::frontend {
+
+template <typename AdderType, size_t width>
+void testAdder(size_t maxDepth) {
+  std::random_device rd;
+  std::mt19937_64 e(rd());
+  std::uniform_int_distribution<uint64_t> dist(0, 0xFFFFFFFFFFFFFFFF);
+  uint64_t mask = width == 64 ? ~uint64_t(0) : (uint64_t(1) << width) - 1;
+
+  for (int i = 0; i < 1000; i++) {
+    uint64_t v1 = dist(e) & mask;
+    uint64_t v2 = dist(e) & mask;
+    // also cover the carry chain running through all the bits
+    if (i == 0) {
+      v1 = mask;
+      v2 = 1;
+    }
+    auto bits1 = toDepthTrackingBits<width>(v1);
+    auto bits2 = toDepthTrackingBits<width>(v2);
+
+    auto sum = AdderType::template add<DepthTrackingBit>(bits1, bits2);
+    EXPECT_EQ(fromDepthTrackingBits(sum), (v1 + v2) & mask);
+    EXPECT_LE(getDepth(sum), maxDepth);
+
+    auto difference =
+        AdderType::template subtract<DepthTrackingBit>(bits1, bits2);
+    EXPECT_EQ(fromDepthTrackingBits(difference), (v1 - v2) & mask);
+    EXPECT_LE(getDepth(difference), maxDepth);
+  }
+}
+
+template <typename AdderType, size_t width>
+void testComparator(size_t maxDepth) {
+  std::random_device rd;
+  std::mt19937_64 e(rd());
+  std::uniform_int_distribution<uint64_t> dist(0, 0xFFFFFFFFFFFFFFFF);
+  uint64_t mask = width == 64 ? ~uint64_t(0) : (uint64_t(1) << width) - 1;
+  auto toSigned = [](uint64_t v) {
+    // sign-extend the width-bit value
+    return static_cast<int64_t>(v << (64 - width)) >> (64 - width);
+  };
+
+  for (int i = 0; i < 1000; i++) {
+    uint64_t v1 = dist(e) & mask;
+    // also cover equal values and values that only differ in the lsb
+    uint64_t v2 = i % 3 == 0 ? v1 ^ (i % 2) : dist(e) & mask;
+    auto bits1 = toDepthTrackingBits<width>(v1);
+    auto bits2 = toDepthTrackingBits<width>(v2);
+
+    auto unsignedLess =
+        AdderType::template lessThan<false, DepthTrackingBit>(bits1, bits2);
+    EXPECT_EQ(unsignedLess.value, v1 < v2);
+    EXPECT_LE(unsignedLess.depth, maxDepth);
+
+    auto signedLess =
+        AdderType::template lessThan<true, DepthTrackingBit>(bits1, bits2);
+    EXPECT_EQ(signedLess.value, toSigned(v1) < toSigned(v2));
+    EXPECT_LE(signedLess.depth, maxDepth);
+  }
+}
+
+// an upper bound of the depth of a parallel-prefix adder: one layer for the
+// generate signals plus the layers of the prefix network over width - 1
+// signals.
+size_t getPrefixAdderDepth(size_t width, size_t layersPerLevel) {
+  auto levels = static_cast<size_t>(std::ceil(std::log2(width - 1)));
+  return 1 + layersPerLevel * levels;
+}
+
+// the comparisons of all the parallel-prefix adders use a balanced tree over
+// the signals of the width bits.
+size_t getTreeComparatorDepth(size_t width) {
+  return 1 + static_cast<size_t>(std::ceil(std::log2(width)));
+}
+
+TEST(AdderTest, testRippleCarryAdder) {
+  testAdder<RippleCarryAdder, 2>(1);
+  testAdder<RippleCarryAdder, 13>(12);
+  testAdder<RippleCarryAdder, 32>(31);
+  testAdder<RippleCarryAdder, 64>(63);
+
+  testComparator<RippleCarryAdder, 2>(2);
+  testComparator<RippleCarryAdder, 13>(13);
+  testComparator<RippleCarryAdder, 64>(64);
+}
+
+TEST(AdderTest, testSklanskyAdder) {
+  testAdder<SklanskyAdder, 2>(1);
+  testAdder<SklanskyAdder, 13>(getPrefixAdderDepth(13, 1));
+  testAdder<SklanskyAdder, 33>(getPrefixAdderDepth(33, 1));
+  testAdder<SklanskyAdder, 64>(getPrefixAdderDepth(64, 1));
+
+  testComparator<SklanskyAdder, 2>(getTreeComparatorDepth(2));
+  testComparator<SklanskyAdder, 13>(getTreeComparatorDepth(13));
+  testComparator<SklanskyAdder, 64>(getTreeComparatorDepth(64));
+}
+
+TEST(AdderTest, testKoggeStoneAdder) {
+  testAdder<KoggeStoneAdder, 2>(1);
+  testAdder<KoggeStoneAdder, 13>(getPrefixAdderDepth(13, 1));
+  testAdder<KoggeStoneAdder, 33>(getPrefixAdderDepth(33, 1));
+  testAdder<KoggeStoneAdder, 64>(getPrefixAdderDepth(64, 1));
+
+  testComparator<KoggeStoneAdder, 2>(getTreeComparatorDepth(2));
+  testComparator<KoggeStoneAdder, 13>(getTreeComparatorDepth(13));
+  testComparator<KoggeStoneAdder, 64>(getTreeComparatorDepth(64));
+}
+
+TEST(AdderTest, testBrentKungAdder) {
+  testAdder<BrentKungAdder, 2>(1);
+  testAdder<BrentKungAdder, 13>(getPrefixAdderDepth(13, 2));
+  testAdder<BrentKungAdder, 33>(getPrefixAdderDepth(33, 2));
+  testAdder<BrentKungAdder, 64>(getPrefixAdderDepth(64, 2));
+
+  testComparator<BrentKungAdder, 2>(getTreeComparatorDepth(2));
+  testComparator<BrentKungAdder, 13>(getTreeComparatorDepth(13));
+  testComparator<BrentKungAdder, 64>(getTreeComparatorDepth(64));
+}
+
+} // namespace fbpcf::frontend
@@ -171,6 +171,106 @@ TEST(BitTest, testAndBatch) {
   scheduler::SchedulerKeeper<0>::freeScheduler();
 }
 
+TEST(BitTest, testCompositeAnd) {
+  auto mock = std::make_unique<schedulerMock>();
+
+  bool v = true;
+  int partyId = 3;
+
+  EXPECT_CALL(*mock, privateAndPrivateComposite(_, SizeIs(3))).Times(1);
+  EXPECT_CALL(*mock, privateAndPublicComposite(_, SizeIs(3))).Times(2);
+  EXPECT_CALL(*mock, publicAndPublicComposite(_, SizeIs(3))).Times(1);
+  EXPECT_CALL(*mock, privateAndPrivate(_, _)).Times(0);
+  EXPECT_CALL(*mock, privateAndPublic(_, _)).Times(0);
+
+  scheduler::SchedulerKeeper<0>::setScheduler(std::move(mock));
+
+  using SecBit = Bit<true, 0>;
+  using PubBit = Bit<false, 0>;
+
+  {
+    SecBit b1(v, partyId);
+    PubBit b2(v);
+    std::vector<SecBit> secBits(3, SecBit(v, partyId));
+    std::vector<PubBit> pubBits(3, PubBit(v));
+
+    EXPECT_EQ(b1.compositeAND(secBits).size(), 3);
+    EXPECT_EQ(b1.compositeAND(pubBits).size(), 3);
+    EXPECT_EQ(b2.compositeAND(secBits).size(), 3);
+    EXPECT_EQ(b2.compositeAND(pubBits).size(), 3);
+  }
+  // everything must be out of scope before free the scheduler.
+  scheduler::SchedulerKeeper<0>::freeScheduler();
+}
+
+TEST(BitTest, testCompositeAndBatch) {
+  auto mock = std::make_unique<schedulerMock>();
+
+  std::vector<bool> v(5, true);
+  int partyId = 3;
+
+  EXPECT_CALL(*mock, privateAndPrivateCompositeBatch(_, SizeIs(3))).Times(1);
+  EXPECT_CALL(*mock, privateAndPublicCompositeBatch(_, SizeIs(3))).Times(2);
+  EXPECT_CALL(*mock, publicAndPublicCompositeBatch(_, SizeIs(3))).Times(1);
+  EXPECT_CALL(*mock, privateAndPrivateBatch(_, _)).Times(0);
+  EXPECT_CALL(*mock, privateAndPublicBatch(_, _)).Times(0);
+
+  scheduler::SchedulerKeeper<0>::setScheduler(std::move(mock));
+
+  using SecBitBatch = Bit<true, 0, true>;
+  using PubBitBatch = Bit<false, 0, true>;
+
+  {
+    SecBitBatch b1(v, partyId);
+    PubBitBatch b2(v);
+    std::vector<SecBitBatch> secBits(3, SecBitBatch(v, partyId));
+    std::vector<PubBitBatch> pubBits(3, PubBitBatch(v));
+
+    EXPECT_EQ(b1.compositeAND(secBits).size(), 3);
+    EXPECT_EQ(b1.compositeAND(pubBits).size(), 3);
+    EXPECT_EQ(b2.compositeAND(secBits).size(), 3);
+    EXPECT_EQ(b2.compositeAND(pubBits).size(), 3);
+  }
+  // everything must be out of scope before free the scheduler.
+  scheduler::SchedulerKeeper<0>::freeScheduler();
+}
+
+TEST(BitTest, testCompositeAndPlaintextScheduler) {
+  scheduler::SchedulerKeeper<0>::setScheduler(
+      std::make_unique<scheduler::PlaintextScheduler>(
+          scheduler::WireKeeper::createWithUnorderedMap()));
+
+  int partyId = 3;
+  std::vector<bool> rights = {true, false, true, true, false};
+
+  using SecBit = Bit<true, 0>;
+  using PubBit = Bit<false, 0>;
+  {
+    for (auto v : {true, false}) {
+      SecBit secLeft(v, partyId);
+      PubBit pubLeft(v);
+      std::vector<SecBit> secRights;
+      std::vector<PubBit> pubRights;
+      for (auto right : rights) {
+        secRights.push_back(SecBit(right, partyId));
+        pubRights.push_back(PubBit(right));
+      }
+
+      auto r1 = secLeft.compositeAND(secRights);
+      auto r2 = secLeft.compositeAND(pubRights);
+      auto r3 = pubLeft.compositeAND(secRights);
+      auto r4 = pubLeft.compositeAND(pubRights);
+      for (size_t i = 0; i < rights.size(); i++) {
+        EXPECT_EQ(r1.at(i).openToParty(partyId).getValue(), v & rights[i]);
+        EXPECT_EQ(r2.at(i).openToParty(partyId).getValue(), v & rights[i]);
+        EXPECT_EQ(r3.at(i).openToParty(partyId).getValue(), v & rights[i]);
+        EXPECT_EQ(r4.at(i).getValue(), v & rights[i]);
+      }
+    }
+  }
+  scheduler::SchedulerKeeper<0>::freeScheduler();
+}
+
 TEST(BitTest, testXor) {
   auto mock = std::make_unique<schedulerMock>();
 
@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace fbpcf::frontend {
+
+/**
+ * A plaintext bit that also tracks the AND depth of the circuit computing it,
+ * i.e. how many rounds of communication a secure evaluation of that circuit
+ * needs. It can be plugged into the adder policies directly.
+ */
+struct DepthTrackingBit {
+  bool value = false;
+  size_t depth = 0;
+
+  DepthTrackingBit operator!() const {
+    return {!value, depth};
+  }
+
+  DepthTrackingBit operator^(const DepthTrackingBit& other) const {
+    return {value != other.value, std::max(depth, other.depth)};
+  }
+
+  DepthTrackingBit operator&(const DepthTrackingBit& other) const {
+    return {value && other.value, std::max(depth, other.depth) + 1};
+  }
+
+  std::vector<DepthTrackingBit> compositeAND(
+      const std::vector<DepthTrackingBit>& others) const {
+    std::vector<DepthTrackingBit> rst;
+    for (auto& other : others) {
+      rst.push_back(*this & other);
+    }
+    return rst;
+  }
+};
+
+template <size_t width>
+std::array<DepthTrackingBit, width> toDepthTrackingBits(uint64_t v) {
+  std::array<DepthTrackingBit, width> rst;
+  for (size_t i = 0; i < width; i++) {
+    rst[i] = DepthTrackingBit{((v >> i) & 1) == 1, 0};
+  }
+  return rst;
+}
+
+template <size_t width>
+uint64_t fromDepthTrackingBits(const std::array<DepthTrackingBit, width>& v) {
+  uint64_t rst = 0;
+  for (size_t i = 0; i < width; i++) {
+    rst |= uint64_t(v.at(i).value) << i;
+  }
+  return rst;
+}
+
+template <size_t width>
+size_t getDepth(const std::array<DepthTrackingBit, width>& v) {
+  size_t rst = 0;
+  for (auto& bit : v) {
+    rst = std::max(rst, bit.depth);
+  }
+  return rst;
+}
+
+} // namespace fbpcf::frontend
@@ -7,11 +7,15 @@
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
+#include <future>
 #include <random>
 #include <stdexcept>
 
+#include "fbpcf/engine/communication/test/AgentFactoryCreationHelper.h"
 #include "fbpcf/frontend/Int.h"
+#include "fbpcf/frontend/test/schedulerMock.h"
 #include "fbpcf/scheduler/PlaintextScheduler.h"
+#include "fbpcf/scheduler/SchedulerHelper.h"
 #include "fbpcf/scheduler/WireKeeper.h"
 #include "fbpcf/test/TestHelper.h"
 
@@ -605,6 +609,130 @@ TEST(IntTest, testSubtractBatch) {
   }
 }
 
+template <typename AdderType>
+void testAddAndSubtractWithAdder() {
+  const int8_t width = 64;
+
+  scheduler::SchedulerKeeper<0>::setScheduler(
+      std::make_unique<scheduler::PlaintextScheduler>(
+          scheduler::WireKeeper::createWithUnorderedMap()));
+  using secSignedInt = Integer<Secret<Signed<width>>, 0, AdderType>;
+  using pubSignedInt = Integer<Public<Signed<width>>, 0, AdderType>;
+  using secUnsignedIntBatch =
+      Integer<Secret<Batch<Unsigned<width>>>, 0, AdderType>;
+  using pubUnsignedIntBatch =
+      Integer<Public<Batch<Unsigned<width>>>, 0, AdderType>;
+
+  size_t batchSize = 17;
+
+  int partyId = 2;
+
+  std::random_device rd;
+  std::mt19937_64 e(rd());
+  // half of the range so that neither the sum nor the difference overflows
+  std::uniform_int_distribution<int64_t> dist1(
+      std::numeric_limits<int64_t>().min() / 2,
+      std::numeric_limits<int64_t>().max() / 2);
+  std::uniform_int_distribution<uint64_t> dist2(
+      0, std::numeric_limits<uint64_t>().max());
+
+  for (int i = 0; i < 20; i++) {
+    int64_t v1 = dist1(e);
+    int64_t v2 = dist1(e);
+
+    // the unsigned operations are expected to wrap around
+    std::vector<uint64_t> v3(batchSize);
+    std::vector<uint64_t> v4(batchSize);
+    for (size_t j = 0; j < batchSize; j++) {
+      v3[j] = dist2(e);
+      v4[j] = dist2(e);
+    }
+
+    {
+      secSignedInt int1(v1, partyId);
+      secSignedInt int2(v2, partyId);
+      pubSignedInt int3(v2);
+
+      EXPECT_EQ((int1 + int2).openToParty(partyId).getValue(), v1 + v2);
+      EXPECT_EQ((int1 - int2).openToParty(partyId).getValue(), v1 - v2);
+      EXPECT_EQ((int1 + int3).openToParty(partyId).getValue(), v1 + v2);
+      EXPECT_EQ((int1 - int3).openToParty(partyId).getValue(), v1 - v2);
+      EXPECT_EQ((pubSignedInt(v1) - int3).getValue(), v1 - v2);
+
+      secUnsignedIntBatch int4(v3, partyId);
+      secUnsignedIntBatch int5(v4, partyId);
+      pubUnsignedIntBatch int6(v4);
+
+      testVectorEq(
+          (int4 + int5).openToParty(partyId).getValue(), addVector(v3, v4));
+      testVectorEq(
+          (int4 - int5).openToParty(partyId).getValue(),
+          subtractVector(v3, v4));
+      testVectorEq(
+          (int4 - int6).openToParty(partyId).getValue(),
+          subtractVector(v3, v4));
+    }
+  }
+}
+
+template <typename AdderType>
+void testComparisonWithAdder() {
+  const int8_t width = 64;
+
+  scheduler::SchedulerKeeper<0>::setScheduler(
+      std::make_unique<scheduler::PlaintextScheduler>(
+          scheduler::WireKeeper::createWithUnorderedMap()));
+  using secSignedInt = Integer<Secret<Signed<width>>, 0, AdderType>;
+  using pubSignedInt = Integer<Public<Signed<width>>, 0, AdderType>;
+  using secUnsignedInt = Integer<Secret<Unsigned<width>>, 0, AdderType>;
+
+  int partyId = 2;
+
+  std::random_device rd;
+  std::mt19937_64 e(rd());
+  std::uniform_int_distribution<int64_t> dist1(
+      std::numeric_limits<int64_t>().min(),
+      std::numeric_limits<int64_t>().max());
+  std::uniform_int_distribution<uint64_t> dist2(
+      0, std::numeric_limits<uint64_t>().max());
+
+  for (int i = 0; i < 100; i++) {
+    int64_t v1 = dist1(e);
+    int64_t v2 = dist1(e);
+    uint64_t v3 = dist2(e);
+    uint64_t v4 = dist2(e);
+
+    {
+      secSignedInt int1(v1, partyId);
+      secSignedInt int2(v2, partyId);
+      pubSignedInt int3(v2);
+
+      EXPECT_EQ((int1 < int2).openToParty(partyId).getValue(), v1 < v2);
+      EXPECT_EQ((int1 <= int3).openToParty(partyId).getValue(), v1 <= v2);
+      EXPECT_EQ((int1 > int2).openToParty(partyId).getValue(), v1 > v2);
+      EXPECT_EQ((int1 >= int3).openToParty(partyId).getValue(), v1 >= v2);
+      EXPECT_FALSE((int1 < int1).openToParty(partyId).getValue());
+
+      secUnsignedInt int4(v3, partyId);
+      secUnsignedInt int5(v4, partyId);
+
+      EXPECT_EQ((int4 < int5).openToParty(partyId).getValue(), v3 < v4);
+      EXPECT_EQ((int4 >= int5).openToParty(partyId).getValue(), v3 >= v4);
+      EXPECT_TRUE((int4 <= int4).openToParty(partyId).getValue());
+    }
+  }
+}
+
+TEST(IntTest, testParallelPrefixAdders) {
+  testAddAndSubtractWithAdder<SklanskyAdder>();
+  testAddAndSubtractWithAdder<KoggeStoneAdder>();
+  testAddAndSubtractWithAdder<BrentKungAdder>();
+
+  testComparisonWithAdder<SklanskyAdder>();
+  testComparisonWithAdder<KoggeStoneAdder>();
+  testComparisonWithAdder<BrentKungAdder>();
+}
+
 TEST(IntTest, testComparison) {
   const int8_t width = 64;
 
@@ -1138,6 +1266,35 @@ TEST(IntTest, testMux) {
   }
 }
 
+TEST(IntTest, testMuxUsesCompositeAnd) {
+  const int8_t width = 32;
+  auto mock = std::make_unique<schedulerMock>();
+
+  // a mux takes a single composite gate, not one AND gate per bit.
+  EXPECT_CALL(*mock, privateAndPrivateComposite(_, SizeIs(width))).Times(1);
+  EXPECT_CALL(*mock, privateAndPublicComposite(_, SizeIs(width))).Times(1);
+  EXPECT_CALL(*mock, privateAndPrivate(_, _)).Times(0);
+  EXPECT_CALL(*mock, privateAndPublic(_, _)).Times(0);
+
+  scheduler::SchedulerKeeper<0>::setScheduler(std::move(mock));
+  using secUnsignedInt = Integer<Secret<Unsigned<width>>, 0>;
+  using pubUnsignedInt = Integer<Public<Unsigned<width>>, 0>;
+
+  int partyId = 2;
+  {
+    secUnsignedInt int1(uint32_t(1), partyId);
+    secUnsignedInt int2(uint32_t(2), partyId);
+    pubUnsignedInt int3(uint32_t(3));
+    pubUnsignedInt int4(uint32_t(4));
+    Bit<true, 0> secChoice(true, partyId);
+
+    auto r1 = int1.mux(secChoice, int2);
+    auto r2 = int3.mux(secChoice, int4);
+  }
+  // everything must be out of scope before free the scheduler.
+  scheduler::SchedulerKeeper<0>::freeScheduler();
+}
+
 TEST(IntTest, testMuxBatch) {
   const int8_t width = 64;
 
@@ -1250,6 +1407,144 @@ TEST(IntTest, testMuxBatch) {
   }
 }
 
+template <typename AdderType>
+void testMultiplyWithAdder() {
+  const int8_t width = 64;
+
+  scheduler::SchedulerKeeper<0>::setScheduler(
+      std::make_unique<scheduler::PlaintextScheduler>(
+          scheduler::WireKeeper::createWithUnorderedMap()));
+  using secSignedInt = Integer<Secret<Signed<width>>, 0, AdderType>;
+  using pubSignedInt = Integer<Public<Signed<width>>, 0, AdderType>;
+  using secUnsignedInt = Integer<Secret<Unsigned<width>>, 0, AdderType>;
+  using pubUnsignedInt = Integer<Public<Unsigned<width>>, 0, AdderType>;
+
+  int partyId = 2;
+
+  std::random_device rd;
+  std::mt19937_64 e(rd());
+  std::uniform_int_distribution<int64_t> dist1(
+      std::numeric_limits<int32_t>().min(),
+      std::numeric_limits<int32_t>().max());
+  std::uniform_int_distribution<uint64_t> dist2(
+      0, std::numeric_limits<uint64_t>().max());
+
+  for (int i = 0; i < 20; i++) {
+    // the signed values are small enough not to overflow
+    int64_t v1 = dist1(e);
+    int64_t v2 = dist1(e);
+    // the unsigned products are expected to wrap around
+    uint64_t v3 = dist2(e);
+    uint64_t v4 = dist2(e);
+
+    {
+      secSignedInt int1(v1, partyId);
+      secSignedInt int2(v2, partyId);
+      pubSignedInt int3(v1);
+      pubSignedInt int4(v2);
+
+      EXPECT_EQ((int1 * int2).openToParty(partyId).getValue(), v1 * v2);
+      EXPECT_EQ((int1 * int4).openToParty(partyId).getValue(), v1 * v2);
+      EXPECT_EQ((int3 * int2).openToParty(partyId).getValue(), v1 * v2);
+      EXPECT_EQ((int3 * int4).getValue(), v1 * v2);
+
+      secUnsignedInt int5(v3, partyId);
+      secUnsignedInt int6(v4, partyId);
+      pubUnsignedInt int7(v4);
+
+      EXPECT_EQ((int5 * int6).openToParty(partyId).getValue(), v3 * v4);
+      EXPECT_EQ((int5 * int7).openToParty(partyId).getValue(), v3 * v4);
+    }
+  }
+}
+
+TEST(IntTest, testMultiply) {
+  testMultiplyWithAdder<RippleCarryAdder>();
+  testMultiplyWithAdder<SklanskyAdder>();
+}
+
+TEST(IntTest, testMultiplyBatch) {
+  const int8_t width = 32;
+
+  scheduler::SchedulerKeeper<0>::setScheduler(
+      std::make_unique<scheduler::PlaintextScheduler>(
+          scheduler::WireKeeper::createWithUnorderedMap()));
+  using secUnsignedIntBatch = Integer<Secret<Batch<Unsigned<width>>>, 0>;
+  using pubUnsignedIntBatch = Integer<Public<Batch<Unsigned<width>>>, 0>;
+
+  size_t batchSize = 17;
+  int partyId = 2;
+
+  std::random_device rd;
+  std::mt19937_64 e(rd());
+  std::uniform_int_distribution<uint32_t> dist(
+      0, std::numeric_limits<uint32_t>().max());
+
+  for (int i = 0; i < 20; i++) {
+    std::vector<uint32_t> v1(batchSize);
+    std::vector<uint32_t> v2(batchSize);
+    std::vector<uint64_t> expected(batchSize);
+    for (size_t j = 0; j < batchSize; j++) {
+      v1[j] = dist(e);
+      v2[j] = dist(e);
+      expected[j] = uint32_t(v1.at(j) * v2.at(j));
+    }
+
+    {
+      secUnsignedIntBatch int1(v1, partyId);
+      secUnsignedIntBatch int2(v2, partyId);
+      pubUnsignedIntBatch int3(v2);
+
+      testVectorEq((int1 * int2).openToParty(partyId).getValue(), expected);
+      testVectorEq((int1 * int3).openToParty(partyId).getValue(), expected);
+    }
+  }
+}
+
+TEST(IntTest, testMultiplyByPublicConstant) {
+  const int8_t width = 64;
+
+  scheduler::SchedulerKeeper<0>::setScheduler(
+      std::make_unique<scheduler::PlaintextScheduler>(
+          scheduler::WireKeeper::createWithUnorderedMap()));
+  using secUnsignedInt = Integer<Secret<Unsigned<width>>, 0>;
+  using pubUnsignedInt = Integer<Public<Unsigned<width>>, 0>;
+
+  int partyId = 2;
+  uint64_t v = 0x123456789ABCDEF;
+
+  {
+    secUnsignedInt int1(v, partyId);
+
+    // multiplying by a power of 2 is merely a shift
+    auto nonFreeGates =
+        scheduler::SchedulerKeeper<0>::getGateStatistics().first;
+    auto r1 = int1 * pubUnsignedInt(uint64_t(8));
+    auto r2 = pubUnsignedInt(uint64_t(0)) * int1;
+    EXPECT_EQ(
+        scheduler::SchedulerKeeper<0>::getGateStatistics().first,
+        nonFreeGates);
+    EXPECT_EQ(r1.openToParty(partyId).getValue(), v * 8);
+    EXPECT_EQ(r2.openToParty(partyId).getValue(), 0);
+
+    // the product of two set bits is added up with one addition, compared to
+    // a full multiplication
+    nonFreeGates = scheduler::SchedulerKeeper<0>::getGateStatistics().first;
+    auto r3 = int1 * pubUnsignedInt(uint64_t(10));
+    auto constantGates =
+        scheduler::SchedulerKeeper<0>::getGateStatistics().first -
+        nonFreeGates;
+    nonFreeGates = scheduler::SchedulerKeeper<0>::getGateStatistics().first;
+    auto r4 = int1 * secUnsignedInt(uint64_t(10), partyId);
+    auto secretGates =
+        scheduler::SchedulerKeeper<0>::getGateStatistics().first -
+        nonFreeGates;
+    EXPECT_EQ(r3.openToParty(partyId).getValue(), v * 10);
+    EXPECT_EQ(r4.openToParty(partyId).getValue(), v * 10);
+    EXPECT_LT(constantGates * 10, secretGates);
+  }
+}
+
 TEST(IntTest, testSubscript) {
   const int8_t width = 64;
 
@@ -1386,4 +1681,72 @@ TEST(IntTest, testSubscriptBatch) {
   }
 }
 
+template <int schedulerId>
+void testConversionsForParty(
+    engine::communication::IPartyCommunicationAgentFactory& agentFactory,
+    const std::vector<int32_t>& v) {
+  auto scheduler =
+      scheduler::createArithmeticLazySchedulerWithInsecureEngine<false>(
+          schedulerId, agentFactory);
+  auto& arithmeticScheduler = *scheduler;
+  scheduler::SchedulerKeeper<schedulerId>::setScheduler(std::move(scheduler));
+  using SecSignedIntBatch =
+      Integer<Secret<Batch<Signed<32>>>, schedulerId, SklanskyAdder>;
+  using SecUnsignedInt = Integer<Secret<Unsigned<16>>, schedulerId>;
+
+  // signed ints are sign extended to 64 bits
+  auto wire = SecSignedIntBatch(v, 0).toIntegerWire();
+  auto integers = arithmeticScheduler.getIntegerValueBatch(
+      arithmeticScheduler.openIntegerValueToPartyBatch(wire, 0));
+  auto output = SecSignedIntBatch(wire).openToParty(0).getValue();
+  arithmeticScheduler.decreaseReferenceCountBatch(wire);
+
+  // the unsigned int only takes the lowest 16 bits of the integer
+  auto unsignedWire = arithmeticScheduler.privateIntegerInput(0x12345678, 1);
+  auto unsignedOutput =
+      SecUnsignedInt(unsignedWire).openToParty(0).getValue();
+  arithmeticScheduler.decreaseReferenceCount(unsignedWire);
+
+  if (schedulerId == 0) {
+    std::vector<uint64_t> expectedIntegers(v.size());
+    for (size_t i = 0; i < v.size(); i++) {
+      expectedIntegers[i] = int64_t(v[i]);
+    }
+    testVectorEq(integers, expectedIntegers);
+    testVectorEq(output, std::vector<int64_t>(v.begin(), v.end()));
+    EXPECT_EQ(unsignedOutput, 0x5678);
+  }
+  scheduler::SchedulerKeeper<schedulerId>::freeScheduler();
+}
+
+TEST(IntTest, testConversions) {
+  std::random_device rd;
+  std::mt19937_64 e(rd());
+  std::uniform_int_distribution<int32_t> dist(
+      std::numeric_limits<int32_t>().min(),
+      std::numeric_limits<int32_t>().max());
+  std::vector<int32_t> v(17);
+  for (auto& item : v) {
+    item = dist(e);
+  }
+  v[0] = std::numeric_limits<int32_t>().min();
+  v[1] = -1;
+
+  auto agentFactories = engine::communication::getInMemoryAgentFactory(2);
+  auto future0 = std::async(
+      testConversionsForParty<0>, std::ref(*agentFactories.at(0)), v);
+  auto future1 = std::async(
+      testConversionsForParty<1>, std::ref(*agentFactories.at(1)), v);
+  future0.get();
+  future1.get();
+}
+
+TEST(IntTest, testConversionsNeedArithmeticScheduler) {
+  scheduler::SchedulerKeeper<0>::setScheduler(
+      std::make_unique<scheduler::PlaintextScheduler>(
+          scheduler::WireKeeper::createWithUnorderedMap()));
+  Integer<Secret<Unsigned<8>>, 0> input(uint64_t(3), 0);
+  EXPECT_THROW(input.toIntegerWire(), std::runtime_error);
+}
+
 } // namespace fbpcf::frontend
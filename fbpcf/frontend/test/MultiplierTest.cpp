@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+#include <random>
+
+#include "fbpcf/frontend/Adder.h"
+#include "fbpcf/frontend/Multiplier.h"
+#include "fbpcf/frontend/test/DepthTrackingBit.h"
+
+namespace fbpcf::frontend {
+
+template <typename AdderType, size_t width>
+void testMultiplier(size_t maxDepth) {
+  std::random_device rd;
+  std::mt19937_64 e(rd());
+  std::uniform_int_distribution<uint64_t> dist(0, 0xFFFFFFFFFFFFFFFF);
+  uint64_t mask = width == 64 ? ~uint64_t(0) : (uint64_t(1) << width) - 1;
+
+  for (int i = 0; i < 1000; i++) {
+    uint64_t v1 = dist(e) & mask;
+    uint64_t v2 = dist(e) & mask;
+    auto product =
+        WallaceTreeMultiplier::multiply<AdderType, DepthTrackingBit>(
+            toDepthTrackingBits<width>(v1), toDepthTrackingBits<width>(v2));
+    EXPECT_EQ(fromDepthTrackingBits(product), (v1 * v2) & mask);
+    EXPECT_LE(getDepth(product), maxDepth);
+  }
+}
+
+// an upper bound of the depth of the multiplier: one layer for the partial
+// products, one layer per stage of Dadda's schedule and the final adder.
+size_t getMultiplierDepth(size_t width, size_t adderDepth) {
+  size_t stages = 0;
+  for (size_t target = 2; target < width; target = target * 3 / 2) {
+    stages++;
+  }
+  return 1 + stages + adderDepth;
+}
+
+TEST(MultiplierTest, testWallaceTreeMultiplier) {
+  testMultiplier<RippleCarryAdder, 2>(getMultiplierDepth(2, 1));
+  testMultiplier<RippleCarryAdder, 13>(getMultiplierDepth(13, 12));
+  testMultiplier<RippleCarryAdder, 64>(getMultiplierDepth(64, 63));
+
+  // the prefix adders of 13 and 64 bits take 5 and 7 layers
+  testMultiplier<SklanskyAdder, 2>(getMultiplierDepth(2, 1));
+  testMultiplier<SklanskyAdder, 13>(getMultiplierDepth(13, 5));
+  testMultiplier<SklanskyAdder, 64>(getMultiplierDepth(64, 7));
+}
+
+} // namespace fbpcf::frontend
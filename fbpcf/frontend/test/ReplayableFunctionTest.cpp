@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <future>
+#include <memory>
+#include <vector>
+
+#include "fbpcf/engine/communication/test/AgentFactoryCreationHelper.h"
+#include "fbpcf/frontend/Bit.h"
+#include "fbpcf/frontend/ReplayableFunction.h"
+#include "fbpcf/frontend/test/schedulerMock.h"
+#include "fbpcf/scheduler/PlaintextScheduler.h"
+#include "fbpcf/scheduler/SchedulerHelper.h"
+#include "fbpcf/scheduler/WireKeeper.h"
+#include "fbpcf/scheduler/gate_keeper/Circuit.h"
+#include "fbpcf/test/TestHelper.h"
+
+namespace fbpcf::frontend {
+
+using namespace ::testing;
+
+// f(a, b, c) = ((a & b) ^ !c, a ^ 1), counting how many times it runs
+template <int schedulerId, bool usingBatch = false>
+ReplayableFunction<schedulerId, usingBatch> createFunction(int& calls) {
+  using SecBit = Bit<true, schedulerId, usingBatch>;
+  using PubBit = Bit<false, schedulerId, usingBatch>;
+  return ReplayableFunction<schedulerId, usingBatch>(
+      [&calls](const std::vector<SecBit>& inputs) {
+        calls++;
+        PubBit one;
+        if constexpr (usingBatch) {
+          one = PubBit(std::vector<bool>(2, true));
+        } else {
+          one = PubBit(true);
+        }
+        return std::vector<SecBit>{
+            (inputs.at(0) & inputs.at(1)) ^ !inputs.at(2),
+            inputs.at(0) ^ one};
+      });
+}
+
+TEST(ReplayableFunctionTest, testRecordOnce) {
+  auto mock = std::make_unique<schedulerMock>();
+
+  auto circuit = std::make_shared<const scheduler::Circuit>(
+      /*usingBatch*/ false,
+      /*numberOfInputs*/ 3,
+      std::vector<scheduler::Circuit::Gate>(),
+      std::vector<std::vector<bool>>(),
+      std::vector<uint32_t>{0, 1});
+  EXPECT_CALL(*mock, startRecording(_)).Times(1);
+  EXPECT_CALL(*mock, stopRecording(_)).WillOnce(Return(circuit));
+  EXPECT_CALL(*mock, replayCircuit(_, _))
+      .Times(2)
+      .WillRepeatedly(Return(std::vector<scheduler::IScheduler::WireId<
+                                 scheduler::IScheduler::Boolean>>(2)));
+
+  scheduler::SchedulerKeeper<0>::setScheduler(std::move(mock));
+  {
+    int calls = 0;
+    auto function = createFunction<0>(calls);
+    std::vector<Bit<true, 0>> inputs(3);
+    for (int i = 0; i < 3; i++) {
+      EXPECT_EQ(function(inputs).size(), 2);
+    }
+    EXPECT_EQ(calls, 1);
+  }
+  scheduler::SchedulerKeeper<0>::freeScheduler();
+}
+
+TEST(ReplayableFunctionTest, testPlaintextScheduler) {
+  scheduler::SchedulerKeeper<0>::setScheduler(
+      std::make_unique<scheduler::PlaintextScheduler>(
+          scheduler::WireKeeper::createWithUnorderedMap()));
+
+  int partyId = 3;
+  using SecBit = Bit<true, 0>;
+  {
+    // the scheduler doesn't record circuits, the function runs every time
+    int calls = 0;
+    auto function = createFunction<0>(calls);
+    for (int i = 0; i < 8; i++) {
+      bool a = i & 1;
+      bool b = i & 2;
+      bool c = i & 4;
+      auto outputs = function(
+          {SecBit(a, partyId), SecBit(b, partyId), SecBit(c, partyId)});
+      ASSERT_EQ(outputs.size(), 2);
+      EXPECT_EQ(
+          outputs.at(0).openToParty(partyId).getValue(), (a & b) ^ !c);
+      EXPECT_EQ(outputs.at(1).openToParty(partyId).getValue(), !a);
+    }
+    EXPECT_EQ(calls, 8);
+  }
+  scheduler::SchedulerKeeper<0>::freeScheduler();
+}
+
+template <int schedulerId, bool usingBatch>
+void testReplayForParty(
+    engine::communication::IPartyCommunicationAgentFactory& agentFactory) {
+  scheduler::SchedulerKeeper<schedulerId>::setScheduler(
+      scheduler::createLazySchedulerWithInsecureEngine<unsafe>(
+          schedulerId, agentFactory));
+  using SecBit = Bit<true, schedulerId, usingBatch>;
+  {
+    int calls = 0;
+    auto function = createFunction<schedulerId, usingBatch>(calls);
+    for (int i = 0; i < 8; i++) {
+      bool a = i & 1;
+      bool b = i & 2;
+      bool c = i & 4;
+      std::vector<SecBit> inputs;
+      if constexpr (usingBatch) {
+        inputs = {SecBit({a, !a}, 0), SecBit({b, !b}, 1), SecBit({c, !c}, 0)};
+      } else {
+        inputs = {SecBit(a, 0), SecBit(b, 1), SecBit(c, 0)};
+      }
+      auto outputs = function(inputs);
+      ASSERT_EQ(outputs.size(), 2);
+      auto output0 = outputs.at(0).openToParty(0).getValue();
+      auto output1 = outputs.at(1).openToParty(0).getValue();
+      if (schedulerId == 0) {
+        if constexpr (usingBatch) {
+          EXPECT_EQ(
+              output0,
+              std::vector<bool>({bool((a & b) ^ !c), bool((!a & !b) ^ c)}));
+          EXPECT_EQ(output1, std::vector<bool>({!a, a}));
+        } else {
+          EXPECT_EQ(output0, (a & b) ^ !c);
+          EXPECT_EQ(output1, !a);
+        }
+      }
+    }
+    // the later shards replay the circuit recorded on the first one
+    EXPECT_EQ(calls, 1);
+  }
+  scheduler::SchedulerKeeper<schedulerId>::freeScheduler();
+}
+
+template <bool usingBatch>
+void testReplayWithLazyScheduler() {
+  auto agentFactories = engine::communication::getInMemoryAgentFactory(2);
+  auto future0 = std::async(
+      testReplayForParty<0, usingBatch>, std::ref(*agentFactories.at(0)));
+  auto future1 = std::async(
+      testReplayForParty<1, usingBatch>, std::ref(*agentFactories.at(1)));
+  future0.get();
+  future1.get();
+}
+
+TEST(ReplayableFunctionTest, testLazyScheduler) {
+  testReplayWithLazyScheduler</*usingBatch*/ false>();
+}
+
+TEST(ReplayableFunctionTest, testLazySchedulerBatch) {
+  testReplayWithLazyScheduler</*usingBatch*/ true>();
+}
+
+} // namespace fbpcf::frontend
@@ -0,0 +1,261 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <folly/Benchmark.h>
+#include <future>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "common/init/Init.h"
+
+#include "fbpcf/engine/communication/IPartyCommunicationAgentFactory.h"
+#include "fbpcf/engine/util/test/benchmarks/BenchmarkHelper.h"
+#include "fbpcf/engine/util/test/benchmarks/NetworkedBenchmark.h"
+#include "fbpcf/frontend/Int.h"
+#include "fbpcf/frontend/test/DepthTrackingBit.h"
+#include "fbpcf/scheduler/SchedulerHelper.h"
+
+namespace fbpcf::frontend {
+
+DEFINE_int64(
+    IntBenchmark_Batch_Size,
+    1024,
+    "How many operations are computed in one batch");
+
+const int8_t kWidth = 64;
+
+// The operations under benchmark. Each of them computes the result and opens
+// it to party 0.
+struct Addition {
+  // the number of bits in the result
+  static const int8_t kOutputWidth = kWidth;
+
+  template <typename AdderType>
+  static size_t getAndDepth() {
+    auto bits = toDepthTrackingBits<kWidth>(0);
+    return getDepth(AdderType::template add<DepthTrackingBit>(bits, bits));
+  }
+
+  template <typename IntType>
+  static void compute(const IntType& left, const IntType& right) {
+    (left + right).openToParty(0).getValue();
+  }
+};
+
+struct Comparison {
+  static const int8_t kOutputWidth = 1;
+
+  template <typename AdderType>
+  static size_t getAndDepth() {
+    auto bits = toDepthTrackingBits<kWidth>(0);
+    return AdderType::template lessThan<false, DepthTrackingBit>(bits, bits)
+        .depth;
+  }
+
+  template <typename IntType>
+  static void compute(const IntType& left, const IntType& right) {
+    (left < right).openToParty(0).getValue();
+  }
+};
+
+struct Multiplication {
+  static const int8_t kOutputWidth = kWidth;
+
+  template <typename AdderType>
+  static size_t getAndDepth() {
+    auto bits = toDepthTrackingBits<kWidth>(0);
+    return getDepth(
+        WallaceTreeMultiplier::multiply<AdderType, DepthTrackingBit>(
+            bits, bits));
+  }
+
+  template <typename IntType>
+  static void compute(const IntType& left, const IntType& right) {
+    (left * right).openToParty(0).getValue();
+  }
+};
+
+// multiplication by a public constant, which only adds up shifted copies of
+// the secret operand.
+struct MultiplicationByConstant {
+  static const int8_t kOutputWidth = kWidth;
+  static const uint64_t kConstant = 0x5555555555555555;
+
+  template <typename AdderType>
+  static size_t getAndDepth() {
+    auto bits = toDepthTrackingBits<kWidth>(0);
+    std::vector<std::vector<DepthTrackingBit>> columns(kWidth);
+    for (size_t i = 0; i < kWidth; i++) {
+      if ((kConstant >> i) & 1) {
+        for (size_t j = 0; i + j < kWidth; j++) {
+          columns[i + j].push_back(bits.at(j));
+        }
+      }
+    }
+    return getDepth(
+        WallaceTreeMultiplier::sumColumns<AdderType, DepthTrackingBit, kWidth>(
+            std::move(columns), DepthTrackingBit{false, 0}));
+  }
+
+  template <
+      bool isSigned,
+      int8_t width,
+      int schedulerId,
+      typename AdderType>
+  static void compute(
+      const Int<isSigned, width, true, schedulerId, true, AdderType>& left,
+      const Int<isSigned, width, true, schedulerId, true, AdderType>&
+      /* right */) {
+    Int<isSigned, width, false, schedulerId, true, AdderType> constant(
+        std::vector<uint64_t>(FLAGS_IntBenchmark_Batch_Size, kConstant));
+    (left * constant).openToParty(0).getValue();
+  }
+};
+
+// Runs an operation on two batches of secret 64-bit integers between two
+// parties over sockets. Besides the wall-clock time and the traffic, it
+// reports the AND gates executed and the AND depth of the circuit, i.e. the
+// number of rounds of communication the operation takes. The engines use dummy
+// tuples so that the time isn't dominated by tuple generation.
+template <typename AdderType, typename Operation>
+class IntOperationBenchmark final : public engine::util::NetworkedBenchmark {
+ public:
+  void addCounters(folly::UserCounters& counters) {
+    counters["and_depth"] = Operation::template getAndDepth<AdderType>();
+    counters["and_gates"] = andGates_;
+  }
+
+ protected:
+  void setup() override {
+    auto [factory0, factory1] = engine::util::getSocketAgentFactories();
+    agentFactory0_ = std::move(factory0);
+    agentFactory1_ = std::move(factory1);
+
+    auto scheduler0 = std::async(
+        scheduler::createLazySchedulerWithInsecureEngine</*unsafe*/ true>,
+        0,
+        std::ref(*agentFactory0_));
+    auto scheduler1 = std::async(
+        scheduler::createLazySchedulerWithInsecureEngine</*unsafe*/ true>,
+        1,
+        std::ref(*agentFactory1_));
+    scheduler::SchedulerKeeper<0>::setScheduler(scheduler0.get());
+    scheduler::SchedulerKeeper<1>::setScheduler(scheduler1.get());
+
+    std::random_device rd;
+    std::mt19937_64 e(rd());
+    std::uniform_int_distribution<uint64_t> dist(
+        0, std::numeric_limits<uint64_t>().max());
+    input_ = std::vector<uint64_t>(FLAGS_IntBenchmark_Batch_Size);
+    for (auto& item : input_) {
+      item = dist(e);
+    }
+
+    // setting up the engines takes traffic too
+    initialTraffic_ = scheduler::SchedulerKeeper<0>::getTrafficStatistics();
+  }
+
+  void runSender() override {
+    andGates_ = run<0>();
+  }
+
+  void runReceiver() override {
+    run<1>();
+  }
+
+  std::pair<uint64_t, uint64_t> getTrafficStatistics() override {
+    auto [sent, received] =
+        scheduler::SchedulerKeeper<0>::getTrafficStatistics();
+    return {sent - initialTraffic_.first, received - initialTraffic_.second};
+  }
+
+ private:
+  // run the operation on the inputs of the two parties and return the AND
+  // gates executed.
+  template <int schedulerId>
+  uint64_t run() {
+    using SecUnsignedIntBatch = Integer<
+        Secret<Batch<Unsigned<kWidth>>>,
+        schedulerId,
+        AdderType>;
+    SecUnsignedIntBatch left(input_, 0);
+    SecUnsignedIntBatch right(input_, 1);
+    Operation::compute(left, right);
+    // opening the result takes one non-free gate per bit
+    return scheduler::SchedulerKeeper<schedulerId>::getGateStatistics().first -
+        Operation::kOutputWidth * input_.size();
+  }
+
+  std::unique_ptr<engine::communication::IPartyCommunicationAgentFactory>
+      agentFactory0_;
+  std::unique_ptr<engine::communication::IPartyCommunicationAgentFactory>
+      agentFactory1_;
+
+  std::vector<uint64_t> input_;
+  std::pair<uint64_t, uint64_t> initialTraffic_;
+  uint64_t andGates_ = 0;
+};
+
+template <typename AdderType, typename Operation>
+void runIntOperationBenchmark(folly::UserCounters& counters) {
+  IntOperationBenchmark<AdderType, Operation> benchmark;
+  benchmark.runBenchmark(counters);
+  BENCHMARK_SUSPEND {
+    benchmark.addCounters(counters);
+  }
+}
+
+BENCHMARK_COUNTERS(Int_Add_RippleCarryAdder, counters) {
+  runIntOperationBenchmark<RippleCarryAdder, Addition>(counters);
+}
+
+BENCHMARK_COUNTERS(Int_Add_SklanskyAdder, counters) {
+  runIntOperationBenchmark<SklanskyAdder, Addition>(counters);
+}
+
+BENCHMARK_COUNTERS(Int_Add_KoggeStoneAdder, counters) {
+  runIntOperationBenchmark<KoggeStoneAdder, Addition>(counters);
+}
+
+BENCHMARK_COUNTERS(Int_Add_BrentKungAdder, counters) {
+  runIntOperationBenchmark<BrentKungAdder, Addition>(counters);
+}
+
+BENCHMARK_COUNTERS(Int_LessThan_RippleCarryAdder, counters) {
+  runIntOperationBenchmark<RippleCarryAdder, Comparison>(counters);
+}
+
+// all the parallel-prefix adders compare with the same tree
+BENCHMARK_COUNTERS(Int_LessThan_SklanskyAdder, counters) {
+  runIntOperationBenchmark<SklanskyAdder, Comparison>(counters);
+}
+
+BENCHMARK_COUNTERS(Int_Multiply_RippleCarryAdder, counters) {
+  runIntOperationBenchmark<RippleCarryAdder, Multiplication>(counters);
+}
+
+BENCHMARK_COUNTERS(Int_Multiply_SklanskyAdder, counters) {
+  runIntOperationBenchmark<SklanskyAdder, Multiplication>(counters);
+}
+
+BENCHMARK_COUNTERS(Int_MultiplyByConstant_RippleCarryAdder, counters) {
+  runIntOperationBenchmark<RippleCarryAdder, MultiplicationByConstant>(
+      counters);
+}
+
+BENCHMARK_COUNTERS(Int_MultiplyByConstant_SklanskyAdder, counters) {
+  runIntOperationBenchmark<SklanskyAdder, MultiplicationByConstant>(counters);
+}
+
+} // namespace fbpcf::frontend
+
+int main(int argc, char* argv[]) {
+  facebook::initFacebook(&argc, &argv);
+  folly::runBenchmarks();
+  return 0;
+}
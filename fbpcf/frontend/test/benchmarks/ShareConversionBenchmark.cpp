@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <folly/Benchmark.h>
+#include <array>
+#include <future>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "common/init/Init.h"
+
+#include "fbpcf/engine/communication/IPartyCommunicationAgentFactory.h"
+#include "fbpcf/engine/util/test/benchmarks/BenchmarkHelper.h"
+#include "fbpcf/engine/util/test/benchmarks/NetworkedBenchmark.h"
+#include "fbpcf/frontend/Int.h"
+#include "fbpcf/scheduler/IArithmeticScheduler.h"
+#include "fbpcf/scheduler/SchedulerHelper.h"
+
+namespace fbpcf::frontend {
+
+// The conversions are typically run on 1M to 50M rows.
+DEFINE_int64(
+    ShareConversionBenchmark_Batch_Size,
+    1000000,
+    "How many integers are converted in one batch");
+
+const int8_t kWidth = 64;
+
+// The conversions under benchmark. Each of them converts a batch of private
+// integers from party 0 and opens the result to party 0.
+struct BooleanToInteger {
+  template <int schedulerId>
+  static void convert(
+      scheduler::IArithmeticScheduler& scheduler,
+      const std::vector<uint64_t>& input) {
+    auto wire =
+        Integer<Secret<Batch<Unsigned<kWidth>>>, schedulerId>(input, 0)
+            .toIntegerWire();
+    scheduler.getIntegerValueBatch(
+        scheduler.openIntegerValueToPartyBatch(wire, 0));
+    scheduler.decreaseReferenceCountBatch(wire);
+  }
+};
+
+struct IntegerToBoolean {
+  template <int schedulerId>
+  static void convert(
+      scheduler::IArithmeticScheduler& scheduler,
+      const std::vector<uint64_t>& input) {
+    auto wire = scheduler.privateIntegerInputBatch(input, 0);
+    Integer<Secret<Batch<Unsigned<kWidth>>>, schedulerId, SklanskyAdder>(wire)
+        .openToParty(0)
+        .getValue();
+    scheduler.decreaseReferenceCountBatch(wire);
+  }
+};
+
+// Runs a conversion between XOR shared Ints and additively shared integer
+// wires between two parties over sockets. Besides the wall-clock time and the
+// traffic, it reports the batch size and the non-free gates executed. The
+// engines use dummy tuples so that the time isn't dominated by tuple
+// generation.
+template <typename Conversion>
+class ShareConversionBenchmark final : public engine::util::NetworkedBenchmark {
+ public:
+  void addCounters(folly::UserCounters& counters) {
+    counters["batch_size"] = input_.size();
+    counters["nonfree_gates"] = nonFreeGates_;
+  }
+
+ protected:
+  void setup() override {
+    auto [factory0, factory1] = engine::util::getSocketAgentFactories();
+    agentFactory0_ = std::move(factory0);
+    agentFactory1_ = std::move(factory1);
+
+    auto scheduler0 = std::async(
+        scheduler::createArithmeticLazySchedulerWithInsecureEngine<
+            /*unsafe*/ true>,
+        0,
+        std::ref(*agentFactory0_));
+    auto scheduler1 = std::async(
+        scheduler::createArithmeticLazySchedulerWithInsecureEngine<
+            /*unsafe*/ true>,
+        1,
+        std::ref(*agentFactory1_));
+    schedulers_.at(0) = scheduler0.get().release();
+    schedulers_.at(1) = scheduler1.get().release();
+    // the scheduler keepers take the ownership
+    scheduler::SchedulerKeeper<0>::setScheduler(
+        std::unique_ptr<scheduler::IScheduler>(schedulers_.at(0)));
+    scheduler::SchedulerKeeper<1>::setScheduler(
+        std::unique_ptr<scheduler::IScheduler>(schedulers_.at(1)));
+
+    std::random_device rd;
+    std::mt19937_64 e(rd());
+    std::uniform_int_distribution<uint64_t> dist(
+        0, std::numeric_limits<uint64_t>().max());
+    input_ = std::vector<uint64_t>(FLAGS_ShareConversionBenchmark_Batch_Size);
+    for (auto& item : input_) {
+      item = dist(e);
+    }
+
+    // setting up the engines takes traffic too
+    initialTraffic_ = scheduler::SchedulerKeeper<0>::getTrafficStatistics();
+  }
+
+  void runSender() override {
+    Conversion::template convert<0>(*schedulers_.at(0), input_);
+    nonFreeGates_ = scheduler::SchedulerKeeper<0>::getGateStatistics().first;
+  }
+
+  void runReceiver() override {
+    Conversion::template convert<1>(*schedulers_.at(1), input_);
+  }
+
+  std::pair<uint64_t, uint64_t> getTrafficStatistics() override {
+    auto [sent, received] =
+        scheduler::SchedulerKeeper<0>::getTrafficStatistics();
+    return {sent - initialTraffic_.first, received - initialTraffic_.second};
+  }
+
+ private:
+  std::unique_ptr<engine::communication::IPartyCommunicationAgentFactory>
+      agentFactory0_;
+  std::unique_ptr<engine::communication::IPartyCommunicationAgentFactory>
+      agentFactory1_;
+
+  std::array<scheduler::IArithmeticScheduler*, 2> schedulers_;
+
+  std::vector<uint64_t> input_;
+  std::pair<uint64_t, uint64_t> initialTraffic_;
+  uint64_t nonFreeGates_ = 0;
+};
+
+template <typename Conversion>
+void runShareConversionBenchmark(folly::UserCounters& counters) {
+  ShareConversionBenchmark<Conversion> benchmark;
+  benchmark.runBenchmark(counters);
+  BENCHMARK_SUSPEND {
+    benchmark.addCounters(counters);
+  }
+}
+
+BENCHMARK_COUNTERS(ShareConversion_BooleanToInteger, counters) {
+  runShareConversionBenchmark<BooleanToInteger>(counters);
+}
+
+BENCHMARK_COUNTERS(ShareConversion_IntegerToBoolean, counters) {
+  runShareConversionBenchmark<IntegerToBoolean>(counters);
+}
+
+} // namespace fbpcf::frontend
+
+int main(int argc, char* argv[]) {
+  facebook::initFacebook(&argc, &argv);
+  folly::runBenchmarks();
+  return 0;
+}
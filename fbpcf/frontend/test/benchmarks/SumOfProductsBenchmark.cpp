@@ -0,0 +1,233 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <folly/Benchmark.h>
+#include <array>
+#include <future>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "common/init/Init.h"
+
+#include "fbpcf/engine/communication/IPartyCommunicationAgentFactory.h"
+#include "fbpcf/engine/util/test/benchmarks/BenchmarkHelper.h"
+#include "fbpcf/engine/util/test/benchmarks/NetworkedBenchmark.h"
+#include "fbpcf/frontend/Int.h"
+#include "fbpcf/scheduler/IArithmeticScheduler.h"
+#include "fbpcf/scheduler/SchedulerHelper.h"
+
+namespace fbpcf::frontend {
+
+DEFINE_int64(
+    SumOfProductsBenchmark_Arithmetic_Rows,
+    10000000,
+    "How many rows are multiplied and summed up with arithmetic shares");
+
+DEFINE_int64(
+    SumOfProductsBenchmark_Boolean_Rows,
+    10000,
+    "How many rows are multiplied and summed up with the boolean Int circuit");
+
+// Computes sum_i(left_i * right_i) mod 2^64 over two columns of secret 64-bit
+// integers, one from each party, and opens the result to party 0. Besides the
+// wall-clock time and the traffic, it reports the rows processed and the
+// non-free gates (ANDs or multiplications) executed, so that the two paths
+// can be compared per row. The engines use dummy tuples so that the time isn't
+// dominated by tuple generation.
+class SumOfProductsBenchmark : public engine::util::NetworkedBenchmark {
+ public:
+  void addCounters(folly::UserCounters& counters) {
+    counters["rows"] = input_.size();
+    counters["nonfree_gates"] = nonFreeGates_;
+  }
+
+ protected:
+  void setup() override {
+    auto [factory0, factory1] = engine::util::getSocketAgentFactories();
+    agentFactory0_ = std::move(factory0);
+    agentFactory1_ = std::move(factory1);
+
+    createSchedulers();
+
+    std::random_device rd;
+    std::mt19937_64 e(rd());
+    std::uniform_int_distribution<uint64_t> dist(
+        0, std::numeric_limits<uint64_t>().max());
+    input_ = std::vector<uint64_t>(getRows());
+    for (auto& item : input_) {
+      item = dist(e);
+    }
+
+    // setting up the engines takes traffic too
+    initialTraffic_ = getSchedulerTrafficStatistics();
+  }
+
+  void runSender() override {
+    nonFreeGates_ = run(0);
+  }
+
+  void runReceiver() override {
+    run(1);
+  }
+
+  std::pair<uint64_t, uint64_t> getTrafficStatistics() override {
+    auto [sent, received] = getSchedulerTrafficStatistics();
+    return {sent - initialTraffic_.first, received - initialTraffic_.second};
+  }
+
+  virtual size_t getRows() const = 0;
+
+  // create the schedulers of both parties, from agentFactory0_ and
+  // agentFactory1_ respectively.
+  virtual void createSchedulers() = 0;
+
+  virtual std::pair<uint64_t, uint64_t> getSchedulerTrafficStatistics() = 0;
+
+  // compute the sum of products as party myId and return the non-free gates
+  // executed.
+  virtual uint64_t run(int myId) = 0;
+
+  std::unique_ptr<engine::communication::IPartyCommunicationAgentFactory>
+      agentFactory0_;
+  std::unique_ptr<engine::communication::IPartyCommunicationAgentFactory>
+      agentFactory1_;
+
+  std::vector<uint64_t> input_;
+
+ private:
+  std::pair<uint64_t, uint64_t> initialTraffic_;
+  uint64_t nonFreeGates_ = 0;
+};
+
+// The products are batched multiplication gates over additive shares, which
+// take a single round. Additions are free, so each party sums up its shares of
+// the products locally before opening the total.
+class ArithmeticSumOfProductsBenchmark final : public SumOfProductsBenchmark {
+ protected:
+  size_t getRows() const override {
+    return FLAGS_SumOfProductsBenchmark_Arithmetic_Rows;
+  }
+
+  void createSchedulers() override {
+    auto scheduler0 = std::async(
+        scheduler::createArithmeticLazySchedulerWithInsecureEngine<
+            /*unsafe*/ true>,
+        0,
+        std::ref(*agentFactory0_));
+    auto scheduler1 = std::async(
+        scheduler::createArithmeticLazySchedulerWithInsecureEngine<
+            /*unsafe*/ true>,
+        1,
+        std::ref(*agentFactory1_));
+    schedulers_.at(0) = scheduler0.get();
+    schedulers_.at(1) = scheduler1.get();
+  }
+
+  std::pair<uint64_t, uint64_t> getSchedulerTrafficStatistics() override {
+    return schedulers_.at(0)->getTrafficStatistics();
+  }
+
+  uint64_t run(int myId) override {
+    auto& scheduler = *schedulers_.at(myId);
+    auto product = scheduler.privateMultPrivateBatch(
+        scheduler.privateIntegerInputBatch(input_, 0),
+        scheduler.privateIntegerInputBatch(input_, 1));
+    auto shares = scheduler.extractIntegerSecretShareBatch(product);
+    auto sum = std::accumulate(shares.begin(), shares.end(), uint64_t(0));
+    scheduler.getIntegerValue(scheduler.openIntegerValueToParty(
+        scheduler.recoverIntegerWire(sum), 0));
+    // opening the result takes one non-free gate
+    return scheduler.getGateStatistics().first - 1;
+  }
+
+ private:
+  std::array<std::unique_ptr<scheduler::IArithmeticScheduler>, 2> schedulers_;
+};
+
+// The products are Int multiplication circuits over XOR shares. The sum is then
+// computed by a tree of Int additions: every level adds the lower half of the
+// batch to the upper half, which are split by extracting and recovering the
+// shares.
+class BooleanSumOfProductsBenchmark final : public SumOfProductsBenchmark {
+ protected:
+  size_t getRows() const override {
+    return FLAGS_SumOfProductsBenchmark_Boolean_Rows;
+  }
+
+  void createSchedulers() override {
+    auto scheduler0 = std::async(
+        scheduler::createLazySchedulerWithInsecureEngine</*unsafe*/ true>,
+        0,
+        std::ref(*agentFactory0_));
+    auto scheduler1 = std::async(
+        scheduler::createLazySchedulerWithInsecureEngine</*unsafe*/ true>,
+        1,
+        std::ref(*agentFactory1_));
+    scheduler::SchedulerKeeper<0>::setScheduler(scheduler0.get());
+    scheduler::SchedulerKeeper<1>::setScheduler(scheduler1.get());
+  }
+
+  std::pair<uint64_t, uint64_t> getSchedulerTrafficStatistics() override {
+    return scheduler::SchedulerKeeper<0>::getTrafficStatistics();
+  }
+
+  uint64_t run(int myId) override {
+    return myId == 0 ? run<0>() : run<1>();
+  }
+
+ private:
+  template <int schedulerId>
+  uint64_t run() {
+    using SecUnsignedIntBatch =
+        Integer<Secret<Batch<Unsigned<64>>>, schedulerId, SklanskyAdder>;
+    SecUnsignedIntBatch left(input_, 0);
+    SecUnsignedIntBatch right(input_, 1);
+    auto sum = left * right;
+    for (auto size = input_.size(); size > 1; size = (size + 1) / 2) {
+      auto shares = sum.extractIntShare().getValue();
+      if (size % 2 == 1) {
+        // both parties pad with a share of 0
+        shares.push_back(0);
+      }
+      auto half = shares.size() / 2;
+      sum = SecUnsignedIntBatch(typename SecUnsignedIntBatch::ExtractedInt(
+                std::vector<uint64_t>(shares.begin(), shares.begin() + half))) +
+          SecUnsignedIntBatch(typename SecUnsignedIntBatch::ExtractedInt(
+              std::vector<uint64_t>(shares.begin() + half, shares.end())));
+    }
+    sum.openToParty(0).getValue();
+    // opening the result takes one non-free gate per bit
+    return scheduler::SchedulerKeeper<schedulerId>::getGateStatistics().first -
+        64;
+  }
+};
+
+BENCHMARK_COUNTERS(SumOfProducts_Arithmetic, counters) {
+  ArithmeticSumOfProductsBenchmark benchmark;
+  benchmark.runBenchmark(counters);
+  BENCHMARK_SUSPEND {
+    benchmark.addCounters(counters);
+  }
+}
+
+BENCHMARK_COUNTERS(SumOfProducts_BooleanInt, counters) {
+  BooleanSumOfProductsBenchmark benchmark;
+  benchmark.runBenchmark(counters);
+  BENCHMARK_SUSPEND {
+    benchmark.addCounters(counters);
+  }
+}
+
+} // namespace fbpcf::frontend
+
+int main(int argc, char* argv[]) {
+  facebook::initFacebook(&argc, &argv);
+  folly::runBenchmarks();
+  return 0;
+}
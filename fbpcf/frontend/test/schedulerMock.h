@@ -10,6 +10,7 @@
 #include <gtest/gtest.h>
 
 #include "fbpcf/scheduler/IScheduler.h"
+#include "fbpcf/scheduler/gate_keeper/Circuit.h"
 
 namespace fbpcf::frontend {
 
@@ -34,6 +35,32 @@ class schedulerMock final : public scheduler::IScheduler {
         .WillByDefault(Invoke([](const std::vector<bool>& /*input*/) {
           return WireId<IScheduler::Boolean>(1);
         }));
+
+    ON_CALL(*this, privateAndPrivateComposite(_, _))
+        .WillByDefault(Invoke(createCompositeOutput));
+
+    ON_CALL(*this, privateAndPrivateCompositeBatch(_, _))
+        .WillByDefault(Invoke(createCompositeOutput));
+
+    ON_CALL(*this, privateAndPublicComposite(_, _))
+        .WillByDefault(Invoke(createCompositeOutput));
+
+    ON_CALL(*this, privateAndPublicCompositeBatch(_, _))
+        .WillByDefault(Invoke(createCompositeOutput));
+
+    ON_CALL(*this, publicAndPublicComposite(_, _))
+        .WillByDefault(Invoke(createCompositeOutput));
+
+    ON_CALL(*this, publicAndPublicCompositeBatch(_, _))
+        .WillByDefault(Invoke(createCompositeOutput));
+  }
+
+  // one output wire for each of the right wires.
+  static std::vector<WireId<IScheduler::Boolean>> createCompositeOutput(
+      WireId<IScheduler::Boolean> /*left*/,
+      std::vector<WireId<IScheduler::Boolean>> rights) {
+    return std::vector<WireId<IScheduler::Boolean>>(
+        rights.size(), WireId<IScheduler::Boolean>(1));
   }
 
   //======== Below are input processing APIs: ========
@@ -221,6 +248,27 @@ class schedulerMock final : public scheduler::IScheduler {
 
   MOCK_METHOD1(decreaseReferenceCountBatch, void(WireId<IScheduler::Boolean>));
 
+  //======== Below are circuit recording APIs: ========
+
+  MOCK_METHOD1(
+      startRecording,
+      void(const std::vector<WireId<IScheduler::Boolean>>&));
+
+  MOCK_METHOD1(
+      startRecordingBatch,
+      void(const std::vector<WireId<IScheduler::Boolean>>&));
+
+  MOCK_METHOD1(
+      stopRecording,
+      std::shared_ptr<const scheduler::Circuit>(
+          const std::vector<WireId<IScheduler::Boolean>>&));
+
+  MOCK_METHOD2(
+      replayCircuit,
+      std::vector<WireId<IScheduler::Boolean>>(
+          const scheduler::Circuit&,
+          const std::vector<WireId<IScheduler::Boolean>>&));
+
   std::pair<uint64_t, uint64_t> getTrafficStatistics() const override {
     return {0, 0};
   }
@@ -228,6 +276,18 @@ class schedulerMock final : public scheduler::IScheduler {
   std::pair<uint64_t, uint64_t> getWireStatistics() const override {
     return {0, 0};
   }
+
+  std::pair<uint64_t, uint64_t> getPendingBytesStatistics() const override {
+    return {0, 0};
+  }
+
+  std::pair<uint64_t, uint64_t> getEliminatedGateStatistics() const override {
+    return {0, 0};
+  }
+
+  std::chrono::nanoseconds getTupleStarvationTime() const override {
+    return std::chrono::nanoseconds(0);
+  }
 };
 
 } // namespace fbpcf::frontend
@@ -134,10 +134,13 @@ LinearOram<T, schedulerId>::conditionalExpansionOneLayer(
     std::vector<SecBatchT>&& src,
     const SecBatchT& zero,
     const frontend::Bit<true, schedulerId, true>& condition) const {
+  // every item is swapped under the same condition, so the whole layer only
+  // needs one composite AND gate.
+  auto swapped =
+      util::MpcAdapters<T, schedulerId>::obliviousSwap(src, zero, condition);
   std::vector<typename LinearOram<T, schedulerId>::SecBatchT> rst;
-  for (auto& item : src) {
-    auto [t0, t1] =
-        util::MpcAdapters<T, schedulerId>::obliviousSwap(item, zero, condition);
+  rst.reserve(swapped.size() * 2);
+  for (auto& [t0, t1] : swapped) {
     rst.push_back(std::move(t0));
     rst.push_back(std::move(t1));
   }
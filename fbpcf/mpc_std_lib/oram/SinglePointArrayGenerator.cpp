@@ -67,7 +67,9 @@ ISinglePointArrayGenerator::ArrayType SinglePointArrayGenerator::expandArray(
   std::vector<__m128i> delta1(batchSize, _mm_set_epi64x(0, 0));
 
   for (size_t i = 0; i < batchSize; i++) {
-    rst[i].second = expander_->expand(std::move(src[i].second));
+    rst[i].second = expander_ != nullptr
+        ? expander_->expand(std::move(src[i].second))
+        : halfTreeExpander_->expand(std::move(src[i].second));
     for (size_t j = 0; j < rst.at(i).second.size(); j += 2) {
       delta0[i] = _mm_xor_si128(delta0.at(i), rst.at(i).second.at(j));
       delta1[i] = _mm_xor_si128(delta1.at(i), rst.at(i).second.at(j + 1));
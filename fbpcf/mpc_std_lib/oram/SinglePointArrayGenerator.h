@@ -30,11 +30,19 @@ class SinglePointArrayGenerator final : public ISinglePointArrayGenerator {
       bool firstShare /* which value to start with when generating the
                          array, the two parties must use different values*/
       ,
-      std::unique_ptr<IObliviousDeltaCalculator> obliviousDeltaCalculator)
+      std::unique_ptr<IObliviousDeltaCalculator> obliviousDeltaCalculator,
+      bool halfTree = false /* whether to expand the trees with a correlated
+                               ggm construction, one AES call per key
+                               instead of two */
+      )
       : firstShare_(firstShare),
         obliviousDeltaCalculator_(std::move(obliviousDeltaCalculator)) {
-    expander_ = std::make_unique<engine::util::Expander>(
-        0 /* this index is not important, any PUBLIC CONSTANT works*/);
+    if (halfTree) {
+      halfTreeExpander_ = std::make_unique<engine::util::HalfTreeExpander>();
+    } else {
+      expander_ = std::make_unique<engine::util::Expander>(
+          0 /* this index is not important, any PUBLIC CONSTANT works*/);
+    }
   }
 
   /**
@@ -56,7 +64,9 @@ class SinglePointArrayGenerator final : public ISinglePointArrayGenerator {
 
   bool firstShare_;
   std::unique_ptr<IObliviousDeltaCalculator> obliviousDeltaCalculator_;
+  // exactly one of the two expanders is set
   std::unique_ptr<engine::util::Expander> expander_;
+  std::unique_ptr<engine::util::HalfTreeExpander> halfTreeExpander_;
 };
 
 } // namespace fbpcf::mpc_std_lib::oram
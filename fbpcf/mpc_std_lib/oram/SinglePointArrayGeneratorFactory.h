@@ -21,18 +21,21 @@ class SinglePointArrayGeneratorFactory final
   SinglePointArrayGeneratorFactory(
       bool firstShare,
       std::unique_ptr<IObliviousDeltaCalculatorFactory>
-          obliviousCalculatrFactory)
+          obliviousCalculatrFactory,
+      bool halfTree = false)
       : firstShare_(firstShare),
-        obliviousCalculatrFactory_(std::move(obliviousCalculatrFactory)) {}
+        obliviousCalculatrFactory_(std::move(obliviousCalculatrFactory)),
+        halfTree_(halfTree) {}
 
   std::unique_ptr<ISinglePointArrayGenerator> create() override {
     return std::make_unique<SinglePointArrayGenerator>(
-        firstShare_, obliviousCalculatrFactory_->create());
+        firstShare_, obliviousCalculatrFactory_->create(), halfTree_);
   }
 
  private:
   bool firstShare_;
   std::unique_ptr<IObliviousDeltaCalculatorFactory> obliviousCalculatrFactory_;
+  bool halfTree_;
 };
 
 } // namespace fbpcf::mpc_std_lib::oram
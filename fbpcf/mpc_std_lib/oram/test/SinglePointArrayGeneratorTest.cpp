@@ -150,4 +150,21 @@ TEST(
   testSinglePointArrayGenerator(std::move(factory0), std::move(factory1));
 }
 
+TEST(
+    SinglePointArrayGeneratorTest,
+    testHalfTreeSinglePointArrayGeneratorWithObliviousDeltaCalculator) {
+  auto factories = engine::communication::getInMemoryAgentFactory(2);
+  setupRealBackend<0, 1>(*factories[0], *factories[1]);
+
+  auto factory0 = std::make_unique<SinglePointArrayGeneratorFactory>(
+      true,
+      std::make_unique<ObliviousDeltaCalculatorFactory<0>>(true, 0, 1),
+      /*halfTree*/ true);
+  auto factory1 = std::make_unique<SinglePointArrayGeneratorFactory>(
+      false,
+      std::make_unique<ObliviousDeltaCalculatorFactory<1>>(false, 0, 1),
+      /*halfTree*/ true);
+  testSinglePointArrayGenerator(std::move(factory0), std::move(factory1));
+}
+
 } // namespace fbpcf::mpc_std_lib::oram
@@ -232,22 +232,55 @@ class MpcAdapters<AggregationValue, schedulerId> {
       const SecBatchType& src1,
       const SecBatchType& src2,
       frontend::Bit<true, schedulerId, true> indicator) {
-    SecretAggregationValue<schedulerId> rst1;
-    SecretAggregationValue<schedulerId> rst2;
-    rst1.conversionCount =
-        src1.conversionCount.mux(indicator, src2.conversionCount);
-    rst1.conversionValue =
-        src1.conversionValue.mux(indicator, src2.conversionValue);
+    return obliviousSwap(std::vector<SecBatchType>{src1}, src2, indicator)
+        .at(0);
+  }
 
-    for (size_t i = 0; i < Adapters<AggregationValue>::countWidth; i++) {
-      rst2.conversionCount[i] = rst1.conversionCount[i] ^
-          src1.conversionCount[i] ^ src2.conversionCount[i];
+  static std::vector<std::pair<SecBatchType, SecBatchType>> obliviousSwap(
+      const std::vector<SecBatchType>& src1,
+      const SecBatchType& src2,
+      frontend::Bit<true, schedulerId, true> indicator) {
+    const size_t countWidth = Adapters<AggregationValue>::countWidth;
+    const size_t valueWidth = Adapters<AggregationValue>::valueWidth;
+
+    // indicator & (src1 ^ src2) is all we need to swap the values, the count
+    // and value bits go into the same composite AND.
+    std::vector<frontend::Bit<true, schedulerId, true>> differences;
+    differences.reserve(src1.size() * (countWidth + valueWidth));
+    for (auto& item : src1) {
+      for (size_t i = 0; i < countWidth; i++) {
+        differences.push_back(
+            item.conversionCount[i] ^ src2.conversionCount[i]);
+      }
+      for (size_t i = 0; i < valueWidth; i++) {
+        differences.push_back(
+            item.conversionValue[i] ^ src2.conversionValue[i]);
+      }
     }
-    for (size_t i = 0; i < Adapters<AggregationValue>::valueWidth; i++) {
-      rst2.conversionValue[i] = rst1.conversionValue[i] ^
-          src1.conversionValue[i] ^ src2.conversionValue[i];
+    auto selected = indicator.compositeAND(differences);
+
+    std::vector<std::pair<SecBatchType, SecBatchType>> rst;
+    size_t index = 0;
+    for (auto& item : src1) {
+      SecretAggregationValue<schedulerId> rst1;
+      SecretAggregationValue<schedulerId> rst2;
+      for (size_t i = 0; i < countWidth; i++) {
+        rst1.conversionCount[i] =
+            item.conversionCount[i] ^ selected.at(index);
+        rst2.conversionCount[i] =
+            src2.conversionCount[i] ^ selected.at(index);
+        index++;
+      }
+      for (size_t i = 0; i < valueWidth; i++) {
+        rst1.conversionValue[i] =
+            item.conversionValue[i] ^ selected.at(index);
+        rst2.conversionValue[i] =
+            src2.conversionValue[i] ^ selected.at(index);
+        index++;
+      }
+      rst.push_back({std::move(rst1), std::move(rst2)});
     }
-    return {rst1, rst2};
+    return rst;
   }
 
   static std::vector<AggregationValue> openToParty(
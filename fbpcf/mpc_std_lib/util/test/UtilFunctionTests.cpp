@@ -17,8 +17,11 @@
 #include <random>
 
 #include "fbpcf/engine/util/util.h"
+#include "fbpcf/frontend/Bit.h"
 #include "fbpcf/mpc_std_lib/util/test/util.h"
 #include "fbpcf/mpc_std_lib/util/util.h"
+#include "fbpcf/scheduler/PlaintextScheduler.h"
+#include "fbpcf/scheduler/WireKeeper.h"
 
 namespace fbpcf::mpc_std_lib::util {
 
@@ -49,4 +52,61 @@ TEST(ConvertingBitsTest, testConvertingBitsForM128iVector) {
   testEq(v, convertedV);
 }
 
+template <typename T>
+void testObliviousSwap() {
+  std::random_device rd;
+  std::mt19937_64 e(rd());
+  std::uniform_int_distribution<uint8_t> randomBit(0, 1);
+  const size_t batchSize = 16;
+  const size_t numberOfItems = 5;
+
+  scheduler::SchedulerKeeper<0>::setScheduler(
+      std::make_unique<scheduler::PlaintextScheduler>(
+          scheduler::WireKeeper::createWithUnorderedMap()));
+  {
+    std::vector<std::vector<T>> values1(numberOfItems, std::vector<T>());
+    std::vector<T> values2;
+    std::vector<bool> indicator;
+    for (size_t i = 0; i < batchSize; i++) {
+      for (auto& item : values1) {
+        item.push_back(std::get<0>(getRandomData<T>(e)));
+      }
+      values2.push_back(std::get<0>(getRandomData<T>(e)));
+      indicator.push_back(randomBit(e));
+    }
+
+    std::vector<typename MpcAdapters<T, 0>::SecBatchType> src1;
+    for (auto& item : values1) {
+      src1.push_back(MpcAdapters<T, 0>::processSecretInputs(item, 0));
+    }
+    auto src2 = MpcAdapters<T, 0>::processSecretInputs(values2, 0);
+    frontend::Bit<true, 0, true> secIndicator(indicator, 0);
+
+    auto swapped = MpcAdapters<T, 0>::obliviousSwap(src1, src2, secIndicator);
+    ASSERT_EQ(swapped.size(), numberOfItems);
+    for (size_t i = 0; i < numberOfItems; i++) {
+      auto [single1, single2] =
+          MpcAdapters<T, 0>::obliviousSwap(src1.at(i), src2, secIndicator);
+      auto rst1 = MpcAdapters<T, 0>::openToParty(swapped.at(i).first, 0);
+      auto rst2 = MpcAdapters<T, 0>::openToParty(swapped.at(i).second, 0);
+      auto singleRst1 = MpcAdapters<T, 0>::openToParty(single1, 0);
+      auto singleRst2 = MpcAdapters<T, 0>::openToParty(single2, 0);
+      for (size_t j = 0; j < batchSize; j++) {
+        auto expected1 = indicator.at(j) ? values2.at(j) : values1.at(i).at(j);
+        auto expected2 = indicator.at(j) ? values1.at(i).at(j) : values2.at(j);
+        EXPECT_EQ(rst1.at(j), expected1);
+        EXPECT_EQ(rst2.at(j), expected2);
+        EXPECT_EQ(singleRst1.at(j), expected1);
+        EXPECT_EQ(singleRst2.at(j), expected2);
+      }
+    }
+  }
+  scheduler::SchedulerKeeper<0>::freeScheduler();
+}
+
+TEST(ObliviousSwapTest, testObliviousSwap) {
+  testObliviousSwap<uint32_t>();
+  testObliviousSwap<AggregationValue>();
+}
+
 } // namespace fbpcf::mpc_std_lib::util
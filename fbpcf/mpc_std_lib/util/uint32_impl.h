@@ -72,6 +72,11 @@ class MpcAdapters<uint32_t, schedulerId> {
       const SecBatchType& src2,
       frontend::Bit<true, schedulerId, true> indicator);
 
+  static std::vector<std::pair<SecBatchType, SecBatchType>> obliviousSwap(
+      const std::vector<SecBatchType>& src1,
+      const SecBatchType& src2,
+      frontend::Bit<true, schedulerId, true> indicator);
+
   static std::vector<uint32_t> openToParty(
       const SecBatchType& src,
       int partyId) {
@@ -114,12 +119,40 @@ MpcAdapters<uint32_t, schedulerId>::obliviousSwap(
     const SecBatchType& src1,
     const SecBatchType& src2,
     frontend::Bit<true, schedulerId, true> indicator) {
-  auto rst1 = src1.mux(indicator, src2);
-  auto rst2 = rst1;
-  for (size_t i = 0; i < widthForUint32; i++) {
-    rst2[i] = rst2[i] ^ src1[i] ^ src2[i];
+  return obliviousSwap(std::vector<SecBatchType>{src1}, src2, indicator).at(0);
+}
+
+template <int schedulerId>
+std::vector<std::pair<
+    typename MpcAdapters<uint32_t, schedulerId>::SecBatchType,
+    typename MpcAdapters<uint32_t, schedulerId>::SecBatchType>>
+MpcAdapters<uint32_t, schedulerId>::obliviousSwap(
+    const std::vector<SecBatchType>& src1,
+    const SecBatchType& src2,
+    frontend::Bit<true, schedulerId, true> indicator) {
+  // indicator & (src1 ^ src2) is all we need to swap the values.
+  std::vector<frontend::Bit<true, schedulerId, true>> differences;
+  differences.reserve(src1.size() * widthForUint32);
+  for (auto& item : src1) {
+    for (size_t i = 0; i < widthForUint32; i++) {
+      differences.push_back(item[i] ^ src2[i]);
+    }
+  }
+  auto selected = indicator.compositeAND(differences);
+
+  std::vector<std::pair<SecBatchType, SecBatchType>> rst;
+  size_t index = 0;
+  for (auto& item : src1) {
+    SecBatchType rst1;
+    SecBatchType rst2;
+    for (size_t i = 0; i < widthForUint32; i++) {
+      rst1[i] = item[i] ^ selected.at(index);
+      rst2[i] = src2[i] ^ selected.at(index);
+      index++;
+    }
+    rst.push_back({std::move(rst1), std::move(rst2)});
   }
-  return {rst1, rst2};
+  return rst;
 }
 
 } // namespace fbpcf::mpc_std_lib::util
@@ -54,6 +54,14 @@ class MpcAdapters {
       const SecBatchType& src2,
       frontend::Bit<true, schedulerId, true> indicator);
 
+  // swap each item in src1 with src2 under the same indicator, i.e. the same
+  // as calling obliviousSwap(src1[i], src2, indicator) for every i. All the
+  // swaps share a single composite AND gate.
+  static std::vector<std::pair<SecBatchType, SecBatchType>> obliviousSwap(
+      const std::vector<SecBatchType>& src1,
+      const SecBatchType& src2,
+      frontend::Bit<true, schedulerId, true> indicator);
+
   static std::vector<T> openToParty(const SecBatchType& src, int partyId);
 };
 
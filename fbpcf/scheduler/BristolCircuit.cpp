@@ -0,0 +1,493 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "fbpcf/scheduler/BristolCircuit.h"
+
+#include <algorithm>
+#include <fstream>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+
+namespace fbpcf::scheduler {
+
+namespace {
+
+using WireId = IScheduler::WireId<IScheduler::Boolean>;
+
+const uint32_t kNotUsed = std::numeric_limits<uint32_t>::max();
+
+std::string getOperationName(BristolCircuit::Operation operation) {
+  switch (operation) {
+    case BristolCircuit::Operation::XOR:
+      return "XOR";
+    case BristolCircuit::Operation::AND:
+      return "AND";
+    case BristolCircuit::Operation::INV:
+      return "INV";
+    case BristolCircuit::Operation::EQ:
+      return "EQ";
+    case BristolCircuit::Operation::EQW:
+      return "EQW";
+    case BristolCircuit::Operation::MAND:
+      return "MAND";
+  }
+  throw std::invalid_argument("Unknown Bristol operation.");
+}
+
+BristolCircuit::Operation getOperation(const std::string& name) {
+  for (auto operation :
+       {BristolCircuit::Operation::XOR,
+        BristolCircuit::Operation::AND,
+        BristolCircuit::Operation::INV,
+        BristolCircuit::Operation::EQ,
+        BristolCircuit::Operation::EQW,
+        BristolCircuit::Operation::MAND}) {
+    if (getOperationName(operation) == name) {
+      return operation;
+    }
+  }
+  throw std::invalid_argument("Unknown Bristol operation: " + name);
+}
+
+bool hasValidArity(const BristolCircuit::Gate& gate) {
+  switch (gate.operation) {
+    case BristolCircuit::Operation::XOR:
+    case BristolCircuit::Operation::AND:
+      return gate.inputs.size() == 2 && gate.outputs.size() == 1;
+    case BristolCircuit::Operation::INV:
+    case BristolCircuit::Operation::EQ:
+    case BristolCircuit::Operation::EQW:
+      return gate.inputs.size() == 1 && gate.outputs.size() == 1;
+    case BristolCircuit::Operation::MAND:
+      return !gate.outputs.empty() &&
+          gate.inputs.size() == 2 * gate.outputs.size();
+  }
+  return false;
+}
+
+uint32_t sum(const std::vector<uint32_t>& sizes) {
+  return std::accumulate(sizes.begin(), sizes.end(), uint64_t(0));
+}
+
+std::vector<uint32_t> readSizes(std::istream& in) {
+  uint32_t numberOfValues = 0;
+  in >> numberOfValues;
+  std::vector<uint32_t> sizes(numberOfValues);
+  for (auto& size : sizes) {
+    in >> size;
+  }
+  return sizes;
+}
+
+void writeSizes(std::ostream& out, const std::vector<uint32_t>& sizes) {
+  out << sizes.size();
+  for (auto size : sizes) {
+    out << " " << size;
+  }
+  out << "\n";
+}
+
+} // namespace
+
+BristolCircuit::BristolCircuit(
+    uint32_t numberOfWires,
+    std::vector<uint32_t> inputSizes,
+    std::vector<uint32_t> outputSizes,
+    std::vector<Gate> gates)
+    : numberOfWires_{numberOfWires},
+      inputSizes_{std::move(inputSizes)},
+      outputSizes_{std::move(outputSizes)},
+      numberOfInputWires_{sum(inputSizes_)},
+      numberOfOutputWires_{sum(outputSizes_)},
+      gates_{std::move(gates)},
+      isConstant_(numberOfWires, false),
+      lastUse_(numberOfWires, kNotUsed) {
+  if (numberOfInputWires_ > numberOfWires_ ||
+      numberOfOutputWires_ > numberOfWires_) {
+    throw std::invalid_argument(
+        "The circuit has more inputs or outputs than wires.");
+  }
+
+  std::vector<bool> isSet(numberOfWires_, false);
+  std::fill(isSet.begin(), isSet.begin() + numberOfInputWires_, true);
+  for (uint32_t i = 0; i < gates_.size(); i++) {
+    auto& gate = gates_.at(i);
+    if (!hasValidArity(gate)) {
+      throw std::invalid_argument(
+          "Gate " + std::to_string(i) + " has a wrong number of wires.");
+    }
+    bool isConstant = true;
+    if (gate.operation == Operation::EQ) {
+      if (gate.inputs.at(0) > 1) {
+        throw std::invalid_argument(
+            "Gate " + std::to_string(i) + " sets a wire to a non-boolean.");
+      }
+    } else {
+      for (auto wire : gate.inputs) {
+        if (wire >= numberOfWires_ || !isSet.at(wire)) {
+          throw std::invalid_argument(
+              "Gate " + std::to_string(i) + " reads a wire that isn't set.");
+        }
+        isConstant = isConstant && isConstant_.at(wire);
+        lastUse_.at(wire) = i;
+      }
+    }
+    for (auto wire : gate.outputs) {
+      if (wire >= numberOfWires_ || isSet.at(wire)) {
+        throw std::invalid_argument(
+            "Gate " + std::to_string(i) + " sets a wire twice.");
+      }
+      isSet.at(wire) = true;
+      isConstant_.at(wire) = isConstant;
+    }
+  }
+
+  for (auto wire = numberOfWires_ - numberOfOutputWires_;
+       wire < numberOfWires_;
+       wire++) {
+    if (!isSet.at(wire)) {
+      throw std::invalid_argument("An output of the circuit isn't set.");
+    }
+    if (isConstant_.at(wire)) {
+      throw std::invalid_argument(
+          "An output of the circuit doesn't depend on its inputs.");
+    }
+    lastUse_.at(wire) = gates_.size();
+  }
+}
+
+BristolCircuit BristolCircuit::read(std::istream& in) {
+  uint32_t numberOfGates = 0;
+  uint32_t numberOfWires = 0;
+  in >> numberOfGates >> numberOfWires;
+  auto inputSizes = readSizes(in);
+  auto outputSizes = readSizes(in);
+  if (in.fail()) {
+    throw std::invalid_argument("Malformed header of the Bristol circuit.");
+  }
+
+  std::vector<Gate> gates(numberOfGates);
+  for (auto& gate : gates) {
+    size_t numberOfInputs = 0;
+    size_t numberOfOutputs = 0;
+    in >> numberOfInputs >> numberOfOutputs;
+    // no gate reads more than twice as many wires as it sets
+    if (in.fail() || numberOfOutputs > numberOfWires ||
+        numberOfInputs > 2 * numberOfOutputs) {
+      throw std::invalid_argument("Malformed gate in the Bristol circuit.");
+    }
+    gate.inputs.resize(numberOfInputs);
+    gate.outputs.resize(numberOfOutputs);
+    for (auto& wire : gate.inputs) {
+      in >> wire;
+    }
+    for (auto& wire : gate.outputs) {
+      in >> wire;
+    }
+    std::string operation;
+    in >> operation;
+    if (in.fail()) {
+      throw std::invalid_argument("Malformed gate in the Bristol circuit.");
+    }
+    gate.operation = getOperation(operation);
+  }
+
+  return BristolCircuit(
+      numberOfWires,
+      std::move(inputSizes),
+      std::move(outputSizes),
+      std::move(gates));
+}
+
+BristolCircuit BristolCircuit::readFromFile(const std::string& path) {
+  std::ifstream in(path);
+  if (!in.is_open()) {
+    throw std::runtime_error("Can't open " + path);
+  }
+  return read(in);
+}
+
+BristolCircuit BristolCircuit::fromCircuit(
+    const Circuit& circuit,
+    std::vector<uint32_t> inputSizes,
+    std::vector<uint32_t> outputSizes) {
+  auto numberOfInputs = circuit.getNumberOfInputs();
+  auto& outputs = circuit.getOutputs();
+  if (inputSizes.empty()) {
+    inputSizes = {numberOfInputs};
+  }
+  if (outputSizes.empty()) {
+    outputSizes = {static_cast<uint32_t>(outputs.size())};
+  }
+  if (sum(inputSizes) != numberOfInputs || sum(outputSizes) != outputs.size()) {
+    throw std::invalid_argument(
+        "The sizes of the values don't match the inputs and outputs.");
+  }
+
+  // The outputs have to be the last wires: the gate setting an output is
+  // given its wire there, outputs that are inputs or repeated are copied to
+  // their wires with EQW gates at the end.
+  auto& circuitGates = circuit.getGates();
+  std::vector<uint32_t> copiedOutputs;
+  std::vector<uint32_t> outputIndexes(circuit.getNumberOfWires(), kNotUsed);
+  for (uint32_t i = 0; i < outputs.size(); i++) {
+    auto wire = outputs.at(i);
+    if (wire < numberOfInputs || outputIndexes.at(wire) != kNotUsed) {
+      copiedOutputs.push_back(i);
+    } else {
+      outputIndexes.at(wire) = i;
+    }
+  }
+  uint32_t numberOfWires =
+      numberOfInputs + circuitGates.size() + copiedOutputs.size();
+  uint32_t firstOutputWire = numberOfWires - outputs.size();
+
+  std::vector<uint32_t> wires(circuit.getNumberOfWires());
+  std::iota(wires.begin(), wires.begin() + numberOfInputs, 0);
+  uint32_t nextWire = numberOfInputs;
+  for (uint32_t i = numberOfInputs; i < wires.size(); i++) {
+    wires.at(i) = outputIndexes.at(i) == kNotUsed
+        ? nextWire++
+        : firstOutputWire + outputIndexes.at(i);
+  }
+
+  std::vector<Gate> gates;
+  gates.reserve(circuitGates.size() + copiedOutputs.size());
+  for (uint32_t i = 0; i < circuitGates.size(); i++) {
+    auto& circuitGate = circuitGates.at(i);
+    Gate gate{Operation::XOR, {}, {wires.at(numberOfInputs + i)}};
+    switch (circuitGate.gateType) {
+      case Circuit::GateType::AsymmetricXOR:
+      case Circuit::GateType::SymmetricXOR:
+        gate.operation = Operation::XOR;
+        gate.inputs = {
+            wires.at(circuitGate.left), wires.at(circuitGate.right)};
+        break;
+
+      case Circuit::GateType::FreeAnd:
+      case Circuit::GateType::NonFreeAnd:
+        gate.operation = Operation::AND;
+        gate.inputs = {
+            wires.at(circuitGate.left), wires.at(circuitGate.right)};
+        break;
+
+      case Circuit::GateType::AsymmetricNot:
+      case Circuit::GateType::SymmetricNot:
+        gate.operation = Operation::INV;
+        gate.inputs = {wires.at(circuitGate.left)};
+        break;
+
+      case Circuit::GateType::Input: {
+        auto& constant = circuit.getConstant(circuitGate.constant);
+        if (constant.empty() ||
+            std::find(constant.begin(), constant.end(), !constant.at(0)) !=
+                constant.end()) {
+          throw std::invalid_argument(
+              "A batch constant differs between rows.");
+        }
+        gate.operation = Operation::EQ;
+        gate.inputs = {constant.at(0)};
+        break;
+      }
+
+      default:
+        throw std::invalid_argument(
+            "Bristol circuits only have XOR, AND and NOT gates.");
+    }
+    gates.push_back(std::move(gate));
+  }
+  for (auto i : copiedOutputs) {
+    gates.push_back(Gate{
+        Operation::EQW, {wires.at(outputs.at(i))}, {firstOutputWire + i}});
+  }
+
+  return BristolCircuit(
+      numberOfWires,
+      std::move(inputSizes),
+      std::move(outputSizes),
+      std::move(gates));
+}
+
+void BristolCircuit::write(std::ostream& out) const {
+  out << gates_.size() << " " << numberOfWires_ << "\n";
+  writeSizes(out, inputSizes_);
+  writeSizes(out, outputSizes_);
+  out << "\n";
+  for (auto& gate : gates_) {
+    out << gate.inputs.size() << " " << gate.outputs.size();
+    for (auto wire : gate.inputs) {
+      out << " " << wire;
+    }
+    for (auto wire : gate.outputs) {
+      out << " " << wire;
+    }
+    out << " " << getOperationName(gate.operation) << "\n";
+  }
+}
+
+void BristolCircuit::writeToFile(const std::string& path) const {
+  std::ofstream out(path);
+  if (!out.is_open()) {
+    throw std::runtime_error("Can't open " + path);
+  }
+  write(out);
+}
+
+std::vector<WireId> BristolCircuit::evaluate(
+    IScheduler& scheduler,
+    const std::vector<WireId>& inputs) const {
+  return evaluate</*usingBatch*/ false>(scheduler, inputs, 1);
+}
+
+std::vector<WireId> BristolCircuit::evaluateBatch(
+    IScheduler& scheduler,
+    const std::vector<WireId>& inputs,
+    size_t batchSize) const {
+  return evaluate</*usingBatch*/ true>(scheduler, inputs, batchSize);
+}
+
+uint64_t BristolCircuit::getNumberOfAndGates() const {
+  uint64_t numberOfAndGates = 0;
+  for (auto& gate : gates_) {
+    if (gate.operation == Operation::AND ||
+        gate.operation == Operation::MAND) {
+      numberOfAndGates += gate.outputs.size();
+    }
+  }
+  return numberOfAndGates;
+}
+
+template <bool usingBatch>
+std::vector<WireId> BristolCircuit::evaluate(
+    IScheduler& scheduler,
+    const std::vector<WireId>& inputs,
+    size_t batchSize) const {
+  if (inputs.size() != numberOfInputWires_) {
+    throw std::invalid_argument(
+        "The circuit takes " + std::to_string(numberOfInputWires_) +
+        " input wires.");
+  }
+
+  std::vector<WireId> wires(numberOfWires_);
+  auto increaseReferenceCount = [&scheduler](WireId wire) {
+    if constexpr (usingBatch) {
+      scheduler.increaseReferenceCountBatch(wire);
+    } else {
+      scheduler.increaseReferenceCount(wire);
+    }
+  };
+  // release the wires that are no longer read after the gate at this index
+  auto release = [this, &scheduler, &wires](
+                     const std::vector<uint32_t>& gateWires, uint32_t index) {
+    for (auto wire : gateWires) {
+      if (lastUse_.at(wire) == index && !wires.at(wire).isEmpty()) {
+        if constexpr (usingBatch) {
+          scheduler.decreaseReferenceCountBatch(wires.at(wire));
+        } else {
+          scheduler.decreaseReferenceCount(wires.at(wire));
+        }
+        wires.at(wire) = WireId();
+      }
+    }
+  };
+
+  auto computeXOR = [&](uint32_t left, uint32_t right) {
+    if (isConstant_.at(left) && isConstant_.at(right)) {
+      return usingBatch
+          ? scheduler.publicXorPublicBatch(wires.at(left), wires.at(right))
+          : scheduler.publicXorPublic(wires.at(left), wires.at(right));
+    } else if (isConstant_.at(left) || isConstant_.at(right)) {
+      if (isConstant_.at(left)) {
+        std::swap(left, right);
+      }
+      return usingBatch
+          ? scheduler.privateXorPublicBatch(wires.at(left), wires.at(right))
+          : scheduler.privateXorPublic(wires.at(left), wires.at(right));
+    } else {
+      return usingBatch
+          ? scheduler.privateXorPrivateBatch(wires.at(left), wires.at(right))
+          : scheduler.privateXorPrivate(wires.at(left), wires.at(right));
+    }
+  };
+  auto computeAND = [&](uint32_t left, uint32_t right) {
+    if (isConstant_.at(left) && isConstant_.at(right)) {
+      return usingBatch
+          ? scheduler.publicAndPublicBatch(wires.at(left), wires.at(right))
+          : scheduler.publicAndPublic(wires.at(left), wires.at(right));
+    } else if (isConstant_.at(left) || isConstant_.at(right)) {
+      if (isConstant_.at(left)) {
+        std::swap(left, right);
+      }
+      return usingBatch
+          ? scheduler.privateAndPublicBatch(wires.at(left), wires.at(right))
+          : scheduler.privateAndPublic(wires.at(left), wires.at(right));
+    } else {
+      return usingBatch
+          ? scheduler.privateAndPrivateBatch(wires.at(left), wires.at(right))
+          : scheduler.privateAndPrivate(wires.at(left), wires.at(right));
+    }
+  };
+  auto computeINV = [&](uint32_t src) {
+    if (isConstant_.at(src)) {
+      return usingBatch ? scheduler.notPublicBatch(wires.at(src))
+                        : scheduler.notPublic(wires.at(src));
+    } else {
+      return usingBatch ? scheduler.notPrivateBatch(wires.at(src))
+                        : scheduler.notPrivate(wires.at(src));
+    }
+  };
+  auto computeEQ = [&scheduler, batchSize](bool v) {
+    return usingBatch
+        ? scheduler.publicBooleanInputBatch(std::vector<bool>(batchSize, v))
+        : scheduler.publicBooleanInput(v);
+  };
+
+  for (uint32_t i = 0; i < numberOfInputWires_; i++) {
+    wires.at(i) = inputs.at(i);
+    increaseReferenceCount(wires.at(i));
+    release({i}, kNotUsed);
+  }
+
+  for (uint32_t i = 0; i < gates_.size(); i++) {
+    auto& gate = gates_.at(i);
+    auto& in = gate.inputs;
+    auto& out = gate.outputs;
+    switch (gate.operation) {
+      case Operation::XOR:
+        wires.at(out.at(0)) = computeXOR(in.at(0), in.at(1));
+        break;
+      case Operation::AND:
+        wires.at(out.at(0)) = computeAND(in.at(0), in.at(1));
+        break;
+      case Operation::INV:
+        wires.at(out.at(0)) = computeINV(in.at(0));
+        break;
+      case Operation::EQ:
+        wires.at(out.at(0)) = computeEQ(in.at(0));
+        break;
+      case Operation::EQW:
+        wires.at(out.at(0)) = wires.at(in.at(0));
+        increaseReferenceCount(wires.at(out.at(0)));
+        break;
+      case Operation::MAND:
+        for (size_t j = 0; j < out.size(); j++) {
+          wires.at(out.at(j)) = computeAND(in.at(j), in.at(j + out.size()));
+        }
+        break;
+    }
+    if (gate.operation != Operation::EQ) {
+      release(in, i);
+    }
+    release(out, kNotUsed);
+  }
+
+  return std::vector<WireId>(
+      wires.end() - numberOfOutputWires_, wires.end());
+}
+
+} // namespace fbpcf::scheduler
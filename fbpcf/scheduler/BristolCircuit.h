@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "fbpcf/scheduler/IScheduler.h"
+#include "fbpcf/scheduler/gate_keeper/Circuit.h"
+
+namespace fbpcf::scheduler {
+
+/**
+ * A boolean circuit in the Bristol Fashion format, the format most published
+ * optimized circuits (AES, SHA-256, adders, comparators...) are distributed
+ * in. A file starts with the number of gates and wires, the number and sizes
+ * of the input values and the number and sizes of the output values, followed
+ * by one gate per line:
+ *
+ *   <#inputs> <#outputs> <input wires...> <output wires...> <operation>
+ *
+ * The input values take the first wires in order and the output values take
+ * the last ones. A circuit can be evaluated on secret-shared wires through any
+ * IScheduler, and a circuit recorded by a gate keeper can be exported so that
+ * it can be optimized by external synthesis tools.
+ */
+class BristolCircuit {
+ public:
+  enum class Operation {
+    XOR,
+    AND,
+    INV,
+    // the "input" of an EQ gate is the constant it sets its output to
+    EQ,
+    EQW,
+    // the n / 2 outputs are the AND of the inputs i and i + n / 2
+    MAND,
+  };
+
+  struct Gate {
+    Operation operation;
+    std::vector<uint32_t> inputs;
+    std::vector<uint32_t> outputs;
+  };
+
+  /**
+   * Create a circuit, throw std::invalid_argument if the gates aren't in a
+   * topological order (every wire is set once, before it is read) or if an
+   * output doesn't depend on the inputs.
+   */
+  BristolCircuit(
+      uint32_t numberOfWires,
+      std::vector<uint32_t> inputSizes,
+      std::vector<uint32_t> outputSizes,
+      std::vector<Gate> gates);
+
+  /**
+   * Parse a circuit in Bristol Fashion, throw std::invalid_argument if it is
+   * malformed.
+   */
+  static BristolCircuit read(std::istream& in);
+
+  static BristolCircuit readFromFile(const std::string& path);
+
+  /**
+   * Convert a circuit recorded by a gate keeper, whose inputs are split into
+   * values of inputSizes bits and whose outputs are split into values of
+   * outputSizes bits. An empty list of sizes means a single value. Throw
+   * std::invalid_argument if the circuit reveals values to a party or uses a
+   * batch constant that isn't the same for every row, as Bristol circuits
+   * can't express those.
+   */
+  static BristolCircuit fromCircuit(
+      const Circuit& circuit,
+      std::vector<uint32_t> inputSizes = {},
+      std::vector<uint32_t> outputSizes = {});
+
+  void write(std::ostream& out) const;
+
+  void writeToFile(const std::string& path) const;
+
+  /**
+   * Add the gates of this circuit to a scheduler, with the given input wires
+   * in the order of the input values, and return the output wires in the
+   * order of the output values. The caller keeps its references to the inputs
+   * and owns one reference to each output.
+   */
+  std::vector<IScheduler::WireId<IScheduler::Boolean>> evaluate(
+      IScheduler& scheduler,
+      const std::vector<IScheduler::WireId<IScheduler::Boolean>>& inputs)
+      const;
+
+  /**
+   * Same as evaluate() on batch wires, constants are expanded to batchSize
+   * rows.
+   */
+  std::vector<IScheduler::WireId<IScheduler::Boolean>> evaluateBatch(
+      IScheduler& scheduler,
+      const std::vector<IScheduler::WireId<IScheduler::Boolean>>& inputs,
+      size_t batchSize) const;
+
+  uint32_t getNumberOfWires() const {
+    return numberOfWires_;
+  }
+
+  const std::vector<uint32_t>& getInputSizes() const {
+    return inputSizes_;
+  }
+
+  const std::vector<uint32_t>& getOutputSizes() const {
+    return outputSizes_;
+  }
+
+  uint32_t getNumberOfInputWires() const {
+    return numberOfInputWires_;
+  }
+
+  uint32_t getNumberOfOutputWires() const {
+    return numberOfOutputWires_;
+  }
+
+  const std::vector<Gate>& getGates() const {
+    return gates_;
+  }
+
+  // The number of AND gates, i.e. the gates that need communication, where a
+  // MAND gate counts as one AND per output.
+  uint64_t getNumberOfAndGates() const;
+
+ private:
+  template <bool usingBatch>
+  std::vector<IScheduler::WireId<IScheduler::Boolean>> evaluate(
+      IScheduler& scheduler,
+      const std::vector<IScheduler::WireId<IScheduler::Boolean>>& inputs,
+      size_t batchSize) const;
+
+  uint32_t numberOfWires_;
+  std::vector<uint32_t> inputSizes_;
+  std::vector<uint32_t> outputSizes_;
+  uint32_t numberOfInputWires_;
+  uint32_t numberOfOutputWires_;
+  std::vector<Gate> gates_;
+
+  // whether a wire only depends on constants, it is then a public wire
+  std::vector<bool> isConstant_;
+  // the index of the last gate reading a wire, or the number of gates for the
+  // outputs, so that wires can be released as soon as possible
+  std::vector<uint32_t> lastUse_;
+};
+
+} // namespace fbpcf::scheduler
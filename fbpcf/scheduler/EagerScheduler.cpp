@@ -166,42 +166,68 @@ std::vector<IScheduler::WireId<IScheduler::Boolean>>
 EagerScheduler::privateAndPrivateComposite(
     IScheduler::WireId<IScheduler::Boolean> left,
     std::vector<IScheduler::WireId<IScheduler::Boolean>> rights) {
-  throw std::runtime_error("Not implemented");
+  nonFreeGates_ += rights.size();
+  std::vector<bool> rightValues;
+  for (auto rightWire : rights) {
+    rightValues.push_back(wireKeeper_->getBooleanValue(rightWire));
+  }
+  auto index = engine_->scheduleCompositeAND(
+      wireKeeper_->getBooleanValue(left), rightValues);
+  engine_->executeScheduledAND();
+
+  std::vector<IScheduler::WireId<IScheduler::Boolean>> rst;
+  for (auto value : engine_->getCompositeANDExecutionResult(index)) {
+    rst.push_back(wireKeeper_->allocateBooleanValue(value));
+  }
+  return rst;
 }
 
 std::vector<IScheduler::WireId<IScheduler::Boolean>>
 EagerScheduler::privateAndPrivateCompositeBatch(
     IScheduler::WireId<IScheduler::Boolean> left,
     std::vector<IScheduler::WireId<IScheduler::Boolean>> rights) {
-  throw std::runtime_error("Not implemented");
+  auto leftValue = wireKeeper_->getBatchBooleanValue(left);
+  std::vector<std::vector<bool>> rightValues;
+  for (auto rightWire : rights) {
+    rightValues.push_back(wireKeeper_->getBatchBooleanValue(rightWire));
+  }
+  nonFreeGates_ += leftValue.size() * rights.size();
+  auto index = engine_->scheduleBatchCompositeAND(leftValue, rightValues);
+  engine_->executeScheduledAND();
+
+  std::vector<IScheduler::WireId<IScheduler::Boolean>> rst;
+  for (auto& value : engine_->getBatchCompositeANDExecutionResult(index)) {
+    rst.push_back(wireKeeper_->allocateBatchBooleanValue(value));
+  }
+  return rst;
 }
 
 std::vector<IScheduler::WireId<IScheduler::Boolean>>
 EagerScheduler::privateAndPublicComposite(
     IScheduler::WireId<IScheduler::Boolean> left,
     std::vector<IScheduler::WireId<IScheduler::Boolean>> rights) {
-  throw std::runtime_error("Not implemented");
+  return computeCompositeFreeAND(left, rights);
 }
 
 std::vector<IScheduler::WireId<IScheduler::Boolean>>
 EagerScheduler::privateAndPublicCompositeBatch(
     IScheduler::WireId<IScheduler::Boolean> left,
     std::vector<IScheduler::WireId<IScheduler::Boolean>> rights) {
-  throw std::runtime_error("Not implemented");
+  return computeBatchCompositeFreeAND(left, rights);
 }
 
 std::vector<IScheduler::WireId<IScheduler::Boolean>>
 EagerScheduler::publicAndPublicComposite(
     IScheduler::WireId<IScheduler::Boolean> left,
     std::vector<IScheduler::WireId<IScheduler::Boolean>> rights) {
-  throw std::runtime_error("Not implemented");
+  return computeCompositeFreeAND(left, rights);
 }
 
 std::vector<IScheduler::WireId<IScheduler::Boolean>>
 EagerScheduler::publicAndPublicCompositeBatch(
     IScheduler::WireId<IScheduler::Boolean> left,
     std::vector<IScheduler::WireId<IScheduler::Boolean>> rights) {
-  throw std::runtime_error("Not implemented");
+  return computeBatchCompositeFreeAND(left, rights);
 }
 
 IScheduler::WireId<IScheduler::Boolean> EagerScheduler::privateXorPrivate(
@@ -310,4 +336,33 @@ std::pair<uint64_t, uint64_t> EagerScheduler::getTrafficStatistics() const {
   return engine_->getTrafficStatistics();
 }
 
+std::vector<IScheduler::WireId<IScheduler::Boolean>>
+EagerScheduler::computeCompositeFreeAND(
+    IScheduler::WireId<IScheduler::Boolean> left,
+    const std::vector<IScheduler::WireId<IScheduler::Boolean>>& rights) {
+  freeGates_ += rights.size();
+  auto leftValue = wireKeeper_->getBooleanValue(left);
+  std::vector<IScheduler::WireId<IScheduler::Boolean>> rst;
+  for (auto rightWire : rights) {
+    rst.push_back(wireKeeper_->allocateBooleanValue(engine_->computeFreeAND(
+        leftValue, wireKeeper_->getBooleanValue(rightWire))));
+  }
+  return rst;
+}
+
+std::vector<IScheduler::WireId<IScheduler::Boolean>>
+EagerScheduler::computeBatchCompositeFreeAND(
+    IScheduler::WireId<IScheduler::Boolean> left,
+    const std::vector<IScheduler::WireId<IScheduler::Boolean>>& rights) {
+  auto leftValue = wireKeeper_->getBatchBooleanValue(left);
+  freeGates_ += leftValue.size() * rights.size();
+  std::vector<IScheduler::WireId<IScheduler::Boolean>> rst;
+  for (auto rightWire : rights) {
+    rst.push_back(
+        wireKeeper_->allocateBatchBooleanValue(engine_->computeBatchFreeAND(
+            leftValue, wireKeeper_->getBatchBooleanValue(rightWire))));
+  }
+  return rst;
+}
+
 } // namespace fbpcf::scheduler
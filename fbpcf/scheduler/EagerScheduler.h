@@ -7,6 +7,9 @@
 
 #pragma once
 
+#include <memory>
+#include <stdexcept>
+
 #include "fbpcf/engine/ISecretShareEngine.h"
 #include "fbpcf/scheduler/IScheduler.h"
 #include "fbpcf/scheduler/IWireKeeper.h"
@@ -279,6 +282,38 @@ class EagerScheduler final : public IScheduler {
    */
   void decreaseReferenceCountBatch(WireId<IScheduler::Boolean> id) override;
 
+  //======== Below are circuit recording APIs: ========
+
+  /**
+   * @inherit doc
+   */
+  void startRecording(
+      const std::vector<WireId<IScheduler::Boolean>>& /*inputs*/) override {}
+
+  /**
+   * @inherit doc
+   */
+  void startRecordingBatch(
+      const std::vector<WireId<IScheduler::Boolean>>& /*inputs*/) override {}
+
+  /**
+   * @inherit doc
+   */
+  std::shared_ptr<const Circuit> stopRecording(
+      const std::vector<WireId<IScheduler::Boolean>>& /*outputs*/) override {
+    // the gates are executed right away, there is nothing to record
+    return nullptr;
+  }
+
+  /**
+   * @inherit doc
+   */
+  std::vector<WireId<IScheduler::Boolean>> replayCircuit(
+      const Circuit& /*circuit*/,
+      const std::vector<WireId<IScheduler::Boolean>>& /*inputs*/) override {
+    throw std::runtime_error("This scheduler doesn't replay circuits.");
+  }
+
   //======== Below are miscellaneous APIs: ========
 
   /**
@@ -293,7 +328,37 @@ class EagerScheduler final : public IScheduler {
     return wireKeeper_->getWireStatistics();
   }
 
+  /**
+   * @inherit doc
+   */
+  std::pair<uint64_t, uint64_t> getPendingBytesStatistics() const override {
+    return {0, 0};
+  }
+
+  /**
+   * @inherit doc
+   */
+  std::pair<uint64_t, uint64_t> getEliminatedGateStatistics() const override {
+    return {0, 0};
+  }
+
+  /**
+   * @inherit doc
+   */
+  std::chrono::nanoseconds getTupleStarvationTime() const override {
+    return engine_->getTupleStarvationTime();
+  }
+
  private:
+  // AND a left value with each of the right values, without communication.
+  std::vector<WireId<IScheduler::Boolean>> computeCompositeFreeAND(
+      WireId<IScheduler::Boolean> left,
+      const std::vector<WireId<IScheduler::Boolean>>& rights);
+
+  std::vector<WireId<IScheduler::Boolean>> computeBatchCompositeFreeAND(
+      WireId<IScheduler::Boolean> left,
+      const std::vector<WireId<IScheduler::Boolean>>& rights);
+
   std::unique_ptr<engine::ISecretShareEngine> engine_;
   std::unique_ptr<IWireKeeper> wireKeeper_;
 };
@@ -251,6 +251,42 @@ class IArithmeticScheduler : public IScheduler {
   virtual WireId<IScheduler::Arithmetic> negPublicBatch(
       WireId<IScheduler::Arithmetic> src) = 0;
 
+  //======== Below are share conversion APIs: ========
+
+  /**
+   * Convert PRIVATE boolean wires, least significant bit first, to a PRIVATE
+   * integer wire storing sum_k 2^k * src[k] mod 2^64. This takes one round.
+   */
+  virtual WireId<IScheduler::Arithmetic> booleanToInteger(
+      const std::vector<WireId<IScheduler::Boolean>>& src) = 0;
+
+  /**
+   * same, except it process a batch of inputs. This could be useful when the
+   * application is a massive replications of a small function.
+   */
+  virtual WireId<IScheduler::Arithmetic> booleanToIntegerBatch(
+      const std::vector<WireId<IScheduler::Boolean>>& src) = 0;
+
+  /**
+   * Secret share the lowest width bits of both parties' shares of a PRIVATE
+   * integer wire as PRIVATE boolean wires, without communication. Return two
+   * summands, least significant bit first, that add up to the lowest width
+   * bits of the integer. Only two-party computation is supported.
+   */
+  virtual std::vector<std::vector<WireId<IScheduler::Boolean>>>
+  integerToBooleanSummands(
+      WireId<IScheduler::Arithmetic> src,
+      int8_t width) = 0;
+
+  /**
+   * same, except it process a batch of inputs. This could be useful when the
+   * application is a massive replications of a small function.
+   */
+  virtual std::vector<std::vector<WireId<IScheduler::Boolean>>>
+  integerToBooleanSummandsBatch(
+      WireId<IScheduler::Arithmetic> src,
+      int8_t width) = 0;
+
   //======== Below are wire management APIs: ========
 
   /**
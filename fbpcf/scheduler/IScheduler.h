@@ -7,12 +7,16 @@
 
 #pragma once
 
+#include <chrono>
 #include <cstdint>
 #include <memory>
 #include <optional>
 #include <vector>
 
 namespace fbpcf::scheduler {
+
+class Circuit;
+
 /**
  * A scheduler is the object that process all frontend computation.
  * It takes in computation requests from the frontend, (possibly passes these
@@ -338,6 +342,39 @@ class IScheduler {
    */
   virtual void decreaseReferenceCountBatch(WireId<Boolean> id) = 0;
 
+  //======== Below are circuit recording APIs: ========
+
+  /**
+   * Record the boolean gates added from now on into a circuit that reads the
+   * given wires. The gates are still evaluated as usual. This is useful to
+   * evaluate the same function on many inputs: the circuit is only built
+   * once, and then replayed. Only the normal boolean gates can be recorded.
+   */
+  virtual void startRecording(const std::vector<WireId<Boolean>>& inputs) = 0;
+
+  /**
+   * same, except the function is evaluated on batch wires.
+   */
+  virtual void startRecordingBatch(
+      const std::vector<WireId<Boolean>>& inputs) = 0;
+
+  /**
+   * Stop recording and return the circuit, whose outputs are the given wires.
+   * Schedulers that execute every gate right away don't record circuits,
+   * they return nullptr.
+   */
+  virtual std::shared_ptr<const Circuit> stopRecording(
+      const std::vector<WireId<Boolean>>& outputs) = 0;
+
+  /**
+   * Evaluate a recorded circuit on the given input wires and return its
+   * output wires. The reference count of each output wire is 1, as for the
+   * output of a gate.
+   */
+  virtual std::vector<WireId<Boolean>> replayCircuit(
+      const Circuit& circuit,
+      const std::vector<WireId<Boolean>>& inputs) = 0;
+
   //======== Below are miscellaneous APIs: ========
   /**
    * Get the total amount of traffic transmitted.
@@ -362,6 +399,34 @@ class IScheduler {
    */
   virtual std::pair<uint64_t, uint64_t> getWireStatistics() const = 0;
 
+  /**
+   * Get the amount of memory taken by the values of the wires whose gates
+   * haven't been executed yet. It is always 0 for schedulers that execute
+   * every gate right away.
+   * @return a pair of (current, peak) bytes.
+   */
+  virtual std::pair<uint64_t, uint64_t> getPendingBytesStatistics() const = 0;
+
+  /**
+   * Get the amount of gates that were never added to the circuit. Dead gates
+   * were free gates dropped before they were executed because nothing read
+   * their results, non-free gates are always executed since the other
+   * parties take part in them. Folded gates were free gates on public values
+   * that were known already, they were computed right away and are counted
+   * as free gates by getGateStatistics() too. It is always 0 for schedulers
+   * that execute every gate right away.
+   * @return a pair of (dead gates, folded gates).
+   */
+  virtual std::pair<uint64_t, uint64_t> getEliminatedGateStatistics()
+      const = 0;
+
+  /**
+   * Get how long the execution of AND gates was blocked waiting for the
+   * tuple generator, i.e. how long it was starved of tuples. It is always 0
+   * for schedulers that don't use tuples.
+   */
+  virtual std::chrono::nanoseconds getTupleStarvationTime() const = 0;
+
  protected:
   uint64_t nonFreeGates_ = 0;
   uint64_t freeGates_ = 0;
@@ -415,8 +480,20 @@ class SchedulerKeeper {
     return scheduler_->getWireStatistics();
   }
 
+  static std::pair<uint64_t, uint64_t> getPendingBytesStatistics() {
+    return scheduler_->getPendingBytesStatistics();
+  }
+
+  static std::pair<uint64_t, uint64_t> getEliminatedGateStatistics() {
+    return scheduler_->getEliminatedGateStatistics();
+  }
+
+  static std::chrono::nanoseconds getTupleStarvationTime() {
+    return scheduler_->getTupleStarvationTime();
+  }
+
  protected:
-  IScheduler& getScheduler() const {
+  static IScheduler& getScheduler() {
     return *scheduler_;
   }
 
@@ -85,6 +85,14 @@ class IWireKeeper {
   virtual void decreaseReferenceCount(
       IScheduler::WireId<IScheduler::Arithmetic> id) = 0;
 
+  // get the reference count on the wire with given id
+  virtual uint32_t getReferenceCount(
+      IScheduler::WireId<IScheduler::Boolean> id) const = 0;
+
+  // get the reference count on the wire with given id
+  virtual uint32_t getReferenceCount(
+      IScheduler::WireId<IScheduler::Arithmetic> id) const = 0;
+
   // create a boolean wire with values v, return its wire id.
   virtual IScheduler::WireId<IScheduler::Boolean> allocateBatchBooleanValue(
       const std::vector<bool>& v,
@@ -149,6 +157,14 @@ class IWireKeeper {
   virtual void decreaseBatchReferenceCount(
       IScheduler::WireId<IScheduler::Arithmetic> id) = 0;
 
+  // get the reference count on the wire with given id
+  virtual uint32_t getBatchReferenceCount(
+      IScheduler::WireId<IScheduler::Boolean> id) const = 0;
+
+  // get the reference count on the wire with given id
+  virtual uint32_t getBatchReferenceCount(
+      IScheduler::WireId<IScheduler::Arithmetic> id) const = 0;
+
   // Return a pair of the number of wires (allocated, deallocated).
   std::pair<uint64_t, uint64_t> getWireStatistics() const {
     return {wiresAllocated_, wiresDeallocated_};
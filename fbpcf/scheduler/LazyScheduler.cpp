@@ -7,12 +7,14 @@
 
 #include "fbpcf/scheduler/LazyScheduler.h"
 
+#include <algorithm>
 #include <exception>
 #include <map>
 #include <stdexcept>
 #include <string>
 
 #include "fbpcf/scheduler/IScheduler.h"
+#include "fbpcf/scheduler/gate_keeper/ICompositeGate.h"
 #include "fbpcf/scheduler/gate_keeper/IGate.h"
 #include "fbpcf/scheduler/gate_keeper/INormalGate.h"
 
@@ -21,10 +23,14 @@ namespace fbpcf::scheduler {
 LazyScheduler::LazyScheduler(
     std::unique_ptr<engine::ISecretShareEngine> engine,
     std::shared_ptr<IWireKeeper> wireKeeper,
-    std::unique_ptr<IGateKeeper> gateKeeper)
+    std::unique_ptr<IGateKeeper> gateKeeper,
+    bool pipelined,
+    std::shared_ptr<engine::util::ThreadPool> threadPool)
     : engine_{std::move(engine)},
       wireKeeper_{std::move(wireKeeper)},
-      gateKeeper_{std::move(gateKeeper)} {}
+      gateKeeper_{std::move(gateKeeper)},
+      pipelined_{pipelined},
+      threadPool_{std::move(threadPool)} {}
 
 IScheduler::WireId<IScheduler::Boolean> LazyScheduler::privateBooleanInput(
     bool v,
@@ -42,12 +48,12 @@ IScheduler::WireId<IScheduler::Boolean> LazyScheduler::privateBooleanInputBatch(
 
 IScheduler::WireId<IScheduler::Boolean> LazyScheduler::publicBooleanInput(
     bool v) {
-  return maybeExecuteGates(gateKeeper_->inputGate(v));
+  return maybeExecuteGates(gateKeeper_->publicInputGate(v));
 }
 
 IScheduler::WireId<IScheduler::Boolean> LazyScheduler::publicBooleanInputBatch(
     const std::vector<bool>& v) {
-  return maybeExecuteGates(gateKeeper_->inputGateBatch(v));
+  return maybeExecuteGates(gateKeeper_->publicInputGateBatch(v));
 }
 
 IScheduler::WireId<IScheduler::Boolean> LazyScheduler::recoverBooleanWire(
@@ -91,6 +97,76 @@ std::vector<bool> LazyScheduler::getBooleanValueBatch(
   return forceWire<true>(id);
 }
 
+IScheduler::WireId<IScheduler::Arithmetic> LazyScheduler::privateIntegerInput(
+    uint64_t v,
+    int partyId) {
+  return maybeExecuteGates(
+      gateKeeper_->integerInputGate(engine_->setIntegerInput(partyId, v)));
+}
+
+IScheduler::WireId<IScheduler::Arithmetic>
+LazyScheduler::privateIntegerInputBatch(
+    const std::vector<uint64_t>& v,
+    int partyId) {
+  return maybeExecuteGates(gateKeeper_->integerInputGateBatch(
+      engine_->setBatchIntegerInput(partyId, v)));
+}
+
+IScheduler::WireId<IScheduler::Arithmetic> LazyScheduler::publicIntegerInput(
+    uint64_t v) {
+  return maybeExecuteGates(gateKeeper_->integerInputGate(v));
+}
+
+IScheduler::WireId<IScheduler::Arithmetic>
+LazyScheduler::publicIntegerInputBatch(
+    const std::vector<uint64_t>& v) {
+  return maybeExecuteGates(gateKeeper_->integerInputGateBatch(v));
+}
+
+IScheduler::WireId<IScheduler::Arithmetic> LazyScheduler::recoverIntegerWire(
+    uint64_t v) {
+  return maybeExecuteGates(gateKeeper_->integerInputGate(v));
+}
+
+IScheduler::WireId<IScheduler::Arithmetic>
+LazyScheduler::recoverIntegerWireBatch(
+    const std::vector<uint64_t>& v) {
+  return maybeExecuteGates(gateKeeper_->integerInputGateBatch(v));
+}
+
+IScheduler::WireId<IScheduler::Arithmetic>
+LazyScheduler::openIntegerValueToParty(
+    WireId<IScheduler::Arithmetic> src,
+    int partyId) {
+  return maybeExecuteGates(gateKeeper_->outputGate(src, partyId));
+}
+
+IScheduler::WireId<IScheduler::Arithmetic>
+LazyScheduler::openIntegerValueToPartyBatch(
+    WireId<IScheduler::Arithmetic> src,
+    int partyId) {
+  return maybeExecuteGates(gateKeeper_->outputGateBatch(src, partyId));
+}
+
+uint64_t LazyScheduler::extractIntegerSecretShare(
+    WireId<IScheduler::Arithmetic> id) {
+  return forceWire<false>(id);
+}
+
+std::vector<uint64_t> LazyScheduler::extractIntegerSecretShareBatch(
+    WireId<IScheduler::Arithmetic> id) {
+  return forceWire<true>(id);
+}
+
+uint64_t LazyScheduler::getIntegerValue(WireId<IScheduler::Arithmetic> id) {
+  return forceWire<false>(id);
+}
+
+std::vector<uint64_t> LazyScheduler::getIntegerValueBatch(
+    WireId<IScheduler::Arithmetic> id) {
+  return forceWire<true>(id);
+}
+
 IScheduler::WireId<IScheduler::Boolean> LazyScheduler::privateAndPrivate(
     WireId<IScheduler::Boolean> left,
     WireId<IScheduler::Boolean> right) {
@@ -122,6 +198,14 @@ IScheduler::WireId<IScheduler::Boolean> LazyScheduler::privateAndPublicBatch(
 IScheduler::WireId<IScheduler::Boolean> LazyScheduler::publicAndPublic(
     WireId<IScheduler::Boolean> left,
     WireId<IScheduler::Boolean> right) {
+  if (gateKeeper_->canFoldGate(left, right)) {
+    return foldedGate(
+        engine_->computeFreeAND(
+            wireKeeper_->getBooleanValue(left),
+            wireKeeper_->getBooleanValue(right)),
+        left,
+        right);
+  }
   return maybeExecuteGates(gateKeeper_->normalGate(
       INormalGate<IScheduler::Boolean>::GateType::FreeAnd, left, right));
 }
@@ -129,6 +213,14 @@ IScheduler::WireId<IScheduler::Boolean> LazyScheduler::publicAndPublic(
 IScheduler::WireId<IScheduler::Boolean> LazyScheduler::publicAndPublicBatch(
     WireId<IScheduler::Boolean> left,
     WireId<IScheduler::Boolean> right) {
+  if (gateKeeper_->canFoldGateBatch(left, right)) {
+    return foldedGateBatch(
+        engine_->computeBatchFreeAND(
+            wireKeeper_->getBatchBooleanValue(left),
+            wireKeeper_->getBatchBooleanValue(right)),
+        left,
+        right);
+  }
   return maybeExecuteGates(gateKeeper_->normalGateBatch(
       INormalGate<IScheduler::Boolean>::GateType::FreeAnd, left, right));
 }
@@ -137,42 +229,48 @@ std::vector<IScheduler::WireId<IScheduler::Boolean>>
 LazyScheduler::privateAndPrivateComposite(
     IScheduler::WireId<IScheduler::Boolean> left,
     std::vector<IScheduler::WireId<IScheduler::Boolean>> rights) {
-  throw std::runtime_error("Not implemented");
+  return maybeExecuteGates(gateKeeper_->compositeGate(
+      ICompositeGate::GateType::NonFreeAnd, left, rights));
 }
 
 std::vector<IScheduler::WireId<IScheduler::Boolean>>
 LazyScheduler::privateAndPrivateCompositeBatch(
     IScheduler::WireId<IScheduler::Boolean> left,
     std::vector<IScheduler::WireId<IScheduler::Boolean>> rights) {
-  throw std::runtime_error("Not implemented");
+  return maybeExecuteGates(gateKeeper_->compositeGateBatch(
+      ICompositeGate::GateType::NonFreeAnd, left, rights));
 }
 
 std::vector<IScheduler::WireId<IScheduler::Boolean>>
 LazyScheduler::privateAndPublicComposite(
     IScheduler::WireId<IScheduler::Boolean> left,
     std::vector<IScheduler::WireId<IScheduler::Boolean>> rights) {
-  throw std::runtime_error("Not implemented");
+  return maybeExecuteGates(gateKeeper_->compositeGate(
+      ICompositeGate::GateType::FreeAnd, left, rights));
 }
 
 std::vector<IScheduler::WireId<IScheduler::Boolean>>
 LazyScheduler::privateAndPublicCompositeBatch(
     IScheduler::WireId<IScheduler::Boolean> left,
     std::vector<IScheduler::WireId<IScheduler::Boolean>> rights) {
-  throw std::runtime_error("Not implemented");
+  return maybeExecuteGates(gateKeeper_->compositeGateBatch(
+      ICompositeGate::GateType::FreeAnd, left, rights));
 }
 
 std::vector<IScheduler::WireId<IScheduler::Boolean>>
 LazyScheduler::publicAndPublicComposite(
     IScheduler::WireId<IScheduler::Boolean> left,
     std::vector<IScheduler::WireId<IScheduler::Boolean>> rights) {
-  throw std::runtime_error("Not implemented");
+  return maybeExecuteGates(gateKeeper_->compositeGate(
+      ICompositeGate::GateType::FreeAnd, left, rights));
 }
 
 std::vector<IScheduler::WireId<IScheduler::Boolean>>
 LazyScheduler::publicAndPublicCompositeBatch(
     IScheduler::WireId<IScheduler::Boolean> left,
     std::vector<IScheduler::WireId<IScheduler::Boolean>> rights) {
-  throw std::runtime_error("Not implemented");
+  return maybeExecuteGates(gateKeeper_->compositeGateBatch(
+      ICompositeGate::GateType::FreeAnd, left, rights));
 }
 
 IScheduler::WireId<IScheduler::Boolean> LazyScheduler::privateXorPrivate(
@@ -206,6 +304,14 @@ IScheduler::WireId<IScheduler::Boolean> LazyScheduler::privateXorPublicBatch(
 IScheduler::WireId<IScheduler::Boolean> LazyScheduler::publicXorPublic(
     WireId<IScheduler::Boolean> left,
     WireId<IScheduler::Boolean> right) {
+  if (gateKeeper_->canFoldGate(left, right)) {
+    return foldedGate(
+        engine_->computeSymmetricXOR(
+            wireKeeper_->getBooleanValue(left),
+            wireKeeper_->getBooleanValue(right)),
+        left,
+        right);
+  }
   return maybeExecuteGates(gateKeeper_->normalGate(
       INormalGate<IScheduler::Boolean>::GateType::SymmetricXOR, left, right));
 }
@@ -213,6 +319,14 @@ IScheduler::WireId<IScheduler::Boolean> LazyScheduler::publicXorPublic(
 IScheduler::WireId<IScheduler::Boolean> LazyScheduler::publicXorPublicBatch(
     WireId<IScheduler::Boolean> left,
     WireId<IScheduler::Boolean> right) {
+  if (gateKeeper_->canFoldGateBatch(left, right)) {
+    return foldedGateBatch(
+        engine_->computeBatchSymmetricXOR(
+            wireKeeper_->getBatchBooleanValue(left),
+            wireKeeper_->getBatchBooleanValue(right)),
+        left,
+        right);
+  }
   return maybeExecuteGates(gateKeeper_->normalGateBatch(
       INormalGate<IScheduler::Boolean>::GateType::SymmetricXOR, left, right));
 }
@@ -231,16 +345,181 @@ IScheduler::WireId<IScheduler::Boolean> LazyScheduler::notPrivateBatch(
 
 IScheduler::WireId<IScheduler::Boolean> LazyScheduler::notPublic(
     WireId<IScheduler::Boolean> src) {
+  if (gateKeeper_->canFoldGate(src)) {
+    return foldedGate(
+        engine_->computeSymmetricNOT(wireKeeper_->getBooleanValue(src)), src);
+  }
   return maybeExecuteGates(gateKeeper_->normalGate(
       INormalGate<IScheduler::Boolean>::GateType::SymmetricNot, src));
 }
 
 IScheduler::WireId<IScheduler::Boolean> LazyScheduler::notPublicBatch(
     WireId<IScheduler::Boolean> src) {
+  if (gateKeeper_->canFoldGateBatch(src)) {
+    return foldedGateBatch(
+        engine_->computeBatchSymmetricNOT(
+            wireKeeper_->getBatchBooleanValue(src)),
+        src);
+  }
   return maybeExecuteGates(gateKeeper_->normalGateBatch(
       INormalGate<IScheduler::Boolean>::GateType::SymmetricNot, src));
 }
 
+IScheduler::WireId<IScheduler::Arithmetic> LazyScheduler::privatePlusPrivate(
+    WireId<IScheduler::Arithmetic> left,
+    WireId<IScheduler::Arithmetic> right) {
+  return maybeExecuteGates(gateKeeper_->normalGate(
+      INormalGate<IScheduler::Arithmetic>::GateType::SymmetricPlus,
+      left,
+      right));
+}
+
+IScheduler::WireId<IScheduler::Arithmetic>
+LazyScheduler::privatePlusPrivateBatch(
+    WireId<IScheduler::Arithmetic> left,
+    WireId<IScheduler::Arithmetic> right) {
+  return maybeExecuteGates(gateKeeper_->normalGateBatch(
+      INormalGate<IScheduler::Arithmetic>::GateType::SymmetricPlus,
+      left,
+      right));
+}
+
+IScheduler::WireId<IScheduler::Arithmetic> LazyScheduler::privatePlusPublic(
+    WireId<IScheduler::Arithmetic> left,
+    WireId<IScheduler::Arithmetic> right) {
+  return maybeExecuteGates(gateKeeper_->normalGate(
+      INormalGate<IScheduler::Arithmetic>::GateType::AsymmetricPlus,
+      left,
+      right));
+}
+
+IScheduler::WireId<IScheduler::Arithmetic>
+LazyScheduler::privatePlusPublicBatch(
+    WireId<IScheduler::Arithmetic> left,
+    WireId<IScheduler::Arithmetic> right) {
+  return maybeExecuteGates(gateKeeper_->normalGateBatch(
+      INormalGate<IScheduler::Arithmetic>::GateType::AsymmetricPlus,
+      left,
+      right));
+}
+
+IScheduler::WireId<IScheduler::Arithmetic> LazyScheduler::publicPlusPublic(
+    WireId<IScheduler::Arithmetic> left,
+    WireId<IScheduler::Arithmetic> right) {
+  return maybeExecuteGates(gateKeeper_->normalGate(
+      INormalGate<IScheduler::Arithmetic>::GateType::SymmetricPlus,
+      left,
+      right));
+}
+
+IScheduler::WireId<IScheduler::Arithmetic> LazyScheduler::publicPlusPublicBatch(
+    WireId<IScheduler::Arithmetic> left,
+    WireId<IScheduler::Arithmetic> right) {
+  return maybeExecuteGates(gateKeeper_->normalGateBatch(
+      INormalGate<IScheduler::Arithmetic>::GateType::SymmetricPlus,
+      left,
+      right));
+}
+
+IScheduler::WireId<IScheduler::Arithmetic> LazyScheduler::privateMultPrivate(
+    WireId<IScheduler::Arithmetic> left,
+    WireId<IScheduler::Arithmetic> right) {
+  return maybeExecuteGates(gateKeeper_->normalGate(
+      INormalGate<IScheduler::Arithmetic>::GateType::NonFreeMult, left, right));
+}
+
+IScheduler::WireId<IScheduler::Arithmetic>
+LazyScheduler::privateMultPrivateBatch(
+    WireId<IScheduler::Arithmetic> left,
+    WireId<IScheduler::Arithmetic> right) {
+  return maybeExecuteGates(gateKeeper_->normalGateBatch(
+      INormalGate<IScheduler::Arithmetic>::GateType::NonFreeMult, left, right));
+}
+
+IScheduler::WireId<IScheduler::Arithmetic> LazyScheduler::privateMultPublic(
+    WireId<IScheduler::Arithmetic> left,
+    WireId<IScheduler::Arithmetic> right) {
+  return maybeExecuteGates(gateKeeper_->normalGate(
+      INormalGate<IScheduler::Arithmetic>::GateType::FreeMult, left, right));
+}
+
+IScheduler::WireId<IScheduler::Arithmetic>
+LazyScheduler::privateMultPublicBatch(
+    WireId<IScheduler::Arithmetic> left,
+    WireId<IScheduler::Arithmetic> right) {
+  return maybeExecuteGates(gateKeeper_->normalGateBatch(
+      INormalGate<IScheduler::Arithmetic>::GateType::FreeMult, left, right));
+}
+
+IScheduler::WireId<IScheduler::Arithmetic> LazyScheduler::publicMultPublic(
+    WireId<IScheduler::Arithmetic> left,
+    WireId<IScheduler::Arithmetic> right) {
+  return maybeExecuteGates(gateKeeper_->normalGate(
+      INormalGate<IScheduler::Arithmetic>::GateType::FreeMult, left, right));
+}
+
+IScheduler::WireId<IScheduler::Arithmetic> LazyScheduler::publicMultPublicBatch(
+    WireId<IScheduler::Arithmetic> left,
+    WireId<IScheduler::Arithmetic> right) {
+  return maybeExecuteGates(gateKeeper_->normalGateBatch(
+      INormalGate<IScheduler::Arithmetic>::GateType::FreeMult, left, right));
+}
+
+IScheduler::WireId<IScheduler::Arithmetic> LazyScheduler::booleanToInteger(
+    const std::vector<WireId<IScheduler::Boolean>>& src) {
+  return maybeExecuteGates(gateKeeper_->booleanToIntegerGate(src));
+}
+
+IScheduler::WireId<IScheduler::Arithmetic>
+LazyScheduler::booleanToIntegerBatch(
+    const std::vector<WireId<IScheduler::Boolean>>& src) {
+  return maybeExecuteGates(gateKeeper_->booleanToIntegerGateBatch(src));
+}
+
+std::vector<std::vector<IScheduler::WireId<IScheduler::Boolean>>>
+LazyScheduler::integerToBooleanSummands(
+    WireId<IScheduler::Arithmetic> src,
+    int8_t width) {
+  return splitSummands(
+      gateKeeper_->integerToBooleanSummandsGate(
+          src, width, kNumberOfSummands),
+      width);
+}
+
+std::vector<std::vector<IScheduler::WireId<IScheduler::Boolean>>>
+LazyScheduler::integerToBooleanSummandsBatch(
+    WireId<IScheduler::Arithmetic> src,
+    int8_t width) {
+  return splitSummands(
+      gateKeeper_->integerToBooleanSummandsGateBatch(
+          src, width, kNumberOfSummands),
+      width);
+}
+
+IScheduler::WireId<IScheduler::Arithmetic> LazyScheduler::negPrivate(
+    WireId<IScheduler::Arithmetic> src) {
+  return maybeExecuteGates(gateKeeper_->normalGate(
+      INormalGate<IScheduler::Arithmetic>::GateType::Neg, src));
+}
+
+IScheduler::WireId<IScheduler::Arithmetic> LazyScheduler::negPrivateBatch(
+    WireId<IScheduler::Arithmetic> src) {
+  return maybeExecuteGates(gateKeeper_->normalGateBatch(
+      INormalGate<IScheduler::Arithmetic>::GateType::Neg, src));
+}
+
+IScheduler::WireId<IScheduler::Arithmetic> LazyScheduler::negPublic(
+    WireId<IScheduler::Arithmetic> src) {
+  return maybeExecuteGates(gateKeeper_->normalGate(
+      INormalGate<IScheduler::Arithmetic>::GateType::Neg, src));
+}
+
+IScheduler::WireId<IScheduler::Arithmetic> LazyScheduler::negPublicBatch(
+    WireId<IScheduler::Arithmetic> src) {
+  return maybeExecuteGates(gateKeeper_->normalGateBatch(
+      INormalGate<IScheduler::Arithmetic>::GateType::Neg, src));
+}
+
 void LazyScheduler::increaseReferenceCount(WireId<IScheduler::Boolean> id) {
   wireKeeper_->increaseReferenceCount(id);
 }
@@ -251,18 +530,58 @@ void LazyScheduler::increaseReferenceCountBatch(
 }
 
 void LazyScheduler::decreaseReferenceCount(WireId<IScheduler::Boolean> id) {
-  wireKeeper_->decreaseReferenceCount(id);
+  gateKeeper_->decreaseReferenceCount(id);
 }
 
 void LazyScheduler::decreaseReferenceCountBatch(
     WireId<IScheduler::Boolean> id) {
-  wireKeeper_->decreaseBatchReferenceCount(id);
+  gateKeeper_->decreaseReferenceCountBatch(id);
+}
+
+void LazyScheduler::increaseReferenceCount(WireId<IScheduler::Arithmetic> id) {
+  wireKeeper_->increaseReferenceCount(id);
+}
+
+void LazyScheduler::increaseReferenceCountBatch(
+    WireId<IScheduler::Arithmetic> id) {
+  wireKeeper_->increaseBatchReferenceCount(id);
+}
+
+void LazyScheduler::decreaseReferenceCount(WireId<IScheduler::Arithmetic> id) {
+  gateKeeper_->decreaseReferenceCount(id);
+}
+
+void LazyScheduler::decreaseReferenceCountBatch(
+    WireId<IScheduler::Arithmetic> id) {
+  gateKeeper_->decreaseReferenceCountBatch(id);
 }
 
 std::pair<uint64_t, uint64_t> LazyScheduler::getTrafficStatistics() const {
   return engine_->getTrafficStatistics();
 }
 
+void LazyScheduler::startRecording(
+    const std::vector<WireId<IScheduler::Boolean>>& inputs) {
+  gateKeeper_->startRecording(inputs);
+}
+
+void LazyScheduler::startRecordingBatch(
+    const std::vector<WireId<IScheduler::Boolean>>& inputs) {
+  gateKeeper_->startRecordingBatch(inputs);
+}
+
+std::shared_ptr<const Circuit> LazyScheduler::stopRecording(
+    const std::vector<WireId<IScheduler::Boolean>>& outputs) {
+  return gateKeeper_->stopRecording(outputs);
+}
+
+std::vector<IScheduler::WireId<IScheduler::Boolean>>
+LazyScheduler::replayCircuit(
+    const Circuit& circuit,
+    const std::vector<WireId<IScheduler::Boolean>>& inputs) {
+  return maybeExecuteGates(gateKeeper_->addCircuit(circuit, inputs));
+}
+
 template <bool usingBatch>
 IGateKeeper::BoolType<usingBatch> LazyScheduler::forceWire(
     IScheduler::WireId<IScheduler::Boolean> id) {
@@ -275,14 +594,64 @@ IGateKeeper::BoolType<usingBatch> LazyScheduler::forceWire(
   }
 }
 
-IScheduler::WireId<IScheduler::Boolean> LazyScheduler::maybeExecuteGates(
-    IScheduler::WireId<IScheduler::Boolean> id) {
+template <bool usingBatch>
+IGateKeeper::IntType<usingBatch> LazyScheduler::forceWire(
+    IScheduler::WireId<IScheduler::Arithmetic> id) {
+  if constexpr (usingBatch) {
+    executeTillLevel(wireKeeper_->getBatchFirstAvailableLevel(id));
+    return wireKeeper_->getBatchIntegerValue(id);
+  } else {
+    executeTillLevel(wireKeeper_->getFirstAvailableLevel(id));
+    return wireKeeper_->getIntegerValue(id);
+  }
+}
+
+template <IScheduler::WireType T>
+IScheduler::WireId<T> LazyScheduler::maybeExecuteGates(
+    IScheduler::WireId<T> id) {
   while (gateKeeper_->hasReachedBatchingLimit()) {
     executeOneLevel();
   }
   return id;
 }
 
+std::vector<IScheduler::WireId<IScheduler::Boolean>>
+LazyScheduler::maybeExecuteGates(
+    std::vector<IScheduler::WireId<IScheduler::Boolean>> ids) {
+  while (gateKeeper_->hasReachedBatchingLimit()) {
+    executeOneLevel();
+  }
+  return ids;
+}
+
+IScheduler::WireId<IScheduler::Boolean> LazyScheduler::foldedGate(
+    bool value,
+    WireId<IScheduler::Boolean> left,
+    WireId<IScheduler::Boolean> right) {
+  freeGates_++;
+  return gateKeeper_->foldedGate(value, left, right);
+}
+
+IScheduler::WireId<IScheduler::Boolean> LazyScheduler::foldedGateBatch(
+    const std::vector<bool>& value,
+    WireId<IScheduler::Boolean> left,
+    WireId<IScheduler::Boolean> right) {
+  freeGates_ += value.size();
+  return gateKeeper_->foldedGateBatch(value, left, right);
+}
+
+std::vector<std::vector<IScheduler::WireId<IScheduler::Boolean>>>
+LazyScheduler::splitSummands(
+    std::vector<WireId<IScheduler::Boolean>> ids,
+    int8_t width) {
+  maybeExecuteGates(ids);
+  std::vector<std::vector<WireId<IScheduler::Boolean>>> summands;
+  for (auto begin = ids.begin(); begin != ids.end(); begin += width) {
+    summands.emplace_back(begin, begin + width);
+  }
+  return summands;
+}
+
 void LazyScheduler::executeTillLevel(uint32_t level) {
   while (gateKeeper_->getFirstUnexecutedLevel() <= level) {
     executeOneLevel();
@@ -291,36 +660,113 @@ void LazyScheduler::executeTillLevel(uint32_t level) {
 
 void LazyScheduler::executeOneLevel() {
   auto level = gateKeeper_->getFirstUnexecutedLevel();
-  auto gates = gateKeeper_->popFirstUnexecutedLevel();
   auto isLevelFree = IGateKeeper::isLevelFree(level);
 
+  if (isLevelFree && threadPool_ != nullptr) {
+    // the gates that don't read any wire of this level go first, the others
+    // may depend on each other and are computed in order.
+    computeIndependentFreeGates(gateKeeper_->popGatesIndependentOfLevel(level));
+  }
+  // let the tuples of the queued ANDs be generated while the levels before
+  // them are executed
+  engine_->prefetchANDTuples(gateKeeper_->getNumberOfPendingANDs());
+  auto gates = gateKeeper_->popFirstUnexecutedLevel();
+
   // Compute free or non-free gates
-  std::map<int64_t, std::vector<bool>> secretSharesByParty;
+  std::map<int64_t, IGate::Secrets> secretSharesByParty;
+  uint64_t numberOfResults = 0;
   for (auto& gate : gates) {
     gate->compute(*engine_, secretSharesByParty);
+    numberOfResults += gate->getNumberOfResults();
+  }
+  if (isLevelFree) {
+    freeGates_ += numberOfResults;
+  } else {
+    nonFreeGates_ += numberOfResults;
+  }
 
-    if (isLevelFree) {
-      freeGates_ += gate->getNumberOfResults();
+  if (!isLevelFree) {
+    // Execute AND and multiplication gates and share secrets
+    if (pipelined_) {
+      auto pendingANDs = engine_->executeScheduledANDAsync();
+      computeIndependentFreeGates(
+          gateKeeper_->popGatesIndependentOfLevel(level));
+      pendingANDs.get();
     } else {
-      nonFreeGates_ += gate->getNumberOfResults();
+      engine_->executeScheduledAND();
+    }
+    engine_->executeScheduledMult();
+    engine_->executeScheduledBooleanToInteger();
+
+    std::map<int64_t, IGate::Secrets> revealedSecretsByParty;
+    for (auto& [party, secretShares] : secretSharesByParty) {
+      IGate::Secrets revealedSecrets;
+      if (!secretShares.booleanSecrets.empty()) {
+        // the shares are opened a word at a time.
+        revealedSecrets.booleanSecrets =
+            engine_
+                ->revealToParty(
+                    party,
+                    engine::util::PackedBitVector(secretShares.booleanSecrets))
+                .toBoolVector();
+      }
+      if (!secretShares.integerSecrets.empty()) {
+        revealedSecrets.integerSecrets =
+            engine_->revealToParty(party, secretShares.integerSecrets);
+      }
+      revealedSecretsByParty.emplace(party, std::move(revealedSecrets));
     }
-  }
 
-  if (!isLevelFree) {
-    // Execute AND gates and share secrets
-    engine_->executeScheduledAND();
+    // Update non-free gates, this only reads the results from the engine and
+    // the revealed secrets.
+    forEachChunk(gates.size(), [&](size_t begin, size_t end) {
+      for (auto i = begin; i < end; i++) {
+        gates[i]->collectScheduledResult(*engine_, revealedSecretsByParty);
+      }
+    });
+
+    gateKeeper_->recordNonFreeLevel(numberOfResults);
+  }
+}
 
-    std::map<int64_t, std::vector<bool>> revealedSecretsByParty;
-    for (auto [party, secretShares] : secretSharesByParty) {
-      revealedSecretsByParty.emplace(
-          party, engine_->revealToParty(party, secretShares));
+void LazyScheduler::computeIndependentFreeGates(
+    const std::vector<std::unique_ptr<IGate>>& gates) {
+  // free gates don't reveal any secret
+  std::map<int64_t, IGate::Secrets> secretSharesByParty;
+  std::vector<IGate*> concurrentGates;
+  for (auto& gate : gates) {
+    if (threadPool_ != nullptr && gate->canComputeConcurrently()) {
+      concurrentGates.push_back(gate.get());
+    } else {
+      gate->compute(*engine_, secretSharesByParty);
     }
+  }
 
-    // Update non-free gates
-    for (auto& nonFreeGate : gates) {
-      nonFreeGate->collectScheduledResult(*engine_, revealedSecretsByParty);
+  forEachChunk(concurrentGates.size(), [&](size_t begin, size_t end) {
+    std::map<int64_t, IGate::Secrets> chunkSecretSharesByParty;
+    for (auto i = begin; i < end; i++) {
+      concurrentGates[i]->compute(*engine_, chunkSecretSharesByParty);
     }
+  });
+
+  for (auto& gate : gates) {
+    freeGates_ += gate->getNumberOfResults();
+  }
+}
+
+void LazyScheduler::forEachChunk(
+    size_t size,
+    const std::function<void(size_t begin, size_t end)>& f) {
+  if (threadPool_ == nullptr || size < 2) {
+    f(0, size);
+    return;
   }
+  // a few chunks per thread balance the gates of different sizes
+  auto numberOfChunks =
+      std::min(size, threadPool_->getNumberOfThreads() * kChunksPerThread);
+  threadPool_->parallelFor(numberOfChunks, [&](size_t chunk) {
+    f(size * chunk / numberOfChunks, size * (chunk + 1) / numberOfChunks);
+  });
 }
 
 } // namespace fbpcf::scheduler
@@ -7,9 +7,16 @@
 
 #pragma once
 
+#include <functional>
+#include <memory>
+#include <vector>
+
 #include "fbpcf/engine/ISecretShareEngine.h"
+#include "fbpcf/engine/util/ThreadPool.h"
+#include "fbpcf/scheduler/IArithmeticScheduler.h"
 #include "fbpcf/scheduler/IScheduler.h"
 #include "fbpcf/scheduler/IWireKeeper.h"
+#include "fbpcf/scheduler/gate_keeper/Circuit.h"
 #include "fbpcf/scheduler/gate_keeper/IGateKeeper.h"
 
 namespace fbpcf::scheduler {
@@ -19,13 +26,25 @@ namespace fbpcf::scheduler {
  * application with the MPC protocol. Gates are batched together
  * and executed lazily to reduce roundtrips. It is cryptographically
  * secure if the underlying secret sharing engine is.
+ * Integer gates are levelled and batched the same way as boolean gates, and
+ * the multiplications at a level are executed together.
+ * In pipelined mode, the ANDs of a non-free level are executed in the
+ * background, while the free gates of the next level that don't depend on
+ * them are computed.
+ * With a thread pool, the free gates of a level that don't read any wire of
+ * that level are computed in parallel, and so are the results of the non-free
+ * gates once a level has been executed. Everything that uses the engine's
+ * state (scheduling, randomness, secrets to reveal) stays on one thread in
+ * the order the gates were added, so that both parties agree on it.
  */
-class LazyScheduler final : public IScheduler {
+class LazyScheduler final : public IArithmeticScheduler {
  public:
   explicit LazyScheduler(
       std::unique_ptr<engine::ISecretShareEngine> engine,
       std::shared_ptr<IWireKeeper> wireKeeper,
-      std::unique_ptr<IGateKeeper> gateKeeper);
+      std::unique_ptr<IGateKeeper> gateKeeper,
+      bool pipelined = false,
+      std::shared_ptr<engine::util::ThreadPool> threadPool = nullptr);
 
   //======== Below are input processing APIs: ========
 
@@ -63,6 +82,41 @@ class LazyScheduler final : public IScheduler {
   WireId<IScheduler::Boolean> recoverBooleanWireBatch(
       const std::vector<bool>& v) override;
 
+  /**
+   * @inherit doc
+   */
+  WireId<IScheduler::Arithmetic> privateIntegerInput(uint64_t v, int partyId)
+      override;
+
+  /**
+   * @inherit doc
+   */
+  WireId<IScheduler::Arithmetic> privateIntegerInputBatch(
+      const std::vector<uint64_t>& v,
+      int partyId) override;
+
+  /**
+   * @inherit doc
+   */
+  WireId<IScheduler::Arithmetic> publicIntegerInput(uint64_t v) override;
+
+  /**
+   * @inherit doc
+   */
+  WireId<IScheduler::Arithmetic> publicIntegerInputBatch(
+      const std::vector<uint64_t>& v) override;
+
+  /**
+   * @inherit doc
+   */
+  WireId<IScheduler::Arithmetic> recoverIntegerWire(uint64_t v) override;
+
+  /**
+   * @inherit doc
+   */
+  WireId<IScheduler::Arithmetic> recoverIntegerWireBatch(
+      const std::vector<uint64_t>& v) override;
+
   //======== Below are output processing APIs: ========
   /**
    * @inherit doc
@@ -100,6 +154,43 @@ class LazyScheduler final : public IScheduler {
   std::vector<bool> getBooleanValueBatch(
       WireId<IScheduler::Boolean> id) override;
 
+  /**
+   * @inherit doc
+   */
+  WireId<IScheduler::Arithmetic> openIntegerValueToParty(
+      WireId<IScheduler::Arithmetic> src,
+      int partyId) override;
+
+  /**
+   * @inherit doc
+   */
+  WireId<IScheduler::Arithmetic> openIntegerValueToPartyBatch(
+      WireId<IScheduler::Arithmetic> src,
+      int partyId) override;
+
+  /**
+   * @inherit doc
+   */
+  uint64_t extractIntegerSecretShare(
+      WireId<IScheduler::Arithmetic> id) override;
+
+  /**
+   * @inherit doc
+   */
+  std::vector<uint64_t> extractIntegerSecretShareBatch(
+      WireId<IScheduler::Arithmetic> id) override;
+
+  /**
+   * @inherit doc
+   */
+  uint64_t getIntegerValue(WireId<IScheduler::Arithmetic> id) override;
+
+  /**
+   * @inherit doc
+   */
+  std::vector<uint64_t> getIntegerValueBatch(
+      WireId<IScheduler::Arithmetic> id) override;
+
   //======== Below are computation APIs: ========
 
   // ------ AND gates ------
@@ -260,6 +351,149 @@ class LazyScheduler final : public IScheduler {
   WireId<IScheduler::Boolean> notPublicBatch(
       WireId<IScheduler::Boolean> src) override;
 
+  // ------ Plus gates ------
+
+  /**
+   * @inherit doc
+   */
+  WireId<IScheduler::Arithmetic> privatePlusPrivate(
+      WireId<IScheduler::Arithmetic> left,
+      WireId<IScheduler::Arithmetic> right) override;
+
+  /**
+   * @inherit doc
+   */
+  WireId<IScheduler::Arithmetic> privatePlusPrivateBatch(
+      WireId<IScheduler::Arithmetic> left,
+      WireId<IScheduler::Arithmetic> right) override;
+
+  /**
+   * @inherit doc
+   */
+  WireId<IScheduler::Arithmetic> privatePlusPublic(
+      WireId<IScheduler::Arithmetic> left,
+      WireId<IScheduler::Arithmetic> right) override;
+
+  /**
+   * @inherit doc
+   */
+  WireId<IScheduler::Arithmetic> privatePlusPublicBatch(
+      WireId<IScheduler::Arithmetic> left,
+      WireId<IScheduler::Arithmetic> right) override;
+
+  /**
+   * @inherit doc
+   */
+  WireId<IScheduler::Arithmetic> publicPlusPublic(
+      WireId<IScheduler::Arithmetic> left,
+      WireId<IScheduler::Arithmetic> right) override;
+
+  /**
+   * @inherit doc
+   */
+  WireId<IScheduler::Arithmetic> publicPlusPublicBatch(
+      WireId<IScheduler::Arithmetic> left,
+      WireId<IScheduler::Arithmetic> right) override;
+
+  // ------ Mult gates ------
+
+  /**
+   * @inherit doc
+   */
+  WireId<IScheduler::Arithmetic> privateMultPrivate(
+      WireId<IScheduler::Arithmetic> left,
+      WireId<IScheduler::Arithmetic> right) override;
+
+  /**
+   * @inherit doc
+   */
+  WireId<IScheduler::Arithmetic> privateMultPrivateBatch(
+      WireId<IScheduler::Arithmetic> left,
+      WireId<IScheduler::Arithmetic> right) override;
+
+  /**
+   * @inherit doc
+   */
+  WireId<IScheduler::Arithmetic> privateMultPublic(
+      WireId<IScheduler::Arithmetic> left,
+      WireId<IScheduler::Arithmetic> right) override;
+
+  /**
+   * @inherit doc
+   */
+  WireId<IScheduler::Arithmetic> privateMultPublicBatch(
+      WireId<IScheduler::Arithmetic> left,
+      WireId<IScheduler::Arithmetic> right) override;
+
+  /**
+   * @inherit doc
+   */
+  WireId<IScheduler::Arithmetic> publicMultPublic(
+      WireId<IScheduler::Arithmetic> left,
+      WireId<IScheduler::Arithmetic> right) override;
+
+  /**
+   * @inherit doc
+   */
+  WireId<IScheduler::Arithmetic> publicMultPublicBatch(
+      WireId<IScheduler::Arithmetic> left,
+      WireId<IScheduler::Arithmetic> right) override;
+
+  // ------ Conversion gates ------
+
+  /**
+   * @inherit doc
+   */
+  WireId<IScheduler::Arithmetic> booleanToInteger(
+      const std::vector<WireId<IScheduler::Boolean>>& src) override;
+
+  /**
+   * @inherit doc
+   */
+  WireId<IScheduler::Arithmetic> booleanToIntegerBatch(
+      const std::vector<WireId<IScheduler::Boolean>>& src) override;
+
+  /**
+   * @inherit doc
+   */
+  std::vector<std::vector<WireId<IScheduler::Boolean>>>
+  integerToBooleanSummands(WireId<IScheduler::Arithmetic> src, int8_t width)
+      override;
+
+  /**
+   * @inherit doc
+   */
+  std::vector<std::vector<WireId<IScheduler::Boolean>>>
+  integerToBooleanSummandsBatch(
+      WireId<IScheduler::Arithmetic> src,
+      int8_t width) override;
+
+  // ------ Neg gates ------
+
+  /**
+   * @inherit doc
+   */
+  WireId<IScheduler::Arithmetic> negPrivate(
+      WireId<IScheduler::Arithmetic> src) override;
+
+  /**
+   * @inherit doc
+   */
+  WireId<IScheduler::Arithmetic> negPrivateBatch(
+      WireId<IScheduler::Arithmetic> src) override;
+
+  /**
+   * @inherit doc
+   */
+  WireId<IScheduler::Arithmetic> negPublic(
+      WireId<IScheduler::Arithmetic> src) override;
+
+  /**
+   * @inherit doc
+   */
+  WireId<IScheduler::Arithmetic> negPublicBatch(
+      WireId<IScheduler::Arithmetic> src) override;
+
   //======== Below are wire management APIs: ========
 
   /**
@@ -282,6 +516,27 @@ class LazyScheduler final : public IScheduler {
    */
   void decreaseReferenceCountBatch(WireId<IScheduler::Boolean> id) override;
 
+  /**
+   * @inherit doc
+   */
+  void increaseReferenceCount(WireId<IScheduler::Arithmetic> src) override;
+
+  /**
+   * @inherit doc
+   */
+  void increaseReferenceCountBatch(
+      WireId<IScheduler::Arithmetic> src) override;
+
+  /**
+   * @inherit doc
+   */
+  void decreaseReferenceCount(WireId<IScheduler::Arithmetic> id) override;
+
+  /**
+   * @inherit doc
+   */
+  void decreaseReferenceCountBatch(WireId<IScheduler::Arithmetic> id) override;
+
   //======== Below are miscellaneous APIs: ========
 
   /**
@@ -296,21 +551,113 @@ class LazyScheduler final : public IScheduler {
     return wireKeeper_->getWireStatistics();
   }
 
+  /**
+   * @inherit doc
+   */
+  std::pair<uint64_t, uint64_t> getPendingBytesStatistics() const override {
+    return {gateKeeper_->getPendingBytes(), gateKeeper_->getPeakPendingBytes()};
+  }
+
+  /**
+   * @inherit doc
+   */
+  std::pair<uint64_t, uint64_t> getEliminatedGateStatistics() const override {
+    return {
+        gateKeeper_->getNumberOfDeadGates(),
+        gateKeeper_->getNumberOfFoldedGates()};
+  }
+
+  /**
+   * @inherit doc
+   */
+  std::chrono::nanoseconds getTupleStarvationTime() const override {
+    return engine_->getTupleStarvationTime();
+  }
+
+  //======== Below are circuit recording APIs: ========
+
+  /**
+   * @inherit doc
+   */
+  void startRecording(
+      const std::vector<WireId<IScheduler::Boolean>>& inputs) override;
+
+  /**
+   * @inherit doc
+   */
+  void startRecordingBatch(
+      const std::vector<WireId<IScheduler::Boolean>>& inputs) override;
+
+  /**
+   * @inherit doc
+   */
+  std::shared_ptr<const Circuit> stopRecording(
+      const std::vector<WireId<IScheduler::Boolean>>& outputs) override;
+
+  /**
+   * @inherit doc
+   */
+  std::vector<WireId<IScheduler::Boolean>> replayCircuit(
+      const Circuit& circuit,
+      const std::vector<WireId<IScheduler::Boolean>>& inputs) override;
+
  private:
+  // integer to boolean conversions only support two-party computation.
+  static const int kNumberOfSummands = 2;
+
+  static const size_t kChunksPerThread = 4;
+
   std::unique_ptr<engine::ISecretShareEngine> engine_;
   std::shared_ptr<IWireKeeper> wireKeeper_;
   std::unique_ptr<IGateKeeper> gateKeeper_;
+  bool pipelined_;
+  std::shared_ptr<engine::util::ThreadPool> threadPool_;
 
   // Compute the value for the given wire if it hasn't been set already.
   template <bool usingBatch>
   IGateKeeper::BoolType<usingBatch> forceWire(WireId<IScheduler::Boolean> id);
 
+  template <bool usingBatch>
+  IGateKeeper::IntType<usingBatch> forceWire(
+      WireId<IScheduler::Arithmetic> id);
+
   // Execute some gates if we're close to reaching the memory limit.
-  WireId<IScheduler::Boolean> maybeExecuteGates(WireId<IScheduler::Boolean> id);
+  template <IScheduler::WireType T>
+  WireId<T> maybeExecuteGates(WireId<T> id);
+
+  std::vector<WireId<IScheduler::Boolean>> maybeExecuteGates(
+      std::vector<WireId<IScheduler::Boolean>> ids);
+
+  // Create a wire holding the result of a free gate on known public values,
+  // instead of adding the gate.
+  WireId<IScheduler::Boolean> foldedGate(
+      bool value,
+      WireId<IScheduler::Boolean> left,
+      WireId<IScheduler::Boolean> right = WireId<IScheduler::Boolean>());
+
+  WireId<IScheduler::Boolean> foldedGateBatch(
+      const std::vector<bool>& value,
+      WireId<IScheduler::Boolean> left,
+      WireId<IScheduler::Boolean> right = WireId<IScheduler::Boolean>());
+
+  // Split the output wires of a conversion gate into one summand per party.
+  std::vector<std::vector<WireId<IScheduler::Boolean>>> splitSummands(
+      std::vector<WireId<IScheduler::Boolean>> ids,
+      int8_t width);
 
   // Compute all the gates up to the given level.
   void executeTillLevel(uint32_t level);
 
+  // Compute free gates that don't depend on each other, in parallel if
+  // possible.
+  void computeIndependentFreeGates(
+      const std::vector<std::unique_ptr<IGate>>& gates);
+
+  // Call f on the ranges of a split of [0, size), in parallel if possible.
+  void forEachChunk(
+      size_t size,
+      const std::function<void(size_t begin, size_t end)>& f);
+
   // Compute one level of gates.
   void executeOneLevel();
 };
@@ -8,6 +8,7 @@
 #pragma once
 
 #include <memory>
+#include <stdexcept>
 #include "fbpcf/scheduler/IScheduler.h"
 #include "fbpcf/scheduler/IWireKeeper.h"
 
@@ -283,6 +284,38 @@ class PlaintextScheduler : public IScheduler {
    */
   void decreaseReferenceCountBatch(WireId<IScheduler::Boolean> id) override;
 
+  //======== Below are circuit recording APIs: ========
+
+  /**
+   * @inherit doc
+   */
+  void startRecording(
+      const std::vector<WireId<IScheduler::Boolean>>& /*inputs*/) override {}
+
+  /**
+   * @inherit doc
+   */
+  void startRecordingBatch(
+      const std::vector<WireId<IScheduler::Boolean>>& /*inputs*/) override {}
+
+  /**
+   * @inherit doc
+   */
+  std::shared_ptr<const Circuit> stopRecording(
+      const std::vector<WireId<IScheduler::Boolean>>& /*outputs*/) override {
+    // the gates are executed right away, there is nothing to record
+    return nullptr;
+  }
+
+  /**
+   * @inherit doc
+   */
+  std::vector<WireId<IScheduler::Boolean>> replayCircuit(
+      const Circuit& /*circuit*/,
+      const std::vector<WireId<IScheduler::Boolean>>& /*inputs*/) override {
+    throw std::runtime_error("This scheduler doesn't replay circuits.");
+  }
+
   //======== Below are miscellaneous APIs: ========
 
   /**
@@ -299,6 +332,27 @@ class PlaintextScheduler : public IScheduler {
     return wireKeeper_->getWireStatistics();
   }
 
+  /**
+   * @inherit doc
+   */
+  std::pair<uint64_t, uint64_t> getPendingBytesStatistics() const override {
+    return {0, 0};
+  }
+
+  /**
+   * @inherit doc
+   */
+  std::pair<uint64_t, uint64_t> getEliminatedGateStatistics() const override {
+    return {0, 0};
+  }
+
+  /**
+   * @inherit doc
+   */
+  std::chrono::nanoseconds getTupleStarvationTime() const override {
+    return std::chrono::nanoseconds(0);
+  }
+
  protected:
   std::unique_ptr<IWireKeeper> wireKeeper_;
 
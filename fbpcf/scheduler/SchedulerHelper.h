@@ -13,6 +13,7 @@
 #include "fbpcf/engine/communication/AgentMapHelper.h"
 #include "fbpcf/engine/communication/IPartyCommunicationAgentFactory.h"
 #include "fbpcf/scheduler/EagerScheduler.h"
+#include "fbpcf/scheduler/IArithmeticScheduler.h"
 #include "fbpcf/scheduler/IScheduler.h"
 #include "fbpcf/scheduler/LazyScheduler.h"
 #include "fbpcf/scheduler/NetworkPlaintextScheduler.h"
@@ -44,12 +45,17 @@ inline std::unique_ptr<IScheduler> createNetworkPlaintextScheduler(
 }
 
 // this function creates a eager scheduler with real secure engine
+template <bool enableCompositeTupleGeneration = false>
 inline std::unique_ptr<IScheduler> createEagerSchedulerWithRealEngine(
     int myId,
     engine::communication::IPartyCommunicationAgentFactory&
         communicationAgentFactory) {
   auto engineFactory = engine::getSecureEngineFactoryWithFERRET<bool>(
-      myId, 2, communicationAgentFactory);
+      myId,
+      2,
+      communicationAgentFactory,
+      std::nullopt,
+      enableCompositeTupleGeneration);
 
   return std::make_unique<EagerScheduler>(
       engineFactory->create(),
@@ -57,12 +63,17 @@ inline std::unique_ptr<IScheduler> createEagerSchedulerWithRealEngine(
 }
 
 // this function creates a lazy scheduler with real secure engine
+template <bool enableCompositeTupleGeneration = false>
 inline std::unique_ptr<IScheduler> createLazySchedulerWithRealEngine(
     int myId,
     engine::communication::IPartyCommunicationAgentFactory&
         communicationAgentFactory) {
   auto engineFactory = engine::getSecureEngineFactoryWithFERRET<bool>(
-      myId, 2, communicationAgentFactory);
+      myId,
+      2,
+      communicationAgentFactory,
+      std::nullopt,
+      enableCompositeTupleGeneration);
 
   std::shared_ptr<IWireKeeper> wireKeeper =
       WireKeeper::createWithVectorArena</*unsafe*/ true>();
@@ -73,24 +84,75 @@ inline std::unique_ptr<IScheduler> createLazySchedulerWithRealEngine(
       std::make_unique<GateKeeper>(wireKeeper));
 }
 
+// this function creates a pipelined lazy scheduler with real secure engine
+template <bool enableCompositeTupleGeneration = false>
+inline std::unique_ptr<IScheduler> createPipelinedLazySchedulerWithRealEngine(
+    int myId,
+    engine::communication::IPartyCommunicationAgentFactory&
+        communicationAgentFactory) {
+  auto engineFactory = engine::getSecureEngineFactoryWithFERRET<bool>(
+      myId,
+      2,
+      communicationAgentFactory,
+      std::nullopt,
+      enableCompositeTupleGeneration);
+
+  std::shared_ptr<IWireKeeper> wireKeeper =
+      WireKeeper::createWithVectorArena</*unsafe*/ true>();
+
+  return std::make_unique<LazyScheduler>(
+      engineFactory->create(),
+      wireKeeper,
+      std::make_unique<GateKeeper>(wireKeeper),
+      /*pipelined*/ true);
+}
+
+// this function creates a lazy scheduler with real secure engine, which
+// computes the gates with the given number of threads
+template <bool enableCompositeTupleGeneration = false>
+inline std::unique_ptr<IScheduler> createParallelLazySchedulerWithRealEngine(
+    int myId,
+    engine::communication::IPartyCommunicationAgentFactory&
+        communicationAgentFactory,
+    size_t numberOfThreads) {
+  auto engineFactory = engine::getSecureEngineFactoryWithFERRET<bool>(
+      myId,
+      2,
+      communicationAgentFactory,
+      std::nullopt,
+      enableCompositeTupleGeneration);
+
+  std::shared_ptr<IWireKeeper> wireKeeper =
+      WireKeeper::createWithVectorArena</*unsafe*/ true>();
+
+  return std::make_unique<LazyScheduler>(
+      engineFactory->create(),
+      wireKeeper,
+      std::make_unique<GateKeeper>(wireKeeper),
+      /*pipelined*/ false,
+      std::make_shared<engine::util::ThreadPool>(numberOfThreads));
+}
+
+template <bool enableCompositeTupleGeneration = false>
 inline std::unique_ptr<IScheduler> createEagerSchedulerWithClassicOT(
     int myId,
     engine::communication::IPartyCommunicationAgentFactory&
         communicationAgentFactory) {
   auto engineFactory = engine::getSecureEngineFactoryWithClassicOt<bool>(
-      myId, 2, communicationAgentFactory);
+      myId, 2, communicationAgentFactory, enableCompositeTupleGeneration);
 
   return std::make_unique<EagerScheduler>(
       engineFactory->create(),
       WireKeeper::createWithVectorArena</*unsafe*/ true>());
 }
 
+template <bool enableCompositeTupleGeneration = false>
 inline std::unique_ptr<IScheduler> createLazySchedulerWithClassicOT(
     int myId,
     engine::communication::IPartyCommunicationAgentFactory&
         communicationAgentFactory) {
   auto engineFactory = engine::getSecureEngineFactoryWithClassicOt<bool>(
-      myId, 2, communicationAgentFactory);
+      myId, 2, communicationAgentFactory, enableCompositeTupleGeneration);
 
   std::shared_ptr<IWireKeeper> wireKeeper =
       WireKeeper::createWithVectorArena</*unsafe*/ true>();
@@ -114,8 +176,10 @@ inline std::unique_ptr<IScheduler> createEagerSchedulerWithInsecureEngine(
       engineFactory->create(), WireKeeper::createWithVectorArena<unsafe>());
 }
 
-// this function creates a lazy scheduler with insecure engine
-template <bool unsafe>
+// this function creates a lazy scheduler with insecure engine, its scalar
+// gates are kept in gate arenas if useGateArena is set and are vectorized if
+// vectorizeGates is set
+template <bool unsafe, bool useGateArena = false, bool vectorizeGates = false>
 inline std::unique_ptr<IScheduler> createLazySchedulerWithInsecureEngine(
     int myId,
     engine::communication::IPartyCommunicationAgentFactory&
@@ -126,10 +190,106 @@ inline std::unique_ptr<IScheduler> createLazySchedulerWithInsecureEngine(
   std::shared_ptr<IWireKeeper> wireKeeper =
       WireKeeper::createWithVectorArena<unsafe>();
 
+  return std::make_unique<LazyScheduler>(
+      engineFactory->create(),
+      wireKeeper,
+      std::make_unique<GateKeeper>(
+          wireKeeper,
+          useGateArena,
+          GateKeeper::kDefaultMemoryBudget,
+          vectorizeGates));
+}
+
+// this function creates a pipelined lazy scheduler with insecure engine
+template <bool unsafe>
+inline std::unique_ptr<IScheduler>
+createPipelinedLazySchedulerWithInsecureEngine(
+    int myId,
+    engine::communication::IPartyCommunicationAgentFactory&
+        communicationAgentFactory) {
+  auto engineFactory = engine::getInsecureEngineFactoryWithDummyTupleGenerator(
+      myId, 2, communicationAgentFactory);
+
+  std::shared_ptr<IWireKeeper> wireKeeper =
+      WireKeeper::createWithVectorArena<unsafe>();
+
+  return std::make_unique<LazyScheduler>(
+      engineFactory->create(),
+      wireKeeper,
+      std::make_unique<GateKeeper>(wireKeeper),
+      /*pipelined*/ true);
+}
+
+// this function creates a lazy scheduler with insecure engine, which computes
+// the gates with the given number of threads
+template <bool unsafe>
+inline std::unique_ptr<IScheduler>
+createParallelLazySchedulerWithInsecureEngine(
+    int myId,
+    engine::communication::IPartyCommunicationAgentFactory&
+        communicationAgentFactory,
+    size_t numberOfThreads) {
+  auto engineFactory = engine::getInsecureEngineFactoryWithDummyTupleGenerator(
+      myId, 2, communicationAgentFactory);
+
+  std::shared_ptr<IWireKeeper> wireKeeper =
+      WireKeeper::createWithVectorArena<unsafe>();
+
+  return std::make_unique<LazyScheduler>(
+      engineFactory->create(),
+      wireKeeper,
+      std::make_unique<GateKeeper>(wireKeeper),
+      /*pipelined*/ false,
+      std::make_shared<engine::util::ThreadPool>(numberOfThreads));
+}
+
+// this function creates a lazy scheduler with real secure engine that also
+// supports integer operations
+template <bool enableCompositeTupleGeneration = false>
+inline std::unique_ptr<IArithmeticScheduler>
+createArithmeticLazySchedulerWithRealEngine(
+    int myId,
+    engine::communication::IPartyCommunicationAgentFactory&
+        communicationAgentFactory) {
+  auto engineFactory = engine::getSecureArithmeticEngineFactoryWithFERRET<bool>(
+      myId,
+      2,
+      communicationAgentFactory,
+      std::nullopt,
+      enableCompositeTupleGeneration);
+
+  std::shared_ptr<IWireKeeper> wireKeeper =
+      WireKeeper::createWithVectorArena</*unsafe*/ true>();
+
   return std::make_unique<LazyScheduler>(
       engineFactory->create(),
       wireKeeper,
       std::make_unique<GateKeeper>(wireKeeper));
 }
 
+// this function creates a lazy scheduler with insecure engine that also
+// supports integer operations, its scalar gates are kept in gate arenas if
+// useGateArena is set and are vectorized if vectorizeGates is set
+template <bool unsafe, bool useGateArena = false, bool vectorizeGates = false>
+inline std::unique_ptr<IArithmeticScheduler>
+createArithmeticLazySchedulerWithInsecureEngine(
+    int myId,
+    engine::communication::IPartyCommunicationAgentFactory&
+        communicationAgentFactory) {
+  auto engineFactory = engine::getInsecureEngineFactoryWithDummyTupleGenerator(
+      myId, 2, communicationAgentFactory);
+
+  std::shared_ptr<IWireKeeper> wireKeeper =
+      WireKeeper::createWithVectorArena<unsafe>();
+
+  return std::make_unique<LazyScheduler>(
+      engineFactory->create(),
+      wireKeeper,
+      std::make_unique<GateKeeper>(
+          wireKeeper,
+          useGateArena,
+          GateKeeper::kDefaultMemoryBudget,
+          vectorizeGates));
+}
+
 } // namespace fbpcf::scheduler
@@ -92,6 +92,16 @@ void WireKeeper::increaseReferenceCount(
   intAllocator_->getWritableReference(id.getId()).referenceCount++;
 }
 
+uint32_t WireKeeper::getReferenceCount(
+    IScheduler::WireId<IScheduler::Boolean> id) const {
+  return boolAllocator_->get(id.getId()).referenceCount;
+}
+
+uint32_t WireKeeper::getReferenceCount(
+    IScheduler::WireId<IScheduler::Arithmetic> id) const {
+  return intAllocator_->get(id.getId()).referenceCount;
+}
+
 void WireKeeper::decreaseReferenceCount(
     IScheduler::WireId<IScheduler::Boolean> id) {
   if (--boolAllocator_->getWritableReference(id.getId()).referenceCount == 0) {
@@ -189,6 +199,16 @@ void WireKeeper::increaseBatchReferenceCount(
   intBatchAllocator_->getWritableReference(id.getId()).referenceCount++;
 }
 
+uint32_t WireKeeper::getBatchReferenceCount(
+    IScheduler::WireId<IScheduler::Boolean> id) const {
+  return boolBatchAllocator_->get(id.getId()).referenceCount;
+}
+
+uint32_t WireKeeper::getBatchReferenceCount(
+    IScheduler::WireId<IScheduler::Arithmetic> id) const {
+  return intBatchAllocator_->get(id.getId()).referenceCount;
+}
+
 void WireKeeper::decreaseBatchReferenceCount(
     IScheduler::WireId<IScheduler::Boolean> id) {
   if (--boolBatchAllocator_->getWritableReference(id.getId()).referenceCount ==
@@ -146,6 +146,18 @@ class WireKeeper final : public IWireKeeper {
   void decreaseReferenceCount(
       IScheduler::WireId<IScheduler::Arithmetic> id) override;
 
+  /**
+   * @inherit doc
+   */
+  uint32_t getReferenceCount(
+      IScheduler::WireId<IScheduler::Boolean> id) const override;
+
+  /**
+   * @inherit doc
+   */
+  uint32_t getReferenceCount(
+      IScheduler::WireId<IScheduler::Arithmetic> id) const override;
+
   /**
    * @inherit doc
    */
@@ -236,6 +248,18 @@ class WireKeeper final : public IWireKeeper {
   void decreaseBatchReferenceCount(
       IScheduler::WireId<IScheduler::Arithmetic> id) override;
 
+  /**
+   * @inherit doc
+   */
+  uint32_t getBatchReferenceCount(
+      IScheduler::WireId<IScheduler::Boolean> id) const override;
+
+  /**
+   * @inherit doc
+   */
+  uint32_t getBatchReferenceCount(
+      IScheduler::WireId<IScheduler::Arithmetic> id) const override;
+
  private:
   std::unique_ptr<IAllocator<WireRecord<bool>>> boolAllocator_;
   std::unique_ptr<IAllocator<WireRecord<std::vector<bool>>>>
@@ -51,27 +51,54 @@ class BatchCompositeGate final : public ICompositeGate {
   }
 
   void compute(
-      engine::ISecretShareEngine& /*engine*/,
-      std::map<int64_t, std::vector<bool>>& /*secretSharesByParty*/) override {
+      engine::ISecretShareEngine& engine,
+      std::map<int64_t, IGate::Secrets>& /*secretSharesByParty*/) override {
+    auto leftValues = wireKeeper_.getBatchBooleanValue(left_);
+    numberOfResults_ = leftValues.size() * rights_.size();
     switch (gateType_) {
         // Free gates
       case GateType::FreeAnd: {
-        throw std::runtime_error("Not implemented");
+        for (size_t i = 0; i < rights_.size(); i++) {
+          wireKeeper_.setBatchBooleanValue(
+              outputWireIDs_[i],
+              engine.computeBatchFreeAND(
+                  leftValues, wireKeeper_.getBatchBooleanValue(rights_[i])));
+        }
+        break;
       }
 
       case GateType::NonFreeAnd: {
-        throw std::runtime_error("Not implemented");
+        if (numberOfResults_ == 0) {
+          break;
+        }
+        std::vector<std::vector<bool>> rightValues(rights_.size());
+        for (size_t i = 0; i < rights_.size(); i++) {
+          rightValues[i] = wireKeeper_.getBatchBooleanValue(rights_[i]);
+        }
+        scheduledResultIndex_ =
+            engine.scheduleBatchCompositeAND(leftValues, rightValues);
+        break;
       }
     }
   }
 
   void collectScheduledResult(
-      engine::ISecretShareEngine& /*engine*/,
-      std::map<int64_t, std::vector<bool>>& /*revealedSecretsByParty*/)
+      engine::ISecretShareEngine& engine,
+      std::map<int64_t, IGate::Secrets>& /*revealedSecretsByParty*/)
       override {
     switch (gateType_) {
       case GateType::NonFreeAnd: {
-        throw std::runtime_error("Not implemented");
+        if (numberOfResults_ == 0) {
+          for (auto wireID : outputWireIDs_) {
+            wireKeeper_.setBatchBooleanValue(wireID, {});
+          }
+          break;
+        }
+        auto& result =
+            engine.getBatchCompositeANDExecutionResult(scheduledResultIndex_);
+        for (size_t i = 0; i < outputWireIDs_.size(); i++) {
+          wireKeeper_.setBatchBooleanValue(outputWireIDs_[i], result.at(i));
+        }
         break;
       }
 
@@ -93,6 +120,11 @@ class BatchCompositeGate final : public ICompositeGate {
       wireKeeper_.decreaseBatchReferenceCount(wire);
     }
   }
+
+  uint32_t getReferenceCount(
+      IScheduler::WireId<IScheduler::Boolean> wire) const override {
+    return wireKeeper_.getBatchReferenceCount(wire);
+  }
 };
 
 } // namespace fbpcf::scheduler
@@ -8,6 +8,7 @@
 #pragma once
 
 #include <map>
+#include <stdexcept>
 
 #include "fbpcf/scheduler/gate_keeper/INormalGate.h"
 
@@ -54,7 +55,44 @@ class BatchNormalGate final : public INormalGate<T> {
 
   void compute(
       engine::ISecretShareEngine& engine,
-      std::map<int64_t, std::vector<bool>>& secretSharesByParty) override {
+      std::map<int64_t, IGate::Secrets>& secretSharesByParty) override {
+    if constexpr (T == IScheduler::Boolean) {
+      computeBooleanGate(engine, secretSharesByParty);
+    } else {
+      computeArithmeticGate(engine, secretSharesByParty);
+    }
+  }
+
+  void collectScheduledResult(
+      engine::ISecretShareEngine& engine,
+      std::map<int64_t, IGate::Secrets>& revealedSecretsByParty) override {
+    if constexpr (T == IScheduler::Boolean) {
+      collectBooleanResult(engine, revealedSecretsByParty);
+    } else {
+      collectArithmeticResult(engine, revealedSecretsByParty);
+    }
+  }
+
+  void increaseReferenceCount(IScheduler::WireId<T> wire) override {
+    if (!wire.isEmpty()) {
+      wireKeeper_.increaseBatchReferenceCount(wire);
+    }
+  }
+
+  void decreaseReferenceCount(IScheduler::WireId<T> wire) override {
+    if (!wire.isEmpty()) {
+      wireKeeper_.decreaseBatchReferenceCount(wire);
+    }
+  }
+
+  uint32_t getReferenceCount(IScheduler::WireId<T> wire) const override {
+    return wireKeeper_.getBatchReferenceCount(wire);
+  }
+
+ private:
+  void computeBooleanGate(
+      engine::ISecretShareEngine& engine,
+      std::map<int64_t, IGate::Secrets>& secretSharesByParty) {
     switch (gateType_) {
         // Free gates
       case GateType::AsymmetricNot: {
@@ -106,9 +144,9 @@ class BatchNormalGate final : public INormalGate<T> {
       // Non-free gates
       case GateType::Output: {
         if (secretSharesByParty.find(partyID_) == secretSharesByParty.end()) {
-          secretSharesByParty.emplace(partyID_, std::vector<bool>());
+          secretSharesByParty.emplace(partyID_, IGate::Secrets());
         }
-        auto& secretShares = secretSharesByParty.at(partyID_);
+        auto& secretShares = secretSharesByParty.at(partyID_).booleanSecrets;
         scheduledResultIndex_ = secretShares.size();
 
         auto values = wireKeeper_.getBatchBooleanValue(left_);
@@ -125,26 +163,34 @@ class BatchNormalGate final : public INormalGate<T> {
         if (numberOfResults_ == 0) {
           break;
         }
-        scheduledResultIndex_ =
-            engine.scheduleBatchAND(leftValues, rightValues);
+        // the packed API appends the whole batch a word at a time.
+        scheduledResultIndex_ = engine.scheduleBatchAND(
+            engine::util::PackedBitVector(leftValues),
+            engine::util::PackedBitVector(rightValues));
         break;
       }
+
+      default:
+        throw std::invalid_argument("Not a boolean gate.");
     }
   }
 
-  void collectScheduledResult(
+  void collectBooleanResult(
       engine::ISecretShareEngine& engine,
-      std::map<int64_t, std::vector<bool>>& revealedSecretsByParty) override {
+      std::map<int64_t, IGate::Secrets>& revealedSecretsByParty) {
     switch (gateType_) {
       case GateType::NonFreeAnd: {
         wireKeeper_.setBatchBooleanValue(
-            wireID_, engine.getBatchANDExecutionResult(scheduledResultIndex_));
+            wireID_,
+            engine.getPackedBatchANDExecutionResult(scheduledResultIndex_)
+                .toBoolVector());
         break;
       }
 
       case GateType::Output: {
         auto iterator =
-            revealedSecretsByParty.at(partyID_).begin() + scheduledResultIndex_;
+            revealedSecretsByParty.at(partyID_).booleanSecrets.begin() +
+            scheduledResultIndex_;
         std::vector<bool> results(iterator, iterator + numberOfResults_);
         wireKeeper_.setBatchBooleanValue(wireID_, results);
         break;
@@ -155,15 +201,104 @@ class BatchNormalGate final : public INormalGate<T> {
     }
   }
 
-  void increaseReferenceCount(IScheduler::WireId<T> wire) override {
-    if (!wire.isEmpty()) {
-      wireKeeper_.increaseBatchReferenceCount(wire);
+  void computeArithmeticGate(
+      engine::ISecretShareEngine& engine,
+      std::map<int64_t, IGate::Secrets>& secretSharesByParty) {
+    switch (gateType_) {
+        // Free gates
+      case GateType::AsymmetricPlus: {
+        auto& leftValues = wireKeeper_.getBatchIntegerValue(left_);
+        auto& rightValues = wireKeeper_.getBatchIntegerValue(right_);
+        numberOfResults_ = leftValues.size();
+        wireKeeper_.setBatchIntegerValue(
+            wireID_,
+            engine.computeBatchAsymmetricPlus(leftValues, rightValues));
+        break;
+      }
+
+      case GateType::SymmetricPlus: {
+        auto& leftValues = wireKeeper_.getBatchIntegerValue(left_);
+        auto& rightValues = wireKeeper_.getBatchIntegerValue(right_);
+        numberOfResults_ = leftValues.size();
+        wireKeeper_.setBatchIntegerValue(
+            wireID_,
+            engine.computeBatchSymmetricPlus(leftValues, rightValues));
+        break;
+      }
+
+      case GateType::Neg: {
+        auto& values = wireKeeper_.getBatchIntegerValue(left_);
+        numberOfResults_ = values.size();
+        wireKeeper_.setBatchIntegerValue(
+            wireID_, engine.computeBatchNeg(values));
+        break;
+      }
+
+      case GateType::FreeMult: {
+        auto& leftValues = wireKeeper_.getBatchIntegerValue(left_);
+        auto& rightValues = wireKeeper_.getBatchIntegerValue(right_);
+        numberOfResults_ = leftValues.size();
+        wireKeeper_.setBatchIntegerValue(
+            wireID_, engine.computeBatchFreeMult(leftValues, rightValues));
+        break;
+      }
+
+      case GateType::Input:
+        break;
+
+      // Non-free gates
+      case GateType::Output: {
+        if (secretSharesByParty.find(partyID_) == secretSharesByParty.end()) {
+          secretSharesByParty.emplace(partyID_, IGate::Secrets());
+        }
+        auto& secretShares = secretSharesByParty.at(partyID_).integerSecrets;
+        scheduledResultIndex_ = secretShares.size();
+
+        auto& values = wireKeeper_.getBatchIntegerValue(left_);
+        numberOfResults_ = values.size();
+        secretShares.insert(secretShares.end(), values.begin(), values.end());
+        break;
+      }
+
+      case GateType::NonFreeMult: {
+        auto& leftValues = wireKeeper_.getBatchIntegerValue(left_);
+        auto& rightValues = wireKeeper_.getBatchIntegerValue(right_);
+
+        numberOfResults_ = leftValues.size();
+        if (numberOfResults_ == 0) {
+          break;
+        }
+        scheduledResultIndex_ =
+            engine.scheduleBatchMult(leftValues, rightValues);
+        break;
+      }
+
+      default:
+        throw std::invalid_argument("Not an arithmetic gate.");
     }
   }
 
-  void decreaseReferenceCount(IScheduler::WireId<T> wire) override {
-    if (!wire.isEmpty()) {
-      wireKeeper_.decreaseBatchReferenceCount(wire);
+  void collectArithmeticResult(
+      engine::ISecretShareEngine& engine,
+      std::map<int64_t, IGate::Secrets>& revealedSecretsByParty) {
+    switch (gateType_) {
+      case GateType::NonFreeMult: {
+        wireKeeper_.setBatchIntegerValue(
+            wireID_, engine.getBatchMultExecutionResult(scheduledResultIndex_));
+        break;
+      }
+
+      case GateType::Output: {
+        auto iterator =
+            revealedSecretsByParty.at(partyID_).integerSecrets.begin() +
+            scheduledResultIndex_;
+        std::vector<uint64_t> results(iterator, iterator + numberOfResults_);
+        wireKeeper_.setBatchIntegerValue(wireID_, results);
+        break;
+      }
+
+      default:
+        break;
     }
   }
 };
@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include "fbpcf/scheduler/IScheduler.h"
+#include "fbpcf/scheduler/gate_keeper/INormalGate.h"
+
+namespace fbpcf::scheduler {
+
+/**
+ * An immutable boolean circuit of normal gates, recorded by a gate keeper so
+ * that it can be replayed on other input wires (see
+ * IGateKeeper::startRecording()). The wires of the circuit are numbered from
+ * 0: first its inputs, then the output of each gate in order. Every gate keeps
+ * the level it was added to, relative to the first level of the circuit, so
+ * that replaying the circuit doesn't need to assign levels again.
+ */
+class Circuit {
+ public:
+  using GateType = INormalGate<IScheduler::Boolean>::GateType;
+
+  static constexpr uint32_t kNoWire = std::numeric_limits<uint32_t>::max();
+
+  struct Gate {
+    GateType gateType;
+    // relative to the first level of the circuit, which is free
+    uint32_t level;
+    uint32_t left;
+    uint32_t right;
+    int partyID;
+    // the index of the value of an input gate in the constants
+    uint32_t constant;
+  };
+
+  Circuit(
+      bool usingBatch,
+      uint32_t numberOfInputs,
+      std::vector<Gate> gates,
+      std::vector<std::vector<bool>> constants,
+      std::vector<uint32_t> outputs)
+      : usingBatch_{usingBatch},
+        numberOfInputs_{numberOfInputs},
+        gates_{std::move(gates)},
+        constants_{std::move(constants)},
+        outputs_{std::move(outputs)} {
+    auto numberOfWires = getNumberOfWires();
+    for (size_t i = 0; i < gates_.size(); i++) {
+      auto& gate = gates_.at(i);
+      // a gate only reads the inputs and the outputs of the gates before it
+      if ((gate.left != kNoWire && gate.left >= numberOfInputs_ + i) ||
+          (gate.right != kNoWire && gate.right >= numberOfInputs_ + i)) {
+        throw std::invalid_argument("A gate reads a wire that isn't set yet.");
+      }
+      if (gate.gateType == GateType::Input &&
+          gate.constant >= constants_.size()) {
+        throw std::invalid_argument("An input gate has no value.");
+      }
+    }
+    for (auto output : outputs_) {
+      if (output >= numberOfWires) {
+        throw std::invalid_argument("An output isn't a wire of the circuit.");
+      }
+    }
+    for (auto& gate : gates_) {
+      if (gate.level >= numberOfGatesByLevel_.size()) {
+        numberOfGatesByLevel_.resize(gate.level + 1);
+      }
+      numberOfGatesByLevel_.at(gate.level)++;
+    }
+  }
+
+  // Whether the wires of the circuit are batch wires.
+  bool isBatch() const {
+    return usingBatch_;
+  }
+
+  uint32_t getNumberOfInputs() const {
+    return numberOfInputs_;
+  }
+
+  uint32_t getNumberOfWires() const {
+    return numberOfInputs_ + gates_.size();
+  }
+
+  const std::vector<Gate>& getGates() const {
+    return gates_;
+  }
+
+  const std::vector<bool>& getConstant(uint32_t index) const {
+    return constants_.at(index);
+  }
+
+  const std::vector<uint32_t>& getOutputs() const {
+    return outputs_;
+  }
+
+  // The number of gates at each level of the circuit, so that replaying it
+  // can make room for all of them at once.
+  const std::vector<uint32_t>& getNumberOfGatesByLevel() const {
+    return numberOfGatesByLevel_;
+  }
+
+ private:
+  bool usingBatch_;
+  uint32_t numberOfInputs_;
+  std::vector<Gate> gates_;
+  std::vector<std::vector<bool>> constants_;
+  std::vector<uint32_t> outputs_;
+  std::vector<uint32_t> numberOfGatesByLevel_;
+};
+
+} // namespace fbpcf::scheduler
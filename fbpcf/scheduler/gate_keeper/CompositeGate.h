@@ -50,29 +50,47 @@ class CompositeGate final : public ICompositeGate {
   }
 
   void compute(
-      engine::ISecretShareEngine& /*engine*/,
-      std::map<int64_t, std::vector<bool>>& /*secretSharesByParty*/) override {
+      engine::ISecretShareEngine& engine,
+      std::map<int64_t, IGate::Secrets>& /*secretSharesByParty*/) override {
+    numberOfResults_ = rights_.size();
+    auto leftValue = wireKeeper_.getBooleanValue(left_);
     switch (gateType_) {
         // Free gates
       case GateType::FreeAnd:
-        throw std::runtime_error("Not implemented");
+        for (size_t i = 0; i < rights_.size(); i++) {
+          wireKeeper_.setBooleanValue(
+              outputWireIDs_[i],
+              engine.computeFreeAND(
+                  leftValue, wireKeeper_.getBooleanValue(rights_[i])));
+        }
         break;
 
       // Non-free gates
-      case GateType::NonFreeAnd:
-        throw std::runtime_error("Not implemented");
+      case GateType::NonFreeAnd: {
+        std::vector<bool> rightValues(rights_.size());
+        for (size_t i = 0; i < rights_.size(); i++) {
+          rightValues[i] = wireKeeper_.getBooleanValue(rights_[i]);
+        }
+        scheduledResultIndex_ =
+            engine.scheduleCompositeAND(leftValue, std::move(rightValues));
         break;
+      }
     }
   }
 
   void collectScheduledResult(
-      engine::ISecretShareEngine& /*engine*/,
-      std::map<int64_t, std::vector<bool>>& /*revealedSecretsByParty*/)
+      engine::ISecretShareEngine& engine,
+      std::map<int64_t, IGate::Secrets>& /*revealedSecretsByParty*/)
       override {
     switch (gateType_) {
-      case GateType::NonFreeAnd:
-        throw std::runtime_error("Not implemented");
+      case GateType::NonFreeAnd: {
+        auto& result =
+            engine.getCompositeANDExecutionResult(scheduledResultIndex_);
+        for (size_t i = 0; i < outputWireIDs_.size(); i++) {
+          wireKeeper_.setBooleanValue(outputWireIDs_[i], result.at(i));
+        }
         break;
+      }
 
       default:
         break;
@@ -92,6 +110,11 @@ class CompositeGate final : public ICompositeGate {
       wireKeeper_.decreaseReferenceCount(wire);
     }
   }
+
+  uint32_t getReferenceCount(
+      IScheduler::WireId<IScheduler::Boolean> wire) const override {
+    return wireKeeper_.getReferenceCount(wire);
+  }
 };
 
 } // namespace fbpcf::scheduler
@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <stdexcept>
+#include <vector>
+
+#include "fbpcf/engine/ISecretShareEngine.h"
+#include "fbpcf/scheduler/IScheduler.h"
+#include "fbpcf/scheduler/IWireKeeper.h"
+#include "fbpcf/scheduler/gate_keeper/IGate.h"
+
+namespace fbpcf::scheduler {
+
+/**
+ * This class executes the conversions between boolean and integer wires. A
+ * BooleanToInteger gate reads a number of boolean wires (lsb first) and writes
+ * an integer wire. An IntegerToBooleanSummands gate reads an integer wire and
+ * writes the lowest bits of every party's share of it to boolean wires, party
+ * by party.
+ */
+template <bool usingBatch>
+class ConversionGate final : public IGate {
+ public:
+  enum class GateType {
+    BooleanToInteger,
+    IntegerToBooleanSummands,
+  };
+
+  ConversionGate(
+      GateType gateType,
+      std::vector<IScheduler::WireId<IScheduler::Boolean>> booleanWireIDs,
+      IScheduler::WireId<IScheduler::Arithmetic> integerWireID,
+      int8_t width,
+      IWireKeeper& wireKeeper)
+      : gateType_{gateType},
+        booleanWireIDs_{booleanWireIDs},
+        integerWireID_{integerWireID},
+        width_{width},
+        wireKeeper_{wireKeeper} {
+    for (auto wireID : booleanWireIDs_) {
+      increaseReferenceCount(wireID);
+    }
+    increaseReferenceCount(integerWireID_);
+  }
+
+  ~ConversionGate() override {
+    for (auto wireID : booleanWireIDs_) {
+      decreaseReferenceCount(wireID);
+    }
+    decreaseReferenceCount(integerWireID_);
+  }
+
+  static bool isFree(GateType gateType) {
+    switch (gateType) {
+      case GateType::BooleanToInteger:
+        return false;
+
+      case GateType::IntegerToBooleanSummands:
+        return true;
+    }
+  }
+
+  void compute(
+      engine::ISecretShareEngine& engine,
+      std::map<int64_t, IGate::Secrets>& /*secretSharesByParty*/) override {
+    switch (gateType_) {
+      case GateType::BooleanToInteger: {
+        if constexpr (usingBatch) {
+          std::vector<std::vector<bool>> bits(booleanWireIDs_.size());
+          for (size_t i = 0; i < booleanWireIDs_.size(); i++) {
+            bits[i] = wireKeeper_.getBatchBooleanValue(booleanWireIDs_[i]);
+          }
+          numberOfResults_ = bits.empty() ? 0 : bits.size() * bits[0].size();
+          scheduledResultIndex_ = engine.scheduleBatchBooleanToInteger(bits);
+        } else {
+          std::vector<bool> bits(booleanWireIDs_.size());
+          for (size_t i = 0; i < booleanWireIDs_.size(); i++) {
+            bits[i] = wireKeeper_.getBooleanValue(booleanWireIDs_[i]);
+          }
+          numberOfResults_ = bits.size();
+          scheduledResultIndex_ = engine.scheduleBooleanToInteger(bits);
+        }
+        break;
+      }
+
+      case GateType::IntegerToBooleanSummands: {
+        if constexpr (usingBatch) {
+          auto summands = engine.computeBatchIntegerToBooleanSummands(
+              wireKeeper_.getBatchIntegerValue(integerWireID_), width_);
+          checkNumberOfSummands(summands.size());
+          for (size_t i = 0; i < summands.size(); i++) {
+            numberOfResults_ += summands[i].size();
+            wireKeeper_.setBatchBooleanValue(
+                booleanWireIDs_[i], summands[i]);
+          }
+        } else {
+          auto summands = engine.computeIntegerToBooleanSummands(
+              wireKeeper_.getIntegerValue(integerWireID_), width_);
+          checkNumberOfSummands(summands.size());
+          for (size_t i = 0; i < summands.size(); i++) {
+            wireKeeper_.setBooleanValue(booleanWireIDs_[i], summands[i]);
+          }
+          numberOfResults_ = summands.size();
+        }
+        break;
+      }
+    }
+  }
+
+  void collectScheduledResult(
+      engine::ISecretShareEngine& engine,
+      std::map<int64_t, IGate::Secrets>& /*revealedSecretsByParty*/)
+      override {
+    if (gateType_ != GateType::BooleanToInteger) {
+      return;
+    }
+    if constexpr (usingBatch) {
+      wireKeeper_.setBatchIntegerValue(
+          integerWireID_,
+          engine.getBatchBooleanToIntegerExecutionResult(
+              scheduledResultIndex_));
+    } else {
+      wireKeeper_.setIntegerValue(
+          integerWireID_,
+          engine.getBooleanToIntegerExecutionResult(scheduledResultIndex_));
+    }
+  }
+
+  uint32_t getNumberOfResults() const override {
+    return numberOfResults_;
+  }
+
+  // the summands are inputs of every party, they consume randomness
+  bool canComputeConcurrently() const override {
+    return false;
+  }
+
+  // both conversions consume randomness in step with the other parties
+  bool isDead() const override {
+    return false;
+  }
+
+ private:
+  void checkNumberOfSummands(size_t numberOfSummands) const {
+    if (numberOfSummands != booleanWireIDs_.size()) {
+      throw std::runtime_error(
+          "The number of summands doesn't match the number of output wires.");
+    }
+  }
+
+  template <IScheduler::WireType T>
+  void increaseReferenceCount(IScheduler::WireId<T> wire) {
+    if (!wire.isEmpty()) {
+      if constexpr (usingBatch) {
+        wireKeeper_.increaseBatchReferenceCount(wire);
+      } else {
+        wireKeeper_.increaseReferenceCount(wire);
+      }
+    }
+  }
+
+  template <IScheduler::WireType T>
+  void decreaseReferenceCount(IScheduler::WireId<T> wire) {
+    if (!wire.isEmpty()) {
+      if constexpr (usingBatch) {
+        wireKeeper_.decreaseBatchReferenceCount(wire);
+      } else {
+        wireKeeper_.decreaseReferenceCount(wire);
+      }
+    }
+  }
+
+  GateType gateType_;
+  std::vector<IScheduler::WireId<IScheduler::Boolean>> booleanWireIDs_;
+  IScheduler::WireId<IScheduler::Arithmetic> integerWireID_;
+  int8_t width_;
+  uint32_t scheduledResultIndex_ = 0;
+  uint32_t numberOfResults_ = 0;
+  IWireKeeper& wireKeeper_;
+};
+
+} // namespace fbpcf::scheduler
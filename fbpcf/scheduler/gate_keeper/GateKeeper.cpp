@@ -6,20 +6,31 @@
  */
 
 #include "fbpcf/scheduler/gate_keeper/GateKeeper.h"
+#include <stdexcept>
 #include "fbpcf/scheduler/IScheduler.h"
 #include "fbpcf/scheduler/gate_keeper/BatchCompositeGate.h"
 #include "fbpcf/scheduler/gate_keeper/BatchNormalGate.h"
 #include "fbpcf/scheduler/gate_keeper/CompositeGate.h"
+#include "fbpcf/scheduler/gate_keeper/ConversionGate.h"
 #include "fbpcf/scheduler/gate_keeper/IGate.h"
 #include "fbpcf/scheduler/gate_keeper/NormalGate.h"
+#include "fbpcf/scheduler/gate_keeper/NormalGateArena.h"
 
 namespace fbpcf::scheduler {
-GateKeeper::GateKeeper(std::shared_ptr<IWireKeeper> wireKeeper)
-    : wireKeeper_{wireKeeper} {}
+GateKeeper::GateKeeper(
+    std::shared_ptr<IWireKeeper> wireKeeper,
+    bool useGateArena,
+    uint64_t memoryBudget,
+    bool vectorizeGates)
+    : wireKeeper_{wireKeeper},
+      // the gates are vectorized by their gate arena
+      useGateArena_{useGateArena || vectorizeGates},
+      vectorizeGates_{vectorizeGates},
+      memoryBudget_{memoryBudget} {}
 
 IScheduler::WireId<IScheduler::Boolean> GateKeeper::inputGate(
     BoolType<false> initialValue) {
-  return addGate<false, false>(
+  return addGate<IScheduler::Boolean, false, false>(
       INormalGate<IScheduler::Boolean>::GateType::Input,
       IScheduler::WireId<IScheduler::Boolean>(),
       IScheduler::WireId<IScheduler::Boolean>(),
@@ -28,17 +39,33 @@ IScheduler::WireId<IScheduler::Boolean> GateKeeper::inputGate(
 
 IScheduler::WireId<IScheduler::Boolean> GateKeeper::inputGateBatch(
     BoolType<true> initialValue) {
-  return addGate<true, false>(
+  return addGate<IScheduler::Boolean, true, false>(
       INormalGate<IScheduler::Boolean>::GateType::Input,
       IScheduler::WireId<IScheduler::Boolean>(),
       IScheduler::WireId<IScheduler::Boolean>(),
       initialValue);
 }
 
+IScheduler::WireId<IScheduler::Boolean> GateKeeper::publicInputGate(
+    BoolType<false> initialValue) {
+  auto wire = inputGate(initialValue);
+  updateKnownWires</*usingBatch*/ false>(
+      wire, /*isKnown*/ true, getWireLevel<false>(wire));
+  return wire;
+}
+
+IScheduler::WireId<IScheduler::Boolean> GateKeeper::publicInputGateBatch(
+    BoolType<true> initialValue) {
+  auto wire = inputGateBatch(initialValue);
+  updateKnownWires</*usingBatch*/ true>(
+      wire, /*isKnown*/ true, getWireLevel<true>(wire));
+  return wire;
+}
+
 IScheduler::WireId<IScheduler::Boolean> GateKeeper::outputGate(
     IScheduler::WireId<IScheduler::Boolean> src,
     int partyID) {
-  return addGate<false, false>(
+  return addGate<IScheduler::Boolean, false, false>(
       INormalGate<IScheduler::Boolean>::GateType::Output,
       src,
       IScheduler::WireId<IScheduler::Boolean>(),
@@ -49,7 +76,7 @@ IScheduler::WireId<IScheduler::Boolean> GateKeeper::outputGate(
 IScheduler::WireId<IScheduler::Boolean> GateKeeper::outputGateBatch(
     IScheduler::WireId<IScheduler::Boolean> src,
     int partyID) {
-  return addGate<true, false>(
+  return addGate<IScheduler::Boolean, true, false>(
       INormalGate<IScheduler::Boolean>::GateType::Output,
       src,
       IScheduler::WireId<IScheduler::Boolean>(),
@@ -61,21 +88,78 @@ IScheduler::WireId<IScheduler::Boolean> GateKeeper::normalGate(
     INormalGate<IScheduler::Boolean>::GateType gateType,
     IScheduler::WireId<IScheduler::Boolean> left,
     IScheduler::WireId<IScheduler::Boolean> right) {
-  return addGate<false, false>(gateType, left, right, false);
+  return addGate<IScheduler::Boolean, false, false>(
+      gateType, left, right, false);
 }
 
 IScheduler::WireId<IScheduler::Boolean> GateKeeper::normalGateBatch(
     INormalGate<IScheduler::Boolean>::GateType gateType,
     IScheduler::WireId<IScheduler::Boolean> left,
     IScheduler::WireId<IScheduler::Boolean> right) {
-  return addGate<true, false>(gateType, left, right, {});
+  return addGate<IScheduler::Boolean, true, false>(gateType, left, right, {});
+}
+
+IScheduler::WireId<IScheduler::Arithmetic> GateKeeper::integerInputGate(
+    IntType<false> initialValue) {
+  return addGate<IScheduler::Arithmetic, false, false>(
+      INormalGate<IScheduler::Arithmetic>::GateType::Input,
+      IScheduler::WireId<IScheduler::Arithmetic>(),
+      IScheduler::WireId<IScheduler::Arithmetic>(),
+      initialValue);
+}
+
+IScheduler::WireId<IScheduler::Arithmetic> GateKeeper::integerInputGateBatch(
+    IntType<true> initialValue) {
+  return addGate<IScheduler::Arithmetic, true, false>(
+      INormalGate<IScheduler::Arithmetic>::GateType::Input,
+      IScheduler::WireId<IScheduler::Arithmetic>(),
+      IScheduler::WireId<IScheduler::Arithmetic>(),
+      initialValue);
+}
+
+IScheduler::WireId<IScheduler::Arithmetic> GateKeeper::outputGate(
+    IScheduler::WireId<IScheduler::Arithmetic> src,
+    int partyID) {
+  return addGate<IScheduler::Arithmetic, false, false>(
+      INormalGate<IScheduler::Arithmetic>::GateType::Output,
+      src,
+      IScheduler::WireId<IScheduler::Arithmetic>(),
+      0,
+      partyID);
+}
+
+IScheduler::WireId<IScheduler::Arithmetic> GateKeeper::outputGateBatch(
+    IScheduler::WireId<IScheduler::Arithmetic> src,
+    int partyID) {
+  return addGate<IScheduler::Arithmetic, true, false>(
+      INormalGate<IScheduler::Arithmetic>::GateType::Output,
+      src,
+      IScheduler::WireId<IScheduler::Arithmetic>(),
+      {},
+      partyID);
+}
+
+IScheduler::WireId<IScheduler::Arithmetic> GateKeeper::normalGate(
+    INormalGate<IScheduler::Arithmetic>::GateType gateType,
+    IScheduler::WireId<IScheduler::Arithmetic> left,
+    IScheduler::WireId<IScheduler::Arithmetic> right) {
+  return addGate<IScheduler::Arithmetic, false, false>(
+      gateType, left, right, 0);
+}
+
+IScheduler::WireId<IScheduler::Arithmetic> GateKeeper::normalGateBatch(
+    INormalGate<IScheduler::Arithmetic>::GateType gateType,
+    IScheduler::WireId<IScheduler::Arithmetic> left,
+    IScheduler::WireId<IScheduler::Arithmetic> right) {
+  return addGate<IScheduler::Arithmetic, true, false>(
+      gateType, left, right, {});
 }
 
 std::vector<IScheduler::WireId<IScheduler::Boolean>> GateKeeper::compositeGate(
     ICompositeGate::GateType gateType,
     IScheduler::WireId<IScheduler::Boolean> left,
     std::vector<IScheduler::WireId<IScheduler::Boolean>> rights) {
-  return addGate<false, true>(gateType, left, rights, 0);
+  return addGate<IScheduler::Boolean, false, true>(gateType, left, rights, 0);
 }
 
 std::vector<IScheduler::WireId<IScheduler::Boolean>>
@@ -83,7 +167,34 @@ GateKeeper::compositeGateBatch(
     ICompositeGate::GateType gateType,
     IScheduler::WireId<IScheduler::Boolean> left,
     std::vector<IScheduler::WireId<IScheduler::Boolean>> rights) {
-  return addGate<true, true>(gateType, left, rights, {});
+  return addGate<IScheduler::Boolean, true, true>(gateType, left, rights, {});
+}
+
+IScheduler::WireId<IScheduler::Arithmetic> GateKeeper::booleanToIntegerGate(
+    const std::vector<IScheduler::WireId<IScheduler::Boolean>>& src) {
+  return addBooleanToIntegerGate<false>(src);
+}
+
+IScheduler::WireId<IScheduler::Arithmetic>
+GateKeeper::booleanToIntegerGateBatch(
+    const std::vector<IScheduler::WireId<IScheduler::Boolean>>& src) {
+  return addBooleanToIntegerGate<true>(src);
+}
+
+std::vector<IScheduler::WireId<IScheduler::Boolean>>
+GateKeeper::integerToBooleanSummandsGate(
+    IScheduler::WireId<IScheduler::Arithmetic> src,
+    int8_t width,
+    int numberOfParties) {
+  return addIntegerToBooleanSummandsGate<false>(src, width, numberOfParties);
+}
+
+std::vector<IScheduler::WireId<IScheduler::Boolean>>
+GateKeeper::integerToBooleanSummandsGateBatch(
+    IScheduler::WireId<IScheduler::Arithmetic> src,
+    int8_t width,
+    int numberOfParties) {
+  return addIntegerToBooleanSummandsGate<true>(src, width, numberOfParties);
 }
 
 uint32_t GateKeeper::getFirstUnexecutedLevel() const {
@@ -91,129 +202,862 @@ uint32_t GateKeeper::getFirstUnexecutedLevel() const {
 }
 
 std::vector<std::unique_ptr<IGate>> GateKeeper::popFirstUnexecutedLevel() {
+  maybeRemoveDeadGates();
   auto gates = std::move(gatesByLevelOffset_.front());
   gatesByLevelOffset_.pop_front();
+  for (auto& gateInfo : gateInfosByLevelOffset_.front()) {
+    removeGateInfo(gateInfo);
+  }
+  gateInfosByLevelOffset_.pop_front();
+  removeGateInfo(takenGateInfoByLevelOffset_.front());
+  takenGateInfoByLevelOffset_.pop_front();
   ++firstUnexecutedLevel_;
-  numUnexecutedGates_ -= gates.size();
+  // the levels of the known wires are enough to tell they are known
+  if (firstUnexecutedLevel_ > maxKnownWireLevel_) {
+    knownBooleanWires_.clear();
+    knownBatchBooleanWires_.clear();
+  }
   return gates;
 }
 
-bool GateKeeper::hasReachedBatchingLimit() const {
-  return numUnexecutedGates_ > kMaxUnexecutedGates;
+std::vector<std::unique_ptr<IGate>> GateKeeper::popGatesIndependentOfLevel(
+    uint32_t level) {
+  std::vector<std::unique_ptr<IGate>> independentGates;
+  if (gatesByLevelOffset_.empty() ||
+      !IGateKeeper::isLevelFree(firstUnexecutedLevel_)) {
+    return independentGates;
+  }
+  maybeRemoveDeadGates();
+
+  // keep the remaining gates in the order they were added
+  auto& gates = gatesByLevelOffset_.front();
+  auto& gateInfos = gateInfosByLevelOffset_.front();
+  size_t remaining = 0;
+  for (size_t i = 0; i < gates.size(); i++) {
+    if (gateInfos[i].inputMaxLevel < level) {
+      independentGates.push_back(std::move(gates[i]));
+      // the other parties may have removed a different set of dead gates
+      takeGateInfo(0, gateInfos[i]);
+    } else {
+      gates[remaining] = std::move(gates[i]);
+      gateInfos[remaining] = gateInfos[i];
+      remaining++;
+    }
+  }
+  gates.resize(remaining);
+  gateInfos.resize(remaining);
+  return independentGates;
 }
 
-template <bool usingBatch, bool isCompositeWire>
-GateKeeper::RightWireType<isCompositeWire> GateKeeper::addGate(
-    GateType<isCompositeWire> gateType,
+bool GateKeeper::canFoldGate(
     IScheduler::WireId<IScheduler::Boolean> left,
-    RightWireType<isCompositeWire> right,
-    BoolType<usingBatch> initialValue,
-    int partyID) {
-  numUnexecutedGates_++;
+    IScheduler::WireId<IScheduler::Boolean> right) const {
+  return recording_ == nullptr && isValueKnown</*usingBatch*/ false>(left) &&
+      (right.isEmpty() || isValueKnown</*usingBatch*/ false>(right));
+}
 
-  auto level = getFirstAvailableLevelForNewWire<usingBatch, isCompositeWire>(
-      gateType, left, right);
+bool GateKeeper::canFoldGateBatch(
+    IScheduler::WireId<IScheduler::Boolean> left,
+    IScheduler::WireId<IScheduler::Boolean> right) const {
+  return recording_ == nullptr && isValueKnown</*usingBatch*/ true>(left) &&
+      (right.isEmpty() || isValueKnown</*usingBatch*/ true>(right));
+}
 
-  while (gatesByLevelOffset_.size() <= level - firstUnexecutedLevel_) {
-    gatesByLevelOffset_.emplace_back(std::vector<std::unique_ptr<IGate>>());
+IScheduler::WireId<IScheduler::Boolean> GateKeeper::foldedGate(
+    BoolType<false> value,
+    IScheduler::WireId<IScheduler::Boolean> left,
+    IScheduler::WireId<IScheduler::Boolean> right) {
+  return addFoldedGate</*usingBatch*/ false>(value, left, right);
+}
+
+IScheduler::WireId<IScheduler::Boolean> GateKeeper::foldedGateBatch(
+    BoolType<true> value,
+    IScheduler::WireId<IScheduler::Boolean> left,
+    IScheduler::WireId<IScheduler::Boolean> right) {
+  return addFoldedGate</*usingBatch*/ true>(value, left, right);
+}
+
+bool GateKeeper::hasReachedBatchingLimit() const {
+  return pendingBytes_ > memoryBudget_ ||
+      numUnexecutedGates_ > maxUnexecutedGates_;
+}
+
+void GateKeeper::recordNonFreeLevel(uint64_t numberOfResults) {
+  if (numberOfResults < kMinResultsPerRoundTrip) {
+    // The level mostly waits for the other parties, putting more gates in
+    // each level amortizes the round trips, as long as they fit in memory.
+    if (maxUnexecutedGates_ < kMaxMaxUnexecutedGates &&
+        2 * pendingBytes_ < memoryBudget_) {
+      maxUnexecutedGates_ *= 2;
+    }
+  } else if (numberOfResults > kMaxResultsPerRoundTrip) {
+    // The level is bound by the local computation, which larger levels don't
+    // speed up.
+    if (maxUnexecutedGates_ > kMinMaxUnexecutedGates) {
+      maxUnexecutedGates_ /= 2;
+    }
   }
+}
 
-  auto& gatesForLevel = gatesByLevelOffset_.at(level - firstUnexecutedLevel_);
+template <IScheduler::WireType T, bool usingBatch, bool isCompositeWire>
+GateKeeper::RightWireType<T, isCompositeWire> GateKeeper::addGate(
+    GateType<T, isCompositeWire> gateType,
+    IScheduler::WireId<T> left,
+    RightWireType<T, isCompositeWire> right,
+    ValueType<T, usingBatch> initialValue,
+    int partyID) {
+  auto inputMaxLevel =
+      getInputMaxLevel<T, usingBatch, isCompositeWire>(left, right);
+  auto level = getFirstAvailableLevel(
+      inputMaxLevel, GateClass<T, isCompositeWire>::isFree(gateType));
 
-  RightWireType<isCompositeWire> outputWire;
   if constexpr (isCompositeWire) {
+    static_assert(
+        T == IScheduler::Boolean, "Composite gates only take boolean wires.");
+    if (recording_ != nullptr) {
+      throw std::invalid_argument("Composite gates can't be recorded.");
+    }
+    numUnexecutedGates_++;
+    gatesAddedSinceSweep_++;
+
+    std::unique_ptr<IGate> gate;
+    uint64_t numberOfBytes = 0;
+    RightWireType<T, isCompositeWire> outputWire;
     if constexpr (usingBatch) {
+      auto batchSize = getBatchSize(left);
       for (size_t i = 0; i < right.size(); i++) {
         outputWire.push_back(wireKeeper_->allocateBatchBooleanValue({}, level));
+        setBatchSize(outputWire.back(), batchSize);
+        updateKnownWires<usingBatch>(
+            outputWire.back(), /*isKnown*/ false, level);
       }
-      gatesForLevel.push_back(std::make_unique<BatchCompositeGate>(
-          gateType, outputWire, left, right, 0, *wireKeeper_));
+      numberOfBytes = right.size() * getValueBytes<T, usingBatch>(batchSize);
+      gate = std::make_unique<BatchCompositeGate>(
+          gateType, outputWire, left, right, 0, *wireKeeper_);
     } else {
       for (size_t i = 0; i < right.size(); i++) {
         outputWire.push_back(wireKeeper_->allocateBooleanValue(0, level));
+        updateKnownWires<usingBatch>(
+            outputWire.back(), /*isKnown*/ false, level);
       }
-      gatesForLevel.push_back(std::make_unique<CompositeGate>(
-          gateType, outputWire, left, right, *wireKeeper_));
+      numberOfBytes = right.size() * getValueBytes<T, usingBatch>(1);
+      gate = std::make_unique<CompositeGate>(
+          gateType, outputWire, left, right, *wireKeeper_);
     }
+    addGateToLevel(level, inputMaxLevel, std::move(gate), numberOfBytes);
+    return outputWire;
   } else {
-    if constexpr (usingBatch) {
-      outputWire = wireKeeper_->allocateBatchBooleanValue(initialValue, level);
-      auto numberOfResults = initialValue.size();
-      gatesForLevel.push_back(
-          std::make_unique<BatchNormalGate<IScheduler::Boolean>>(
-              gateType,
-              outputWire,
-              left,
-              right,
-              partyID,
-              numberOfResults,
-              *wireKeeper_));
+    if (recording_ == nullptr) {
+      return addNormalGate<T, usingBatch>(
+          level, inputMaxLevel, gateType, left, right, initialValue, partyID);
+    }
+    auto recordedGate = getRecordedGate<T, usingBatch>(
+        gateType, left, right, initialValue, partyID, level);
+    auto outputWire = addNormalGate<T, usingBatch>(
+        level, inputMaxLevel, gateType, left, right, initialValue, partyID);
+    recording_->gates.push_back(recordedGate);
+    recording_->wireIndexes[outputWire.getId()] =
+        recording_->numberOfInputs + recording_->gates.size() - 1;
+    return outputWire;
+  }
+}
+
+template <IScheduler::WireType T, bool usingBatch>
+IScheduler::WireId<T> GateKeeper::addNormalGate(
+    uint32_t level,
+    uint32_t inputMaxLevel,
+    typename INormalGate<T>::GateType gateType,
+    IScheduler::WireId<T> left,
+    IScheduler::WireId<T> right,
+    ValueType<T, usingBatch> initialValue,
+    int partyID) {
+  numUnexecutedGates_++;
+  gatesAddedSinceSweep_++;
 
+  std::unique_ptr<IGate> gate;
+  uint64_t numberOfBytes = 0;
+  uint64_t numberOfANDs = 0;
+  IScheduler::WireId<T> outputWire;
+  if constexpr (usingBatch) {
+    if constexpr (T == IScheduler::Boolean) {
+      outputWire = wireKeeper_->allocateBatchBooleanValue(initialValue, level);
+      updateKnownWires<usingBatch>(outputWire, /*isKnown*/ false, level);
     } else {
+      outputWire = wireKeeper_->allocateBatchIntegerValue(initialValue, level);
+    }
+    // only input gates are given their values, the other gates take the
+    // batch size of their input
+    auto batchSize = left.isEmpty() ? initialValue.size() : getBatchSize(left);
+    setBatchSize(outputWire, batchSize);
+    numberOfBytes = getValueBytes<T, usingBatch>(batchSize);
+    if (T == IScheduler::Boolean &&
+        gateType == INormalGate<T>::GateType::NonFreeAnd) {
+      numberOfANDs = batchSize;
+    }
+    auto numberOfResults = initialValue.size();
+    gate = std::make_unique<BatchNormalGate<T>>(
+        gateType,
+        outputWire,
+        left,
+        right,
+        partyID,
+        numberOfResults,
+        *wireKeeper_);
+
+  } else {
+    if constexpr (T == IScheduler::Boolean) {
       outputWire = wireKeeper_->allocateBooleanValue(initialValue, level);
-      gatesForLevel.push_back(std::make_unique<NormalGate<IScheduler::Boolean>>(
-          gateType, outputWire, left, right, partyID, *wireKeeper_));
+      updateKnownWires<usingBatch>(outputWire, /*isKnown*/ false, level);
+    } else {
+      outputWire = wireKeeper_->allocateIntegerValue(initialValue, level);
+    }
+    numberOfBytes = getValueBytes<T, usingBatch>(1);
+    if (useGateArena_) {
+      addGateToArena<T>(
+          level, inputMaxLevel, gateType, outputWire, left, right, partyID);
+      addPendingBytes(numberOfBytes);
+      return outputWire;
+    }
+    gate = std::make_unique<NormalGate<T>>(
+        gateType, outputWire, left, right, partyID, *wireKeeper_);
+    if (T == IScheduler::Boolean &&
+        gateType == INormalGate<T>::GateType::NonFreeAnd) {
+      numberOfANDs = 1;
     }
   }
 
+  addGateToLevel(
+      level, inputMaxLevel, std::move(gate), numberOfBytes, numberOfANDs);
   return outputWire;
 }
 
-// Free gates are added to even levels, and non-free gates are added to odd
-// levels. A gate can depend on a free gate at the same level, but cannot
-// depend on a non-free gate at the same level.
-template <bool usingBatch, bool isCompositeWire>
-uint32_t GateKeeper::getFirstAvailableLevelForNewWire(
-    GateType<isCompositeWire> gateType,
-    IScheduler::WireId<IScheduler::Boolean> left,
-    RightWireType<isCompositeWire> right) const {
-  uint32_t leftMaxLevel = 0;
-  if (left.isEmpty()) {
-    leftMaxLevel = 0;
-  } else if constexpr (usingBatch) {
-    leftMaxLevel = wireKeeper_->getBatchFirstAvailableLevel(left);
+template <bool usingBatch>
+IScheduler::WireId<IScheduler::Arithmetic> GateKeeper::addBooleanToIntegerGate(
+    const std::vector<IScheduler::WireId<IScheduler::Boolean>>& src) {
+  if (recording_ != nullptr) {
+    throw std::invalid_argument("Conversion gates can't be recorded.");
+  }
+  numUnexecutedGates_++;
+  gatesAddedSinceSweep_++;
+
+  using Gate = ConversionGate<usingBatch>;
+  uint32_t inputMaxLevel = 0;
+  for (auto wire : src) {
+    inputMaxLevel = std::max(inputMaxLevel, getWireLevel<usingBatch>(wire));
+  }
+  auto level = getFirstAvailableLevel(
+      inputMaxLevel, Gate::isFree(Gate::GateType::BooleanToInteger));
+
+  IScheduler::WireId<IScheduler::Arithmetic> outputWire;
+  size_t batchSize = 1;
+  if constexpr (usingBatch) {
+    outputWire = wireKeeper_->allocateBatchIntegerValue({}, level);
+    batchSize = src.empty() ? 0 : getBatchSize(src.at(0));
+    setBatchSize(outputWire, batchSize);
   } else {
-    leftMaxLevel = wireKeeper_->getFirstAvailableLevel(left);
+    outputWire = wireKeeper_->allocateIntegerValue(0, level);
   }
+  addGateToLevel(
+      level,
+      inputMaxLevel,
+      std::make_unique<Gate>(
+          Gate::GateType::BooleanToInteger, src, outputWire, 0, *wireKeeper_),
+      getValueBytes<IScheduler::Arithmetic, usingBatch>(batchSize));
+  return outputWire;
+}
 
-  uint32_t rightMaxLevel = 0;
-  if constexpr (isCompositeWire) {
-    for (auto rightWire : right) {
-      if (!rightWire.isEmpty()) {
-        if constexpr (usingBatch) {
-          rightMaxLevel = std::max(
-              rightMaxLevel,
-              wireKeeper_->getBatchFirstAvailableLevel(rightWire));
-        } else {
-          rightMaxLevel = std::max(
-              rightMaxLevel, wireKeeper_->getFirstAvailableLevel(rightWire));
-        }
+template <bool usingBatch>
+std::vector<IScheduler::WireId<IScheduler::Boolean>>
+GateKeeper::addIntegerToBooleanSummandsGate(
+    IScheduler::WireId<IScheduler::Arithmetic> src,
+    int8_t width,
+    int numberOfParties) {
+  if (recording_ != nullptr) {
+    throw std::invalid_argument("Conversion gates can't be recorded.");
+  }
+  numUnexecutedGates_++;
+  gatesAddedSinceSweep_++;
+
+  using Gate = ConversionGate<usingBatch>;
+  auto inputMaxLevel = getWireLevel<usingBatch>(src);
+  auto level = getFirstAvailableLevel(
+      inputMaxLevel, Gate::isFree(Gate::GateType::IntegerToBooleanSummands));
+
+  std::vector<IScheduler::WireId<IScheduler::Boolean>> outputWires;
+  size_t batchSize = 1;
+  if constexpr (usingBatch) {
+    batchSize = getBatchSize(src);
+  }
+  for (int i = 0; i < numberOfParties * width; i++) {
+    if constexpr (usingBatch) {
+      outputWires.push_back(wireKeeper_->allocateBatchBooleanValue({}, level));
+      setBatchSize(outputWires.back(), batchSize);
+    } else {
+      outputWires.push_back(wireKeeper_->allocateBooleanValue(0, level));
+    }
+    updateKnownWires<usingBatch>(
+        outputWires.back(), /*isKnown*/ false, level);
+  }
+  addGateToLevel(
+      level,
+      inputMaxLevel,
+      std::make_unique<Gate>(
+          Gate::GateType::IntegerToBooleanSummands,
+          outputWires,
+          src,
+          width,
+          *wireKeeper_),
+      outputWires.size() *
+          getValueBytes<IScheduler::Boolean, usingBatch>(batchSize));
+  return outputWires;
+}
+
+size_t GateKeeper::getLevelOffset(uint32_t level) {
+  size_t offset = level - firstUnexecutedLevel_;
+  while (gatesByLevelOffset_.size() <= offset) {
+    gatesByLevelOffset_.emplace_back(std::vector<std::unique_ptr<IGate>>());
+    gateInfosByLevelOffset_.emplace_back(std::vector<GateInfo>());
+    takenGateInfoByLevelOffset_.push_back(GateInfo{0, 0, 0, 0});
+  }
+  return offset;
+}
+
+void GateKeeper::addGateToLevel(
+    uint32_t level,
+    uint32_t inputMaxLevel,
+    std::unique_ptr<IGate> gate,
+    uint64_t numberOfBytes,
+    uint64_t numberOfANDs) {
+  auto offset = getLevelOffset(level);
+  gatesByLevelOffset_.at(offset).push_back(std::move(gate));
+  gateInfosByLevelOffset_.at(offset).push_back(GateInfo{
+      inputMaxLevel, /*numberOfGates*/ 1, numberOfBytes, numberOfANDs});
+  addPendingBytes(numberOfBytes);
+  pendingANDs_ += numberOfANDs;
+}
+
+template <IScheduler::WireType T>
+void GateKeeper::addGateToArena(
+    uint32_t level,
+    uint32_t inputMaxLevel,
+    typename INormalGate<T>::GateType gateType,
+    IScheduler::WireId<T> outputWire,
+    IScheduler::WireId<T> left,
+    IScheduler::WireId<T> right,
+    int partyID) {
+  auto offset = getLevelOffset(level);
+  getLastArena<T>(offset, inputMaxLevel)
+      .addGate(gateType, outputWire, left, right, partyID);
+  auto& gateInfo = gateInfosByLevelOffset_.at(offset).back();
+  gateInfo.inputMaxLevel = std::max(gateInfo.inputMaxLevel, inputMaxLevel);
+  gateInfo.numberOfGates++;
+  gateInfo.numberOfBytes += getValueBytes<T, /*usingBatch*/ false>(1);
+  if (T == IScheduler::Boolean &&
+      gateType == INormalGate<T>::GateType::NonFreeAnd) {
+    gateInfo.numberOfANDs++;
+    pendingANDs_++;
+  }
+}
+
+template <IScheduler::WireType T>
+NormalGateArena<T>& GateKeeper::getLastArena(
+    size_t offset,
+    uint32_t inputMaxLevel) {
+  auto& gates = gatesByLevelOffset_.at(offset);
+
+  // only the last gate of a level can be extended, so that the gates are
+  // still computed in the order they were added
+  auto arena = gates.empty()
+      ? nullptr
+      : dynamic_cast<NormalGateArena<T>*>(gates.back().get());
+  if (arena == nullptr) {
+    auto newArena =
+        std::make_unique<NormalGateArena<T>>(*wireKeeper_, vectorizeGates_);
+    arena = newArena.get();
+    gates.push_back(std::move(newArena));
+    gateInfosByLevelOffset_.at(offset).push_back(GateInfo{
+        inputMaxLevel,
+        /*numberOfGates*/ 0,
+        /*numberOfBytes*/ 0,
+        /*numberOfANDs*/ 0});
+  }
+  return *arena;
+}
+
+template <IScheduler::WireType T>
+size_t GateKeeper::getBatchSize(IScheduler::WireId<T> wire) const {
+  // the values of the wires that haven't been computed are still empty
+  if (getWireLevel</*usingBatch*/ true>(wire) >= firstUnexecutedLevel_) {
+    auto& batchSizes =
+        T == IScheduler::Boolean ? booleanBatchSizes_ : integerBatchSizes_;
+    auto iter = batchSizes.find(wire.getId());
+    if (iter != batchSizes.end()) {
+      return iter->second;
+    }
+  }
+  if constexpr (T == IScheduler::Boolean) {
+    return wireKeeper_->getBatchBooleanValue(wire).size();
+  } else {
+    return wireKeeper_->getBatchIntegerValue(wire).size();
+  }
+}
+
+template <IScheduler::WireType T>
+void GateKeeper::setBatchSize(IScheduler::WireId<T> wire, size_t batchSize) {
+  if constexpr (T == IScheduler::Boolean) {
+    booleanBatchSizes_[wire.getId()] = batchSize;
+  } else {
+    integerBatchSizes_[wire.getId()] = batchSize;
+  }
+}
+
+template <IScheduler::WireType T, bool usingBatch>
+uint64_t GateKeeper::getValueBytes(size_t batchSize) {
+  if constexpr (T == IScheduler::Boolean) {
+    // batches of booleans are stored as bits
+    return usingBatch ? (batchSize + 7) / 8 : sizeof(bool);
+  } else {
+    return batchSize * sizeof(uint64_t);
+  }
+}
+
+void GateKeeper::addPendingBytes(uint64_t numberOfBytes) {
+  pendingBytes_ += numberOfBytes;
+  peakPendingBytes_ = std::max(peakPendingBytes_, pendingBytes_);
+}
+
+void GateKeeper::removeGateInfo(const GateInfo& gateInfo) {
+  numUnexecutedGates_ -= gateInfo.numberOfGates;
+  pendingBytes_ -= gateInfo.numberOfBytes;
+  pendingANDs_ -= gateInfo.numberOfANDs;
+}
+
+void GateKeeper::takeGateInfo(size_t offset, const GateInfo& gateInfo) {
+  auto& takenGateInfo = takenGateInfoByLevelOffset_.at(offset);
+  takenGateInfo.numberOfGates += gateInfo.numberOfGates;
+  takenGateInfo.numberOfBytes += gateInfo.numberOfBytes;
+  takenGateInfo.numberOfANDs += gateInfo.numberOfANDs;
+}
+
+void GateKeeper::decreaseReferenceCount(
+    IScheduler::WireId<IScheduler::Boolean> id) {
+  decreaseReferenceCount</*usingBatch*/ false>(id);
+}
+
+void GateKeeper::decreaseReferenceCount(
+    IScheduler::WireId<IScheduler::Arithmetic> id) {
+  decreaseReferenceCount</*usingBatch*/ false>(id);
+}
+
+void GateKeeper::decreaseReferenceCountBatch(
+    IScheduler::WireId<IScheduler::Boolean> id) {
+  decreaseReferenceCount</*usingBatch*/ true>(id);
+}
+
+void GateKeeper::decreaseReferenceCountBatch(
+    IScheduler::WireId<IScheduler::Arithmetic> id) {
+  decreaseReferenceCount</*usingBatch*/ true>(id);
+}
+
+template <bool usingBatch, IScheduler::WireType T>
+void GateKeeper::decreaseReferenceCount(IScheduler::WireId<T> id) {
+  if constexpr (usingBatch) {
+    // the caller and the gate of the wire hold the last references
+    if (!mayHaveDeadGates_ &&
+        wireKeeper_->getBatchReferenceCount(id) == 2 &&
+        getWireLevel<usingBatch>(id) >= firstUnexecutedLevel_) {
+      mayHaveDeadGates_ = true;
+    }
+    wireKeeper_->decreaseBatchReferenceCount(id);
+  } else {
+    if (!mayHaveDeadGates_ && wireKeeper_->getReferenceCount(id) == 2 &&
+        getWireLevel<usingBatch>(id) >= firstUnexecutedLevel_) {
+      mayHaveDeadGates_ = true;
+    }
+    wireKeeper_->decreaseReferenceCount(id);
+  }
+}
+
+void GateKeeper::maybeRemoveDeadGates() {
+  if (!mayHaveDeadGates_ ||
+      4 * gatesAddedSinceSweep_ < numUnexecutedGates_) {
+    return;
+  }
+  mayHaveDeadGates_ = false;
+  gatesAddedSinceSweep_ = 0;
+  removeDeadGates();
+}
+
+void GateKeeper::removeDeadGates() {
+  for (size_t offset = gatesByLevelOffset_.size(); offset-- > 0;) {
+    auto& gates = gatesByLevelOffset_.at(offset);
+    auto& gateInfos = gateInfosByLevelOffset_.at(offset);
+    bool hasDeadGates = false;
+    // a gate may read the free gates before it in the same level
+    for (size_t i = gates.size(); i-- > 0;) {
+      if (useGateArena_) {
+        removeDeadGatesFromArena<IScheduler::Boolean>(
+            offset, *gates[i], gateInfos[i]);
+        removeDeadGatesFromArena<IScheduler::Arithmetic>(
+            offset, *gates[i], gateInfos[i]);
+      }
+      if (gates[i]->isDead()) {
+        // releasing its wires may make the gates it reads dead
+        numberOfDeadGates_ += gateInfos[i].numberOfGates;
+        takeGateInfo(offset, gateInfos[i]);
+        gates[i] = nullptr;
+        hasDeadGates = true;
+      }
+    }
+    if (!hasDeadGates) {
+      continue;
+    }
+
+    // keep the remaining gates in the order they were added
+    size_t remaining = 0;
+    for (size_t i = 0; i < gates.size(); i++) {
+      if (gates[i] != nullptr) {
+        gates[remaining] = std::move(gates[i]);
+        gateInfos[remaining] = gateInfos[i];
+        remaining++;
       }
     }
+    gates.resize(remaining);
+    gateInfos.resize(remaining);
+  }
+}
+
+template <IScheduler::WireType T>
+void GateKeeper::removeDeadGatesFromArena(
+    size_t offset,
+    IGate& gate,
+    GateInfo& gateInfo) {
+  auto arena = dynamic_cast<NormalGateArena<T>*>(&gate);
+  if (arena == nullptr) {
+    return;
+  }
+  auto numberOfGates = arena->removeDeadGates();
+  auto numberOfANDs = T == IScheduler::Boolean
+      ? arena->getNumberOfGates(INormalGate<T>::GateType::NonFreeAnd)
+      : 0;
+  GateInfo deadGateInfo{
+      gateInfo.inputMaxLevel,
+      numberOfGates,
+      numberOfGates * getValueBytes<T, /*usingBatch*/ false>(1),
+      gateInfo.numberOfANDs - numberOfANDs};
+  gateInfo.numberOfGates -= deadGateInfo.numberOfGates;
+  gateInfo.numberOfBytes -= deadGateInfo.numberOfBytes;
+  gateInfo.numberOfANDs -= deadGateInfo.numberOfANDs;
+  numberOfDeadGates_ += deadGateInfo.numberOfGates;
+  takeGateInfo(offset, deadGateInfo);
+}
+
+template <bool usingBatch>
+IScheduler::WireId<IScheduler::Boolean> GateKeeper::addFoldedGate(
+    BoolType<usingBatch> value,
+    IScheduler::WireId<IScheduler::Boolean> left,
+    IScheduler::WireId<IScheduler::Boolean> right) {
+  numberOfFoldedGates_++;
+  auto level = getFirstAvailableLevel(
+      getInputMaxLevel<IScheduler::Boolean, usingBatch, false>(left, right),
+      /*isFreeGate*/ true);
+  IScheduler::WireId<IScheduler::Boolean> wire;
+  if constexpr (usingBatch) {
+    wire = wireKeeper_->allocateBatchBooleanValue(value, level);
+    setBatchSize(wire, value.size());
+  } else {
+    wire = wireKeeper_->allocateBooleanValue(value, level);
+  }
+  updateKnownWires<usingBatch>(wire, /*isKnown*/ true, level);
+  return wire;
+}
+
+template <bool usingBatch>
+bool GateKeeper::isValueKnown(
+    IScheduler::WireId<IScheduler::Boolean> wire) const {
+  if (getWireLevel<usingBatch>(wire) < firstUnexecutedLevel_) {
+    return true;
+  }
+  auto& knownWires =
+      usingBatch ? knownBatchBooleanWires_ : knownBooleanWires_;
+  return knownWires.find(wire.getId()) != knownWires.end();
+}
+
+template <bool usingBatch>
+void GateKeeper::updateKnownWires(
+    IScheduler::WireId<IScheduler::Boolean> wire,
+    bool isKnown,
+    uint32_t level) {
+  auto& knownWires =
+      usingBatch ? knownBatchBooleanWires_ : knownBooleanWires_;
+  if (isKnown) {
+    knownWires.insert(wire.getId());
+    maxKnownWireLevel_ = std::max(maxKnownWireLevel_, level);
+  } else if (!knownWires.empty()) {
+    // the wire id may have been used by a known wire before
+    knownWires.erase(wire.getId());
+  }
+}
+
+void GateKeeper::startRecording(
+    const std::vector<IScheduler::WireId<IScheduler::Boolean>>& inputs) {
+  startRecording(inputs, /*usingBatch*/ false);
+}
+
+void GateKeeper::startRecordingBatch(
+    const std::vector<IScheduler::WireId<IScheduler::Boolean>>& inputs) {
+  startRecording(inputs, /*usingBatch*/ true);
+}
+
+void GateKeeper::startRecording(
+    const std::vector<IScheduler::WireId<IScheduler::Boolean>>& inputs,
+    bool usingBatch) {
+  if (recording_ != nullptr) {
+    throw std::runtime_error("A circuit is already being recorded.");
+  }
+  recording_ = std::make_unique<Recording>();
+  recording_->usingBatch = usingBatch;
+  recording_->numberOfInputs = inputs.size();
+  for (size_t i = 0; i < inputs.size(); i++) {
+    recording_->wireIndexes[inputs.at(i).getId()] = i;
+  }
+}
+
+std::shared_ptr<const Circuit> GateKeeper::stopRecording(
+    const std::vector<IScheduler::WireId<IScheduler::Boolean>>& outputs) {
+  if (recording_ == nullptr) {
+    throw std::runtime_error("No circuit is being recorded.");
+  }
+  std::vector<uint32_t> outputIndexes;
+  for (auto output : outputs) {
+    outputIndexes.push_back(recording_->getWireIndex(output));
+  }
+  auto recording = std::move(recording_);
+
+  // make the levels relative to the first free level of the circuit
+  uint32_t firstLevel = UINT32_MAX;
+  for (auto& gate : recording->gates) {
+    firstLevel = std::min(firstLevel, gate.level);
+  }
+  firstLevel &= ~1U;
+  for (auto& gate : recording->gates) {
+    gate.level -= firstLevel;
+  }
+
+  return std::make_shared<const Circuit>(
+      recording->usingBatch,
+      recording->numberOfInputs,
+      std::move(recording->gates),
+      std::move(recording->constants),
+      std::move(outputIndexes));
+}
+
+std::vector<IScheduler::WireId<IScheduler::Boolean>> GateKeeper::addCircuit(
+    const Circuit& circuit,
+    const std::vector<IScheduler::WireId<IScheduler::Boolean>>& inputs) {
+  if (circuit.isBatch()) {
+    return addCircuit</*usingBatch*/ true>(circuit, inputs);
   } else {
-    if (right.isEmpty()) {
-      rightMaxLevel = 0;
-    } else if constexpr (usingBatch) {
-      rightMaxLevel = wireKeeper_->getBatchFirstAvailableLevel(right);
+    return addCircuit</*usingBatch*/ false>(circuit, inputs);
+  }
+}
+
+template <bool usingBatch>
+std::vector<IScheduler::WireId<IScheduler::Boolean>> GateKeeper::addCircuit(
+    const Circuit& circuit,
+    const std::vector<IScheduler::WireId<IScheduler::Boolean>>& inputs) {
+  if (recording_ != nullptr) {
+    throw std::runtime_error("Circuits can't be added while recording.");
+  }
+  if (inputs.size() != circuit.getNumberOfInputs()) {
+    throw std::invalid_argument(
+        "The circuit takes a different number of inputs.");
+  }
+
+  std::vector<IScheduler::WireId<IScheduler::Boolean>> wires(inputs);
+  std::vector<uint32_t> wireLevels;
+  wires.reserve(circuit.getNumberOfWires());
+  wireLevels.reserve(circuit.getNumberOfWires());
+
+  // the circuit starts at a free level where all its inputs are available
+  uint32_t firstLevel = firstUnexecutedLevel_;
+  for (auto input : inputs) {
+    wireLevels.push_back(getWireLevel<usingBatch>(input));
+    firstLevel = std::max(firstLevel, wireLevels.back());
+  }
+  firstLevel += firstLevel & 1;
+  reserveLevels<usingBatch>(firstLevel, circuit.getNumberOfGatesByLevel());
+
+  auto getWire = [&wires](uint32_t index) {
+    return index == Circuit::kNoWire ? IScheduler::WireId<IScheduler::Boolean>()
+                                     : wires.at(index);
+  };
+  auto getLevel = [&wireLevels](uint32_t index) {
+    return index == Circuit::kNoWire ? 0 : wireLevels.at(index);
+  };
+  // only input gates have a value
+  const std::vector<bool> noValue;
+  using InitialValue = ValueType<IScheduler::Boolean, usingBatch>;
+  auto getInitialValue = [&circuit,
+                          &noValue](const Circuit::Gate& gate) -> InitialValue {
+    auto& value = gate.gateType == Circuit::GateType::Input
+        ? circuit.getConstant(gate.constant)
+        : noValue;
+    if constexpr (usingBatch) {
+      return value;
+    } else {
+      return !value.empty() && value.at(0);
+    }
+  };
+  for (auto& gate : circuit.getGates()) {
+    auto level = firstLevel + gate.level;
+    auto inputMaxLevel = std::max(getLevel(gate.left), getLevel(gate.right));
+    wires.push_back(addNormalGate<IScheduler::Boolean, usingBatch>(
+        level,
+        inputMaxLevel,
+        gate.gateType,
+        getWire(gate.left),
+        getWire(gate.right),
+        getInitialValue(gate),
+        gate.partyID));
+    wireLevels.push_back(level);
+  }
+
+  // the caller only holds the outputs of the circuit, the gates keep the other
+  // wires alive until they are executed.
+  std::vector<IScheduler::WireId<IScheduler::Boolean>> outputs;
+  for (auto index : circuit.getOutputs()) {
+    outputs.push_back(wires.at(index));
+    if constexpr (usingBatch) {
+      wireKeeper_->increaseBatchReferenceCount(outputs.back());
+    } else {
+      wireKeeper_->increaseReferenceCount(outputs.back());
+    }
+  }
+  for (size_t i = circuit.getNumberOfInputs(); i < wires.size(); i++) {
+    decreaseReferenceCount<usingBatch>(wires.at(i));
+  }
+  return outputs;
+}
+
+template <bool usingBatch>
+void GateKeeper::reserveLevels(
+    uint32_t firstLevel,
+    const std::vector<uint32_t>& numberOfGatesByLevel) {
+  if (numberOfGatesByLevel.empty()) {
+    return;
+  }
+  getLevelOffset(firstLevel + numberOfGatesByLevel.size() - 1);
+  // keep growing geometrically, as the same levels may be reserved for many
+  // replays in a row
+  auto reserve = [](auto& gates, size_t numberOfGates) {
+    auto capacity = gates.size() + numberOfGates;
+    if (capacity > gates.capacity()) {
+      gates.reserve(std::max(capacity, 2 * gates.capacity()));
+    }
+  };
+  for (size_t i = 0; i < numberOfGatesByLevel.size(); i++) {
+    auto numberOfGates = numberOfGatesByLevel.at(i);
+    if (numberOfGates == 0) {
+      continue;
+    }
+    auto offset = firstLevel + i - firstUnexecutedLevel_;
+    if (!usingBatch && useGateArena_) {
+      // the arena is extended by the gates of the circuit, which max its
+      // input level with their own
+      getLastArena<IScheduler::Boolean>(offset, /*inputMaxLevel*/ 0)
+          .reserveGates(numberOfGates);
     } else {
-      rightMaxLevel = wireKeeper_->getFirstAvailableLevel(right);
+      reserve(gatesByLevelOffset_.at(offset), numberOfGates);
+      reserve(gateInfosByLevelOffset_.at(offset), numberOfGates);
+    }
+  }
+}
+
+template <IScheduler::WireType T, bool usingBatch>
+Circuit::Gate GateKeeper::getRecordedGate(
+    typename INormalGate<T>::GateType gateType,
+    IScheduler::WireId<T> left,
+    IScheduler::WireId<T> right,
+    ValueType<T, usingBatch> initialValue,
+    int partyID,
+    uint32_t level) {
+  if constexpr (T != IScheduler::Boolean) {
+    throw std::invalid_argument("Only boolean gates can be recorded.");
+  } else {
+    if (usingBatch != recording_->usingBatch) {
+      throw std::invalid_argument(
+          "Batch and non-batch gates can't be recorded together.");
+    }
+    Circuit::Gate gate{
+        gateType,
+        level,
+        left.isEmpty() ? Circuit::kNoWire : recording_->getWireIndex(left),
+        right.isEmpty() ? Circuit::kNoWire : recording_->getWireIndex(right),
+        partyID,
+        0};
+    if (gateType == Circuit::GateType::Input) {
+      gate.constant = recording_->constants.size();
+      if constexpr (usingBatch) {
+        recording_->constants.push_back(initialValue);
+      } else {
+        recording_->constants.push_back({initialValue});
+      }
     }
+    return gate;
   }
+}
 
-  auto isFreeGate = GateClass<isCompositeWire>::isFree(gateType);
+uint32_t GateKeeper::Recording::getWireIndex(
+    IScheduler::WireId<IScheduler::Boolean> wire) const {
+  auto iter = wireIndexes.find(wire.getId());
+  if (iter == wireIndexes.end()) {
+    throw std::invalid_argument(
+        "The wire isn't an input of the circuit or written by its gates.");
+  }
+  return iter->second;
+}
 
-  auto minAvailableLeft = leftMaxLevel +
-      (IGateKeeper::isLevelFree(leftMaxLevel) ? (isFreeGate ? 0 : 1)
-                                              : (isFreeGate ? 1 : 2));
-  auto minAvailableRight = rightMaxLevel +
-      (IGateKeeper::isLevelFree(rightMaxLevel) ? (isFreeGate ? 0 : 1)
+template <bool usingBatch, IScheduler::WireType T>
+uint32_t GateKeeper::getWireLevel(IScheduler::WireId<T> wire) const {
+  if (wire.isEmpty()) {
+    return 0;
+  } else if constexpr (usingBatch) {
+    return wireKeeper_->getBatchFirstAvailableLevel(wire);
+  } else {
+    return wireKeeper_->getFirstAvailableLevel(wire);
+  }
+}
+
+template <IScheduler::WireType T, bool usingBatch, bool isCompositeWire>
+uint32_t GateKeeper::getInputMaxLevel(
+    IScheduler::WireId<T> left,
+    RightWireType<T, isCompositeWire> right) const {
+  uint32_t inputMaxLevel = getWireLevel<usingBatch>(left);
+  if constexpr (isCompositeWire) {
+    for (auto rightWire : right) {
+      inputMaxLevel =
+          std::max(inputMaxLevel, getWireLevel<usingBatch>(rightWire));
+    }
+  } else {
+    inputMaxLevel = std::max(inputMaxLevel, getWireLevel<usingBatch>(right));
+  }
+  return inputMaxLevel;
+}
+
+// Free gates are added to even levels, and non-free gates are added to odd
+// levels. A gate can depend on a free gate at the same level, but cannot
+// depend on a non-free gate at the same level.
+uint32_t GateKeeper::getFirstAvailableLevel(
+    uint32_t inputMaxLevel,
+    bool isFreeGate) const {
+  auto minAvailableInput = inputMaxLevel +
+      (IGateKeeper::isLevelFree(inputMaxLevel) ? (isFreeGate ? 0 : 1)
                                                : (isFreeGate ? 1 : 2));
   auto minAvailableFirstUnexecuted = firstUnexecutedLevel_ +
       (IGateKeeper::isLevelFree(firstUnexecutedLevel_) ? (isFreeGate ? 0 : 1)
                                                        : (isFreeGate ? 1 : 0));
 
-  return std::max(
-      std::max(minAvailableLeft, minAvailableRight),
-      minAvailableFirstUnexecuted);
+  return std::max(minAvailableInput, minAvailableFirstUnexecuted);
 }
 } // namespace fbpcf::scheduler
@@ -9,14 +9,40 @@
 
 #include <deque>
 #include <memory>
+#include <unordered_map>
+#include <unordered_set>
 
 #include "fbpcf/scheduler/gate_keeper/IGateKeeper.h"
 
 namespace fbpcf::scheduler {
 
+template <IScheduler::WireType T>
+class NormalGateArena;
+
+/**
+ * This class keeps the gates of the circuit by level. By default every gate
+ * is a heap-allocated object. With a gate arena, the runs of non-batch normal
+ * gates in a level are stored in flat arrays instead (see NormalGateArena),
+ * other gates are kept as objects. With vectorized gates, the non-free gates
+ * of a gate arena are executed as one batch gate of the engine, so that
+ * scalar programs get the per-gate cost of batch ones.
+ * The unexecuted gates are bounded by a memory budget on the bytes of their
+ * output wire values, and by a number of gates that grows while the non-free
+ * levels are too narrow to amortize their round trips and shrinks back once
+ * they are wide.
+ * The free gates whose results can't be read anymore are dropped before they
+ * are executed, and free gates on known values can be folded by the caller
+ * instead of being added.
+ */
 class GateKeeper : public IGateKeeper {
  public:
-  explicit GateKeeper(std::shared_ptr<IWireKeeper> wireKeeper);
+  static constexpr uint64_t kDefaultMemoryBudget = 1ULL << 30;
+
+  explicit GateKeeper(
+      std::shared_ptr<IWireKeeper> wireKeeper,
+      bool useGateArena = false,
+      uint64_t memoryBudget = kDefaultMemoryBudget,
+      bool vectorizeGates = false);
 
   /**
    * @inherit doc
@@ -30,6 +56,18 @@ class GateKeeper : public IGateKeeper {
   IScheduler::WireId<IScheduler::Boolean> inputGateBatch(
       BoolType<true> initialValue) override;
 
+  /**
+   * @inherit doc
+   */
+  IScheduler::WireId<IScheduler::Boolean> publicInputGate(
+      BoolType<false> initialValue) override;
+
+  /**
+   * @inherit doc
+   */
+  IScheduler::WireId<IScheduler::Boolean> publicInputGateBatch(
+      BoolType<true> initialValue) override;
+
   /**
    * @inherit doc
    */
@@ -62,6 +100,82 @@ class GateKeeper : public IGateKeeper {
       IScheduler::WireId<IScheduler::Boolean> right =
           IScheduler::WireId<IScheduler::Boolean>()) override;
 
+  /**
+   * @inherit doc
+   */
+  IScheduler::WireId<IScheduler::Arithmetic> integerInputGate(
+      IntType<false> initialValue) override;
+
+  /**
+   * @inherit doc
+   */
+  IScheduler::WireId<IScheduler::Arithmetic> integerInputGateBatch(
+      IntType<true> initialValue) override;
+
+  /**
+   * @inherit doc
+   */
+  IScheduler::WireId<IScheduler::Arithmetic> outputGate(
+      IScheduler::WireId<IScheduler::Arithmetic> src,
+      int partyID) override;
+
+  /**
+   * @inherit doc
+   */
+  IScheduler::WireId<IScheduler::Arithmetic> outputGateBatch(
+      IScheduler::WireId<IScheduler::Arithmetic> src,
+      int partyID) override;
+
+  /**
+   * @inherit doc
+   */
+  IScheduler::WireId<IScheduler::Arithmetic> normalGate(
+      INormalGate<IScheduler::Arithmetic>::GateType gateType,
+      IScheduler::WireId<IScheduler::Arithmetic> left,
+      IScheduler::WireId<IScheduler::Arithmetic> right =
+          IScheduler::WireId<IScheduler::Arithmetic>()) override;
+
+  /**
+   * @inherit doc
+   */
+  IScheduler::WireId<IScheduler::Arithmetic> normalGateBatch(
+      INormalGate<IScheduler::Arithmetic>::GateType gateType,
+      IScheduler::WireId<IScheduler::Arithmetic> left,
+      IScheduler::WireId<IScheduler::Arithmetic> right =
+          IScheduler::WireId<IScheduler::Arithmetic>()) override;
+
+  /**
+   * @inherit doc
+   */
+  IScheduler::WireId<IScheduler::Arithmetic> booleanToIntegerGate(
+      const std::vector<IScheduler::WireId<IScheduler::Boolean>>& src)
+      override;
+
+  /**
+   * @inherit doc
+   */
+  IScheduler::WireId<IScheduler::Arithmetic> booleanToIntegerGateBatch(
+      const std::vector<IScheduler::WireId<IScheduler::Boolean>>& src)
+      override;
+
+  /**
+   * @inherit doc
+   */
+  std::vector<IScheduler::WireId<IScheduler::Boolean>>
+  integerToBooleanSummandsGate(
+      IScheduler::WireId<IScheduler::Arithmetic> src,
+      int8_t width,
+      int numberOfParties) override;
+
+  /**
+   * @inherit doc
+   */
+  std::vector<IScheduler::WireId<IScheduler::Boolean>>
+  integerToBooleanSummandsGateBatch(
+      IScheduler::WireId<IScheduler::Arithmetic> src,
+      int8_t width,
+      int numberOfParties) override;
+
   /**
    * @inherit doc
    */
@@ -88,51 +202,396 @@ class GateKeeper : public IGateKeeper {
    */
   std::vector<std::unique_ptr<IGate>> popFirstUnexecutedLevel() override;
 
+  /**
+   * @inherit doc
+   */
+  std::vector<std::unique_ptr<IGate>> popGatesIndependentOfLevel(
+      uint32_t level) override;
+
   /**
    * @inherit doc
    */
   bool hasReachedBatchingLimit() const override;
 
+  /**
+   * @inherit doc
+   */
+  void recordNonFreeLevel(uint64_t numberOfResults) override;
+
+  /**
+   * @inherit doc
+   */
+  uint64_t getPendingBytes() const override {
+    return pendingBytes_;
+  }
+
+  /**
+   * @inherit doc
+   */
+  uint64_t getNumberOfPendingANDs() const override {
+    return pendingANDs_;
+  }
+
+  /**
+   * @inherit doc
+   */
+  uint64_t getPeakPendingBytes() const override {
+    return peakPendingBytes_;
+  }
+
+  /**
+   * @inherit doc
+   */
+  void decreaseReferenceCount(
+      IScheduler::WireId<IScheduler::Boolean> id) override;
+
+  /**
+   * @inherit doc
+   */
+  void decreaseReferenceCount(
+      IScheduler::WireId<IScheduler::Arithmetic> id) override;
+
+  /**
+   * @inherit doc
+   */
+  void decreaseReferenceCountBatch(
+      IScheduler::WireId<IScheduler::Boolean> id) override;
+
+  /**
+   * @inherit doc
+   */
+  void decreaseReferenceCountBatch(
+      IScheduler::WireId<IScheduler::Arithmetic> id) override;
+
+  /**
+   * @inherit doc
+   */
+  uint64_t getNumberOfDeadGates() const override {
+    return numberOfDeadGates_;
+  }
+
+  /**
+   * @inherit doc
+   */
+  bool canFoldGate(
+      IScheduler::WireId<IScheduler::Boolean> left,
+      IScheduler::WireId<IScheduler::Boolean> right =
+          IScheduler::WireId<IScheduler::Boolean>()) const override;
+
+  /**
+   * @inherit doc
+   */
+  bool canFoldGateBatch(
+      IScheduler::WireId<IScheduler::Boolean> left,
+      IScheduler::WireId<IScheduler::Boolean> right =
+          IScheduler::WireId<IScheduler::Boolean>()) const override;
+
+  /**
+   * @inherit doc
+   */
+  IScheduler::WireId<IScheduler::Boolean> foldedGate(
+      BoolType<false> value,
+      IScheduler::WireId<IScheduler::Boolean> left,
+      IScheduler::WireId<IScheduler::Boolean> right =
+          IScheduler::WireId<IScheduler::Boolean>()) override;
+
+  /**
+   * @inherit doc
+   */
+  IScheduler::WireId<IScheduler::Boolean> foldedGateBatch(
+      BoolType<true> value,
+      IScheduler::WireId<IScheduler::Boolean> left,
+      IScheduler::WireId<IScheduler::Boolean> right =
+          IScheduler::WireId<IScheduler::Boolean>()) override;
+
+  /**
+   * @inherit doc
+   */
+  uint64_t getNumberOfFoldedGates() const override {
+    return numberOfFoldedGates_;
+  }
+
+  // The current maximum number of unexecuted gates.
+  uint64_t getMaxUnexecutedGates() const {
+    return maxUnexecutedGates_;
+  }
+
+  /**
+   * @inherit doc
+   */
+  void startRecording(
+      const std::vector<IScheduler::WireId<IScheduler::Boolean>>& inputs)
+      override;
+
+  /**
+   * @inherit doc
+   */
+  void startRecordingBatch(
+      const std::vector<IScheduler::WireId<IScheduler::Boolean>>& inputs)
+      override;
+
+  /**
+   * @inherit doc
+   */
+  std::shared_ptr<const Circuit> stopRecording(
+      const std::vector<IScheduler::WireId<IScheduler::Boolean>>& outputs)
+      override;
+
+  /**
+   * @inherit doc
+   */
+  std::vector<IScheduler::WireId<IScheduler::Boolean>> addCircuit(
+      const Circuit& circuit,
+      const std::vector<IScheduler::WireId<IScheduler::Boolean>>& inputs)
+      override;
+
+  static constexpr uint64_t kMinMaxUnexecutedGates = 100000;
+  static constexpr uint64_t kMaxMaxUnexecutedGates =
+      16 * kMinMaxUnexecutedGates;
+  // A non-free level with fewer results spends most of its time waiting for
+  // the round trip, one with more results is bound by the local computation.
+  static constexpr uint64_t kMinResultsPerRoundTrip = 1 << 14;
+  static constexpr uint64_t kMaxResultsPerRoundTrip = 1 << 20;
+
  private:
-  template <bool isCompositeWire>
-  using GateClass = typename std::conditional<
-      isCompositeWire,
-      ICompositeGate,
-      INormalGate<IScheduler::Boolean>>::type;
+  // composite gates only take boolean wires
+  template <IScheduler::WireType T, bool isCompositeWire>
+  using GateClass = typename std::
+      conditional<isCompositeWire, ICompositeGate, INormalGate<T>>::type;
 
-  template <bool isCompositeWire>
+  template <IScheduler::WireType T, bool isCompositeWire>
   using GateType = typename std::conditional<
       isCompositeWire,
       ICompositeGate::GateType,
-      INormalGate<IScheduler::Boolean>::GateType>::type;
+      typename INormalGate<T>::GateType>::type;
 
-  template <bool isCompositeWire>
+  template <IScheduler::WireType T, bool isCompositeWire>
   using RightWireType = typename std::conditional<
       isCompositeWire,
-      std::vector<IScheduler::WireId<IScheduler::Boolean>>,
-      IScheduler::WireId<IScheduler::Boolean>>::type;
+      std::vector<IScheduler::WireId<T>>,
+      IScheduler::WireId<T>>::type;
 
-  template <bool usingBatch, bool isCompositeWire>
-  RightWireType<isCompositeWire> addGate(
-      GateType<isCompositeWire> gateType,
-      IScheduler::WireId<IScheduler::Boolean> left,
-      RightWireType<isCompositeWire> right,
-      BoolType<usingBatch> initialValue,
+  template <IScheduler::WireType T, bool usingBatch>
+  using ValueType = typename std::conditional<
+      T == IScheduler::Boolean,
+      BoolType<usingBatch>,
+      IntType<usingBatch>>::type;
+
+  template <IScheduler::WireType T, bool usingBatch, bool isCompositeWire>
+  RightWireType<T, isCompositeWire> addGate(
+      GateType<T, isCompositeWire> gateType,
+      IScheduler::WireId<T> left,
+      RightWireType<T, isCompositeWire> right,
+      ValueType<T, usingBatch> initialValue,
       int partyID = 0);
 
-  template <bool usingBatch, bool isCompositeWire>
-  uint32_t getFirstAvailableLevelForNewWire(
-      GateType<isCompositeWire> gateType,
+  // add a normal gate at the given level.
+  template <IScheduler::WireType T, bool usingBatch>
+  IScheduler::WireId<T> addNormalGate(
+      uint32_t level,
+      uint32_t inputMaxLevel,
+      typename INormalGate<T>::GateType gateType,
+      IScheduler::WireId<T> left,
+      IScheduler::WireId<T> right,
+      ValueType<T, usingBatch> initialValue,
+      int partyID);
+
+  template <bool usingBatch>
+  IScheduler::WireId<IScheduler::Arithmetic> addBooleanToIntegerGate(
+      const std::vector<IScheduler::WireId<IScheduler::Boolean>>& src);
+
+  template <bool usingBatch>
+  std::vector<IScheduler::WireId<IScheduler::Boolean>>
+  addIntegerToBooleanSummandsGate(
+      IScheduler::WireId<IScheduler::Arithmetic> src,
+      int8_t width,
+      int numberOfParties);
+
+  template <bool usingBatch, IScheduler::WireType T>
+  uint32_t getWireLevel(IScheduler::WireId<T> wire) const;
+
+  // the first level a new gate can be added to, given the max level of its
+  // input wires.
+  uint32_t getFirstAvailableLevel(uint32_t inputMaxLevel, bool isFreeGate)
+      const;
+
+  template <IScheduler::WireType T, bool usingBatch, bool isCompositeWire>
+  uint32_t getInputMaxLevel(
+      IScheduler::WireId<T> left,
+      RightWireType<T, isCompositeWire> right) const;
+
+  struct GateInfo {
+    // the max level of the input wires of the gate(s)
+    uint32_t inputMaxLevel;
+    // more than one for a gate arena
+    uint64_t numberOfGates;
+    // the bytes of the output wire values of the gate(s)
+    uint64_t numberOfBytes;
+    // the boolean AND results of the gate(s), one tuple each
+    uint64_t numberOfANDs;
+  };
+
+  struct Recording {
+    bool usingBatch;
+    uint32_t numberOfInputs;
+    // the index in the circuit of the inputs and of the recorded wires
+    std::unordered_map<uint64_t, uint32_t> wireIndexes;
+    std::vector<Circuit::Gate> gates;
+    std::vector<std::vector<bool>> constants;
+
+    uint32_t getWireIndex(IScheduler::WireId<IScheduler::Boolean> wire) const;
+  };
+
+  void startRecording(
+      const std::vector<IScheduler::WireId<IScheduler::Boolean>>& inputs,
+      bool usingBatch);
+
+  // the record of a gate that is about to be added
+  template <IScheduler::WireType T, bool usingBatch>
+  Circuit::Gate getRecordedGate(
+      typename INormalGate<T>::GateType gateType,
+      IScheduler::WireId<T> left,
+      IScheduler::WireId<T> right,
+      ValueType<T, usingBatch> initialValue,
+      int partyID,
+      uint32_t level);
+
+  template <bool usingBatch>
+  std::vector<IScheduler::WireId<IScheduler::Boolean>> addCircuit(
+      const Circuit& circuit,
+      const std::vector<IScheduler::WireId<IScheduler::Boolean>>& inputs);
+
+  // make room at each level from the given one for the given number of
+  // gates, so that the gates of a replayed circuit are added without
+  // reallocating.
+  template <bool usingBatch>
+  void reserveLevels(
+      uint32_t firstLevel,
+      const std::vector<uint32_t>& numberOfGatesByLevel);
+
+  // the number of values in a batch wire
+  template <IScheduler::WireType T>
+  size_t getBatchSize(IScheduler::WireId<T> wire) const;
+
+  template <IScheduler::WireType T>
+  void setBatchSize(IScheduler::WireId<T> wire, size_t batchSize);
+
+  // the bytes taken by the value of a wire
+  template <IScheduler::WireType T, bool usingBatch>
+  static uint64_t getValueBytes(size_t batchSize);
+
+  void addPendingBytes(uint64_t numberOfBytes);
+
+  void removeGateInfo(const GateInfo& gateInfo);
+
+  // keep the gate(s) counted until the level at the offset is popped.
+  void takeGateInfo(size_t offset, const GateInfo& gateInfo);
+
+  template <bool usingBatch, IScheduler::WireType T>
+  void decreaseReferenceCount(IScheduler::WireId<T> id);
+
+  // remove the dead gates if there may be some, once enough gates were added
+  // since the last time, as it goes through all the unexecuted gates.
+  void maybeRemoveDeadGates();
+
+  // remove the unexecuted gates that nothing reads, starting from the last
+  // level so that the gates only read by removed gates are removed as well.
+  void removeDeadGates();
+
+  // remove the dead gates of the given gate if it is a gate arena.
+  template <IScheduler::WireType T>
+  void removeDeadGatesFromArena(
+      size_t offset,
+      IGate& gate,
+      GateInfo& gateInfo);
+
+  template <bool usingBatch>
+  IScheduler::WireId<IScheduler::Boolean> addFoldedGate(
+      BoolType<usingBatch> value,
       IScheduler::WireId<IScheduler::Boolean> left,
-      RightWireType<isCompositeWire> right) const;
+      IScheduler::WireId<IScheduler::Boolean> right);
+
+  template <bool usingBatch>
+  bool isValueKnown(IScheduler::WireId<IScheduler::Boolean> wire) const;
+
+  // keep track of the new boolean wires at the given level whose values are
+  // given when they are created, i.e. before their level is executed.
+  template <bool usingBatch>
+  void updateKnownWires(
+      IScheduler::WireId<IScheduler::Boolean> wire,
+      bool isKnown,
+      uint32_t level);
+
+  // make sure gatesByLevelOffset_ reaches the given level and return its index
+  size_t getLevelOffset(uint32_t level);
+
+  void addGateToLevel(
+      uint32_t level,
+      uint32_t inputMaxLevel,
+      std::unique_ptr<IGate> gate,
+      uint64_t numberOfBytes,
+      uint64_t numberOfANDs = 0);
+
+  // the arena at the end of the level at the given offset, a new one is
+  // added if the last gate of the level isn't an arena.
+  template <IScheduler::WireType T>
+  NormalGateArena<T>& getLastArena(size_t offset, uint32_t inputMaxLevel);
+
+  // append a non-batch normal gate to the arena at the end of the level, or
+  // to a new one if the last gate of the level isn't an arena.
+  template <IScheduler::WireType T>
+  void addGateToArena(
+      uint32_t level,
+      uint32_t inputMaxLevel,
+      typename INormalGate<T>::GateType gateType,
+      IScheduler::WireId<T> outputWire,
+      IScheduler::WireId<T> left,
+      IScheduler::WireId<T> right,
+      int partyID);
 
   std::deque<std::vector<std::unique_ptr<IGate>>> gatesByLevelOffset_;
+  // the info of each gate in gatesByLevelOffset_
+  std::deque<std::vector<GateInfo>> gateInfosByLevelOffset_;
+  // The gates taken out of each level before it is popped, as dead gates or
+  // as gates independent of the executing level. They count towards the
+  // batching limit and the memory budget until the level is popped, so that
+  // the counters only change when all parties pop a level.
+  std::deque<GateInfo> takenGateInfoByLevelOffset_;
   std::shared_ptr<IWireKeeper> wireKeeper_;
+  bool useGateArena_;
+  bool vectorizeGates_;
+
+  // The batch sizes of the batch wires allocated by this object, they are
+  // only needed until the wires are computed. An entry is overwritten when
+  // its wire id is reused.
+  std::unordered_map<uint64_t, size_t> booleanBatchSizes_;
+  std::unordered_map<uint64_t, size_t> integerBatchSizes_;
+
+  // The unexecuted boolean wires whose values are known, i.e. the outputs of
+  // input gates and folded gates. An entry is removed when its wire id is
+  // reused.
+  std::unordered_set<uint64_t> knownBooleanWires_;
+  std::unordered_set<uint64_t> knownBatchBooleanWires_;
+  uint32_t maxKnownWireLevel_ = 0;
+
+  std::unique_ptr<Recording> recording_;
 
   uint32_t firstUnexecutedLevel_ = 0;
 
-  uint32_t numUnexecutedGates_ = 0;
-  const uint32_t kMaxUnexecutedGates = 100000;
+  uint64_t numUnexecutedGates_ = 0;
+  uint64_t maxUnexecutedGates_ = kMinMaxUnexecutedGates;
+
+  uint64_t memoryBudget_;
+  uint64_t pendingBytes_ = 0;
+  uint64_t pendingANDs_ = 0;
+  uint64_t peakPendingBytes_ = 0;
+
+  // whether a wire was released while its gate was unexecuted since the last
+  // time the dead gates were removed, otherwise there are none.
+  bool mayHaveDeadGates_ = false;
+  uint64_t gatesAddedSinceSweep_ = 0;
+  uint64_t numberOfDeadGates_ = 0;
+  uint64_t numberOfFoldedGates_ = 0;
 };
 
 } // namespace fbpcf::scheduler
@@ -82,19 +82,35 @@ class ICompositeGate : public IGate {
   // Run or schedule the computation for this gate.
   virtual void compute(
       engine::ISecretShareEngine& engine,
-      std::map<int64_t, std::vector<bool>>& secretSharesByParty) override = 0;
+      std::map<int64_t, IGate::Secrets>& secretSharesByParty) override = 0;
 
   // For non-free gates, get the result of the computation that was scheduled
   // and store it on the appropriate wire.
   virtual void collectScheduledResult(
       engine::ISecretShareEngine& engine,
-      std::map<int64_t, std::vector<bool>>& revealedSecretsByParty)
+      std::map<int64_t, IGate::Secrets>& revealedSecretsByParty)
       override = 0;
 
   uint32_t getNumberOfResults() const override {
     return numberOfResults_;
   }
 
+  bool canComputeConcurrently() const override {
+    return isFree(gateType_);
+  }
+
+  bool isDead() const override {
+    if (!isFree(gateType_)) {
+      return false;
+    }
+    for (auto wireID : outputWireIDs_) {
+      if (getReferenceCount(wireID) != 1) {
+        return false;
+      }
+    }
+    return true;
+  }
+
   std::vector<IScheduler::WireId<IScheduler::Boolean>> getOutputWireIds()
       const {
     return outputWireIDs_;
@@ -159,6 +175,9 @@ class ICompositeGate : public IGate {
 
   virtual void decreaseReferenceCount(
       IScheduler::WireId<IScheduler::Boolean> wire) = 0;
+
+  virtual uint32_t getReferenceCount(
+      IScheduler::WireId<IScheduler::Boolean> wire) const = 0;
 };
 
 } // namespace fbpcf::scheduler
@@ -7,20 +7,29 @@
 
 #pragma once
 
+#include <cstdint>
 #include <map>
+#include <vector>
 
 #include "fbpcf/engine/ISecretShareEngine.h"
 
 namespace fbpcf::scheduler {
 
 /**
- * Base interface for Gates in a boolean circuit. It is used to encapsulate
- * operations that will happen at some point in the future.
+ * Base interface for Gates in a boolean or arithmetic circuit. It is used to
+ * encapsulate operations that will happen at some point in the future.
  */
 class IGate {
  public:
   virtual ~IGate() = default;
 
+  // The secrets to be revealed to (or revealed by) one party. Boolean secrets
+  // are XOR shared and integer secrets are additively shared mod 2^64.
+  struct Secrets {
+    std::vector<bool> booleanSecrets;
+    std::vector<uint64_t> integerSecrets;
+  };
+
   /* Run or schedule the computation for this gate.
    * @param engine The secret share engine used to execute and schedule
    * networked operations
@@ -29,7 +38,7 @@ class IGate {
    */
   virtual void compute(
       engine::ISecretShareEngine& engine,
-      std::map<int64_t, std::vector<bool>>& secretSharesByParty) = 0;
+      std::map<int64_t, Secrets>& secretSharesByParty) = 0;
 
   /* For non-free gates, get the result of the computation that was scheduled
    * and store it on the appropriate wire(s).
@@ -39,11 +48,24 @@ class IGate {
    */
   virtual void collectScheduledResult(
       engine::ISecretShareEngine& engine,
-      std::map<int64_t, std::vector<bool>>& revealedSecretsByParty) = 0;
+      std::map<int64_t, Secrets>& revealedSecretsByParty) = 0;
 
   // The number of values in a batch gate (1 for non-batch case)
   virtual uint32_t getNumberOfResults() const = 0;
 
+  // Whether compute() only reads the input wires and writes the output wires
+  // of this gate, i.e. it doesn't schedule anything on the engine, consume
+  // randomness or add secrets to reveal. Such gates can be computed
+  // concurrently.
+  virtual bool canComputeConcurrently() const = 0;
+
+  // Whether the gate holds the only references to its output wires, i.e.
+  // nothing will ever read its results and it doesn't need to be computed.
+  // Only free gates can be dead: the non-free ones talk to the other parties,
+  // which may still read their side of an open or an AND, so dropping them on
+  // one party only would break the lockstep.
+  virtual bool isDead() const = 0;
+
  protected:
 };
 } // namespace fbpcf::scheduler
@@ -7,7 +7,11 @@
 
 #pragma once
 
+#include <memory>
+#include <vector>
+
 #include "fbpcf/scheduler/IScheduler.h"
+#include "fbpcf/scheduler/gate_keeper/Circuit.h"
 #include "fbpcf/scheduler/gate_keeper/ICompositeGate.h"
 #include "fbpcf/scheduler/gate_keeper/IGate.h"
 #include "fbpcf/scheduler/gate_keeper/INormalGate.h"
@@ -23,6 +27,10 @@ class IGateKeeper {
   using BoolType = typename std::
       conditional<usingBatch, const std::vector<bool>&, bool>::type;
 
+  template <bool usingBatch>
+  using IntType = typename std::
+      conditional<usingBatch, const std::vector<uint64_t>&, uint64_t>::type;
+
   virtual ~IGateKeeper() = default;
 
   // Create an input gate and return its output wire ID.
@@ -33,6 +41,15 @@ class IGateKeeper {
   virtual IScheduler::WireId<IScheduler::Boolean> inputGateBatch(
       BoolType<true> initialValue) = 0;
 
+  // Create an input gate whose value is public, the free gates reading it can
+  // then be folded, and return its output wire ID.
+  virtual IScheduler::WireId<IScheduler::Boolean> publicInputGate(
+      BoolType<false> initialValue) = 0;
+
+  // same, for a batch input gate.
+  virtual IScheduler::WireId<IScheduler::Boolean> publicInputGateBatch(
+      BoolType<true> initialValue) = 0;
+
   // Create an output gate and return its output wire ID.
   virtual IScheduler::WireId<IScheduler::Boolean> outputGate(
       IScheduler::WireId<IScheduler::Boolean> src,
@@ -59,6 +76,67 @@ class IGateKeeper {
       IScheduler::WireId<IScheduler::Boolean> right =
           IScheduler::WireId<IScheduler::Boolean>()) = 0;
 
+  // Create an integer input gate and return its output wire ID.
+  virtual IScheduler::WireId<IScheduler::Arithmetic> integerInputGate(
+      IntType<false> initialValue) = 0;
+
+  // Create a batch integer input gate and return its output wire ID.
+  virtual IScheduler::WireId<IScheduler::Arithmetic> integerInputGateBatch(
+      IntType<true> initialValue) = 0;
+
+  // Create an integer output gate and return its output wire ID.
+  virtual IScheduler::WireId<IScheduler::Arithmetic> outputGate(
+      IScheduler::WireId<IScheduler::Arithmetic> src,
+      int partyID) = 0;
+
+  // Create a batch integer output gate and return its output wire ID.
+  virtual IScheduler::WireId<IScheduler::Arithmetic> outputGateBatch(
+      IScheduler::WireId<IScheduler::Arithmetic> src,
+      int partyID) = 0;
+
+  // Create a unary/binary arithmetic gate (e.g. Plus, Mult, Neg) and return its
+  // output wire ID.
+  virtual IScheduler::WireId<IScheduler::Arithmetic> normalGate(
+      INormalGate<IScheduler::Arithmetic>::GateType gateType,
+      IScheduler::WireId<IScheduler::Arithmetic> left,
+      IScheduler::WireId<IScheduler::Arithmetic> right =
+          IScheduler::WireId<IScheduler::Arithmetic>()) = 0;
+
+  // Create a batch unary/binary arithmetic gate (e.g. Plus, Mult, Neg) and
+  // return its output wire ID.
+  virtual IScheduler::WireId<IScheduler::Arithmetic> normalGateBatch(
+      INormalGate<IScheduler::Arithmetic>::GateType gateType,
+      IScheduler::WireId<IScheduler::Arithmetic> left,
+      IScheduler::WireId<IScheduler::Arithmetic> right =
+          IScheduler::WireId<IScheduler::Arithmetic>()) = 0;
+
+  // Create a gate converting boolean wires (lsb first) to an integer wire,
+  // return its output wire ID.
+  virtual IScheduler::WireId<IScheduler::Arithmetic> booleanToIntegerGate(
+      const std::vector<IScheduler::WireId<IScheduler::Boolean>>& src) = 0;
+
+  // Create a batch gate converting boolean wires (lsb first) to an integer
+  // wire, return its output wire ID.
+  virtual IScheduler::WireId<IScheduler::Arithmetic> booleanToIntegerGateBatch(
+      const std::vector<IScheduler::WireId<IScheduler::Boolean>>& src) = 0;
+
+  // Create a gate sharing the lowest width bits of every party's share of an
+  // integer wire as boolean wires. Return numberOfParties * width output wire
+  // ID's, where the k-th bit of party i's share is at [i * width + k].
+  virtual std::vector<IScheduler::WireId<IScheduler::Boolean>>
+  integerToBooleanSummandsGate(
+      IScheduler::WireId<IScheduler::Arithmetic> src,
+      int8_t width,
+      int numberOfParties) = 0;
+
+  // Create a batch gate sharing the lowest width bits of every party's share
+  // of an integer wire as boolean wires, laid out the same way as above.
+  virtual std::vector<IScheduler::WireId<IScheduler::Boolean>>
+  integerToBooleanSummandsGateBatch(
+      IScheduler::WireId<IScheduler::Arithmetic> src,
+      int8_t width,
+      int numberOfParties) = 0;
+
   // Create a binary composite gate (e.g. AND, XOR) from a single left input and
   // multiple right inputs. Returns its output wire ID's
   virtual std::vector<IScheduler::WireId<IScheduler::Boolean>> compositeGate(
@@ -79,13 +157,126 @@ class IGateKeeper {
   // to odd levels.
   virtual uint32_t getFirstUnexecutedLevel() const = 0;
 
-  // Extract all the gates at the level that should be executed next.
+  // Extract all the gates at the level that should be executed next. Before
+  // that, the unexecuted free gates whose results can't be read anymore may
+  // be removed, see getNumberOfDeadGates().
   virtual std::vector<std::unique_ptr<IGate>> popFirstUnexecutedLevel() = 0;
 
-  // Whether we've exceeded the maximum number of unexecuted gates. In this
-  // case, gates should be executed in order to free up memory.
+  // Extract the gates at the first unexecuted level that only read wires
+  // from levels before the given one, i.e. that don't depend on the gates of
+  // the given level or later. Only free levels are considered, so that these
+  // gates can be computed while a non-free level is still being executed.
+  virtual std::vector<std::unique_ptr<IGate>> popGatesIndependentOfLevel(
+      uint32_t level) = 0;
+
+  // Whether the unexecuted gates have exceeded the memory budget or the
+  // maximum number of unexecuted gates. In this case, gates should be
+  // executed in order to free up memory.
   virtual bool hasReachedBatchingLimit() const = 0;
 
+  // Report how many results a non-free level had once it was executed, so
+  // that the maximum number of unexecuted gates can grow while the levels are
+  // too narrow to amortize their round trips. This only depends on the
+  // circuit, not on timings, so that every party puts the same gates in the
+  // same levels.
+  virtual void recordNonFreeLevel(uint64_t numberOfResults) = 0;
+
+  // The bytes taken by the values of the output wires of the unexecuted
+  // gates.
+  virtual uint64_t getPendingBytes() const = 0;
+
+  // The number of AND results of the unexecuted boolean gates, i.e. how many
+  // tuples they will take. Composite ANDs aren't counted, as they take
+  // composite tuples.
+  virtual uint64_t getNumberOfPendingANDs() const = 0;
+
+  // The max of getPendingBytes() so far.
+  virtual uint64_t getPeakPendingBytes() const = 0;
+
+  // Release a reference held by the caller to the wire with given id. Once
+  // the gate of an unexecuted wire holds its only reference, the gate can be
+  // removed.
+  virtual void decreaseReferenceCount(
+      IScheduler::WireId<IScheduler::Boolean> id) = 0;
+
+  // same, for a batch wire.
+  virtual void decreaseReferenceCountBatch(
+      IScheduler::WireId<IScheduler::Boolean> id) = 0;
+
+  // same, for an arithmetic wire.
+  virtual void decreaseReferenceCount(
+      IScheduler::WireId<IScheduler::Arithmetic> id) = 0;
+
+  // same, for an arithmetic batch wire.
+  virtual void decreaseReferenceCountBatch(
+      IScheduler::WireId<IScheduler::Arithmetic> id) = 0;
+
+  // The number of gates removed before they were executed, because the only
+  // references to their output wires were held by the gates themselves. Once
+  // a gate is removed, the gates only read by it are removed as well. As the
+  // parties may release different wires, a removed gate keeps counting
+  // towards the batching limit and the pending bytes until its level is
+  // popped.
+  virtual uint64_t getNumberOfDeadGates() const = 0;
+
+  // Whether a free gate reading the given wires can be computed right away
+  // instead of being added: the values of the wires are known already, either
+  // because they were given when the wires were created or because the gates
+  // writing them were executed. Gates are never folded while recording.
+  virtual bool canFoldGate(
+      IScheduler::WireId<IScheduler::Boolean> left,
+      IScheduler::WireId<IScheduler::Boolean> right =
+          IScheduler::WireId<IScheduler::Boolean>()) const = 0;
+
+  // same, for batch wires.
+  virtual bool canFoldGateBatch(
+      IScheduler::WireId<IScheduler::Boolean> left,
+      IScheduler::WireId<IScheduler::Boolean> right =
+          IScheduler::WireId<IScheduler::Boolean>()) const = 0;
+
+  // Create a wire holding the result of a folded gate reading the given wires
+  // and return its ID. No gate is added, but the wire is at the level the
+  // gate would have been added to, so that forcing it or adding the gates
+  // reading it executes the same levels as before.
+  virtual IScheduler::WireId<IScheduler::Boolean> foldedGate(
+      BoolType<false> value,
+      IScheduler::WireId<IScheduler::Boolean> left,
+      IScheduler::WireId<IScheduler::Boolean> right =
+          IScheduler::WireId<IScheduler::Boolean>()) = 0;
+
+  // same, for batch wires.
+  virtual IScheduler::WireId<IScheduler::Boolean> foldedGateBatch(
+      BoolType<true> value,
+      IScheduler::WireId<IScheduler::Boolean> left,
+      IScheduler::WireId<IScheduler::Boolean> right =
+          IScheduler::WireId<IScheduler::Boolean>()) = 0;
+
+  // The number of gates folded so far.
+  virtual uint64_t getNumberOfFoldedGates() const = 0;
+
+  // Record the gates added from now on into a circuit that reads the given
+  // wires, the gates are still executed as usual. Only non-batch normal
+  // boolean gates can be recorded, and they can only read the inputs of the
+  // circuit or the wires of the gates recorded before them. Otherwise, adding
+  // the gate throws.
+  virtual void startRecording(
+      const std::vector<IScheduler::WireId<IScheduler::Boolean>>& inputs) = 0;
+
+  // same, except that only batch normal boolean gates can be recorded.
+  virtual void startRecordingBatch(
+      const std::vector<IScheduler::WireId<IScheduler::Boolean>>& inputs) = 0;
+
+  // Stop recording and return the circuit, whose outputs are the given wires.
+  virtual std::shared_ptr<const Circuit> stopRecording(
+      const std::vector<IScheduler::WireId<IScheduler::Boolean>>& outputs) = 0;
+
+  // Add the gates of a recorded circuit on the given input wires, at the
+  // levels they were recorded at relative to the first level the inputs are
+  // available. Return the output wires of the circuit.
+  virtual std::vector<IScheduler::WireId<IScheduler::Boolean>> addCircuit(
+      const Circuit& circuit,
+      const std::vector<IScheduler::WireId<IScheduler::Boolean>>& inputs) = 0;
+
   // Even levels contain free gates, and odd levels contain non-free gates.
   static inline bool isLevelFree(uint32_t level) {
     return !(level & 1);
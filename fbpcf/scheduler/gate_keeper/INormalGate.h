@@ -18,7 +18,9 @@ namespace fbpcf::scheduler {
 
 /**
  * This class executes gates in a circuit. There are subclasses for batched and
- * non-batched gates.
+ * non-batched gates. Boolean wires use the XOR/NOT/AND gate types and
+ * arithmetic wires use the Plus/Neg/Mult gate types, input and output gates
+ * work with both.
  */
 template <IScheduler::WireType T>
 class INormalGate : public IGate {
@@ -32,6 +34,11 @@ class INormalGate : public IGate {
     AsymmetricXOR,
     SymmetricNot,
     SymmetricXOR,
+    FreeMult,
+    NonFreeMult,
+    AsymmetricPlus,
+    SymmetricPlus,
+    Neg,
   };
 
   INormalGate(
@@ -76,9 +83,14 @@ class INormalGate : public IGate {
       case GateType::Input:
       case GateType::SymmetricNot:
       case GateType::SymmetricXOR:
+      case GateType::FreeMult:
+      case GateType::AsymmetricPlus:
+      case GateType::SymmetricPlus:
+      case GateType::Neg:
         return true;
 
       case GateType::NonFreeAnd:
+      case GateType::NonFreeMult:
       case GateType::Output:
         return false;
     }
@@ -93,6 +105,15 @@ class INormalGate : public IGate {
     return numberOfResults_;
   }
 
+  // input gates get their values when they are created
+  bool canComputeConcurrently() const override {
+    return isFree(gateType_);
+  }
+
+  bool isDead() const override {
+    return isFree(gateType_) && getReferenceCount(wireID_) == 1;
+  }
+
  protected:
   GateType gateType_;
   IScheduler::WireId<T> wireID_;
@@ -137,6 +158,8 @@ class INormalGate : public IGate {
   virtual void increaseReferenceCount(IScheduler::WireId<T> wire) = 0;
 
   virtual void decreaseReferenceCount(IScheduler::WireId<T> wire) = 0;
+
+  virtual uint32_t getReferenceCount(IScheduler::WireId<T> wire) const = 0;
 };
 
 } // namespace fbpcf::scheduler
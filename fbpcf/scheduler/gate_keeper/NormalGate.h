@@ -8,6 +8,7 @@
 #pragma once
 
 #include <map>
+#include <stdexcept>
 
 #include "fbpcf/scheduler/gate_keeper/INormalGate.h"
 
@@ -54,7 +55,44 @@ class NormalGate final : public INormalGate<T> {
 
   void compute(
       engine::ISecretShareEngine& engine,
-      std::map<int64_t, std::vector<bool>>& secretSharesByParty) override {
+      std::map<int64_t, IGate::Secrets>& secretSharesByParty) override {
+    if constexpr (T == IScheduler::Boolean) {
+      computeBooleanGate(engine, secretSharesByParty);
+    } else {
+      computeArithmeticGate(engine, secretSharesByParty);
+    }
+  }
+
+  void collectScheduledResult(
+      engine::ISecretShareEngine& engine,
+      std::map<int64_t, IGate::Secrets>& revealedSecretsByParty) override {
+    if constexpr (T == IScheduler::Boolean) {
+      collectBooleanResult(engine, revealedSecretsByParty);
+    } else {
+      collectArithmeticResult(engine, revealedSecretsByParty);
+    }
+  }
+
+  void increaseReferenceCount(IScheduler::WireId<T> wire) override {
+    if (!wire.isEmpty()) {
+      wireKeeper_.increaseReferenceCount(wire);
+    }
+  }
+
+  void decreaseReferenceCount(IScheduler::WireId<T> wire) override {
+    if (!wire.isEmpty()) {
+      wireKeeper_.decreaseReferenceCount(wire);
+    }
+  }
+
+  uint32_t getReferenceCount(IScheduler::WireId<T> wire) const override {
+    return wireKeeper_.getReferenceCount(wire);
+  }
+
+ private:
+  void computeBooleanGate(
+      engine::ISecretShareEngine& engine,
+      std::map<int64_t, IGate::Secrets>& secretSharesByParty) {
     switch (gateType_) {
         // Free gates
       case GateType::AsymmetricNot:
@@ -96,14 +134,18 @@ class NormalGate final : public INormalGate<T> {
                 wireKeeper_.getBooleanValue(right_)));
         break;
 
+      default:
+        throw std::invalid_argument("Not a boolean gate.");
+
       // Non-free gates
       case GateType::Output: {
         if (secretSharesByParty.find(partyID_) == secretSharesByParty.end()) {
-          secretSharesByParty.emplace(partyID_, std::vector<bool>());
+          secretSharesByParty.emplace(partyID_, IGate::Secrets());
         }
         auto& secretShares = secretSharesByParty.at(partyID_);
-        scheduledResultIndex_ = secretShares.size();
-        secretShares.push_back(wireKeeper_.getBooleanValue(left_));
+        scheduledResultIndex_ = secretShares.booleanSecrets.size();
+        secretShares.booleanSecrets.push_back(
+            wireKeeper_.getBooleanValue(left_));
         break;
       }
 
@@ -115,9 +157,9 @@ class NormalGate final : public INormalGate<T> {
     }
   }
 
-  void collectScheduledResult(
+  void collectBooleanResult(
       engine::ISecretShareEngine& engine,
-      std::map<int64_t, std::vector<bool>>& revealedSecretsByParty) override {
+      std::map<int64_t, IGate::Secrets>& revealedSecretsByParty) {
     switch (gateType_) {
       case GateType::NonFreeAnd:
         wireKeeper_.setBooleanValue(
@@ -127,7 +169,8 @@ class NormalGate final : public INormalGate<T> {
       case GateType::Output:
         wireKeeper_.setBooleanValue(
             wireID_,
-            revealedSecretsByParty.at(partyID_).at(scheduledResultIndex_));
+            revealedSecretsByParty.at(partyID_).booleanSecrets.at(
+                scheduledResultIndex_));
         break;
 
       default:
@@ -135,15 +178,84 @@ class NormalGate final : public INormalGate<T> {
     }
   }
 
-  void increaseReferenceCount(IScheduler::WireId<T> wire) override {
-    if (!wire.isEmpty()) {
-      wireKeeper_.increaseReferenceCount(wire);
+  void computeArithmeticGate(
+      engine::ISecretShareEngine& engine,
+      std::map<int64_t, IGate::Secrets>& secretSharesByParty) {
+    switch (gateType_) {
+        // Free gates
+      case GateType::AsymmetricPlus:
+        wireKeeper_.setIntegerValue(
+            wireID_,
+            engine.computeAsymmetricPlus(
+                wireKeeper_.getIntegerValue(left_),
+                wireKeeper_.getIntegerValue(right_)));
+        break;
+
+      case GateType::SymmetricPlus:
+        wireKeeper_.setIntegerValue(
+            wireID_,
+            engine.computeSymmetricPlus(
+                wireKeeper_.getIntegerValue(left_),
+                wireKeeper_.getIntegerValue(right_)));
+        break;
+
+      case GateType::Neg:
+        wireKeeper_.setIntegerValue(
+            wireID_, engine.computeNeg(wireKeeper_.getIntegerValue(left_)));
+        break;
+
+      case GateType::FreeMult:
+        wireKeeper_.setIntegerValue(
+            wireID_,
+            engine.computeFreeMult(
+                wireKeeper_.getIntegerValue(left_),
+                wireKeeper_.getIntegerValue(right_)));
+        break;
+
+      case GateType::Input:
+        break;
+
+      // Non-free gates
+      case GateType::Output: {
+        if (secretSharesByParty.find(partyID_) == secretSharesByParty.end()) {
+          secretSharesByParty.emplace(partyID_, IGate::Secrets());
+        }
+        auto& secretShares = secretSharesByParty.at(partyID_);
+        scheduledResultIndex_ = secretShares.integerSecrets.size();
+        secretShares.integerSecrets.push_back(
+            wireKeeper_.getIntegerValue(left_));
+        break;
+      }
+
+      case GateType::NonFreeMult:
+        scheduledResultIndex_ = engine.scheduleMult(
+            wireKeeper_.getIntegerValue(left_),
+            wireKeeper_.getIntegerValue(right_));
+        break;
+
+      default:
+        throw std::invalid_argument("Not an arithmetic gate.");
     }
   }
 
-  void decreaseReferenceCount(IScheduler::WireId<T> wire) override {
-    if (!wire.isEmpty()) {
-      wireKeeper_.decreaseReferenceCount(wire);
+  void collectArithmeticResult(
+      engine::ISecretShareEngine& engine,
+      std::map<int64_t, IGate::Secrets>& revealedSecretsByParty) {
+    switch (gateType_) {
+      case GateType::NonFreeMult:
+        wireKeeper_.setIntegerValue(
+            wireID_, engine.getMultExecutionResult(scheduledResultIndex_));
+        break;
+
+      case GateType::Output:
+        wireKeeper_.setIntegerValue(
+            wireID_,
+            revealedSecretsByParty.at(partyID_).integerSecrets.at(
+                scheduledResultIndex_));
+        break;
+
+      default:
+        break;
     }
   }
 };
@@ -0,0 +1,498 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "fbpcf/scheduler/IWireKeeper.h"
+#include "fbpcf/scheduler/gate_keeper/IGate.h"
+#include "fbpcf/scheduler/gate_keeper/INormalGate.h"
+
+namespace fbpcf::scheduler {
+
+/**
+ * This class stores a run of non-batch normal gates of one level in flat
+ * arrays, one entry per gate, instead of one heap-allocated NormalGate each.
+ * The gates are computed in the order they were added with a switch on their
+ * type, so that a run of millions of scalar gates costs a few contiguous
+ * allocations and one virtual call.
+ * When vectorized, the non-free AND and multiplication gates are gathered
+ * into one batch gate of the engine and their results are scattered back to
+ * their wires. They can't read each other, since a non-free gate only reads
+ * wires of lower levels.
+ */
+template <IScheduler::WireType T>
+class NormalGateArena final : public IGate {
+ public:
+  using GateType = typename INormalGate<T>::GateType;
+
+  explicit NormalGateArena(IWireKeeper& wireKeeper, bool vectorize = false)
+      : vectorize_{vectorize}, wireKeeper_{wireKeeper} {
+    reserve(kInitialCapacity);
+  }
+
+  ~NormalGateArena() override {
+    for (size_t i = 0; i < gateTypes_.size(); i++) {
+      decreaseReferenceCount(outputWireIDs_[i]);
+      decreaseReferenceCount(leftWireIDs_[i]);
+      decreaseReferenceCount(rightWireIDs_[i]);
+    }
+  }
+
+  NormalGateArena(const NormalGateArena&) = delete;
+  NormalGateArena& operator=(const NormalGateArena&) = delete;
+
+  /**
+   * Append a gate, it will be computed after the gates already in the arena.
+   */
+  void addGate(
+      GateType gateType,
+      IScheduler::WireId<T> wireID,
+      IScheduler::WireId<T> left,
+      IScheduler::WireId<T> right,
+      int partyID) {
+    if (gateTypes_.size() == gateTypes_.capacity()) {
+      reserve(2 * gateTypes_.capacity());
+    }
+    gateTypes_.push_back(gateType);
+    outputWireIDs_.push_back(toRawId(wireID));
+    leftWireIDs_.push_back(toRawId(left));
+    rightWireIDs_.push_back(toRawId(right));
+    partyIDs_.push_back(partyID);
+    scheduledResultIndexes_.push_back(0);
+    allFree_ = allFree_ && INormalGate<T>::isFree(gateType);
+
+    increaseReferenceCount(outputWireIDs_.back());
+    increaseReferenceCount(leftWireIDs_.back());
+    increaseReferenceCount(rightWireIDs_.back());
+  }
+
+  /**
+   * Make room for the given number of gates on top of the ones already in the
+   * arena, so that adding them doesn't reallocate.
+   */
+  void reserveGates(size_t numberOfGates) {
+    auto capacity = gateTypes_.size() + numberOfGates;
+    if (capacity > gateTypes_.capacity()) {
+      reserve(std::max(capacity, 2 * gateTypes_.capacity()));
+    }
+  }
+
+  size_t size() const {
+    return gateTypes_.size();
+  }
+
+  GateType getGateType(size_t index) const {
+    return gateTypes_.at(index);
+  }
+
+  IScheduler::WireId<T> getWireId(size_t index) const {
+    return IScheduler::WireId<T>(outputWireIDs_.at(index));
+  }
+
+  size_t getNumberOfGates(GateType gateType) const {
+    return std::count(gateTypes_.begin(), gateTypes_.end(), gateType);
+  }
+
+  void compute(
+      engine::ISecretShareEngine& engine,
+      std::map<int64_t, IGate::Secrets>& secretSharesByParty) override {
+    if (vectorize_ && !allFree_) {
+      computeVectorized(engine, secretSharesByParty);
+      return;
+    }
+    for (size_t i = 0; i < gateTypes_.size(); i++) {
+      if constexpr (T == IScheduler::Boolean) {
+        computeBooleanGate(i, engine, secretSharesByParty);
+      } else {
+        computeArithmeticGate(i, engine, secretSharesByParty);
+      }
+    }
+  }
+
+  void collectScheduledResult(
+      engine::ISecretShareEngine& engine,
+      std::map<int64_t, IGate::Secrets>& revealedSecretsByParty) override {
+    if (allFree_) {
+      return;
+    }
+    if (vectorize_) {
+      collectVectorizedResult(engine, revealedSecretsByParty);
+      return;
+    }
+    for (size_t i = 0; i < gateTypes_.size(); i++) {
+      if constexpr (T == IScheduler::Boolean) {
+        collectBooleanResult(i, engine, revealedSecretsByParty);
+      } else {
+        collectArithmeticResult(i, engine, revealedSecretsByParty);
+      }
+    }
+  }
+
+  // Every gate has one result.
+  uint32_t getNumberOfResults() const override {
+    return gateTypes_.size();
+  }
+
+  // The gates in the arena may read each other, but they are computed in
+  // order on one thread.
+  bool canComputeConcurrently() const override {
+    return allFree_;
+  }
+
+  // The arena is dead once all of its gates were removed.
+  bool isDead() const override {
+    return gateTypes_.empty();
+  }
+
+  /**
+   * Remove the free gates whose output wires are only referenced by the arena
+   * and return how many were removed, see IGate::isDead(). The gates are
+   * visited from the last one, so that a gate only read by removed gates is
+   * removed as well.
+   */
+  size_t removeDeadGates() {
+    std::vector<bool> isRemoved(gateTypes_.size());
+    size_t numberOfRemovedGates = 0;
+    for (size_t i = gateTypes_.size(); i-- > 0;) {
+      if (INormalGate<T>::isFree(gateTypes_[i]) &&
+          wireKeeper_.getReferenceCount(
+              IScheduler::WireId<T>(outputWireIDs_[i])) == 1) {
+        decreaseReferenceCount(outputWireIDs_[i]);
+        decreaseReferenceCount(leftWireIDs_[i]);
+        decreaseReferenceCount(rightWireIDs_[i]);
+        isRemoved[i] = true;
+        numberOfRemovedGates++;
+      }
+    }
+    if (numberOfRemovedGates == 0) {
+      return 0;
+    }
+
+    size_t size = 0;
+    allFree_ = true;
+    for (size_t i = 0; i < gateTypes_.size(); i++) {
+      if (isRemoved[i]) {
+        continue;
+      }
+      gateTypes_[size] = gateTypes_[i];
+      outputWireIDs_[size] = outputWireIDs_[i];
+      leftWireIDs_[size] = leftWireIDs_[i];
+      rightWireIDs_[size] = rightWireIDs_[i];
+      partyIDs_[size] = partyIDs_[i];
+      allFree_ = allFree_ && INormalGate<T>::isFree(gateTypes_[i]);
+      size++;
+    }
+    gateTypes_.resize(size);
+    outputWireIDs_.resize(size);
+    leftWireIDs_.resize(size);
+    rightWireIDs_.resize(size);
+    partyIDs_.resize(size);
+    scheduledResultIndexes_.resize(size);
+    return numberOfRemovedGates;
+  }
+
+ private:
+  static const size_t kInitialCapacity = 64;
+  static constexpr uint64_t kNoWire = std::numeric_limits<uint64_t>::max();
+
+  static uint64_t toRawId(IScheduler::WireId<T> wire) {
+    return wire.isEmpty() ? kNoWire : wire.getId();
+  }
+
+  void reserve(size_t capacity) {
+    gateTypes_.reserve(capacity);
+    outputWireIDs_.reserve(capacity);
+    leftWireIDs_.reserve(capacity);
+    rightWireIDs_.reserve(capacity);
+    partyIDs_.reserve(capacity);
+    scheduledResultIndexes_.reserve(capacity);
+  }
+
+  void increaseReferenceCount(uint64_t wire) {
+    if (wire != kNoWire) {
+      wireKeeper_.increaseReferenceCount(IScheduler::WireId<T>(wire));
+    }
+  }
+
+  void decreaseReferenceCount(uint64_t wire) {
+    if (wire != kNoWire) {
+      wireKeeper_.decreaseReferenceCount(IScheduler::WireId<T>(wire));
+    }
+  }
+
+  bool getBooleanValue(uint64_t wire) const {
+    return wireKeeper_.getBooleanValue(IScheduler::WireId<T>(wire));
+  }
+
+  void setBooleanValue(uint64_t wire, bool v) {
+    wireKeeper_.setBooleanValue(IScheduler::WireId<T>(wire), v);
+  }
+
+  uint64_t getIntegerValue(uint64_t wire) const {
+    return wireKeeper_.getIntegerValue(IScheduler::WireId<T>(wire));
+  }
+
+  void setIntegerValue(uint64_t wire, uint64_t v) {
+    wireKeeper_.setIntegerValue(IScheduler::WireId<T>(wire), v);
+  }
+
+  static constexpr GateType kNonFreeGateType = T == IScheduler::Boolean
+      ? GateType::NonFreeAnd
+      : GateType::NonFreeMult;
+
+  // Gather the inputs of the non-free gates into one batch, the other gates
+  // are computed one by one.
+  void computeVectorized(
+      engine::ISecretShareEngine& engine,
+      std::map<int64_t, IGate::Secrets>& secretSharesByParty) {
+    using Value =
+        typename std::conditional<T == IScheduler::Boolean, bool, uint64_t>::
+            type;
+    std::vector<Value> leftValues;
+    std::vector<Value> rightValues;
+    for (size_t i = 0; i < gateTypes_.size(); i++) {
+      if (gateTypes_[i] == kNonFreeGateType) {
+        scheduledResultIndexes_[i] = leftValues.size();
+        if constexpr (T == IScheduler::Boolean) {
+          leftValues.push_back(getBooleanValue(leftWireIDs_[i]));
+          rightValues.push_back(getBooleanValue(rightWireIDs_[i]));
+        } else {
+          leftValues.push_back(getIntegerValue(leftWireIDs_[i]));
+          rightValues.push_back(getIntegerValue(rightWireIDs_[i]));
+        }
+      } else if constexpr (T == IScheduler::Boolean) {
+        computeBooleanGate(i, engine, secretSharesByParty);
+      } else {
+        computeArithmeticGate(i, engine, secretSharesByParty);
+      }
+    }
+    hasScheduledBatch_ = !leftValues.empty();
+    if (!hasScheduledBatch_) {
+      return;
+    }
+    if constexpr (T == IScheduler::Boolean) {
+      scheduledBatchIndex_ = engine.scheduleBatchAND(leftValues, rightValues);
+    } else {
+      scheduledBatchIndex_ = engine.scheduleBatchMult(leftValues, rightValues);
+    }
+  }
+
+  void collectVectorizedResult(
+      engine::ISecretShareEngine& engine,
+      std::map<int64_t, IGate::Secrets>& revealedSecretsByParty) {
+    if constexpr (T == IScheduler::Boolean) {
+      static const std::vector<bool> kNoResults;
+      auto& results = hasScheduledBatch_
+          ? engine.getBatchANDExecutionResult(scheduledBatchIndex_)
+          : kNoResults;
+      for (size_t i = 0; i < gateTypes_.size(); i++) {
+        if (gateTypes_[i] == kNonFreeGateType) {
+          setBooleanValue(
+              outputWireIDs_[i], results.at(scheduledResultIndexes_[i]));
+        } else {
+          collectBooleanResult(i, engine, revealedSecretsByParty);
+        }
+      }
+    } else {
+      static const std::vector<uint64_t> kNoResults;
+      auto& results = hasScheduledBatch_
+          ? engine.getBatchMultExecutionResult(scheduledBatchIndex_)
+          : kNoResults;
+      for (size_t i = 0; i < gateTypes_.size(); i++) {
+        if (gateTypes_[i] == kNonFreeGateType) {
+          setIntegerValue(
+              outputWireIDs_[i], results.at(scheduledResultIndexes_[i]));
+        } else {
+          collectArithmeticResult(i, engine, revealedSecretsByParty);
+        }
+      }
+    }
+  }
+
+  void computeBooleanGate(
+      size_t i,
+      engine::ISecretShareEngine& engine,
+      std::map<int64_t, IGate::Secrets>& secretSharesByParty) {
+    auto out = outputWireIDs_[i];
+    auto left = leftWireIDs_[i];
+    auto right = rightWireIDs_[i];
+    switch (gateTypes_[i]) {
+        // Free gates
+      case GateType::AsymmetricNot:
+        setBooleanValue(
+            out, engine.computeAsymmetricNOT(getBooleanValue(left)));
+        break;
+
+      case GateType::AsymmetricXOR:
+        setBooleanValue(
+            out,
+            engine.computeAsymmetricXOR(
+                getBooleanValue(left), getBooleanValue(right)));
+        break;
+
+      case GateType::FreeAnd:
+        setBooleanValue(
+            out,
+            engine.computeFreeAND(
+                getBooleanValue(left), getBooleanValue(right)));
+        break;
+
+      case GateType::Input:
+        break;
+
+      case GateType::SymmetricNot:
+        setBooleanValue(out, engine.computeSymmetricNOT(getBooleanValue(left)));
+        break;
+
+      case GateType::SymmetricXOR:
+        setBooleanValue(
+            out,
+            engine.computeSymmetricXOR(
+                getBooleanValue(left), getBooleanValue(right)));
+        break;
+
+      default:
+        throw std::invalid_argument("Not a boolean gate.");
+
+      // Non-free gates
+      case GateType::Output: {
+        auto& secretShares = secretSharesByParty[partyIDs_[i]];
+        scheduledResultIndexes_[i] = secretShares.booleanSecrets.size();
+        secretShares.booleanSecrets.push_back(getBooleanValue(left));
+        break;
+      }
+
+      case GateType::NonFreeAnd:
+        scheduledResultIndexes_[i] =
+            engine.scheduleAND(getBooleanValue(left), getBooleanValue(right));
+        break;
+    }
+  }
+
+  void collectBooleanResult(
+      size_t i,
+      engine::ISecretShareEngine& engine,
+      std::map<int64_t, IGate::Secrets>& revealedSecretsByParty) {
+    switch (gateTypes_[i]) {
+      case GateType::NonFreeAnd:
+        setBooleanValue(
+            outputWireIDs_[i],
+            engine.getANDExecutionResult(scheduledResultIndexes_[i]));
+        break;
+
+      case GateType::Output:
+        setBooleanValue(
+            outputWireIDs_[i],
+            revealedSecretsByParty.at(partyIDs_[i])
+                .booleanSecrets.at(scheduledResultIndexes_[i]));
+        break;
+
+      default:
+        break;
+    }
+  }
+
+  void computeArithmeticGate(
+      size_t i,
+      engine::ISecretShareEngine& engine,
+      std::map<int64_t, IGate::Secrets>& secretSharesByParty) {
+    auto out = outputWireIDs_[i];
+    auto left = leftWireIDs_[i];
+    auto right = rightWireIDs_[i];
+    switch (gateTypes_[i]) {
+        // Free gates
+      case GateType::AsymmetricPlus:
+        setIntegerValue(
+            out,
+            engine.computeAsymmetricPlus(
+                getIntegerValue(left), getIntegerValue(right)));
+        break;
+
+      case GateType::SymmetricPlus:
+        setIntegerValue(
+            out,
+            engine.computeSymmetricPlus(
+                getIntegerValue(left), getIntegerValue(right)));
+        break;
+
+      case GateType::Neg:
+        setIntegerValue(out, engine.computeNeg(getIntegerValue(left)));
+        break;
+
+      case GateType::FreeMult:
+        setIntegerValue(
+            out,
+            engine.computeFreeMult(
+                getIntegerValue(left), getIntegerValue(right)));
+        break;
+
+      case GateType::Input:
+        break;
+
+      // Non-free gates
+      case GateType::Output: {
+        auto& secretShares = secretSharesByParty[partyIDs_[i]];
+        scheduledResultIndexes_[i] = secretShares.integerSecrets.size();
+        secretShares.integerSecrets.push_back(getIntegerValue(left));
+        break;
+      }
+
+      case GateType::NonFreeMult:
+        scheduledResultIndexes_[i] =
+            engine.scheduleMult(getIntegerValue(left), getIntegerValue(right));
+        break;
+
+      default:
+        throw std::invalid_argument("Not an arithmetic gate.");
+    }
+  }
+
+  void collectArithmeticResult(
+      size_t i,
+      engine::ISecretShareEngine& engine,
+      std::map<int64_t, IGate::Secrets>& revealedSecretsByParty) {
+    switch (gateTypes_[i]) {
+      case GateType::NonFreeMult:
+        setIntegerValue(
+            outputWireIDs_[i],
+            engine.getMultExecutionResult(scheduledResultIndexes_[i]));
+        break;
+
+      case GateType::Output:
+        setIntegerValue(
+            outputWireIDs_[i],
+            revealedSecretsByParty.at(partyIDs_[i])
+                .integerSecrets.at(scheduledResultIndexes_[i]));
+        break;
+
+      default:
+        break;
+    }
+  }
+
+  std::vector<GateType> gateTypes_;
+  std::vector<uint64_t> outputWireIDs_;
+  std::vector<uint64_t> leftWireIDs_;
+  std::vector<uint64_t> rightWireIDs_;
+  std::vector<int> partyIDs_;
+  std::vector<uint32_t> scheduledResultIndexes_;
+  bool allFree_ = true;
+  bool vectorize_;
+  bool hasScheduledBatch_ = false;
+  uint32_t scheduledBatchIndex_ = 0;
+  IWireKeeper& wireKeeper_;
+};
+
+} // namespace fbpcf::scheduler
@@ -10,8 +10,10 @@
 #include <fbpcf/scheduler/gate_keeper/IGate.h>
 #include "fbpcf/scheduler/IScheduler.h"
 #include "fbpcf/scheduler/WireKeeper.h"
+#include "fbpcf/scheduler/gate_keeper/ConversionGate.h"
 #include "fbpcf/scheduler/gate_keeper/GateKeeper.h"
 #include "fbpcf/scheduler/gate_keeper/INormalGate.h"
+#include "fbpcf/scheduler/gate_keeper/NormalGateArena.h"
 
 namespace fbpcf::scheduler {
 
@@ -51,6 +53,18 @@ void testLevel(
   }
 }
 
+void testArithmeticLevel(
+    std::vector<std::unique_ptr<IGate>> level,
+    std::vector<IScheduler::WireId<IScheduler::Arithmetic>> expectedWires) {
+  ASSERT_EQ(level.size(), expectedWires.size());
+  for (auto i = 0; i < level.size(); ++i) {
+    auto normalGate =
+        dynamic_cast<INormalGate<IScheduler::Arithmetic>*>(level.at(i).get());
+    ASSERT_NE(normalGate, nullptr);
+    EXPECT_EQ(normalGate->getWireId().getId(), expectedWires.at(i).getId());
+  }
+}
+
 TEST(GateKeeperTest, TestAddAndRemoveGates) {
   std::shared_ptr<IWireKeeper> wireKeeper =
       WireKeeper::createWithVectorArena<unsafe>();
@@ -213,4 +227,548 @@ TEST(GateKeeperTest, TestCompositeGates) {
   // check level 131
   testLevel(gateKeeper->popFirstUnexecutedLevel(), {}, {wires4});
 }
+
+TEST(GateKeeperTest, TestArithmeticGates) {
+  std::shared_ptr<IWireKeeper> wireKeeper =
+      WireKeeper::createWithVectorArena<unsafe>();
+  auto gateKeeper = std::make_unique<GateKeeper>(wireKeeper);
+
+  // Level 0
+  auto wire1 = gateKeeper->integerInputGate(3);
+  auto wire2 = gateKeeper->integerInputGateBatch({4, 5});
+  auto wire3 = gateKeeper->integerInputGateBatch({6, 7});
+
+  // Level 1
+  auto wire4 = gateKeeper->normalGate(
+      INormalGate<IScheduler::Arithmetic>::GateType::NonFreeMult,
+      wire1,
+      wire1);
+  auto wire5 = gateKeeper->normalGateBatch(
+      INormalGate<IScheduler::Arithmetic>::GateType::NonFreeMult,
+      wire2,
+      wire3);
+
+  // Level 2
+  auto wire6 = gateKeeper->normalGateBatch(
+      INormalGate<IScheduler::Arithmetic>::GateType::SymmetricPlus,
+      wire5,
+      wire2);
+  auto wire7 = gateKeeper->normalGate(
+      INormalGate<IScheduler::Arithmetic>::GateType::Neg, wire4);
+
+  // Level 0
+  auto wire8 = gateKeeper->normalGate(
+      INormalGate<IScheduler::Arithmetic>::GateType::FreeMult, wire1, wire1);
+
+  // Level 3
+  auto wire9 = gateKeeper->outputGateBatch(wire6, 0);
+  auto wire10 = gateKeeper->outputGate(wire7, 1);
+
+  EXPECT_EQ(gateKeeper->getFirstUnexecutedLevel(), 0);
+
+  testArithmeticLevel(
+      gateKeeper->popFirstUnexecutedLevel(), {wire1, wire2, wire3, wire8});
+  testArithmeticLevel(gateKeeper->popFirstUnexecutedLevel(), {wire4, wire5});
+  testArithmeticLevel(gateKeeper->popFirstUnexecutedLevel(), {wire6, wire7});
+  testArithmeticLevel(gateKeeper->popFirstUnexecutedLevel(), {wire9, wire10});
+
+  EXPECT_EQ(gateKeeper->getFirstUnexecutedLevel(), 4);
+}
+
+template <bool usingBatch>
+void testConversionLevel(
+    std::vector<std::unique_ptr<IGate>> level,
+    size_t expectedNumberOfGates,
+    size_t expectedNumberOfConversions) {
+  ASSERT_EQ(level.size(), expectedNumberOfGates);
+  size_t numberOfConversions = 0;
+  for (auto& gate : level) {
+    if (dynamic_cast<ConversionGate<usingBatch>*>(gate.get()) != nullptr) {
+      numberOfConversions++;
+    }
+  }
+  EXPECT_EQ(numberOfConversions, expectedNumberOfConversions);
+}
+
+TEST(GateKeeperTest, TestConversionGates) {
+  std::shared_ptr<IWireKeeper> wireKeeper =
+      WireKeeper::createWithVectorArena<unsafe>();
+  auto gateKeeper = std::make_unique<GateKeeper>(wireKeeper);
+
+  // Level 0, splitting the shares into summands is free
+  auto wire1 = gateKeeper->inputGate(true);
+  auto wire2 = gateKeeper->integerInputGate(3);
+  auto summands1 = gateKeeper->integerToBooleanSummandsGate(wire2, 4, 2);
+  EXPECT_EQ(summands1.size(), 8);
+
+  // Level 1
+  auto wire3 = gateKeeper->booleanToIntegerGate({wire1, summands1.at(0)});
+
+  // Level 2
+  auto summands2 = gateKeeper->integerToBooleanSummandsGate(wire3, 1, 2);
+  EXPECT_EQ(summands2.size(), 2);
+
+  EXPECT_EQ(gateKeeper->getFirstUnexecutedLevel(), 0);
+  testConversionLevel<false>(gateKeeper->popFirstUnexecutedLevel(), 3, 1);
+  testConversionLevel<false>(gateKeeper->popFirstUnexecutedLevel(), 1, 1);
+  testConversionLevel<false>(gateKeeper->popFirstUnexecutedLevel(), 1, 1);
+
+  // Level 4
+  auto wire4 = gateKeeper->integerInputGateBatch({4, 5});
+  auto summands3 = gateKeeper->integerToBooleanSummandsGateBatch(wire4, 2, 2);
+  EXPECT_EQ(summands3.size(), 4);
+
+  // Level 5
+  gateKeeper->booleanToIntegerGateBatch(summands3);
+
+  testConversionLevel<true>(gateKeeper->popFirstUnexecutedLevel(), 0, 0);
+  testConversionLevel<true>(gateKeeper->popFirstUnexecutedLevel(), 2, 1);
+  testConversionLevel<true>(gateKeeper->popFirstUnexecutedLevel(), 1, 1);
+
+  EXPECT_EQ(gateKeeper->getFirstUnexecutedLevel(), 6);
+}
+
+TEST(GateKeeperTest, TestPopGatesIndependentOfLevel) {
+  std::shared_ptr<IWireKeeper> wireKeeper =
+      WireKeeper::createWithVectorArena<unsafe>();
+  auto gateKeeper = std::make_unique<GateKeeper>(wireKeeper);
+
+  // Level 0
+  auto wire1 = gateKeeper->inputGate(true);
+  auto wire2 = gateKeeper->inputGate(false);
+
+  // Level 1
+  auto wire3 = gateKeeper->normalGate(
+      INormalGate<IScheduler::Boolean>::GateType::NonFreeAnd, wire1, wire2);
+
+  testLevel(gateKeeper->popFirstUnexecutedLevel(), {wire1, wire2}, {});
+
+  // non-free levels are never taken apart
+  EXPECT_EQ(gateKeeper->popGatesIndependentOfLevel(1).size(), 0);
+
+  // Level 2, the first two gates don't depend on level 1
+  auto wire4 = gateKeeper->inputGate(true);
+  auto wire5 = gateKeeper->normalGate(
+      INormalGate<IScheduler::Boolean>::GateType::AsymmetricXOR, wire1, wire2);
+  auto wire6 = gateKeeper->normalGate(
+      INormalGate<IScheduler::Boolean>::GateType::AsymmetricXOR, wire3, wire1);
+  auto wire7 = gateKeeper->normalGate(
+      INormalGate<IScheduler::Boolean>::GateType::AsymmetricXOR, wire5, wire2);
+
+  testLevel(gateKeeper->popFirstUnexecutedLevel(), {wire3}, {});
+  EXPECT_EQ(gateKeeper->getFirstUnexecutedLevel(), 2);
+
+  // wire7 reads wire5 from the same level, so it isn't taken either
+  testLevel(gateKeeper->popGatesIndependentOfLevel(1), {wire4, wire5}, {});
+  testLevel(gateKeeper->popFirstUnexecutedLevel(), {wire6, wire7}, {});
+  EXPECT_EQ(gateKeeper->getFirstUnexecutedLevel(), 3);
+}
+
+void testArena(
+    const std::unique_ptr<IGate>& gate,
+    std::vector<IScheduler::WireId<IScheduler::Boolean>> expectedWires) {
+  auto arena =
+      dynamic_cast<NormalGateArena<IScheduler::Boolean>*>(gate.get());
+  ASSERT_NE(arena, nullptr);
+  ASSERT_EQ(arena->size(), expectedWires.size());
+  EXPECT_EQ(arena->getNumberOfResults(), expectedWires.size());
+  for (size_t i = 0; i < expectedWires.size(); ++i) {
+    EXPECT_EQ(arena->getWireId(i).getId(), expectedWires.at(i).getId());
+  }
+}
+
+TEST(GateKeeperTest, TestGateArena) {
+  using GateType = INormalGate<IScheduler::Boolean>::GateType;
+  std::shared_ptr<IWireKeeper> wireKeeper =
+      WireKeeper::createWithVectorArena<unsafe>();
+  auto gateKeeper =
+      std::make_unique<GateKeeper>(wireKeeper, /*useGateArena*/ true);
+
+  // Level 0, a batch gate splits the run of scalar gates
+  auto wire1 = gateKeeper->inputGate(true);
+  auto wire2 = gateKeeper->inputGate(false);
+  gateKeeper->inputGateBatch({true, false});
+  auto wire3 = gateKeeper->normalGate(GateType::AsymmetricXOR, wire1, wire2);
+
+  // Level 1
+  auto wire4 = gateKeeper->normalGate(GateType::NonFreeAnd, wire1, wire2);
+  auto wire5 = gateKeeper->normalGate(GateType::NonFreeAnd, wire3, wire1);
+
+  EXPECT_FALSE(gateKeeper->hasReachedBatchingLimit());
+
+  auto level0 = gateKeeper->popFirstUnexecutedLevel();
+  ASSERT_EQ(level0.size(), 3);
+  testArena(level0.at(0), {wire1, wire2});
+  EXPECT_NE(
+      dynamic_cast<INormalGate<IScheduler::Boolean>*>(level0.at(1).get()),
+      nullptr);
+  testArena(level0.at(2), {wire3});
+  EXPECT_TRUE(level0.at(0)->canComputeConcurrently());
+
+  auto level1 = gateKeeper->popFirstUnexecutedLevel();
+  ASSERT_EQ(level1.size(), 1);
+  testArena(level1.at(0), {wire4, wire5});
+  EXPECT_FALSE(level1.at(0)->canComputeConcurrently());
+
+  // Level 2, an arena is independent of level 1 if all its gates are
+  auto wire6 = gateKeeper->normalGate(GateType::AsymmetricXOR, wire1, wire2);
+  auto independentGates = gateKeeper->popGatesIndependentOfLevel(1);
+  ASSERT_EQ(independentGates.size(), 1);
+  testArena(independentGates.at(0), {wire6});
+
+  auto wire7 = gateKeeper->normalGate(GateType::AsymmetricXOR, wire1, wire2);
+  auto wire8 = gateKeeper->normalGate(GateType::AsymmetricXOR, wire4, wire1);
+  EXPECT_EQ(gateKeeper->popGatesIndependentOfLevel(1).size(), 0);
+
+  auto level2 = gateKeeper->popFirstUnexecutedLevel();
+  ASSERT_EQ(level2.size(), 1);
+  testArena(level2.at(0), {wire7, wire8});
+  EXPECT_EQ(gateKeeper->getFirstUnexecutedLevel(), 3);
+}
+
+TEST(GateKeeperTest, TestGateArenaBatchingLimit) {
+  std::shared_ptr<IWireKeeper> wireKeeper =
+      WireKeeper::createWithVectorArena<unsafe>();
+  auto gateKeeper =
+      std::make_unique<GateKeeper>(wireKeeper, /*useGateArena*/ true);
+
+  // every gate in an arena counts towards the batching limit
+  std::vector<IScheduler::WireId<IScheduler::Boolean>> wires;
+  while (!gateKeeper->hasReachedBatchingLimit()) {
+    wires.push_back(gateKeeper->inputGate(true));
+  }
+  EXPECT_GT(wires.size(), 1);
+
+  auto level0 = gateKeeper->popFirstUnexecutedLevel();
+  testArena(level0.at(0), wires);
+  EXPECT_FALSE(gateKeeper->hasReachedBatchingLimit());
+}
+
+TEST(GateKeeperTest, TestPendingBytes) {
+  using GateType = INormalGate<IScheduler::Boolean>::GateType;
+  std::shared_ptr<IWireKeeper> wireKeeper =
+      WireKeeper::createWithVectorArena<unsafe>();
+  auto gateKeeper = std::make_unique<GateKeeper>(wireKeeper);
+
+  // Level 0, batches of booleans take a bit per value
+  gateKeeper->inputGate(true);
+  auto wire2 = gateKeeper->inputGateBatch(std::vector<bool>(100));
+  gateKeeper->integerInputGateBatch(std::vector<uint64_t>(3));
+  EXPECT_EQ(gateKeeper->getPendingBytes(), sizeof(bool) + 13 + 24);
+
+  // Level 1, the batch size of a gate comes from its input. The integer input
+  // gates go to level 0.
+  auto wire4 =
+      gateKeeper->normalGateBatch(GateType::NonFreeAnd, wire2, wire2);
+  gateKeeper->compositeGateBatch(
+      ICompositeGate::GateType::NonFreeAnd, wire2, {wire2, wire2, wire2});
+  gateKeeper->normalGate(
+      INormalGate<IScheduler::Arithmetic>::GateType::NonFreeMult,
+      gateKeeper->integerInputGate(1),
+      gateKeeper->integerInputGate(2));
+  EXPECT_EQ(
+      gateKeeper->getPendingBytes(),
+      sizeof(bool) + 13 + 24 + 2 * sizeof(uint64_t) + 13 + 3 * 13 +
+          sizeof(uint64_t));
+
+  auto level0 = gateKeeper->popFirstUnexecutedLevel();
+  EXPECT_EQ(gateKeeper->getPendingBytes(), 13 + 3 * 13 + sizeof(uint64_t));
+  auto level1 = gateKeeper->popFirstUnexecutedLevel();
+  EXPECT_EQ(gateKeeper->getPendingBytes(), 0);
+
+  // Level 2, the size of a computed batch wire comes from its value
+  wireKeeper->setBatchBooleanValue(wire4, std::vector<bool>(16));
+  gateKeeper->normalGateBatch(GateType::SymmetricNot, wire4, wire4);
+  EXPECT_EQ(gateKeeper->getPendingBytes(), 2);
+
+  EXPECT_EQ(
+      gateKeeper->getPeakPendingBytes(),
+      sizeof(bool) + 13 + 24 + 2 * sizeof(uint64_t) + 13 + 3 * 13 +
+          sizeof(uint64_t));
+}
+
+TEST(GateKeeperTest, TestPendingANDs) {
+  using GateType = INormalGate<IScheduler::Boolean>::GateType;
+  for (auto useGateArena : {false, true}) {
+    std::shared_ptr<IWireKeeper> wireKeeper =
+        WireKeeper::createWithVectorArena<unsafe>();
+    auto gateKeeper = std::make_unique<GateKeeper>(wireKeeper, useGateArena);
+
+    // Level 0
+    auto wire1 = gateKeeper->inputGate(true);
+    auto wire2 = gateKeeper->inputGateBatch(std::vector<bool>(100));
+    EXPECT_EQ(gateKeeper->getNumberOfPendingANDs(), 0);
+
+    // Level 1, a batch AND takes a tuple per value, composite ANDs and
+    // multiplications don't take boolean tuples
+    auto wire3 = gateKeeper->normalGate(GateType::NonFreeAnd, wire1, wire1);
+    gateKeeper->normalGate(GateType::NonFreeAnd, wire1, wire1);
+    gateKeeper->normalGateBatch(GateType::NonFreeAnd, wire2, wire2);
+    gateKeeper->compositeGateBatch(
+        ICompositeGate::GateType::NonFreeAnd, wire2, {wire2, wire2});
+    gateKeeper->normalGate(
+        INormalGate<IScheduler::Arithmetic>::GateType::NonFreeMult,
+        gateKeeper->integerInputGate(1),
+        gateKeeper->integerInputGate(2));
+    EXPECT_EQ(gateKeeper->getNumberOfPendingANDs(), 102);
+
+    // unread ANDs still take tuples, the other parties take part in them
+    gateKeeper->decreaseReferenceCount(wire3);
+    gateKeeper->popFirstUnexecutedLevel();
+    EXPECT_EQ(gateKeeper->getNumberOfPendingANDs(), 102);
+    gateKeeper->popFirstUnexecutedLevel();
+    EXPECT_EQ(gateKeeper->getNumberOfPendingANDs(), 0);
+  }
+}
+
+TEST(GateKeeperTest, TestMemoryBudget) {
+  std::shared_ptr<IWireKeeper> wireKeeper =
+      WireKeeper::createWithVectorArena<unsafe>();
+  auto gateKeeper = std::make_unique<GateKeeper>(
+      wireKeeper, /*useGateArena*/ false, /*memoryBudget*/ 200);
+
+  // two batches of 800 booleans fit in the budget, a third one doesn't
+  gateKeeper->inputGateBatch(std::vector<bool>(800));
+  gateKeeper->inputGateBatch(std::vector<bool>(800));
+  EXPECT_FALSE(gateKeeper->hasReachedBatchingLimit());
+  gateKeeper->inputGateBatch(std::vector<bool>(800));
+  EXPECT_TRUE(gateKeeper->hasReachedBatchingLimit());
+
+  gateKeeper->popFirstUnexecutedLevel();
+  EXPECT_FALSE(gateKeeper->hasReachedBatchingLimit());
+  EXPECT_EQ(gateKeeper->getPeakPendingBytes(), 300);
+}
+
+TEST(GateKeeperTest, TestAdaptiveBatchingLimit) {
+  std::shared_ptr<IWireKeeper> wireKeeper =
+      WireKeeper::createWithVectorArena<unsafe>();
+  auto gateKeeper = std::make_unique<GateKeeper>(wireKeeper);
+  auto maxUnexecutedGates = GateKeeper::kMinMaxUnexecutedGates;
+  EXPECT_EQ(gateKeeper->getMaxUnexecutedGates(), maxUnexecutedGates);
+
+  // the limit grows while the levels are too narrow to amortize their round
+  // trips
+  auto narrowLevel = GateKeeper::kMinResultsPerRoundTrip - 1;
+  auto wideLevel = GateKeeper::kMaxResultsPerRoundTrip + 1;
+  gateKeeper->recordNonFreeLevel(narrowLevel);
+  EXPECT_EQ(gateKeeper->getMaxUnexecutedGates(), 2 * maxUnexecutedGates);
+  for (int i = 0; i < 10; i++) {
+    gateKeeper->recordNonFreeLevel(narrowLevel);
+  }
+  EXPECT_EQ(
+      gateKeeper->getMaxUnexecutedGates(), GateKeeper::kMaxMaxUnexecutedGates);
+
+  // it stays the same if the levels are wide enough
+  gateKeeper->recordNonFreeLevel(GateKeeper::kMinResultsPerRoundTrip);
+  EXPECT_EQ(
+      gateKeeper->getMaxUnexecutedGates(), GateKeeper::kMaxMaxUnexecutedGates);
+
+  // and shrinks back when the levels are bound by local computation
+  for (int i = 0; i < 10; i++) {
+    gateKeeper->recordNonFreeLevel(wideLevel);
+  }
+  EXPECT_EQ(gateKeeper->getMaxUnexecutedGates(), maxUnexecutedGates);
+
+  // it doesn't grow if the unexecuted gates take half of the memory budget
+  auto smallBudgetGateKeeper = std::make_unique<GateKeeper>(
+      wireKeeper, /*useGateArena*/ false, /*memoryBudget*/ 200);
+  smallBudgetGateKeeper->inputGateBatch(std::vector<bool>(800));
+  smallBudgetGateKeeper->recordNonFreeLevel(narrowLevel);
+  EXPECT_EQ(
+      smallBudgetGateKeeper->getMaxUnexecutedGates(), maxUnexecutedGates);
+}
+
+TEST(GateKeeperTest, TestDeadGates) {
+  using GateType = INormalGate<IScheduler::Boolean>::GateType;
+  for (auto useGateArena : {false, true}) {
+    std::shared_ptr<IWireKeeper> wireKeeper =
+        WireKeeper::createWithVectorArena<unsafe>();
+    auto gateKeeper = std::make_unique<GateKeeper>(wireKeeper, useGateArena);
+
+    // Level 0
+    auto wire1 = gateKeeper->inputGate(true);
+    auto wire2 = gateKeeper->inputGate(false);
+    auto wire3 = gateKeeper->normalGate(GateType::AsymmetricXOR, wire1, wire2);
+    auto wires4 = gateKeeper->compositeGate(
+        ICompositeGate::GateType::FreeAnd, wire1, {wire2, wire3});
+    auto wire8 = gateKeeper->normalGate(GateType::SymmetricXOR, wire1, wire2);
+    auto wire9 = gateKeeper->normalGate(GateType::AsymmetricNot, wire8);
+    // Level 1
+    auto wire5 = gateKeeper->normalGate(GateType::NonFreeAnd, wire3, wire1);
+    auto wire6 = gateKeeper->normalGate(GateType::NonFreeAnd, wire2, wire1);
+    // Level 2
+    auto wire7 = gateKeeper->normalGate(GateType::AsymmetricNot, wire5);
+    // Level 3
+    auto wire10 = gateKeeper->outputGate(wire6, 0);
+
+    // wire7 isn't read, wire9 isn't read and wire8 is only read by wire9, the
+    // outputs of the composite gate aren't read. wire5 and wire10 aren't read
+    // either, but they are non-free gates, which the other parties take part
+    // in.
+    gateKeeper->decreaseReferenceCount(wire3);
+    gateKeeper->decreaseReferenceCount(wires4.at(0));
+    gateKeeper->decreaseReferenceCount(wires4.at(1));
+    gateKeeper->decreaseReferenceCount(wire5);
+    gateKeeper->decreaseReferenceCount(wire7);
+    gateKeeper->decreaseReferenceCount(wire8);
+    gateKeeper->decreaseReferenceCount(wire9);
+    gateKeeper->decreaseReferenceCount(wire10);
+    EXPECT_EQ(gateKeeper->getNumberOfDeadGates(), 0);
+
+    auto level0 = gateKeeper->popFirstUnexecutedLevel();
+    EXPECT_EQ(gateKeeper->getNumberOfDeadGates(), 4);
+    if (useGateArena) {
+      ASSERT_EQ(level0.size(), 1);
+      testArena(level0.at(0), {wire1, wire2, wire3});
+    } else {
+      testLevel(std::move(level0), {wire1, wire2, wire3}, {});
+    }
+
+    auto level1 = gateKeeper->popFirstUnexecutedLevel();
+    EXPECT_EQ(level1.size(), useGateArena ? 1 : 2);
+    EXPECT_EQ(wireKeeper->getReferenceCount(wire5), 1);
+    // the dead wire7 is still pending until its level is popped
+    auto pendingBytes = gateKeeper->getPendingBytes();
+    EXPECT_EQ(gateKeeper->popFirstUnexecutedLevel().size(), 0);
+    EXPECT_LT(gateKeeper->getPendingBytes(), pendingBytes);
+    EXPECT_EQ(wireKeeper->getReferenceCount(wire10), 1);
+    EXPECT_EQ(gateKeeper->popFirstUnexecutedLevel().size(), 1);
+    EXPECT_EQ(gateKeeper->getPendingBytes(), 0);
+  }
+}
+
+TEST(GateKeeperTest, TestFoldedGates) {
+  using GateType = INormalGate<IScheduler::Boolean>::GateType;
+  std::shared_ptr<IWireKeeper> wireKeeper =
+      WireKeeper::createWithVectorArena<unsafe>();
+  auto gateKeeper = std::make_unique<GateKeeper>(wireKeeper);
+
+  // Level 0, the values of public input gates are known before they are
+  // executed
+  auto wire1 = gateKeeper->publicInputGate(true);
+  auto wire2 = gateKeeper->normalGate(GateType::AsymmetricNot, wire1);
+  auto wire3 = gateKeeper->publicInputGateBatch({true, false});
+  auto privateWire = gateKeeper->inputGate(true);
+  EXPECT_TRUE(gateKeeper->canFoldGate(wire1));
+  EXPECT_FALSE(gateKeeper->canFoldGate(privateWire));
+  EXPECT_FALSE(gateKeeper->canFoldGate(wire1, wire2));
+  EXPECT_TRUE(gateKeeper->canFoldGateBatch(wire3));
+
+  auto wire4 = gateKeeper->foldedGate(false, wire1);
+  auto wire5 = gateKeeper->foldedGateBatch({false, true}, wire3);
+  EXPECT_TRUE(gateKeeper->canFoldGate(wire1, wire4));
+  EXPECT_TRUE(gateKeeper->canFoldGateBatch(wire3, wire5));
+  EXPECT_FALSE(wireKeeper->getBooleanValue(wire4));
+  EXPECT_EQ(gateKeeper->getNumberOfFoldedGates(), 2);
+
+  // Level 1, the folded wires are at the level of their gates
+  auto wire6 = gateKeeper->normalGate(GateType::NonFreeAnd, wire4, wire4);
+  auto wire7 = gateKeeper->normalGateBatch(GateType::NonFreeAnd, wire5, wire5);
+  EXPECT_EQ(wireKeeper->getFirstAvailableLevel(wire6), 1);
+  EXPECT_EQ(wireKeeper->getBatchFirstAvailableLevel(wire7), 1);
+
+  testLevel(
+      gateKeeper->popFirstUnexecutedLevel(),
+      {wire1, wire2, wire3, privateWire},
+      {});
+  EXPECT_TRUE(gateKeeper->canFoldGate(wire2));
+  EXPECT_FALSE(gateKeeper->canFoldGate(wire6));
+
+  // gates are never folded while recording
+  gateKeeper->startRecording({wire1});
+  EXPECT_FALSE(gateKeeper->canFoldGate(wire1));
+  gateKeeper->stopRecording({wire1});
+  EXPECT_TRUE(gateKeeper->canFoldGate(wire1));
+}
+
+TEST(GateKeeperTest, TestRecordAndReplay) {
+  using GateType = INormalGate<IScheduler::Boolean>::GateType;
+  std::shared_ptr<IWireKeeper> wireKeeper =
+      WireKeeper::createWithVectorArena<unsafe>();
+  auto gateKeeper = std::make_unique<GateKeeper>(wireKeeper);
+
+  // Level 0
+  auto wire1 = gateKeeper->inputGate(true);
+  auto wire2 = gateKeeper->inputGate(false);
+
+  gateKeeper->startRecording({wire1, wire2});
+  // Level 0
+  auto wire3 = gateKeeper->inputGate(true);
+  auto wire4 = gateKeeper->normalGate(GateType::AsymmetricXOR, wire1, wire3);
+  // Level 1
+  auto wire5 = gateKeeper->normalGate(GateType::NonFreeAnd, wire4, wire2);
+  // Level 2
+  auto wire6 = gateKeeper->normalGate(GateType::SymmetricNot, wire5);
+  auto circuit = gateKeeper->stopRecording({wire6, wire4});
+
+  EXPECT_FALSE(circuit->isBatch());
+  EXPECT_EQ(circuit->getNumberOfInputs(), 2);
+  EXPECT_EQ(circuit->getNumberOfWires(), 6);
+  ASSERT_EQ(circuit->getGates().size(), 4);
+  std::vector<uint32_t> levels;
+  for (auto& gate : circuit->getGates()) {
+    levels.push_back(gate.level);
+  }
+  EXPECT_EQ(levels, std::vector<uint32_t>({0, 0, 1, 2}));
+  EXPECT_EQ(circuit->getGates().at(1).left, 0);
+  EXPECT_EQ(circuit->getGates().at(1).right, 2);
+  EXPECT_EQ(circuit->getConstant(circuit->getGates().at(0).constant).at(0), 1);
+  EXPECT_EQ(circuit->getOutputs(), std::vector<uint32_t>({5, 3}));
+
+  testLevel(
+      gateKeeper->popFirstUnexecutedLevel(), {wire1, wire2, wire3, wire4}, {});
+
+  // Replay on wire6 and wire5, the circuit starts at level 2 where wire6 is
+  // available.
+  auto outputs = gateKeeper->addCircuit(*circuit, {wire6, wire5});
+  ASSERT_EQ(outputs.size(), 2);
+
+  testLevel(gateKeeper->popFirstUnexecutedLevel(), {wire5}, {});
+  auto level2 = gateKeeper->popFirstUnexecutedLevel();
+  ASSERT_EQ(level2.size(), 3);
+  EXPECT_EQ(
+      dynamic_cast<INormalGate<IScheduler::Boolean>*>(level2.at(2).get())
+          ->getWireId()
+          .getId(),
+      outputs.at(1).getId());
+  EXPECT_EQ(gateKeeper->popFirstUnexecutedLevel().size(), 1);
+  testLevel(gateKeeper->popFirstUnexecutedLevel(), {outputs.at(0)}, {});
+}
+
+TEST(GateKeeperTest, TestRecordingErrors) {
+  using GateType = INormalGate<IScheduler::Boolean>::GateType;
+  std::shared_ptr<IWireKeeper> wireKeeper =
+      WireKeeper::createWithVectorArena<unsafe>();
+  auto gateKeeper = std::make_unique<GateKeeper>(wireKeeper);
+
+  auto wire1 = gateKeeper->inputGate(true);
+  auto wire2 = gateKeeper->inputGate(false);
+  auto batchWire = gateKeeper->inputGateBatch({true, false});
+  EXPECT_THROW(gateKeeper->stopRecording({}), std::runtime_error);
+
+  gateKeeper->startRecording({wire1});
+  EXPECT_THROW(gateKeeper->startRecording({wire1}), std::runtime_error);
+  // wire2 isn't an input
+  EXPECT_THROW(
+      gateKeeper->normalGate(GateType::AsymmetricXOR, wire1, wire2),
+      std::invalid_argument);
+  // only non-batch normal boolean gates are recorded
+  EXPECT_THROW(
+      gateKeeper->normalGateBatch(GateType::SymmetricNot, batchWire),
+      std::invalid_argument);
+  EXPECT_THROW(
+      gateKeeper->compositeGate(
+          ICompositeGate::GateType::NonFreeAnd, wire1, {wire1}),
+      std::invalid_argument);
+  EXPECT_THROW(gateKeeper->integerInputGate(1), std::invalid_argument);
+  EXPECT_THROW(
+      gateKeeper->booleanToIntegerGate({wire1}), std::invalid_argument);
+  EXPECT_THROW(gateKeeper->stopRecording({wire2}), std::invalid_argument);
+
+  auto wire3 = gateKeeper->normalGate(GateType::SymmetricNot, wire1);
+  auto circuit = gateKeeper->stopRecording({wire3});
+  EXPECT_THROW(
+      gateKeeper->addCircuit(*circuit, {wire1, wire2}), std::invalid_argument);
+}
+
 } // namespace fbpcf::scheduler
@@ -0,0 +1,222 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "fbpcf/scheduler/BristolCircuit.h"
+#include "fbpcf/scheduler/IScheduler.h"
+#include "fbpcf/scheduler/PlaintextScheduler.h"
+#include "fbpcf/scheduler/WireKeeper.h"
+#include "fbpcf/scheduler/gate_keeper/GateKeeper.h"
+
+namespace fbpcf::scheduler {
+
+using WireId = IScheduler::WireId<IScheduler::Boolean>;
+
+// a full adder: (sum, carry) = a + b + c
+const std::string kFullAdder =
+    "4 8\n"
+    "3 1 1 1\n"
+    "2 1 1\n"
+    "\n"
+    "2 1 0 1 3 XOR\n"
+    "2 1 3 2 6 XOR\n"
+    "4 2 0 3 1 2 4 5 MAND\n"
+    "2 1 4 5 7 XOR\n";
+
+// (!x ^ y, x), going through constants and copies
+const std::string kConstants =
+    "8 10\n"
+    "2 1 1\n"
+    "2 1 1\n"
+    "\n"
+    "1 1 1 2 EQ\n"
+    "2 1 0 2 3 AND\n"
+    "1 1 3 4 INV\n"
+    "2 1 4 1 5 XOR\n"
+    "1 1 5 6 EQW\n"
+    "2 1 2 2 7 XOR\n"
+    "2 1 7 6 8 XOR\n"
+    "1 1 3 9 EQW\n";
+
+BristolCircuit readCircuit(const std::string& text) {
+  std::istringstream in(text);
+  return BristolCircuit::read(in);
+}
+
+// evaluate the circuit on every assignment of its inputs, one at a time and
+// in a batch.
+void testCircuit(
+    const BristolCircuit& circuit,
+    std::function<std::vector<bool>(const std::vector<bool>&)> expected) {
+  PlaintextScheduler scheduler(WireKeeper::createWithUnorderedMap());
+  auto numberOfInputs = circuit.getNumberOfInputWires();
+  auto numberOfOutputs = circuit.getNumberOfOutputWires();
+  size_t numberOfAssignments = 1 << numberOfInputs;
+
+  std::vector<std::vector<bool>> inputBatches(
+      numberOfInputs, std::vector<bool>(numberOfAssignments));
+  std::vector<std::vector<bool>> expectedBatches(
+      numberOfOutputs, std::vector<bool>(numberOfAssignments));
+  for (size_t i = 0; i < numberOfAssignments; i++) {
+    std::vector<bool> inputValues(numberOfInputs);
+    std::vector<WireId> inputs;
+    for (size_t j = 0; j < numberOfInputs; j++) {
+      inputValues[j] = (i >> j) & 1;
+      inputBatches[j][i] = inputValues[j];
+      inputs.push_back(scheduler.privateBooleanInput(inputValues[j], j % 2));
+    }
+    auto expectedValues = expected(inputValues);
+    auto outputs = circuit.evaluate(scheduler, inputs);
+    ASSERT_EQ(outputs.size(), numberOfOutputs);
+    for (size_t j = 0; j < numberOfOutputs; j++) {
+      EXPECT_EQ(scheduler.getBooleanValue(outputs[j]), expectedValues[j]);
+      expectedBatches[j][i] = expectedValues[j];
+      scheduler.decreaseReferenceCount(outputs[j]);
+    }
+    for (auto input : inputs) {
+      scheduler.decreaseReferenceCount(input);
+    }
+  }
+
+  std::vector<WireId> inputs;
+  for (size_t j = 0; j < numberOfInputs; j++) {
+    inputs.push_back(
+        scheduler.privateBooleanInputBatch(inputBatches[j], j % 2));
+  }
+  auto outputs = circuit.evaluateBatch(scheduler, inputs, numberOfAssignments);
+  ASSERT_EQ(outputs.size(), numberOfOutputs);
+  for (size_t j = 0; j < numberOfOutputs; j++) {
+    EXPECT_EQ(scheduler.getBooleanValueBatch(outputs[j]), expectedBatches[j]);
+    scheduler.decreaseReferenceCountBatch(outputs[j]);
+  }
+  for (auto input : inputs) {
+    scheduler.decreaseReferenceCountBatch(input);
+  }
+
+  // every wire created by the circuit is released
+  auto [allocated, deallocated] = scheduler.getWireStatistics();
+  EXPECT_EQ(allocated, deallocated);
+}
+
+TEST(BristolCircuitTest, TestReadAndWrite) {
+  auto circuit = readCircuit(kFullAdder);
+  EXPECT_EQ(circuit.getNumberOfWires(), 8);
+  EXPECT_EQ(circuit.getInputSizes(), std::vector<uint32_t>({1, 1, 1}));
+  EXPECT_EQ(circuit.getOutputSizes(), std::vector<uint32_t>({1, 1}));
+  EXPECT_EQ(circuit.getNumberOfInputWires(), 3);
+  EXPECT_EQ(circuit.getNumberOfOutputWires(), 2);
+  ASSERT_EQ(circuit.getGates().size(), 4);
+  EXPECT_EQ(
+      circuit.getGates().at(2).operation, BristolCircuit::Operation::MAND);
+  EXPECT_EQ(circuit.getNumberOfAndGates(), 2);
+
+  std::ostringstream out;
+  circuit.write(out);
+  EXPECT_EQ(out.str(), kFullAdder);
+}
+
+TEST(BristolCircuitTest, TestEvaluate) {
+  testCircuit(readCircuit(kFullAdder), [](const std::vector<bool>& input) {
+    auto sum = input[0] + input[1] + input[2];
+    return std::vector<bool>{bool(sum & 1), bool(sum & 2)};
+  });
+  testCircuit(readCircuit(kConstants), [](const std::vector<bool>& input) {
+    return std::vector<bool>{bool(!input[0] ^ input[1]), input[0]};
+  });
+}
+
+TEST(BristolCircuitTest, TestMalformedCircuits) {
+  // unknown operation
+  EXPECT_THROW(
+      readCircuit("1 3\n2 1 1\n1 1\n\n2 1 0 1 2 OR\n"), std::invalid_argument);
+  // wrong number of wires
+  EXPECT_THROW(
+      readCircuit("1 3\n2 1 1\n1 1\n\n1 1 0 2 XOR\n"), std::invalid_argument);
+  // reads a wire that isn't set
+  EXPECT_THROW(
+      readCircuit("2 4\n2 1 1\n1 1\n\n2 1 0 3 2 XOR\n2 1 0 1 3 AND\n"),
+      std::invalid_argument);
+  // sets a wire twice
+  EXPECT_THROW(
+      readCircuit("2 3\n2 1 1\n1 1\n\n2 1 0 1 2 XOR\n2 1 0 1 2 AND\n"),
+      std::invalid_argument);
+  // the output is a constant
+  EXPECT_THROW(
+      readCircuit("1 3\n2 1 1\n1 1\n\n1 1 1 2 EQ\n"), std::invalid_argument);
+  // truncated
+  EXPECT_THROW(
+      readCircuit("2 4\n2 1 1\n1 1\n\n2 1 0 1 2 XOR\n"),
+      std::invalid_argument);
+
+  auto circuit = readCircuit(kFullAdder);
+  PlaintextScheduler scheduler(WireKeeper::createWithUnorderedMap());
+  EXPECT_THROW(
+      circuit.evaluate(scheduler, {scheduler.publicBooleanInput(true)}),
+      std::invalid_argument);
+}
+
+TEST(BristolCircuitTest, TestExportRecordedCircuit) {
+  using GateType = INormalGate<IScheduler::Boolean>::GateType;
+  std::shared_ptr<IWireKeeper> wireKeeper =
+      WireKeeper::createWithUnorderedMap();
+  GateKeeper gateKeeper(wireKeeper);
+
+  auto a = gateKeeper.inputGate(true);
+  auto b = gateKeeper.inputGate(false);
+  gateKeeper.startRecording({a, b});
+  auto one = gateKeeper.inputGate(true);
+  auto notA = gateKeeper.normalGate(GateType::AsymmetricXOR, a, one);
+  auto product = gateKeeper.normalGate(GateType::NonFreeAnd, notA, b);
+  auto result = gateKeeper.normalGate(GateType::AsymmetricNot, product);
+  // outputs may repeat and may be inputs
+  auto circuit = gateKeeper.stopRecording({result, b, result, notA});
+
+  auto bristolCircuit = BristolCircuit::fromCircuit(*circuit, {1, 1}, {2, 2});
+  EXPECT_EQ(bristolCircuit.getInputSizes(), std::vector<uint32_t>({1, 1}));
+  EXPECT_EQ(bristolCircuit.getOutputSizes(), std::vector<uint32_t>({2, 2}));
+  EXPECT_EQ(bristolCircuit.getNumberOfAndGates(), 1);
+  // b and the second copy of the result are copied
+  EXPECT_EQ(bristolCircuit.getGates().size(), 6);
+
+  std::stringstream file;
+  bristolCircuit.write(file);
+  testCircuit(
+      BristolCircuit::read(file), [](const std::vector<bool>& input) {
+        bool result = !(!input[0] & input[1]);
+        return std::vector<bool>{result, input[1], result, !input[0]};
+      });
+
+  EXPECT_THROW(
+      BristolCircuit::fromCircuit(*circuit, {1}, {4}), std::invalid_argument);
+}
+
+TEST(BristolCircuitTest, TestExportUnsupportedGates) {
+  std::shared_ptr<IWireKeeper> wireKeeper =
+      WireKeeper::createWithUnorderedMap();
+  GateKeeper gateKeeper(wireKeeper);
+
+  auto a = gateKeeper.inputGateBatch({true, false});
+  gateKeeper.startRecordingBatch({a});
+  auto constant = gateKeeper.inputGateBatch({true, false});
+  auto sum = gateKeeper.normalGateBatch(
+      INormalGate<IScheduler::Boolean>::GateType::AsymmetricXOR, a, constant);
+  auto circuit = gateKeeper.stopRecording({sum});
+  // the constant isn't the same for every row
+  EXPECT_THROW(BristolCircuit::fromCircuit(*circuit), std::invalid_argument);
+
+  gateKeeper.startRecordingBatch({a});
+  auto opened = gateKeeper.outputGateBatch(a, 0);
+  circuit = gateKeeper.stopRecording({opened});
+  EXPECT_THROW(BristolCircuit::fromCircuit(*circuit), std::invalid_argument);
+}
+
+} // namespace fbpcf::scheduler
@@ -6,14 +6,18 @@
  */
 
 #include <gtest/gtest.h>
+#include <sstream>
 
 #include "fbpcf/engine/communication/IPartyCommunicationAgentFactory.h"
 #include "fbpcf/engine/communication/test/AgentFactoryCreationHelper.h"
+#include "fbpcf/scheduler/BristolCircuit.h"
 #include "fbpcf/scheduler/EagerScheduler.h"
+#include "fbpcf/scheduler/IArithmeticScheduler.h"
 #include "fbpcf/scheduler/IScheduler.h"
 #include "fbpcf/scheduler/LazyScheduler.h"
 #include "fbpcf/scheduler/NetworkPlaintextScheduler.h"
 #include "fbpcf/scheduler/PlaintextScheduler.h"
+#include "fbpcf/scheduler/SchedulerHelper.h"
 #include "fbpcf/scheduler/WireKeeper.h"
 #include "fbpcf/scheduler/gate_keeper/GateKeeper.h"
 #include "fbpcf/test/TestHelper.h"
@@ -60,7 +64,11 @@ INSTANTIATE_TEST_SUITE_P(
         SchedulerType::Plaintext,
         SchedulerType::NetworkPlaintext,
         SchedulerType::Eager,
-        SchedulerType::Lazy),
+        SchedulerType::Lazy,
+        SchedulerType::PipelinedLazy,
+        SchedulerType::ParallelLazy,
+        SchedulerType::ArenaLazy,
+        SchedulerType::VectorizedLazy),
     [](const testing::TestParamInfo<SchedulerTestFixture::ParamType>& info) {
       return getSchedulerName(info.param);
     });
@@ -417,6 +425,41 @@ TEST_P(SchedulerTestFixture, testMultipleOperations) {
   runWithScheduler(GetParam(), testMultipleOperations);
 }
 
+// Gates added after a level is executed may not depend on the gates of the
+// next non-free level, in which case a pipelined scheduler computes them
+// while that level is in flight.
+void testGatesAddedDuringExecution(
+    std::unique_ptr<IScheduler> scheduler,
+    int8_t myID) {
+  auto wire1 = scheduler->privateBooleanInput(true, 0);
+  auto wire2 = scheduler->privateBooleanInput(true, 1);
+  auto wire3 = scheduler->privateAndPrivate(wire1, wire2);
+
+  // execute the inputs
+  scheduler->extractBooleanSecretShare(wire1);
+
+  auto wire4 = scheduler->privateBooleanInput(true, 0);
+  auto wire5 = scheduler->privateXorPrivate(wire4, wire1);
+  auto wire6 = scheduler->privateXorPrivate(wire3, wire5);
+  auto wire7 = scheduler->privateAndPrivate(wire5, wire6);
+
+  auto output1 =
+      scheduler->getBooleanValue(scheduler->openBooleanValueToParty(wire6, 0));
+  auto output2 =
+      scheduler->getBooleanValue(scheduler->openBooleanValueToParty(wire7, 0));
+  if (myID == 0) {
+    EXPECT_TRUE(output1);
+    EXPECT_FALSE(output2);
+  }
+  auto gateCount = scheduler->getGateStatistics();
+  EXPECT_EQ(gateCount.first, 4);
+  EXPECT_EQ(gateCount.second, 5);
+}
+
+TEST_P(SchedulerTestFixture, testGatesAddedDuringExecution) {
+  runWithScheduler(GetParam(), testGatesAddedDuringExecution);
+}
+
 void testReferenceCount(
     std::unique_ptr<IScheduler> scheduler,
     int8_t /*myId*/) {
@@ -487,6 +530,310 @@ TEST_P(SchedulerTestFixture, testReferenceCountBatch) {
   runWithScheduler(GetParam(), testReferenceCountBatch);
 }
 
+void testPendingBytes(std::unique_ptr<IScheduler> scheduler, int8_t /*myId*/) {
+  auto wire1 = scheduler->privateBooleanInputBatch(std::vector<bool>(800), 0);
+  auto wire2 = scheduler->privateBooleanInputBatch(std::vector<bool>(800), 1);
+  auto wire3 = scheduler->privateAndPrivateBatch(wire1, wire2);
+
+  auto [pendingBytes, peakPendingBytes] =
+      scheduler->getPendingBytesStatistics();
+  EXPECT_LE(pendingBytes, peakPendingBytes);
+
+  // every gate has been executed once the output is computed
+  scheduler->getBooleanValueBatch(wire3);
+  EXPECT_EQ(scheduler->getPendingBytesStatistics().first, 0);
+  EXPECT_EQ(scheduler->getPendingBytesStatistics().second, peakPendingBytes);
+}
+
+TEST_P(SchedulerTestFixture, testPendingBytes) {
+  runWithScheduler(GetParam(), testPendingBytes);
+}
+
+void testEliminatedGates(std::unique_ptr<IScheduler> scheduler, int8_t myID) {
+  bool isLazy = dynamic_cast<LazyScheduler*>(scheduler.get()) != nullptr;
+
+  // the public gates on public inputs are folded
+  auto a = scheduler->publicBooleanInput(true);
+  auto b = scheduler->publicBooleanInput(false);
+  auto c = scheduler->publicXorPublic(a, b);
+  auto d = scheduler->notPublic(c);
+  auto e = scheduler->publicAndPublic(c, a);
+  auto f = scheduler->notPublicBatch(
+      scheduler->publicBooleanInputBatch({true, false}));
+
+  // the free gates that nothing reads are dropped
+  auto x = scheduler->privateBooleanInput(true, 0);
+  auto y = scheduler->privateBooleanInput(true, 1);
+  auto product = scheduler->privateAndPrivate(x, y);
+  auto unused = scheduler->privateXorPrivate(product, x);
+  scheduler->decreaseReferenceCount(product);
+  scheduler->decreaseReferenceCount(unused);
+  auto result = scheduler->getBooleanValue(scheduler->openBooleanValueToParty(
+      scheduler->privateAndPublic(x, e), 0));
+
+  EXPECT_FALSE(scheduler->getBooleanValue(d));
+  EXPECT_TRUE(scheduler->getBooleanValue(e));
+  testVectorEq(scheduler->getBooleanValueBatch(f), {false, true});
+  if (myID == 0) {
+    EXPECT_TRUE(result);
+  }
+
+  auto [deadGates, foldedGates] = scheduler->getEliminatedGateStatistics();
+  auto gateCount = scheduler->getGateStatistics();
+  if (isLazy) {
+    // the AND is executed although nothing reads it, only the XOR is dropped
+    EXPECT_EQ(deadGates, 1);
+    EXPECT_EQ(foldedGates, 4);
+    EXPECT_EQ(gateCount.first, 2);
+  } else {
+    EXPECT_EQ(deadGates, 0);
+    EXPECT_EQ(foldedGates, 0);
+    EXPECT_EQ(gateCount.first, 2);
+  }
+}
+
+TEST_P(SchedulerTestFixture, testEliminatedGates) {
+  runWithScheduler(GetParam(), testEliminatedGates);
+}
+
+// Every party opens a value to each party and only keeps its own result, so
+// the parties drop different opens. They must still all be executed.
+void testDroppedOpens(std::unique_ptr<IScheduler> scheduler, int8_t myID) {
+  auto x = scheduler->privateBooleanInput(true, 0);
+  auto y = scheduler->privateBooleanInput(true, 1);
+  auto product = scheduler->privateAndPrivate(x, y);
+  auto openedTo0 = scheduler->openBooleanValueToParty(product, 0);
+  auto openedTo1 = scheduler->openBooleanValueToParty(product, 1);
+  scheduler->decreaseReferenceCount(myID == 0 ? openedTo1 : openedTo0);
+  auto result =
+      scheduler->getBooleanValue(myID == 0 ? openedTo0 : openedTo1);
+  EXPECT_TRUE(result);
+}
+
+TEST_P(SchedulerTestFixture, testDroppedOpens) {
+  runWithScheduler(GetParam(), testDroppedOpens);
+}
+
+// Only party 0 releases a lot of free gates, then both parties add gates
+// until they cross the limit of unexecuted gates. The released gates must
+// keep counting until their level is popped, otherwise party 0 would stop
+// executing levels earlier than party 1 and put the next AND in an already
+// executed level.
+void testReleasedWiresBeforeBatchingLimit(
+    std::unique_ptr<IScheduler> scheduler,
+    int8_t myID) {
+  const size_t numberOfGates = GateKeeper::kMinMaxUnexecutedGates / 2;
+  auto x = scheduler->privateBooleanInput(true, 0);
+  auto y = scheduler->privateBooleanInput(true, 1);
+  auto product = scheduler->privateAndPrivate(x, y);
+
+  std::vector<IScheduler::WireId<IScheduler::Boolean>> keptWires;
+  for (size_t i = 0; i < numberOfGates; i++) {
+    auto wire = scheduler->privateXorPrivate(product, x);
+    if (myID == 0) {
+      scheduler->decreaseReferenceCount(wire);
+    } else {
+      keptWires.push_back(wire);
+    }
+  }
+  // a few more than needed, so that the limit is crossed again after the
+  // first level is popped
+  for (size_t i = 0; i < numberOfGates + 10; i++) {
+    keptWires.push_back(scheduler->privateXorPrivate(product, y));
+  }
+
+  auto secondProduct = scheduler->privateAndPrivate(x, y);
+  auto result = scheduler->getBooleanValue(
+      scheduler->openBooleanValueToParty(secondProduct, 0));
+  auto lastResult = scheduler->getBooleanValue(
+      scheduler->openBooleanValueToParty(keptWires.back(), 0));
+  if (myID == 0) {
+    EXPECT_TRUE(result);
+    EXPECT_FALSE(lastResult);
+  }
+  for (auto wire : keptWires) {
+    scheduler->decreaseReferenceCount(wire);
+  }
+}
+
+TEST_P(SchedulerTestFixture, testReleasedWiresBeforeBatchingLimit) {
+  runWithScheduler(GetParam(), testReleasedWiresBeforeBatchingLimit);
+}
+
+// a full adder in Bristol Fashion: (sum, carry) = a + b + c
+void testBristolCircuit(std::unique_ptr<IScheduler> scheduler, int8_t myID) {
+  std::istringstream file(
+      "4 8\n3 1 1 1\n2 1 1\n\n"
+      "2 1 0 1 3 XOR\n"
+      "2 1 3 2 6 XOR\n"
+      "4 2 0 3 1 2 4 5 MAND\n"
+      "2 1 4 5 7 XOR\n");
+  auto circuit = BristolCircuit::read(file);
+
+  std::vector<std::vector<bool>> inputBatches(3);
+  for (int i = 0; i < 8; i++) {
+    std::vector<IScheduler::WireId<IScheduler::Boolean>> inputs;
+    for (int j = 0; j < 3; j++) {
+      inputBatches[j].push_back((i >> j) & 1);
+      inputs.push_back(scheduler->privateBooleanInput((i >> j) & 1, j % 2));
+    }
+    auto outputs = circuit.evaluate(*scheduler, inputs);
+    ASSERT_EQ(outputs.size(), 2);
+    auto sum = scheduler->getBooleanValue(
+        scheduler->openBooleanValueToParty(outputs.at(0), 0));
+    auto carry = scheduler->getBooleanValue(
+        scheduler->openBooleanValueToParty(outputs.at(1), 0));
+    if (myID == 0) {
+      auto expected = (i & 1) + ((i >> 1) & 1) + ((i >> 2) & 1);
+      EXPECT_EQ(sum, bool(expected & 1));
+      EXPECT_EQ(carry, bool(expected & 2));
+    }
+  }
+
+  std::vector<IScheduler::WireId<IScheduler::Boolean>> inputs;
+  for (int j = 0; j < 3; j++) {
+    inputs.push_back(scheduler->privateBooleanInputBatch(inputBatches[j], 1));
+  }
+  auto outputs = circuit.evaluateBatch(*scheduler, inputs, 8);
+  ASSERT_EQ(outputs.size(), 2);
+  auto sum = scheduler->getBooleanValueBatch(
+      scheduler->openBooleanValueToPartyBatch(outputs.at(0), 0));
+  auto carry = scheduler->getBooleanValueBatch(
+      scheduler->openBooleanValueToPartyBatch(outputs.at(1), 0));
+  if (myID == 0) {
+    testVectorEq(sum, {false, true, true, false, true, false, false, true});
+    testVectorEq(
+        carry, {false, false, false, true, false, true, true, true});
+  }
+}
+
+TEST_P(SchedulerTestFixture, testBristolCircuit) {
+  runWithScheduler(GetParam(), testBristolCircuit);
+}
+
+class CircuitRecordingTestFixture
+    : public ::testing::TestWithParam<SchedulerType> {};
+
+INSTANTIATE_TEST_SUITE_P(
+    SchedulerTest,
+    CircuitRecordingTestFixture,
+    ::testing::Values(
+        SchedulerType::Lazy,
+        SchedulerType::PipelinedLazy,
+        SchedulerType::ParallelLazy,
+        SchedulerType::ArenaLazy,
+        SchedulerType::VectorizedLazy),
+    [](const testing::TestParamInfo<CircuitRecordingTestFixture::ParamType>&
+           info) { return getSchedulerName(info.param); });
+
+// Record f(a, b, c) = ((a & b) ^ !c, a ^ 1) on the first shard and replay it
+// on the others.
+template <bool usingBatch>
+void testRecordAndReplay(std::unique_ptr<IScheduler> scheduler, int8_t myID) {
+  using WireId = IScheduler::WireId<IScheduler::Boolean>;
+  auto& lazyScheduler = dynamic_cast<LazyScheduler&>(*scheduler);
+
+  // every shard is an assignment of (a, b, c)
+  std::vector<std::vector<bool>> values;
+  for (int i = 0; i < 8; i++) {
+    values.push_back({bool(i & 1), bool(i & 2), bool(i & 4)});
+  }
+  auto input = [&](bool v, int partyId) {
+    if constexpr (usingBatch) {
+      return lazyScheduler.privateBooleanInputBatch({v, !v}, partyId);
+    } else {
+      return lazyScheduler.privateBooleanInput(v, partyId);
+    }
+  };
+  auto reveal = [&](WireId wire) {
+    if constexpr (usingBatch) {
+      auto opened = lazyScheduler.openBooleanValueToPartyBatch(wire, 0);
+      auto value = lazyScheduler.getBooleanValueBatch(opened);
+      lazyScheduler.decreaseReferenceCountBatch(opened);
+      lazyScheduler.decreaseReferenceCountBatch(wire);
+      return value;
+    } else {
+      auto opened = lazyScheduler.openBooleanValueToParty(wire, 0);
+      auto value = lazyScheduler.getBooleanValue(opened);
+      lazyScheduler.decreaseReferenceCount(opened);
+      lazyScheduler.decreaseReferenceCount(wire);
+      return std::vector<bool>{value};
+    }
+  };
+  auto check = [&](const std::vector<bool>& shard,
+                   std::vector<WireId> outputs) {
+    ASSERT_EQ(outputs.size(), 2);
+    auto output0 = reveal(outputs.at(0));
+    auto output1 = reveal(outputs.at(1));
+    if (myID == 0) {
+      EXPECT_EQ(output0.at(0), (shard[0] & shard[1]) ^ !shard[2]);
+      EXPECT_EQ(output1.at(0), !shard[0]);
+      if constexpr (usingBatch) {
+        EXPECT_EQ(output0.at(1), (!shard[0] & !shard[1]) ^ shard[2]);
+        EXPECT_EQ(output1.at(1), shard[0]);
+      }
+    }
+  };
+
+  std::shared_ptr<const Circuit> circuit;
+  for (auto& shard : values) {
+    std::vector<WireId> inputs{
+        input(shard[0], 0), input(shard[1], 1), input(shard[2], 0)};
+    std::vector<WireId> outputs;
+    if (circuit == nullptr) {
+      if constexpr (usingBatch) {
+        lazyScheduler.startRecordingBatch(inputs);
+        auto product =
+            lazyScheduler.privateAndPrivateBatch(inputs[0], inputs[1]);
+        auto negation = lazyScheduler.notPrivateBatch(inputs[2]);
+        auto one = lazyScheduler.publicBooleanInputBatch({true, true});
+        outputs = {
+            lazyScheduler.privateXorPrivateBatch(product, negation),
+            lazyScheduler.privateXorPublicBatch(inputs[0], one)};
+        lazyScheduler.decreaseReferenceCountBatch(product);
+        lazyScheduler.decreaseReferenceCountBatch(negation);
+        lazyScheduler.decreaseReferenceCountBatch(one);
+      } else {
+        lazyScheduler.startRecording(inputs);
+        auto product = lazyScheduler.privateAndPrivate(inputs[0], inputs[1]);
+        auto negation = lazyScheduler.notPrivate(inputs[2]);
+        auto one = lazyScheduler.publicBooleanInput(true);
+        outputs = {
+            lazyScheduler.privateXorPrivate(product, negation),
+            lazyScheduler.privateXorPublic(inputs[0], one)};
+        lazyScheduler.decreaseReferenceCount(product);
+        lazyScheduler.decreaseReferenceCount(negation);
+        lazyScheduler.decreaseReferenceCount(one);
+      }
+      circuit = lazyScheduler.stopRecording(outputs);
+      EXPECT_EQ(circuit->isBatch(), usingBatch);
+      EXPECT_EQ(circuit->getNumberOfInputs(), 3);
+    } else {
+      outputs = lazyScheduler.replayCircuit(*circuit, inputs);
+    }
+    for (auto wire : inputs) {
+      if constexpr (usingBatch) {
+        lazyScheduler.decreaseReferenceCountBatch(wire);
+      } else {
+        lazyScheduler.decreaseReferenceCount(wire);
+      }
+    }
+    check(shard, outputs);
+  }
+
+  // only the wires of the last reveals are left, and they are freed
+  auto [allocated, deallocated] = lazyScheduler.getWireStatistics();
+  EXPECT_EQ(allocated, deallocated);
+}
+
+TEST_P(CircuitRecordingTestFixture, testRecordAndReplay) {
+  runWithScheduler(GetParam(), testRecordAndReplay</*usingBatch*/ false>);
+}
+
+TEST_P(CircuitRecordingTestFixture, testRecordAndReplayBatch) {
+  runWithScheduler(GetParam(), testRecordAndReplay</*usingBatch*/ true>);
+}
+
 class CompositeSchedulerTestFixture
     : public ::testing::TestWithParam<std::tuple<SchedulerType, size_t>> {};
 
@@ -496,7 +843,13 @@ INSTANTIATE_TEST_SUITE_P(
     ::testing::Combine(
         ::testing::Values(
             SchedulerType::Plaintext,
-            SchedulerType::NetworkPlaintext),
+            SchedulerType::NetworkPlaintext,
+            SchedulerType::Eager,
+            SchedulerType::Lazy,
+            SchedulerType::PipelinedLazy,
+            SchedulerType::ParallelLazy,
+            SchedulerType::ArenaLazy,
+            SchedulerType::VectorizedLazy),
         ::testing::Values(16, 256, 1024)),
     [](const testing::TestParamInfo<CompositeSchedulerTestFixture::ParamType>&
            info) {
@@ -705,4 +1058,242 @@ TEST_P(CompositeSchedulerTestFixture, testCompositeANDBatch) {
       });
 }
 
+template <bool useGateArena, bool vectorizeGates>
+void runWithArithmeticScheduler(
+    std::function<
+        void(std::unique_ptr<IArithmeticScheduler> scheduler, int8_t myID)>
+        testBody) {
+  auto agentFactories =
+      engine::communication::getInMemoryAgentFactory(numberOfParties);
+
+  std::vector<std::future<void>> futures;
+
+  for (auto i = 0; i < numberOfParties; ++i) {
+    futures.push_back(std::async(
+        [i, testBody](std::reference_wrapper<
+                      engine::communication::IPartyCommunicationAgentFactory>
+                          agentFactory) {
+          testBody(
+              createArithmeticLazySchedulerWithInsecureEngine<
+                  unsafe,
+                  useGateArena,
+                  vectorizeGates>(i, agentFactory),
+              i);
+        },
+        std::reference_wrapper<
+            engine::communication::IPartyCommunicationAgentFactory>(
+            *agentFactories.at(i))));
+  }
+
+  for (auto i = 0; i < numberOfParties; ++i) {
+    futures.at(i).get();
+  }
+}
+
+// run the test body without gate arenas, with gate arenas and with
+// vectorized gates
+void runWithArithmeticScheduler(
+    std::function<
+        void(std::unique_ptr<IArithmeticScheduler> scheduler, int8_t myID)>
+        testBody) {
+  runWithArithmeticScheduler<
+      /*useGateArena*/ false,
+      /*vectorizeGates*/ false>(testBody);
+  runWithArithmeticScheduler<
+      /*useGateArena*/ true,
+      /*vectorizeGates*/ false>(testBody);
+  runWithArithmeticScheduler<
+      /*useGateArena*/ true,
+      /*vectorizeGates*/ true>(testBody);
+}
+
+TEST(ArithmeticSchedulerTest, testIntegerInputAndOutput) {
+  runWithArithmeticScheduler(
+      [](std::unique_ptr<IArithmeticScheduler> scheduler, int8_t myID) {
+        auto wire1 = scheduler->publicIntegerInput(17);
+        EXPECT_EQ(scheduler->getIntegerValue(wire1), 17);
+
+        auto wire2 = scheduler->publicIntegerInputBatch({3, 5});
+        testVectorEq(scheduler->getIntegerValueBatch(wire2), {3, 5});
+
+        // Reveal 0's input to 1
+        auto wire3 =
+            scheduler->getIntegerValue(scheduler->openIntegerValueToParty(
+                scheduler->privateIntegerInput(42, 0), 1));
+        if (myID == 1) {
+          EXPECT_EQ(wire3, 42);
+        }
+
+        auto share = scheduler->extractIntegerSecretShareBatch(
+            scheduler->privateIntegerInputBatch({7, UINT64_MAX}, 1));
+        auto wire4 = scheduler->recoverIntegerWireBatch(share);
+
+        // Reveal 1's input to 0
+        auto wire5 = scheduler->getIntegerValueBatch(
+            scheduler->openIntegerValueToPartyBatch(wire4, 0));
+        if (myID == 0) {
+          testVectorEq(wire5, {7, UINT64_MAX});
+        }
+      });
+}
+
+TEST(ArithmeticSchedulerTest, testIntegerOperations) {
+  runWithArithmeticScheduler(
+      [](std::unique_ptr<IArithmeticScheduler> scheduler, int8_t myID) {
+        uint64_t v1 = 0xFEDCBA9876543210;
+        uint64_t v2 = 12345;
+        auto private1 = scheduler->privateIntegerInput(v1, 0);
+        auto private2 = scheduler->privateIntegerInput(v2, 1);
+        auto public1 = scheduler->publicIntegerInput(v1);
+        auto public2 = scheduler->publicIntegerInput(v2);
+
+        auto open = [&scheduler](
+                        IScheduler::WireId<IScheduler::Arithmetic> wire) {
+          return scheduler->getIntegerValue(
+              scheduler->openIntegerValueToParty(wire, 0));
+        };
+
+        auto plusPrivate =
+            open(scheduler->privatePlusPrivate(private1, private2));
+        auto plusMixed = open(scheduler->privatePlusPublic(private1, public2));
+        auto multPrivate =
+            open(scheduler->privateMultPrivate(private1, private2));
+        auto multMixed = open(scheduler->privateMultPublic(private2, public1));
+        auto negPrivate = open(scheduler->negPrivate(private1));
+        if (myID == 0) {
+          EXPECT_EQ(plusPrivate, v1 + v2);
+          EXPECT_EQ(plusMixed, v1 + v2);
+          EXPECT_EQ(multPrivate, v1 * v2);
+          EXPECT_EQ(multMixed, v1 * v2);
+          EXPECT_EQ(negPrivate, -v1);
+        }
+
+        EXPECT_EQ(
+            scheduler->getIntegerValue(
+                scheduler->publicPlusPublic(public1, public2)),
+            v1 + v2);
+        EXPECT_EQ(
+            scheduler->getIntegerValue(
+                scheduler->publicMultPublic(public1, public2)),
+            v1 * v2);
+        EXPECT_EQ(
+            scheduler->getIntegerValue(scheduler->negPublic(public2)), -v2);
+      });
+}
+
+TEST(ArithmeticSchedulerTest, testIntegerOperationsBatch) {
+  runWithArithmeticScheduler(
+      [](std::unique_ptr<IArithmeticScheduler> scheduler, int8_t myID) {
+        std::vector<uint64_t> v1 = {0xFEDCBA9876543210, 0, 7};
+        std::vector<uint64_t> v2 = {12345, UINT64_MAX, 9};
+        auto private1 = scheduler->privateIntegerInputBatch(v1, 0);
+        auto private2 = scheduler->privateIntegerInputBatch(v2, 1);
+        auto public2 = scheduler->publicIntegerInputBatch(v2);
+
+        // (v1 * v2 + v2) * v1 - v2 takes two rounds of multiplication.
+        auto product = scheduler->privateMultPrivateBatch(private1, private2);
+        auto sum = scheduler->privatePlusPublicBatch(product, public2);
+        auto result = scheduler->privatePlusPrivateBatch(
+            scheduler->privateMultPrivateBatch(sum, private1),
+            scheduler->negPrivateBatch(private2));
+        auto plaintext = scheduler->getIntegerValueBatch(
+            scheduler->openIntegerValueToPartyBatch(result, 0));
+
+        if (myID == 0) {
+          std::vector<uint64_t> expected(v1.size());
+          for (size_t i = 0; i < v1.size(); i++) {
+            expected[i] = (v1[i] * v2[i] + v2[i]) * v1[i] - v2[i];
+          }
+          testVectorEq(plaintext, expected);
+        }
+
+        auto gateCount = scheduler->getGateStatistics();
+        EXPECT_EQ(gateCount.first, 3 * v1.size());
+      });
+}
+
+TEST(ArithmeticSchedulerTest, testConversions) {
+  runWithArithmeticScheduler(
+      [](std::unique_ptr<IArithmeticScheduler> scheduler, int8_t myID) {
+        uint64_t v = 0xFEDCBA9876543210;
+        const int8_t width = 16;
+
+        // boolean to integer
+        std::vector<IScheduler::WireId<IScheduler::Boolean>> bits;
+        for (int8_t i = 0; i < width; i++) {
+          bits.push_back(scheduler->privateBooleanInput((v >> i) & 1, 0));
+        }
+        auto integer = scheduler->getIntegerValue(
+            scheduler->openIntegerValueToParty(
+                scheduler->booleanToInteger(bits), 0));
+        if (myID == 0) {
+          EXPECT_EQ(integer, v & 0xFFFF);
+        }
+
+        // integer to boolean, the summands are free
+        auto summands = scheduler->integerToBooleanSummands(
+            scheduler->privateIntegerInput(v, 1), width);
+        ASSERT_EQ(summands.size(), 2);
+        uint64_t sum = 0;
+        for (auto& summand : summands) {
+          ASSERT_EQ(summand.size(), width);
+          for (int8_t i = 0; i < width; i++) {
+            sum += uint64_t(scheduler->getBooleanValue(
+                       scheduler->openBooleanValueToParty(summand[i], 0)))
+                << i;
+          }
+        }
+        if (myID == 0) {
+          EXPECT_EQ(sum & 0xFFFF, v & 0xFFFF);
+        }
+
+        // one non-free gate per converted bit and per opened value
+        auto gateCount = scheduler->getGateStatistics();
+        EXPECT_EQ(gateCount.first, width + 1 + 2 * width);
+      });
+}
+
+TEST(ArithmeticSchedulerTest, testConversionsBatch) {
+  runWithArithmeticScheduler(
+      [](std::unique_ptr<IArithmeticScheduler> scheduler, int8_t myID) {
+        std::vector<uint64_t> v = {0xFEDCBA9876543210, 0, UINT64_MAX};
+        const int8_t width = 64;
+
+        // boolean to integer
+        std::vector<IScheduler::WireId<IScheduler::Boolean>> bits;
+        for (int8_t i = 0; i < width; i++) {
+          std::vector<bool> ithBits(v.size());
+          for (size_t j = 0; j < v.size(); j++) {
+            ithBits[j] = (v[j] >> i) & 1;
+          }
+          bits.push_back(scheduler->privateBooleanInputBatch(ithBits, 1));
+        }
+        auto integers = scheduler->getIntegerValueBatch(
+            scheduler->openIntegerValueToPartyBatch(
+                scheduler->booleanToIntegerBatch(bits), 0));
+        if (myID == 0) {
+          testVectorEq(integers, v);
+        }
+
+        // integer to boolean
+        auto summands = scheduler->integerToBooleanSummandsBatch(
+            scheduler->privateIntegerInputBatch(v, 0), width);
+        ASSERT_EQ(summands.size(), 2);
+        std::vector<uint64_t> sums(v.size(), 0);
+        for (auto& summand : summands) {
+          ASSERT_EQ(summand.size(), width);
+          for (int8_t i = 0; i < width; i++) {
+            auto opened = scheduler->getBooleanValueBatch(
+                scheduler->openBooleanValueToPartyBatch(summand[i], 0));
+            for (size_t j = 0; j < v.size(); j++) {
+              sums[j] += uint64_t(opened.at(j)) << i;
+            }
+          }
+        }
+        if (myID == 0) {
+          testVectorEq(sums, v);
+        }
+      });
+}
+
 } // namespace fbpcf::scheduler
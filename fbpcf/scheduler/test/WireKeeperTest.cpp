@@ -130,6 +130,7 @@ void wireKeeperTestReferenceCount(std::unique_ptr<IWireKeeper> wireKeeper) {
     }
     EXPECT_TRUE(wireKeeper->getBooleanValue(boolWire));
   }
+  EXPECT_EQ(wireKeeper->getReferenceCount(boolWire), 5);
 
   for (int i = 0; i < 10; i++) {
     EXPECT_TRUE(wireKeeper->getBooleanValue(boolWire));
@@ -158,6 +159,7 @@ void wireKeeperTestReferenceCount(std::unique_ptr<IWireKeeper> wireKeeper) {
     }
     EXPECT_EQ(wireKeeper->getIntegerValue(intWire), 10);
   }
+  EXPECT_EQ(wireKeeper->getReferenceCount(intWire), 5);
 
   for (int i = 0; i < 10; i++) {
     EXPECT_EQ(wireKeeper->getIntegerValue(intWire), 10);
@@ -188,6 +190,7 @@ void wireKeeperTestReferenceCount(std::unique_ptr<IWireKeeper> wireKeeper) {
     testVectorEq(
         wireKeeper->getBatchBooleanValue(batchBoolWire), testBoolValue);
   }
+  EXPECT_EQ(wireKeeper->getBatchReferenceCount(batchBoolWire), 5);
 
   for (int i = 0; i < 10; i++) {
     testVectorEq(
@@ -219,6 +222,7 @@ void wireKeeperTestReferenceCount(std::unique_ptr<IWireKeeper> wireKeeper) {
     }
     testVectorEq(wireKeeper->getBatchIntegerValue(batchIntWire), testIntValue);
   }
+  EXPECT_EQ(wireKeeper->getBatchReferenceCount(batchIntWire), 5);
 
   for (int i = 0; i < 10; i++) {
     testVectorEq(wireKeeper->getBatchIntegerValue(batchIntWire), testIntValue);
@@ -0,0 +1,237 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <folly/Benchmark.h>
+#include <array>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "common/init/Init.h"
+
+#include "fbpcf/engine/communication/IPartyCommunicationAgentFactory.h"
+#include "fbpcf/engine/util/test/benchmarks/BenchmarkHelper.h"
+#include "fbpcf/engine/util/test/benchmarks/NetworkedBenchmark.h"
+#include "fbpcf/scheduler/IScheduler.h"
+#include "fbpcf/scheduler/SchedulerHelper.h"
+#include "fbpcf/scheduler/gate_keeper/Circuit.h"
+
+namespace fbpcf::scheduler {
+
+DEFINE_int64(
+    CircuitReplayBenchmark_Shards,
+    100,
+    "How many shards the function is evaluated on");
+
+DEFINE_int64(
+    CircuitReplayBenchmark_Shard_Size,
+    64,
+    "How many rows are in each shard");
+
+namespace {
+
+using WireId = IScheduler::WireId<IScheduler::Boolean>;
+
+const size_t kBitWidth = 32;
+
+void release(IScheduler& scheduler, const std::vector<WireId>& wires) {
+  for (auto wire : wires) {
+    scheduler.decreaseReferenceCountBatch(wire);
+  }
+}
+
+// the sum of two numbers, given by their bits starting from the least
+// significant one
+std::vector<WireId> add(
+    IScheduler& scheduler,
+    const std::vector<WireId>& a,
+    const std::vector<WireId>& b) {
+  std::vector<WireId> sum{scheduler.privateXorPrivateBatch(a[0], b[0])};
+  auto carry = scheduler.privateAndPrivateBatch(a[0], b[0]);
+  for (size_t i = 1; i < a.size(); i++) {
+    auto aXorCarry = scheduler.privateXorPrivateBatch(a[i], carry);
+    auto bXorCarry = scheduler.privateXorPrivateBatch(b[i], carry);
+    auto bits = scheduler.privateXorPrivateBatch(a[i], b[i]);
+    sum.push_back(scheduler.privateXorPrivateBatch(bits, carry));
+    auto product = scheduler.privateAndPrivateBatch(aXorCarry, bXorCarry);
+    auto nextCarry = scheduler.privateXorPrivateBatch(product, carry);
+    release(scheduler, {aXorCarry, bXorCarry, bits, product, carry});
+    carry = nextCarry;
+  }
+  scheduler.decreaseReferenceCountBatch(carry);
+  return sum;
+}
+
+// whether a < b, i.e. a + ~b + 1 doesn't carry out
+WireId lessThan(
+    IScheduler& scheduler,
+    const std::vector<WireId>& a,
+    const std::vector<WireId>& b) {
+  auto carry = scheduler.publicBooleanInputBatch(std::vector<bool>(
+      FLAGS_CircuitReplayBenchmark_Shard_Size, true));
+  for (size_t i = 0; i < a.size(); i++) {
+    auto notB = scheduler.notPrivateBatch(b[i]);
+    auto aXorCarry = scheduler.privateXorPrivateBatch(a[i], carry);
+    auto notBXorCarry = scheduler.privateXorPrivateBatch(notB, carry);
+    auto product = scheduler.privateAndPrivateBatch(aXorCarry, notBXorCarry);
+    auto nextCarry = scheduler.privateXorPrivateBatch(product, carry);
+    release(scheduler, {notB, aXorCarry, notBXorCarry, product, carry});
+    carry = nextCarry;
+  }
+  auto result = scheduler.notPrivateBatch(carry);
+  scheduler.decreaseReferenceCountBatch(carry);
+  return result;
+}
+
+// An attribution rule: a conversion is attributed to a touchpoint if it
+// happened after the touchpoint and within the attribution window.
+WireId attribute(
+    IScheduler& scheduler,
+    const std::vector<WireId>& touchpoint,
+    const std::vector<WireId>& conversion,
+    const std::vector<WireId>& window) {
+  auto windowEnd = add(scheduler, touchpoint, window);
+  auto isAfter = lessThan(scheduler, touchpoint, conversion);
+  auto isInWindow = lessThan(scheduler, conversion, windowEnd);
+  auto result = scheduler.privateAndPrivateBatch(isAfter, isInWindow);
+  release(scheduler, windowEnd);
+  release(scheduler, {isAfter, isInWindow});
+  return result;
+}
+
+} // namespace
+
+// Evaluates an attribution rule on many shards between two parties. It either
+// builds the gates of the rule for every shard, or records them on the first
+// shard and replays the circuit on the others. Besides the wall-clock time and
+// the traffic, it reports the time spent adding the gates of each shard.
+template <bool replay>
+class CircuitReplayBenchmark final : public engine::util::NetworkedBenchmark {
+ public:
+  void addCounters(folly::UserCounters& counters) {
+    counters["shards"] = FLAGS_CircuitReplayBenchmark_Shards;
+    counters["setup_us_per_shard"] =
+        setupTime_.count() / 1000.0 / FLAGS_CircuitReplayBenchmark_Shards;
+  }
+
+ protected:
+  void setup() override {
+    auto [factory0, factory1] = engine::util::getSocketAgentFactories();
+    agentFactory0_ = std::move(factory0);
+    agentFactory1_ = std::move(factory1);
+
+    auto createScheduler =
+        createLazySchedulerWithInsecureEngine</*unsafe*/ true>;
+    auto scheduler0 =
+        std::async(createScheduler, 0, std::ref(*agentFactory0_));
+    auto scheduler1 =
+        std::async(createScheduler, 1, std::ref(*agentFactory1_));
+    schedulers_.at(0) = scheduler0.get();
+    schedulers_.at(1) = scheduler1.get();
+
+    std::random_device rd;
+    std::mt19937_64 e(rd());
+    std::uniform_int_distribution<uint8_t> dist(0, 1);
+    input_ = std::vector<bool>(FLAGS_CircuitReplayBenchmark_Shard_Size);
+    for (size_t i = 0; i < input_.size(); i++) {
+      input_[i] = dist(e);
+    }
+
+    // setting up the engines takes traffic too
+    initialTraffic_ = schedulers_.at(0)->getTrafficStatistics();
+  }
+
+  void runSender() override {
+    setupTime_ = run(*schedulers_.at(0));
+  }
+
+  void runReceiver() override {
+    run(*schedulers_.at(1));
+  }
+
+  std::pair<uint64_t, uint64_t> getTrafficStatistics() override {
+    auto [sent, received] = schedulers_.at(0)->getTrafficStatistics();
+    return {sent - initialTraffic_.first, received - initialTraffic_.second};
+  }
+
+ private:
+  // evaluate the rule on every shard and return the time spent adding gates.
+  std::chrono::nanoseconds run(IScheduler& scheduler) {
+    std::chrono::nanoseconds setupTime(0);
+    std::shared_ptr<const Circuit> circuit;
+    for (int64_t i = 0; i < FLAGS_CircuitReplayBenchmark_Shards; i++) {
+      std::vector<WireId> inputs;
+      for (auto partyId : {0, 1, 0}) {
+        for (size_t j = 0; j < kBitWidth; j++) {
+          inputs.push_back(scheduler.privateBooleanInputBatch(input_, partyId));
+        }
+      }
+
+      auto start = std::chrono::steady_clock::now();
+      std::vector<WireId> outputs;
+      if (replay && circuit != nullptr) {
+        outputs = scheduler.replayCircuit(*circuit, inputs);
+      } else {
+        if (replay) {
+          scheduler.startRecordingBatch(inputs);
+        }
+        outputs = {attribute(
+            scheduler,
+            {inputs.begin(), inputs.begin() + kBitWidth},
+            {inputs.begin() + kBitWidth, inputs.begin() + 2 * kBitWidth},
+            {inputs.begin() + 2 * kBitWidth, inputs.end()})};
+        if (replay) {
+          circuit = scheduler.stopRecording(outputs);
+        }
+      }
+      setupTime += std::chrono::steady_clock::now() - start;
+
+      scheduler.extractBooleanSecretShareBatch(outputs.at(0));
+      release(scheduler, outputs);
+      release(scheduler, inputs);
+    }
+    return setupTime;
+  }
+
+  std::unique_ptr<engine::communication::IPartyCommunicationAgentFactory>
+      agentFactory0_;
+  std::unique_ptr<engine::communication::IPartyCommunicationAgentFactory>
+      agentFactory1_;
+
+  std::array<std::unique_ptr<IScheduler>, 2> schedulers_;
+
+  std::vector<bool> input_;
+  std::pair<uint64_t, uint64_t> initialTraffic_;
+  std::chrono::nanoseconds setupTime_{0};
+};
+
+template <bool replay>
+void runCircuitReplayBenchmark(folly::UserCounters& counters) {
+  CircuitReplayBenchmark<replay> benchmark;
+  benchmark.runBenchmark(counters);
+  BENCHMARK_SUSPEND {
+    benchmark.addCounters(counters);
+  }
+}
+
+BENCHMARK_COUNTERS(CircuitReplay_Build, counters) {
+  runCircuitReplayBenchmark</*replay*/ false>(counters);
+}
+
+BENCHMARK_COUNTERS(CircuitReplay_Replay, counters) {
+  runCircuitReplayBenchmark</*replay*/ true>(counters);
+}
+
+} // namespace fbpcf::scheduler
+
+int main(int argc, char* argv[]) {
+  facebook::initFacebook(&argc, &argv);
+  folly::runBenchmarks();
+  return 0;
+}
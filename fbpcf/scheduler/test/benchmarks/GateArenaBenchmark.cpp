@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <folly/Benchmark.h>
+#include <array>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "common/init/Init.h"
+
+#include "fbpcf/engine/communication/IPartyCommunicationAgentFactory.h"
+#include "fbpcf/engine/util/test/benchmarks/BenchmarkHelper.h"
+#include "fbpcf/engine/util/test/benchmarks/NetworkedBenchmark.h"
+#include "fbpcf/scheduler/IScheduler.h"
+#include "fbpcf/scheduler/SchedulerHelper.h"
+
+namespace fbpcf::scheduler {
+
+DEFINE_int64(
+    GateArenaBenchmark_Width,
+    100000,
+    "How many scalar wires are evaluated side by side");
+
+DEFINE_int64(
+    GateArenaBenchmark_Rounds,
+    10,
+    "How many rounds of scalar gates are executed");
+
+// Runs a wide circuit of scalar (non-batch) gates between two parties: every
+// round computes an AND and an XOR gate on each wire. Besides the wall-clock
+// time and the traffic, it reports the gates executed per second by the
+// sender, so that the cost of keeping every scalar gate as an object can be
+// compared with keeping them in gate arenas, and with vectorizing the AND
+// gates of a gate arena into batch gates. The engines use dummy tuples so
+// that the time is dominated by the scheduler.
+template <bool useGateArena, bool vectorizeGates>
+class GateArenaBenchmark final : public engine::util::NetworkedBenchmark {
+ public:
+  void addCounters(folly::UserCounters& counters) {
+    counters["gates"] = gates_;
+    counters["gates_per_second"] = gates_ / seconds_;
+  }
+
+ protected:
+  void setup() override {
+    auto [factory0, factory1] = engine::util::getSocketAgentFactories();
+    agentFactory0_ = std::move(factory0);
+    agentFactory1_ = std::move(factory1);
+
+    auto createScheduler = createLazySchedulerWithInsecureEngine<
+        /*unsafe*/ true,
+        useGateArena,
+        vectorizeGates>;
+    auto scheduler0 =
+        std::async(createScheduler, 0, std::ref(*agentFactory0_));
+    auto scheduler1 =
+        std::async(createScheduler, 1, std::ref(*agentFactory1_));
+    schedulers_.at(0) = scheduler0.get();
+    schedulers_.at(1) = scheduler1.get();
+
+    std::random_device rd;
+    std::mt19937_64 e(rd());
+    std::uniform_int_distribution<uint8_t> dist(0, 1);
+    input_ = std::vector<bool>(FLAGS_GateArenaBenchmark_Width);
+    for (size_t i = 0; i < input_.size(); i++) {
+      input_[i] = dist(e);
+    }
+
+    // setting up the engines takes traffic too
+    initialTraffic_ = schedulers_.at(0)->getTrafficStatistics();
+  }
+
+  void runSender() override {
+    auto start = std::chrono::steady_clock::now();
+    gates_ = run(*schedulers_.at(0));
+    seconds_ = std::chrono::duration<double>(
+                   std::chrono::steady_clock::now() - start)
+                   .count();
+  }
+
+  void runReceiver() override {
+    run(*schedulers_.at(1));
+  }
+
+  std::pair<uint64_t, uint64_t> getTrafficStatistics() override {
+    auto [sent, received] = schedulers_.at(0)->getTrafficStatistics();
+    return {sent - initialTraffic_.first, received - initialTraffic_.second};
+  }
+
+ private:
+  // run the rounds and return the gates executed.
+  uint64_t run(IScheduler& scheduler) {
+    using WireId = IScheduler::WireId<IScheduler::Boolean>;
+    auto [initialNonFreeGates, initialFreeGates] =
+        scheduler.getGateStatistics();
+
+    std::vector<WireId> state(input_.size());
+    std::vector<WireId> mask(input_.size());
+    for (size_t i = 0; i < input_.size(); i++) {
+      state[i] = scheduler.privateBooleanInput(input_[i], 0);
+      mask[i] = scheduler.privateBooleanInput(input_[i], 1);
+    }
+
+    for (int64_t round = 0; round < FLAGS_GateArenaBenchmark_Rounds; round++) {
+      for (size_t i = 0; i < state.size(); i++) {
+        auto product = scheduler.privateAndPrivate(state[i], mask[i]);
+        auto next = scheduler.privateXorPrivate(product, state[i]);
+        scheduler.decreaseReferenceCount(product);
+        scheduler.decreaseReferenceCount(state[i]);
+        state[i] = next;
+      }
+    }
+
+    for (size_t i = 0; i < state.size(); i++) {
+      scheduler.extractBooleanSecretShare(state[i]);
+      scheduler.decreaseReferenceCount(state[i]);
+      scheduler.decreaseReferenceCount(mask[i]);
+    }
+    auto [nonFreeGates, freeGates] = scheduler.getGateStatistics();
+    return nonFreeGates - initialNonFreeGates + freeGates - initialFreeGates;
+  }
+
+  std::unique_ptr<engine::communication::IPartyCommunicationAgentFactory>
+      agentFactory0_;
+  std::unique_ptr<engine::communication::IPartyCommunicationAgentFactory>
+      agentFactory1_;
+
+  std::array<std::unique_ptr<IScheduler>, 2> schedulers_;
+
+  std::vector<bool> input_;
+  std::pair<uint64_t, uint64_t> initialTraffic_;
+  uint64_t gates_ = 0;
+  double seconds_ = 0;
+};
+
+template <bool useGateArena, bool vectorizeGates = false>
+void runGateArenaBenchmark(folly::UserCounters& counters) {
+  GateArenaBenchmark<useGateArena, vectorizeGates> benchmark;
+  benchmark.runBenchmark(counters);
+  BENCHMARK_SUSPEND {
+    benchmark.addCounters(counters);
+  }
+}
+
+BENCHMARK_COUNTERS(GateArena_GateObjects, counters) {
+  runGateArenaBenchmark</*useGateArena*/ false>(counters);
+}
+
+BENCHMARK_COUNTERS(GateArena_GateArena, counters) {
+  runGateArenaBenchmark</*useGateArena*/ true>(counters);
+}
+
+BENCHMARK_COUNTERS(GateArena_VectorizedGates, counters) {
+  runGateArenaBenchmark</*useGateArena*/ true, /*vectorizeGates*/ true>(
+      counters);
+}
+
+} // namespace fbpcf::scheduler
+
+int main(int argc, char* argv[]) {
+  facebook::initFacebook(&argc, &argv);
+  folly::runBenchmarks();
+  return 0;
+}
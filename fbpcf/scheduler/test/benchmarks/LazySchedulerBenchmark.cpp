@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <folly/Benchmark.h>
+#include <array>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "common/init/Init.h"
+
+#include "fbpcf/engine/communication/IPartyCommunicationAgentFactory.h"
+#include "fbpcf/engine/util/test/benchmarks/BenchmarkHelper.h"
+#include "fbpcf/engine/util/test/benchmarks/NetworkedBenchmark.h"
+#include "fbpcf/scheduler/IScheduler.h"
+#include "fbpcf/scheduler/SchedulerHelper.h"
+
+namespace fbpcf::scheduler {
+
+DEFINE_int64(
+    LazySchedulerBenchmark_Batch_Size,
+    1000000,
+    "How many bits are in each batch");
+
+DEFINE_int64(
+    LazySchedulerBenchmark_Rounds,
+    20,
+    "How many rounds of AND gates are executed");
+
+DEFINE_int64(
+    LazySchedulerBenchmark_Local_Batches,
+    16,
+    "How many batches of free gates are added in every round");
+
+DEFINE_int64(
+    LazySchedulerBenchmark_Latency_Ms,
+    25,
+    "The one-way latency of the simulated link, i.e. half of the RTT");
+
+// Runs a chain of batched AND gates between two parties over a link with a
+// simulated latency. In every round, a party checkpoints the shares of the
+// chain (which doesn't need any communication) and then adds free gates on
+// other batches that were shared earlier, so that these gates are independent
+// of the AND gates of the next round. A pipelined scheduler evaluates them
+// while that round is in flight. Besides the wall-clock time and the traffic,
+// it reports the rounds and the free gates executed. The engines use dummy
+// tuples so that the time isn't dominated by tuple generation.
+template <bool pipelined>
+class LazySchedulerBenchmark final : public engine::util::NetworkedBenchmark {
+ public:
+  void addCounters(folly::UserCounters& counters) {
+    counters["rounds"] = FLAGS_LazySchedulerBenchmark_Rounds;
+    counters["free_gates"] = freeGates_;
+  }
+
+ protected:
+  void setup() override {
+    auto [factory0, factory1] = engine::util::getDelayedSocketAgentFactories(
+        std::chrono::milliseconds(FLAGS_LazySchedulerBenchmark_Latency_Ms));
+    agentFactory0_ = std::move(factory0);
+    agentFactory1_ = std::move(factory1);
+
+    auto createScheduler = pipelined
+        ? createPipelinedLazySchedulerWithInsecureEngine</*unsafe*/ true>
+        : createLazySchedulerWithInsecureEngine</*unsafe*/ true>;
+    auto scheduler0 =
+        std::async(createScheduler, 0, std::ref(*agentFactory0_));
+    auto scheduler1 =
+        std::async(createScheduler, 1, std::ref(*agentFactory1_));
+    schedulers_.at(0) = scheduler0.get();
+    schedulers_.at(1) = scheduler1.get();
+
+    std::random_device rd;
+    std::mt19937_64 e(rd());
+    std::uniform_int_distribution<uint8_t> dist(0, 1);
+    input_ = std::vector<bool>(FLAGS_LazySchedulerBenchmark_Batch_Size);
+    for (size_t i = 0; i < input_.size(); i++) {
+      input_[i] = dist(e);
+    }
+
+    // setting up the engines takes traffic too
+    initialTraffic_ = schedulers_.at(0)->getTrafficStatistics();
+  }
+
+  void runSender() override {
+    freeGates_ = run(*schedulers_.at(0));
+  }
+
+  void runReceiver() override {
+    run(*schedulers_.at(1));
+  }
+
+  std::pair<uint64_t, uint64_t> getTrafficStatistics() override {
+    auto [sent, received] = schedulers_.at(0)->getTrafficStatistics();
+    return {sent - initialTraffic_.first, received - initialTraffic_.second};
+  }
+
+ private:
+  // run the rounds and return the free gates executed.
+  uint64_t run(IScheduler& scheduler) {
+    using WireId = IScheduler::WireId<IScheduler::Boolean>;
+    auto initialFreeGates = scheduler.getGateStatistics().second;
+
+    auto state = scheduler.privateBooleanInputBatch(input_, 0);
+    auto mask = scheduler.privateBooleanInputBatch(input_, 1);
+    std::vector<WireId> batches(FLAGS_LazySchedulerBenchmark_Local_Batches);
+    for (auto& batch : batches) {
+      batch = scheduler.privateBooleanInputBatch(input_, 1);
+    }
+
+    std::vector<WireId> results;
+    for (int64_t i = 0; i < FLAGS_LazySchedulerBenchmark_Rounds; i++) {
+      auto next = scheduler.privateAndPrivateBatch(state, mask);
+      auto checkpoint = scheduler.privateXorPrivateBatch(state, mask);
+      scheduler.extractBooleanSecretShareBatch(checkpoint);
+      scheduler.decreaseReferenceCountBatch(checkpoint);
+      scheduler.decreaseReferenceCountBatch(state);
+      state = next;
+
+      for (auto batch : batches) {
+        results.push_back(scheduler.privateXorPrivateBatch(batch, mask));
+      }
+    }
+
+    scheduler.extractBooleanSecretShareBatch(state);
+    for (auto result : results) {
+      scheduler.extractBooleanSecretShareBatch(result);
+      scheduler.decreaseReferenceCountBatch(result);
+    }
+    for (auto batch : batches) {
+      scheduler.decreaseReferenceCountBatch(batch);
+    }
+    scheduler.decreaseReferenceCountBatch(mask);
+    scheduler.decreaseReferenceCountBatch(state);
+    return scheduler.getGateStatistics().second - initialFreeGates;
+  }
+
+  std::unique_ptr<engine::communication::IPartyCommunicationAgentFactory>
+      agentFactory0_;
+  std::unique_ptr<engine::communication::IPartyCommunicationAgentFactory>
+      agentFactory1_;
+
+  std::array<std::unique_ptr<IScheduler>, 2> schedulers_;
+
+  std::vector<bool> input_;
+  std::pair<uint64_t, uint64_t> initialTraffic_;
+  uint64_t freeGates_ = 0;
+};
+
+template <bool pipelined>
+void runLazySchedulerBenchmark(folly::UserCounters& counters) {
+  LazySchedulerBenchmark<pipelined> benchmark;
+  benchmark.runBenchmark(counters);
+  BENCHMARK_SUSPEND {
+    benchmark.addCounters(counters);
+  }
+}
+
+BENCHMARK_COUNTERS(LazyScheduler_Sequential, counters) {
+  runLazySchedulerBenchmark</*pipelined*/ false>(counters);
+}
+
+BENCHMARK_COUNTERS(LazyScheduler_Pipelined, counters) {
+  runLazySchedulerBenchmark</*pipelined*/ true>(counters);
+}
+
+} // namespace fbpcf::scheduler
+
+int main(int argc, char* argv[]) {
+  facebook::initFacebook(&argc, &argv);
+  folly::runBenchmarks();
+  return 0;
+}
@@ -50,7 +50,16 @@ inline void testEq(
   }
 }
 
-enum class SchedulerType { Plaintext, NetworkPlaintext, Eager, Lazy };
+enum class SchedulerType {
+  Plaintext,
+  NetworkPlaintext,
+  Eager,
+  Lazy,
+  PipelinedLazy,
+  ParallelLazy,
+  ArenaLazy,
+  VectorizedLazy
+};
 
 inline std::string getSchedulerName(SchedulerType schedulerType) {
   switch (schedulerType) {
@@ -62,6 +71,14 @@ inline std::string getSchedulerName(SchedulerType schedulerType) {
       return "EagerScheduler";
     case SchedulerType::Lazy:
       return "LazyScheduler";
+    case SchedulerType::PipelinedLazy:
+      return "PipelinedLazyScheduler";
+    case SchedulerType::ParallelLazy:
+      return "ParallelLazyScheduler";
+    case SchedulerType::ArenaLazy:
+      return "ArenaLazyScheduler";
+    case SchedulerType::VectorizedLazy:
+      return "VectorizedLazyScheduler";
   }
 }
 
@@ -70,6 +87,9 @@ using SchedulerCreator = std::function<std::unique_ptr<scheduler::IScheduler>(
     engine::communication::IPartyCommunicationAgentFactory&
         communicationAgentFactory)>;
 
+// the number of threads of the parallel schedulers in tests
+const size_t kNumberOfTestThreads = 4;
+
 template <bool unsafe>
 inline SchedulerCreator getSchedulerCreator(SchedulerType schedulerType) {
   switch (schedulerType) {
@@ -81,6 +101,24 @@ inline SchedulerCreator getSchedulerCreator(SchedulerType schedulerType) {
       return scheduler::createEagerSchedulerWithInsecureEngine<unsafe>;
     case SchedulerType::Lazy:
       return scheduler::createLazySchedulerWithInsecureEngine<unsafe>;
+    case SchedulerType::PipelinedLazy:
+      return scheduler::createPipelinedLazySchedulerWithInsecureEngine<unsafe>;
+    case SchedulerType::ParallelLazy:
+      return [](int myId,
+                engine::communication::IPartyCommunicationAgentFactory&
+                    communicationAgentFactory) {
+        return scheduler::createParallelLazySchedulerWithInsecureEngine<unsafe>(
+            myId, communicationAgentFactory, kNumberOfTestThreads);
+      };
+    case SchedulerType::ArenaLazy:
+      return scheduler::createLazySchedulerWithInsecureEngine<
+          unsafe,
+          /*useGateArena*/ true>;
+    case SchedulerType::VectorizedLazy:
+      return scheduler::createLazySchedulerWithInsecureEngine<
+          unsafe,
+          /*useGateArena*/ true,
+          /*vectorizeGates*/ true>;
   }
 }
 